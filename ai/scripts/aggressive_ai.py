@@ -5,47 +5,68 @@
 - 低血量时仍然攻击（到 10% 才逃）
 """
 from ai_utils import *
+from ai_batch import *
 
 
 def update_ai(ctx_json):
     ctx = parse_context(ctx_json)
-
-    pos = ctx['pos']
-    health = ctx['health']
-    max_health = ctx['max_health']
     enemies = ctx['enemies']
-    attack_range = ctx['attack_range']
-    move_speed = ctx['move_speed']
+    nearest = enemies[0]['pos'] if enemies else None
+    target = choose_weakest_enemy(ctx)
+    return make_action(*decide(
+        ctx['pos'], ctx['health'], ctx['max_health'], nearest,
+        target['pos'] if target else None, target['id'] if target else 0,
+        ctx['attack_range'], ctx['move_speed']))
+
+
+def update_ai_batch(raw):
+    """批量入口: 直接按列读取，不构造 dict"""
+    b = Batch(raw)
+    health, max_health = b.af[A_HEALTH], b.af[A_MAX_HEALTH]
+    attack_range, move_speed = b.af[A_ATTACK_RANGE], b.af[A_MOVE_SPEED]
+    enemy_health = b.ef[E_HEALTH] if b.ef else None
+    enemy_id = b.ei[E_ENTITY_ID] if b.ei else None
+    for i in range(b.n):
+        nearest = weakest = None
+        rows = b.enemy_range(i)
+        if rows:
+            nearest = b.enemy_pos(rows[0])
+            k = min(rows, key=enemy_health.__getitem__)
+            weakest = (b.enemy_pos(k), enemy_id[k])
+        b.set_action(i, *decide(
+            b.pos(i), health[i], max_health[i], nearest,
+            weakest[0] if weakest else None, weakest[1] if weakest else 0,
+            attack_range[i], move_speed[i]))
+    return b.strings
+
+
+def decide(pos, health, max_health, nearest_pos, target_pos, target_id, attack_range, move_speed):
+    """返回 make_action 的参数元组；target 为血量最低的敌人，nearest_pos 为最近敌人的位置"""
 
     if health <= 0:
-        return make_action("Dead")
+        return ("Dead",)
 
     # 仅 10% 以下才逃
     if health < max_health * 0.1:
-        if enemies:
-            away = direction_to(enemies[0]['pos'], pos)
-            return make_action("Flee", away[0], away[1], away[2], move_speed * 1.5)
-        return make_action("Flee")
+        if nearest_pos:
+            away = direction_to(nearest_pos, pos)
+            return ("Flee", away[0], away[1], away[2], move_speed * 1.5)
+        return ("Flee",)
 
     # 没有敌人 → 原地搜索
-    if not enemies:
+    if not target_pos:
         # 缓慢旋转搜索（原地不动）
-        return make_action("Idle", custom="searching")
-
-    # 选择最弱目标
-    target = choose_weakest_enemy(ctx)
-    if not target:
-        target = enemies[0]
+        return ("Idle", 0, 0, 0, 0, 0, "searching")
 
-    dist = distance(pos, target['pos'])
-    d = direction_to(pos, target['pos'])
+    dist = distance(pos, target_pos)
+    d = direction_to(pos, target_pos)
 
     # 在攻击范围内 → 攻击
     if dist <= attack_range:
-        return make_action("Attack", d[0], d[1], d[2], 0, target=target['id'])
+        return ("Attack", d[0], d[1], d[2], 0, target_id)
 
     # 冲刺追击（加速）
-    return make_action("Chase", d[0], d[1], d[2], move_speed * 1.2, target=target['id'])
+    return ("Chase", d[0], d[1], d[2], move_speed * 1.2, target_id)
 
 
 def get_ai_info():
@@ -0,0 +1,238 @@
+"""
+批量 AI 协议 — C++ AIManager 每帧对每个脚本模块只调用一次 update_ai_batch(batch)
+
+batch 是一个 dict，各张表是结构数组 (每列连续) 的 memoryview，不经过 JSON:
+- agent 表 n 行: agent_f / agent_i
+- 附近实体表 enemy_n 行: enemy_f / enemy_i (agent 的区间为 [A_ENEMY_BEGIN, +A_ENEMY_COUNT)，按距离升序)
+- 队友表 ally_n 行: ally_f / ally_i
+- 小队概览表 squad_n 行: squad_f / squad_i (只有指挥官批次非空)
+- player: 玩家行为数据 (单行)；orders: 去重后的命令 JSON 字符串，A_ORDER 为其下标
+- 结果表 action_f / action_i 可写，初值为当前状态、不移动
+
+缓冲只在本次调用期间有效，不要保存到调用之外: 调用返回后 C++ 会 release 这些 memoryview，
+之后再访问会抛 ValueError；由它们 cast 出的视图、numpy.frombuffer 数组等不会随之失效，
+留到调用之外会读写已释放的内存。
+列编号与 engine/include/engine/ai/ai_batch.h 中 AIBatch 的定义保持一致。
+
+用法:
+    from ai_batch import Batch
+
+    def update_ai_batch(raw):
+        b = Batch(raw)
+        health = b.agent_col(A_HEALTH)
+        for i in range(b.n):
+            ...
+            b.set_action(i, "Chase", dx, dy, dz, speed, target)
+        return b.strings
+
+已有的逐个 update_ai(ctx_json) 可用 batch_adapter 包装成批量入口 (省去 JSON 与逐个调用)。
+装有 numpy 时可以 numpy.frombuffer(raw["agent_f"], numpy.float32).reshape(-1, raw["n"]) 整列计算。
+"""
+
+# ── 列编号 ──────────────────────────────────────────────
+
+# agent 浮点列 (A_DT 为距上次决策的秒数，A_FRAME_DT 为本帧 dt)
+(A_POS_X, A_POS_Y, A_POS_Z, A_ROT_Y, A_HEALTH, A_MAX_HEALTH, A_DETECT_RANGE,
+ A_ATTACK_RANGE, A_MOVE_SPEED, A_DT, A_FRAME_DT) = range(11)
+# agent 整数列
+(A_ENTITY_ID, A_STATE, A_ROLE, A_SQUAD_ID, A_SQUAD_SIZE, A_SQUAD_ALIVE, A_ORDER,
+ A_ENEMY_BEGIN, A_ENEMY_COUNT, A_ALLY_BEGIN, A_ALLY_COUNT, A_HAS_PLAYER) = range(12)
+
+# 附近实体
+E_POS_X, E_POS_Y, E_POS_Z, E_HEALTH, E_DIST = range(5)
+E_ENTITY_ID = 0
+
+# 队友
+L_POS_X, L_POS_Y, L_POS_Z, L_HEALTH, L_MAX_HEALTH, L_DIST = range(6)
+L_ENTITY_ID, L_STATE, L_ROLE = range(3)
+
+# 小队概览
+S_CENTER_X, S_CENTER_Y, S_CENTER_Z, S_AVG_HEALTH = range(4)
+S_SQUAD_ID, S_TOTAL, S_ALIVE, S_HAS_ORDER = range(4)
+
+# 玩家
+(P_POS_X, P_POS_Y, P_POS_Z, P_VEL_X, P_VEL_Y, P_VEL_Z, P_SPEED, P_AVG_SPEED,
+ P_ATTACK_COUNT, P_RETREAT_COUNT, P_AGGRESSION, P_COMBAT_TIME) = range(12)
+
+# 结果
+R_DIR_X, R_DIR_Y, R_DIR_Z, R_SPEED = range(4)
+R_STATE, R_TARGET = range(2)
+
+# AIState 与角色编号
+STATE_NAMES = ("Idle", "Patrol", "Chase", "Attack", "Flee", "Dead")
+STATE_IDS = {name: i for i, name in enumerate(STATE_NAMES)}
+ROLE_NAMES = ("soldier", "leader", "commander")
+
+
+def _columns(view, fmt, rows):
+    """按列切开一块结构数组缓冲 (切片不拷贝)"""
+    flat = view.cast(fmt)
+    if rows == 0:
+        return []
+    return [flat[c * rows:(c + 1) * rows] for c in range(len(flat) // rows)]
+
+
+class Batch:
+    """一次 update_ai_batch 调用的上下文与结果"""
+
+    def __init__(self, raw):
+        self.n = raw["n"]
+        self.af = _columns(raw["agent_f"], "f", self.n)
+        self.ai = _columns(raw["agent_i"], "i", self.n)
+        self.ef = _columns(raw["enemy_f"], "f", raw["enemy_n"])
+        self.ei = _columns(raw["enemy_i"], "i", raw["enemy_n"])
+        self.lf = _columns(raw["ally_f"], "f", raw["ally_n"])
+        self.li = _columns(raw["ally_i"], "i", raw["ally_n"])
+        self.sf = _columns(raw["squad_f"], "f", raw["squad_n"])
+        self.si = _columns(raw["squad_i"], "i", raw["squad_n"])
+        self.player = raw["player"].cast("f")
+        self.orders = raw["orders"]
+        self.rf = _columns(raw["action_f"], "f", self.n)
+        self.ri = _columns(raw["action_i"], "i", self.n)
+        self.strings = []   # [(row, custom, order)]，作为 update_ai_batch 的返回值
+
+    # ── 读取 ─────────────────────────────────────
+
+    def agent_col(self, col):
+        """agent 浮点列 (memoryview，按行下标访问)"""
+        return self.af[col]
+
+    def agent_int_col(self, col):
+        return self.ai[col]
+
+    def pos(self, i):
+        af = self.af
+        return [af[A_POS_X][i], af[A_POS_Y][i], af[A_POS_Z][i]]
+
+    def state(self, i):
+        return STATE_NAMES[self.ai[A_STATE][i]]
+
+    def enemy_range(self, i):
+        """agent i 的附近实体在 enemy 表中的行区间"""
+        begin = self.ai[A_ENEMY_BEGIN][i]
+        return range(begin, begin + self.ai[A_ENEMY_COUNT][i])
+
+    def enemy_pos(self, k):
+        ef = self.ef
+        return [ef[E_POS_X][k], ef[E_POS_Y][k], ef[E_POS_Z][k]]
+
+    def order(self, i):
+        """agent i 收到的命令 JSON 字符串，无命令为 None"""
+        k = self.ai[A_ORDER][i]
+        return self.orders[k] if k >= 0 else None
+
+    # ── 写回 ─────────────────────────────────────
+
+    def set_action(self, i, state, dir_x=0, dir_y=0, dir_z=0, speed=0, target=0, custom="", order=""):
+        """参数与 ai_utils.make_action 相同"""
+        rf = self.rf
+        rf[R_DIR_X][i] = dir_x
+        rf[R_DIR_Y][i] = dir_y
+        rf[R_DIR_Z][i] = dir_z
+        rf[R_SPEED][i] = speed
+        self.ri[R_STATE][i] = STATE_IDS.get(state, 0)
+        self.ri[R_TARGET][i] = int(target)
+        if custom or order:
+            self.strings.append((i, custom, order))
+
+    def set_action_string(self, i, result):
+        """写入逐个接口的返回串 "state|x,y,z|speed|target|custom|order" """
+        if not result:
+            return
+        parts = result.split("|", 5)
+        parts += [""] * (6 - len(parts))
+        d = (parts[1].split(",") + ["0", "0", "0"])[:3] if parts[1] else ["0", "0", "0"]
+        try:
+            self.set_action(i, parts[0], float(d[0]), float(d[1]), float(d[2]),
+                            float(parts[2] or 0), int(parts[3] or 0), parts[4], parts[5])
+        except ValueError:
+            self.ri[R_STATE][i] = STATE_IDS.get(parts[0], 0)
+
+    # ── 兼容逐个接口 ─────────────────────────────
+
+    def context(self, i):
+        """还原成与 ContextToJSON 相同结构的 dict"""
+        af, ai = self.af, self.ai
+        enemies = []
+        for k in self.enemy_range(i):
+            enemies.append({
+                "id": self.ei[E_ENTITY_ID][k],
+                "pos": self.enemy_pos(k),
+                "health": self.ef[E_HEALTH][k],
+                "dist": self.ef[E_DIST][k],
+                "tag": "",
+            })
+        allies = []
+        begin = ai[A_ALLY_BEGIN][i]
+        for k in range(begin, begin + ai[A_ALLY_COUNT][i]):
+            lf, li = self.lf, self.li
+            allies.append({
+                "id": li[L_ENTITY_ID][k],
+                "pos": [lf[L_POS_X][k], lf[L_POS_Y][k], lf[L_POS_Z][k]],
+                "health": lf[L_HEALTH][k],
+                "max_health": lf[L_MAX_HEALTH][k],
+                "state": STATE_NAMES[li[L_STATE][k]],
+                "role": ROLE_NAMES[li[L_ROLE][k]],
+                "dist": lf[L_DIST][k],
+            })
+        player = None
+        if ai[A_HAS_PLAYER][i]:
+            p = self.player
+            player = {
+                "pos": [p[P_POS_X], p[P_POS_Y], p[P_POS_Z]],
+                "vel": [p[P_VEL_X], p[P_VEL_Y], p[P_VEL_Z]],
+                "speed": p[P_SPEED],
+                "avg_speed": p[P_AVG_SPEED],
+                "attack_count": int(p[P_ATTACK_COUNT]),
+                "retreat_count": int(p[P_RETREAT_COUNT]),
+                "aggression": p[P_AGGRESSION],
+                "combat_time": p[P_COMBAT_TIME],
+            }
+        squads = []
+        if ai[A_ROLE][i] == 2:
+            sf, si = self.sf, self.si
+            for k in range(len(sf[0]) if sf else 0):
+                squads.append({
+                    "id": si[S_SQUAD_ID][k],
+                    "total": si[S_TOTAL][k],
+                    "alive": si[S_ALIVE][k],
+                    "avg_hp": sf[S_AVG_HEALTH][k],
+                    "center": [sf[S_CENTER_X][k], sf[S_CENTER_Y][k], sf[S_CENTER_Z][k]],
+                    "order": "active" if si[S_HAS_ORDER][k] else "idle",
+                })
+        return {
+            "entity_id": ai[A_ENTITY_ID][i],
+            "pos": self.pos(i),
+            "health": af[A_HEALTH][i],
+            "max_health": af[A_MAX_HEALTH][i],
+            "state": self.state(i),
+            "detect_range": af[A_DETECT_RANGE][i],
+            "attack_range": af[A_ATTACK_RANGE][i],
+            "move_speed": af[A_MOVE_SPEED][i],
+            "dt": af[A_DT][i],
+            "frame_dt": af[A_FRAME_DT][i],
+            "role": ROLE_NAMES[ai[A_ROLE][i]],
+            "squad_id": ai[A_SQUAD_ID][i],
+            "squad_size": ai[A_SQUAD_SIZE][i],
+            "squad_alive": ai[A_SQUAD_ALIVE][i],
+            "order": self.order(i),
+            "enemies": enemies,
+            "allies": allies,
+            "patrol_points": [],
+            "patrol_index": 0,
+            "player": player,
+            "squads": squads,
+        }
+
+
+def batch_adapter(update_ai):
+    """把逐个的 update_ai(ctx) 包装成 update_ai_batch(batch)
+
+    update_ai 收到的是 dict 而不是 JSON 字符串 (ai_utils.parse_context 两者都接受)
+    """
+    def update_ai_batch(raw):
+        b = Batch(raw)
+        for i in range(b.n):
+            b.set_action_string(i, update_ai(b.context(i)))
+        return b.strings
+    return update_ai_batch
@@ -154,7 +154,9 @@ def make_order(order_type, target_pos=None, target_id=0, priority=0.5,
 # ════════════════════════════════════════════════════════════
 
 def parse_context(ctx_json):
-    """解析 C++ 传来的 JSON 上下文"""
+    """解析 C++ 传来的 JSON 上下文 (批量接口经 ai_batch.batch_adapter 直接传入 dict)"""
+    if isinstance(ctx_json, dict):
+        return ctx_json
     try:
         return json.loads(ctx_json)
     except Exception:
@@ -13,6 +13,7 @@
 """
 from collections import deque
 from ai_utils import *
+from ai_batch import batch_adapter
 
 # ═══════════════════════════════════════════════════════════
 # 持久记忆（跨帧保持，Python 进程内存中）
@@ -248,6 +249,10 @@ def update_ai(ctx_json):
     return make_action("Idle", custom=f"tactic:{tactic}", order=order)
 
 
+# 批量入口: 每帧整个模块只调用一次，逐个复用 update_ai 的决策
+update_ai_batch = batch_adapter(update_ai)
+
+
 def get_ai_info():
     return {
         "name": "指挥官 AI",
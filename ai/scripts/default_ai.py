@@ -8,50 +8,68 @@
 - Dead：死亡
 """
 from ai_utils import *
+from ai_batch import *
 
 
 def update_ai(ctx_json):
     ctx = parse_context(ctx_json)
-
-    state = ctx['state']
-    pos = ctx['pos']
-    health = ctx['health']
-    max_health = ctx['max_health']
-    dt = ctx['dt']
-    enemies = ctx['enemies']
-    patrol_points = ctx.get('patrol_points', [])
-    patrol_idx = ctx.get('patrol_index', 0)
-    attack_range = ctx['attack_range']
-    move_speed = ctx['move_speed']
+    enemy = ctx['enemies'][0] if ctx['enemies'] else None
+    return make_action(*decide(
+        ctx['state'], ctx['pos'], ctx['health'], ctx['max_health'],
+        enemy['pos'] if enemy else None, enemy['id'] if enemy else 0, enemy['dist'] if enemy else 0,
+        ctx.get('patrol_points', []), ctx.get('patrol_index', 0),
+        ctx['attack_range'], ctx['move_speed']))
+
+
+def update_ai_batch(raw):
+    """批量入口: 直接按列读取，不构造 dict"""
+    b = Batch(raw)
+    state, health, max_health = b.ai[A_STATE], b.af[A_HEALTH], b.af[A_MAX_HEALTH]
+    attack_range, move_speed = b.af[A_ATTACK_RANGE], b.af[A_MOVE_SPEED]
+    enemy_begin, enemy_count = b.ai[A_ENEMY_BEGIN], b.ai[A_ENEMY_COUNT]
+    enemy_id, enemy_dist = b.ei[E_ENTITY_ID] if b.ei else None, b.ef[E_DIST] if b.ef else None
+    for i in range(b.n):
+        k = enemy_begin[i]
+        has_enemy = enemy_count[i] > 0
+        b.set_action(i, *decide(
+            STATE_NAMES[state[i]], b.pos(i), health[i], max_health[i],
+            b.enemy_pos(k) if has_enemy else None,
+            enemy_id[k] if has_enemy else 0, enemy_dist[k] if has_enemy else 0,
+            (), 0, attack_range[i], move_speed[i]))
+    return b.strings
+
+
+def decide(state, pos, health, max_health, enemy_pos, enemy_id, enemy_dist,
+           patrol_points, patrol_idx, attack_range, move_speed):
+    """返回 make_action 的参数元组；enemy_* 为最近的敌人 (没有时 enemy_pos 为 None)"""
 
     # 死亡
     if health <= 0:
-        return make_action("Dead")
+        return ("Dead",)
 
     # 低血量逃跑 (< 20%)
     if health < max_health * 0.2:
-        if enemies:
+        if enemy_pos:
             # 逃离最近敌人
-            enemy = enemies[0]
-            away = direction_to(enemy['pos'], pos)
-            return make_action("Flee", away[0], away[1], away[2], move_speed * 1.3)
-        return make_action("Flee", 0, 0, 1, move_speed * 1.3)
+            away = direction_to(enemy_pos, pos)
+            return ("Flee", away[0], away[1], away[2], move_speed * 1.3)
+        return ("Flee", 0, 0, 1, move_speed * 1.3)
 
     # ── 状态逻辑 ────────────────────────────
 
     if state == "Idle":
         # 发现敌人 → 追击
-        if enemies:
-            return make_action("Chase")
+        if enemy_pos:
+            return ("Chase",)
         # 有巡逻点 → 巡逻
         if patrol_points:
-            return make_action("Patrol")
-        return make_action("Idle")
+            return ("Patrol",)
+        return ("Idle",)
 
     elif state == "Patrol":
         # 发现敌人 → 追击
-        if enemies:
-            return make_action("Chase")
+        if enemy_pos:
+            return ("Chase",)
 
         # 沿路径点移动
         if patrol_points:
@@ -60,49 +78,44 @@ def update_ai(ctx_json):
 
             if dist < 1.0:
                 # 到达路径点 → 下一个
-                return make_action("Patrol", custom=f"next_patrol")
+                return ("Patrol", 0, 0, 0, 0, 0, "next_patrol")
             else:
                 d = direction_to(pos, target)
-                return make_action("Patrol", d[0], d[1], d[2], move_speed * 0.6)
+                return ("Patrol", d[0], d[1], d[2], move_speed * 0.6)
 
-        return make_action("Idle")
+        return ("Idle",)
 
     elif state == "Chase":
-        if not enemies:
-            return make_action("Patrol")
-
-        enemy = choose_closest_enemy(ctx)
-        dist = enemy['dist']
+        if not enemy_pos:
+            return ("Patrol",)
 
-        if dist <= attack_range:
-            return make_action("Attack", target=enemy['id'])
+        if enemy_dist <= attack_range:
+            return ("Attack", 0, 0, 0, 0, enemy_id)
 
         # 追击
-        d = direction_to(pos, enemy['pos'])
-        return make_action("Chase", d[0], d[1], d[2], move_speed)
+        d = direction_to(pos, enemy_pos)
+        return ("Chase", d[0], d[1], d[2], move_speed)
 
     elif state == "Attack":
-        if not enemies:
-            return make_action("Patrol")
+        if not enemy_pos:
+            return ("Patrol",)
 
-        enemy = choose_closest_enemy(ctx)
-        if enemy['dist'] > attack_range * 1.5:
-            return make_action("Chase")
+        if enemy_dist > attack_range * 1.5:
+            return ("Chase",)
 
         # 持续攻击（面向敌人但不移动）
-        d = direction_to(pos, enemy['pos'])
-        return make_action("Attack", d[0], d[1], d[2], 0, target=enemy['id'])
+        d = direction_to(pos, enemy_pos)
+        return ("Attack", d[0], d[1], d[2], 0, enemy_id)
 
     elif state == "Flee":
         if health > max_health * 0.4:
-            return make_action("Patrol")
-        if enemies:
-            enemy = enemies[0]
-            away = direction_to(enemy['pos'], pos)
-            return make_action("Flee", away[0], away[1], away[2], move_speed * 1.3)
-        return make_action("Idle")
-
-    return make_action(state)
+            return ("Patrol",)
+        if enemy_pos:
+            away = direction_to(enemy_pos, pos)
+            return ("Flee", away[0], away[1], away[2], move_speed * 1.3)
+        return ("Idle",)
+
+    return (state,)
 
 
 def get_ai_info():
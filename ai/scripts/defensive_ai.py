@@ -6,6 +6,7 @@
 - 血量低时提前撤退到守卫点
 """
 from ai_utils import *
+from ai_batch import *
 
 # 每个实体的守卫点缓存
 _guard_positions = {}
@@ -13,19 +14,37 @@ _guard_positions = {}
 
 def update_ai(ctx_json):
     ctx = parse_context(ctx_json)
-
-    entity_id = ctx['entity_id']
-    pos = ctx['pos']
-    health = ctx['health']
-    max_health = ctx['max_health']
-    enemies = ctx['enemies']
-    attack_range = ctx['attack_range']
-    detect_range = ctx['detect_range']
-    move_speed = ctx['move_speed']
-    state = ctx['state']
+    enemy = choose_closest_enemy(ctx)
+    return make_action(*decide(
+        ctx['entity_id'], ctx['pos'], ctx['health'], ctx['max_health'],
+        enemy['pos'] if enemy else None, enemy['id'] if enemy else 0, enemy['dist'] if enemy else 0,
+        ctx['attack_range'], ctx['detect_range'], ctx['move_speed']))
+
+
+def update_ai_batch(raw):
+    """批量入口: 直接按列读取，不构造 dict"""
+    b = Batch(raw)
+    entity_id, health, max_health = b.ai[A_ENTITY_ID], b.af[A_HEALTH], b.af[A_MAX_HEALTH]
+    attack_range, detect_range, move_speed = b.af[A_ATTACK_RANGE], b.af[A_DETECT_RANGE], b.af[A_MOVE_SPEED]
+    enemy_begin, enemy_count = b.ai[A_ENEMY_BEGIN], b.ai[A_ENEMY_COUNT]
+    enemy_id, enemy_dist = b.ei[E_ENTITY_ID] if b.ei else None, b.ef[E_DIST] if b.ef else None
+    for i in range(b.n):
+        k = enemy_begin[i]
+        has_enemy = enemy_count[i] > 0
+        b.set_action(i, *decide(
+            entity_id[i], b.pos(i), health[i], max_health[i],
+            b.enemy_pos(k) if has_enemy else None,
+            enemy_id[k] if has_enemy else 0, enemy_dist[k] if has_enemy else 0,
+            attack_range[i], detect_range[i], move_speed[i]))
+    return b.strings
+
+
+def decide(entity_id, pos, health, max_health, enemy_pos, enemy_id, enemy_dist,
+           attack_range, detect_range, move_speed):
+    """返回 make_action 的参数元组；enemy_* 为最近的敌人 (没有时 enemy_pos 为 None)"""
 
     if health <= 0:
-        return make_action("Dead")
+        return ("Dead",)
 
     # 记录初始位置（守卫点）
     if entity_id not in _guard_positions:
@@ -41,36 +60,34 @@ def update_ai(ctx_json):
     if health < max_health * 0.3:
         if dist_from_guard > 2.0:
             d = direction_to(pos, guard_pos)
-            return make_action("Flee", d[0], d[1], d[2], move_speed)
-        return make_action("Idle")
+            return ("Flee", d[0], d[1], d[2], move_speed)
+        return ("Idle",)
 
     # 超出追击范围 → 返回守卫点
     if dist_from_guard > max_chase_dist:
         d = direction_to(pos, guard_pos)
-        return make_action("Patrol", d[0], d[1], d[2], move_speed * 0.8, custom="returning")
+        return ("Patrol", d[0], d[1], d[2], move_speed * 0.8, 0, "returning")
 
     # 没有敌人 → 返回守卫点或待命
-    if not enemies:
+    if not enemy_pos:
         if dist_from_guard > 2.0:
             d = direction_to(pos, guard_pos)
-            return make_action("Patrol", d[0], d[1], d[2], move_speed * 0.6, custom="returning")
-        return make_action("Idle")
+            return ("Patrol", d[0], d[1], d[2], move_speed * 0.6, 0, "returning")
+        return ("Idle",)
 
     # 有敌人
-    enemy = choose_closest_enemy(ctx)
-    dist = enemy['dist']
-    d = direction_to(pos, enemy['pos'])
+    d = direction_to(pos, enemy_pos)
 
     # 攻击范围内 → 攻击
-    if dist <= attack_range:
-        return make_action("Attack", d[0], d[1], d[2], 0, target=enemy['id'])
+    if enemy_dist <= attack_range:
+        return ("Attack", d[0], d[1], d[2], 0, enemy_id)
 
     # 在检测范围内 → 追击
-    if dist <= detect_range:
-        return make_action("Chase", d[0], d[1], d[2], move_speed * 0.9, target=enemy['id'])
+    if enemy_dist <= detect_range:
+        return ("Chase", d[0], d[1], d[2], move_speed * 0.9, enemy_id)
 
     # 敌人太远 → 待命
-    return make_action("Idle")
+    return ("Idle",)
 
 
 def get_ai_info():
@@ -6,6 +6,10 @@ Engine API — Python 脚本调用引擎功能的接口
 此文件提供友好的 Python API 包装。
 
 如果 _engine_bridge 不可用（独立测试时），则使用 stub 模式。
+
+邻域查询 (find_nearby / find_k_nearest / get_squad_members) 优先走内置的
+_engine_spatial 模块: AIManager 每帧重建一次的网格索引，不再逐实体扫描。
+它只在主线程回答 (AI 工作线程上返回 None)，此时回退到 _engine_bridge。
 """
 import json
 
@@ -16,6 +20,12 @@ try:
 except ImportError:
     _HAS_BRIDGE = False
 
+try:
+    import _engine_spatial as _spatial
+    _HAS_SPATIAL = True
+except ImportError:
+    _HAS_SPATIAL = False
+
 
 # ── Transform ────────────────────────────────────────────────
 
@@ -97,7 +107,11 @@ def find_by_tag(tag):
     return []
 
 def find_nearby(entity_id, radius):
-    """查找附近实体 → [{"id": int, "pos": [x,y,z], "dist": float, "name": str}, ...]"""
+    """查找附近实体 → [{"id": int, "pos": [x,y,z], "dist": float, "name": str}, ...] (按距离升序)"""
+    if _HAS_SPATIAL:
+        result = _spatial.find_nearby(entity_id, radius)
+        if result is not None:
+            return result
     if _HAS_BRIDGE:
         result = _bridge.find_nearby(entity_id, radius)
         try:
@@ -106,6 +120,22 @@ def find_nearby(entity_id, radius):
             return []
     return []
 
+def find_k_nearest(entity_id, k, max_radius=float("inf")):
+    """最近的 k 个实体 (不超过 max_radius) → 格式同 find_nearby"""
+    if _HAS_SPATIAL:
+        result = _spatial.k_nearest(entity_id, k, max_radius)
+        if result is not None:
+            return result
+    return find_nearby(entity_id, max_radius)[:k]
+
+def get_squad_members(squad_id):
+    """小队成员 → [entity_id, ...] (按 ID 升序)"""
+    if _HAS_SPATIAL:
+        result = _spatial.squad_members(squad_id)
+        if result is not None:
+            return result
+    return []
+
 def get_entity_count():
     """获取场景中实体总数"""
     if _HAS_BRIDGE:
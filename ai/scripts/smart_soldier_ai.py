@@ -18,6 +18,7 @@
 - 有队友协作行为
 """
 from ai_utils import *
+from ai_batch import batch_adapter
 
 
 # ── 士兵个体记忆 ──────────────────────────────────────
@@ -317,6 +318,10 @@ def find_shared_target(enemies, allies):
     return best_target if max_allies_near > 0 else None
 
 
+# 批量入口: 每帧整个模块只调用一次，逐个复用 update_ai 的决策
+update_ai_batch = batch_adapter(update_ai)
+
+
 def get_ai_info():
     return {
         "name": "智能士兵 AI",
@@ -11,6 +11,7 @@
 输出: 自身行动 + 下发给士兵的子命令
 """
 from ai_utils import *
+from ai_batch import batch_adapter
 
 
 def update_ai(ctx_json):
@@ -244,6 +245,10 @@ def independent_decision(ctx, pos, enemies, allies, speed, atk_range):
     return make_action("Idle")
 
 
+# 批量入口: 每帧整个模块只调用一次，逐个复用 update_ai 的决策
+update_ai_batch = batch_adapter(update_ai)
+
+
 def get_ai_info():
     return {
         "name": "小队长 AI",
@@ -0,0 +1,284 @@
+/**
+ * @file bench_animation.cpp
+ * @brief 骨骼动画基准: 2000 个蒙皮角色的每帧更新
+ *
+ * 所有角色共享一个 64 骨骼的骨架和 3 个剪辑 (每骨骼 30 个关键帧)。
+ * Legacy 为旧做法: 每实例持有剪辑副本、按名称查找、采样写入骨架后再算矩阵 (只能串行)；
+ * System 为 AnimationSystem，参数为 JobSystem 工作线程数 (0 = 调用线程串行)，
+ * Compressed 变体使用压缩剪辑。Sample 系列只测单个实例的关键帧采样，报告每骨骼纳秒数。
+ * LOD 系列把角色均匀分布在相机前 0~200 m: 参数 0 = 默认距离 LOD，1 = 再加 1 ms 帧预算，
+ * 2 = 一半角色在视锥外 (剔除跳过)。Palette 为同一场景顺带写骨骼调色板 (实例化蒙皮用)。
+ * Skinning_Cpu 为 SIMD CPU 蒙皮，报告每顶点纳秒数。
+ */
+
+#include <benchmark/benchmark.h>
+#include "engine/renderer/animation.h"
+#include "engine/core/job_system.h"
+#include "engine/core/components.h"
+#include "engine/renderer/frustum.h"
+#include "engine/renderer/skinning_utils.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+
+using namespace Engine;
+
+namespace {
+
+constexpr u32 CHARACTERS = 2000;
+constexpr u32 BONES = 64;
+constexpr u32 KEYS = 30;
+
+AnimationSetRef GetAnimationSet() {
+    static AnimationSetRef set = [] {
+        auto skeleton = CreateRef<Skeleton>();
+        for (u32 i = 0; i < BONES; i++) {
+            Bone bone;
+            bone.Name = "bone_" + std::to_string(i);
+            // 每 8 根一条链，模拟四肢/手指分叉
+            bone.ParentIndex = (i % 8 == 0) ? (i == 0 ? -1 : 0) : (i32)i - 1;
+            bone.LocalTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0.1f, 0));
+            skeleton->AddBone(bone);
+        }
+
+        auto s = CreateRef<AnimationSet>();
+        s->SkeletonData = skeleton;
+        const char* names[] = {"idle", "walk", "run"};
+        for (u32 c = 0; c < 3; c++) {
+            AnimationClip clip;
+            clip.Name = names[c];
+            clip.Duration = 1.0f;
+            for (u32 b = 0; b < BONES; b++) {
+                AnimationChannel ch;
+                ch.BoneIndex = (i32)b;
+                for (u32 k = 0; k < KEYS; k++) {
+                    f32 t = (f32)k / (KEYS - 1);
+                    f32 phase = t * 6.2831853f + (f32)(b + c);
+                    ch.PositionKeys.push_back({t, {0, 0.1f, std::sin(phase) * 0.01f}});
+                    ch.RotationKeys.push_back({t, glm::angleAxis(std::sin(phase) * 0.5f, glm::vec3(1, 0, 0))});
+                    ch.ScaleKeys.push_back({t, glm::vec3(1.0f)});
+                }
+                clip.Channels.push_back(std::move(ch));
+            }
+            s->Clips.push_back(std::move(clip));
+        }
+        return AnimationSetRef(s);
+    }();
+    return set;
+}
+
+AnimationSetRef GetCompressedSet() {
+    static AnimationSetRef set = [] {
+        auto s = CreateRef<AnimationSet>(*GetAnimationSet());
+        s->CompressClips({}, false);
+        return AnimationSetRef(s);
+    }();
+    return set;
+}
+
+const char* ClipName(u32 i) {
+    static const char* names[] = {"idle", "walk", "run"};
+    return names[i % 3];
+}
+
+} // namespace
+
+static void BM_Animation_Legacy(benchmark::State& state) {
+    auto set = GetAnimationSet();
+    // 旧组件: 每实例剪辑副本 + 可写骨架
+    struct LegacyAnimator {
+        Ref<Skeleton> SkeletonRef;
+        std::vector<AnimationClip> Clips;
+        std::string CurrentClip;
+        f32 CurrentTime = 0.0f;
+        std::vector<glm::mat4> BoneMatrices;
+    };
+    auto shared = CreateRef<Skeleton>(*set->SkeletonData);
+    std::vector<LegacyAnimator> animators(CHARACTERS);
+    for (u32 i = 0; i < CHARACTERS; i++) {
+        animators[i].SkeletonRef = shared;
+        animators[i].Clips = set->Clips;
+        animators[i].CurrentClip = ClipName(i);
+        animators[i].CurrentTime = (f32)i * 0.001f;
+    }
+
+    for (auto _ : state) {
+        for (auto& anim : animators) {
+            const AnimationClip* clip = nullptr;
+            for (const auto& c : anim.Clips) {
+                if (c.Name == anim.CurrentClip) { clip = &c; break; }
+            }
+            anim.CurrentTime = std::fmod(anim.CurrentTime + 1.0f / 60.0f, clip->Duration);
+            AnimationSampler::Sample(*clip, anim.CurrentTime, *anim.SkeletonRef);
+            anim.SkeletonRef->ComputeBoneMatrices(anim.BoneMatrices);
+        }
+        benchmark::DoNotOptimize(animators[0].BoneMatrices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * CHARACTERS);
+}
+BENCHMARK(BM_Animation_Legacy)->Unit(benchmark::kMillisecond);
+
+static void RunSystem(benchmark::State& state, const AnimationSetRef& set) {
+    u32 threads = (u32)state.range(0);
+    if (threads > 0) JobSystem::Init(threads);
+
+    ECSWorld world;
+    for (u32 i = 0; i < CHARACTERS; i++) {
+        Entity e = world.CreateEntity("Zombie");
+        auto& anim = world.AddComponent<AnimatorComponent>(e);
+        anim.Animations = set;
+        anim.CurrentClip = ClipName(i);
+        anim.CurrentTime = (f32)i * 0.001f;
+    }
+
+    AnimationSystem system;
+    for (auto _ : state) {
+        system.Update(world, 1.0f / 60.0f);
+    }
+    state.SetItemsProcessed(state.iterations() * CHARACTERS);
+
+    if (threads > 0) JobSystem::Shutdown();
+}
+
+static void BM_Animation_System(benchmark::State& state) {
+    RunSystem(state, GetAnimationSet());
+}
+BENCHMARK(BM_Animation_System)->Arg(0)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_Animation_SystemCompressed(benchmark::State& state) {
+    RunSystem(state, GetCompressedSet());
+}
+BENCHMARK(BM_Animation_SystemCompressed)->Arg(0)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_Animation_Palette(benchmark::State& state) {
+    ECSWorld world;
+    for (u32 i = 0; i < CHARACTERS; i++) {
+        Entity e = world.CreateEntity("Zombie");
+        auto& anim = world.AddComponent<AnimatorComponent>(e);
+        anim.Animations = GetCompressedSet();
+        anim.CurrentClip = ClipName(i);
+        anim.CurrentTime = (f32)i * 0.001f;
+    }
+    BonePaletteBuffer palette;
+    AnimationSystem system;
+    system.SetPalette(&palette);
+    for (auto _ : state) {
+        system.Update(world, 1.0f / 60.0f);
+        benchmark::DoNotOptimize(palette.Data(0));
+    }
+    state.SetItemsProcessed(state.iterations() * CHARACTERS);
+    state.counters["palette_kb"] = (f64)palette.GetUsed() * sizeof(AffineTransform) / 1024.0;
+}
+BENCHMARK(BM_Animation_Palette)->Unit(benchmark::kMillisecond);
+
+static void BM_Animation_LOD(benchmark::State& state) {
+    u32 mode = (u32)state.range(0);
+    ECSWorld world;
+    for (u32 i = 0; i < CHARACTERS; i++) {
+        Entity e = world.CreateEntity("Zombie");
+        f32 distance = 200.0f * (f32)i / CHARACTERS;
+        f32 side = (mode == 2 && i % 2) ? -1.0f : 1.0f;   // 模式 2: 奇数号放到相机背后
+        world.AddComponent<TransformComponent>(e).WorldMatrix =
+            glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, -distance * side));
+        auto& anim = world.AddComponent<AnimatorComponent>(e);
+        anim.Animations = GetCompressedSet();
+        anim.CurrentClip = ClipName(i);
+        anim.CurrentTime = (f32)i * 0.001f;
+    }
+
+    Frustum frustum;
+    frustum.ExtractFromVP(glm::perspective(glm::radians(60.0f), 16.0f / 9.0f, 0.1f, 500.0f) *
+                          glm::lookAt(glm::vec3(0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0)));
+    AnimationSystem system;
+    AnimationLODSettings lod;
+    if (mode == 1) lod.FrameBudgetMs = 1.0f;
+    system.SetLODSettings(lod);
+    system.SetView({glm::vec3(0), 0.0f, mode == 2 ? &frustum : nullptr});
+
+    u64 evaluated = 0, interpolated = 0;
+    for (auto _ : state) {
+        system.Update(world, 1.0f / 60.0f);
+        evaluated += system.GetStats().Evaluated;
+        interpolated += system.GetStats().Interpolated;
+    }
+    state.SetItemsProcessed(state.iterations() * CHARACTERS);
+    state.counters["evaluated"] = (f64)evaluated / (f64)state.iterations();
+    state.counters["interpolated"] = (f64)interpolated / (f64)state.iterations();
+}
+BENCHMARK(BM_Animation_LOD)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond);
+
+// ── 单实例采样 (每骨骼耗时) ─────────────────────────────────
+// sec_per_bone 以 SI 后缀显示 (如 25n = 25 ns)
+
+namespace {
+
+void ReportPerBone(benchmark::State& state, u32 clipBytes) {
+    state.counters["sec_per_bone"] = benchmark::Counter(
+        (f64)state.iterations() * BONES, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+    state.counters["clip_bytes"] = (f64)clipBytes;
+}
+
+} // namespace
+
+static void BM_AnimSample_Raw(benchmark::State& state) {
+    auto set = GetAnimationSet();
+    const AnimationClip& clip = set->Clips[1];
+    std::vector<BonePose> pose(BONES);
+    f32 time = 0.0f;
+    for (auto _ : state) {
+        time = std::fmod(time + 1.0f / 60.0f, clip.Duration);
+        AnimationSampler::SamplePose(clip, time, *set->SkeletonData, pose.data());
+        benchmark::DoNotOptimize(pose.data());
+    }
+    u32 bytes = 0;
+    for (const auto& ch : clip.Channels) {
+        bytes += (u32)(ch.PositionKeys.size() * sizeof(PositionKey) +
+                       ch.RotationKeys.size() * sizeof(RotationKey) + ch.ScaleKeys.size() * sizeof(ScaleKey));
+    }
+    ReportPerBone(state, bytes);
+}
+BENCHMARK(BM_AnimSample_Raw);
+
+static void BM_AnimSample_Compressed(benchmark::State& state) {
+    auto set = GetCompressedSet();
+    const CompressedClip& clip = set->Compressed[1];
+    std::vector<BonePose> pose(BONES);
+    AnimationCursor cursor;
+    f32 time = 0.0f;
+    for (auto _ : state) {
+        time = std::fmod(time + 1.0f / 60.0f, clip.GetDuration());
+        clip.Sample(time, cursor, pose.data());
+        benchmark::DoNotOptimize(pose.data());
+    }
+    ReportPerBone(state, clip.GetMemoryUsage());
+}
+BENCHMARK(BM_AnimSample_Compressed);
+
+// ── CPU 蒙皮 ────────────────────────────────────────────────
+
+static void BM_Skinning_Cpu(benchmark::State& state) {
+    constexpr u32 VERTICES = 8192;
+    std::vector<glm::mat4> bones(BONES);
+    for (u32 b = 0; b < BONES; b++) {
+        bones[b] = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0.1f * b, 0)) *
+                   glm::mat4_cast(glm::angleAxis(0.05f * b, glm::vec3(1, 0, 0)));
+    }
+    std::vector<SkinningUtils::SkinVertex> src(VERTICES), dst(VERTICES);
+    for (u32 i = 0; i < VERTICES; i++) {
+        auto& v = src[i];
+        v.Position = {std::sin((f32)i), 0.001f * i, std::cos((f32)i)};
+        v.Normal = glm::normalize(v.Position + glm::vec3(0, 1, 0));
+        v.Tangent = {1, 0, 0};
+        v.Bitangent = {0, 0, 1};
+        for (int k = 0; k < 4; k++) v.BoneIDs[k] = (i32)((i / 64 + k) % BONES);
+        v.Weights[0] = 0.4f; v.Weights[1] = 0.3f; v.Weights[2] = 0.2f; v.Weights[3] = 0.1f;
+    }
+    for (auto _ : state) {
+        SkinningUtils::SkinVertices(src.data(), VERTICES, bones.data(), BONES, dst.data());
+        benchmark::DoNotOptimize(dst.data());
+    }
+    state.counters["sec_per_vertex"] = benchmark::Counter(
+        (f64)state.iterations() * VERTICES, benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_Skinning_Cpu);
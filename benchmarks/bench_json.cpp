@@ -0,0 +1,174 @@
+/**
+ * @file bench_json.cpp
+ * @brief JSON 解析基准: 引擎 JsonDocument vs nlohmann::json
+ *
+ * 两类输入 (均在内存中生成，不含磁盘 IO):
+ *   - LDtk 风格关卡: 大量 {"px":[x,y],"src":[u,v],"f":0,...} 瓦片对象 + intGridCsv
+ *   - SceneSerializer 输出的 10 万实体场景
+ * "Parse" 只建立文档; "Walk" 额外遍历全部值 (与加载器的实际访问模式一致)。
+ */
+
+#include <benchmark/benchmark.h>
+#include "engine/core/json.h"
+#include "engine/core/scene_serializer.h"
+#include "engine/core/components.h"
+#include "engine/core/log.h"
+
+#include <nlohmann/json.hpp>
+
+using namespace Engine;
+
+namespace {
+
+/// 约 9 MB 的 LDtk 风格项目 (8 个关卡，每关 1.6 万瓦片 + 256x256 IntGrid)
+std::string BuildLdtkJson() {
+    std::string out;
+    out.reserve(24u << 20);
+    out += "{\"defaultGridSize\":16,\"defs\":{\"tilesets\":[{\"uid\":1,\"relPath\":\"tiles.png\","
+           "\"pxWid\":512,\"pxHei\":512}]},\"levels\":[";
+    for (u32 lvl = 0; lvl < 8; lvl++) {
+        if (lvl) out += ',';
+        out += "{\"identifier\":\"Level_" + std::to_string(lvl) + "\",\"uid\":" + std::to_string(lvl) +
+               ",\"worldX\":0,\"worldY\":0,\"pxWid\":4096,\"pxHei\":4096,\"layerInstances\":[";
+        out += "{\"__identifier\":\"Ground\",\"__type\":\"AutoLayer\",\"__gridSize\":16,"
+               "\"__cWid\":256,\"__cHei\":256,\"__tilesetDefUid\":1,\"autoLayerTiles\":[";
+        for (u32 i = 0; i < 256 * 64; i++) {
+            if (i) out += ',';
+            u32 x = (i % 256) * 16, y = (i / 256) * 16;
+            out += "{\"px\":[" + std::to_string(x) + "," + std::to_string(y) + "],\"src\":[" +
+                   std::to_string((i * 7) % 512) + "," + std::to_string((i * 13) % 512) +
+                   "],\"f\":" + std::to_string(i % 4) + ",\"t\":" + std::to_string(i % 1024) +
+                   ",\"d\":[" + std::to_string(lvl) + "," + std::to_string(i) + "],\"a\":1}";
+        }
+        out += "],\"intGridCsv\":[";
+        for (u32 i = 0; i < 256 * 256; i++) {
+            if (i) out += ',';
+            out += (i % 17 == 0) ? '1' : '0';
+        }
+        out += "]}]}";
+    }
+    out += "]}";
+    return out;
+}
+
+const std::string& GetLdtkJson() {
+    static std::string json = BuildLdtkJson();
+    return json;
+}
+
+const std::string& GetSceneJson() {
+    static std::string json = [] {
+        Logger::SetLevel(LogLevel::Warn);
+        Scene scene("BenchScene");
+        auto& world = scene.GetWorld();
+        for (u32 i = 0; i < 100000; i++) {
+            Entity e = scene.CreateEntity("Entity_" + std::to_string(i));
+            auto& tr = world.AddComponent<TransformComponent>(e);
+            tr.X = (f32)(i % 317) * 0.37f;
+            tr.RotY = (f32)i * 0.01f;
+            world.AddComponent<RenderComponent>(e).ColorR = (f32)(i % 255) / 255.0f;
+            if (i % 3 == 0) world.AddComponent<HealthComponent>(e).Current = 75.5f;
+        }
+        return SceneSerializer::SaveToString(scene);
+    }();
+    return json;
+}
+
+/// 遍历所有值，数值做一次转换，防止只测到惰性解析
+f64 Walk(JsonValue v) {
+    switch (v.GetType()) {
+        case JsonType::Number: return v.AsF64();
+        case JsonType::String: return (f64)v.AsStringView().size();
+        case JsonType::Array: {
+            f64 sum = 0.0;
+            for (JsonValue e : v.Elements()) sum += Walk(e);
+            return sum;
+        }
+        case JsonType::Object: {
+            f64 sum = 0.0;
+            for (const auto& m : v.Members()) sum += Walk(m.Value);
+            return sum;
+        }
+        default: return 0.0;
+    }
+}
+
+f64 Walk(const nlohmann::json& v) {
+    if (v.is_number()) return v.get<f64>();
+    if (v.is_string()) return (f64)v.get_ref<const std::string&>().size();
+    f64 sum = 0.0;
+    if (v.is_structured()) {
+        for (const auto& e : v) sum += Walk(e);
+    }
+    return sum;
+}
+
+const std::string& Input(benchmark::State& state) {
+    return state.range(0) == 0 ? GetLdtkJson() : GetSceneJson();
+}
+
+void SetLabel(benchmark::State& state, size_t bytes) {
+    state.SetLabel(state.range(0) == 0 ? "ldtk" : "scene");
+    state.SetBytesProcessed((i64)(state.iterations() * bytes));
+}
+
+} // namespace
+
+// ── 仅解析 ──────────────────────────────────────────────────
+
+static void BM_JsonParse_Engine(benchmark::State& state) {
+    const std::string& json = Input(state);
+    for (auto _ : state) {
+        JsonDocument doc;
+        bool ok = doc.Parse(std::string_view(json));
+        benchmark::DoNotOptimize(ok);
+    }
+    SetLabel(state, json.size());
+}
+BENCHMARK(BM_JsonParse_Engine)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_JsonParse_Nlohmann(benchmark::State& state) {
+    const std::string& json = Input(state);
+    for (auto _ : state) {
+        auto doc = nlohmann::json::parse(json);
+        benchmark::DoNotOptimize(doc.size());
+    }
+    SetLabel(state, json.size());
+}
+BENCHMARK(BM_JsonParse_Nlohmann)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ── 解析 + 全量遍历 ─────────────────────────────────────────
+
+static void BM_JsonWalk_Engine(benchmark::State& state) {
+    const std::string& json = Input(state);
+    for (auto _ : state) {
+        JsonDocument doc;
+        doc.Parse(std::string_view(json));
+        benchmark::DoNotOptimize(Walk(doc.GetRoot()));
+    }
+    SetLabel(state, json.size());
+}
+BENCHMARK(BM_JsonWalk_Engine)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_JsonWalk_Nlohmann(benchmark::State& state) {
+    const std::string& json = Input(state);
+    for (auto _ : state) {
+        auto doc = nlohmann::json::parse(json);
+        benchmark::DoNotOptimize(Walk(doc));
+    }
+    SetLabel(state, json.size());
+}
+BENCHMARK(BM_JsonWalk_Nlohmann)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// ── 结构索引 (第一阶段) 吞吐 ────────────────────────────────
+
+static void BM_JsonStructuralIndex(benchmark::State& state) {
+    const std::string& json = GetLdtkJson();
+    std::vector<u32> positions;
+    for (auto _ : state) {
+        JsonDocument::BuildStructuralIndex(json, positions);
+        benchmark::DoNotOptimize(positions.data());
+    }
+    state.SetBytesProcessed((i64)(state.iterations() * json.size()));
+}
+BENCHMARK(BM_JsonStructuralIndex)->Unit(benchmark::kMillisecond);
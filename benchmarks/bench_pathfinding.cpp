@@ -0,0 +1,415 @@
+/**
+ * @file bench_pathfinding.cpp
+ * @brief 寻路基准: GameMap::Generate(512, 512) 生成的导航网格上的 A* 查询
+ *
+ * 每个基准跑固定的 64 对随机可走起终点 (种子固定)，报告单次查询耗时。
+ * Legacy 为旧版 NavGrid::FindPath 的逐字实现: 每次查询重置全部节点、std::priority_queue
+ * 重复入堆、unordered_set 关闭列表、每次展开返回新的邻居 vector。
+ * Stamped 为当前 A* (代号标记 + 带索引的二叉堆 + 复用的工作缓冲)。
+ * JumpPoint / Hierarchical 为同一网格切换到 JPS+ / HPA* 模式；cost 为相对 A* 最短路径的平均代价比。
+ * Short 为 3 格以内的短路径，体现每次查询与网格大小无关。expanded 为平均展开节点数。
+ * Build 为两种模式加速数据的构建耗时。Edit 为地图中央放下/拆掉一座 2×2 的墙后
+ * UpdateSearchData 的耗时 (只修复改动区域)。
+ * Horde 为 N 个单位追同一目标 (目标周围 40 格内随机分布): 每个单位各自 JPS+ 查询，
+ * 或者算一张半径 48 格的流场 (FlowField) 后每个单位查一次方向。FlowFieldFull 为整张网格的积分，
+ * FlowFieldEdit 为放下/拆掉同一座墙后整张流场重算与局部修复 (Repair) 的对比。
+ * QueueBurst 为同样 N 个单位一次性向 PathRequestQueue 提交 JPS+ 请求，只计主线程的
+ * 提交 + 派发耗时 (求解在工作线程上，不计入)。
+ */
+
+#include <benchmark/benchmark.h>
+#include "engine/ai/behavior_tree.h"
+#include "engine/ai/flow_field.h"
+#include "engine/ai/path_request_queue.h"
+#include "engine/core/job_system.h"
+#include "game/game_map.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <queue>
+#include <random>
+#include <unordered_set>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+constexpr u32 MAP_SIZE = 512;
+constexpr u32 QUERIES = 64;
+
+const NavGrid& GetGrid(NavSearchMode mode = NavSearchMode::AStar) {
+    static GameMap map = [] {
+        std::srand(1234);
+        GameMap m;
+        m.Generate(MAP_SIZE, MAP_SIZE);
+        m.GetNavGrid().SetSearchMode(NavSearchMode::AStar);
+        return m;
+    }();
+    static NavGrid jumpPoint = [] {
+        NavGrid grid = map.GetNavGrid();
+        grid.SetSearchMode(NavSearchMode::JumpPoint);
+        return grid;
+    }();
+    static NavGrid hierarchical = [] {
+        NavGrid grid = map.GetNavGrid();
+        grid.SetSearchMode(NavSearchMode::Hierarchical);
+        return grid;
+    }();
+    switch (mode) {
+        case NavSearchMode::JumpPoint:    return jumpPoint;
+        case NavSearchMode::Hierarchical: return hierarchical;
+        case NavSearchMode::AStar:        break;
+    }
+    return map.GetNavGrid();
+}
+
+f32 PathCost(const std::vector<glm::ivec2>& path) {
+    f32 cost = 0.0f;
+    for (size_t i = 1; i < path.size(); i++) {
+        cost += (path[i].x != path[i - 1].x && path[i].y != path[i - 1].y) ? 1.414f : 1.0f;
+    }
+    return cost;
+}
+
+using Query = std::pair<glm::ivec2, glm::ivec2>;
+
+std::vector<Query> MakeQueries(const NavGrid& grid, i32 maxDistance) {
+    std::mt19937 rng(99);
+    std::uniform_int_distribution<i32> coord(0, MAP_SIZE - 1), offset(-maxDistance, maxDistance);
+    std::vector<Query> queries;
+    while (queries.size() < QUERIES) {
+        glm::ivec2 s = {coord(rng), coord(rng)};
+        glm::ivec2 g = maxDistance > 0 ? s + glm::ivec2(offset(rng), offset(rng)) : glm::ivec2(coord(rng), coord(rng));
+        if (!grid.IsWalkable(s.x, s.y) || !grid.IsWalkable(g.x, g.y)) continue;
+        queries.push_back({s, g});
+    }
+    return queries;
+}
+
+// ── 旧版实现 (对照) ─────────────────────────────────────────
+
+struct LegacyNode {
+    i32 X, Y;
+    f32 GCost = 0, HCost = 0;
+    f32 FCost() const { return GCost + HCost; }
+    LegacyNode* Parent = nullptr;
+    bool Walkable = true;
+};
+
+class LegacyGrid {
+public:
+    explicit LegacyGrid(const NavGrid& grid) : m_Width(grid.GetWidth()), m_Height(grid.GetHeight()) {
+        m_Nodes.resize((size_t)m_Width * m_Height);
+        for (u32 y = 0; y < m_Height; y++) {
+            for (u32 x = 0; x < m_Width; x++) {
+                LegacyNode& n = m_Nodes[y * m_Width + x];
+                n.X = (i32)x; n.Y = (i32)y;
+                n.Walkable = grid.IsWalkable((i32)x, (i32)y);
+            }
+        }
+    }
+
+    size_t FindPath(glm::ivec2 s, glm::ivec2 e) {
+        LegacyNode* startNode = GetNode(s.x, s.y);
+        LegacyNode* endNode = GetNode(e.x, e.y);
+        if (!startNode || !endNode || !startNode->Walkable || !endNode->Walkable) return 0;
+        for (auto& node : m_Nodes) { node.GCost = 1e9f; node.HCost = 0; node.Parent = nullptr; }
+
+        auto cmp = [](LegacyNode* a, LegacyNode* b) { return a->FCost() > b->FCost(); };
+        std::priority_queue<LegacyNode*, std::vector<LegacyNode*>, decltype(cmp)> openSet(cmp);
+        struct PairHash {
+            size_t operator()(const std::pair<i32, i32>& p) const {
+                return std::hash<i32>()(p.first) ^ (std::hash<i32>()(p.second) << 16);
+            }
+        };
+        std::unordered_set<std::pair<i32, i32>, PairHash> closedSet;
+
+        startNode->GCost = 0;
+        startNode->HCost = Heuristic(startNode, endNode);
+        openSet.push(startNode);
+        while (!openSet.empty()) {
+            LegacyNode* current = openSet.top();
+            openSet.pop();
+            if (current == endNode) {
+                std::vector<glm::vec3> path;
+                for (LegacyNode* n = endNode; n; n = n->Parent) path.push_back({n->X + 0.5f, 0.0f, n->Y + 0.5f});
+                std::reverse(path.begin(), path.end());
+                return path.size();
+            }
+            closedSet.insert({current->X, current->Y});
+            for (LegacyNode* neighbor : GetNeighbors(current)) {
+                if (closedSet.count({neighbor->X, neighbor->Y})) continue;
+                f32 dx = std::abs((f32)(neighbor->X - current->X));
+                f32 dy = std::abs((f32)(neighbor->Y - current->Y));
+                f32 newG = current->GCost + ((dx + dy > 1.5f) ? 1.414f : 1.0f);
+                if (newG < neighbor->GCost) {
+                    neighbor->GCost = newG;
+                    neighbor->HCost = Heuristic(neighbor, endNode);
+                    neighbor->Parent = current;
+                    openSet.push(neighbor);
+                }
+            }
+        }
+        return 0;
+    }
+
+private:
+    LegacyNode* GetNode(i32 x, i32 y) {
+        if (x < 0 || x >= (i32)m_Width || y < 0 || y >= (i32)m_Height) return nullptr;
+        return &m_Nodes[y * m_Width + x];
+    }
+    bool IsWalkable(i32 x, i32 y) { LegacyNode* n = GetNode(x, y); return n && n->Walkable; }
+    std::vector<LegacyNode*> GetNeighbors(LegacyNode* node) {
+        std::vector<LegacyNode*> neighbors;
+        static const i32 dx[] = {-1, 0, 1, -1, 1, -1, 0, 1};
+        static const i32 dy[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+        for (int i = 0; i < 8; i++) {
+            LegacyNode* n = GetNode(node->X + dx[i], node->Y + dy[i]);
+            if (n && n->Walkable) {
+                if (dx[i] != 0 && dy[i] != 0 &&
+                    (!IsWalkable(node->X + dx[i], node->Y) || !IsWalkable(node->X, node->Y + dy[i]))) continue;
+                neighbors.push_back(n);
+            }
+        }
+        return neighbors;
+    }
+    static f32 Heuristic(LegacyNode* a, LegacyNode* b) {
+        f32 dx = std::abs((f32)(a->X - b->X)), dy = std::abs((f32)(a->Y - b->Y));
+        return (dx + dy) + (1.414f - 2.0f) * std::min(dx, dy);
+    }
+
+    u32 m_Width, m_Height;
+    std::vector<LegacyNode> m_Nodes;
+};
+
+void RunLegacy(benchmark::State& state, i32 maxDistance) {
+    const NavGrid& grid = GetGrid();
+    LegacyGrid legacy(grid);
+    auto queries = MakeQueries(grid, maxDistance);
+    u32 q = 0;
+    for (auto _ : state) {
+        const Query& query = queries[q++ % QUERIES];
+        benchmark::DoNotOptimize(legacy.FindPath(query.first, query.second));
+    }
+}
+
+void RunStamped(benchmark::State& state, i32 maxDistance, NavSearchMode mode = NavSearchMode::AStar) {
+    const NavGrid& grid = GetGrid(mode);
+    auto queries = MakeQueries(grid, maxDistance);
+    NavSearchState search;
+    std::vector<glm::ivec2> path;
+    u32 q = 0;
+    u64 expanded = 0;
+    for (auto _ : state) {
+        const Query& query = queries[q++ % QUERIES];
+        grid.FindPath(query.first, query.second, path, search);
+        expanded += search.GetExpandedCount();
+        benchmark::DoNotOptimize(path.data());
+    }
+    state.counters["expanded"] = benchmark::Counter((f64)expanded, benchmark::Counter::kAvgIterations);
+
+    // 与 A* 最短路径的代价比 (计时之外)
+    if (mode != NavSearchMode::AStar) {
+        f64 ratio = 0.0;
+        u32 found = 0;
+        for (const Query& query : queries) {
+            if (!grid.FindPath(query.first, query.second, path, search)) continue;
+            f32 cost = PathCost(path);
+            GetGrid().FindPath(query.first, query.second, path, search);
+            ratio += PathCost(path) > 0.0f ? cost / PathCost(path) : 1.0;
+            found++;
+        }
+        state.counters["cost"] = found ? ratio / found : 1.0;
+    }
+}
+
+} // namespace
+
+static void BM_Pathfinding_Legacy(benchmark::State& state) { RunLegacy(state, 0); }
+BENCHMARK(BM_Pathfinding_Legacy)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_Stamped(benchmark::State& state) { RunStamped(state, 0); }
+BENCHMARK(BM_Pathfinding_Stamped)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_LegacyShort(benchmark::State& state) { RunLegacy(state, 3); }
+BENCHMARK(BM_Pathfinding_LegacyShort)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_StampedShort(benchmark::State& state) { RunStamped(state, 3); }
+BENCHMARK(BM_Pathfinding_StampedShort)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_JumpPoint(benchmark::State& state) { RunStamped(state, 0, NavSearchMode::JumpPoint); }
+BENCHMARK(BM_Pathfinding_JumpPoint)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_Hierarchical(benchmark::State& state) { RunStamped(state, 0, NavSearchMode::Hierarchical); }
+BENCHMARK(BM_Pathfinding_Hierarchical)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_JumpPointShort(benchmark::State& state) {
+    RunStamped(state, 3, NavSearchMode::JumpPoint);
+}
+BENCHMARK(BM_Pathfinding_JumpPointShort)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_HierarchicalShort(benchmark::State& state) {
+    RunStamped(state, 3, NavSearchMode::Hierarchical);
+}
+BENCHMARK(BM_Pathfinding_HierarchicalShort)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_Build(benchmark::State& state) {
+    NavGrid grid = GetGrid();
+    NavSearchMode mode = (NavSearchMode)state.range(0);
+    for (auto _ : state) grid.SetSearchMode(mode);
+    state.SetLabel(mode == NavSearchMode::JumpPoint ? "JPS+" : "HPA*");
+    if (mode == NavSearchMode::Hierarchical) state.counters["nodes"] = grid.GetAbstractNodeCount();
+}
+BENCHMARK(BM_Pathfinding_Build)
+    ->Arg((i64)NavSearchMode::JumpPoint)
+    ->Arg((i64)NavSearchMode::Hierarchical)
+    ->Unit(benchmark::kMillisecond);
+
+/// 在地图中央找一块 2×2 全可走的位置 (放一座墙)
+static glm::ivec2 FindWallSpot(const NavGrid& grid) {
+    for (i32 y = 250; y < 400; y++) {
+        for (i32 x = 250; x < 400; x++) {
+            if (grid.IsWalkable(x, y) && grid.IsWalkable(x + 1, y) && grid.IsWalkable(x, y + 1) &&
+                grid.IsWalkable(x + 1, y + 1)) {
+                return {x, y};
+            }
+        }
+    }
+    return {256, 256};
+}
+
+static void SetWall(NavGrid& grid, glm::ivec2 p, bool walkable) {
+    for (i32 dy = 0; dy < 2; dy++) {
+        for (i32 dx = 0; dx < 2; dx++) grid.SetWalkable(p.x + dx, p.y + dy, walkable);
+    }
+}
+
+static void BM_Pathfinding_Edit(benchmark::State& state) {
+    NavGrid grid = GetGrid();
+    NavSearchMode mode = (NavSearchMode)state.range(0);
+    grid.SetSearchMode(mode);
+    glm::ivec2 spot = FindWallSpot(grid);
+    bool walkable = false;
+    for (auto _ : state) {
+        SetWall(grid, spot, walkable);
+        grid.UpdateSearchData();
+        walkable = !walkable;
+    }
+    state.SetLabel(mode == NavSearchMode::JumpPoint ? "JPS+" : "HPA*");
+}
+BENCHMARK(BM_Pathfinding_Edit)
+    ->Arg((i64)NavSearchMode::JumpPoint)
+    ->Arg((i64)NavSearchMode::Hierarchical)
+    ->Unit(benchmark::kMicrosecond);
+
+// ── 追同一目标的大量单位 ────────────────────────────────────
+
+namespace {
+
+constexpr glm::ivec2 HORDE_GOAL = {256, 256};
+
+std::vector<glm::ivec2> MakeHorde(const NavGrid& grid, u32 count) {
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<i32> offset(-40, 40);
+    std::vector<glm::ivec2> agents;
+    while (agents.size() < count) {
+        glm::ivec2 p = HORDE_GOAL + glm::ivec2(offset(rng), offset(rng));
+        if (grid.IsWalkable(p.x, p.y)) agents.push_back(p);
+    }
+    return agents;
+}
+
+glm::ivec2 WalkableGoal(const NavGrid& grid) {
+    glm::ivec2 goal = HORDE_GOAL;
+    while (!grid.IsWalkable(goal.x, goal.y)) goal.x++;
+    return goal;
+}
+
+} // namespace
+
+static void BM_Pathfinding_HordeAStar(benchmark::State& state) {
+    const NavGrid& grid = GetGrid(NavSearchMode::JumpPoint);
+    auto agents = MakeHorde(grid, (u32)state.range(0));
+    glm::ivec2 goal = WalkableGoal(grid);
+    NavSearchState search;
+    std::vector<glm::ivec2> path;
+    for (auto _ : state) {
+        for (const glm::ivec2& a : agents) {
+            grid.FindPath(a, goal, path, search);
+            benchmark::DoNotOptimize(path.data());
+        }
+    }
+}
+BENCHMARK(BM_Pathfinding_HordeAStar)->Arg(100)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_HordeFlowField(benchmark::State& state) {
+    const NavGrid& grid = GetGrid();
+    auto agents = MakeHorde(grid, (u32)state.range(0));
+    glm::ivec2 goal = WalkableGoal(grid);
+    FlowField field;
+    for (auto _ : state) {
+        field.Compute(grid, goal, 48.0f);
+        glm::ivec2 sum = {0, 0};
+        for (const glm::ivec2& a : agents) sum += field.GetDirection(a.x, a.y);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.counters["cells"] = field.GetReachedCount();
+}
+BENCHMARK(BM_Pathfinding_HordeFlowField)->Arg(100)->Arg(500)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_FlowFieldEdit(benchmark::State& state) {
+    NavGrid grid = GetGrid();
+    glm::ivec2 goal = WalkableGoal(grid);
+    glm::ivec2 spot = FindWallSpot(grid);
+    bool repair = state.range(0) != 0;
+    FlowField field;
+    field.Compute(grid, goal);
+    bool walkable = false;
+    for (auto _ : state) {
+        u32 before = grid.GetRevision();
+        SetWall(grid, spot, walkable);
+        walkable = !walkable;
+        glm::ivec2 lo, hi;
+        grid.GetChangedRegion(before, lo, hi);
+        if (repair) field.Repair(grid, lo, hi);
+        else        field.Compute(grid, goal);
+    }
+    state.SetLabel(repair ? "repair" : "recompute");
+}
+BENCHMARK(BM_Pathfinding_FlowFieldEdit)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+static void BM_Pathfinding_FlowFieldFull(benchmark::State& state) {
+    const NavGrid& grid = GetGrid();
+    glm::ivec2 goal = WalkableGoal(grid);
+    FlowField field;
+    for (auto _ : state) field.Compute(grid, goal);
+    state.counters["cells"] = field.GetReachedCount();
+}
+BENCHMARK(BM_Pathfinding_FlowFieldFull)->Unit(benchmark::kMillisecond);
+
+static void BM_Pathfinding_QueueBurst(benchmark::State& state) {
+    const NavGrid& grid = GetGrid(NavSearchMode::JumpPoint);
+    u32 count = (u32)state.range(0);
+    auto agents = MakeHorde(grid, count);
+    glm::ivec2 goal = WalkableGoal(grid);
+
+    JobSystem::Init();
+    PathRequestQueue queue;
+    queue.SetNavGrid(&grid);
+    queue.SetConfig({count, count, 1.0f});
+    queue.Update();   // 先建好快照
+    PathResult result;
+    for (auto _ : state) {
+        for (u32 i = 0; i < count; i++) queue.Submit(i, agents[i], goal, -(f32)i);
+        queue.Update();
+
+        state.PauseTiming();
+        queue.WaitIdle();
+        while (queue.PopResult(result)) benchmark::DoNotOptimize(result.Cells.data());
+        state.ResumeTiming();
+    }
+    JobSystem::Shutdown();
+}
+BENCHMARK(BM_Pathfinding_QueueBurst)->Arg(100)->Arg(500)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,108 @@
+/**
+ * @file bench_scene_serializer.cpp
+ * @brief 场景序列化基准: JSON vs 二进制
+ *
+ * 10 万实体场景的内存内保存/加载耗时 (不含磁盘 IO)。
+ */
+
+#include <benchmark/benchmark.h>
+#include "engine/core/scene_serializer.h"
+#include "engine/core/components.h"
+#include "engine/core/log.h"
+
+using namespace Engine;
+
+namespace {
+
+constexpr u32 ENTITY_COUNT = 100000;
+
+Ref<Scene> BuildScene(u32 count) {
+    Logger::SetLevel(LogLevel::Warn);
+
+    auto scene = CreateRef<Scene>("BenchScene");
+    auto& world = scene->GetWorld();
+    for (u32 i = 0; i < count; i++) {
+        Entity e = scene->CreateEntity("Entity_" + std::to_string(i));
+
+        auto& tr = world.AddComponent<TransformComponent>(e);
+        tr.X = (f32)(i % 317) * 0.37f;
+        tr.Z = (f32)(i / 317) * 0.37f;
+        tr.RotY = (f32)i * 0.01f;
+
+        auto& rc = world.AddComponent<RenderComponent>(e);
+        rc.MeshType = (i % 2) ? "cube" : "sphere";
+        rc.ColorR = (f32)(i % 255) / 255.0f;
+
+        if (i % 2 == 0) {
+            auto& mat = world.AddComponent<MaterialComponent>(e);
+            mat.Roughness = 0.25f;
+            mat.TextureName = "stone";
+        }
+        if (i % 3 == 0) {
+            world.AddComponent<HealthComponent>(e).Current = 75.5f;
+            world.AddComponent<VelocityComponent>(e).VX = 1.5f;
+        }
+        if (i % 10 == 0) {
+            auto& ai = world.AddComponent<AIComponent>(e);
+            ai.ScriptModule = "zombie_ai";
+        }
+    }
+    return scene;
+}
+
+const Ref<Scene>& GetScene() {
+    static Ref<Scene> scene = BuildScene(ENTITY_COUNT);
+    return scene;
+}
+
+} // namespace
+
+// ── JSON ────────────────────────────────────────────────────
+
+static void BM_SceneSave_Json(benchmark::State& state) {
+    const auto& scene = GetScene();
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::string json = SceneSerializer::SaveToString(*scene);
+        bytes = json.size();
+        benchmark::DoNotOptimize(json.data());
+    }
+    state.counters["KB"] = (f64)bytes / 1024.0;
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+}
+BENCHMARK(BM_SceneSave_Json)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneLoad_Json(benchmark::State& state) {
+    std::string json = SceneSerializer::SaveToString(*GetScene());
+    for (auto _ : state) {
+        auto loaded = SceneSerializer::LoadFromString(json);
+        benchmark::DoNotOptimize(loaded.get());
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+}
+BENCHMARK(BM_SceneLoad_Json)->Unit(benchmark::kMillisecond);
+
+// ── 二进制 ──────────────────────────────────────────────────
+
+static void BM_SceneSave_Binary(benchmark::State& state) {
+    const auto& scene = GetScene();
+    std::vector<u8> blob;
+    for (auto _ : state) {
+        SceneSerializer::SaveBinaryToMemory(*scene, blob);
+        benchmark::DoNotOptimize(blob.data());
+    }
+    state.counters["KB"] = (f64)blob.size() / 1024.0;
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+}
+BENCHMARK(BM_SceneSave_Binary)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneLoad_Binary(benchmark::State& state) {
+    std::vector<u8> blob;
+    SceneSerializer::SaveBinaryToMemory(*GetScene(), blob);
+    for (auto _ : state) {
+        auto loaded = SceneSerializer::LoadFromMemory(blob.data(), blob.size());
+        benchmark::DoNotOptimize(loaded.get());
+    }
+    state.SetItemsProcessed(state.iterations() * ENTITY_COUNT);
+}
+BENCHMARK(BM_SceneLoad_Binary)->Unit(benchmark::kMillisecond);
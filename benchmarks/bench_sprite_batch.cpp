@@ -0,0 +1,225 @@
+/**
+ * @file bench_sprite_batch.cpp
+ * @brief 精灵批处理基准: 60000 个瓦片 + 2000 个实体精灵的每帧提交与合批
+ *
+ * 瓦片使用 5 种纹理 (按地形交错)，实体精灵使用 40 种纹理。
+ * Legacy 为旧做法: 主线程按提交顺序写顶点，16 个纹理槽用满或 10000 四边形时 Flush。
+ * Sorted 为 SpriteCommandList + SpriteBatchBuilder: 瓦片在层 0、实体在层 1，
+ * 两层都用 Texture 模式，含提交、基数排序、分批与顶点写出；参数为 JobSystem
+ * 工作线程数 (0 = 调用线程串行，否则瓦片按行切块并行提交)。draw_calls 为每帧批次数。
+ * Atlas 为同一场景，45 张纹理先用 AtlasBuilder 打进 2048 图集页并注册 SpriteTextureRemap。
+ * AtlasPack 为把 45 张精灵表 + 95 个字形大小的图像装进 320×320 页 (含像素拷贝) 的
+ * 加载期耗时，occupancy 为含 padding 的装填率。
+ * TileChunks 为同样的 300×200 瓦片烘焙进 TilemapChunkCache 后的每帧 CPU 耗时:
+ * 参数为每帧 SetTile 的次数 (散布在不同区块)，rebuilt 为每帧重建的区块数，
+ * draw_calls 为全部区块的批次数。网格上传与 DrawCall 本身不计入。
+ */
+
+#include <benchmark/benchmark.h>
+#include "engine/renderer/sprite_list.h"
+#include "engine/renderer/atlas_packer.h"
+#include "engine/game2d/tilemap_chunks.h"
+#include "engine/core/job_system.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+constexpr u32 MAP_W = 300;
+constexpr u32 MAP_H = 200;
+constexpr u32 ENTITIES = 2000;
+constexpr u32 TILE_TEXTURES = 5;
+constexpr u32 ENTITY_TEXTURES = 40;
+constexpr u32 LEGACY_MAX_QUADS = 10000;
+constexpr u32 SLOTS = SpriteDrawBatch::MAX_TEXTURE_SLOTS;
+
+u32 TileTexture(u32 x, u32 y) {
+    // 块状地形: 相邻瓦片多为同种纹理，但每行都会出现多种
+    return 1 + ((x / 7 + y / 5 + (x * y) / 97) % TILE_TEXTURES);
+}
+
+u32 EntityTexture(u32 i) { return 100 + (i * 7) % ENTITY_TEXTURES; }
+
+void SubmitTiles(SpriteCommandList& list, u32 rowBegin, u32 rowEnd) {
+    for (u32 y = rowBegin; y < rowEnd; y++) {
+        for (u32 x = 0; x < MAP_W; x++) {
+            list.Draw(TileTexture(x, y), {x * 16.0f, y * 16.0f}, {16.0f, 16.0f},
+                      {0, 0, 1, 1}, 0.0f, glm::vec4(1.0f));
+        }
+    }
+}
+
+void SubmitEntities(SpriteCommandList& list) {
+    for (u32 i = 0; i < ENTITIES; i++) {
+        list.Draw(EntityTexture(i), {(f32)(i % 97) * 40.0f, (f32)(i / 97) * 40.0f}, {32.0f, 32.0f},
+                  {0, 0, 1, 1}, 0.1f * (f32)(i % 5), glm::vec4(1.0f));
+    }
+}
+
+/// 瓦片 16×16 / 实体 32×32 的纯色图像，再加 95 个字形大小的图像
+void AddSceneImages(AtlasBuilder& builder, bool glyphs) {
+    std::vector<u8> pixels(64 * 64 * 4, 255);
+    for (u32 t = 1; t <= TILE_TEXTURES; t++) builder.Add(t, pixels.data(), 16, 16);
+    for (u32 t = 0; t < ENTITY_TEXTURES; t++) builder.Add(100 + t, pixels.data(), 32 + t % 3 * 8, 32);
+    if (!glyphs) return;
+    for (u32 g = 0; g < 95; g++) builder.Add(1000 + g, pixels.data(), 6 + g % 11, 10 + g % 13);
+}
+
+void RunSorted(benchmark::State& state, SpriteBatchBuilder& builder) {
+    constexpr u32 ROW_CHUNKS = 8;
+    std::vector<SpriteCommandList> tileLists(ROW_CHUNKS);
+    SpriteCommandList entityList;
+    std::vector<const SpriteCommandList*> lists;
+    for (auto& l : tileLists) lists.push_back(&l);
+    lists.push_back(&entityList);
+
+    builder.SetLayerSortMode(0, SpriteSortMode::Texture);
+    builder.SetLayerSortMode(1, SpriteSortMode::Texture);
+    std::vector<SpriteVertex> out((size_t)(MAP_W * MAP_H + ENTITIES) * 4);
+
+    for (auto _ : state) {
+        JobSystem::ParallelForRange(ROW_CHUNKS, 1, [&](u32 begin, u32 end) {
+            for (u32 c = begin; c < end; c++) {
+                tileLists[c].Clear();
+                SubmitTiles(tileLists[c], MAP_H * c / ROW_CHUNKS, MAP_H * (c + 1) / ROW_CHUNKS);
+            }
+        });
+        entityList.Clear();
+        entityList.SetLayer(1);
+        SubmitEntities(entityList);
+
+        builder.Build(lists.data(), (u32)lists.size(), LEGACY_MAX_QUADS);
+        JobSystem::ParallelForRange(builder.GetQuadCount(), 4096, [&](u32 begin, u32 end) {
+            builder.WriteVertices(begin, end, out.data() + (size_t)begin * 4);
+        });
+        benchmark::DoNotOptimize(out.data());
+    }
+    state.counters["draw_calls"] = (f64)builder.GetBatches().size();
+}
+
+} // namespace
+
+static void BM_SpriteBatch_Legacy(benchmark::State& state) {
+    std::vector<SpriteVertex> buffer((size_t)LEGACY_MAX_QUADS * 4);
+    u32 drawCalls = 0;
+    for (auto _ : state) {
+        drawCalls = 0;
+        u32 quads = 0, slotCount = 1;
+        u32 slots[SLOTS] = {};
+        auto submit = [&](u32 texture, glm::vec2 pos, glm::vec2 size, f32 rotation) {
+            if (quads >= LEGACY_MAX_QUADS) { drawCalls++; quads = 0; slotCount = 1; }
+            f32 texIndex = 0.0f;
+            for (u32 s = 1; s < slotCount; s++) {
+                if (slots[s] == texture) { texIndex = (f32)s; break; }
+            }
+            if (texIndex == 0.0f) {
+                if (slotCount >= SLOTS) { drawCalls++; quads = 0; slotCount = 1; }
+                slots[slotCount] = texture;
+                texIndex = (f32)slotCount++;
+            }
+            f32 c = std::cos(rotation), s = std::sin(rotation);
+            SpriteVertex* v = &buffer[(size_t)quads * 4];
+            glm::vec2 corners[4] = {{0, 0}, {size.x, 0}, {size.x, size.y}, {0, size.y}};
+            for (int i = 0; i < 4; i++) {
+                glm::vec2 p = rotation != 0.0f
+                    ? pos + glm::vec2(corners[i].x * c - corners[i].y * s, corners[i].x * s + corners[i].y * c)
+                    : pos + corners[i];
+                v[i] = {p, corners[i], glm::vec4(1.0f), texIndex};
+            }
+            quads++;
+        };
+        for (u32 y = 0; y < MAP_H; y++) {
+            for (u32 x = 0; x < MAP_W; x++) submit(TileTexture(x, y), {x * 16.0f, y * 16.0f}, {16, 16}, 0.0f);
+        }
+        for (u32 i = 0; i < ENTITIES; i++) {
+            submit(EntityTexture(i), {(f32)(i % 97) * 40.0f, (f32)(i / 97) * 40.0f}, {32, 32}, 0.1f * (f32)(i % 5));
+        }
+        if (quads > 0) drawCalls++;
+        benchmark::DoNotOptimize(buffer.data());
+    }
+    state.counters["draw_calls"] = (f64)drawCalls;
+}
+BENCHMARK(BM_SpriteBatch_Legacy)->Unit(benchmark::kMillisecond);
+
+static void BM_SpriteBatch_Sorted(benchmark::State& state) {
+    u32 threads = (u32)state.range(0);
+    if (threads > 0) JobSystem::Init(threads);
+
+    SpriteBatchBuilder builder;
+    RunSorted(state, builder);
+
+    if (threads > 0) JobSystem::Shutdown();
+}
+BENCHMARK(BM_SpriteBatch_Sorted)->Arg(0)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+static void BM_SpriteBatch_Atlas(benchmark::State& state) {
+    AtlasBuilder atlas(2048, 1);
+    AddSceneImages(atlas, false);
+    atlas.Pack();
+    for (const AtlasEntry& e : atlas.GetEntries()) {
+        SpriteTextureRemap::Set(e.Key, 9000 + e.Page, e.UVRect);
+    }
+
+    SpriteBatchBuilder builder;
+    RunSorted(state, builder);
+    state.counters["pages"] = (f64)atlas.GetPageCount();
+
+    SpriteTextureRemap::Clear();
+}
+BENCHMARK(BM_SpriteBatch_Atlas)->Unit(benchmark::kMillisecond);
+
+static void BM_SpriteBatch_AtlasPack(benchmark::State& state) {
+    f32 occupancy = 0.0f;
+    u32 pages = 0;
+    for (auto _ : state) {
+        AtlasBuilder atlas(320, 1);
+        AddSceneImages(atlas, true);
+        atlas.Pack();
+        occupancy = atlas.GetPageOccupancy(0);
+        pages = atlas.GetPageCount();
+        benchmark::DoNotOptimize(atlas.GetPagePixels(0).data());
+    }
+    state.counters["occupancy"] = occupancy;
+    state.counters["pages"] = (f64)pages;
+}
+BENCHMARK(BM_SpriteBatch_AtlasPack)->Unit(benchmark::kMicrosecond);
+
+static void BM_SpriteBatch_TileChunks(benchmark::State& state) {
+    u32 edits = (u32)state.range(0);
+    JobSystem::Init(4);
+
+    Tilemap map(MAP_W, MAP_H, 16);
+    map.AddLayer("ground");
+    for (u32 y = 0; y < MAP_H; y++) {
+        for (u32 x = 0; x < MAP_W; x++) map.SetTile(0, x, y, {(u16)TileTexture(x, y)});
+    }
+    TilemapChunkCache cache;
+    cache.SetMesher([](const Tilemap& m, u32 layer, u32 x, u32 y, SpriteCommandList& out) {
+        out.Draw(m.GetTile(layer, x, y).TileID, {(f32)x, (f32)y}, {1.0f, 1.0f},
+                 {0, 0, 1, 1}, 0.0f, glm::vec4(1.0f));
+    });
+    cache.Rebuild(map);
+
+    u32 rebuilt = 0, frame = 0;
+    for (auto _ : state) {
+        for (u32 i = 0; i < edits; i++) {
+            u32 x = (frame * 37 + i * 71) % MAP_W, y = (frame * 13 + i * 43) % MAP_H;
+            map.SetTile(0, x, y, {(u16)(1 + (map.GetTile(0, x, y).TileID % TILE_TEXTURES))});
+        }
+        rebuilt = cache.Rebuild(map);
+        frame++;
+    }
+
+    u32 drawCalls = 0;
+    for (u32 cy = 0; cy < cache.GetChunkCountY(); cy++) {
+        for (u32 cx = 0; cx < cache.GetChunkCountX(); cx++) drawCalls += (u32)cache.GetChunk(0, cx, cy).Batches.size();
+    }
+    state.counters["rebuilt"] = (f64)rebuilt;
+    state.counters["draw_calls"] = (f64)drawCalls;
+
+    JobSystem::Shutdown();
+}
+BENCHMARK(BM_SpriteBatch_TileChunks)->Arg(0)->Arg(1)->Arg(16)->UseRealTime()->Unit(benchmark::kMicrosecond);
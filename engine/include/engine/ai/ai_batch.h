@@ -0,0 +1,123 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/ai/python_engine.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+namespace AI {
+
+// ── 批量 AI 上下文 ──────────────────────────────────────────
+//
+// 同一脚本模块的所有 agent 每帧只调用一次 Python: update_ai_batch(batch)。
+// 上下文打包成几张结构数组表 (每列连续存放)，通过缓冲协议以 memoryview 交给 Python，
+// 不做 JSON 序列化/解析，脚本可逐列读取或直接 numpy.frombuffer；动作写回同样布局的结果表，
+// 只有自定义动作和下发命令这两个字符串以 [(row, custom, order), ...] 返回。
+//
+// 列编号必须与 ai/scripts/ai_batch.py 一致。
+
+/// 一张结构数组表: 浮点列与整数列各一个缓冲，第 c 列占 [c * Rows, (c + 1) * Rows)
+struct AIBatchTable {
+    u32 Rows = 0;
+    std::vector<f32> Floats;
+    std::vector<i32> Ints;
+
+    void Resize(u32 rows, u32 floatCols, u32 intCols) {
+        Rows = rows;
+        Floats.assign((size_t)rows * floatCols, 0.0f);
+        Ints.assign((size_t)rows * intCols, 0);
+    }
+    f32& F(u32 col, u32 row) { return Floats[(size_t)col * Rows + row]; }
+    i32& I(u32 col, u32 row) { return Ints[(size_t)col * Rows + row]; }
+    f32 F(u32 col, u32 row) const { return Floats[(size_t)col * Rows + row]; }
+    i32 I(u32 col, u32 row) const { return Ints[(size_t)col * Rows + row]; }
+};
+
+class AIBatch {
+public:
+    // ── 列定义 ───────────────────────────────────
+    /// 每个 agent 一行。Order 为 Orders 列表下标 (-1 = 无命令)，敌人/队友为对应表的区间
+    struct Agent {
+        enum : u32 { PosX, PosY, PosZ, RotY, Health, MaxHealth, DetectRange, AttackRange,
+                     MoveSpeed, DeltaTime, FrameDeltaTime, FloatCount };
+        enum : u32 { EntityID, State, Role, SquadID, SquadSize, SquadAlive, Order,
+                     EnemyBegin, EnemyCount, AllyBegin, AllyCount, HasPlayer, IntCount };
+    };
+    /// 附近实体 (每个 agent 的区间内按距离升序)
+    struct Enemy {
+        enum : u32 { PosX, PosY, PosZ, Health, Dist, FloatCount };
+        enum : u32 { EntityID, IntCount };
+    };
+    /// 同小队队友
+    struct Ally {
+        enum : u32 { PosX, PosY, PosZ, Health, MaxHealth, Dist, FloatCount };
+        enum : u32 { EntityID, State, Role, IntCount };
+    };
+    /// 所有小队概览 (只有指挥官的批次非空)
+    struct Squad {
+        enum : u32 { CenterX, CenterY, CenterZ, AvgHealth, FloatCount };
+        enum : u32 { SquadID, Total, Alive, HasOrder, IntCount };
+    };
+    /// 玩家行为数据 (单行，HasPlayer 的 agent 可见)
+    struct Player {
+        enum : u32 { PosX, PosY, PosZ, VelX, VelY, VelZ, Speed, AvgSpeed, AttackCount,
+                     RetreatCount, Aggression, CombatTime, FloatCount };
+    };
+    /// 结果: Python 写入，初值为当前状态、零移动
+    struct Action {
+        enum : u32 { DirX, DirY, DirZ, Speed, FloatCount };
+        enum : u32 { State, Target, IntCount };
+    };
+
+    /// 角色字符串 ↔ 整数 (soldier=0, leader=1, commander=2)
+    static i32 RoleToInt(const std::string& role);
+
+    /// 清空 (保留容量，每帧复用)
+    void Clear();
+    /// 追加一个 agent 的上下文，返回行号
+    u32 Add(u32 entityID, const AIContext& ctx);
+    /// 把追加的行转成列存储，并按行数准备结果表；调用 Python 前执行一次
+    void Pack();
+
+    u32 GetCount() const { return (u32)m_Entities.size(); }
+    u32 GetEntity(u32 row) const { return m_Entities[row]; }
+    /// Python 返回的字符串结果
+    void SetStrings(u32 row, const std::string& custom, const std::string& order);
+    /// 读取第 row 个 agent 的动作
+    AIAction GetAction(u32 row) const;
+
+    AIBatchTable Agents, Enemies, Allies, Squads, Actions;
+    std::vector<f32> PlayerData = std::vector<f32>(Player::FloatCount, 0.0f);
+    std::vector<std::string> Orders;      // 去重后的命令 JSON (同小队的士兵共用)
+
+private:
+    struct AgentRow {
+        f32 F[Agent::FloatCount];
+        i32 I[Agent::IntCount];
+    };
+    struct EnemyRow {
+        glm::vec3 Position;
+        f32 Health, Distance;
+        u32 EntityID;
+    };
+    struct AllyRow {
+        glm::vec3 Position;
+        f32 Health, MaxHealth, Distance;
+        u32 EntityID;
+        i32 State, Role;
+    };
+
+    std::vector<u32> m_Entities;
+    std::vector<AgentRow> m_AgentRows;
+    std::vector<EnemyRow> m_EnemyRows;
+    std::vector<AllyRow> m_AllyRows;
+    std::vector<AIContext::SquadSummary> m_SquadRows;
+    std::unordered_map<std::string, i32> m_OrderIndex;
+    std::vector<std::string> m_Custom, m_OrderOut;
+};
+
+} // namespace AI
+} // namespace Engine
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/ai/python_engine.h"
+
+#include <vector>
+
+namespace Engine {
+namespace AI {
+
+// ── AI 思考调度 ─────────────────────────────────────────────
+//
+// 不是每个 agent 每帧都重新决策: 思考间隔按角色、到玩家的距离和当前状态决定
+// (战斗中更频繁，Idle/Patrol 更稀)，首次调度按实体 ID 错开相位，避免同间隔的 agent 挤在同一帧。
+// 到期的 agent 多于本帧预算时按优先级取前若干个 (事件唤醒 > 指挥官/队长 > 逾期久的)，
+// 没选上的留到下一帧，逾期越久越靠前。两次思考之间沿用上次的移动 (见 AIManager)。
+//
+// 预算以毫秒计: 用上一帧测得的单 agent 主线程耗时 (指数平均) 换算成本帧可思考的个数。
+
+enum class AIRole : u8 { Soldier = 0, Leader, Commander };
+
+class AIScheduler {
+public:
+    struct Settings {
+        f32 BudgetMs = 2.0f;           // 每帧 AI 主线程预算 (0 = 不限)
+        u32 MinAgentsPerFrame = 8;     // 预算再紧每帧也至少处理这么多
+
+        f32 NearDistance = 30.0f;      // 到玩家距离分档
+        f32 FarDistance = 60.0f;
+        f32 NearInterval = 0.0f;       // 秒；0 = 每帧
+        f32 MidInterval = 0.05f;
+        f32 FarInterval = 0.2f;
+        f32 IdleScale = 3.0f;          // Idle/Patrol 的间隔倍数
+        f32 CombatMaxInterval = 0.05f; // Chase/Attack/Flee 的间隔上限
+
+        f32 LeaderInterval = 0.1f;     // 队长/指挥官不分距离
+        f32 CommanderInterval = 0.25f;
+    };
+
+    struct Candidate {
+        u32 EntityID = 0;
+        f32 Priority = 0;
+        f32 Interval = 0;              // 选中后排下一次用
+    };
+
+    void SetSettings(const Settings& settings) { m_Settings = settings; }
+    const Settings& GetSettings() const { return m_Settings; }
+
+    /// 思考间隔 (秒)
+    f32 GetInterval(AIRole role, f32 distToPlayer, AIState state) const;
+
+    /// 首次调度的剩余时间: 按实体 ID 把相位散布在 [0, interval)
+    static f32 InitialDelay(u32 entityID, f32 interval);
+
+    /// 候选优先级: overdue 为逾期秒数 (计时器的相反数)
+    static f32 GetPriority(AIRole role, f32 overdue, bool woken);
+
+    /// 本帧最多思考的 agent 数 (预算不限或尚无耗时数据时不限)
+    u32 GetFrameQuota() const;
+
+    /// 按优先级保留前 quota 个候选 (顺序不保证)
+    static void Select(std::vector<Candidate>& candidates, u32 quota);
+
+    /// 记录本帧思考了多少 agent、主线程 AI 共耗时多少，更新单 agent 耗时估计
+    void EndFrame(u32 thought, f32 ms);
+    f32 GetCostPerAgentMs() const { return m_CostPerAgentMs; }
+
+    void Reset() { m_CostPerAgentMs = 0; }
+
+private:
+    Settings m_Settings;
+    f32 m_CostPerAgentMs = 0;
+};
+
+} // namespace AI
+} // namespace Engine
@@ -14,7 +14,7 @@ namespace Engine {
 
 // ── 行为树节点状态 ──────────────────────────────────────────
 
-enum class BTStatus { Success, Failure, Running };
+enum class BTStatus : u8 { Success, Failure, Running };
 
 // ── 行为树节点基类 ──────────────────────────────────────────
 
@@ -156,13 +156,78 @@ private:
 };
 
 // ── A* 寻路 ─────────────────────────────────────────────────
+// 可走性按格存为 u8 数组；单次查询的节点状态 (G/父节点/堆位置) 放在 NavSearchState 的
+// 紧凑数组里，用代号 (generation) 标记本次查询写过的格子: 查询开始时不清零整张网格，
+// 代价只与实际展开的节点数有关。开放列表为带位置索引的二叉堆 (decrease-key，不重复入堆)。
+// 状态缓冲预热后，查询本身不做堆分配。
+//
+// 另有两种可选的加速模式 (NavSearchMode)，按 NavGrid 选择:
+//   JumpPoint    — JPS+: 预计算每格 8 个方向的跳点距离，只在跳点之间搜索，结果与 A* 等价 (最短)
+//   Hierarchical — HPA*: 网格切成簇，簇边界的入口为抽象节点，簇内路径预先求好并缓存；
+//                  长距离查询只搜抽象图再拼接缓存路径，结果接近最短但不保证最短
+// 加速数据由 UpdateSearchData 构建；可走性改动后失效，失效期间网格坐标版 FindPath 退回 A*。
+// NavGrid 记录最近改动过的格子 (GetChangedRegion)，UpdateSearchData 只修复改动区域:
+// JPS+ 从改动处沿各方向回溯到跳点距离不再变化为止，HPA* 只重算改动涉及的簇。
+
+/// A* 单次查询的工作缓冲。每个线程/调用方各持一份即可并发查询同一张 NavGrid
+class NavSearchState {
+public:
+    /// 上次查询展开 (出堆) 的节点数 (HPA* 为各阶段之和)
+    u32 GetExpandedCount() const { return m_Expanded; }
+
+private:
+    friend class NavGrid;
+
+    static constexpr u32 NOT_IN_HEAP = 0xFFFFFFFEu;
+    static constexpr u32 CLOSED      = 0xFFFFFFFFu;
+
+    /// 每格 16 字节: 展开时一次取到同一格的全部状态
+    struct Node {
+        u32 Stamp;     // 最后被写入的代号
+        u32 HeapPos;   // 堆中下标 / NOT_IN_HEAP / CLOSED
+        f32 G;
+        u32 Parent;
+    };
+    /// 堆元素自带排序键，比较时不必回查节点数组
+    struct HeapEntry {
+        f32 F;
+        f32 G;
+        u32 Node;
+    };
+
+    /// 扩容到 nodeCount 并开始新一代 (代号回绕时才整体清零)
+    void Begin(u32 nodeCount);
+    /// 取节点状态，首次访问本代的节点时先初始化
+    Node& Touch(u32 node) {
+        Node& n = m_Nodes[node];
+        if (n.Stamp != m_Generation) n = {m_Generation, NOT_IN_HEAP, 1e30f, 0};
+        return n;
+    }
 
-struct NavNode {
-    i32 X, Y;
-    f32 GCost = 0, HCost = 0;
-    f32 FCost() const { return GCost + HCost; }
-    NavNode* Parent = nullptr;
-    bool Walkable = true;
+    void HeapPush(u32 node, f32 f, f32 g);
+    void HeapDecrease(u32 node, f32 f, f32 g);
+    u32  HeapPop();
+    void SiftUp(u32 slot, HeapEntry entry);
+    static bool HeapLess(const HeapEntry& a, const HeapEntry& b) {
+        // F 相同时先展开 G 大的 (离目标更近)，减少等价路径上的展开
+        return a.F < b.F || (a.F == b.F && a.G > b.G);
+    }
+
+    std::vector<Node> m_Nodes;
+    std::vector<HeapEntry> m_Heap;
+    u32 m_HeapSize = 0;
+    u32 m_Generation = 0;
+    u32 m_Expanded = 0;
+
+    // HPA* 查询的临时数据
+    std::vector<std::pair<u32, f32>> m_StartLinks, m_GoalLinks;   // 起点/终点到所在簇入口的代价
+    std::vector<u32> m_AbstractPath;
+};
+
+enum class NavSearchMode : u8 {
+    AStar,          // 逐格 A*
+    JumpPoint,      // JPS+ (预计算跳点距离)
+    Hierarchical,   // HPA* (簇抽象 + 缓存簇内路径)
 };
 
 class NavGrid {
@@ -171,23 +236,132 @@ public:
     NavGrid(u32 width, u32 height, f32 cellSize = 1.0f);
 
     void SetWalkable(i32 x, i32 y, bool walkable);
-    bool IsWalkable(i32 x, i32 y) const;
 
-    /// A* 寻路 → 返回路径点列表 (世界坐标)
+    /// 只复制 src 的尺寸、可走性与搜索模式，并按模式重建加速数据。
+    /// 不复制工作缓冲、跳点表和簇图 (给工作线程做快照用，比整体拷贝省内存)
+    void CopyWalkability(const NavGrid& src);
+
+    /// 选择搜索模式并构建对应的加速数据
+    void SetSearchMode(NavSearchMode mode);
+    NavSearchMode GetSearchMode() const { return m_Mode; }
+    /// 使加速数据与当前可走性一致 (SetWalkable 之后调用；世界坐标版 FindPath 会自动调用)。
+    /// 改动记录还在时只局部修复，否则整体重建
+    void UpdateSearchData();
+    /// 加速数据是否与当前可走性一致
+    bool IsSearchDataValid() const { return !m_SearchDataDirty; }
+    /// 可走性版本号: 每次实际改变可走性时递增 (派生数据据此判断是否过期)
+    u32 GetRevision() const { return m_Revision; }
+    /// sinceRevision 之后改动过的格子的包围矩形 (含两端，没有改动时 min > max)。
+    /// 只保留最近 CHANGE_HISTORY 次改动: 更早的版本返回 false，矩形为整张网格
+    bool GetChangedRegion(u32 sinceRevision, glm::ivec2& outMin, glm::ivec2& outMax) const;
+    static constexpr u32 CHANGE_HISTORY = 1024;
+    bool IsWalkable(i32 x, i32 y) const {
+        if (x < 0 || x >= (i32)m_Width || y < 0 || y >= (i32)m_Height) return false;
+        return m_Walkable[(u32)y * m_Width + (u32)x] != 0;
+    }
+
+    /// A* 寻路 → 返回路径点列表 (世界坐标，网格平面为 XZ)
     std::vector<glm::vec3> FindPath(const glm::vec3& start, const glm::vec3& end);
+    /// 同上，写入 outPath (复用其容量)。找不到路径时 outPath 为空并返回 false
+    bool FindPath(const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& outPath);
+
+    /// 网格坐标版本: outCells 为起点到终点逐格相邻的格子 (含两端)。state 为调用方持有的
+    /// 工作缓冲，不同 state 可在多个线程上同时查询 (期间不能修改可走性)
+    bool FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+                  std::vector<glm::ivec2>& outCells, NavSearchState& state) const;
+    /// 指定模式查询 (对应加速数据未构建或已失效时退回 A*)
+    bool FindPath(const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>& outCells,
+                  NavSearchState& state, NavSearchMode mode) const;
 
     u32 GetWidth() const { return m_Width; }
     u32 GetHeight() const { return m_Height; }
+    /// 可走性数组 (行优先，每格 0/1)
+    const u8* GetWalkableData() const { return m_Walkable.data(); }
     f32 GetCellSize() const { return m_CellSize; }
+    /// 默认工作缓冲 (世界坐标版 FindPath 使用)
+    const NavSearchState& GetSearchState() const { return m_Search; }
+
+    /// HPA* 簇边长 (格)
+    static constexpr u32 HPA_CLUSTER_SIZE = 16;
+    /// HPA* 抽象图规模 (未构建时为 0)
+    u32 GetAbstractNodeCount() const { return (u32)m_HpaNodes.size(); }
+    u32 GetAbstractEdgeCount() const { return (u32)m_HpaEdges.size(); }
 
 private:
+    // 方向编号: 0-3 正交 (-x, +x, -y, +y)，4-7 对角
+    static constexpr i32 DIR_X[8] = {-1, 1, 0, 0, -1, 1, -1, 1};
+    static constexpr i32 DIR_Y[8] = {0, 0, -1, 1, -1, -1, 1, 1};
+    static constexpr u32 NO_GOAL = 0xFFFFFFFFu;
+
+    static f32 Heuristic(i32 ax, i32 ay, i32 bx, i32 by);
+    static u32 DirIndex(i32 dx, i32 dy);
+
+    /// 限定在 [boundsMin, boundsMax] 矩形内的 A*；goalIdx 为 NO_GOAL 时退化为 Dijkstra 填满矩形
+    bool SearchCells(u32 startIdx, u32 goalIdx, const glm::ivec2& boundsMin, const glm::ivec2& boundsMax,
+                     NavSearchState& state) const;
+    /// 沿 Parent 链把 startIdx → goalIdx 的格子追加到 out (includeStart 决定是否含起点)
+    void AppendParentChain(u32 startIdx, u32 goalIdx, const NavSearchState& state,
+                           std::vector<glm::ivec2>& out, bool includeStart) const;
+
+    bool FindPathAStar(const glm::ivec2& start, const glm::ivec2& goal,
+                       std::vector<glm::ivec2>& outCells, NavSearchState& state) const;
+
+    /// 按当前模式整体重建加速数据
+    void RebuildSearchData();
+
+    // JPS+ (nav_grid_jps.cpp)
+    void BuildJumpDistances();
+    /// 可走性在 [changedMin, changedMax] 内变化后修复跳点距离
+    void RepairJumpDistances(const glm::ivec2& changedMin, const glm::ivec2& changedMax);
+    /// 由下一格的结果递推 (x, y) 在方向 d 上的跳点距离
+    i16 ComputeJumpDist(i32 x, i32 y, u32 d) const;
+    bool FindPathJumpPoint(const glm::ivec2& start, const glm::ivec2& goal,
+                           std::vector<glm::ivec2>& outCells, NavSearchState& state) const;
+
+    // HPA* (nav_grid_hpa.cpp)
+    struct HpaNode {
+        u32 Cell;
+        u32 Cluster;
+        u32 FirstEdge, EdgeCount;   // m_HpaEdges 中的区间
+    };
+    struct HpaEdge {
+        u32 To;
+        f32 Cost;
+        u32 PathOffset, PathLength; // m_HpaSteps 中的方向编码；长度 0 为跨簇的一步
+    };
+    /// reuse 非空时，其中标记为 1 的簇沿用已有的簇内边 (簇内可走性与入口都没变)
+    void BuildHierarchy(const std::vector<u8>* reuse = nullptr);
+    /// 可走性在 [changedMin, changedMax] 内变化后只重算涉及的簇
+    void RepairHierarchy(const glm::ivec2& changedMin, const glm::ivec2& changedMax);
+    /// 入口格子对应的抽象节点下标 (不是入口返回 0xFFFFFFFF)
+    u32 HpaNodeOf(u32 cell) const;
+    u32 ClusterOf(i32 x, i32 y) const;
+    void ClusterBounds(u32 cluster, glm::ivec2& outMin, glm::ivec2& outMax) const;
+    bool FindPathHierarchical(const glm::ivec2& start, const glm::ivec2& goal,
+                              std::vector<glm::ivec2>& outCells, NavSearchState& state) const;
+
     u32 m_Width = 0, m_Height = 0;
     f32 m_CellSize = 1.0f;
-    std::vector<NavNode> m_Nodes;
-    
-    NavNode* GetNode(i32 x, i32 y);
-    std::vector<NavNode*> GetNeighbors(NavNode* node);
-    f32 Heuristic(NavNode* a, NavNode* b);
+    std::vector<u8> m_Walkable;
+
+    NavSearchMode m_Mode = NavSearchMode::AStar;
+    bool m_SearchDataDirty = false;
+    u32 m_Revision = 0;
+    u32 m_SearchRevision = 0;            // 加速数据对应的可走性版本
+    std::vector<glm::ivec2> m_ChangeLog; // 环形记录: 版本 r 的改动格子在 [r % CHANGE_HISTORY]
+
+    /// JPS+ 跳点距离: 每格 8 个方向连续存放。> 0 为到下一个跳点的步数，
+    /// <= 0 为 -(撞墙前可走的步数)
+    std::vector<i16> m_JumpDist;
+
+    std::vector<HpaNode> m_HpaNodes;             // 按簇排序
+    std::vector<u32> m_HpaClusterFirst;          // 每簇在 m_HpaNodes 中的起始下标 (多一个哨兵)
+    std::vector<HpaEdge> m_HpaEdges;
+    std::vector<u8> m_HpaSteps;                  // 缓存的簇内路径 (每步一个方向编号)
+    u32 m_HpaClustersX = 0, m_HpaClustersY = 0;
+
+    NavSearchState m_Search;
+    std::vector<glm::ivec2> m_CellPath;   // 世界坐标版的临时格子路径
 };
 
 } // namespace Engine
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/core/ecs.h"
+#include "engine/ai/behavior_tree.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+// ── 编译行为树 ──────────────────────────────────────────────
+// BehaviorTree 每个 agent 一棵堆上的节点树，组合节点每帧从第一个孩子重新求值。
+// CompiledBehaviorTree 把树按先序摊平成连续的节点数组，所有 agent 共享；
+// 每个 agent 的运行状态只是一个 16 字节的 BTAgentState (放在 BehaviorTreeComponent 里):
+//   - Running: 上一帧返回 Running 的节点。下一帧直接从它恢复 (O(1) 定位)，
+//     结果再沿父节点向上传递，前面已成功/失败的兄弟不再重新求值
+//   - Counters: 各 Repeater 的已完成次数
+// 恢复点是叶子 (Action) 或 Repeater (两次重复之间)。恢复语义意味着已通过的条件不会每帧
+// 重查；需要打断时对状态调用 Reset。
+//
+// 叶子回调按下标存放在树里，调用时传入 BTTickContext (实体 + dt)；
+// BehaviorTreeSystem 在 JobSystem 上并行 tick，回调需可并发调用 (见 BehaviorTreeSystem)。
+
+/// 每个 agent 的行为树状态 (POD)
+struct BTAgentState {
+    static constexpr u16 NONE = 0xFFFF;
+    static constexpr u32 MAX_COUNTERS = 6;   // 一棵树最多的 Repeater 数
+
+    u16 Running = NONE;                      // 恢复点节点下标
+    BTStatus LastStatus = BTStatus::Failure; // 上次 Tick 的结果
+    u16 Counters[MAX_COUNTERS] = {};
+};
+static_assert(sizeof(BTAgentState) == 16, "BTAgentState 应保持 16 字节");
+
+/// 叶子回调的参数
+struct BTTickContext {
+    ECSWorld* World = nullptr;
+    Entity Self = INVALID_ENTITY;
+    f32 DeltaTime = 0;
+};
+
+enum class BTNodeType : u8 { Sequence, Selector, Inverter, Repeater, Action, Condition };
+
+class CompiledBehaviorTree {
+public:
+    using ActionFunc = std::function<BTStatus(const BTTickContext&)>;
+    using ConditionFunc = std::function<bool(const BTTickContext&)>;
+
+    /// 摊平后的节点 (先序)。孩子从 下标 + 1 开始，沿 Next 依次是兄弟，直到父节点的 Next
+    struct Node {
+        BTNodeType Type = BTNodeType::Sequence;
+        u8 Slot = 0;            // Repeater: 计数器槽
+        u16 MaxRepeats = 0;     // Repeater: 0 = 无限
+        u16 Parent = BTAgentState::NONE;
+        u16 Next = 0;           // 子树之后的第一个节点
+        u16 Payload = 0;        // Action/Condition: 回调下标
+    };
+
+    /// 推进一帧；state 为该 agent 的状态
+    BTStatus Tick(BTAgentState& state, const BTTickContext& ctx) const;
+    /// 放弃进行中的节点，下次从根开始
+    static void Reset(BTAgentState& state) { state = BTAgentState{}; }
+
+    u32 GetNodeCount() const { return (u32)m_Nodes.size(); }
+    const Node& GetNode(u32 index) const { return m_Nodes[index]; }
+    const std::string& GetNodeName(u32 index) const { return m_Names[index]; }
+
+private:
+    friend class BTBuilder;
+
+    /// 从头进入节点 (孩子返回 Running 时在 state 记下恢复点)
+    BTStatus Enter(u16 index, BTAgentState& state, const BTTickContext& ctx) const;
+    /// 孩子 child 以 status 结束后由父节点 parent 继续
+    BTStatus Continue(u16 parent, u16 child, BTStatus status,
+                      BTAgentState& state, const BTTickContext& ctx) const;
+
+    std::vector<Node> m_Nodes;
+    std::vector<std::string> m_Names;
+    std::vector<ActionFunc> m_Actions;
+    std::vector<ConditionFunc> m_Conditions;
+};
+
+// ── 构建器 ──────────────────────────────────────────────────
+// 按先序描述树: 组合/装饰节点开一层，End() 关闭；叶子不需要 End。
+//
+//   BTBuilder b;
+//   b.Selector()
+//       .Sequence().Condition("HasTarget", hasTarget).Action("Attack", attack).End()
+//       .Action("Patrol", patrol)
+//    .End();
+//   Ref<CompiledBehaviorTree> tree = b.Build();
+
+class BTBuilder {
+public:
+    BTBuilder& Sequence(const std::string& name = "Sequence");
+    BTBuilder& Selector(const std::string& name = "Selector");
+    BTBuilder& Inverter(const std::string& name = "Inverter");
+    /// maxRepeats = 0 为无限重复
+    BTBuilder& Repeater(u16 maxRepeats = 0, const std::string& name = "Repeater");
+    BTBuilder& Action(const std::string& name, CompiledBehaviorTree::ActionFunc func);
+    BTBuilder& Condition(const std::string& name, CompiledBehaviorTree::ConditionFunc func);
+    BTBuilder& End();
+
+    /// 校验并生成。结构错误 (层未闭合、多个根、装饰节点不是恰好一个孩子、
+    /// Repeater 超过 BTAgentState::MAX_COUNTERS 等) 时记录错误并返回 nullptr
+    Ref<CompiledBehaviorTree> Build();
+
+private:
+    u16 Push(BTNodeType type, const std::string& name);
+
+    CompiledBehaviorTree m_Tree;
+    std::vector<u16> m_Open;   // 尚未 End 的组合/装饰节点
+    u32 m_Roots = 0;
+    u32 m_Repeaters = 0;
+    bool m_Error = false;
+};
+
+// ── 行为树组件 / 系统 ───────────────────────────────────────
+
+struct BehaviorTreeComponent : public Component {
+    Ref<CompiledBehaviorTree> Tree;   // 多个 agent 共享同一棵
+    BTAgentState State;
+};
+
+/// 每帧 tick 所有 BehaviorTreeComponent。
+/// @warning 并行模式下叶子回调在工作线程上并发执行:
+///   - 只读写自身实体的组件 (或自行同步的共享数据)
+///   - 不得添加/删除组件、创建/销毁实体
+///   - 只能访问 UsesComponents 声明过的组件类型: GetComponent/HasComponent 遇到还没有池的类型
+///     会新建池 (写共享的池表)，声明的类型在并行 tick 前由主线程建好
+///   没有声明任何组件类型时退回串行 tick；回调做不到上述要求时用 SetParallel(false)。
+class BehaviorTreeSystem : public System {
+public:
+    void Update(ECSWorld& world, f32 dt) override;
+    const char* GetName() const override { return "BehaviorTreeSystem"; }
+
+    void SetParallel(bool parallel) { m_Parallel = parallel; }
+    bool IsParallel() const { return m_Parallel; }
+
+    /// 声明叶子回调会访问的组件类型 (BehaviorTreeComponent 自带)
+    template<typename... T>
+    void UsesComponents() {
+        (m_PoolSetup.push_back([](ECSWorld& world) { world.GetComponentArray<T>(); }), ...);
+    }
+
+private:
+    static constexpr u32 TICK_GRAIN = 64;   // 每个并行任务至少 tick 的 agent 数
+    bool m_Parallel = true;
+    std::vector<void (*)(ECSWorld&)> m_PoolSetup;   // 并行 tick 前建池
+};
+
+} // namespace Engine
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+class NavGrid;
+
+// ── 流场 ────────────────────────────────────────────────────
+// 以一个目标格为源的 Dijkstra 积分场: 每格记录到目标的代价与下一步方向 (最短路径树的父方向)。
+// 大量单位追同一个目标时，每个单位只需按所在格子查一次方向，
+// 寻路代价从 O(单位数 × 路径) 变为每个目标一次 O(覆盖格子数)。
+//
+// 邻接规则与 NavGrid 的 A* 相同 (8 邻接、不切角)，代价取整数 正交 10 / 对角 14，
+// 用 15 个桶的环形桶队列 (Dial) 代替二叉堆。maxCost 限定积分半径 (单位: 格)，
+// 半径之外视为不可达。各格状态带代号，重算只写入本次覆盖的格子，不清零整张网格。
+//
+// 可走性局部变化后用 Repair 修复: 作废最短路径树上经过改动区域的子树，
+// 再从作废区域的边界和改动区域重新松弛，代价与改动影响到的格子数成正比。
+
+class FlowField {
+public:
+    /// 表示不可达/目标格的方向
+    static constexpr u8 NO_DIRECTION = 0xFF;
+
+    /// 以 goal 为目标积分。goal 不可走时整张场不可达
+    void Compute(const NavGrid& grid, const glm::ivec2& goal, f32 maxCost = 1e30f);
+    /// 可走性只在 [changedMin, changedMax] 内变化后局部修复，结果与重新 Compute 相同 (代价一致)。
+    /// 返回 false 表示改动不涉及本场，只更新了版本号
+    bool Repair(const NavGrid& grid, const glm::ivec2& changedMin, const glm::ivec2& changedMax);
+
+    /// 格子到目标的路径代价 (格)；不可达返回 -1
+    f32 GetCost(i32 x, i32 y) const;
+    /// 格子是否在场内可达 (含目标格)
+    bool IsReachable(i32 x, i32 y) const { return Index(x, y) != INVALID; }
+    /// 下一步的格子偏移 (各分量 -1..1)；目标格或不可达返回 (0, 0)
+    glm::ivec2 GetDirection(i32 x, i32 y) const;
+
+    const glm::ivec2& GetGoal() const { return m_Goal; }
+    f32 GetMaxCost() const { return m_MaxCost; }
+    /// 计算时 NavGrid 的可走性版本号
+    u32 GetGridRevision() const { return m_GridRevision; }
+    /// 上次积分覆盖 (可达) 的格子数
+    u32 GetReachedCount() const { return m_Reached; }
+
+private:
+    static constexpr u32 INVALID = 0xFFFFFFFFu;
+    static constexpr u32 BUCKET_COUNT = 15;   // > 最大单步代价 14
+
+    /// 本代可达格子的下标，否则 INVALID
+    u32 Index(i32 x, i32 y) const {
+        if (x < 0 || y < 0 || x >= (i32)m_Width || y >= (i32)m_Height) return INVALID;
+        u32 i = (u32)y * m_Width + (u32)x;
+        return m_Stamp[i] == m_Generation ? i : INVALID;
+    }
+
+    u32 m_Width = 0, m_Height = 0;
+    glm::ivec2 m_Goal = {-1, -1};
+    f32 m_MaxCost = 0.0f;
+    u32 m_GridRevision = 0;
+    u32 m_Reached = 0;
+    glm::ivec2 m_ReachedMin = {0, 0}, m_ReachedMax = {-1, -1};   // 可达格子的包围矩形
+
+    u32 m_Generation = 0;
+    std::vector<u32> m_Stamp;
+    std::vector<u32> m_Cost;    // 整数代价 (正交 10 / 对角 14)
+    std::vector<u8>  m_Dir;     // NavGrid 方向编号
+    std::vector<u32> m_Buckets[BUCKET_COUNT];
+
+    // Repair 的临时数据
+    std::vector<u32> m_Invalid;
+    std::vector<std::pair<u32, u32>> m_RepairHeap;   // (代价, 格子) 小顶堆
+};
+
+// ── 流场缓存 ────────────────────────────────────────────────
+// 按 key (如目标实体 ID) 管理多张流场。每帧 RequestGoal 声明需要的目标，
+// 只有目标换了格子、半径变化或 NavGrid 可走性变化时才标脏；
+// Update 把本帧所有脏场分发到 JobSystem 工作线程并行重算 (每个目标一个任务)。
+
+class FlowFieldCache {
+public:
+    void SetNavGrid(const NavGrid* grid) { m_Grid = grid; }
+
+    /// 声明本帧需要以 goal 为目标的流场
+    void RequestGoal(u64 key, const glm::ivec2& goal, f32 maxCost = 1e30f);
+    /// 重算所有过期的流场 (只是可走性局部变化的流场就地修复)
+    void Update();
+
+    /// 取流场 (未请求过返回 nullptr)
+    const FlowField* Get(u64 key) const;
+    void Remove(u64 key) { m_Fields.erase(key); }
+    void Clear() { m_Fields.clear(); }
+
+    /// 上次 Update 整张重算的流场数
+    u32 GetRecomputedCount() const { return m_Recomputed; }
+    /// 上次 Update 局部修复的流场数 (改动不涉及的流场不计)
+    u32 GetRepairedCount() const { return m_Repaired; }
+
+private:
+    struct Entry {
+        FlowField Field;
+        glm::ivec2 Goal = {-1, -1};
+        f32 MaxCost = 0.0f;
+        bool Computed = false;
+    };
+
+    const NavGrid* m_Grid = nullptr;
+    std::unordered_map<u64, Entry> m_Fields;
+    std::vector<Entry*> m_Dirty;
+    std::vector<u8> m_Repair;        // 与 m_Dirty 对应: 1 = 局部修复，任务完成后 2 = 确有修改
+    u32 m_Recomputed = 0;
+    u32 m_Repaired = 0;
+};
+
+} // namespace Engine
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/ai/behavior_tree.h"
+
+#include <glm/glm.hpp>
+#include <atomic>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+// ── 异步寻路请求队列 ────────────────────────────────────────
+//
+// 单位提交寻路请求拿到句柄，求解在 JobSystem 工作线程上进行，结果进完成队列，
+// 主线程每帧取出。寻路不再在游戏逻辑的 Update 里同步阻塞，批量刷新不会造成帧尖峰。
+//
+// - 工作线程只读 NavGrid 的快照，主线程可以随时修改原网格。可走性版本变化时，
+//   没有在途任务引用的快照就地同步改动区域 (加速数据局部修复)。当前快照仍被引用时
+//   换用备用快照 (上一份已空闲的快照) 同样局部同步；两份都被引用时才新建一份，
+//   只复制可走性并重建加速数据。旧快照由在途任务持有到结束
+// - 待处理请求按优先级排序，每帧最多派发 MaxDispatchPerFrame 个，在途上限 MaxInFlight；
+//   JobSystem 未启动时在主线程同步求解，受 SyncBudgetMs 时间预算限制
+// - 每个 owner (如实体 ID) 同时只有一个有效请求: 重新请求或 Cancel 会让旧请求作废，
+//   未派发的直接丢弃，已在途的结果在取出时丢弃
+//
+// 用法:
+//   PathHandle h = queue.Submit(entity, start, goal, -distance);   // 近的优先
+//   queue.Update();                                                // 每帧
+//   PathResult r;
+//   while (queue.PopResult(r)) { ... }
+
+using PathHandle = u64;
+constexpr PathHandle INVALID_PATH_HANDLE = 0;
+
+struct PathResult {
+    PathHandle Handle = INVALID_PATH_HANDLE;
+    u64 Owner = 0;
+    bool Found = false;
+    std::vector<glm::ivec2> Cells;   // 起点到终点逐格相邻的格子 (含两端)
+    u32 GridRevision = 0;            // 求解所用快照对应的 NavGrid 可走性版本
+};
+
+struct PathQueueConfig {
+    u32 MaxDispatchPerFrame = 32;    // 每帧最多派发的请求数
+    u32 MaxInFlight = 64;            // 同时在工作线程上的请求上限
+    f32 SyncBudgetMs = 1.0f;         // 无工作线程时每帧同步求解的时间预算
+};
+
+class PathRequestQueue {
+public:
+    PathRequestQueue();
+
+    void SetNavGrid(const NavGrid* grid);
+    void SetConfig(const PathQueueConfig& config) { m_Config = config; }
+    const PathQueueConfig& GetConfig() const { return m_Config; }
+
+    /// 提交请求 (priority 越大越先处理)。同一 owner 之前的请求作废
+    PathHandle Submit(u64 owner, const glm::ivec2& start, const glm::ivec2& goal, f32 priority = 0.0f);
+    /// 作废该 owner 的请求 (单位死亡/不再需要)
+    void Cancel(u64 owner);
+    /// owner 是否有尚未取出结果的有效请求
+    bool IsPending(u64 owner) const { return m_Current.count(owner) != 0; }
+
+    /// 主线程每帧调用: 按需刷新快照，按优先级派发请求
+    void Update();
+    /// 取出一个完成的结果 (作废请求的结果会被跳过)
+    bool PopResult(PathResult& out);
+
+    /// 尚未派发的请求数 (含已作废但还在堆里的)
+    u32 GetQueuedCount() const { return (u32)m_Queue.size(); }
+    /// 工作线程上的请求数
+    u32 GetInFlightCount() const;
+    /// 阻塞等待所有在途请求完成 (测试/关闭用)
+    void WaitIdle() const;
+
+private:
+    struct Request {
+        PathHandle Handle;
+        u64 Owner;
+        glm::ivec2 Start, Goal;
+        f32 Priority;
+    };
+    static bool HeapLess(const Request& a, const Request& b) { return a.Priority < b.Priority; }
+    /// 工作线程与主线程共享的完成队列 (在途任务持有引用，队列销毁后也安全)
+    struct Completion {
+        std::mutex Mutex;
+        std::vector<PathResult> Results;
+        std::atomic<u32> InFlight{0};
+    };
+
+    bool IsCurrent(u64 owner, PathHandle handle) const;
+    void RefreshSnapshot();
+
+    const NavGrid* m_Grid = nullptr;
+    Ref<NavGrid> m_Snapshot;
+    u32 m_SnapshotRevision = 0;
+    Ref<NavGrid> m_SpareSnapshot;                      // 上一份快照，任务结束后复用
+    u32 m_SpareRevision = 0;
+
+    PathQueueConfig m_Config;
+    std::vector<Request> m_Queue;                      // 按 Priority 的二叉堆
+    std::unordered_map<u64, PathHandle> m_Current;     // owner → 当前有效请求
+    PathHandle m_NextHandle = 1;
+
+    Ref<Completion> m_Completion;
+    std::vector<PathResult> m_Ready;                   // 已从完成队列搬出、待 PopResult
+    size_t m_ReadyIndex = 0;
+    NavSearchState m_SyncState;                        // 同步求解用
+};
+
+} // namespace Engine
@@ -17,7 +17,13 @@ class Scene;
 
 namespace AI {
 
+class AIBatch;
+class AIScheduler;
+class AISpatialIndex;
+
 // ── Python AI 引擎 ──────────────────────────────────────────
+// 导入的模块和取到的函数对象按名字缓存，每帧调用不再重复 import/getattr。
+// 导入失败也会缓存 (只报一次错)；改了脚本需要重新加载时调用 ClearCache
 
 class PythonEngine {
 public:
@@ -35,9 +41,21 @@ public:
     static std::string GetVariable(const std::string& module,
                                     const std::string& varName);
 
+    /// 模块是否定义了可调用的 func (不存在时不报错)
+    static bool HasFunction(const std::string& module, const std::string& func);
+    /// 调用 module.update_ai_batch(batch): 整批上下文以 memoryview 传入，动作写回 batch。
+    /// 调用返回后这些 memoryview 即被 release，脚本不得在调用之外保留它们
+    static bool CallBatch(const std::string& module, AIBatch& batch);
+    /// 丢弃缓存的模块与函数 (下次调用重新导入)。须在主线程调用；
+    /// AI 工作线程开着时先等它算完在途快照
+    static void ClearCache();
+
+    /// 最近一次错误 (工作线程也会写入，加锁读取)
     static std::string GetLastError();
 
 private:
+    static void SetLastError(std::string error);
+
     static bool s_Initialized;
     static std::string s_LastError;
 };
@@ -108,6 +126,7 @@ public:
 
 private:
     static std::deque<PlayerSnapshot> s_History;
+    static f32 s_SpeedSum;                     // s_History 速度之和 (平均速度 O(1))
     static u32 s_PlayerEntity;
     static glm::vec3 s_LastPosition;
     static f32 s_TotalTime;
@@ -161,7 +180,8 @@ struct AIContext {
 
     // 环境信息
     std::vector<NearbyEntity> NearbyEnemies;
-    f32 DeltaTime = 0;
+    f32 DeltaTime = 0;          // 距该 agent 上次决策的秒数 (思考调度下可能跨多帧)
+    f32 FrameDeltaTime = 0;     // 本帧 dt
 
     // 巡逻路径点 (可选)
     std::vector<glm::vec3> PatrolPoints;
@@ -228,16 +248,57 @@ struct AIAgent {
 };
 
 // ── AI 管理器 ───────────────────────────────────────────────
+// 每帧先由 AIScheduler 挑出本帧要决策的 agent (按距离/状态的思考间隔、事件唤醒、每帧预算)，
+// 没轮到的 agent 沿用上次决策的移动。
+//
+// 每个阶段先收集本阶段要更新的 agent: 脚本模块定义了 update_ai_batch 的按模块归批，
+// 每个模块调用一次 Python (见 ai_batch.h)；没有批量入口的模块仍逐个调用 update_ai。
+//
+// SetThreaded(true) 后 Python 决策移到 AI 工作线程: 主线程每帧把三个阶段的上下文采集成
+// 一份快照交给工作线程，同时应用上一份快照的结果 (双缓冲，动作/命令晚一帧生效)。
+// 工作线程只读快照、不碰 ECS；GIL 按调用获取，主线程的 ScriptSystem 仍可调用 Python。
+
+struct AIFramePhase;
+
+/// AI 工作线程的耗时 (毫秒，最近一帧)
+struct AIWorkerStats {
+    f32 GatherMs = 0;   // 主线程: 采集快照
+    f32 StallMs = 0;    // 主线程: 等工作线程交还上一份结果 (>0 表示 Python 比一帧慢)
+    f32 ApplyMs = 0;    // 主线程: 应用结果
+    f32 WorkerMs = 0;   // 工作线程: 上一份快照的 Python 决策
+    u64 Frames = 0;     // 工作线程处理的快照数
+};
 
 class AIManager {
 public:
     static void Init();
     static void Update(Scene& scene, f32 dt);
+    /// 停止工作线程 (须在 PythonEngine::Shutdown 之前调用)
     static void Shutdown();
     static u32 GetActiveAgentCount() { return s_AgentCount; }
 
+    /// 开/关 AI 工作线程 (需 Python 已初始化)；关闭时等在途快照算完，其结果丢弃
+    static void SetThreaded(bool threaded);
+    static bool IsThreaded();
+    static const AIWorkerStats& GetWorkerStats();
+
+    /// 思考调度参数 (间隔、每帧预算)
+    static AIScheduler& GetScheduler();
+
+    /// 本帧的邻域索引 (每帧 AI 更新开始时重建；仅主线程读取)
+    static const AISpatialIndex& GetSpatialIndex();
+
 private:
-    // 三阶段更新
+    friend struct AIAgent;   // 逐个调用路径用 ContextToJSON / ParseAction
+
+    /// 给所有 agent 计时、检查唤醒事件，选出本帧决策的 agent (置 ThinkNow)，返回个数
+    static u32 ScheduleAgents(Scene& scene, f32 dt);
+    /// 本帧没有新动作的 agent 沿用上次的移动
+    static void CoastAgents(Scene& scene, f32 dt);
+    /// 重建邻域索引 (工作线程空闲时调用)
+    static void RebuildSpatialIndex(Scene& scene);
+
+    // 三阶段更新 (采集到当前阶段)
     static void UpdateCommanders(Scene& scene, f32 dt);
     static void UpdateSquadLeaders(Scene& scene, f32 dt);
     static void UpdateSoldiers(Scene& scene, f32 dt);
@@ -250,6 +311,15 @@ private:
     static std::vector<NearbyEntity> FindNearbyEntities(
         Scene& scene, u32 selfID, const glm::vec3& pos, f32 range);
 
+    /// 把 agent 加入当前阶段: 有批量入口的模块进该模块的批次，否则记下 JSON 上下文逐个调用
+    static void Submit(u32 entityID, const std::string& module, const AIContext& ctx);
+    /// 调用 Python 求出阶段内所有动作 (主线程或工作线程)
+    static void RunPhase(AIFramePhase& phase);
+    /// 按行应用阶段结果并清空 (主线程)
+    static void ApplyPhase(Scene& scene, AIFramePhase& phase, f32 dt);
+    /// 写回状态、移动，并把命令下发给 orderTarget 角色 (nullptr = 不下发)
+    static void ApplyResult(Scene& scene, u32 entityID, const AIAction& action,
+                            f32 dt, const char* orderTarget);
     static void ApplyAction(Scene& scene, u32 entityID, const AIAction& action, f32 dt);
     static void DispatchOrders(Scene& scene, u32 issuerEntity,
                                 const std::string& orderJson, const std::string& role);
@@ -0,0 +1,91 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace Engine {
+
+class ECSWorld;
+
+namespace AI {
+
+// ── AI 邻域索引 ─────────────────────────────────────────────
+// AIManager 每帧重建一次的均匀网格 (XZ 平面)，AI 感知、小队/指挥官上下文与脚本的
+// find_nearby 共用，代替每个 agent 各扫一遍全部实体 (O(agent × 实体) → O(附近格子))。
+//
+// 条目按格子计数排序后连续存放，一个格子的条目是一段区间；距离按三维计算。
+// 格子数超过上限时自动放大格子 (实体分布很散时不至于分配巨大的网格)。
+// 查询结果是重建那一刻的快照。
+
+class AISpatialIndex {
+public:
+    struct Entry {
+        glm::vec3 Position = {0, 0, 0};
+        f32 Health = 0;            // 无 HealthComponent 为 0
+        u32 EntityID = 0;
+    };
+
+    struct Hit {
+        u32 Index = 0;             // GetEntry 的下标
+        f32 Distance = 0;
+    };
+
+    explicit AISpatialIndex(f32 cellSize = 8.0f) : m_CellSize(cellSize) {}
+
+    void SetCellSize(f32 size) { m_CellSize = size; }
+    f32 GetCellSize() const { return m_CellSize; }
+
+    /// 从 world 重建: 所有带 Transform 的实体进网格，所有带 SquadComponent 的实体进小队表。
+    /// 条目填充与分格在 JobSystem 上并行
+    void Build(ECSWorld& world);
+    /// 直接从条目重建；squads 为 (小队 ID, 实体) 对
+    void Build(std::vector<Entry> entries,
+               const std::vector<std::pair<u32, u32>>& squads = {});
+    void Clear();
+
+    u32 GetCount() const { return (u32)m_Entries.size(); }
+    const Entry& GetEntry(u32 index) const { return m_Entries[index]; }
+
+    /// 半径内 (含边界) 的条目，不含 excludeID，按距离升序 (同距离按实体 ID)
+    void QueryRadius(const glm::vec3& pos, f32 radius, u32 excludeID,
+                     std::vector<Hit>& out) const;
+    /// 最近的 k 个 (距离不超过 maxRadius)，不含 excludeID，按距离升序
+    void QueryKNearest(const glm::vec3& pos, u32 k, f32 maxRadius, u32 excludeID,
+                       std::vector<Hit>& out) const;
+
+    /// 小队成员实体 (按实体 ID 升序)；没有该小队返回空表
+    const std::vector<u32>& GetSquadMembers(u32 squadID) const;
+    /// 有成员的小队 ID (升序)
+    const std::vector<u32>& GetSquadIDs() const { return m_SquadIDs; }
+
+private:
+    static constexpr u32 MAX_CELLS = 1u << 20;
+
+    /// m_Entries 已填好后分格并按格子重排
+    void BuildGrid();
+    void BuildSquads(std::vector<std::pair<u32, u32>>& squads);
+    i32 CellX(f32 x) const;
+    i32 CellZ(f32 z) const;
+
+    f32 m_CellSize;
+    f32 m_GridCellSize = 8.0f;          // 实际使用的格子大小 (可能被放大)
+    glm::vec2 m_Origin = {0, 0};        // 网格左下角 (XZ)
+    glm::vec3 m_Min = {0, 0, 0}, m_Max = {0, 0, 0};   // 条目包围盒
+    u32 m_Width = 0, m_Height = 0;
+
+    std::vector<Entry> m_Entries;       // 按格子排序
+    std::vector<u32> m_CellStart;       // 格子 c 的条目为 [m_CellStart[c], m_CellStart[c + 1])
+    std::vector<u32> m_CellOf;          // 构建时每个条目的格子 (复用容量)
+    std::vector<Entry> m_Scratch;
+
+    std::unordered_map<u32, std::vector<u32>> m_Squads;
+    std::vector<u32> m_SquadIDs;
+    std::vector<std::pair<u32, u32>> m_SquadPairs;
+};
+
+} // namespace AI
+} // namespace Engine
@@ -46,6 +46,7 @@ struct ApplicationConfig {
     u32 Width  = 1280;
     u32 Height = 720;
     bool VSync = true;
+    std::vector<std::string> AssetPacks;   // 启动时挂载的 cook 资源包 (不存在则跳过，回退散文件)
     GraphicsBackend Backend =
 #ifdef ENGINE_ENABLE_VULKAN
         GraphicsBackend::Vulkan;
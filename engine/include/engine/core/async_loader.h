@@ -12,19 +12,6 @@
 
 namespace Engine {
 
-// ── 纹理 CPU 解码结果 ──────────────────────────────────────
-// 工作线程产出的中间数据（不含任何 GL 调用）
-
-struct TextureLoadResult {
-    std::string Name;           // 资源名
-    std::string FilePath;       // 原始路径（用于日志）
-    unsigned char* PixelData;   // stbi 分配的像素数据
-    i32 Width;
-    i32 Height;
-    i32 Channels;
-    std::function<void(Ref<Texture2D>)> Callback;  // 加载完成回调（可选）
-};
-
 // ── 模型 CPU 解析结果 ──────────────────────────────────────
 
 struct MeshLoadResult {
@@ -47,12 +34,13 @@ struct MeshCpuData {
 //
 // 利用 JobSystem 工作线程做 CPU 密集型（磁盘IO+解码），
 // 主线程做 GPU 上传（OpenGL 调用），避免帧卡顿。
+// 纹理转交 TextureStreamer (工作线程 mip 生成 + 按字节预算逐层上传)。
 //
 // 用法:
 //   AsyncLoader::Init();
 //   AsyncLoader::LoadTextureAsync("grass", "textures/grass.png");
 //   // 主循环中:
-//   AsyncLoader::FlushUploads(4);     // 每帧上传最多 4 个
+//   AsyncLoader::FlushUploads(4);     // 每帧上传最多 4 个模型
 //   // 退出时:
 //   AsyncLoader::Shutdown();
 
@@ -66,8 +54,8 @@ public:
 
     // ── 异步加载提交 ────────────────────────────────────────
 
-    /// 异步加载纹理: 工作线程解码 → 主线程上传 GPU
-    /// callback 在主线程 FlushUploads 时调用（可选）
+    /// 异步加载纹理: 转交 TextureStreamer 流送
+    /// callback 在纹理首次可采样 (最粗 mip 就绪) 时于主线程调用（可选）
     static void LoadTextureAsync(const std::string& name,
                                   const std::string& filepath,
                                   std::function<void(Ref<Texture2D>)> callback = nullptr);
@@ -78,8 +66,8 @@ public:
 
     // ── 主线程刷新 ──────────────────────────────────────────
 
-    /// 主线程每帧调用: 从完成队列取出 CPU 数据并上传 GPU
-    /// budget = 本帧最多上传数量 (0 = 全部)
+    /// 主线程每帧调用: 从完成队列取出模型 CPU 数据并上传 GPU
+    /// budget = 本帧最多上传模型数量 (0 = 全部)；纹理由 TextureStreamer::Update 按字节预算上传
     static void FlushUploads(u32 budget = 4);
 
     // ── 状态查询 ────────────────────────────────────────────
@@ -95,9 +83,7 @@ public:
 
 private:
     // 完成队列（工作线程写入，主线程读取）
-    static std::queue<TextureLoadResult>  s_TextureQueue;
     static std::queue<MeshLoadResult>     s_MeshQueue;
-    static std::mutex                     s_TextureMutex;
     static std::mutex                     s_MeshMutex;
 
     // 活跃计数
@@ -79,6 +79,18 @@ struct AIComponent : public Component {
     std::string State = "Idle";
     f32 DetectRange = 10.0f;
     f32 AttackRange = 2.0f;
+
+    // 思考调度 (运行时状态，不序列化；见 AIScheduler)
+    bool WakeRequested = false;        // 外部事件要求下一帧立即重新决策
+    bool ThinkNow = false;             // 本帧是否被调度决策
+    bool PlayerInRange = false;        // 上一帧玩家是否在探测范围内 (进入范围即唤醒)
+    f32  ThinkTimer = 0.0f;            // 距下次决策的秒数 (<=0 到期)
+    f32  SinceLastThink = 0.0f;        // 距上次决策累计的秒数
+    f32  ThinkDeltaTime = 0.0f;        // 本次决策的 dt (= 被调度时的 SinceLastThink)，传给脚本
+    f32  LastHealth = -1.0f;           // 上一帧的血量 (<0 = 尚未调度；掉血即唤醒)
+    glm::vec3 MoveDirection = {0, 0, 0}; // 上次决策的移动，两次决策之间继续沿用
+    f32  MoveSpeed = 0.0f;
+    u32  LastMoveFrame = 0;            // 最近一次按决策结果移动的 AI 帧号
 };
 
 // ── Squad ───────────────────────────────────────────────────
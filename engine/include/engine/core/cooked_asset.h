@@ -0,0 +1,119 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/core/async_loader.h"
+#include "engine/core/prefab.h"
+#include "engine/renderer/mesh.h"
+#include "engine/renderer/mesh_optimizer.h"
+#include "engine/renderer/mip_chain.h"
+#include "engine/renderer/bc_encoder.h"
+#include "engine/game2d/ldtk_loader.h"
+
+#include <vector>
+
+namespace Engine {
+
+// ── Cook 产物二进制格式 ─────────────────────────────────────
+//
+// 资源包 (PackArchive) 中各类 blob 的布局与编解码。
+// 读取接口返回直接指向 blob 的视图，不做拷贝；blob 必须 16 字节对齐
+// (PackWriter 保证)。格式变化时提升对应 *_VERSION，旧包需重新 cook。
+
+constexpr u32 COOKED_MODEL_MAGIC   = 0x4C444F4D;   // "MODL"
+constexpr u32 COOKED_MODEL_VERSION = 2;
+constexpr u32 COOKED_TEX_MAGIC     = 0x58455443;   // "CTEX"
+constexpr u32 COOKED_TEX_VERSION   = 1;
+constexpr u32 COOKED_PREFAB_MAGIC  = 0x42465250;   // "PRFB"
+constexpr u32 COOKED_LDTK_MAGIC    = 0x4B54444C;   // "LDTK"
+constexpr u32 COOKED_DATA_VERSION  = 1;            // 预制体 / LDtk 共用
+
+/// 场景 blob 编码 (PackEntry::Flags)
+enum class CookedSceneEncoding : u32 {
+    Json = 0,   // 原始 JSON 文本
+    Binary,     // SceneSerializer 二进制格式 (运行时直接在映射内存上读取)
+};
+
+// ── 模型 ────────────────────────────────────────────────────
+
+/// 顶点格式 (SubmeshRecord::VertexFormat)
+enum class CookedVertexFormat : u32 {
+    Full = 0,   // MeshVertex (56 字节)
+    Packed,     // PackedMeshVertex (20 字节)
+};
+
+/// 模型写出选项
+struct CookedModelOptions {
+    bool Quantize = false;   // 顶点压缩为 PackedMeshVertex (运行时是否直接使用见 ResourceManager::SetPackedVertexInput)
+    bool Meshlets = false;   // 附带 meshlet 划分 (包围球 + 法线锥)
+};
+
+/// 单个子网格视图 (指向 blob 内部)
+/// Vertices / PackedVertices 二者恰有一个非空，取决于 cook 时是否量化
+struct CookedMeshView {
+    const char* Name = "";
+    const MeshVertex* Vertices = nullptr;
+    const PackedMeshVertex* PackedVertices = nullptr;
+    u32 VertexCount = 0;
+    const u32* Indices = nullptr;
+    u32 IndexCount = 0;
+    const char* AlbedoTexPath = "";
+    const char* NormalTexPath = "";
+    const char* MetallicRoughnessTexPath = "";
+
+    // Meshlet (可选，MeshletCount = 0 表示未生成)
+    const Meshlet* Meshlets = nullptr;
+    u32 MeshletCount = 0;
+    const u32* MeshletVertices = nullptr;
+    const u8* MeshletTriangles = nullptr;
+};
+
+// ── 纹理 ────────────────────────────────────────────────────
+
+enum class CookedTextureFormat : u32 {
+    Raw8 = 0,   // 未压缩 8 位, 通道数见 Channels
+    BC1,
+    BC3,
+};
+
+struct CookedMipLevel {
+    u32 Width  = 0;
+    u32 Height = 0;
+    u64 Offset = 0;   // 相对 blob 起始
+    u64 Size   = 0;
+};
+
+struct CookedTextureView {
+    u32 Width = 0;
+    u32 Height = 0;
+    u32 Channels = 0;
+    CookedTextureFormat Format = CookedTextureFormat::Raw8;
+    u32 LevelCount = 0;
+    const CookedMipLevel* Levels = nullptr;
+    const u8* Base = nullptr;
+
+    const u8* GetLevelData(u32 level) const { return Base + Levels[level].Offset; }
+};
+
+// ── 编解码 ──────────────────────────────────────────────────
+
+class CookedAsset {
+public:
+    /// 模型: 多个子网格 + 名称/纹理路径字符串表 + 顶点/索引数据 (+ 可选 meshlet)
+    static void WriteModel(const std::vector<MeshCpuData>& meshes, std::vector<u8>& out,
+                           const CookedModelOptions& options = {});
+    static bool ReadModel(const u8* data, size_t size, std::vector<CookedMeshView>& out);
+
+    /// 纹理: 完整 mip 链，可选 BC 压缩 (压缩仅支持 3/4 通道)
+    static bool WriteTexture(const MipChain& chain, CookedTextureFormat format, std::vector<u8>& out);
+    static bool ReadTexture(const u8* data, size_t size, CookedTextureView& out);
+
+    /// 预制体蓝图
+    static void WritePrefab(const Prefab& prefab, std::vector<u8>& out);
+    static Ref<Prefab> ReadPrefab(const u8* data, size_t size);
+
+    /// LDtk 项目 (渲染相关子集)
+    static void WriteLdtk(const LdtkProject& project, std::vector<u8>& out);
+    static bool ReadLdtk(const u8* data, size_t size, LdtkProject& project);
+};
+
+} // namespace Engine
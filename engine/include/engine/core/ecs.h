@@ -8,6 +8,7 @@
 #include "engine/core/ecs_types.h"
 #include "engine/core/types.h"
 #include "engine/core/job_system.h"
+#include "engine/core/assert.h"
 #include <vector>
 #include <unordered_map>
 #include <typeindex>
@@ -68,6 +69,31 @@ public:
         return &m_Dense[idx];
     }
 
+    /// 批量添加组件: 稀疏表只扩容一次，稠密数组预留后顺序追加
+    /// init(i, T&) 负责填充第 i 个实体的组件 (已存在的组件先重置再填充)
+    template<typename Func>
+    void AddBulk(const Entity* entities, u32 count, Func&& init) {
+        if (count == 0) return;
+        Entity maxEntity = *std::max_element(entities, entities + count);
+        if (maxEntity >= m_Sparse.size())
+            m_Sparse.resize((size_t)maxEntity + 1, INVALID_INDEX);
+        m_Dense.reserve(m_Dense.size() + count);
+        m_Entities.reserve(m_Entities.size() + count);
+
+        for (u32 i = 0; i < count; i++) {
+            Entity e = entities[i];
+            if (m_Sparse[e] != INVALID_INDEX) {
+                T& existing = m_Dense[m_Sparse[e]];
+                existing = T();
+                init(i, existing);
+                continue;
+            }
+            m_Sparse[e] = (u32)m_Dense.size();
+            m_Entities.push_back(e);
+            init(i, m_Dense.emplace_back());
+        }
+    }
+
     /// 删除组件（swap-and-pop 保持紧密）
     void Remove(Entity e) override {
         if (e >= m_Sparse.size() || m_Sparse[e] == INVALID_INDEX)
@@ -127,6 +153,9 @@ public:
     /// 创建新实体 (自动附加 TagComponent — 需要 components.h 已包含)
     Entity CreateEntity(const std::string& name = "Entity");
 
+    /// 批量创建 count 个实体，ID 追加到 out (TagComponent 一次性批量附加)
+    void CreateEntities(u32 count, std::vector<Entity>& out, const std::string& name = "Entity");
+
     /// 销毁实体 (Generation 递增，ID 回收到 free list)
     void DestroyEntity(Entity e);
 
@@ -148,6 +177,12 @@ public:
         return *pool.Add(e, std::forward<Args>(args)...);
     }
 
+    /// 批量添加组件 (场景加载等整块写入): init(i, T&) 填充 entities[i] 的组件
+    template<typename T, typename Func>
+    void AddComponents(const Entity* entities, u32 count, Func&& init) {
+        GetPool<T>().AddBulk(entities, count, std::forward<Func>(init));
+    }
+
     /// 获取组件（可能为 nullptr）
     template<typename T>
     T* GetComponent(Entity e) {
@@ -273,6 +308,9 @@ public:
     template<typename T>
     ComponentArray<T>& GetComponentArray() { return GetPool<T>(); }
 
+    /// 并行阶段 (工作线程读组件) 期间置位: m_Pools 不加锁，此时新建组件池即数据竞争，调试版断言
+    void SetPoolCreationLocked(bool locked) { m_PoolCreationLocked = locked; }
+
 private:
     template<typename T>
     ComponentArray<T>& GetPool() {
@@ -281,6 +319,7 @@ private:
         if (it != m_Pools.end()) {
             return *static_cast<ComponentArray<T>*>(it->second.get());
         }
+        ENGINE_ASSERT(!m_PoolCreationLocked, "并行阶段新建组件池");
         auto pool = std::make_unique<ComponentArray<T>>();
         auto& ref = *pool;
         m_Pools[typeIdx] = std::move(pool);
@@ -293,6 +332,7 @@ private:
     std::vector<Entity>  m_FreeList;     // 可复用的已销毁实体 ID
     std::unordered_map<std::type_index, Scope<IComponentPool>> m_Pools;
     std::vector<Scope<System>> m_Systems;
+    bool m_PoolCreationLocked = false;
 };
 
 } // namespace Engine
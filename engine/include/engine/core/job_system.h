@@ -9,6 +9,7 @@
 #include <functional>
 #include <atomic>
 #include <vector>
+#include <algorithm>
 
 namespace Engine {
 
@@ -41,7 +42,18 @@ public:
     template<typename Func>
     static void ParallelFor(u32 begin, u32 end, Func&& fn);
 
-    /// 阻塞等待所有已提交任务完成
+    /// 按区间并行: 将 [0, count) 切成每块至少 grain 个元素的连续区间
+    /// fn 签名: void(u32 begin, u32 end)。适合 SIMD 内核或粗粒度任务列表
+    /// (ParallelFor 在元素数 <= 64 时总是串行)
+    template<typename Func>
+    static void ParallelForRange(u32 count, u32 grain, Func&& fn);
+
+    /// 执行 chunkFn(0..numChunks-1) 并等待它们全部完成。
+    /// 只等本次调用的块 (不等其他已提交任务)；调用线程自己也认领块，
+    /// 因此可以在工作线程上嵌套调用。ParallelFor / ParallelForRange 基于它实现
+    static void RunChunks(u32 numChunks, const std::function<void(u32)>& chunkFn);
+
+    /// 阻塞等待所有已提交任务完成 (包括其他系统提交的长任务，如异步寻路)
     static void WaitIdle();
 
     /// 查询线程数
@@ -81,18 +93,33 @@ void JobSystem::ParallelFor(u32 begin, u32 end, Func&& fn) {
     u32 chunkSize = total / numChunks;
     u32 remainder = total % numChunks;
 
-    for (u32 c = 0; c < numChunks; c++) {
+    RunChunks(numChunks, [&](u32 c) {
         u32 chunkBegin = begin + c * chunkSize + std::min(c, remainder);
         u32 chunkEnd   = chunkBegin + chunkSize + (c < remainder ? 1 : 0);
+        for (u32 i = chunkBegin; i < chunkEnd; i++) {
+            fn(i);
+        }
+    });
+}
 
-        Submit([chunkBegin, chunkEnd, fn]() {
-            for (u32 i = chunkBegin; i < chunkEnd; i++) {
-                fn(i);
-            }
-        });
+template<typename Func>
+void JobSystem::ParallelForRange(u32 count, u32 grain, Func&& fn) {
+    if (count == 0) return;
+    grain = std::max(grain, 1u);
+
+    u32 numChunks = std::min(s_Running ? s_ThreadCount : 0u, (count + grain - 1) / grain);
+    if (numChunks <= 1) {
+        fn(0u, count);
+        return;
     }
 
-    WaitIdle();
+    u32 chunkSize = count / numChunks;
+    u32 remainder = count % numChunks;
+    RunChunks(numChunks, [&](u32 c) {
+        u32 chunkBegin = c * chunkSize + std::min(c, remainder);
+        u32 chunkEnd   = chunkBegin + chunkSize + (c < remainder ? 1 : 0);
+        fn(chunkBegin, chunkEnd);
+    });
 }
 
 } // namespace Engine
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine {
+
+// ── JSON 解析 ───────────────────────────────────────────────
+//
+// 两阶段解析 (simdjson 思路):
+//   1. 结构索引: 每 64 字节一块，SIMD 分类引号/反斜杠/结构符/空白，
+//      位运算剔除字符串内部后，得到所有 token 起始位置
+//   2. 校验 + 跳转表: 单遍检查语法，并为每个 token 记录其后继兄弟位置
+//
+// 之后的访问是按需的: JsonValue 只是 (文档, token 序号)，数值在读取时才转换，
+// 字符串直接返回指向源缓冲区的 string_view，不做拷贝。
+
+class JsonDocument;
+class JsonElementIterator;
+class JsonMemberIterator;
+template<typename It> struct JsonRange;
+
+enum class JsonType : u8 {
+    Invalid = 0,
+    Null,
+    Bool,
+    Number,
+    String,
+    Array,
+    Object,
+};
+
+class JsonValue {
+public:
+    JsonValue() = default;
+
+    JsonType GetType() const;
+    bool IsValid() const  { return m_Doc != nullptr; }
+    bool IsNull() const   { return GetType() == JsonType::Null; }
+    bool IsBool() const   { return GetType() == JsonType::Bool; }
+    bool IsNumber() const { return GetType() == JsonType::Number; }
+    bool IsString() const { return GetType() == JsonType::String; }
+    bool IsArray() const  { return GetType() == JsonType::Array; }
+    bool IsObject() const { return GetType() == JsonType::Object; }
+    explicit operator bool() const { return IsValid(); }
+
+    // ── 标量 (类型不符时返回默认值) ────────────────────────
+    f64  AsF64(f64 def = 0.0) const;
+    f32  AsF32(f32 def = 0.0f) const { return (f32)AsF64(def); }
+    i64  AsI64(i64 def = 0) const;
+    i32  AsI32(i32 def = 0) const { return (i32)AsI64(def); }
+    bool AsBool(bool def = false) const;
+
+    /// 字符串原始内容 (引号之间，未处理转义)，指向源缓冲区
+    std::string_view AsStringView() const;
+    /// 字符串内容 (已处理转义)
+    std::string AsString(std::string_view def = {}) const;
+    /// 字符串是否等于 s (按原始内容比较，适用于不含转义的键/枚举值)
+    bool Equals(std::string_view s) const { return IsString() && AsStringView() == s; }
+
+    // ── 容器 ────────────────────────────────────────────────
+    /// 数组元素数 / 对象成员数 (线性跳跃，不展开子树)
+    u32 Size() const;
+    /// 数组第 index 个元素，越界返回无效值
+    JsonValue operator[](u32 index) const;
+    /// 对象成员查找，不存在返回无效值
+    JsonValue operator[](std::string_view key) const { return Find(key); }
+    JsonValue Find(std::string_view key) const;
+    bool Contains(std::string_view key) const { return Find(key).IsValid(); }
+
+    /// 按键读取，缺失或类型不符时返回默认值
+    f32  GetF32(std::string_view key, f32 def = 0.0f) const { return Find(key).AsF32(def); }
+    i32  GetI32(std::string_view key, i32 def = 0) const    { return Find(key).AsI32(def); }
+    bool GetBool(std::string_view key, bool def = false) const { return Find(key).AsBool(def); }
+    std::string GetString(std::string_view key, std::string_view def = {}) const {
+        return Find(key).AsString(def);
+    }
+
+    // ── 遍历 ────────────────────────────────────────────────
+    /// 数组元素 (非数组返回空区间)
+    JsonRange<JsonElementIterator> Elements() const;
+    /// 对象成员 (非对象返回空区间)
+    JsonRange<JsonMemberIterator> Members() const;
+
+private:
+    friend class JsonDocument;
+    friend class JsonElementIterator;
+    friend class JsonMemberIterator;
+    JsonValue(const JsonDocument* doc, u32 token) : m_Doc(doc), m_Token(token) {}
+
+    const JsonDocument* m_Doc = nullptr;
+    u32 m_Token = 0;
+};
+
+// ── 遍历 ────────────────────────────────────────────────────
+
+class JsonElementIterator {
+public:
+    JsonElementIterator(const JsonDocument* doc, u32 token) : m_Doc(doc), m_Token(token) {}
+    JsonValue operator*() const { return JsonValue(m_Doc, m_Token); }
+    JsonElementIterator& operator++();
+    bool operator!=(const JsonElementIterator& o) const { return m_Token != o.m_Token; }
+private:
+    const JsonDocument* m_Doc;
+    u32 m_Token;
+};
+
+struct JsonMember {
+    std::string_view Key;   // 原始内容 (未处理转义)
+    JsonValue Value;
+};
+
+class JsonMemberIterator {
+public:
+    JsonMemberIterator(const JsonDocument* doc, u32 token) : m_Doc(doc), m_Token(token) {}
+    JsonMember operator*() const;
+    JsonMemberIterator& operator++();
+    bool operator!=(const JsonMemberIterator& o) const { return m_Token != o.m_Token; }
+private:
+    const JsonDocument* m_Doc;
+    u32 m_Token;   // 指向键
+};
+
+template<typename It>
+struct JsonRange {
+    It First, Last;
+    It begin() const { return First; }
+    It end() const { return Last; }
+};
+
+// ── 文档 ────────────────────────────────────────────────────
+
+class JsonDocument {
+public:
+    JsonDocument() = default;
+    JsonDocument(const JsonDocument&) = delete;
+    JsonDocument& operator=(const JsonDocument&) = delete;
+
+    /// 解析外部缓冲区 (不拷贝: json 必须在文档生命周期内保持有效)
+    bool Parse(std::string_view json);
+    /// 解析并接管缓冲区
+    bool Parse(std::string&& json);
+    /// 读取文件并解析
+    bool LoadFile(const std::string& path);
+
+    /// 兼容旧版场景写出器: 数组中紧邻的对象/数组元素 ("}{"、"][") 之间允许缺少逗号。
+    /// 默认关闭 (严格 JSON)，须在 Parse 之前设置
+    void SetAllowMissingArrayCommas(bool allow) { m_AllowMissingCommas = allow; }
+
+    JsonValue GetRoot() const;
+    const std::string& GetError() const { return m_Error; }
+    u32 GetTokenCount() const { return (u32)m_Tokens.size(); }
+    std::string_view GetSource() const { return m_Source; }
+
+    /// 第一阶段: 结构字符索引 (结构符、字符串起始引号、标量起始位置)
+    /// 字符串未闭合时返回 false
+    static bool BuildStructuralIndex(std::string_view json, std::vector<u32>& positions);
+
+private:
+    friend class JsonValue;
+    friend class JsonElementIterator;
+    friend class JsonMemberIterator;
+
+    bool BuildTape();
+    bool Fail(u32 token, const char* what);
+
+    char CharAt(u32 token) const { return m_Source[m_Tokens[token]]; }
+    u32 Skip(u32 token) const { return m_Next[token]; }
+    std::string_view StringAt(u32 token) const;
+
+    std::string m_Owned;
+    std::string_view m_Source;
+    std::vector<u32> m_Tokens;   // token 在源中的字节偏移
+    std::vector<u32> m_Next;     // token 对应值结束后的下一个 token 序号
+    std::string m_Error;
+    bool m_AllowMissingCommas = false;
+};
+
+} // namespace Engine
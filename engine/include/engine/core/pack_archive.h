@@ -0,0 +1,139 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine {
+
+// ── 资源包 (.pak) ───────────────────────────────────────────
+//
+// 离线 cook 工具产出的单文件归档，运行时 mmap 后零拷贝读取。
+//
+// 文件布局:
+//   [PackHeader]
+//   [blob 0][pad][blob 1][pad] ...      每个 blob 按 PACK_ALIGNMENT 对齐
+//   [PackEntry × EntryCount]            按 NameHash 升序 (二分查找)
+//   [名称字符串表]                       '\0' 结尾，PackEntry::NameOffset 指向此处
+//
+// 所有整数为小端。版本不一致的包直接拒绝加载，需重新 cook。
+
+constexpr u32 PACK_MAGIC     = 0x4B415047;   // "GPAK"
+constexpr u32 PACK_VERSION   = 1;
+constexpr u32 PACK_ALIGNMENT = 16;
+
+enum class PackAssetType : u32 {
+    Raw = 0,    // 原样打包的文件
+    Mesh,       // CookedMesh: 顶点/索引 blob
+    Texture,    // CookedTexture: 预生成 mip 链 (RGBA8 / BC1 / BC3)
+    Scene,      // 场景
+    Prefab,     // 预制体蓝图
+    Ldtk,       // LDtk 项目
+};
+
+struct PackHeader {
+    u32 Magic       = PACK_MAGIC;
+    u32 Version     = PACK_VERSION;
+    u32 EntryCount  = 0;
+    u32 Reserved    = 0;
+    u64 TocOffset   = 0;
+    u64 NamesOffset = 0;
+    u64 NamesSize   = 0;
+};
+
+struct PackEntry {
+    u32 NameHash   = 0;   // SID(name)
+    u32 Type       = 0;   // PackAssetType
+    u32 Flags      = 0;   // 类型相关 (如场景 blob 的编码方式)
+    u32 NameOffset = 0;   // 名称字符串表内偏移
+    u64 Offset     = 0;   // blob 在文件内的偏移
+    u64 Size       = 0;   // blob 字节数
+};
+
+static_assert(sizeof(PackHeader) == 40, "PackHeader 布局变化需要提升 PACK_VERSION");
+static_assert(sizeof(PackEntry)  == 32, "PackEntry 布局变化需要提升 PACK_VERSION");
+
+/// 查找结果: 指向映射内存的只读视图
+struct PackBlob {
+    const u8* Data = nullptr;
+    size_t Size = 0;
+    u32 Flags = 0;
+
+    explicit operator bool() const { return Data != nullptr; }
+};
+
+// ── 只读资源包 (mmap) ───────────────────────────────────────
+
+class PackArchive {
+public:
+    PackArchive() = default;
+    ~PackArchive();
+
+    PackArchive(const PackArchive&) = delete;
+    PackArchive& operator=(const PackArchive&) = delete;
+
+    /// 映射并校验包文件
+    bool Open(const std::string& filepath);
+    void Close();
+    bool IsOpen() const { return m_Base != nullptr; }
+
+    /// 按资源名查找 (O(log n))，找不到返回 nullptr
+    const PackEntry* Find(std::string_view name) const;
+
+    /// 按资源名 + 类型查找，类型不符视为未找到
+    PackBlob Lookup(std::string_view name, PackAssetType type) const;
+
+    /// blob 起始地址 (直接指向映射内存，包关闭前有效)
+    const u8* GetData(const PackEntry& entry) const { return m_Base + entry.Offset; }
+    const char* GetName(const PackEntry& entry) const { return m_Names + entry.NameOffset; }
+
+    const PackEntry* GetEntries() const { return m_Entries; }
+    u32 GetEntryCount() const { return m_EntryCount; }
+    const std::string& GetPath() const { return m_Path; }
+    size_t GetFileSize() const { return m_Size; }
+
+private:
+    std::string m_Path;
+    const u8* m_Base = nullptr;
+    size_t m_Size = 0;
+    const PackEntry* m_Entries = nullptr;
+    const char* m_Names = nullptr;
+    u32 m_EntryCount = 0;
+
+#ifdef _WIN32
+    void* m_File = nullptr;
+    void* m_Mapping = nullptr;
+#endif
+};
+
+// ── 资源包写入 (cook 工具使用) ───────────────────────────────
+
+class PackWriter {
+public:
+    /// 添加一个 blob，同名资源后者覆盖前者
+    void Add(const std::string& name, PackAssetType type,
+             const void* data, size_t size, u32 flags = 0);
+    void Add(const std::string& name, PackAssetType type,
+             const std::vector<u8>& data, u32 flags = 0) {
+        Add(name, type, data.data(), data.size(), flags);
+    }
+
+    /// 写出完整包文件
+    bool Write(const std::string& filepath) const;
+
+    u32 GetEntryCount() const { return (u32)m_Items.size(); }
+    u64 GetPayloadSize() const;
+
+private:
+    struct Item {
+        std::string Name;
+        PackAssetType Type;
+        u32 Flags;
+        std::vector<u8> Data;
+    };
+    std::vector<Item> m_Items;
+};
+
+} // namespace Engine
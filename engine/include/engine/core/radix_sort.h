@@ -0,0 +1,31 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <vector>
+
+namespace Engine {
+
+// ── 基数排序 ────────────────────────────────────────────────
+// LSD 基数排序 (每趟 8 位，稳定)，用于按量化深度/排序键给大量元素排序。
+// 元素数较多且 JobSystem 已启动时，每趟的直方图统计与分散写入按固定区间
+// 并行执行 (区间只取决于元素数与线程数，结果与串行完全一致)。
+// 某一趟所有键落在同一桶时跳过该趟。
+//
+// 乒乓缓冲与直方图由排序器持有，复用同一个实例可避免每帧分配。
+
+class RadixSorter {
+public:
+    /// 按 key 升序稳定排序 (key, value) 对；只比较 key 的低 keyBits 位
+    void Sort(u32* keys, u32* values, u32 count, u32 keyBits = 32);
+
+    /// 元素数不少于此值时才并行
+    static constexpr u32 PARALLEL_THRESHOLD = 16384;
+
+private:
+    std::vector<u32> m_Keys;
+    std::vector<u32> m_Values;
+    std::vector<u32> m_Histograms;   // 每区间 256 桶
+};
+
+} // namespace Engine
@@ -6,6 +6,7 @@
 #include "engine/renderer/mesh.h"
 #include "engine/renderer/material.h"
 #include "engine/renderer/gltf_loader.h"
+#include "engine/core/pack_archive.h"
 #include "engine/core/log.h"
 
 #include <string>
@@ -45,6 +46,18 @@ public:
     static void StoreMesh(const std::string& name, Scope<Mesh> mesh);
     static Mesh* GetMesh(const std::string& name);
 
+    // ── 资源包 (cook 产物) ──────────────────────────────────
+    /// mmap 挂载资源包；之后按原始路径加载的资源优先从包内读取
+    static bool MountPack(const std::string& filepath);
+    static void UnmountPacks();
+    /// 在已挂载的包中查找 (后挂载者优先)，未命中返回空 PackBlob
+    static PackBlob FindPacked(const std::string& name, PackAssetType type);
+    /// 渲染端能否直接使用压缩顶点 (cook --quantize)。压缩 Mesh 没有 aBitangent 属性，
+    /// 只有内置 GL 着色器会由 aTangent.w 重建副切线；默认关闭，此时加载时解压为 MeshVertex。
+    /// 只用内置着色器 (或自定义着色器同样按 cross(N, T) * aTangent.w 重建) 的 OpenGL 应用可打开
+    static void SetPackedVertexInput(bool enabled) { s_PackedVertexInput = enabled; }
+    static bool IsPackedVertexInputEnabled() { return s_PackedVertexInput; }
+
     // ── 全局 ────────────────────────────────────────────────
     static void Clear();
     static void PrintStats();
@@ -59,10 +72,15 @@ public:
     static std::vector<std::string> LoadModel(const std::string& filepath);
 
 private:
+    static Ref<Texture2D> CreateCookedTexture(const PackBlob& blob, const std::string& name);
+    static std::vector<std::string> LoadCookedModel(const PackBlob& blob, const std::string& filepath);
+
     static std::unordered_map<std::string, Ref<Shader>> s_Shaders;
     static std::unordered_map<std::string, Ref<Texture2D>> s_Textures;
     static std::unordered_map<std::string, Scope<Mesh>> s_Meshes;
     static std::unordered_map<std::string, Ref<Material>> s_Materials;
+    static std::vector<Scope<PackArchive>> s_Packs;
+    static bool s_PackedVertexInput;
 };
 
 } // namespace Engine
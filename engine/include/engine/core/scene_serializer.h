@@ -4,19 +4,43 @@
 #include "engine/core/scene.h"
 
 #include <string>
+#include <string_view>
+#include <vector>
 
 namespace Engine {
 
 // ── 场景序列化器 ────────────────────────────────────────────
-// JSON 格式的场景保存/加载
+// JSON: 可读的交换格式 (编辑器保存 / 手工修改)
+// 二进制: 按组件类型整块存放的运行时格式，加载时批量写入 ECS 组件池
+//   [Header][点光][聚光][组件块 × N][字符串表]
+//   组件块 = [BlockHeader][实体序号 u32 × Count][定长记录 × Count]
+// 格式变化时提升 SCENE_BINARY_VERSION，旧文件需从 JSON 重新导出
+
+constexpr u32 SCENE_BINARY_MAGIC   = 0x424E4353;   // "SCNB"
+constexpr u32 SCENE_BINARY_VERSION = 1;
 
 class SceneSerializer {
 public:
     /// 保存场景到 JSON 文件
     static bool Save(const Scene& scene, const std::string& filepath);
 
-    /// 从 JSON 文件加载场景
+    /// 序列化为 JSON 文本
+    static std::string SaveToString(const Scene& scene);
+
+    /// 保存场景到二进制文件
+    static bool SaveBinary(const Scene& scene, const std::string& filepath);
+
+    /// 序列化为二进制 blob
+    static void SaveBinaryToMemory(const Scene& scene, std::vector<u8>& out);
+
+    /// 加载场景 (按文件头自动识别 JSON / 二进制；已挂载资源包中存在同名场景时优先读包)
     static Ref<Scene> Load(const std::string& filepath);
+
+    /// 从内存中的 JSON 文本加载场景
+    static Ref<Scene> LoadFromString(std::string_view json);
+
+    /// 从内存中的二进制 blob 加载场景 (直接读取，不拷贝 blob；要求 4 字节对齐)
+    static Ref<Scene> LoadFromMemory(const u8* data, size_t size);
 };
 
 } // namespace Engine
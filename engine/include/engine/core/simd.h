@@ -0,0 +1,84 @@
+#pragma once
+
+// ── SIMD 平台检测 ───────────────────────────────────────────
+// x86-64 默认具备 SSE2，AArch64 默认具备 NEON；其余平台走标量路径。
+// 需要更高指令集 (AVX2 等) 的代码应自行做运行时检测，这里只暴露基线。
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define ENGINE_SIMD_SSE2 1
+    #include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define ENGINE_SIMD_NEON 1
+    #include <arm_neon.h>
+#endif
+
+#include <cmath>
+
+namespace Engine::Simd {
+
+// ── 4 路 float 向量 ─────────────────────────────────────────
+// 只覆盖动画/蒙皮/粒子等 SoA 批处理用到的运算；无 SIMD 时退化为逐分量循环。
+
+#if defined(ENGINE_SIMD_SSE2)
+
+using F4 = __m128;
+
+inline F4 Load(const float* p)          { return _mm_loadu_ps(p); }
+inline void Store(float* p, F4 v)       { _mm_storeu_ps(p, v); }
+inline F4 Set1(float x)                 { return _mm_set1_ps(x); }
+inline F4 Add(F4 a, F4 b)               { return _mm_add_ps(a, b); }
+inline F4 Sub(F4 a, F4 b)               { return _mm_sub_ps(a, b); }
+inline F4 Mul(F4 a, F4 b)               { return _mm_mul_ps(a, b); }
+inline F4 Div(F4 a, F4 b)               { return _mm_div_ps(a, b); }
+inline F4 MulAdd(F4 a, F4 b, F4 c)      { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+inline F4 Min(F4 a, F4 b)               { return _mm_min_ps(a, b); }
+inline F4 Max(F4 a, F4 b)               { return _mm_max_ps(a, b); }
+inline F4 Sqrt(F4 a)                    { return _mm_sqrt_ps(a); }
+/// a 的符号乘以 s 的符号 (s < 0 时取反 a)
+inline F4 FlipSign(F4 a, F4 s)          { return _mm_xor_ps(a, _mm_and_ps(s, _mm_set1_ps(-0.0f))); }
+
+#elif defined(ENGINE_SIMD_NEON)
+
+using F4 = float32x4_t;
+
+inline F4 Load(const float* p)          { return vld1q_f32(p); }
+inline void Store(float* p, F4 v)       { vst1q_f32(p, v); }
+inline F4 Set1(float x)                 { return vdupq_n_f32(x); }
+inline F4 Add(F4 a, F4 b)               { return vaddq_f32(a, b); }
+inline F4 Sub(F4 a, F4 b)               { return vsubq_f32(a, b); }
+inline F4 Mul(F4 a, F4 b)               { return vmulq_f32(a, b); }
+inline F4 Div(F4 a, F4 b)               { return vdivq_f32(a, b); }
+inline F4 MulAdd(F4 a, F4 b, F4 c)      { return vmlaq_f32(c, a, b); }
+inline F4 Min(F4 a, F4 b)               { return vminq_f32(a, b); }
+inline F4 Max(F4 a, F4 b)               { return vmaxq_f32(a, b); }
+inline F4 Sqrt(F4 a)                    { return vsqrtq_f32(a); }
+inline F4 FlipSign(F4 a, F4 s) {
+    uint32x4_t sign = vandq_u32(vreinterpretq_u32_f32(s), vdupq_n_u32(0x80000000u));
+    return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(a), sign));
+}
+
+#else
+
+struct F4 { float v[4]; };
+
+#define ENGINE_SIMD_F4_OP(name, expr)                                    \
+    inline F4 name(F4 a, F4 b) { F4 r; for (int i = 0; i < 4; i++) {     \
+        float x = a.v[i], y = b.v[i]; r.v[i] = (expr); } return r; }
+
+inline F4 Load(const float* p)          { F4 r; for (int i = 0; i < 4; i++) r.v[i] = p[i]; return r; }
+inline void Store(float* p, F4 v)       { for (int i = 0; i < 4; i++) p[i] = v.v[i]; }
+inline F4 Set1(float x)                 { return F4{{x, x, x, x}}; }
+ENGINE_SIMD_F4_OP(Add, x + y)
+ENGINE_SIMD_F4_OP(Sub, x - y)
+ENGINE_SIMD_F4_OP(Mul, x * y)
+ENGINE_SIMD_F4_OP(Div, x / y)
+ENGINE_SIMD_F4_OP(Min, x < y ? x : y)
+ENGINE_SIMD_F4_OP(Max, x > y ? x : y)
+ENGINE_SIMD_F4_OP(FlipSign, std::signbit(y) ? -x : x)
+#undef ENGINE_SIMD_F4_OP
+inline F4 MulAdd(F4 a, F4 b, F4 c)      { return Add(Mul(a, b), c); }
+inline F4 Sqrt(F4 a)                    { F4 r; for (int i = 0; i < 4; i++) r.v[i] = std::sqrt(a.v[i]); return r; }
+
+#endif
+
+} // namespace Engine::Simd
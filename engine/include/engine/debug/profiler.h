@@ -18,6 +18,7 @@ public:
         std::string Name;
         f64 DurationMs = 0;   // 毫秒
         u32 Depth = 0;        // 嵌套深度 (0=顶层)
+        bool OtherThread = false;   // 其他线程的耗时 (不计入帧总时间)
     };
 
     struct FrameStats {
@@ -31,6 +32,9 @@ public:
     /// 结束计时
     static void EndTimer(const std::string& name);
 
+    /// 记录其他线程测得的耗时 (在主线程调用，如 AI 工作线程的上一份快照)
+    static void RecordTimer(const std::string& name, f64 ms);
+
     /// 每帧结束调用 — 汇总并存储帧数据
     static void EndFrame();
 
@@ -139,6 +139,10 @@ public:
     /// 录入场景信息
     static void RecordSceneInfo(u32 entities, u32 activeLights, u32 particleEmitters);
 
+    /// 录入粒子绘制统计 (剔除/排序/实例上传量)
+    static void RecordParticles(u32 visibleEmitters, u32 culledEmitters, u32 drawnParticles,
+                                u32 sortedParticles, u32 uploadBytes);
+
     /// ImGui 渲染 (每帧调用)
     static void Render();
 
@@ -207,6 +211,13 @@ private:
     inline static u32 s_Entities = 0;
     inline static u32 s_ActiveLights = 0;
     inline static u32 s_ParticleEmitters = 0;
+
+    // Particles
+    inline static u32 s_ParticleVisibleEmitters = 0;
+    inline static u32 s_ParticleCulledEmitters = 0;
+    inline static u32 s_ParticlesDrawn = 0;
+    inline static u32 s_ParticlesSorted = 0;
+    inline static u32 s_ParticleUploadBytes = 0;
 };
 
 } // namespace Engine
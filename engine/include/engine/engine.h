@@ -16,15 +16,20 @@
 #include "engine/core/systems.h"
 #include "engine/core/string_id.h"
 #include "engine/core/resource_manager.h"
+#include "engine/core/json.h"
+#include "engine/core/pack_archive.h"
+#include "engine/core/cooked_asset.h"
 #include "engine/core/scene.h"
 #include "engine/core/scene_serializer.h"
 #include "engine/core/script_system.h"
 #include "engine/core/prefab.h"
 #include "engine/core/job_system.h"
+#include "engine/core/radix_sort.h"
 #include "engine/core/async_loader.h"
 #include "engine/core/application.h"
 #include "engine/core/allocator.h"
 #include "engine/core/random.h"
+#include "engine/core/simd.h"
 
 // Platform
 #include "engine/platform/window.h"
@@ -38,14 +43,19 @@
 #include "engine/renderer/shader.h"
 #include "engine/renderer/buffer.h"
 #include "engine/renderer/texture.h"
+#include "engine/renderer/mip_chain.h"
+#include "engine/renderer/bc_encoder.h"
+#include "engine/renderer/texture_streamer.h"
 #include "engine/renderer/camera.h"
 #include "engine/renderer/light.h"
 #include "engine/renderer/mesh.h"
+#include "engine/renderer/mesh_optimizer.h"
 #include "engine/renderer/material.h"
 #include "engine/renderer/framebuffer.h"
 #include "engine/renderer/post_process.h"
 #include "engine/renderer/skybox.h"
 #include "engine/renderer/particle.h"
+#include "engine/renderer/particle_emitter.h"
 #include "engine/renderer/bloom.h"
 #include "engine/renderer/scene_renderer.h"
 #include "engine/renderer/shaders.h"
@@ -56,7 +66,10 @@
 #include "engine/renderer/frustum.h"
 #include "engine/renderer/screen_quad.h"
 #include "engine/renderer/sprite_batch.h"
+#include "engine/renderer/sprite_list.h"
 #include "engine/renderer/font.h"
+#include "engine/renderer/atlas_packer.h"
+#include "engine/renderer/texture_atlas.h"
 #include "engine/renderer/gltf_loader.h"
 #include "engine/renderer/viewport_modes.h"
 #include "engine/renderer/ssao.h"
@@ -68,12 +81,14 @@
 #include "engine/renderer/instance_renderer.h"
 #include "engine/renderer/animation.h"
 #include "engine/renderer/animation_blend.h"
+#include "engine/renderer/animation_compression.h"
 #include "engine/renderer/animation_event.h"
 #include "engine/renderer/animation_ik.h"
 #include "engine/renderer/animation_layer.h"
 #include "engine/renderer/animation_root_motion.h"
 #include "engine/renderer/animation_state_machine.h"
 #include "engine/renderer/skinning_utils.h"
+#include "engine/renderer/skinned_instance_renderer.h"
 #include "engine/renderer/volumetric.h"
 
 // Debug
@@ -119,7 +134,9 @@
 
 // Game2D (引擎级通用 2D 工具)
 #include "engine/game2d/sprite2d.h"
+#include "engine/game2d/tile_collision_grid.h"
 #include "engine/game2d/tilemap.h"
+#include "engine/game2d/tilemap_chunks.h"
 #include "engine/game2d/camera2d_controller.h"
 
 // AI (optional)
@@ -31,6 +31,7 @@ struct AABB2D {
 namespace Collision2D {
 
 /// 分轴 Tilemap 碰撞移动 — 返回修正后的新位置
+/// 在位压缩碰撞网格上扫掠: 每轴走到碰到 Solid 为止 (贴墙滑动)，地图外视为 Solid
 /// @param tilemap  瓦片地图引用
 /// @param oldPos   当前位置 (中心)
 /// @param newPos   目标位置 (中心)
@@ -40,38 +41,18 @@ inline glm::vec2 MoveAndSlide(const Tilemap& tilemap,
                                const glm::vec2& newPos,
                                const glm::vec2& halfSize)
 {
-    glm::vec2 result = oldPos;
-    u32 w = tilemap.GetWidth();
-    u32 h = tilemap.GetHeight();
-
-    // 辅助 lambda: 检查 AABB 四角是否碰到 Solid
-    auto isSolidAt = [&](f32 cx, f32 cy) -> bool {
-        // 检测 AABB 四角覆盖的 tile
-        i32 x0 = (i32)std::floor(cx - halfSize.x);
-        i32 y0 = (i32)std::floor(cy - halfSize.y);
-        i32 x1 = (i32)std::floor(cx + halfSize.x - 0.001f);
-        i32 y1 = (i32)std::floor(cy + halfSize.y - 0.001f);
-
-        for (i32 ty = y0; ty <= y1; ty++) {
-            for (i32 tx = x0; tx <= x1; tx++) {
-                if (tx < 0 || ty < 0 || tx >= (i32)w || ty >= (i32)h)
-                    return true;  // 越界视为 Solid
-                if (tilemap.IsSolid((u32)tx, (u32)ty))
-                    return true;
-            }
-        }
-        return false;
-    };
-
-    // 分轴 X
-    if (!isSolidAt(newPos.x, oldPos.y))
-        result.x = newPos.x;
-
-    // 分轴 Y
-    if (!isSolidAt(result.x, newPos.y))
-        result.y = newPos.y;
+    return tilemap.GetCollisionGrid().MoveAndSlide(oldPos, newPos, halfSize);
+}
 
-    return result;
+/// 批量分轴碰撞移动 — 一次解算所有移动实体 (大量丧尸时经 JobSystem 并行)
+/// newPos 原地改为修正后的位置
+inline void MoveAndSlideBatch(const Tilemap& tilemap,
+                              const glm::vec2* oldPos,
+                              glm::vec2* newPos,
+                              const glm::vec2* halfSize,
+                              u32 count)
+{
+    tilemap.GetCollisionGrid().MoveAndSlideBatch(oldPos, newPos, halfSize, count);
 }
 
 /// 圆形推挤 — 两个圆形碰撞体之间的推开方向和距离
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Engine {
+
+enum class TileCollision : u8;
+
+// ── 位压缩碰撞网格 ──────────────────────────────────────────
+// Tilemap 的派生数据: 每种碰撞类型一个位平面，每个 tile 1 bit，每行按 u64 对齐。
+// 存的是各层合并后的有效类型 (与 Tilemap::GetCollision 相同，取最大值)，
+// 所以同一 tile 只在一个位平面中置位。由 Tilemap::SetTile / MarkDirty 增量维护。
+//
+// 矩形查询与扫掠按行做 64 位掩码运算: 一次判断 64 个 tile，
+// 扫掠用 countr_zero / countl_zero 直接找到运动方向上的第一个阻挡列。
+// 地图以外一律视为阻挡。
+
+class TileCollisionGrid {
+public:
+    /// 位平面数 (Solid / Water / Interact；None 不存)
+    static constexpr u32 CLASS_COUNT = 3;
+
+    /// 重新分配并清空
+    void Resize(u32 width, u32 height);
+
+    void Set(u32 x, u32 y, TileCollision collision);
+    TileCollision Get(u32 x, u32 y) const;
+    bool Test(TileCollision collision, u32 x, u32 y) const;
+
+    /// tile 矩形 [x0, x1]×[y0, y1] (含两端) 内是否有该类型的 tile；越界部分算命中
+    bool AnyInRect(TileCollision collision, i32 x0, i32 y0, i32 x1, i32 y1) const;
+
+    /// 中心 center、半尺寸 halfSize 的 AABB 沿 X / Y 移动 delta，返回碰到 Solid 前
+    /// 实际能走的距离 (贴住 tile 边缘)。起点已重叠的 tile 不阻挡，卡进墙里的实体可以走出来
+    f32 SweepX(const glm::vec2& center, const glm::vec2& halfSize, f32 dx) const;
+    f32 SweepY(const glm::vec2& center, const glm::vec2& halfSize, f32 dy) const;
+
+    /// 分轴移动 (先 X 后 Y)，贴墙滑动。返回修正后的位置
+    glm::vec2 MoveAndSlide(const glm::vec2& oldPos, const glm::vec2& newPos, const glm::vec2& halfSize) const;
+
+    /// 批量 MoveAndSlide: newPos 原地改为修正后的位置。count 较大时经 JobSystem 并行
+    void MoveAndSlideBatch(const glm::vec2* oldPos, glm::vec2* newPos, const glm::vec2* halfSize, u32 count) const;
+
+    u32 GetWidth() const { return m_Width; }
+    u32 GetHeight() const { return m_Height; }
+    u32 GetWordsPerRow() const { return m_WordsPerRow; }
+    /// 第 y 行的位 (bit x & 63 of word x >> 6)
+    const u64* GetRow(TileCollision collision, u32 y) const;
+
+private:
+    u64* Row(u32 plane, u32 y) { return m_Bits.data() + ((size_t)plane * m_Height + y) * m_WordsPerRow; }
+    const u64* Row(u32 plane, u32 y) const { return m_Bits.data() + ((size_t)plane * m_Height + y) * m_WordsPerRow; }
+
+    /// 第 y 行 [x0, x1] 列中是否有置位 (调用方保证在界内)
+    bool RowAny(u32 plane, u32 y, u32 x0, u32 x1) const;
+    /// 行 [y0, y1] 合并后，[x0, x1] 内最左 (ascending) / 最右的置位列；没有返回 -1
+    i32 FindColumn(u32 plane, u32 y0, u32 y1, u32 x0, u32 x1, bool ascending) const;
+
+    u32 m_Width = 0;
+    u32 m_Height = 0;
+    u32 m_WordsPerRow = 0;
+    std::vector<u64> m_Bits;   // [plane][y][word]
+};
+
+} // namespace Engine
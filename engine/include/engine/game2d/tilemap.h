@@ -3,6 +3,7 @@
 #include "engine/core/types.h"
 #include "engine/core/ecs.h"
 #include "engine/renderer/texture.h"
+#include "engine/game2d/tile_collision_grid.h"
 
 #include <glm/glm.hpp>
 #include <string>
@@ -32,6 +33,7 @@ struct TileData {
 struct TilemapLayer {
     std::string Name;
     std::vector<TileData> Tiles;          // width * height 大小
+    std::vector<u32> ChunkVersions;       // 每个区块的修改版本 (见 Tilemap::MarkDirty)
     bool Visible = true;
     i32  ZOrder = 0;
 };
@@ -40,6 +42,9 @@ struct TilemapLayer {
 
 class Tilemap {
 public:
+    /// 渲染区块边长 (tile)
+    static constexpr u32 CHUNK_SIZE = 32;
+
     Tilemap() = default;
     Tilemap(u32 width, u32 height, u32 tileSize);
 
@@ -54,9 +59,20 @@ public:
     const TileData& GetTile(u32 layerIdx, u32 x, u32 y) const;
     void SetTile(u32 layerIdx, u32 x, u32 y, const TileData& tile);
 
-    /// 碰撞查询
+    /// 标记 (x, y) 所在区块已修改并刷新该 tile 的碰撞位 (SetTile 自动调用；
+    /// 直接改写 GetTile 的引用后需手动调用)。位于区块边缘时相邻区块一并标记 (autotile 依赖四邻)
+    void MarkDirty(u32 layerIdx, u32 x, u32 y);
+
+    /// 区块版本号: 每次修改取进程内全局递增的新值 (重新生成地图也不会重复)，
+    /// 缓存记下构建时的版本即可判断是否过期
+    u32 GetChunkCountX() const { return (m_Width + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+    u32 GetChunkCountY() const { return (m_Height + CHUNK_SIZE - 1) / CHUNK_SIZE; }
+    u32 GetChunkVersion(u32 layerIdx, u32 cx, u32 cy) const;
+
+    /// 碰撞查询 (查位压缩碰撞网格，各层取最高优先的碰撞类型)
     TileCollision GetCollision(u32 x, u32 y) const;
     bool IsSolid(u32 x, u32 y) const;
+    const TileCollisionGrid& GetCollisionGrid() const { return m_CollisionGrid; }
 
     /// 世界坐标 → Tile 坐标
     glm::ivec2 WorldToTile(const glm::vec2& worldPos) const;
@@ -79,10 +95,14 @@ public:
     void SetTilesetColumns(u32 cols) { m_TilesetColumns = cols; }
 
 private:
+    /// 重新合并 (x, y) 各层的碰撞类型写入碰撞网格
+    void RefreshCollision(u32 x, u32 y);
+
     u32 m_Width  = 0;
     u32 m_Height = 0;
     u32 m_TileSize = 16;                  // 像素
     std::vector<TilemapLayer> m_Layers;
+    TileCollisionGrid m_CollisionGrid;    // 派生数据，随 SetTile 增量更新
     std::string m_TilesetTexture;
     u32 m_TilesetColumns = 16;            // 图集每行 Tile 数
 
@@ -91,13 +111,26 @@ private:
 
 // ── Tilemap 渲染器 ─────────────────────────────────────────
 
+class TilemapChunkCache;
+
 class TilemapRenderer {
 public:
-    /// 绘制可见区域 (相机视锥裁剪)
+    /// 绘制可见区域 (相机视锥裁剪)，每帧逐 tile 提交
     static void Draw(const Tilemap& map,
                      const glm::vec2& cameraPos,
                      const glm::vec2& viewportSize,
                      f32 pixelsPerUnit = 16.0f);
+
+    /// 区块网格版本: 重建过期区块后按层绘制可见区块 (cache 需已设置 mesher，
+    /// 如 TilemapChunkCache::CreateTilesetMesher)
+    static void Draw(TilemapChunkCache& cache,
+                     const Tilemap& map,
+                     const glm::vec2& cameraPos,
+                     const glm::vec2& viewportSize,
+                     const glm::mat4& transform = glm::mat4(1.0f));
+
+    /// tileset 中 TileID 对应的 UV 子区域 (含半像素内缩)
+    static glm::vec4 GetTileUV(u16 tileID, u32 tileSize, u32 columns, u32 texWidth, u32 texHeight);
 };
 
 // ── Tilemap 组件 (挂到 Entity 上) ──────────────────────────
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/game2d/tilemap.h"
+#include "engine/renderer/sprite_list.h"
+
+#include <glm/glm.hpp>
+#include <functional>
+#include <vector>
+
+namespace Engine {
+
+class SpriteStaticMesh;
+
+/// 把 (x, y) 处的 tile 写入所在区块的命令列表。会在多个工作线程上同时调用，
+/// 只能读取 map；同一区块同一层的 tile 按纹理排序合批，不能依赖提交顺序
+using TileMesher = std::function<void(const Tilemap& map, u32 layer, u32 x, u32 y, SpriteCommandList& out)>;
+
+// ── Tilemap 区块网格缓存 ────────────────────────────────────
+// 每层切成 Tilemap::CHUNK_SIZE² 的区块，各自烘焙成常驻 GPU 的 SpriteStaticMesh。
+// 只重建版本号变化 (SetTile / MarkDirty) 的区块: 顶点在 JobSystem 工作线程上
+// 并行生成，主线程只做上传。绘制时每个可见区块每层通常只有一次 DrawCall。
+//
+// 网格坐标为 tile 单位 (tile (x, y) 占 [x, x+1]×[y, y+1])，由 Draw 的 transform
+// 变换到屏幕像素；视野移动只改 transform，不触发重建。
+
+class TilemapChunkCache {
+public:
+    struct Chunk {
+        u32 BuiltVersion = 0;
+        bool NeedsUpload = false;
+        std::vector<SpriteVertex> Vertices;
+        std::vector<SpriteDrawBatch> Batches;
+        Scope<SpriteStaticMesh> Mesh;
+    };
+
+    TilemapChunkCache();
+    ~TilemapChunkCache();
+
+    TilemapChunkCache(const TilemapChunkCache&) = delete;
+    TilemapChunkCache& operator=(const TilemapChunkCache&) = delete;
+
+    /// 更换 mesher 后所有区块在下次 Rebuild 时重建
+    void SetMesher(TileMesher mesher);
+
+    /// tileset 图集的默认 mesher (TileID - 1 按列数换算 UV，与 TilemapRenderer::Draw 相同)
+    static TileMesher CreateTilesetMesher(const Ref<Texture2D>& tileset, u32 tileSize, u32 columns);
+
+    /// 重建过期的区块 (仅 CPU，并行)。地图尺寸或层数变化时全部重建。返回重建的区块数
+    u32 Rebuild(const Tilemap& map);
+
+    /// 上传 Rebuild 生成的顶点 (需要 GL 上下文)
+    void Upload();
+
+    /// 把覆盖 tile 区域 [minTile, maxTile] 的区块的第 layer 层提交给 SpriteBatch
+    void Draw(u32 layer, const glm::ivec2& minTile, const glm::ivec2& maxTile, const glm::mat4& transform) const;
+
+    /// 丢弃全部区块数据
+    void Invalidate();
+
+    u32 GetChunkCountX() const { return m_ChunksX; }
+    u32 GetChunkCountY() const { return m_ChunksY; }
+    u32 GetLayerCount() const { return m_Layers; }
+    const Chunk& GetChunk(u32 layer, u32 cx, u32 cy) const {
+        return m_Chunks[((size_t)layer * m_ChunksY + cy) * m_ChunksX + cx];
+    }
+
+private:
+    TileMesher m_Mesher;
+    u32 m_MapWidth = 0, m_MapHeight = 0;
+    u32 m_ChunksX = 0, m_ChunksY = 0, m_Layers = 0;
+    std::vector<Chunk> m_Chunks;   // [layer][cy][cx]
+    std::vector<u32> m_Stale;      // Rebuild 临时: 过期区块下标
+};
+
+} // namespace Engine
@@ -2,6 +2,7 @@
 
 #include "engine/core/types.h"
 #include "engine/core/ecs.h"
+#include "engine/renderer/animation_compression.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -12,6 +13,8 @@
 
 namespace Engine {
 
+class Frustum;
+
 // ── 最大骨骼数 ──────────────────────────────────────────────
 constexpr u32 MAX_BONES = 128;
 
@@ -24,6 +27,28 @@ struct Bone {
     glm::mat4 LocalTransform = glm::mat4(1.0f);     // 当前局部变换
 };
 
+// ── 骨骼局部姿势 (TRS) ─────────────────────────────────────
+
+struct BonePose {
+    glm::vec3 Position = {0, 0, 0};
+    glm::quat Rotation = glm::quat(1, 0, 0, 0);
+    glm::vec3 Scale    = {1, 1, 1};
+};
+
+// ── 仿射变换 (3×4 行主序) ───────────────────────────────────
+// 省去恒为 (0,0,0,1) 的末行: 48 字节，组合时每行 3 次乘加 (SIMD)。
+// 模型空间姿势与绑定逆矩阵都以此形式参与计算，只在输出时展开为 mat4。
+
+struct AffineTransform {
+    glm::vec4 Rows[3] = {{1, 0, 0, 0}, {0, 1, 0, 0}, {0, 0, 1, 0}};
+
+    static AffineTransform FromPose(const BonePose& pose);
+    static AffineTransform FromMat4(const glm::mat4& m);
+    glm::mat4 ToMat4() const;
+
+    AffineTransform operator*(const AffineTransform& rhs) const;
+};
+
 // ── 关键帧 ──────────────────────────────────────────────────
 
 struct PositionKey {
@@ -83,8 +108,19 @@ public:
     /// 输出: FinalMatrices[i] = GlobalTransform[i] * InverseBindMatrix[i]
     void ComputeBoneMatrices(std::vector<glm::mat4>& outMatrices) const;
 
+    /// 由外部局部姿势计算骨骼矩阵 (不读写骨架状态，可多线程共享同一骨架)
+    /// localPose / modelPose / outMatrices 均为 GetBoneCount() 个元素，
+    /// modelPose 输出模型空间全局变换
+    void ComputeBoneMatrices(const BonePose* localPose, AffineTransform* modelPose,
+                             glm::mat4* outMatrices) const;
+
+    /// 绑定姿势 (AddBone 时由 LocalTransform 分解)
+    const std::vector<BonePose>& GetRestPose() const { return m_RestPose; }
+
 private:
     std::vector<Bone> m_Bones;
+    std::vector<BonePose> m_RestPose;
+    std::vector<AffineTransform> m_InverseBind;   // InverseBindMatrix 的 3×4 形式
     std::unordered_map<std::string, i32> m_BoneNameMap;  // 名称→索引
 };
 
@@ -96,6 +132,13 @@ public:
     static void Sample(const AnimationClip& clip, f32 time,
                        Skeleton& skeleton);
 
+    /// 采样到实例自己的姿势缓冲 (outPose 为 GetBoneCount() 个元素)
+    /// 无通道的骨骼取绑定姿势；不修改骨架，可并行调用
+    /// boneLimit: 只采样索引小于此值的骨骼 (LOD 减骨)，其余同样取绑定姿势
+    static void SamplePose(const AnimationClip& clip, f32 time,
+                           const Skeleton& skeleton, BonePose* outPose,
+                           u32 boneLimit = ~0u);
+
 private:
     /// 线性插值位置
     static glm::vec3 InterpolatePosition(const std::vector<PositionKey>& keys, f32 time);
@@ -105,27 +148,218 @@ private:
     static glm::vec3 InterpolateScale(const std::vector<ScaleKey>& keys, f32 time);
 };
 
+// ── 共享动画资源 ────────────────────────────────────────────
+// 骨架与剪辑加载后只读，同一模型的所有实例共享一份 (按 Ref 引用)
+
+struct AnimationSet {
+    Ref<const Skeleton> SkeletonData;
+    std::vector<AnimationClip> Clips;
+    std::vector<CompressedClip> Compressed;       // 与 Clips 一一对应 (为空 = 未压缩)
+
+    /// 按名称查找剪辑索引 (-1 = 未找到)
+    i32 FindClip(const std::string& name) const;
+
+    /// 压缩全部剪辑 (共享前调用)，之后 AnimationSystem 走压缩采样
+    /// keepRaw = false 时清空原始关键帧，只保留名称和时长
+    /// (AnimLayerStack / RootMotionExtractor 仍需原始关键帧)
+    void CompressClips(const AnimationCompressionSettings& settings = {}, bool keepRaw = true);
+};
+
+using AnimationSetRef = Ref<const AnimationSet>;
+
 // ── 动画组件 ────────────────────────────────────────────────
 
 struct AnimatorComponent : public Component {
-    Ref<Skeleton> SkeletonRef;
-    std::vector<AnimationClip> Clips;            // 可用动画列表
+    AnimationSetRef Animations;                   // 共享骨架 + 剪辑 (只读)
     std::string CurrentClip;                      // 当前播放的动画名
     f32 CurrentTime = 0.0f;
     f32 PlaybackSpeed = 1.0f;
     bool Loop = true;
     bool Playing = true;
 
+    /// CurrentClip 解析后的剪辑索引 (-1 = 待解析)
+    /// 直接修改 CurrentClip 后需置 -1，或改用 Play()
+    i32 ClipIndex = -1;
+
+    /// 压缩剪辑的关键帧游标 (每实例)
+    AnimationCursor Cursor;
+
+    /// 包围球半径 (剔除与屏幕尺寸估算，球心取 TransformComponent 世界位置)
+    f32 BoundsRadius = 1.0f;
+
     /// 最终骨骼矩阵 (由 AnimationSystem 每帧更新)
     std::vector<glm::mat4> BoneMatrices;
+
+    /// 本帧骨骼调色板在 BonePaletteBuffer 中的偏移 (骨骼数)，实例化蒙皮按此寻址
+    /// 未设置调色板、被剔除或调色板已满时为 INVALID_PALETTE_OFFSET
+    u32 PaletteOffset = 0xFFFFFFFFu;
+
+    // ── LOD 运行时状态 (由 AnimationSystem 维护) ──────────────
+    u8  LODLevel = 0;
+    u16 FramesSinceEval = 0;      // 距上次采样的帧数
+    bool PoseValid = false;       // false = 首次或刚恢复可见，需立即采样
+    std::vector<glm::mat4> PrevMatrices;   // 降频时的插值端点: 当前时刻
+    std::vector<glm::mat4> NextMatrices;   //                   下次采样时刻 (预采样)
+
+    /// 切换剪辑并从头播放
+    void Play(const std::string& clip) {
+        CurrentClip = clip;
+        ClipIndex = -1;
+        CurrentTime = 0.0f;
+        Playing = true;
+    }
+};
+
+// ── 姿势缓冲池 ──────────────────────────────────────────────
+// 每帧为活跃实例线性分配局部姿势 / 模型空间矩阵切片。
+// 容量只增不减，稳定后不再分配；切片互不重叠，可并行写入。
+// Allocate 只能在分发任务前单线程调用 (扩容会使指针失效)。
+
+class PoseArena {
+public:
+    void Reset() { m_Used = 0; }
+
+    /// 分配 boneCount 根骨骼的切片，返回偏移
+    u32 Allocate(u32 boneCount);
+
+    BonePose*        Local(u32 offset) { return m_Local.data() + offset; }
+    AffineTransform* Model(u32 offset) { return m_Model.data() + offset; }
+
+    u32 GetUsed() const     { return m_Used; }
+    u32 GetCapacity() const { return (u32)m_Local.size(); }
+
+private:
+    std::vector<BonePose>        m_Local;
+    std::vector<AffineTransform> m_Model;
+    u32 m_Used = 0;
+};
+
+// ── 骨骼调色板 ──────────────────────────────────────────────
+// 本帧所有可见实例的蒙皮矩阵连续存放 (每骨骼一个 3×4 行主序仿射矩阵，48 字节)，
+// 实例化蒙皮着色器按实例属性中的偏移取用。存储可以是外部映射的 GPU 缓冲
+// (SkinnedInstanceRenderer 的上传环)，未设置时使用内部数组。
+// Allocate 只在分发任务前单线程调用，切片互不重叠，可并行写入。
+
+constexpr u32 INVALID_PALETTE_OFFSET = 0xFFFFFFFFu;
+
+class BonePaletteBuffer {
+public:
+    /// 改用外部存储 (如映射的 PBO)，capacity 为骨骼数；data 为空恢复内部数组
+    void SetExternalStorage(AffineTransform* data, u32 capacity);
+    void Reset() { m_Used = 0; }
+
+    /// 分配 boneCount 根骨骼，返回偏移；外部存储容量不足时返回 INVALID_PALETTE_OFFSET
+    u32 Allocate(u32 boneCount);
+
+    AffineTransform*       Data(u32 offset)       { return m_Data + offset; }
+    const AffineTransform* Data(u32 offset) const { return m_Data + offset; }
+
+    u32 GetUsed() const     { return m_Used; }
+    u32 GetCapacity() const { return m_Capacity; }
+    bool IsExternal() const { return m_External; }
+
+private:
+    std::vector<AffineTransform> m_Owned;
+    AffineTransform* m_Data = nullptr;
+    u32 m_Capacity = 0;
+    u32 m_Used = 0;
+    bool m_External = false;
+};
+
+// ── 动画 LOD ────────────────────────────────────────────────
+// 按投影尺寸 (有 ProjectionScale 时) 或距离选级。降频的实例在采样帧预采样
+// 下一次采样时刻的姿势，中间帧在两端骨骼矩阵间线性插值；远级可只采样
+// 前 MaxBones 根骨骼 (骨骼按父在前排序，末端的手指/面部骨骼保持绑定姿势)。
+
+struct AnimationLODLevel {
+    f32 MinScreenSize  = 0.0f;   // 包围球投影直径 (像素) 不小于此值时使用该级
+    f32 MaxDistance    = 0.0f;   // 无投影信息时: 距离不大于此值时使用该级
+    u32 UpdateInterval = 1;      // 每 N 帧采样一次
+    u32 MaxBones       = 0;      // 0 = 全部骨骼
+};
+
+struct AnimationLODSettings {
+    std::vector<AnimationLODLevel> Levels = {
+        {200.0f, 15.0f, 1, 0},
+        { 80.0f, 40.0f, 2, 0},
+        { 30.0f, 80.0f, 4, 32},
+        {  0.0f, 1e30f, 8, 16},
+    };
+    /// 每帧采样耗时预算 (毫秒，0 = 不限)。超出时按优先级 (投影尺寸 × 逾期帧数)
+    /// 推迟低优先级实例的采样，被推迟的实例停在最近一次预采样的姿势
+    f32 FrameBudgetMs = 0.0f;
+};
+
+/// 观察者与剔除输入，通常取自上一帧 SceneRenderer::GetCullResults()
+struct AnimationView {
+    glm::vec3 CameraPosition{0.0f};
+    f32 ProjectionScale = 0.0f;            // 视口高度 / (2·tan(fov/2))，0 = 按距离分级
+    const Frustum* CullFrustum = nullptr;  // 为空 = 不剔除
+};
+
+struct AnimationFrameStats {
+    u32 Animators     = 0;   // 参与更新的实例
+    u32 Evaluated     = 0;   // 本帧采样
+    u32 Interpolated  = 0;   // 本帧插值
+    u32 Culled        = 0;   // 视锥外跳过
+    u32 Deferred      = 0;   // 因预算推迟
+    u32 EvaluatedBones = 0;
+    f32 UpdateMs      = 0.0f;
 };
 
 // ── 动画系统 ────────────────────────────────────────────────
+// 串行阶段推进时间、解析剪辑、选 LOD、按预算挑选本帧采样的实例并分配
+// 姿势切片，随后采样/插值按实例分发到 JobSystem 并行执行。
 
 class AnimationSystem : public System {
 public:
     void Update(ECSWorld& world, f32 dt) override;
     const char* GetName() const override { return "AnimationSystem"; }
+
+    void SetView(const AnimationView& view) { m_View = view; }
+    void SetLODSettings(const AnimationLODSettings& settings) { m_LOD = settings; }
+    const AnimationLODSettings& GetLODSettings() const { return m_LOD; }
+
+    const AnimationFrameStats& GetStats() const { return m_Stats; }
+    const PoseArena& GetPoseArena() const { return m_Arena; }
+
+    /// 设置后每帧为可见实例分配调色板切片，采样/插值任务顺带写入 (nullptr = 关闭)
+    void SetPalette(BonePaletteBuffer* palette) { m_Palette = palette; }
+
+private:
+    enum class JobKind : u8 {
+        Evaluate,        // 采样当前时刻 → BoneMatrices
+        EvaluateAhead,   // 采样下次采样时刻 → NextMatrices (降频)
+        Interpolate,     // Prev/Next 插值 → BoneMatrices
+        Hold,            // 姿势不变 (预算推迟)，只写调色板
+    };
+
+    struct PoseJob {
+        AnimatorComponent*   Animator;
+        const AnimationClip* Clip;
+        const CompressedClip* Compressed;   // 非空时优先
+        const Skeleton*      SkeletonData;
+        u32                  PoseOffset;
+        f32                  Time;          // 采样时刻 / 插值权重
+        u32                  BoneLimit;
+        u32                  Interval;      // LOD 采样间隔 (帧)
+        JobKind              Kind;
+        f32                  Priority;      // 预算排序用
+    };
+
+    void RunJob(const PoseJob& job);
+    void WritePalette(const AnimatorComponent& anim);
+
+    AnimationLODSettings m_LOD;
+    AnimationView m_View;
+    AnimationFrameStats m_Stats;
+    f32 m_NsPerBone = 100.0f;     // 实测的每骨骼采样耗时 (指数平均)，用于预算换算
+
+    PoseArena m_Arena;
+    BonePaletteBuffer* m_Palette = nullptr;
+    std::vector<PoseJob> m_Jobs;         // 本帧入选的采样
+    std::vector<PoseJob> m_Blends;       // 本帧的矩阵插值 (不计入每骨骼耗时)
+    std::vector<PoseJob> m_Candidates;
 };
 
 } // namespace Engine
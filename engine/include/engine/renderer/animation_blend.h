@@ -10,12 +10,7 @@
 namespace Engine {
 
 // ── 骨骼姿势（一帧中所有骨骼的局部变换）─────────────────────
-
-struct BonePose {
-    glm::vec3 Position = {0, 0, 0};
-    glm::quat Rotation = glm::quat(1, 0, 0, 0);
-    glm::vec3 Scale    = {1, 1, 1};
-};
+// BonePose 定义见 animation.h
 
 struct AnimPose {
     std::vector<BonePose> BonePoses;  // 索引对应骨骼索引
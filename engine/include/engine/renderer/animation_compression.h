@@ -0,0 +1,107 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+struct AnimationClip;
+struct BonePose;
+class Skeleton;
+
+// ── 压缩参数 ────────────────────────────────────────────────
+// 误差上限按骨骼局部空间度量: 平移/缩放为分量绝对差，旋转为夹角 (弧度)。
+
+struct AnimationCompressionSettings {
+    f32 SampleRate        = 30.0f;     // 均匀重采样频率 (帧/秒)
+    f32 PositionTolerance = 1e-4f;
+    f32 RotationTolerance = 1e-4f;
+    f32 ScaleTolerance    = 1e-4f;
+};
+
+struct AnimationCompressionStats {
+    u32 RawBytes        = 0;           // 原始关键帧字节数
+    u32 CompressedBytes = 0;
+    u32 KeptKeys        = 0;           // 曲线拟合后保留的关键帧 (所有轨道合计)
+    u32 SampledKeys     = 0;           // 重采样得到的关键帧 (所有轨道合计)
+    f32 MaxPositionError = 0.0f;       // 在所有采样帧上实测
+    f32 MaxRotationError = 0.0f;
+    f32 MaxScaleError    = 0.0f;
+};
+
+// ── 采样游标 (每实例) ───────────────────────────────────────
+// 记录每条轨道上一次命中的关键帧区间。时间前进时从上次位置向后推进，
+// 摊销 O(1)；时间回退 (循环回绕/跳转) 时从头开始。
+
+struct AnimationCursor {
+    std::vector<u16> Keys;
+    f32 LastFrame = 0.0f;
+
+    void Reset() { Keys.clear(); LastFrame = 0.0f; }
+};
+
+// ── 压缩剪辑 ────────────────────────────────────────────────
+// 思路同 ACL: 均匀重采样 → 恒定轨道折叠为单帧 → 按误差上限剔除可由相邻帧
+// 线性插值重建的关键帧 → 每轨道按值域归一化后量化为 16 位。
+// 每根骨骼固定 3 条轨道 (旋转/平移/缩放)，无通道的骨骼存绑定姿势常量。
+// 旋转只存 xyz (w >= 0 由单位长度重建)。
+// 采样以 4 条轨道为一组走 SIMD (SSE2/NEON) lerp/nlerp。
+
+class CompressedClip {
+public:
+    /// 从原始剪辑压缩 (需要骨架提供绑定姿势和骨骼数)
+    bool Build(const AnimationClip& clip, const Skeleton& skeleton,
+               const AnimationCompressionSettings& settings = {},
+               AnimationCompressionStats* stats = nullptr);
+
+    /// 采样 time (秒) 的局部姿势，outPose 为 GetBoneCount() 个元素
+    /// boneLimit: 只写入索引小于此值的骨骼 (LOD 减骨)，其余保持不变
+    void Sample(f32 time, AnimationCursor& cursor, BonePose* outPose,
+                u32 boneLimit = ~0u) const;
+
+    const std::string& GetName() const { return m_Name; }
+    f32 GetDuration() const { return m_Duration; }
+    u32 GetBoneCount() const { return m_BoneCount; }
+    bool IsEmpty() const { return m_BoneCount == 0; }
+
+    /// 常驻内存字节数 (关键帧 + 轨道描述)
+    u32 GetMemoryUsage() const;
+
+private:
+    enum TrackKind : u32 { TRACK_ROTATION = 0, TRACK_POSITION = 1, TRACK_SCALE = 2, TRACK_KIND_COUNT = 3 };
+
+    struct Track {
+        u32 KeyOffset = 0;     // 在 m_Frames 中的起始 (m_Values 中为 ×3)
+        u32 KeyCount  = 0;
+    };
+
+    /// 4 条轨道一组的值域 (SoA，便于整组反量化)
+    struct alignas(16) TrackGroup {
+        f32 Min[3][4];
+        f32 Step[3][4];        // extent / 65535
+    };
+
+    /// 轨道 t = kind * m_TrackStride + bone
+    u32 TrackIndex(u32 kind, u32 bone) const { return kind * m_TrackStride + bone; }
+
+    void SampleGroup(u32 kind, u32 group, f32 frame, u16* cursorKeys,
+                     f32 out[4][4]) const;
+
+    std::string m_Name;
+    f32 m_Duration   = 0.0f;
+    f32 m_SampleRate = 30.0f;        // 实际帧率 (FrameCount - 1) / Duration，不低于设置值
+    u32 m_FrameCount = 0;
+    u32 m_BoneCount  = 0;
+    u32 m_TrackStride = 0;           // 骨骼数向上取整到 4
+
+    std::vector<Track>      m_Tracks;
+    std::vector<TrackGroup> m_Groups;
+    std::vector<u16>        m_Frames;    // 关键帧所在的采样帧号
+    std::vector<u16>        m_Values;    // 每关键帧 3 个量化分量
+};
+
+} // namespace Engine
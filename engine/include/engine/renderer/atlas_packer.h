@@ -0,0 +1,96 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Engine {
+
+// ── Skyline 矩形装箱 ────────────────────────────────────────
+// 天际线记录每一段水平线的高度；新矩形放在使其顶边最低的位置，
+// 同高时选下方空隙 (被盖住、再也用不上的面积) 最小的位置。
+// 对按高度降序输入的精灵/字形，装填率通常在 85%~95%。
+
+struct AtlasRect {
+    u32 X = 0, Y = 0;
+    u32 W = 0, H = 0;
+};
+
+class SkylinePacker {
+public:
+    void Init(u32 width, u32 height);
+
+    /// 放入 w×h 的矩形，放不下返回 false
+    bool Pack(u32 w, u32 h, AtlasRect& out);
+
+    u32 GetWidth() const { return m_Width; }
+    u32 GetHeight() const { return m_Height; }
+    /// 已放入矩形的面积 / 总面积
+    f32 GetOccupancy() const;
+
+private:
+    struct Segment { u32 X, Y, W; };
+
+    /// 以第 index 段为左端放 w×h: 返回底边高度，放不下返回 false
+    bool Fit(u32 index, u32 w, u32 h, u32& y, u64& waste) const;
+
+    std::vector<Segment> m_Skyline;
+    u32 m_Width = 0;
+    u32 m_Height = 0;
+    u64 m_UsedArea = 0;
+};
+
+// ── 图集构建 (CPU) ──────────────────────────────────────────
+// 收集 RGBA8 图像，按高度降序装入若干页。每张图四周挤出 padding 像素
+// (复制边缘像素)，避免采样时串到相邻图像。不依赖 GL，加载期或 cook 期都可运行。
+
+struct AtlasEntry {
+    u32 Key = 0;             // 调用方给的标识 (TextureAtlas 用源纹理 ID)
+    u32 Page = 0;
+    AtlasRect Rect;          // 页内像素区域 (不含 padding)
+    glm::vec4 UVRect{0.0f};  // 源纹理 UV [0,1]² 在页内对应的区域 {u0, v0, u1, v1}
+};
+
+class AtlasBuilder {
+public:
+    explicit AtlasBuilder(u32 pageSize = 2048, u32 padding = 1);
+
+    /// 加入一张 RGBA8 图像 (像素被复制)。sourceHeight > height 时只打包源纹理的
+    /// 前 height 行 (如字体位图的已用部分)，UVRect 仍按完整源纹理换算
+    void Add(u32 key, const u8* rgba, u32 width, u32 height, u32 sourceHeight = 0);
+
+    /// 装箱并生成页像素。有图像大于单页时跳过它并返回 false
+    bool Pack();
+
+    void Clear();
+
+    u32 GetPageSize() const { return m_PageSize; }
+    u32 GetPageCount() const { return (u32)m_Pages.size(); }
+    const std::vector<u8>& GetPagePixels(u32 page) const { return m_Pages[page].Pixels; }
+    f32 GetPageOccupancy(u32 page) const { return m_Pages[page].Packer.GetOccupancy(); }
+
+    const std::vector<AtlasEntry>& GetEntries() const { return m_Entries; }
+    const AtlasEntry* Find(u32 key) const;
+
+private:
+    struct Pending {
+        u32 Key;
+        u32 Width, Height, SourceHeight;
+        std::vector<u8> Pixels;
+    };
+    struct Page {
+        SkylinePacker Packer;
+        std::vector<u8> Pixels;
+    };
+
+    void Blit(Page& page, const Pending& image, const AtlasRect& rect) const;
+
+    u32 m_PageSize;
+    u32 m_Padding;
+    std::vector<Pending> m_Pending;
+    std::vector<Page> m_Pages;
+    std::vector<AtlasEntry> m_Entries;
+};
+
+} // namespace Engine
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <vector>
+
+namespace Engine {
+
+// ── BC (S3TC) 块压缩格式 ────────────────────────────────────
+
+enum class BcFormat : u8 {
+    BC1,   // RGB 565 端点 + 2 bit 索引, 8 字节/块 (不透明)
+    BC3,   // BC1 颜色块 + 8 bit 插值 alpha, 16 字节/块
+};
+
+// ── BC 编码器 (离线 cook 用) ─────────────────────────────────
+//
+// 包围盒端点 + 内缩 (range fit)，质量低于 PCA/迭代拟合，
+// 但无依赖、可预测，适合构建流水线批量处理。
+// 非 4 整除尺寸按边缘 clamp 补齐到整块。
+
+class BcEncoder {
+public:
+    static u32 GetBlockBytes(BcFormat format) { return format == BcFormat::BC1 ? 8 : 16; }
+
+    /// 压缩后字节数 = ceil(w/4) * ceil(h/4) * 块大小
+    static size_t GetCompressedSize(BcFormat format, u32 width, u32 height);
+
+    /// 压缩整张图 (channels = 3 或 4)，out 需至少 GetCompressedSize 字节
+    static void EncodeImage(const u8* pixels, u32 width, u32 height, u32 channels,
+                            BcFormat format, u8* out);
+
+    /// 单块编解码, rgba = 4x4 像素 RGBA8 (行优先)
+    static void EncodeBlockBC1(const u8* rgba, u8* out);
+    static void EncodeBlockBC3(const u8* rgba, u8* out);
+    static void DecodeBlockBC1(const u8* block, u8* rgba);
+    static void DecodeBlockBC3(const u8* block, u8* rgba);
+};
+
+} // namespace Engine
@@ -3,6 +3,7 @@
 #include "engine/core/types.h"
 #include <string>
 #include <array>
+#include <vector>
 
 namespace Engine {
 
@@ -36,6 +37,14 @@ public:
     /// 计算文本宽度
     f32 MeasureText(const std::string& text, f32 scale = 1.0f) const;
 
+    // ── 字形位图 (供 TextureAtlas 打包) ─────────────────────
+
+    /// 单通道字形位图 (GetBitmapSize()² 字节，行 0 对应 V = 0)
+    const std::vector<u8>& GetBitmap() const { return m_Bitmap; }
+    u32 GetBitmapSize() const { return ATLAS_SIZE; }
+    /// 位图中实际用到的行数 (之后全空)
+    u32 GetBitmapUsedRows() const { return m_BitmapUsedRows; }
+
 private:
     static constexpr u32 ATLAS_SIZE = 512;
     static constexpr u32 FIRST_CHAR = 32;
@@ -43,6 +52,8 @@ private:
 
     u32  m_TextureID = 0;
     f32  m_LineHeight = 0;
+    u32  m_BitmapUsedRows = 0;
+    std::vector<u8> m_Bitmap;
     bool m_Valid = false;
     std::array<GlyphInfo, CHAR_COUNT> m_Glyphs{};
 };
@@ -23,6 +23,21 @@ struct GltfSkinVertex {
     glm::vec4  Weights  = {0, 0, 0, 0};   // 对应权重
 };
 
+/// 转成 GPU 蒙皮顶点 (Mesh 蒙皮构造函数 / SkinnedInstanceRenderer 使用)
+inline SkinningUtils::SkinVertex ToSkinVertex(const GltfSkinVertex& v) {
+    SkinningUtils::SkinVertex out;
+    out.Position  = v.Position;
+    out.Normal    = v.Normal;
+    out.UV        = v.TexCoord;
+    out.Tangent   = v.Tangent;
+    out.Bitangent = v.Bitangent;
+    for (int i = 0; i < 4; i++) {
+        out.BoneIDs[i] = v.BoneIDs[i];
+        out.Weights[i] = v.Weights[i];
+    }
+    return out;
+}
+
 // ── glTF PBR 材质信息 ───────────────────────────────────────
 
 struct GltfMaterial {
@@ -41,15 +56,18 @@ struct GltfMaterial {
 // ── glTF 网格 + 材质 ───────────────────────────────────────
 
 struct GltfMesh {
+    /// 蒙皮网格由 SkinVertices 构建 (带 aBoneIDs/aWeights，可直接交给 SkinnedInstanceRenderer)
     Scope<Mesh> MeshData;
+    // CPU 顶点/索引 (仅 createGpuMesh = false 时填充，MeshData 为空)
+    std::vector<MeshVertex> Vertices;
+    std::vector<u32> Indices;
     GltfMaterial Material;
     std::string Name;
 
     // 蒙皮数据 (可选)
     bool HasSkin = false;
     std::vector<GltfSkinVertex> SkinVertices;
-    Ref<Skeleton> SkeletonRef;
-    std::vector<AnimationClip> Clips;
+    AnimationSetRef Animations;   // 同一文件的蒙皮网格共享
 };
 
 // ── glTF 加载器 ────────────────────────────────────────────
@@ -57,7 +75,8 @@ struct GltfMesh {
 class GltfLoader {
 public:
     /// 从 .gltf / .glb 文件加载所有网格
-    static std::vector<GltfMesh> Load(const std::string& filepath);
+    /// createGpuMesh = false 时只输出 CPU 数据，不创建 GL 对象 (离线 cook / 工作线程)
+    static std::vector<GltfMesh> Load(const std::string& filepath, bool createGpuMesh = true);
 };
 
 } // namespace Engine
@@ -2,6 +2,7 @@
 
 #include "engine/core/types.h"
 #include "engine/renderer/buffer.h"
+#include "engine/renderer/skinning_utils.h"
 
 #include <glm/glm.hpp>
 #include <string>
@@ -19,16 +20,45 @@ struct MeshVertex {
     glm::vec3 Bitangent = {0, 0, 1};
 };
 
+// ── 压缩顶点 (20 字节) ──────────────────────────────────────
+// 由 MeshOptimizer::Quantize 在导入期生成，顶点读取带宽约为 MeshVertex 的 1/3:
+//   Position  half × 3 (+1 填充)       绝对值超过 2048 的坐标精度降到 1 单位以上
+//   Normal    snorm 10:10:10:2
+//   Tangent   snorm 10:10:10:2，w = 副切线符号 (B = cross(N, T) * w)
+//   TexCoord  half × 2
+// 各分量都能由顶点装配阶段直接解码，着色器输入仍为 vec3/vec4。
+
+struct PackedMeshVertex {
+    u16 Position[4];
+    u32 Normal;
+    u32 Tangent;
+    u16 TexCoord[2];
+};
+static_assert(sizeof(PackedMeshVertex) == 20, "PackedMeshVertex 布局与 GPU 属性绑定一致");
+
 // ── 网格 ────────────────────────────────────────────────────
 
 class Mesh {
 public:
     /// 从顶点/索引数据构建
     Mesh(const std::vector<MeshVertex>& vertices, const std::vector<u32>& indices);
+    /// 从连续内存构建 (如资源包 mmap 区域，数据直接上传不做中间拷贝)
+    Mesh(const MeshVertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount);
+    /// 从压缩顶点构建 (无独立副切线属性，着色器须由 aTangent.w 重建；
+    /// 仅内置 GL 着色器如此，见 ResourceManager::SetPackedVertexInput)
+    Mesh(const PackedMeshVertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount);
+    /// 从蒙皮顶点构建 (SetupSkinVertexVAO，额外带 aBoneIDs/aWeights 于 location 5/6)。
+    /// 非蒙皮着色器忽略多出的属性，也可直接 Draw
+    Mesh(const SkinningUtils::SkinVertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount);
     
     /// 从 OBJ 文件加载
     static Scope<Mesh> LoadOBJ(const std::string& filepath);
 
+    /// 仅解析 OBJ 到 CPU 数据 (不触碰 GL，可在工作线程 / 离线工具中调用)
+    static bool ParseOBJ(const std::string& filepath,
+                         std::vector<MeshVertex>& outVertices,
+                         std::vector<u32>& outIndices);
+
     /// 预置几何体
     static Scope<Mesh> CreateCube();
     static Scope<Mesh> CreatePlane(f32 size = 10.0f, f32 uvScale = 5.0f);
@@ -45,19 +75,22 @@ public:
 
     void Draw() const;
 
-    u32 GetVertexCount() const { return (u32)m_Vertices.size(); }
+    u32 GetVertexCount() const { return m_VertexCount; }
     u32 GetIndexCount() const { return m_IndexCount; }
     u32 GetVAO() const { return m_VAO; }
+    /// VAO 是否带骨骼索引/权重属性 (SkinnedInstanceRenderer 要求)
+    bool HasSkinAttributes() const { return m_HasSkin; }
 
 private:
     void SetupBuffers();
 
-    std::vector<MeshVertex> m_Vertices;
+    u32 m_VertexCount = 0;
     u32 m_IndexCount = 0;
 
     u32 m_VAO = 0;
     u32 m_VBO = 0;
     u32 m_IBO = 0;
+    bool m_HasSkin = false;
 };
 
 } // namespace Engine
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/renderer/mesh.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Engine {
+
+// ── 顶点缓存统计 ────────────────────────────────────────────
+// 以 FIFO 后变换缓存模拟 GPU 顶点复用:
+//   ACMR = 变换次数 / 三角形数  (理想下限约 0.5，乱序网格可达 3)
+//   ATVR = 变换次数 / 被引用顶点数 (理想为 1)
+
+struct VertexCacheStats {
+    u32 Transformed = 0;    // 缓存未命中次数 (顶点着色器调用数)
+    f32 ACMR = 0.0f;
+    f32 ATVR = 0.0f;
+};
+
+// ── 网格簇 (Meshlet) ────────────────────────────────────────
+// 三角形按局部性分组，每簇顶点/三角形数有上限，附带包围球与法线锥，
+// 可在 CPU 或 GPU 上以簇为单位做视锥/背面剔除。
+
+struct Meshlet {
+    u32 VertexOffset = 0;     // 在 MeshletData::Vertices 中的起始
+    u32 TriangleOffset = 0;   // 在 MeshletData::Triangles 中的起始 (字节，每三角形 3 个)
+    u32 VertexCount = 0;
+    u32 TriangleCount = 0;
+
+    glm::vec3 Center{0.0f};   // 包围球
+    f32 Radius = 0.0f;
+    glm::vec3 ConeAxis{0.0f, 0.0f, 1.0f};   // 法线锥 (面法线平均方向)
+    f32 ConeCutoff = 1.0f;    // sin(锥半角)，>= 1 表示法线发散、不可剔除
+
+    /// 从 cameraPos 看过去整簇背面朝向 (可安全剔除)
+    bool IsBackfacing(const glm::vec3& cameraPos) const {
+        glm::vec3 d = Center - cameraPos;
+        return glm::dot(d, ConeAxis) >= ConeCutoff * glm::length(d) + Radius;
+    }
+};
+
+struct MeshletData {
+    std::vector<Meshlet> Meshlets;
+    std::vector<u32> Vertices;   // 簇内局部顶点 → 网格顶点索引
+    std::vector<u8>  Triangles;  // 簇内三角形 (局部顶点索引)
+};
+
+// ── 网格优化 (导入期, 纯 CPU) ───────────────────────────────
+//
+// 推荐顺序 (Optimize 即按此执行):
+//   1. OptimizeVertexCache — Tipsify 重排三角形，提高后变换缓存命中
+//   2. OptimizeOverdraw    — 在缓存友好的簇之间按朝外程度排序，减少过度绘制
+//   3. OptimizeVertexFetch — 按首次使用顺序重排顶点，提高顶点读取局部性
+// 三步都只改变顺序，不改变几何。
+
+class MeshOptimizer {
+public:
+    static constexpr u32 DEFAULT_CACHE_SIZE = 16;
+    static constexpr u32 MAX_MESHLET_VERTICES = 64;
+    static constexpr u32 MAX_MESHLET_TRIANGLES = 124;
+
+    /// Tipsify 三角形重排 (原地)
+    /// clusters 非空时输出簇边界 (三角形序号，首元素为 0)，供 OptimizeOverdraw 使用
+    static void OptimizeVertexCache(u32* indices, u32 indexCount, u32 vertexCount,
+                                    u32 cacheSize = DEFAULT_CACHE_SIZE,
+                                    std::vector<u32>* clusters = nullptr);
+
+    /// 按簇重排以减少过度绘制 (原地)
+    /// threshold: 允许 ACMR 相对 Tipsify 结果变差的比例 (1.05 = 5%)，越大簇越细、排序越自由
+    static void OptimizeOverdraw(u32* indices, u32 indexCount,
+                                 const MeshVertex* vertices, u32 vertexCount,
+                                 const std::vector<u32>& clusters,
+                                 f32 threshold = 1.05f,
+                                 u32 cacheSize = DEFAULT_CACHE_SIZE);
+
+    /// 顶点按首次引用顺序重排，丢弃未引用顶点，返回新顶点数
+    static u32 OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<u32>& indices);
+
+    /// 完整流程: 缓存 → 过度绘制 → 顶点读取
+    static void Optimize(std::vector<MeshVertex>& vertices, std::vector<u32>& indices,
+                         f32 overdrawThreshold = 1.05f);
+
+    /// FIFO 缓存模拟
+    static VertexCacheStats AnalyzeVertexCache(const u32* indices, u32 indexCount, u32 vertexCount,
+                                               u32 cacheSize = DEFAULT_CACHE_SIZE);
+
+    /// 压缩顶点 (见 PackedMeshVertex)
+    static void Quantize(const MeshVertex* vertices, u32 vertexCount,
+                         std::vector<PackedMeshVertex>& out);
+    /// 解压回 MeshVertex，副切线按 cross(N, T) * w 重建 (供不支持压缩输入的着色器/后端)
+    static void Dequantize(const PackedMeshVertex* vertices, u32 vertexCount,
+                           std::vector<MeshVertex>& out);
+
+    /// 贪心划分 meshlet (按当前三角形顺序，建议在 OptimizeVertexCache 之后调用)
+    static void BuildMeshlets(const MeshVertex* vertices, u32 vertexCount,
+                              const u32* indices, u32 indexCount, MeshletData& out,
+                              u32 maxVertices = MAX_MESHLET_VERTICES,
+                              u32 maxTriangles = MAX_MESHLET_TRIANGLES);
+};
+
+} // namespace Engine
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "engine/core/types.h"
+
+#include <vector>
+
+namespace Engine {
+
+// ── Mip 下采样滤波器 ────────────────────────────────────────
+
+enum class MipFilter : u8 {
+    Box,     // 2x2 平均 (最快, 略模糊)
+    Kaiser,  // Kaiser 窗 sinc (更锐利, 适合细节多的贴图)
+};
+
+// ── 单个 Mip 层描述 ─────────────────────────────────────────
+
+struct MipLevel {
+    u32 Width  = 0;
+    u32 Height = 0;
+    size_t Offset = 0;   // 在 MipChain::Pixels 中的字节偏移
+    size_t Size   = 0;   // 字节数 = Width * Height * Channels
+};
+
+// ── Mip 链 (CPU 端) ─────────────────────────────────────────
+// 所有层级紧密排列在一块连续内存中，Level 0 = 原图。
+// 纯 CPU 数据，可在工作线程构建，主线程按层上传 GPU。
+
+struct MipChain {
+    u32 Width    = 0;
+    u32 Height   = 0;
+    u32 Channels = 0;
+    std::vector<MipLevel> Levels;
+    std::vector<u8>       Pixels;
+
+    const u8* GetLevelData(u32 level) const { return Pixels.data() + Levels[level].Offset; }
+    u32 GetLevelCount() const { return (u32)Levels.size(); }
+    size_t GetTotalSize() const { return Pixels.size(); }
+
+    /// 完整 mip 链层数: floor(log2(max(w, h))) + 1
+    static u32 CountLevels(u32 width, u32 height);
+
+    /// 从 8 位像素构建完整 mip 链 (拷贝 level 0 并逐级下采样)
+    /// 非 2 的幂尺寸按面积比例重采样，边缘 clamp。
+    static bool Build(const u8* pixels, u32 width, u32 height, u32 channels,
+                      MipFilter filter, MipChain& out);
+};
+
+} // namespace Engine
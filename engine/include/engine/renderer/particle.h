@@ -2,85 +2,68 @@
 
 #include "engine/core/types.h"
 #include "engine/renderer/shader.h"
+#include "engine/renderer/particle_emitter.h"
 
 #include <glm/glm.hpp>
 #include <vector>
 
 namespace Engine {
 
-// ── 粒子 ────────────────────────────────────────────────────
-
-struct Particle {
-    glm::vec3 Position = {0, 0, 0};
-    glm::vec3 Velocity = {0, 0, 0};
-    glm::vec3 Color    = {1, 1, 1};
-    glm::vec3 ColorStart = {1, 0.8f, 0.3f};
-    glm::vec3 ColorEnd   = {1, 0.1f, 0.0f};
-    f32 Size     = 0.1f;
-    f32 Life     = 1.0f;
-    f32 MaxLife  = 1.0f;
-    f32 Gravity  = -2.0f;
-
-    bool IsAlive() const { return Life > 0.0f; }
-};
-
-// ── 粒子发射器配置 ──────────────────────────────────────────
-
-struct ParticleEmitterConfig {
-    glm::vec3 Position = {0, 0, 0};
-    glm::vec3 Direction = {0, 1, 0};     // 发射方向
-    f32 SpreadAngle  = 30.0f;            // 扩散角度(度)
-    f32 MinSpeed     = 1.0f;
-    f32 MaxSpeed     = 3.0f;
-    f32 MinLife      = 0.5f;
-    f32 MaxLife      = 2.0f;
-    f32 MinSize      = 0.05f;
-    f32 MaxSize      = 0.15f;
-    glm::vec3 ColorStart = {1, 0.8f, 0.3f};
-    glm::vec3 ColorEnd   = {1, 0.1f, 0.0f};
-    f32 Gravity      = -2.0f;            // 重力
-    u32 EmitRate     = 50;               // 每秒粒子数
-    u32 MaxParticles = 500;
-};
-
 // ── 粒子系统 ────────────────────────────────────────────────
+// 管理任意数量的独立发射器 (各自 SoA 存储与预算)，Update 在 JobSystem 上并行模拟，
+// Draw 剔除视锥外/过远的发射器，把其余存活粒子汇总为最多两次实例化绘制
+// (叠加混合一次，alpha 混合从后往前排序后一次)。
+// 发射率距离 LOD 使用上一次 Draw 的相机位置 (滞后一帧)。
+
+using ParticleEmitterHandle = u32;
+constexpr ParticleEmitterHandle INVALID_PARTICLE_EMITTER = 0;
 
 class ParticleSystem {
 public:
     static void Init();
     static void Shutdown();
 
-    /// 发射粒子
+    /// 创建发射器 (默认按 EmitRate 持续发射)，返回句柄
+    static ParticleEmitterHandle CreateEmitter(const ParticleEmitterConfig& config);
+    static void DestroyEmitter(ParticleEmitterHandle handle);
+    /// 句柄无效时返回 nullptr；指针在 DestroyEmitter 之前有效
+    static ParticleEmitter* GetEmitter(ParticleEmitterHandle handle);
+    static u32 GetEmitterCount();
+
+    /// 按配置在 config.Position 发射 dt 时间内的粒子 (旧接口)
+    /// 外观相同的配置共用一个不自动发射的内部发射器
     static void Emit(const ParticleEmitterConfig& config, f32 dt);
 
-    /// 更新所有粒子
+    /// 更新所有发射器
     static void Update(f32 dt);
 
-    /// 渲染所有存活粒子（叠加混合，面向摄像机）
-    static void Draw(const f32* viewProjectionMatrix, const glm::vec3& cameraRight,
-                     const glm::vec3& cameraUp);
+    /// 渲染可见发射器的存活粒子（面向摄像机）
+    static void Draw(const f32* viewProjectionMatrix, const glm::vec3& cameraPosition,
+                     const glm::vec3& cameraRight, const glm::vec3& cameraUp);
+
+    static void SetLODSettings(const ParticleLODSettings& settings) { s_LOD = settings; }
+    static const ParticleLODSettings& GetLODSettings() { return s_LOD; }
 
     /// 统计
     static u32 GetAliveCount();
+    /// 上一次 Draw 的剔除/排序/上传统计
+    static const ParticleDrawStats& GetDrawStats() { return s_DrawList.GetStats(); }
 
 private:
-    static void RespawnParticle(Particle& p, const ParticleEmitterConfig& cfg);
-
-    static std::vector<Particle> s_Pool;
+    static std::vector<Scope<ParticleEmitter>> s_Emitters;     // 句柄 = 下标 + 1，销毁后留空位复用
+    static std::vector<ParticleEmitter*> s_Active;              // 本帧参与更新的发射器
+    static std::vector<ParticleEmitterHandle> s_ImmediateEmitters;   // Emit() 使用的内部发射器
+    static u32 s_NextSeed;
+    static ParticleLODSettings s_LOD;
+    static ParticleDrawList s_DrawList;
+    static glm::vec3 s_CameraPosition;
+    static bool s_HasCamera;
     static u32 s_AliveCount;
     static u32 s_QuadVAO;
     static u32 s_QuadVBO;
     static u32 s_InstanceVBO;
+    static u32 s_InstanceCapacity;
     static Ref<Shader> s_Shader;
-
-    // GPU 实例数据结构
-    struct InstanceData {
-        glm::vec3 Position;
-        float Size;
-        glm::vec3 Color;
-        float Alpha;
-    };
-    static std::vector<InstanceData> s_InstanceBuffer;
 };
 
 } // namespace Engine
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/core/radix_sort.h"
+#include "engine/physics/collision.h"
+
+#include <glm/glm.hpp>
+
+#include <random>
+#include <vector>
+
+namespace Engine {
+
+// ── 粒子发射器配置 ──────────────────────────────────────────
+
+struct ParticleEmitterConfig {
+    glm::vec3 Position = {0, 0, 0};
+    glm::vec3 Direction = {0, 1, 0};     // 发射方向
+    f32 SpreadAngle  = 30.0f;            // 扩散角度(度)
+    f32 MinSpeed     = 1.0f;
+    f32 MaxSpeed     = 3.0f;
+    f32 MinLife      = 0.5f;
+    f32 MaxLife      = 2.0f;
+    f32 MinSize      = 0.05f;
+    f32 MaxSize      = 0.15f;
+    glm::vec3 ColorStart = {1, 0.8f, 0.3f};
+    glm::vec3 ColorEnd   = {1, 0.1f, 0.0f};
+    f32 SizeStart    = 1.0f;             // 尺寸曲线: 发射尺寸 × lerp(SizeStart, SizeEnd, 寿命进度)
+    f32 SizeEnd      = 1.0f;
+    f32 AlphaStart   = 1.0f;             // 透明度曲线 (默认随寿命线性淡出)
+    f32 AlphaEnd     = 0.0f;
+    f32 Gravity      = -2.0f;            // 重力
+    f32 Drag         = 0.0f;             // 线性阻尼 (1/秒)
+    u32 EmitRate     = 50;               // 每秒粒子数
+    u32 MaxParticles = 500;              // 本发射器的粒子预算
+    bool AlphaBlend  = false;            // false = 叠加混合 (与顺序无关)，true = alpha 混合 (需从后往前排序)
+};
+
+/// 渲染用的单个粒子实例 (与粒子着色器的实例属性布局一致)
+struct ParticleInstance {
+    glm::vec3 Position;
+    f32 Size;
+    glm::vec3 Color;
+    f32 Alpha;
+};
+
+// ── 粒子发射器 (SoA) ────────────────────────────────────────
+// 每个属性一条连续的 float 流，存活粒子始终紧凑地位于 [0, 存活数)，
+// 死亡粒子用末尾粒子填补 (交换压缩)。每条流的容量向上取整到 4，
+// 更新内核以 4 个粒子为一组走 SIMD (SSE2/NEON)，寿命进度驱动颜色/尺寸/透明度曲线。
+// 颜色曲线端点存在发射器上，粒子只存寿命与发射尺寸。
+//
+// 线程: Simulate 的不同区间可并行；Emit/Compact/SetConfig 只能单线程调用。
+// 不依赖 GL，多发射器的并行更新见 UpdateAll。
+
+class ParticleEmitter {
+public:
+    enum Stream : u32 {
+        POS_X, POS_Y, POS_Z,
+        VEL_X, VEL_Y, VEL_Z,
+        LIFE, INV_MAX_LIFE, BASE_SIZE,
+        COLOR_R, COLOR_G, COLOR_B, ALPHA, SIZE,
+        STREAM_COUNT
+    };
+
+    /// Simulate 的区间粒度 (并行更新时每个任务至少这么多粒子)
+    static constexpr u32 SIMULATE_CHUNK = 16384;
+
+    explicit ParticleEmitter(const ParticleEmitterConfig& config = {}, u32 seed = 1);
+
+    // 流指针指向自身存储: 可移动 (vector 缓冲区随之转移)，不可拷贝
+    ParticleEmitter(ParticleEmitter&&) = default;
+    ParticleEmitter& operator=(ParticleEmitter&&) = default;
+    ParticleEmitter(const ParticleEmitter&) = delete;
+    ParticleEmitter& operator=(const ParticleEmitter&) = delete;
+
+    /// 更换配置；预算变化时重新分配，超出新预算的粒子被丢弃
+    void SetConfig(const ParticleEmitterConfig& config);
+    const ParticleEmitterConfig& GetConfig() const { return m_Config; }
+    void SetPosition(const glm::vec3& position) { m_Config.Position = position; }
+
+    /// 为 true 时 UpdateAll 按 EmitRate 持续发射
+    bool Emitting = true;
+
+    /// EmitOverTime 的发射率倍数 (距离 LOD，由 ParticleSystem 每帧设置)
+    f32 EmitRateScale = 1.0f;
+
+    /// 立即发射 count 个粒子，受预算限制，返回实际发射数
+    u32 Emit(u32 count);
+
+    /// 按 EmitRate 发射 dt 时间内应产生的粒子 (小数部分跨帧累积)
+    u32 EmitOverTime(f32 dt);
+
+    /// 推进 [begin, end) 内的粒子；begin 须为 4 的倍数
+    void Simulate(f32 dt, u32 begin, u32 end);
+
+    /// 移除寿命耗尽的粒子 (交换压缩)
+    void Compact();
+
+    /// 重新计算存活粒子的包围盒 (含最大粒子尺寸)，UpdateAll/Update 在压缩后调用
+    void ComputeBounds();
+    /// 上一次 ComputeBounds 的结果；无存活粒子时为空盒 (Min > Max)
+    const AABB& GetBounds() const { return m_Bounds; }
+
+    /// 单线程便捷接口: 按需发射 + Simulate + Compact + ComputeBounds
+    void Update(f32 dt);
+
+    void Clear() { m_Alive = 0; m_EmitAccumulator = 0.0f; }
+
+    /// 把 [begin, end) 内的粒子写为渲染实例
+    void WriteInstances(u32 begin, u32 end, ParticleInstance* out) const;
+
+    u32 GetAliveCount() const { return m_Alive; }
+    u32 GetCapacity() const { return m_Config.MaxParticles; }
+    const f32* GetStream(Stream stream) const { return m_Streams[stream]; }
+
+    /// 并行更新多个发射器: 串行发射后，所有发射器的存活区间按 SIMULATE_CHUNK
+    /// 切块一起分发到 JobSystem，最后各发射器并行压缩并更新包围盒
+    static void UpdateAll(ParticleEmitter* const* emitters, u32 count, f32 dt);
+
+private:
+    void Allocate(u32 capacity);
+    void MoveParticle(u32 from, u32 to);
+    f32 Random(f32 lo, f32 hi);
+
+    ParticleEmitterConfig m_Config;
+    std::vector<f32> m_Storage;            // 所有流连续存放
+    f32* m_Streams[STREAM_COUNT] = {};
+    u32 m_Stride = 0;                      // 每条流的容量 (预算向上取整到 4)
+    u32 m_Alive = 0;
+    f32 m_EmitAccumulator = 0.0f;
+    AABB m_Bounds = {glm::vec3(1e30f), glm::vec3(-1e30f)};
+    std::mt19937 m_Rng;
+    u32 m_FirstChunk = 0;                  // UpdateAll 中本发射器第一个块的全局序号
+};
+
+// ── 粒子剔除 / LOD / 排序 ───────────────────────────────────
+// 发射器按包围盒做视锥剔除，超出 CullDistance 的既不绘制也不发射；
+// FullRateDistance 到 CullDistance 之间发射率从 1 线性降到 MinRateScale。
+// alpha 混合发射器的粒子汇总后按量化深度 (16 位) 从后往前基数排序，
+// 叠加混合的粒子与顺序无关，保持发射器内顺序。
+
+struct ParticleLODSettings {
+    f32 FullRateDistance = 25.0f;    // 此距离内全速发射
+    f32 CullDistance     = 150.0f;   // 此距离外不发射、不绘制 (0 = 不限)
+    f32 MinRateScale     = 0.2f;     // CullDistance 处的发射率倍数
+    bool SortAlphaBlended = true;    // alpha 混合粒子从后往前排序
+
+    /// 到相机距离为 distance 的发射器的发射率倍数
+    f32 EmitRateScale(f32 distance) const;
+};
+
+struct ParticleDrawStats {
+    u32 VisibleEmitters = 0;
+    u32 CulledEmitters  = 0;   // 视锥外或超出 CullDistance
+    u32 DrawnParticles  = 0;
+    u32 SortedParticles = 0;
+    u32 UploadBytes     = 0;   // 本帧实例数据上传量
+    u32 DrawCalls       = 0;
+};
+
+/// 每帧的粒子绘制列表 (不依赖 GL): [0, AdditiveCount) 为叠加混合实例，
+/// 其后为 alpha 混合实例 (已排序时从远到近)
+class ParticleDrawList {
+public:
+    /// viewProjection 的第 4 行 (裁剪空间 w) 作为透视投影下的视深
+    void Build(ParticleEmitter* const* emitters, u32 count, const glm::mat4& viewProjection,
+               const glm::vec3& cameraPosition, const ParticleLODSettings& settings);
+
+    const std::vector<ParticleInstance>& GetInstances() const { return m_Instances; }
+    u32 GetAdditiveCount() const { return m_AdditiveCount; }
+    const ParticleDrawStats& GetStats() const { return m_Stats; }
+
+private:
+    struct WriteTask {
+        const ParticleEmitter* Emitter;
+        u32 Begin, End, Offset;
+    };
+
+    void SortBackToFront(const glm::mat4& viewProjection);
+
+    // 每帧复用的中间数组
+    std::vector<const ParticleEmitter*> m_Additive, m_Blended;
+    std::vector<WriteTask> m_WriteTasks;
+
+    std::vector<ParticleInstance> m_Instances;
+    std::vector<ParticleInstance> m_Scratch;
+    std::vector<u32> m_SortKeys;
+    std::vector<u32> m_SortIndices;
+    RadixSorter m_Sorter;
+    u32 m_AdditiveCount = 0;
+    ParticleDrawStats m_Stats;
+};
+
+} // namespace Engine
@@ -5,6 +5,7 @@
 #include "engine/renderer/camera.h"
 #include "engine/renderer/shader.h"
 #include "engine/renderer/framebuffer.h"
+#include "engine/renderer/frustum.h"
 
 namespace Engine {
 
@@ -35,6 +36,15 @@ struct SceneFrameStats {
     f32 FrameTimeMs   = 0.0f;
 };
 
+/// 上一次渲染的相机剔除信息，供动画 LOD 等系统复用 (滞后一帧):
+///   anim.SetView({cull.CameraPosition, cull.ProjectionScale, &cull.ViewFrustum});
+struct SceneCullResults {
+    Frustum   ViewFrustum;
+    glm::vec3 CameraPosition{0.0f};
+    f32       ProjectionScale = 0.0f;   // 视口高度 / (2·tan(fov/2))，半径 r、距离 d 的球约占 2r·scale/d 像素
+    u32       FrameIndex = 0;           // 每次渲染递增，0 表示尚未渲染
+};
+
 class SceneRenderer {
 public:
     static void Init(const SceneRendererConfig& config);
@@ -63,6 +73,9 @@ public:
     /// 获取帧统计信息
     static const SceneFrameStats& GetFrameStats();
 
+    /// 获取上一次渲染的剔除信息
+    static const SceneCullResults& GetCullResults();
+
 private:
     // 各 Pass 函数
     static void ShadowPass(Scene& scene, PerspectiveCamera& camera);
@@ -92,6 +105,7 @@ private:
     static bool s_BloomEnabled;
     static int  s_GBufDebugMode;
     static SceneFrameStats s_FrameStats;
+    static SceneCullResults s_CullResults;
 };
 
 } // namespace Engine
@@ -12,7 +12,7 @@ inline const char* LitVertex = R"(
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
-layout(location = 3) in vec3 aTangent;
+layout(location = 3) in vec4 aTangent;   // w = 副切线符号 (完整顶点格式下恒为 1)
 layout(location = 4) in vec3 aBitangent;
 
 out vec3 vFragPos;
@@ -33,9 +33,11 @@ void main() {
     vTexCoord = aTexCoord;
     vFragPosLightSpace = uLightSpaceMat * wp;
 
-    vec3 T = normalize(uNormalMat * aTangent);
-    vec3 B = normalize(uNormalMat * aBitangent);
+    vec3 T = normalize(uNormalMat * aTangent.xyz);
     vec3 N = normalize(vNormal);
+    // 压缩顶点不带副切线 (读到 0)，由 N、T 和符号重建
+    vec3 B = dot(aBitangent, aBitangent) > 0.0 ? normalize(uNormalMat * aBitangent)
+                                               : cross(N, T) * aTangent.w;
     vTBN = mat3(T, B, N);
 
     gl_Position = uVP * wp;
@@ -206,7 +208,7 @@ inline const char* GBufferInstancedVertex = R"(
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
-layout(location = 3) in vec3 aTangent;
+layout(location = 3) in vec4 aTangent;   // w = 副切线符号 (完整顶点格式下恒为 1)
 layout(location = 4) in vec3 aBitangent;
 
 // 实例属性 (per-instance)
@@ -237,8 +239,10 @@ void main() {
     vNormal  = normalize(normalMat * aNormal);
     vTexCoord = aTexCoord;
 
-    vec3 T = normalize(normalMat * aTangent);
-    vec3 B = normalize(normalMat * aBitangent);
+    vec3 T = normalize(normalMat * aTangent.xyz);
+    // 压缩顶点不带副切线 (读到 0)，由 N、T 和符号重建
+    vec3 B = dot(aBitangent, aBitangent) > 0.0 ? normalize(normalMat * aBitangent)
+                                               : cross(vNormal, T) * aTangent.w;
     vTBN = mat3(T, B, vNormal);
 
     // 传递实例材质参数
@@ -300,7 +304,7 @@ inline const char* GBufferVertex = R"(
 layout(location = 0) in vec3 aPos;
 layout(location = 1) in vec3 aNormal;
 layout(location = 2) in vec2 aTexCoord;
-layout(location = 3) in vec3 aTangent;
+layout(location = 3) in vec4 aTangent;   // w = 副切线符号 (完整顶点格式下恒为 1)
 layout(location = 4) in vec3 aBitangent;
 
 out vec3 vFragPos;
@@ -318,9 +322,11 @@ void main() {
     vNormal  = normalize(uNormalMat * aNormal);
     vTexCoord = aTexCoord;
 
-    vec3 T = normalize(uNormalMat * aTangent);
-    vec3 B = normalize(uNormalMat * aBitangent);
+    vec3 T = normalize(uNormalMat * aTangent.xyz);
     vec3 N = vNormal;
+    // 压缩顶点不带副切线 (读到 0)，由 N、T 和符号重建
+    vec3 B = dot(aBitangent, aBitangent) > 0.0 ? normalize(uNormalMat * aBitangent)
+                                               : cross(N, T) * aTangent.w;
     vTBN = mat3(T, B, N);
 
     gl_Position = uVP * wp;
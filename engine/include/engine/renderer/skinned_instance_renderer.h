@@ -0,0 +1,94 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/renderer/animation.h"
+#include "engine/renderer/mesh.h"
+#include "engine/renderer/shader.h"
+
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace Engine {
+
+// ── 蒙皮实例化渲染 ──────────────────────────────────────────
+//
+// 所有可见角色的骨骼调色板每帧写进同一块缓冲 (BonePaletteBuffer)，
+// 通过 PBO 上传环拷到一张 RGBA32F 调色板纹理 (每骨骼 3 texel，即 3×4 行)。
+// 每个实例只带 Model 矩阵和调色板偏移，同网格的蒙皮角色一次实例化绘制。
+//
+// 上传环为 RingSize 个 PBO 轮转 + fence: 写入本帧分段时 GPU 仍可读前几帧的分段。
+// 动画任务直接写映射内存，省去一次 CPU 拷贝。
+//
+// 每帧用法:
+//   1. SkinnedInstanceRenderer::BeginFrame()         — 动画更新之前 (映射本帧分段)
+//   2. AnimationSystem::Update()                     — SetPalette(&GetPalette()) 之后顺带写调色板
+//   3. SkinnedInstanceRenderer::UploadPalette()      — 绘制之前 (解除映射并拷到纹理)
+//   4. Begin(mesh, shader) → Submit(model, anim.PaletteOffset)... → End()
+//      mesh 须带骨骼属性 (Mesh 蒙皮构造函数 / SetupSkinVertexVAO，
+//      glTF 蒙皮网格的 GltfMesh::MeshData 即是)，否则 Begin 报错并跳过本批
+//
+// 着色器见 assets/shaders/skinning_instanced.glsl:
+//   Model 矩阵 location 8~11，调色板偏移 location 12 (uint)
+
+struct SkinnedInstanceConfig {
+    u32 MaxPaletteBones = 65536;   // 每帧调色板容量 (骨骼数)，约 3 MB/分段
+    u32 MaxInstances    = 4096;    // 单次 End() 的实例上限，超出自动分批
+    u32 RingSize        = 3;       // 上传环分段数
+};
+
+struct SkinnedInstanceData {
+    glm::mat4 Model;
+    u32 PaletteOffset;
+    u32 Padding[3];
+};
+
+class SkinnedInstanceRenderer {
+public:
+    static constexpr u32 PALETTE_TEXTURE_WIDTH = 1024;   // texel
+    static constexpr u32 PALETTE_TEXTURE_UNIT  = 8;
+    static constexpr u32 INSTANCE_ATTRIB_START = 8;
+
+    static void Init(const SkinnedInstanceConfig& config = {});
+    static void Shutdown();
+    static bool IsActive() { return s_Initialized; }
+
+    /// 等待并映射本帧的上传环分段，调色板改为写入映射内存
+    static void BeginFrame();
+
+    /// 解除映射，把本帧已用部分从 PBO 拷贝到调色板纹理 (GPU 端异步完成)
+    static void UploadPalette();
+
+    /// AnimationSystem::SetPalette 的目标
+    static BonePaletteBuffer& GetPalette() { return s_Palette; }
+
+    /// mesh 须满足 HasSkinAttributes()
+    static void Begin(Mesh* mesh, Shader* shader);
+    static void Submit(const glm::mat4& model, u32 paletteOffset);
+    static void End();
+
+    static u32 GetDrawCallCount()    { return s_DrawCalls; }
+    static u32 GetInstanceCount()    { return s_TotalInstances; }
+    static u32 GetPaletteBoneCount() { return s_UploadedBones; }   // 上一次上传的骨骼数
+    static void ResetStats();
+
+private:
+    static SkinnedInstanceConfig s_Config;
+    static bool s_Initialized;
+
+    static BonePaletteBuffer s_Palette;
+    static u32 s_PaletteTexture;
+    static std::vector<u32>   s_RingBuffers;   // PBO
+    static std::vector<void*> s_RingFences;    // GLsync
+    static u32 s_RingIndex;
+    static bool s_Mapped;
+    static u32 s_UploadedBones;
+
+    static u32 s_InstanceVBO;
+    static std::vector<SkinnedInstanceData> s_Instances;
+    static Mesh* s_CurrentMesh;
+    static Shader* s_CurrentShader;
+    static u32 s_DrawCalls;
+    static u32 s_TotalInstances;
+};
+
+} // namespace Engine
@@ -5,12 +5,15 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
 #include <vector>
 
 namespace Engine {
 
 // ── GPU 骨骼蒙皮辅助 ────────────────────────────────────────
-// 提供骨骼矩阵 uniform 上传和蒙皮网格 VAO 布局设置
+// 提供骨骼矩阵 uniform 上传和蒙皮网格 VAO 布局设置；
+// 另有 CPU 蒙皮路径 (SIMD)，供不便做 GPU 蒙皮的低端目标使用。
+// 大批同网格角色改用 SkinnedInstanceRenderer (骨骼调色板 + 实例化)。
 
 class SkinningUtils {
 public:
@@ -36,8 +39,37 @@ public:
         f32       Weights[4]  = {0.0f, 0.0f, 0.0f, 0.0f};
     };
 
-    /// 一键设置 SkinVertex 结构的完整 VAO 属性
+    /// 一键设置 SkinVertex 结构的完整 VAO 属性 (按 SKIN_VERTEX_LAYOUT)
     static void SetupSkinVertexVAO();
+
+    /// CPU 蒙皮: 按 skinning.glsl 的公式 (权重加权骨骼矩阵、权重和偏离 1 时归一化、
+    /// 法线/切线用逆转置) 变换到模型空间，写入 dst 的位置/法线/切线/副切线，其余字段照抄。
+    /// 与着色器的唯一差别: 没有有效权重的顶点保持原样 (着色器会塌缩到原点)。
+    /// 不依赖 GL 上下文，可在任意线程按顶点区间分段调用；src 与 dst 可以相同
+    static void SkinVertices(const SkinVertex* src, u32 count,
+                             const glm::mat4* boneMatrices, u32 boneCount,
+                             SkinVertex* dst);
+};
+
+// ── SkinVertex 属性布局 ─────────────────────────────────────
+// 与 skinning.glsl / skinning_instanced.glsl 的 location 一一对应。
+// SetupSkinVertexVAO 按此表设置属性，单元测试据此校验布局 (不需要 GL 上下文)。
+
+struct SkinVertexAttribute {
+    u32  Location;
+    u32  Components;
+    bool Integer;      // glVertexAttribIPointer (GL_INT)，否则为 GL_FLOAT
+    u32  Offset;
+};
+
+inline constexpr SkinVertexAttribute SKIN_VERTEX_LAYOUT[] = {
+    {0, 3, false, (u32)offsetof(SkinningUtils::SkinVertex, Position)},    // aPos
+    {1, 3, false, (u32)offsetof(SkinningUtils::SkinVertex, Normal)},      // aNormal
+    {2, 2, false, (u32)offsetof(SkinningUtils::SkinVertex, UV)},          // aUV
+    {3, 3, false, (u32)offsetof(SkinningUtils::SkinVertex, Tangent)},     // aTangent
+    {4, 3, false, (u32)offsetof(SkinningUtils::SkinVertex, Bitangent)},   // aBitangent
+    {5, 4, true,  (u32)offsetof(SkinningUtils::SkinVertex, BoneIDs)},     // aBoneIDs
+    {6, 4, false, (u32)offsetof(SkinningUtils::SkinVertex, Weights)},     // aWeights
 };
 
 } // namespace Engine
@@ -3,18 +3,53 @@
 #include "engine/core/types.h"
 #include "engine/renderer/texture.h"
 #include "engine/renderer/shader.h"
+#include "engine/renderer/sprite_list.h"
 
 #include <glm/glm.hpp>
 #include <string>
+#include <vector>
 
 namespace Engine {
 
 class Font; // 前向声明
 
+// ── 静态精灵网格 ────────────────────────────────────────────
+// 顶点常驻 GPU、只在内容变化时重新上传的四边形集合 (如 tilemap 区块)。
+// 顶点与批次表来自 SpriteBatchBuilder，经 SpriteBatch::DrawStaticMesh 绘制。
+class SpriteStaticMesh {
+public:
+    SpriteStaticMesh() = default;
+    ~SpriteStaticMesh();
+
+    SpriteStaticMesh(const SpriteStaticMesh&) = delete;
+    SpriteStaticMesh& operator=(const SpriteStaticMesh&) = delete;
+
+    /// 上传顶点 (quadCount × 4) 与批次表 (FirstQuad 相对 vertices)
+    void Upload(const SpriteVertex* vertices, u32 quadCount, const std::vector<SpriteDrawBatch>& batches);
+
+    u32 GetQuadCount() const { return m_QuadCount; }
+    const std::vector<SpriteDrawBatch>& GetBatches() const { return m_Batches; }
+
+private:
+    friend class SpriteBatch;
+
+    u32 m_VAO = 0;
+    u32 m_VBO = 0;
+    u32 m_CapacityQuads = 0;
+    u32 m_QuadCount = 0;
+    std::vector<SpriteDrawBatch> m_Batches;
+};
+
 // ── 2D 精灵批渲染器 ────────────────────────────────────────
 // 批量绘制 2D 四边形，使用正交投影
 // 支持纹理/纯色/旋转/缩放
-
+//
+// Begin 与 End 之间的绘制只记录到命令列表，End 时合并所有列表、按
+// (层, 纹理, 深度) 基数排序并切分批次 (见 SpriteBatchBuilder)，再写入
+// 三段轮转的顶点缓冲 (每段一个 fence，写入时 GPU 仍可读其余两段)。
+// 主线程用 Draw/DrawRect/DrawText；工作线程用 AcquireList() 取得自己的列表。
+// 多线程列表之间的先后不确定: 会相互重叠的精灵用不同的层区分。
+// 静态网格 (DrawStaticMesh) 在 End 时先于所有动态精灵、按提交顺序绘制。
 class SpriteBatch {
 public:
     /// 初始化渲染资源
@@ -54,7 +89,19 @@ public:
                          f32 scale = 1.0f,
                          const glm::vec4& color = glm::vec4(1.0f));
 
-    /// 结束当前帧 (Flush 到 GPU)
+    /// 主线程之后的绘制所在的层 (小的先画，Begin 时重置为 0)
+    static void SetLayer(u8 layer);
+
+    /// 层内排序方式 (默认 Submission，跨帧保留)
+    static void SetLayerSortMode(u8 layer, SpriteSortMode mode);
+
+    /// 取得一个本帧专用的命令列表 (线程安全)，End 时自动合并
+    static SpriteCommandList& AcquireList();
+
+    /// 绘制静态网格 (transform 把网格坐标变换到屏幕像素)。网格须存活到 End
+    static void DrawStaticMesh(const SpriteStaticMesh& mesh, const glm::mat4& transform = glm::mat4(1.0f));
+
+    /// 结束当前帧 (排序合并后提交到 GPU)
     static void End();
 
     /// 渲染统计
@@ -62,14 +109,19 @@ public:
     static u32 GetQuadCount();
 
     /// 常量
-    static constexpr u32 MAX_QUADS = 10000;
+    static constexpr u32 MAX_QUADS = 10000;                 // 单次 DrawCall 上限
     static constexpr u32 MAX_VERTICES = MAX_QUADS * 4;
     static constexpr u32 MAX_INDICES = MAX_QUADS * 6;
-    static constexpr u32 MAX_TEXTURE_SLOTS = 16;
+    static constexpr u32 MAX_TEXTURE_SLOTS = SpriteDrawBatch::MAX_TEXTURE_SLOTS;
+    static constexpr u32 SEGMENT_QUADS = 32768;             // 顶点环每段容量
+    static constexpr u32 RING_SIZE = 3;
 
 private:
+    friend class SpriteStaticMesh;
+
     static void Flush();
-    static void StartBatch();
+    static void FlushStaticMeshes();
+    static void BindVertexAttributes(size_t baseOffset);
 };
 
 } // namespace Engine
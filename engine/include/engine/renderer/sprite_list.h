@@ -0,0 +1,145 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/core/radix_sort.h"
+
+#include <glm/glm.hpp>
+#include <unordered_map>
+#include <vector>
+
+namespace Engine {
+
+// ── 精灵顶点 / 排序模式 ─────────────────────────────────────
+
+struct SpriteVertex {
+    glm::vec2 Position;
+    glm::vec2 TexCoord;
+    glm::vec4 Color;
+    f32 TexIndex;  // 批次内纹理槽 (0 = 白色纹理)，由 SpriteBatchBuilder 填写
+};
+
+/// 层内排序方式。层号总是优先 (小的先画)
+enum class SpriteSortMode : u8 {
+    Submission,   // 按提交顺序 (默认，重叠精灵的前后关系由提交顺序决定)
+    Texture,      // 按 (纹理, 深度) 排序合并批次，适合互不重叠的大量精灵 (如地面瓦片)
+};
+
+/// 一个待绘制的四边形 (52 字节，展开为顶点推迟到写入顶点缓冲时)
+struct SpriteQuad {
+    glm::vec2 Position;   // 左上角
+    glm::vec2 Size;
+    glm::vec4 UV;         // {u0, v0, u1, v1}
+    glm::vec4 Color;
+    f32 Rotation;         // 绕中心旋转 (弧度)
+};
+
+// ── 纹理重定向 ──────────────────────────────────────────────
+// 源纹理 ID → 图集页纹理 ID + 源纹理在页内的 UV 区域 (由 TextureAtlas 注册)。
+// SpriteCommandList::Draw 提交时查表，已打进图集的纹理自动改画图集页并换算 UV，
+// 调用端不用改。GL 纹理名是小整数，直接按 ID 索引；只在帧外 (加载期) 修改。
+
+class SpriteTextureRemap {
+public:
+    static constexpr u32 MAX_TEXTURE_ID = 1u << 16;
+
+    static void Set(u32 sourceID, u32 pageID, const glm::vec4& uvRect);
+    static void Remove(u32 sourceID);
+    static void Clear();
+
+    /// 若 textureID 已重定向，改写为页纹理并把 uv 换算到页内
+    static void Apply(u32& textureID, glm::vec4& uv) {
+        if (textureID >= s_Entries.size()) return;
+        const Entry& e = s_Entries[textureID];
+        if (e.PageID == 0) return;
+        f32 sx = e.UVRect.z - e.UVRect.x;
+        f32 sy = e.UVRect.w - e.UVRect.y;
+        uv = {e.UVRect.x + uv.x * sx, e.UVRect.y + uv.y * sy,
+              e.UVRect.x + uv.z * sx, e.UVRect.y + uv.w * sy};
+        textureID = e.PageID;
+    }
+
+private:
+    struct Entry {
+        u32 PageID = 0;
+        glm::vec4 UVRect{0.0f};
+    };
+    static std::vector<Entry> s_Entries;
+};
+
+// ── 精灵命令列表 ────────────────────────────────────────────
+// 不依赖 GL 的四边形记录，连同纹理 ID、层、深度一起存下。
+// 每个线程写自己的列表 (SpriteBatch::AcquireList)，End 时统一合并排序。
+// 深度取 [0, 1]，同层同纹理内小的先画 (量化到 12 位)。
+
+class SpriteCommandList {
+public:
+    void Clear();
+    void Reserve(u32 quads);
+
+    /// 之后提交的精灵所在的层
+    void SetLayer(u8 layer) { m_Layer = layer; }
+    u8 GetLayer() const { return m_Layer; }
+
+    /// 绘制纹理子区域 (textureID = 0 为纯色)，绕中心旋转 rotation 弧度。
+    /// 已打进图集的纹理经 SpriteTextureRemap 改写为图集页
+    void Draw(u32 textureID, const glm::vec2& position, const glm::vec2& size,
+              const glm::vec4& uvRect, f32 rotation, const glm::vec4& tint, f32 depth = 0.0f);
+
+    u32 GetQuadCount() const { return (u32)m_TextureIDs.size(); }
+    const SpriteQuad& GetQuad(u32 quad) const { return m_Quads[quad]; }
+    u32 GetTextureID(u32 quad) const { return m_TextureIDs[quad]; }
+    /// 高 8 位层号，低 12 位量化深度
+    u32 GetSortInfo(u32 quad) const { return m_SortInfo[quad]; }
+
+    /// 把四边形展开为 4 个顶点 (左上、右上、右下、左下)
+    static void Expand(const SpriteQuad& quad, f32 texIndex, SpriteVertex* out);
+
+private:
+    std::vector<SpriteQuad> m_Quads;
+    std::vector<u32> m_TextureIDs;
+    std::vector<u32> m_SortInfo;
+    u8 m_Layer = 0;
+};
+
+// ── 合并 / 排序 / 分批 ──────────────────────────────────────
+// 所有列表的四边形按 32 位键 (层 8 位 | 纹理序 12 位 | 深度 12 位) 基数排序；
+// Submission 层只用层号作键，稳定排序保持提交顺序。随后按排序结果切分批次:
+// 纹理槽 (含白色纹理) 用满或达到单批上限时开新批次。
+
+struct SpriteDrawBatch {
+    static constexpr u32 MAX_TEXTURE_SLOTS = 16;
+
+    u32 FirstQuad = 0;
+    u32 QuadCount = 0;
+    u32 TextureCount = 1;                    // 槽 0 固定为白色纹理
+    u32 Textures[MAX_TEXTURE_SLOTS] = {};    // 纹理 ID (槽 0 = 0，由渲染端替换为白色纹理)
+};
+
+class SpriteBatchBuilder {
+public:
+    static constexpr u32 MAX_LISTS = 256;
+
+    void SetLayerSortMode(u8 layer, SpriteSortMode mode) { m_LayerModes[layer] = mode; }
+    SpriteSortMode GetLayerSortMode(u8 layer) const { return m_LayerModes[layer]; }
+
+    /// 合并排序并生成批次；列表在下一次 Build 之前不得修改。不同实例可在不同线程同时使用
+    void Build(const SpriteCommandList* const* lists, u32 count, u32 maxQuadsPerBatch);
+
+    u32 GetQuadCount() const { return (u32)m_Keys.size(); }
+    const std::vector<SpriteDrawBatch>& GetBatches() const { return m_Batches; }
+
+    /// 按排序结果写出第 [begin, end) 个四边形的顶点 (纹理槽已填好)，不同区间可并行
+    void WriteVertices(u32 begin, u32 end, SpriteVertex* out) const;
+
+private:
+    SpriteSortMode m_LayerModes[256] = {};
+    std::vector<const SpriteCommandList*> m_Lists;
+    std::vector<u32> m_Keys;
+    std::vector<u32> m_Order;    // 列表序号 << 24 | 四边形序号
+    std::vector<u8> m_Slots;     // 排序后每个四边形的纹理槽
+    std::vector<SpriteDrawBatch> m_Batches;
+    std::unordered_map<u32, u32> m_TextureRanks;   // 纹理 ID → 本次 Build 的纹理序
+    RadixSorter m_Sorter;
+};
+
+} // namespace Engine
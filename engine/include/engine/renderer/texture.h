@@ -1,6 +1,7 @@
 #pragma once
 
 #include "engine/core/types.h"
+#include "engine/renderer/bc_encoder.h"
 #include <string>
 
 namespace Engine {
@@ -15,6 +16,10 @@ public:
     Texture2D(u32 width, u32 height, const void* data = nullptr);
     /// 从原始像素数据构建（指定通道数，用于异步加载 GPU 上传）
     Texture2D(u32 width, u32 height, u32 channels, const void* data);
+    /// 预分配 mipLevels 层不可变存储，不上传数据（用于 TextureStreamer 逐层填充）
+    Texture2D(u32 width, u32 height, u32 channels, u32 mipLevels);
+    /// 预分配 BC 压缩格式的 mipLevels 层存储 (cook 产出的压缩纹理)
+    Texture2D(u32 width, u32 height, BcFormat format, u32 mipLevels);
     ~Texture2D();
 
     // 禁止拷贝
@@ -30,6 +35,23 @@ public:
     /// 设置最近邻采样 (Pixel Art 必须)
     void SetFilterNearest();
 
+    // ── 流式上传 (mip 逐层细化) ─────────────────────────────
+
+    /// 上传某一 mip 层的若干行 [rowBegin, rowBegin + rowCount)
+    /// 若当前绑定了 GL_PIXEL_UNPACK_BUFFER，pixels 为 PBO 内偏移
+    void UploadMipRows(u32 level, u32 rowBegin, u32 rowCount, const void* pixels);
+
+    /// 上传某一 mip 层的完整压缩数据 (BC 块, size 为字节数)
+    void UploadCompressedMip(u32 level, const void* data, u32 size);
+
+    /// 设置可采样的最精细层 (GL_TEXTURE_BASE_LEVEL)，更精细的层尚未就绪
+    void SetResidentLevel(u32 level);
+
+    u32 GetMipLevels() const { return m_MipLevels; }
+    u32 GetResidentLevel() const { return m_ResidentLevel; }
+    u32 GetChannels() const { return m_Channels; }
+    bool IsCompressed() const { return m_Compressed; }
+
     u32 GetID() const { return m_ID; }
     u32 GetWidth() const { return m_Width; }
     u32 GetHeight() const { return m_Height; }
@@ -43,6 +65,9 @@ private:
     u32 m_Channels = 0;
     u32 m_InternalFormat = 0;
     u32 m_DataFormat = 0;
+    u32 m_MipLevels = 1;
+    u32 m_ResidentLevel = 0;
+    bool m_Compressed = false;
 };
 
 } // namespace Engine
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/renderer/atlas_packer.h"
+#include "engine/renderer/texture.h"
+
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+class Font;
+
+// ── 运行时纹理图集 ──────────────────────────────────────────
+// 加载期把精灵表、tileset、字体字形打进共享的图集页 (Skyline 装箱)，
+// Build 后通过 SpriteTextureRemap 把源纹理重定向到图集页: 原有的
+// SpriteBatch::Draw(texture, uv) / DrawText 调用无需修改，同页的精灵自然合批。
+//
+// 限制: UV 必须落在 [0,1] 内 (依赖 REPEAT 平铺的纹理不要加入)；
+// 源纹理在图集析构前必须保持存活 (否则 GL 可能复用其 ID)。
+
+class TextureAtlas {
+public:
+    /// nearestFilter: 页纹理使用最近邻采样 (像素风)，否则线性采样
+    explicit TextureAtlas(u32 pageSize = 2048, u32 padding = 1, bool nearestFilter = true);
+    ~TextureAtlas();
+
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    /// 重新读取 texture 的源图像文件并排入打包 (GL 端无法回读像素)
+    bool AddTexture(const Ref<Texture2D>& texture, const std::string& filepath);
+    /// 直接排入 RGBA8 像素，替代 ID 为 textureID 的纹理
+    void AddPixels(u32 textureID, const u8* rgba, u32 width, u32 height, u32 sourceHeight = 0);
+    /// 排入字体字形位图 (只打包已用的行)
+    bool AddFont(const Font& font);
+
+    /// 装箱、创建页纹理并注册重定向。可多次调用: 新排入的图像追加进现有页
+    bool Build();
+
+    u32 GetPageCount() const { return (u32)m_Pages.size(); }
+    const Ref<Texture2D>& GetPage(u32 index) const { return m_Pages[index]; }
+    const AtlasBuilder& GetBuilder() const { return m_Builder; }
+
+private:
+    void ClearRemap();
+
+    AtlasBuilder m_Builder;
+    bool m_NearestFilter;
+    std::vector<Ref<Texture2D>> m_Pages;
+    std::vector<u32> m_RemappedIDs;
+};
+
+} // namespace Engine
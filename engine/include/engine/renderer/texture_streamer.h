@@ -0,0 +1,127 @@
+#pragma once
+
+#include "engine/core/types.h"
+#include "engine/renderer/texture.h"
+#include "engine/renderer/mip_chain.h"
+
+#include <string>
+#include <functional>
+#include <vector>
+#include <queue>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+namespace Engine {
+
+// ── 纹理流送配置 ────────────────────────────────────────────
+
+struct TextureStreamerConfig {
+    u32 UploadBudgetBytes  = 4 * 1024 * 1024;  // 每帧最多上传字节数 (同时也是单个 PBO 大小)
+    u32 StagingBufferCount = 3;                // PBO 环形缓冲数量 (>= 2 才能与 GPU 并行)
+    MipFilter Filter       = MipFilter::Box;   // 工作线程 mip 生成滤波器
+};
+
+// ── 纹理流送系统 ────────────────────────────────────────────
+//
+// 工作线程: 磁盘读取 + stbi 解码 + 构建完整 mip 链 (不依赖驱动 glGenerateMipmap)
+// 主线程:   按字节预算，经 PBO (GL_PIXEL_UNPACK_BUFFER) 环形缓冲逐层上传
+//
+// 上传顺序从最粗的 mip 开始向 level 0 细化，每完成一层就下放
+// GL_TEXTURE_BASE_LEVEL，纹理在第一帧就可以以低分辨率参与绘制。
+// 大层 (如 4K level 0) 会按行切分到多帧，单帧上传量永远不超过预算。
+//
+// 用法:
+//   TextureStreamer::Init();
+//   TextureStreamer::Request("grass", "textures/grass.png", [](Ref<Texture2D> t) { ... });
+//   // 主循环中:
+//   TextureStreamer::Update();
+//   // 退出时:
+//   TextureStreamer::Shutdown();
+//
+// 线程安全: Request / Update 只能在主线程调用 (GL 上下文所在线程)。
+
+class TextureStreamer {
+public:
+    static void Init(const TextureStreamerConfig& config = {});
+    static void Shutdown();
+    static bool IsActive() { return s_Initialized; }
+
+    /// 提交流送请求。callback 在最粗一层就绪 (纹理首次可采样) 时于主线程调用。
+    /// 同名纹理已缓存则立即回调；已在流送中则合并到同一请求。
+    static void Request(const std::string& name,
+                        const std::string& filepath,
+                        std::function<void(Ref<Texture2D>)> callback = nullptr);
+
+    /// 主线程每帧调用: 接收解码结果并在预算内上传 mip 数据
+    static void Update();
+
+    // ── 状态查询 ────────────────────────────────────────────
+
+    /// 正在工作线程解码中的数量
+    static u32 GetInFlightCount() { return s_InFlight.load(); }
+
+    /// 已解码、尚未完全上传的纹理数量
+    static u32 GetStreamingCount() { return (u32)s_Streams.size(); }
+
+    /// 尚未上传的字节数
+    static u64 GetPendingBytes();
+
+    /// 上一帧实际上传字节数
+    static u32 GetLastFrameUploadBytes() { return s_LastFrameBytes; }
+
+    /// 是否全部完成 (无解码中、无待上传)
+    static bool IsIdle();
+
+private:
+    // 工作线程产出
+    struct DecodedTexture {
+        std::string Name;
+        std::string FilePath;
+        MipChain Chain;
+    };
+
+    // 主线程流送状态
+    struct StreamState {
+        std::string Name;
+        Ref<Texture2D> Texture;
+        MipChain Chain;
+        u32 Level = 0;         // 正在上传的层 (从最粗层递减到 0)
+        u32 Row = 0;           // 该层已上传行数
+        bool Published = false;
+    };
+
+    // 单次 PBO → 纹理拷贝
+    struct UploadCommand {
+        StreamState* Stream = nullptr;
+        u32 Level = 0;
+        u32 RowBegin = 0;
+        u32 RowCount = 0;
+        size_t Offset = 0;
+        bool LevelComplete = false;
+    };
+
+    static void AcceptDecoded();
+    static void Publish(StreamState& stream);
+
+    static TextureStreamerConfig s_Config;
+    static bool s_Initialized;
+
+    // 解码完成队列 (工作线程写入，主线程读取)
+    static std::queue<Scope<DecodedTexture>> s_DecodedQueue;
+    static std::mutex s_DecodedMutex;
+    static std::atomic<u32> s_InFlight;
+
+    // 主线程状态
+    static std::vector<Scope<StreamState>> s_Streams;
+    static std::unordered_map<std::string, std::vector<std::function<void(Ref<Texture2D>)>>> s_Waiters;
+    static std::vector<UploadCommand> s_Commands;
+
+    // PBO 环形缓冲
+    static std::vector<u32>   s_StagingBuffers;
+    static std::vector<void*> s_StagingFences;   // GLsync
+    static u32 s_StagingIndex;
+    static u32 s_LastFrameBytes;
+};
+
+} // namespace Engine
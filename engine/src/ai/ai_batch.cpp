@@ -0,0 +1,164 @@
+#include "engine/ai/ai_batch.h"
+
+namespace Engine {
+namespace AI {
+
+i32 AIBatch::RoleToInt(const std::string& role) {
+    if (role == "leader")    return 1;
+    if (role == "commander") return 2;
+    return 0;
+}
+
+void AIBatch::Clear() {
+    m_Entities.clear();
+    m_AgentRows.clear();
+    m_EnemyRows.clear();
+    m_AllyRows.clear();
+    m_SquadRows.clear();
+    m_OrderIndex.clear();
+    Orders.clear();
+    PlayerData.assign(Player::FloatCount, 0.0f);
+}
+
+u32 AIBatch::Add(u32 entityID, const AIContext& ctx) {
+    u32 row = (u32)m_Entities.size();
+    m_Entities.push_back(entityID);
+
+    AgentRow& a = m_AgentRows.emplace_back();
+    a.F[Agent::PosX] = ctx.Position.x;
+    a.F[Agent::PosY] = ctx.Position.y;
+    a.F[Agent::PosZ] = ctx.Position.z;
+    a.F[Agent::RotY] = ctx.Rotation.y;
+    a.F[Agent::Health] = ctx.Health;
+    a.F[Agent::MaxHealth] = ctx.MaxHealth;
+    a.F[Agent::DetectRange] = ctx.DetectRange;
+    a.F[Agent::AttackRange] = ctx.AttackRange;
+    a.F[Agent::MoveSpeed] = ctx.MoveSpeed;
+    a.F[Agent::DeltaTime] = ctx.DeltaTime;
+    a.F[Agent::FrameDeltaTime] = ctx.FrameDeltaTime;
+
+    a.I[Agent::EntityID] = (i32)ctx.EntityID;
+    a.I[Agent::State] = (i32)ctx.CurrentState;
+    a.I[Agent::Role] = RoleToInt(ctx.Role);
+    a.I[Agent::SquadID] = (i32)ctx.SquadID;
+    a.I[Agent::SquadSize] = (i32)ctx.SquadSize;
+    a.I[Agent::SquadAlive] = (i32)ctx.SquadAlive;
+    a.I[Agent::HasPlayer] = ctx.HasPlayerData ? 1 : 0;
+
+    // 同一命令只传一份字符串
+    a.I[Agent::Order] = -1;
+    if (!ctx.CurrentOrder.empty()) {
+        auto [it, inserted] = m_OrderIndex.try_emplace(ctx.CurrentOrder, (i32)Orders.size());
+        if (inserted) Orders.push_back(ctx.CurrentOrder);
+        a.I[Agent::Order] = it->second;
+    }
+
+    a.I[Agent::EnemyBegin] = (i32)m_EnemyRows.size();
+    a.I[Agent::EnemyCount] = (i32)ctx.NearbyEnemies.size();
+    for (const auto& e : ctx.NearbyEnemies) {
+        m_EnemyRows.push_back({e.Position, e.Health, e.Distance, e.EntityID});
+    }
+
+    a.I[Agent::AllyBegin] = (i32)m_AllyRows.size();
+    a.I[Agent::AllyCount] = (i32)ctx.SquadMembers.size();
+    for (const auto& m : ctx.SquadMembers) {
+        m_AllyRows.push_back({m.Position, m.Health, m.MaxHealth, m.Distance, m.EntityID,
+                              (i32)AIStateFromString(m.State), RoleToInt(m.Role)});
+    }
+
+    // 玩家数据与小队概览对所有 agent 相同，只取一份
+    if (ctx.HasPlayerData) {
+        f32* p = PlayerData.data();
+        p[Player::PosX] = ctx.PlayerPosition.x;
+        p[Player::PosY] = ctx.PlayerPosition.y;
+        p[Player::PosZ] = ctx.PlayerPosition.z;
+        p[Player::VelX] = ctx.PlayerVelocity.x;
+        p[Player::VelY] = ctx.PlayerVelocity.y;
+        p[Player::VelZ] = ctx.PlayerVelocity.z;
+        p[Player::Speed] = ctx.PlayerSpeed;
+        p[Player::AvgSpeed] = ctx.PlayerAvgSpeed;
+        p[Player::AttackCount] = (f32)ctx.PlayerAttackCount;
+        p[Player::RetreatCount] = (f32)ctx.PlayerRetreatCount;
+        p[Player::Aggression] = ctx.PlayerAggressionScore;
+        p[Player::CombatTime] = ctx.PlayerCombatTime;
+    }
+    if (m_SquadRows.empty() && !ctx.AllSquads.empty()) m_SquadRows = ctx.AllSquads;
+
+    return row;
+}
+
+void AIBatch::Pack() {
+    const u32 n = GetCount();
+
+    Agents.Resize(n, Agent::FloatCount, Agent::IntCount);
+    for (u32 r = 0; r < n; r++) {
+        const AgentRow& a = m_AgentRows[r];
+        for (u32 c = 0; c < Agent::FloatCount; c++) Agents.F(c, r) = a.F[c];
+        for (u32 c = 0; c < Agent::IntCount; c++) Agents.I(c, r) = a.I[c];
+    }
+
+    Enemies.Resize((u32)m_EnemyRows.size(), Enemy::FloatCount, Enemy::IntCount);
+    for (u32 r = 0; r < Enemies.Rows; r++) {
+        const EnemyRow& e = m_EnemyRows[r];
+        Enemies.F(Enemy::PosX, r) = e.Position.x;
+        Enemies.F(Enemy::PosY, r) = e.Position.y;
+        Enemies.F(Enemy::PosZ, r) = e.Position.z;
+        Enemies.F(Enemy::Health, r) = e.Health;
+        Enemies.F(Enemy::Dist, r) = e.Distance;
+        Enemies.I(Enemy::EntityID, r) = (i32)e.EntityID;
+    }
+
+    Allies.Resize((u32)m_AllyRows.size(), Ally::FloatCount, Ally::IntCount);
+    for (u32 r = 0; r < Allies.Rows; r++) {
+        const AllyRow& m = m_AllyRows[r];
+        Allies.F(Ally::PosX, r) = m.Position.x;
+        Allies.F(Ally::PosY, r) = m.Position.y;
+        Allies.F(Ally::PosZ, r) = m.Position.z;
+        Allies.F(Ally::Health, r) = m.Health;
+        Allies.F(Ally::MaxHealth, r) = m.MaxHealth;
+        Allies.F(Ally::Dist, r) = m.Distance;
+        Allies.I(Ally::EntityID, r) = (i32)m.EntityID;
+        Allies.I(Ally::State, r) = m.State;
+        Allies.I(Ally::Role, r) = m.Role;
+    }
+
+    Squads.Resize((u32)m_SquadRows.size(), Squad::FloatCount, Squad::IntCount);
+    for (u32 r = 0; r < Squads.Rows; r++) {
+        const auto& s = m_SquadRows[r];
+        Squads.F(Squad::CenterX, r) = s.CenterPosition.x;
+        Squads.F(Squad::CenterY, r) = s.CenterPosition.y;
+        Squads.F(Squad::CenterZ, r) = s.CenterPosition.z;
+        Squads.F(Squad::AvgHealth, r) = s.AverageHealth;
+        Squads.I(Squad::SquadID, r) = (i32)s.SquadID;
+        Squads.I(Squad::Total, r) = (i32)s.TotalMembers;
+        Squads.I(Squad::Alive, r) = (i32)s.AliveMembers;
+        Squads.I(Squad::HasOrder, r) = s.CurrentOrder == "active" ? 1 : 0;
+    }
+
+    // 结果表初值: 保持当前状态、不移动
+    Actions.Resize(n, Action::FloatCount, Action::IntCount);
+    for (u32 r = 0; r < n; r++) Actions.I(Action::State, r) = m_AgentRows[r].I[Agent::State];
+    m_Custom.assign(n, std::string());
+    m_OrderOut.assign(n, std::string());
+}
+
+void AIBatch::SetStrings(u32 row, const std::string& custom, const std::string& order) {
+    if (row >= GetCount()) return;
+    m_Custom[row] = custom;
+    m_OrderOut[row] = order;
+}
+
+AIAction AIBatch::GetAction(u32 row) const {
+    AIAction action;
+    i32 state = Actions.I(Action::State, row);
+    action.NewState = (state >= 0 && state <= (i32)AIState::Dead) ? (AIState)state : AIState::Idle;
+    action.MoveDirection = {Actions.F(Action::DirX, row), Actions.F(Action::DirY, row), Actions.F(Action::DirZ, row)};
+    action.MoveSpeed = Actions.F(Action::Speed, row);
+    action.TargetEntityID = (u32)Actions.I(Action::Target, row);
+    action.CustomAction = m_Custom[row];
+    action.OrderForSubordinates = m_OrderOut[row];
+    return action;
+}
+
+} // namespace AI
+} // namespace Engine
@@ -0,0 +1,71 @@
+#include "engine/ai/ai_scheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace Engine {
+namespace AI {
+
+f32 AIScheduler::GetInterval(AIRole role, f32 distToPlayer, AIState state) const {
+    const Settings& s = m_Settings;
+    if (role == AIRole::Commander) return s.CommanderInterval;
+    if (role == AIRole::Leader)    return s.LeaderInterval;
+
+    f32 interval = s.NearInterval;
+    if (distToPlayer > s.FarDistance)       interval = s.FarInterval;
+    else if (distToPlayer > s.NearDistance) interval = s.MidInterval;
+
+    switch (state) {
+        case AIState::Idle:
+        case AIState::Patrol:
+            interval *= s.IdleScale;
+            break;
+        case AIState::Chase:
+        case AIState::Attack:
+        case AIState::Flee:
+            interval = std::min(interval, s.CombatMaxInterval);
+            break;
+        default:
+            break;
+    }
+    return interval;
+}
+
+f32 AIScheduler::InitialDelay(u32 entityID, f32 interval) {
+    // 黄金比例序列: 连续 ID 在 [0, 1) 上分布均匀
+    f32 phase = (f32)entityID * 0.6180339887f;
+    phase -= (f32)(u32)phase;
+    return phase * interval;
+}
+
+f32 AIScheduler::GetPriority(AIRole role, f32 overdue, bool woken) {
+    f32 priority = overdue;
+    if (role != AIRole::Soldier) priority += 100.0f;   // 命令链上游先思考
+    if (woken) priority += 1000.0f;
+    return priority;
+}
+
+u32 AIScheduler::GetFrameQuota() const {
+    if (m_Settings.BudgetMs <= 0.0f || m_CostPerAgentMs <= 0.0f) {
+        return std::numeric_limits<u32>::max();
+    }
+    u32 quota = (u32)(m_Settings.BudgetMs / m_CostPerAgentMs);
+    return std::max(quota, m_Settings.MinAgentsPerFrame);
+}
+
+void AIScheduler::Select(std::vector<Candidate>& candidates, u32 quota) {
+    if (candidates.size() <= quota) return;
+    std::nth_element(candidates.begin(), candidates.begin() + quota, candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.Priority > b.Priority; });
+    candidates.resize(quota);
+}
+
+void AIScheduler::EndFrame(u32 thought, f32 ms) {
+    if (thought == 0) return;
+    f32 cost = ms / (f32)thought;
+    // 指数平均，一帧的尖峰不至于把配额压到底
+    m_CostPerAgentMs = (m_CostPerAgentMs <= 0.0f) ? cost : m_CostPerAgentMs * 0.9f + cost * 0.1f;
+}
+
+} // namespace AI
+} // namespace Engine
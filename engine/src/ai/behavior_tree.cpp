@@ -2,144 +2,287 @@
 #include "engine/core/log.h"
 
 #include <algorithm>
-#include <queue>
 #include <cmath>
-#include <unordered_set>
 
 namespace Engine {
 
+// ── A* 工作缓冲 ─────────────────────────────────────────────
+
+void NavSearchState::Begin(u32 nodeCount) {
+    if (m_Nodes.size() < nodeCount) {
+        m_Nodes.resize(nodeCount, Node{0, NOT_IN_HEAP, 0.0f, 0});
+        m_Heap.resize(nodeCount);
+    }
+    if (++m_Generation == 0) {
+        for (Node& n : m_Nodes) n.Stamp = 0;
+        m_Generation = 1;
+    }
+    m_HeapSize = 0;
+    m_Expanded = 0;
+}
+
+void NavSearchState::SiftUp(u32 slot, HeapEntry entry) {
+    while (slot > 0) {
+        u32 parent = (slot - 1) / 2;
+        if (!HeapLess(entry, m_Heap[parent])) break;
+        m_Heap[slot] = m_Heap[parent];
+        m_Nodes[m_Heap[slot].Node].HeapPos = slot;
+        slot = parent;
+    }
+    m_Heap[slot] = entry;
+    m_Nodes[entry.Node].HeapPos = slot;
+}
+
+void NavSearchState::HeapPush(u32 node, f32 f, f32 g) {
+    SiftUp(m_HeapSize++, {f, g, node});
+}
+
+void NavSearchState::HeapDecrease(u32 node, f32 f, f32 g) {
+    SiftUp(m_Nodes[node].HeapPos, {f, g, node});
+}
+
+u32 NavSearchState::HeapPop() {
+    u32 top = m_Heap[0].Node;
+    m_Nodes[top].HeapPos = CLOSED;
+    HeapEntry last = m_Heap[--m_HeapSize];
+    if (m_HeapSize == 0) return top;
+
+    // 下沉
+    u32 slot = 0;
+    for (;;) {
+        u32 child = slot * 2 + 1;
+        if (child >= m_HeapSize) break;
+        if (child + 1 < m_HeapSize && HeapLess(m_Heap[child + 1], m_Heap[child])) child++;
+        if (!HeapLess(m_Heap[child], last)) break;
+        m_Heap[slot] = m_Heap[child];
+        m_Nodes[m_Heap[slot].Node].HeapPos = slot;
+        slot = child;
+    }
+    m_Heap[slot] = last;
+    m_Nodes[last.Node].HeapPos = slot;
+    return top;
+}
+
 // ── NavGrid 实现 ────────────────────────────────────────────
 
 NavGrid::NavGrid(u32 width, u32 height, f32 cellSize)
     : m_Width(width), m_Height(height), m_CellSize(cellSize)
 {
-    m_Nodes.resize(width * height);
-    for (u32 y = 0; y < height; y++) {
-        for (u32 x = 0; x < width; x++) {
-            NavNode& node = m_Nodes[y * width + x];
-            node.X = (i32)x;
-            node.Y = (i32)y;
-            node.Walkable = true;
-        }
-    }
+    m_Walkable.assign((size_t)width * height, 1);
     LOG_INFO("[NavGrid] 创建 %ux%u 导航网格 (格子大小: %.1f)", width, height, cellSize);
 }
 
 void NavGrid::SetWalkable(i32 x, i32 y, bool walkable) {
     if (x < 0 || x >= (i32)m_Width || y < 0 || y >= (i32)m_Height) return;
-    m_Nodes[y * m_Width + x].Walkable = walkable;
+    u8& cell = m_Walkable[(u32)y * m_Width + (u32)x];
+    if (cell == (walkable ? 1 : 0)) return;
+    cell = walkable ? 1 : 0;
+    m_Revision++;
+    if (m_ChangeLog.empty()) m_ChangeLog.resize(CHANGE_HISTORY);
+    m_ChangeLog[m_Revision % CHANGE_HISTORY] = {x, y};
+    if (m_Mode != NavSearchMode::AStar) m_SearchDataDirty = true;
+}
+
+bool NavGrid::GetChangedRegion(u32 sinceRevision, glm::ivec2& outMin, glm::ivec2& outMax) const {
+    u32 count = m_Revision - sinceRevision;
+    if (count > CHANGE_HISTORY) {
+        outMin = {0, 0};
+        outMax = {(i32)m_Width - 1, (i32)m_Height - 1};
+        return false;
+    }
+    outMin = {(i32)m_Width, (i32)m_Height};
+    outMax = {-1, -1};
+    for (u32 i = 1; i <= count; i++) {
+        const glm::ivec2& cell = m_ChangeLog[(sinceRevision + i) % CHANGE_HISTORY];
+        outMin = glm::min(outMin, cell);
+        outMax = glm::max(outMax, cell);
+    }
+    return true;
 }
 
-bool NavGrid::IsWalkable(i32 x, i32 y) const {
-    if (x < 0 || x >= (i32)m_Width || y < 0 || y >= (i32)m_Height) return false;
-    return m_Nodes[y * m_Width + x].Walkable;
+void NavGrid::CopyWalkability(const NavGrid& src) {
+    m_Width = src.m_Width;
+    m_Height = src.m_Height;
+    m_CellSize = src.m_CellSize;
+    m_Walkable = src.m_Walkable;
+    m_Mode = src.m_Mode;
+    m_Revision++;   // 旧的改动记录不再对应当前内容
+    RebuildSearchData();
 }
 
-NavNode* NavGrid::GetNode(i32 x, i32 y) {
-    if (x < 0 || x >= (i32)m_Width || y < 0 || y >= (i32)m_Height) return nullptr;
-    return &m_Nodes[y * m_Width + x];
+void NavGrid::SetSearchMode(NavSearchMode mode) {
+    m_Mode = mode;
+    RebuildSearchData();
 }
 
-std::vector<NavNode*> NavGrid::GetNeighbors(NavNode* node) {
-    std::vector<NavNode*> neighbors;
-    static const i32 dx[] = {-1, 0, 1, -1, 1, -1, 0, 1};
-    static const i32 dy[] = {-1, -1, -1, 0, 0, 1, 1, 1};
+void NavGrid::UpdateSearchData() {
+    if (!m_SearchDataDirty) return;
 
-    for (int i = 0; i < 8; i++) {
-        NavNode* n = GetNode(node->X + dx[i], node->Y + dy[i]);
-        if (n && n->Walkable) {
-            // 对角线移动检查：两个相邻正交格都必须可走
-            if (dx[i] != 0 && dy[i] != 0) {
-                if (!IsWalkable(node->X + dx[i], node->Y) ||
-                    !IsWalkable(node->X, node->Y + dy[i]))
-                    continue;
+    // 改动集中在一小块时局部修复；超过网格 1/8 面积时整体重建更划算
+    glm::ivec2 changedMin, changedMax;
+    if (GetChangedRegion(m_SearchRevision, changedMin, changedMax)) {
+        glm::ivec2 extent = glm::max(changedMax - changedMin + 1, glm::ivec2(0));
+        if ((u64)extent.x * (u64)extent.y * 8 <= (u64)m_Width * m_Height) {
+            if (extent.x > 0) {
+                if (m_Mode == NavSearchMode::JumpPoint) RepairJumpDistances(changedMin, changedMax);
+                else if (m_Mode == NavSearchMode::Hierarchical) RepairHierarchy(changedMin, changedMax);
             }
-            neighbors.push_back(n);
+            m_SearchDataDirty = false;
+            m_SearchRevision = m_Revision;
+            return;
         }
     }
-    return neighbors;
+    RebuildSearchData();
 }
 
-f32 NavGrid::Heuristic(NavNode* a, NavNode* b) {
-    // 八方向距离（对角线代价 √2）
-    f32 dx = std::abs((f32)(a->X - b->X));
-    f32 dy = std::abs((f32)(a->Y - b->Y));
-    return (dx + dy) + (1.414f - 2.0f) * std::min(dx, dy);
-}
+void NavGrid::RebuildSearchData() {
+    m_JumpDist.clear();
+    m_JumpDist.shrink_to_fit();
+    m_HpaNodes.clear();
+    m_HpaClusterFirst.clear();
+    m_HpaEdges.clear();
+    m_HpaSteps.clear();
+    m_SearchDataDirty = false;
+    m_SearchRevision = m_Revision;
 
-std::vector<glm::vec3> NavGrid::FindPath(const glm::vec3& start, const glm::vec3& end) {
-    // 世界坐标 → 网格坐标
-    i32 sx = (i32)(start.x / m_CellSize);
-    i32 sy = (i32)(start.z / m_CellSize);
-    i32 ex = (i32)(end.x / m_CellSize);
-    i32 ey = (i32)(end.z / m_CellSize);
-
-    NavNode* startNode = GetNode(sx, sy);
-    NavNode* endNode = GetNode(ex, ey);
-    if (!startNode || !endNode || !startNode->Walkable || !endNode->Walkable) {
-        return {};
+    switch (m_Mode) {
+        case NavSearchMode::AStar:        break;
+        case NavSearchMode::JumpPoint:    BuildJumpDistances(); break;
+        case NavSearchMode::Hierarchical: BuildHierarchy(); break;
     }
+}
 
-    // 重置所有节点
-    for (auto& node : m_Nodes) {
-        node.GCost = 1e9f;
-        node.HCost = 0;
-        node.Parent = nullptr;
-    }
+/// 八方向距离 (对角线代价 √2)
+f32 NavGrid::Heuristic(i32 ax, i32 ay, i32 bx, i32 by) {
+    f32 dx = (f32)std::abs(ax - bx);
+    f32 dy = (f32)std::abs(ay - by);
+    return (dx + dy) + (1.414f - 2.0f) * std::min(dx, dy);
+}
 
-    // A* 开放列表 (优先队列)
-    auto cmp = [](NavNode* a, NavNode* b) { return a->FCost() > b->FCost(); };
-    std::priority_queue<NavNode*, std::vector<NavNode*>, decltype(cmp)> openSet(cmp);
+u32 NavGrid::DirIndex(i32 dx, i32 dy) {
+    if (dy == 0) return dx < 0 ? 0 : 1;
+    if (dx == 0) return dy < 0 ? 2 : 3;
+    return 4 + (dx < 0 ? 0 : 1) + (dy < 0 ? 0 : 2);
+}
 
-    struct PairHash {
-        size_t operator()(const std::pair<i32,i32>& p) const {
-            return std::hash<i32>()(p.first) ^ (std::hash<i32>()(p.second) << 16);
-        }
+bool NavGrid::SearchCells(u32 startIdx, u32 goalIdx, const glm::ivec2& boundsMin, const glm::ivec2& boundsMax,
+                          NavSearchState& state) const {
+    static const f32 COST[8] = {1.0f, 1.0f, 1.0f, 1.0f, 1.414f, 1.414f, 1.414f, 1.414f};
+    const u32 width = m_Width;
+    const i32 gx = goalIdx == NO_GOAL ? 0 : (i32)(goalIdx % width);
+    const i32 gy = goalIdx == NO_GOAL ? 0 : (i32)(goalIdx / width);
+    auto heuristic = [&](i32 x, i32 y) {
+        return goalIdx == NO_GOAL ? 0.0f : Heuristic(x, y, gx, gy);
     };
-    std::unordered_set<std::pair<i32,i32>, PairHash> closedSet;
-
-    startNode->GCost = 0;
-    startNode->HCost = Heuristic(startNode, endNode);
-    openSet.push(startNode);
-
-    while (!openSet.empty()) {
-        NavNode* current = openSet.top();
-        openSet.pop();
-
-        if (current == endNode) {
-            // 回溯路径
-            std::vector<glm::vec3> path;
-            NavNode* node = endNode;
-            while (node) {
-                f32 wx = (node->X + 0.5f) * m_CellSize;
-                f32 wz = (node->Y + 0.5f) * m_CellSize;
-                path.push_back({wx, 0.0f, wz});
-                node = node->Parent;
-            }
-            std::reverse(path.begin(), path.end());
-            return path;
-        }
 
-        closedSet.insert({current->X, current->Y});
+    state.Begin(width * m_Height);
+    NavSearchState::Node& startNode = state.Touch(startIdx);
+    startNode.G = 0.0f;
+    startNode.Parent = startIdx;
+    state.HeapPush(startIdx, heuristic((i32)(startIdx % width), (i32)(startIdx / width)), 0.0f);
 
-        for (NavNode* neighbor : GetNeighbors(current)) {
-            if (closedSet.count({neighbor->X, neighbor->Y})) continue;
+    while (state.m_HeapSize > 0) {
+        u32 current = state.HeapPop();
+        state.m_Expanded++;
+        if (current == goalIdx) return true;
 
-            f32 dx = std::abs((f32)(neighbor->X - current->X));
-            f32 dy = std::abs((f32)(neighbor->Y - current->Y));
-            f32 moveCost = (dx + dy > 1.5f) ? 1.414f : 1.0f;  // 对角 vs 正交
-            f32 newG = current->GCost + moveCost;
+        i32 cx = (i32)(current % width);
+        i32 cy = (i32)(current / width);
+        f32 currentG = state.m_Nodes[current].G;
+        bool open[4];
 
-            if (newG < neighbor->GCost) {
-                neighbor->GCost = newG;
-                neighbor->HCost = Heuristic(neighbor, endNode);
-                neighbor->Parent = current;
-                openSet.push(neighbor);
+        // 前 4 个正交，后 4 个对角 (对角需要两侧正交格都可走，不能切角)
+        for (u32 i = 0; i < 8; i++) {
+            i32 nx = cx + DIR_X[i];
+            i32 ny = cy + DIR_Y[i];
+            bool walkable = nx >= boundsMin.x && nx <= boundsMax.x && ny >= boundsMin.y && ny <= boundsMax.y &&
+                            m_Walkable[(u32)ny * width + (u32)nx];
+            if (i < 4) {
+                open[i] = walkable;
+            } else {
+                // 对角 (dx, dy) 的两侧正交格: 左右 open[0|1]、上下 open[2|3]
+                walkable = walkable && open[DIR_X[i] < 0 ? 0 : 1] && open[DIR_Y[i] < 0 ? 2 : 3];
             }
+            if (!walkable) continue;
+
+            u32 neighbor = (u32)ny * width + (u32)nx;
+            NavSearchState::Node& n = state.Touch(neighbor);
+            if (n.HeapPos == NavSearchState::CLOSED) continue;
+
+            f32 newG = currentG + COST[i];
+            if (newG >= n.G) continue;
+
+            bool inHeap = n.HeapPos != NavSearchState::NOT_IN_HEAP;
+            n.G = newG;
+            n.Parent = current;
+            f32 f = newG + heuristic(nx, ny);
+            if (inHeap) state.HeapDecrease(neighbor, f, newG);
+            else        state.HeapPush(neighbor, f, newG);
         }
     }
 
-    return {};  // 无可达路径
+    return false;  // 无可达路径
+}
+
+void NavGrid::AppendParentChain(u32 startIdx, u32 goalIdx, const NavSearchState& state,
+                                std::vector<glm::ivec2>& out, bool includeStart) const {
+    size_t first = out.size();
+    for (u32 node = goalIdx; node != startIdx; node = state.m_Nodes[node].Parent) {
+        out.push_back({(i32)(node % m_Width), (i32)(node / m_Width)});
+    }
+    if (includeStart) out.push_back({(i32)(startIdx % m_Width), (i32)(startIdx / m_Width)});
+    std::reverse(out.begin() + (std::ptrdiff_t)first, out.end());
+}
+
+bool NavGrid::FindPathAStar(const glm::ivec2& start, const glm::ivec2& goal,
+                            std::vector<glm::ivec2>& outCells, NavSearchState& state) const {
+    u32 startIdx = (u32)start.y * m_Width + (u32)start.x;
+    u32 goalIdx = (u32)goal.y * m_Width + (u32)goal.x;
+    if (!SearchCells(startIdx, goalIdx, {0, 0}, {(i32)m_Width - 1, (i32)m_Height - 1}, state)) return false;
+    AppendParentChain(startIdx, goalIdx, state, outCells, true);
+    return true;
+}
+
+bool NavGrid::FindPath(const glm::ivec2& start, const glm::ivec2& goal,
+                       std::vector<glm::ivec2>& outCells, NavSearchState& state) const {
+    return FindPath(start, goal, outCells, state, m_Mode);
+}
+
+bool NavGrid::FindPath(const glm::ivec2& start, const glm::ivec2& goal, std::vector<glm::ivec2>& outCells,
+                       NavSearchState& state, NavSearchMode mode) const {
+    outCells.clear();
+    state.m_Expanded = 0;
+    if (!IsWalkable(start.x, start.y) || !IsWalkable(goal.x, goal.y)) return false;
+
+    // 加速数据只对应构建时的模式与可走性
+    if (mode != m_Mode || m_SearchDataDirty) mode = NavSearchMode::AStar;
+    switch (mode) {
+        case NavSearchMode::JumpPoint:    return FindPathJumpPoint(start, goal, outCells, state);
+        case NavSearchMode::Hierarchical: return FindPathHierarchical(start, goal, outCells, state);
+        case NavSearchMode::AStar:        break;
+    }
+    return FindPathAStar(start, goal, outCells, state);
+}
+
+bool NavGrid::FindPath(const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& outPath) {
+    outPath.clear();
+    // 世界坐标 → 网格坐标
+    glm::ivec2 s = {(i32)(start.x / m_CellSize), (i32)(start.z / m_CellSize)};
+    glm::ivec2 e = {(i32)(end.x / m_CellSize), (i32)(end.z / m_CellSize)};
+    if (m_SearchDataDirty) UpdateSearchData();
+    if (!FindPath(s, e, m_CellPath, m_Search)) return false;
+
+    outPath.reserve(m_CellPath.size());
+    for (const glm::ivec2& cell : m_CellPath) {
+        outPath.push_back({(cell.x + 0.5f) * m_CellSize, 0.0f, (cell.y + 0.5f) * m_CellSize});
+    }
+    return true;
+}
+
+std::vector<glm::vec3> NavGrid::FindPath(const glm::vec3& start, const glm::vec3& end) {
+    std::vector<glm::vec3> path;
+    FindPath(start, end, path);
+    return path;
 }
 
 } // namespace Engine
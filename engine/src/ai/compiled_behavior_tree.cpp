@@ -0,0 +1,234 @@
+#include "engine/ai/compiled_behavior_tree.h"
+#include "engine/core/job_system.h"
+#include "engine/core/log.h"
+
+namespace Engine {
+
+// ── 求值 ────────────────────────────────────────────────
+
+BTStatus CompiledBehaviorTree::Tick(BTAgentState& state, const BTTickContext& ctx) const {
+    if (m_Nodes.empty()) return state.LastStatus = BTStatus::Failure;
+
+    u16 node = state.Running;
+    state.Running = BTAgentState::NONE;
+    BTStatus status;
+
+    if (node == BTAgentState::NONE) {
+        node = 0;
+        status = Enter(0, state, ctx);
+    } else if (m_Nodes[node].Type == BTNodeType::Repeater) {
+        // 停在两次重复之间: 计数保留，重新进入孩子
+        status = Continue(node, node + 1, Enter(node + 1, state, ctx), state, ctx);
+    } else {
+        status = Enter(node, state, ctx);
+    }
+
+    // 沿父链向上传递，直到有节点仍在运行或到达根
+    while (status != BTStatus::Running && m_Nodes[node].Parent != BTAgentState::NONE) {
+        u16 parent = m_Nodes[node].Parent;
+        status = Continue(parent, node, status, state, ctx);
+        node = parent;
+    }
+    return state.LastStatus = status;
+}
+
+BTStatus CompiledBehaviorTree::Enter(u16 index, BTAgentState& state, const BTTickContext& ctx) const {
+    const Node& n = m_Nodes[index];
+    switch (n.Type) {
+        case BTNodeType::Action: {
+            BTStatus s = m_Actions[n.Payload](ctx);
+            if (s == BTStatus::Running) state.Running = index;
+            return s;
+        }
+        case BTNodeType::Condition:
+            return m_Conditions[n.Payload](ctx) ? BTStatus::Success : BTStatus::Failure;
+
+        case BTNodeType::Sequence:
+        case BTNodeType::Selector: {
+            // 空组合: Sequence 成功、Selector 失败
+            if (n.Next == index + 1) {
+                return n.Type == BTNodeType::Sequence ? BTStatus::Success : BTStatus::Failure;
+            }
+            u16 child = index + 1;
+            return Continue(index, child, Enter(child, state, ctx), state, ctx);
+        }
+        case BTNodeType::Inverter:
+        case BTNodeType::Repeater:
+            if (n.Type == BTNodeType::Repeater) state.Counters[n.Slot] = 0;
+            return Continue(index, index + 1, Enter(index + 1, state, ctx), state, ctx);
+    }
+    return BTStatus::Failure;
+}
+
+BTStatus CompiledBehaviorTree::Continue(u16 parent, u16 child, BTStatus status,
+                                        BTAgentState& state, const BTTickContext& ctx) const {
+    if (status == BTStatus::Running) return status;
+    const Node& p = m_Nodes[parent];
+
+    switch (p.Type) {
+        case BTNodeType::Sequence:
+        case BTNodeType::Selector: {
+            // Sequence 遇到非成功即返回，Selector 遇到非失败即返回；否则进入下一个兄弟
+            BTStatus pass = (p.Type == BTNodeType::Sequence) ? BTStatus::Success : BTStatus::Failure;
+            while (status == pass) {
+                child = m_Nodes[child].Next;
+                if (child == p.Next) return pass;
+                status = Enter(child, state, ctx);
+            }
+            return status;
+        }
+        case BTNodeType::Inverter:
+            return status == BTStatus::Success ? BTStatus::Failure : BTStatus::Success;
+
+        case BTNodeType::Repeater: {
+            // 与 BTRepeater 一致: 每帧最多完成一次孩子，未达次数时返回 Running
+            u16& count = state.Counters[p.Slot];
+            count++;
+            if (p.MaxRepeats > 0 && count >= p.MaxRepeats) return BTStatus::Success;
+            state.Running = parent;
+            return BTStatus::Running;
+        }
+        default:
+            return status;
+    }
+}
+
+// ── 构建器 ──────────────────────────────────────────────
+
+u16 BTBuilder::Push(BTNodeType type, const std::string& name) {
+    auto& nodes = m_Tree.m_Nodes;
+    if (nodes.size() >= BTAgentState::NONE) {
+        if (!m_Error) LOG_ERROR("[BT] 节点数超过上限 %u", (u32)BTAgentState::NONE);
+        m_Error = true;
+        return 0;
+    }
+
+    u16 index = (u16)nodes.size();
+    CompiledBehaviorTree::Node node;
+    node.Type = type;
+    node.Next = index + 1;
+    if (m_Open.empty()) {
+        m_Roots++;
+    } else {
+        node.Parent = m_Open.back();
+        const auto& parent = nodes[node.Parent];
+        bool decorator = parent.Type == BTNodeType::Inverter || parent.Type == BTNodeType::Repeater;
+        if (decorator && index != node.Parent + 1) {
+            LOG_ERROR("[BT] 装饰节点 '%s' 只能有一个孩子", m_Tree.m_Names[node.Parent].c_str());
+            m_Error = true;
+        }
+    }
+    nodes.push_back(node);
+    m_Tree.m_Names.push_back(name);
+    return index;
+}
+
+BTBuilder& BTBuilder::Sequence(const std::string& name) {
+    m_Open.push_back(Push(BTNodeType::Sequence, name));
+    return *this;
+}
+
+BTBuilder& BTBuilder::Selector(const std::string& name) {
+    m_Open.push_back(Push(BTNodeType::Selector, name));
+    return *this;
+}
+
+BTBuilder& BTBuilder::Inverter(const std::string& name) {
+    m_Open.push_back(Push(BTNodeType::Inverter, name));
+    return *this;
+}
+
+BTBuilder& BTBuilder::Repeater(u16 maxRepeats, const std::string& name) {
+    u16 index = Push(BTNodeType::Repeater, name);
+    if (m_Repeaters >= BTAgentState::MAX_COUNTERS) {
+        if (!m_Error) LOG_ERROR("[BT] Repeater 超过 %u 个", BTAgentState::MAX_COUNTERS);
+        m_Error = true;
+    } else if (!m_Error) {
+        m_Tree.m_Nodes[index].Slot = (u8)m_Repeaters++;
+        m_Tree.m_Nodes[index].MaxRepeats = maxRepeats;
+    }
+    m_Open.push_back(index);
+    return *this;
+}
+
+BTBuilder& BTBuilder::Action(const std::string& name, CompiledBehaviorTree::ActionFunc func) {
+    u16 index = Push(BTNodeType::Action, name);
+    if (m_Error) return *this;
+    m_Tree.m_Nodes[index].Payload = (u16)m_Tree.m_Actions.size();
+    m_Tree.m_Actions.push_back(std::move(func));
+    return *this;
+}
+
+BTBuilder& BTBuilder::Condition(const std::string& name, CompiledBehaviorTree::ConditionFunc func) {
+    u16 index = Push(BTNodeType::Condition, name);
+    if (m_Error) return *this;
+    m_Tree.m_Nodes[index].Payload = (u16)m_Tree.m_Conditions.size();
+    m_Tree.m_Conditions.push_back(std::move(func));
+    return *this;
+}
+
+BTBuilder& BTBuilder::End() {
+    if (m_Open.empty()) {
+        LOG_ERROR("[BT] End() 没有对应的组合/装饰节点");
+        m_Error = true;
+        return *this;
+    }
+    u16 index = m_Open.back();
+    m_Open.pop_back();
+    auto& node = m_Tree.m_Nodes[index];
+    node.Next = (u16)m_Tree.m_Nodes.size();
+
+    // 多个孩子已在 Push 时报告
+    bool decorator = node.Type == BTNodeType::Inverter || node.Type == BTNodeType::Repeater;
+    if (decorator && node.Next == index + 1) {
+        LOG_ERROR("[BT] 装饰节点 '%s' 没有孩子", m_Tree.m_Names[index].c_str());
+        m_Error = true;
+    }
+    return *this;
+}
+
+Ref<CompiledBehaviorTree> BTBuilder::Build() {
+    if (!m_Open.empty()) {
+        LOG_ERROR("[BT] 还有 %u 层没有 End()", (u32)m_Open.size());
+        m_Error = true;
+    }
+    if (m_Roots != 1) {
+        LOG_ERROR("[BT] 需要恰好一个根节点 (当前 %u 个)", m_Roots);
+        m_Error = true;
+    }
+    if (m_Error) return nullptr;
+
+    auto tree = CreateRef<CompiledBehaviorTree>(std::move(m_Tree));
+    m_Tree = CompiledBehaviorTree();
+    m_Roots = 0;
+    m_Repeaters = 0;
+    return tree;
+}
+
+// ── 系统 ────────────────────────────────────────────────
+
+void BehaviorTreeSystem::Update(ECSWorld& world, f32 dt) {
+    auto& pool = world.GetComponentArray<BehaviorTreeComponent>();
+    u32 count = pool.Size();
+
+    auto tick = [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) {
+            BehaviorTreeComponent& bt = pool.Data(i);
+            if (!bt.Tree) continue;
+            BTTickContext ctx{&world, pool.GetEntity(i), dt};
+            bt.Tree->Tick(bt.State, ctx);
+        }
+    };
+
+    // 未声明组件类型时无法保证回调不新建组件池，串行 tick
+    if (m_Parallel && !m_PoolSetup.empty()) {
+        for (auto setup : m_PoolSetup) setup(world);
+        world.SetPoolCreationLocked(true);
+        JobSystem::ParallelForRange(count, TICK_GRAIN, tick);
+        world.SetPoolCreationLocked(false);
+    } else {
+        tick(0, count);
+    }
+}
+
+} // namespace Engine
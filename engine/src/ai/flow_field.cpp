@@ -0,0 +1,271 @@
+#include "engine/ai/flow_field.h"
+#include "engine/ai/behavior_tree.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <functional>
+
+namespace Engine {
+
+// 方向编号与 NavGrid 相同: 0-3 正交 (-x, +x, -y, +y)，4-7 对角
+static constexpr i32 DIR_X[8] = {-1, 1, 0, 0, -1, 1, -1, 1};
+static constexpr i32 DIR_Y[8] = {0, 0, -1, 1, -1, -1, 1, 1};
+static constexpr u8  OPPOSITE[8] = {1, 0, 3, 2, 7, 6, 5, 4};
+static constexpr u32 STEP_COST[8] = {10, 10, 10, 10, 14, 14, 14, 14};
+
+// ── FlowField ───────────────────────────────────────────────
+
+void FlowField::Compute(const NavGrid& grid, const glm::ivec2& goal, f32 maxCost) {
+    u32 width = grid.GetWidth(), height = grid.GetHeight();
+    if (width != m_Width || height != m_Height) {
+        m_Width = width;
+        m_Height = height;
+        size_t cells = (size_t)width * height;
+        m_Stamp.assign(cells, 0);
+        m_Cost.resize(cells);
+        m_Dir.resize(cells);
+        m_Generation = 0;
+    }
+    if (++m_Generation == 0) {
+        std::fill(m_Stamp.begin(), m_Stamp.end(), 0u);
+        m_Generation = 1;
+    }
+
+    m_Goal = goal;
+    m_MaxCost = maxCost;
+    m_GridRevision = grid.GetRevision();
+    m_Reached = 0;
+    m_ReachedMin = {0, 0};
+    m_ReachedMax = {-1, -1};
+    if (!grid.IsWalkable(goal.x, goal.y)) return;
+
+    const u32 limit = maxCost >= 4.0e8f ? 0xFFFFFFFFu : (u32)(maxCost * 10.0f);
+    for (auto& bucket : m_Buckets) bucket.clear();
+
+    u32 goalIdx = (u32)goal.y * width + (u32)goal.x;
+    glm::ivec2 reachedMin = goal, reachedMax = goal;
+    m_Stamp[goalIdx] = m_Generation;
+    m_Cost[goalIdx] = 0;
+    m_Dir[goalIdx] = NO_DIRECTION;
+    m_Buckets[0].push_back(goalIdx);
+    m_Reached = 1;
+    u32 pending = 1;
+
+    const u8* walkable_ = grid.GetWalkableData();
+    u32 offset[8];
+    for (u32 i = 0; i < 8; i++) offset[i] = (u32)(DIR_Y[i] * (i32)width + DIR_X[i]);
+
+    // 桶队列: 单步代价 ≤ 14 < 桶数，当前桶处理期间不会有新元素落进同一个桶
+    for (u32 cost = 0; pending > 0; cost++) {
+        std::vector<u32>& bucket = m_Buckets[cost % BUCKET_COUNT];
+        for (size_t k = 0; k < bucket.size(); k++) {
+            u32 current = bucket[k];
+            pending--;
+            if (m_Cost[current] != cost) continue;   // 已被更短的代价取代
+
+            // 内部格子直接按偏移读可走性，只有贴边的格子才做越界判断
+            i32 cx = (i32)(current % width), cy = (i32)(current / width);
+            bool interior = cx > 0 && cy > 0 && cx + 1 < (i32)width && cy + 1 < (i32)height;
+            bool open[4];
+            for (u32 i = 0; i < 8; i++) {
+                u32 neighbor = current + offset[i];
+                bool walkable = interior ? walkable_[neighbor] != 0 : grid.IsWalkable(cx + DIR_X[i], cy + DIR_Y[i]);
+                if (i < 4) open[i] = walkable;
+                else walkable = walkable && open[DIR_X[i] < 0 ? 0 : 1] && open[DIR_Y[i] < 0 ? 2 : 3];
+                if (!walkable) continue;
+
+                u32 newCost = cost + STEP_COST[i];
+                if (newCost > limit) continue;
+                if (m_Stamp[neighbor] != m_Generation) {
+                    m_Stamp[neighbor] = m_Generation;
+                    m_Reached++;
+                    glm::ivec2 cell = {cx + DIR_X[i], cy + DIR_Y[i]};
+                    reachedMin = glm::min(reachedMin, cell);
+                    reachedMax = glm::max(reachedMax, cell);
+                } else if (newCost >= m_Cost[neighbor]) {
+                    continue;
+                }
+                m_Cost[neighbor] = newCost;
+                m_Dir[neighbor] = OPPOSITE[i];   // 邻格的下一步指回当前格
+                m_Buckets[newCost % BUCKET_COUNT].push_back(neighbor);
+                pending++;
+            }
+        }
+        bucket.clear();
+    }
+    m_ReachedMin = reachedMin;
+    m_ReachedMax = reachedMax;
+}
+
+bool FlowField::Repair(const NavGrid& grid, const glm::ivec2& changedMin, const glm::ivec2& changedMax) {
+    if (grid.GetWidth() != m_Width || grid.GetHeight() != m_Height || m_Reached == 0) {
+        // 尺寸变了或原先整张不可达 (目标格被堵): 整张重算
+        Compute(grid, m_Goal, m_MaxCost);
+        return true;
+    }
+    m_GridRevision = grid.GetRevision();
+
+    // 一条边 (含对角的两个侧格) 的可走性变化时，两端都在改动矩形外扩 1 格内；
+    // 外扩后与可达区域不相邻的改动不影响任何最短路径
+    const glm::ivec2 lo = glm::max(changedMin - 1, glm::ivec2(0));
+    const glm::ivec2 hi = glm::min(changedMax + 1, glm::ivec2((i32)m_Width - 1, (i32)m_Height - 1));
+    if (hi.x < m_ReachedMin.x - 1 || lo.x > m_ReachedMax.x + 1 ||
+        hi.y < m_ReachedMin.y - 1 || lo.y > m_ReachedMax.y + 1) {
+        return false;
+    }
+    if (!grid.IsWalkable(m_Goal.x, m_Goal.y)) {
+        Compute(grid, m_Goal, m_MaxCost);
+        return true;
+    }
+
+    const u32 width = m_Width;
+    const u32 goalIdx = (u32)m_Goal.y * width + (u32)m_Goal.x;
+    const u32 limit = m_MaxCost >= 4.0e8f ? 0xFFFFFFFFu : (u32)(m_MaxCost * 10.0f);
+    auto reached = [&](i32 x, i32 y) {
+        return x >= 0 && y >= 0 && x < (i32)width && y < (i32)m_Height &&
+               m_Stamp[(u32)y * width + (u32)x] == m_Generation;
+    };
+    // (x, y) 沿方向 i 走一步是否合法 (不切角)
+    auto canStep = [&](i32 x, i32 y, u32 i) {
+        if (!grid.IsWalkable(x + DIR_X[i], y + DIR_Y[i])) return false;
+        return i < 4 || (grid.IsWalkable(x + DIR_X[i], y) && grid.IsWalkable(x, y + DIR_Y[i]));
+    };
+    auto invalidate = [&](u32 idx) {
+        m_Stamp[idx] = 0;
+        m_Reached--;
+        m_Invalid.push_back(idx);
+    };
+
+    // 1. 作废: 改动区域内自身不可走或下一步不再合法的格子，以及最短路径树上它们的全部后代
+    m_Invalid.clear();
+    for (i32 y = lo.y; y <= hi.y; y++) {
+        for (i32 x = lo.x; x <= hi.x; x++) {
+            u32 idx = (u32)y * width + (u32)x;
+            if (idx == goalIdx || m_Stamp[idx] != m_Generation) continue;
+            if (!grid.IsWalkable(x, y) || !canStep(x, y, m_Dir[idx])) invalidate(idx);
+        }
+    }
+    for (size_t k = 0; k < m_Invalid.size(); k++) {
+        i32 x = (i32)(m_Invalid[k] % width), y = (i32)(m_Invalid[k] / width);
+        for (u32 i = 0; i < 8; i++) {
+            i32 nx = x + DIR_X[i], ny = y + DIR_Y[i];
+            if (!reached(nx, ny)) continue;
+            u32 n = (u32)ny * width + (u32)nx;
+            if (n != goalIdx && m_Dir[n] == OPPOSITE[i]) invalidate(n);   // 邻格的下一步指向这里
+        }
+    }
+
+    // 2. 从作废区域的边界和改动区域内仍可达的格子出发重新松弛 (代价任意，用二叉堆)
+    auto greater = std::greater<std::pair<u32, u32>>();
+    m_RepairHeap.clear();
+    auto seed = [&](i32 x, i32 y) {
+        if (!reached(x, y)) return;
+        u32 idx = (u32)y * width + (u32)x;
+        m_RepairHeap.push_back({m_Cost[idx], idx});
+        std::push_heap(m_RepairHeap.begin(), m_RepairHeap.end(), greater);
+    };
+    for (u32 idx : m_Invalid) {
+        i32 x = (i32)(idx % width), y = (i32)(idx / width);
+        for (u32 i = 0; i < 8; i++) seed(x + DIR_X[i], y + DIR_Y[i]);
+    }
+    for (i32 y = lo.y; y <= hi.y; y++) {
+        for (i32 x = lo.x; x <= hi.x; x++) seed(x, y);
+    }
+
+    while (!m_RepairHeap.empty()) {
+        std::pop_heap(m_RepairHeap.begin(), m_RepairHeap.end(), greater);
+        auto [cost, current] = m_RepairHeap.back();
+        m_RepairHeap.pop_back();
+        if (m_Stamp[current] != m_Generation || m_Cost[current] != cost) continue;
+
+        i32 cx = (i32)(current % width), cy = (i32)(current / width);
+        for (u32 i = 0; i < 8; i++) {
+            if (!canStep(cx, cy, i)) continue;
+            u32 newCost = cost + STEP_COST[i];
+            if (newCost > limit) continue;
+            i32 nx = cx + DIR_X[i], ny = cy + DIR_Y[i];
+            u32 neighbor = (u32)ny * width + (u32)nx;
+            if (m_Stamp[neighbor] != m_Generation) {
+                m_Stamp[neighbor] = m_Generation;
+                m_Reached++;
+                m_ReachedMin = glm::min(m_ReachedMin, glm::ivec2(nx, ny));
+                m_ReachedMax = glm::max(m_ReachedMax, glm::ivec2(nx, ny));
+            } else if (newCost >= m_Cost[neighbor]) {
+                continue;
+            }
+            m_Cost[neighbor] = newCost;
+            m_Dir[neighbor] = OPPOSITE[i];
+            m_RepairHeap.push_back({newCost, neighbor});
+            std::push_heap(m_RepairHeap.begin(), m_RepairHeap.end(), greater);
+        }
+    }
+    return true;
+}
+
+f32 FlowField::GetCost(i32 x, i32 y) const {
+    u32 i = Index(x, y);
+    return i == INVALID ? -1.0f : (f32)m_Cost[i] * 0.1f;
+}
+
+glm::ivec2 FlowField::GetDirection(i32 x, i32 y) const {
+    u32 i = Index(x, y);
+    if (i == INVALID || m_Dir[i] == NO_DIRECTION) return {0, 0};
+    return {DIR_X[m_Dir[i]], DIR_Y[m_Dir[i]]};
+}
+
+// ── FlowFieldCache ──────────────────────────────────────────
+
+void FlowFieldCache::RequestGoal(u64 key, const glm::ivec2& goal, f32 maxCost) {
+    Entry& entry = m_Fields[key];
+    entry.Goal = goal;
+    entry.MaxCost = maxCost;
+}
+
+void FlowFieldCache::Update() {
+    m_Recomputed = 0;
+    if (!m_Grid) return;
+
+    m_Repaired = 0;
+    m_Dirty.clear();
+    m_Repair.clear();
+    const NavGrid& grid = *m_Grid;
+    u32 revision = grid.GetRevision();
+    glm::ivec2 changedMin, changedMax;
+    for (auto& [key, entry] : m_Fields) {
+        const FlowField& field = entry.Field;
+        if (!entry.Computed || field.GetGoal() != entry.Goal || field.GetMaxCost() != entry.MaxCost) {
+            m_Dirty.push_back(&entry);
+            m_Repair.push_back(0);
+        } else if (field.GetGridRevision() != revision) {
+            // 只有可走性变了: 改动记录还在就局部修复
+            m_Dirty.push_back(&entry);
+            m_Repair.push_back(grid.GetChangedRegion(field.GetGridRevision(), changedMin, changedMax) ? 1 : 0);
+        }
+    }
+
+    // 每个目标一个任务；同一张 NavGrid 只读共享
+    JobSystem::ParallelForRange((u32)m_Dirty.size(), 1, [&](u32 begin, u32 end) {
+        glm::ivec2 regionMin, regionMax;
+        for (u32 i = begin; i < end; i++) {
+            Entry& entry = *m_Dirty[i];
+            if (m_Repair[i]) {
+                grid.GetChangedRegion(entry.Field.GetGridRevision(), regionMin, regionMax);
+                if (entry.Field.Repair(grid, regionMin, regionMax)) m_Repair[i] = 2;
+            } else {
+                entry.Field.Compute(grid, entry.Goal, entry.MaxCost);
+            }
+            entry.Computed = true;
+        }
+    });
+    for (u8 repair : m_Repair) {
+        if (repair == 0) m_Recomputed++;
+        else if (repair == 2) m_Repaired++;
+    }
+}
+
+const FlowField* FlowFieldCache::Get(u64 key) const {
+    auto it = m_Fields.find(key);
+    return it != m_Fields.end() && it->second.Computed ? &it->second.Field : nullptr;
+}
+
+} // namespace Engine
@@ -0,0 +1,346 @@
+#include "engine/ai/behavior_tree.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace Engine {
+
+// ── HPA* ────────────────────────────────────────────────────
+// 网格按 HPA_CLUSTER_SIZE 切成簇。相邻两簇的公共边界上，两侧都可走的连续段为一个入口:
+// 短于 6 格的入口取中点一对格子，更长的取两端各一对。入口格子即抽象节点，跨簇边代价为 1；
+// 同簇节点两两之间用限定在簇内的 Dijkstra 求代价，路径按方向编码缓存。
+// 查询时把起点/终点临时接入所在簇的节点，在抽象图上 A*，再拼接缓存路径；
+// 起终点在同簇或相邻簇时直接逐格 A*。
+
+static constexpr u32 INVALID_NODE = 0xFFFFFFFFu;
+static constexpr u32 MIN_DOUBLE_ENTRANCE = 6;
+
+u32 NavGrid::ClusterOf(i32 x, i32 y) const {
+    return (u32)y / HPA_CLUSTER_SIZE * m_HpaClustersX + (u32)x / HPA_CLUSTER_SIZE;
+}
+
+void NavGrid::ClusterBounds(u32 cluster, glm::ivec2& outMin, glm::ivec2& outMax) const {
+    u32 cx = cluster % m_HpaClustersX, cy = cluster / m_HpaClustersX;
+    outMin = {(i32)(cx * HPA_CLUSTER_SIZE), (i32)(cy * HPA_CLUSTER_SIZE)};
+    outMax = {(i32)std::min((cx + 1) * HPA_CLUSTER_SIZE, m_Width) - 1,
+              (i32)std::min((cy + 1) * HPA_CLUSTER_SIZE, m_Height) - 1};
+}
+
+u32 NavGrid::HpaNodeOf(u32 cell) const {
+    u32 cluster = ClusterOf((i32)(cell % m_Width), (i32)(cell / m_Width));
+    auto first = m_HpaNodes.begin() + m_HpaClusterFirst[cluster];
+    auto last = m_HpaNodes.begin() + m_HpaClusterFirst[cluster + 1];
+    auto it = std::lower_bound(first, last, cell, [](const HpaNode& n, u32 c) { return n.Cell < c; });
+    return it != last && it->Cell == cell ? (u32)(it - m_HpaNodes.begin()) : INVALID_NODE;
+}
+
+void NavGrid::RepairHierarchy(const glm::ivec2& changedMin, const glm::ivec2& changedMax) {
+    if (m_HpaClusterFirst.empty()) {
+        BuildHierarchy();
+        return;
+    }
+
+    // 改动影响所在簇的簇内路径；贴着簇边界的改动还会改变另一侧簇的入口 → 外扩 1 格涉及的簇重算
+    const u32 C = HPA_CLUSTER_SIZE;
+    glm::ivec2 lo = glm::max(changedMin - 1, glm::ivec2(0));
+    glm::ivec2 hi = glm::min(changedMax + 1, glm::ivec2((i32)m_Width - 1, (i32)m_Height - 1));
+    std::vector<u8> reuse((size_t)m_HpaClustersX * m_HpaClustersY, 1);
+    for (u32 cy = (u32)lo.y / C; cy <= (u32)hi.y / C; cy++) {
+        for (u32 cx = (u32)lo.x / C; cx <= (u32)hi.x / C; cx++) reuse[cy * m_HpaClustersX + cx] = 0;
+    }
+    BuildHierarchy(&reuse);
+}
+
+void NavGrid::BuildHierarchy(const std::vector<u8>* reuse) {
+    const u32 C = HPA_CLUSTER_SIZE;
+    const u32 width = m_Width;
+
+    // 沿用簇内边时先把旧的抽象图移出来
+    std::vector<HpaNode> oldNodes;
+    std::vector<u32> oldFirst;
+    std::vector<HpaEdge> oldEdges;
+    std::vector<u8> oldSteps;
+    if (reuse) {
+        oldNodes.swap(m_HpaNodes);
+        oldFirst.swap(m_HpaClusterFirst);
+        oldEdges.swap(m_HpaEdges);
+        oldSteps.swap(m_HpaSteps);
+    }
+
+    m_HpaClustersX = (m_Width + C - 1) / C;
+    m_HpaClustersY = (m_Height + C - 1) / C;
+    const u32 clusterCount = m_HpaClustersX * m_HpaClustersY;
+
+    // 1. 入口: 每个入口记录边界两侧的一对格子
+    std::vector<std::pair<u32, u32>> transitions;
+    auto scanBorder = [&](u32 fixed, u32 from, u32 to, bool vertical) {
+        // vertical: 边界在 x = fixed | fixed+1 之间，沿 y 扫描；否则在 y = fixed | fixed+1 之间
+        auto cellA = [&](u32 t) { return vertical ? t * width + fixed : fixed * width + t; };
+        auto cellB = [&](u32 t) { return vertical ? t * width + fixed + 1 : (fixed + 1) * width + t; };
+        auto addTransition = [&](u32 t) { transitions.push_back({cellA(t), cellB(t)}); };
+
+        u32 runStart = 0;
+        bool inRun = false;
+        for (u32 t = from; t <= to + 1; t++) {
+            bool open = t <= to && m_Walkable[cellA(t)] && m_Walkable[cellB(t)];
+            if (open && !inRun) {
+                runStart = t;
+                inRun = true;
+            } else if (!open && inRun) {
+                u32 runEnd = t - 1;
+                if (runEnd - runStart + 1 < MIN_DOUBLE_ENTRANCE) {
+                    addTransition((runStart + runEnd) / 2);
+                } else {
+                    addTransition(runStart);
+                    addTransition(runEnd);
+                }
+                inRun = false;
+            }
+        }
+    };
+    for (u32 cy = 0; cy < m_HpaClustersY; cy++) {
+        u32 y0 = cy * C, y1 = std::min(y0 + C, m_Height) - 1;
+        for (u32 cx = 0; cx + 1 < m_HpaClustersX; cx++) scanBorder((cx + 1) * C - 1, y0, y1, true);
+    }
+    for (u32 cx = 0; cx < m_HpaClustersX; cx++) {
+        u32 x0 = cx * C, x1 = std::min(x0 + C, m_Width) - 1;
+        for (u32 cy = 0; cy + 1 < m_HpaClustersY; cy++) scanBorder((cy + 1) * C - 1, x0, x1, false);
+    }
+
+    // 2. 抽象节点: 去重后按 (簇, 格子) 排序，同簇节点连续存放
+    std::vector<u64> keys;
+    keys.reserve(transitions.size() * 2);
+    auto keyOf = [&](u32 cell) { return ((u64)ClusterOf((i32)(cell % width), (i32)(cell / width)) << 32) | cell; };
+    for (const auto& [a, b] : transitions) {
+        keys.push_back(keyOf(a));
+        keys.push_back(keyOf(b));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    m_HpaNodes.resize(keys.size());
+    m_HpaClusterFirst.assign(clusterCount + 1, 0);
+    for (u32 i = 0; i < (u32)keys.size(); i++) {
+        m_HpaNodes[i] = {(u32)keys[i], (u32)(keys[i] >> 32), 0, 0};
+        m_HpaClusterFirst[m_HpaNodes[i].Cluster + 1]++;
+    }
+    for (u32 c = 0; c < clusterCount; c++) m_HpaClusterFirst[c + 1] += m_HpaClusterFirst[c];
+
+    // 3. 边: 跨簇一步 + 簇内 Dijkstra (每个节点一次，得到到同簇其余节点的代价与路径)
+    std::vector<std::pair<u32, HpaEdge>> edges;
+    for (const auto& [a, b] : transitions) {
+        u32 nodeA = HpaNodeOf(a), nodeB = HpaNodeOf(b);
+        edges.push_back({nodeA, {nodeB, 1.0f, 0, 0}});
+        edges.push_back({nodeB, {nodeA, 1.0f, 0, 0}});
+    }
+
+    // 簇内可走性和入口都没变的簇: 原样搬运旧的簇内边与缓存路径 (节点下标平移)
+    auto reuseCluster = [&](u32 c) {
+        u32 oldBegin = oldFirst[c], oldEnd = oldFirst[c + 1];
+        u32 newBegin = m_HpaClusterFirst[c];
+        if (oldEnd - oldBegin != m_HpaClusterFirst[c + 1] - newBegin) return false;
+        for (u32 i = oldBegin; i < oldEnd; i++) {
+            if (oldNodes[i].Cell != m_HpaNodes[i - oldBegin + newBegin].Cell) return false;
+        }
+        for (u32 i = oldBegin; i < oldEnd; i++) {
+            const HpaNode& node = oldNodes[i];
+            for (u32 e = node.FirstEdge; e < node.FirstEdge + node.EdgeCount; e++) {
+                const HpaEdge& old = oldEdges[e];
+                if (old.PathLength == 0) continue;   // 跨簇边已重新生成
+                HpaEdge edge = {old.To - oldBegin + newBegin, old.Cost, (u32)m_HpaSteps.size(), old.PathLength};
+                m_HpaSteps.insert(m_HpaSteps.end(), oldSteps.begin() + old.PathOffset,
+                                  oldSteps.begin() + old.PathOffset + old.PathLength);
+                edges.push_back({i - oldBegin + newBegin, edge});
+            }
+        }
+        return true;
+    };
+
+    NavSearchState& search = m_Search;   // 网格自己的工作缓冲 (改动可走性期间本来就不能查询)
+    std::vector<u8> steps;
+    for (u32 c = 0; c < clusterCount; c++) {
+        if (reuse && (*reuse)[c] && reuseCluster(c)) continue;
+        glm::ivec2 bmin, bmax;
+        ClusterBounds(c, bmin, bmax);
+        for (u32 i = m_HpaClusterFirst[c]; i < m_HpaClusterFirst[c + 1]; i++) {
+            u32 from = m_HpaNodes[i].Cell;
+            SearchCells(from, NO_GOAL, bmin, bmax, search);
+
+            for (u32 j = m_HpaClusterFirst[c]; j < m_HpaClusterFirst[c + 1]; j++) {
+                u32 to = m_HpaNodes[j].Cell;
+                const NavSearchState::Node& n = search.m_Nodes[to];
+                if (j == i || n.Stamp != search.m_Generation || n.HeapPos != NavSearchState::CLOSED) continue;
+
+                steps.clear();
+                for (u32 cell = to; cell != from; cell = search.m_Nodes[cell].Parent) {
+                    u32 parent = search.m_Nodes[cell].Parent;
+                    steps.push_back((u8)DirIndex((i32)(cell % width) - (i32)(parent % width),
+                                                 (i32)(cell / width) - (i32)(parent / width)));
+                }
+                HpaEdge edge = {j, n.G, (u32)m_HpaSteps.size(), (u32)steps.size()};
+                m_HpaSteps.insert(m_HpaSteps.end(), steps.rbegin(), steps.rend());
+                edges.push_back({i, edge});
+            }
+        }
+    }
+
+    // 按起点节点计数排序 (同一节点的边保持生成顺序)
+    for (const auto& [from, edge] : edges) m_HpaNodes[from].EdgeCount++;
+    u32 offset = 0;
+    for (HpaNode& node : m_HpaNodes) {
+        node.FirstEdge = offset;
+        offset += node.EdgeCount;
+        node.EdgeCount = 0;
+    }
+    m_HpaEdges.resize(edges.size());
+    for (const auto& [from, edge] : edges) {
+        HpaNode& node = m_HpaNodes[from];
+        m_HpaEdges[node.FirstEdge + node.EdgeCount++] = edge;
+    }
+
+    if (!reuse) {
+        LOG_INFO("[NavGrid] HPA* 抽象图: %u 簇, %zu 节点, %zu 边, 缓存路径 %zu 步",
+                 clusterCount, m_HpaNodes.size(), m_HpaEdges.size(), m_HpaSteps.size());
+    }
+}
+
+bool NavGrid::FindPathHierarchical(const glm::ivec2& start, const glm::ivec2& goal,
+                                   std::vector<glm::ivec2>& outCells, NavSearchState& state) const {
+    const u32 width = m_Width;
+    const u32 startIdx = (u32)start.y * width + (u32)start.x;
+    const u32 goalIdx = (u32)goal.y * width + (u32)goal.x;
+    const u32 startCluster = ClusterOf(start.x, start.y);
+    const u32 goalCluster = ClusterOf(goal.x, goal.y);
+
+    // 同簇或相邻簇: 直接 A* (短路径逐格搜索更便宜，也避免绕经入口)
+    i32 clusterDx = (i32)(startCluster % m_HpaClustersX) - (i32)(goalCluster % m_HpaClustersX);
+    i32 clusterDy = (i32)(startCluster / m_HpaClustersX) - (i32)(goalCluster / m_HpaClustersX);
+    if (std::abs(clusterDx) <= 1 && std::abs(clusterDy) <= 1) return FindPathAStar(start, goal, outCells, state);
+
+    u32 expanded = 0;
+    glm::ivec2 startMin, startMax, goalMin, goalMax;
+    ClusterBounds(startCluster, startMin, startMax);
+    ClusterBounds(goalCluster, goalMin, goalMax);
+
+    // 1. 起点/终点到所在簇各节点的簇内代价
+    auto linkCluster = [&](u32 cell, u32 cluster, const glm::ivec2& bmin, const glm::ivec2& bmax,
+                           std::vector<std::pair<u32, f32>>& links) {
+        links.clear();
+        SearchCells(cell, NO_GOAL, bmin, bmax, state);
+        expanded += state.m_Expanded;
+        for (u32 i = m_HpaClusterFirst[cluster]; i < m_HpaClusterFirst[cluster + 1]; i++) {
+            const NavSearchState::Node& n = state.m_Nodes[m_HpaNodes[i].Cell];
+            if (n.Stamp == state.m_Generation && n.HeapPos == NavSearchState::CLOSED) links.push_back({i, n.G});
+        }
+    };
+    linkCluster(startIdx, startCluster, startMin, startMax, state.m_StartLinks);
+    linkCluster(goalIdx, goalCluster, goalMin, goalMax, state.m_GoalLinks);
+    if (state.m_StartLinks.empty() || state.m_GoalLinks.empty()) {
+        state.m_Expanded = expanded;
+        return false;
+    }
+
+    // 2. 抽象图 A*: 节点 0..N-1 为入口，N 为起点，N+1 为终点
+    const u32 nodeCount = (u32)m_HpaNodes.size();
+    const u32 startNode = nodeCount, goalNode = nodeCount + 1;
+    auto cellOf = [&](u32 node) {
+        u32 cell = node == startNode ? startIdx : node == goalNode ? goalIdx : m_HpaNodes[node].Cell;
+        return glm::ivec2((i32)(cell % width), (i32)(cell / width));
+    };
+
+    state.Begin(nodeCount + 2);
+    NavSearchState::Node& root = state.Touch(startNode);
+    root.G = 0.0f;
+    root.Parent = startNode;
+    state.HeapPush(startNode, Heuristic(start.x, start.y, goal.x, goal.y), 0.0f);
+
+    bool found = false;
+    while (state.m_HeapSize > 0) {
+        u32 current = state.HeapPop();
+        state.m_Expanded++;
+        if (current == goalNode) {
+            found = true;
+            break;
+        }
+
+        f32 currentG = state.m_Nodes[current].G;
+        auto relax = [&](u32 next, f32 cost) {
+            NavSearchState::Node& n = state.Touch(next);
+            if (n.HeapPos == NavSearchState::CLOSED) return;
+            f32 newG = currentG + cost;
+            if (newG >= n.G) return;
+            bool inHeap = n.HeapPos != NavSearchState::NOT_IN_HEAP;
+            n.G = newG;
+            n.Parent = current;
+            glm::ivec2 c = cellOf(next);
+            f32 f = newG + Heuristic(c.x, c.y, goal.x, goal.y);
+            if (inHeap) state.HeapDecrease(next, f, newG);
+            else        state.HeapPush(next, f, newG);
+        };
+
+        if (current == startNode) {
+            for (const auto& [node, cost] : state.m_StartLinks) relax(node, cost);
+            continue;
+        }
+        const HpaNode& node = m_HpaNodes[current];
+        for (u32 e = node.FirstEdge; e < node.FirstEdge + node.EdgeCount; e++) {
+            relax(m_HpaEdges[e].To, m_HpaEdges[e].Cost);
+        }
+        if (node.Cluster == goalCluster) {
+            for (const auto& [link, cost] : state.m_GoalLinks) {
+                if (link == current) relax(goalNode, cost);
+            }
+        }
+    }
+    expanded += state.m_Expanded;
+
+    if (!found) {
+        state.m_Expanded = expanded;
+        return false;
+    }
+
+    std::vector<u32>& abstractPath = state.m_AbstractPath;
+    abstractPath.clear();
+    for (u32 node = state.m_Nodes[goalNode].Parent; node != startNode; node = state.m_Nodes[node].Parent) {
+        abstractPath.push_back(node);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    // 3. 细化: 起点段与终点段在簇内重新求路径，中间拼接缓存路径
+    u32 firstCell = m_HpaNodes[abstractPath.front()].Cell;
+    SearchCells(startIdx, firstCell, startMin, startMax, state);
+    expanded += state.m_Expanded;
+    AppendParentChain(startIdx, firstCell, state, outCells, true);
+
+    for (size_t k = 0; k + 1 < abstractPath.size(); k++) {
+        const HpaNode& from = m_HpaNodes[abstractPath[k]];
+        const HpaEdge* edge = nullptr;
+        for (u32 e = from.FirstEdge; e < from.FirstEdge + from.EdgeCount; e++) {
+            if (m_HpaEdges[e].To == abstractPath[k + 1]) {
+                edge = &m_HpaEdges[e];
+                break;
+            }
+        }
+        glm::ivec2 cell = cellOf(abstractPath[k]);
+        if (edge->PathLength == 0) {
+            outCells.push_back(cellOf(edge->To));
+            continue;
+        }
+        for (u32 s = 0; s < edge->PathLength; s++) {
+            u8 dir = m_HpaSteps[edge->PathOffset + s];
+            cell += glm::ivec2(DIR_X[dir], DIR_Y[dir]);
+            outCells.push_back(cell);
+        }
+    }
+
+    u32 lastCell = m_HpaNodes[abstractPath.back()].Cell;
+    SearchCells(lastCell, goalIdx, goalMin, goalMax, state);
+    expanded += state.m_Expanded;
+    AppendParentChain(lastCell, goalIdx, state, outCells, false);
+
+    state.m_Expanded = expanded;
+    return true;
+}
+
+} // namespace Engine
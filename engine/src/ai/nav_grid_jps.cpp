@@ -0,0 +1,230 @@
+#include "engine/ai/behavior_tree.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+// ── JPS+ ────────────────────────────────────────────────────
+// 不切角规则下的跳点:
+//   正交移动 (dx, 0) 到达 (x, y)，若侧面 (x, y±1) 可走而身后 (x-dx, y±1) 不可走，
+//   则 (x, y±1) 只能经由 (x, y) 到达 → (x, y) 为跳点 (纵向同理)
+//   对角移动到达的格子，若沿两个分量方向的正交跳跃能找到跳点，则它本身是跳点
+// 预计算后查询只需查表，不再逐格扫描。
+
+static constexpr u32 DIR_COUNT = 8;
+
+bool NavGrid::FindPathJumpPoint(const glm::ivec2& start, const glm::ivec2& goal,
+                                std::vector<glm::ivec2>& outCells, NavSearchState& state) const {
+    const u32 width = m_Width;
+    const u32 startIdx = (u32)start.y * width + (u32)start.x;
+    const u32 goalIdx = (u32)goal.y * width + (u32)goal.x;
+
+    state.Begin(width * m_Height);
+    NavSearchState::Node& startNode = state.Touch(startIdx);
+    startNode.G = 0.0f;
+    startNode.Parent = startIdx;
+    state.HeapPush(startIdx, Heuristic(start.x, start.y, goal.x, goal.y), 0.0f);
+
+    while (state.m_HeapSize > 0) {
+        u32 current = state.HeapPop();
+        state.m_Expanded++;
+
+        if (current == goalIdx) {
+            // 跳点之间是纯正交或纯对角的直线，逐格展开
+            size_t first = outCells.size();
+            for (u32 node = goalIdx; node != startIdx;) {
+                u32 parent = state.m_Nodes[node].Parent;
+                i32 x = (i32)(node % width), y = (i32)(node / width);
+                i32 px = (i32)(parent % width), py = (i32)(parent / width);
+                i32 sx = (px > x) - (px < x), sy = (py > y) - (py < y);
+                for (; x != px || y != py; x += sx, y += sy) outCells.push_back({x, y});
+                node = parent;
+            }
+            outCells.push_back(start);
+            std::reverse(outCells.begin() + (std::ptrdiff_t)first, outCells.end());
+            return true;
+        }
+
+        i32 cx = (i32)(current % width);
+        i32 cy = (i32)(current / width);
+        const NavSearchState::Node& cur = state.m_Nodes[current];
+        f32 currentG = cur.G;
+
+        // 按到达方向裁剪需要尝试的方向 (起点尝试全部 8 个)
+        u32 dirs[DIR_COUNT];
+        u32 dirCount = 0;
+        if (current == startIdx) {
+            for (u32 d = 0; d < DIR_COUNT; d++) dirs[dirCount++] = d;
+        } else {
+            i32 px = (i32)(cur.Parent % width), py = (i32)(cur.Parent / width);
+            i32 dx = (cx > px) - (cx < px), dy = (cy > py) - (cy < py);
+            if (dx != 0 && dy != 0) {
+                dirs[dirCount++] = DirIndex(dx, 0);
+                dirs[dirCount++] = DirIndex(0, dy);
+                dirs[dirCount++] = DirIndex(dx, dy);
+            } else if (dx != 0) {
+                dirs[dirCount++] = DirIndex(dx, 0);
+                dirs[dirCount++] = DirIndex(0, -1);
+                dirs[dirCount++] = DirIndex(0, 1);
+                dirs[dirCount++] = DirIndex(dx, -1);
+                dirs[dirCount++] = DirIndex(dx, 1);
+            } else {
+                dirs[dirCount++] = DirIndex(0, dy);
+                dirs[dirCount++] = DirIndex(-1, 0);
+                dirs[dirCount++] = DirIndex(1, 0);
+                dirs[dirCount++] = DirIndex(-1, dy);
+                dirs[dirCount++] = DirIndex(1, dy);
+            }
+        }
+
+        const i16* jumps = &m_JumpDist[(size_t)current * DIR_COUNT];
+        i32 toGoalX = goal.x - cx, toGoalY = goal.y - cy;
+
+        for (u32 k = 0; k < dirCount; k++) {
+            u32 d = dirs[k];
+            i32 dx = DIR_X[d], dy = DIR_Y[d];
+            i32 jump = jumps[d];
+            i32 reach = jump > 0 ? jump : -jump;   // 这个方向上能直走的步数
+            if (reach == 0) continue;
+
+            // 终点比跳点/墙更近时直接把终点 (或与终点对齐的格子) 作为后继
+            i32 steps = 0;
+            if (d < 4) {
+                i32 along = dx != 0 ? toGoalX * dx : toGoalY * dy;
+                i32 across = dx != 0 ? toGoalY : toGoalX;
+                if (across == 0 && along > 0 && along <= reach) steps = along;
+            } else if (toGoalX * dx > 0 && toGoalY * dy > 0) {
+                i32 align = std::min(toGoalX * dx, toGoalY * dy);
+                if (align <= reach) steps = align;
+            }
+            if (steps == 0) {
+                if (jump <= 0) continue;
+                steps = jump;
+            }
+
+            i32 nx = cx + dx * steps, ny = cy + dy * steps;
+            u32 neighbor = (u32)ny * width + (u32)nx;
+            NavSearchState::Node& n = state.Touch(neighbor);
+            if (n.HeapPos == NavSearchState::CLOSED) continue;
+
+            f32 newG = currentG + (f32)steps * (d < 4 ? 1.0f : 1.414f);
+            if (newG >= n.G) continue;
+
+            bool inHeap = n.HeapPos != NavSearchState::NOT_IN_HEAP;
+            n.G = newG;
+            n.Parent = current;
+            f32 f = newG + Heuristic(nx, ny, goal.x, goal.y);
+            if (inHeap) state.HeapDecrease(neighbor, f, newG);
+            else        state.HeapPush(neighbor, f, newG);
+        }
+    }
+
+    return false;
+}
+
+inline i16 NavGrid::ComputeJumpDist(i32 x, i32 y, u32 d) const {
+    const i32 w = (i32)m_Width, h = (i32)m_Height;
+    auto walkable = [&](i32 px, i32 py) {
+        return px >= 0 && px < w && py >= 0 && py < h && m_Walkable[(u32)py * m_Width + (u32)px];
+    };
+    auto dist = [&](i32 px, i32 py, u32 dir) {
+        return m_JumpDist[((size_t)py * m_Width + (u32)px) * DIR_COUNT + dir];
+    };
+
+    const i32 dx = DIR_X[d], dy = DIR_Y[d];
+    const i32 nx = x + dx, ny = y + dy;
+    if (!walkable(x, y) || !walkable(nx, ny)) return 0;
+
+    // 下一格是否为跳点
+    bool nextIsJump;
+    if (dx == 0 || dy == 0) {
+        // 正交: 沿方向进入下一格时出现被迫邻居
+        if (dx != 0) {
+            nextIsJump = (walkable(nx, ny - 1) && !walkable(x, ny - 1)) ||
+                         (walkable(nx, ny + 1) && !walkable(x, ny + 1));
+        } else {
+            nextIsJump = (walkable(nx - 1, ny) && !walkable(nx - 1, y)) ||
+                         (walkable(nx + 1, ny) && !walkable(nx + 1, y));
+        }
+    } else {
+        // 对角: 不能切角；下一格沿两个分量方向的正交跳跃能找到跳点
+        if (!walkable(nx, y) || !walkable(x, ny)) return 0;
+        nextIsJump = dist(nx, ny, DirIndex(dx, 0)) > 0 || dist(nx, ny, DirIndex(0, dy)) > 0;
+    }
+
+    // 下一格是跳点记 1，否则在下一格的结果上同号加一步
+    if (nextIsJump) return 1;
+    i16 next = dist(nx, ny, d);
+    return next > 0 ? (i16)(next + 1) : (i16)(next - 1);
+}
+
+void NavGrid::BuildJumpDistances() {
+    if (m_Width > 0x7FFF || m_Height > 0x7FFF) {
+        LOG_WARN("[NavGrid] %ux%u 超出 JPS+ 跳点距离范围，退回 A*", m_Width, m_Height);
+        m_Mode = NavSearchMode::AStar;
+        return;
+    }
+
+    const i32 w = (i32)m_Width, h = (i32)m_Height;
+    m_JumpDist.assign((size_t)m_Width * m_Height * DIR_COUNT, 0);
+
+    // 逆着方向扫描，下一格总是先算好；对角依赖下一格的正交结果，放在正交之后
+    for (u32 d = 0; d < DIR_COUNT; d++) {
+        i32 dx = DIR_X[d], dy = DIR_Y[d];
+        for (i32 i = 0; i < h; i++) {
+            i32 y = dy > 0 ? h - 1 - i : i;
+            for (i32 j = 0; j < w; j++) {
+                i32 x = dx > 0 ? w - 1 - j : j;
+                u32 cell = (u32)y * m_Width + (u32)x;
+                if (m_Walkable[cell]) m_JumpDist[(size_t)cell * DIR_COUNT + d] = ComputeJumpDist(x, y, d);
+            }
+        }
+    }
+}
+
+void NavGrid::RepairJumpDistances(const glm::ivec2& changedMin, const glm::ivec2& changedMax) {
+    if (m_JumpDist.empty()) {
+        BuildJumpDistances();
+        return;
+    }
+
+    // 一格的值只读取自身周围 1 格的可走性和下一格的值 → 输入变化的格子都在改动矩形外扩 1 格内。
+    // 从这些格子逆着方向回溯重算: 某格的新值与旧值相同时，它身后的格子 (只依赖它) 也不会变
+    const i32 w = (i32)m_Width, h = (i32)m_Height;
+    const glm::ivec2 lo = glm::max(changedMin - 1, glm::ivec2(0));
+    const glm::ivec2 hi = glm::min(changedMax + 1, glm::ivec2(w - 1, h - 1));
+
+    // 正交方向上"是否为跳点" (值 > 0) 发生变化的格子: 对角方向的值依赖它
+    std::vector<std::pair<u32, u32>> flipped;
+    auto walkBack = [&](i32 x, i32 y, u32 d) {
+        for (; x >= 0 && x < w && y >= 0 && y < h; x -= DIR_X[d], y -= DIR_Y[d]) {
+            i16& slot = m_JumpDist[((size_t)y * m_Width + (u32)x) * DIR_COUNT + d];
+            i16 value = ComputeJumpDist(x, y, d);
+            if (value == slot) break;
+            if (d < 4 && (value > 0) != (slot > 0)) flipped.push_back({(u32)y * m_Width + (u32)x, d});
+            slot = value;
+        }
+    };
+
+    for (u32 d = 0; d < DIR_COUNT; d++) {
+        // 对角之前先修完正交，并补上正交跳点变化引起的对角起点
+        if (d == 4) {
+            for (const auto& [cell, o] : flipped) {
+                i32 x = (i32)(cell % m_Width), y = (i32)(cell / m_Width);
+                for (u32 diag = 4; diag < DIR_COUNT; diag++) {
+                    bool uses = o < 2 ? DIR_X[diag] == DIR_X[o] : DIR_Y[diag] == DIR_Y[o];
+                    if (uses) walkBack(x - DIR_X[diag], y - DIR_Y[diag], diag);
+                }
+            }
+        }
+        i32 dx = DIR_X[d], dy = DIR_Y[d];
+        for (i32 i = 0; i <= hi.y - lo.y; i++) {
+            i32 y = dy > 0 ? hi.y - i : lo.y + i;
+            for (i32 j = 0; j <= hi.x - lo.x; j++) walkBack(dx > 0 ? hi.x - j : lo.x + j, y, d);
+        }
+    }
+}
+
+} // namespace Engine
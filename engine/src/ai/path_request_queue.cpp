@@ -0,0 +1,147 @@
+#include "engine/ai/path_request_queue.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace Engine {
+
+PathRequestQueue::PathRequestQueue()
+    : m_Completion(CreateRef<Completion>()) {}
+
+void PathRequestQueue::SetNavGrid(const NavGrid* grid) {
+    if (grid == m_Grid) return;
+    m_Grid = grid;
+    m_Snapshot.reset();
+    m_SpareSnapshot.reset();
+}
+
+PathHandle PathRequestQueue::Submit(u64 owner, const glm::ivec2& start, const glm::ivec2& goal, f32 priority) {
+    PathHandle handle = m_NextHandle++;
+    m_Current[owner] = handle;   // 旧请求作废
+    m_Queue.push_back({handle, owner, start, goal, priority});
+    std::push_heap(m_Queue.begin(), m_Queue.end(), HeapLess);
+    return handle;
+}
+
+void PathRequestQueue::Cancel(u64 owner) {
+    m_Current.erase(owner);
+}
+
+bool PathRequestQueue::IsCurrent(u64 owner, PathHandle handle) const {
+    auto it = m_Current.find(owner);
+    return it != m_Current.end() && it->second == handle;
+}
+
+u32 PathRequestQueue::GetInFlightCount() const {
+    return m_Completion->InFlight.load();
+}
+
+void PathRequestQueue::WaitIdle() const {
+    while (m_Completion->InFlight.load() > 0) std::this_thread::yield();
+}
+
+void PathRequestQueue::RefreshSnapshot() {
+    if (!m_Grid) {
+        m_Snapshot.reset();
+        m_SpareSnapshot.reset();
+        return;
+    }
+    if (m_Snapshot && m_SnapshotRevision == m_Grid->GetRevision() &&
+        m_Snapshot->GetSearchMode() == m_Grid->GetSearchMode()) {
+        return;
+    }
+
+    // 当前快照还有任务在读: 换到备用快照；两份都在用时新建
+    if (m_Snapshot && m_Snapshot.use_count() > 1) {
+        std::swap(m_Snapshot, m_SpareSnapshot);
+        std::swap(m_SnapshotRevision, m_SpareRevision);
+        if (m_Snapshot && m_Snapshot.use_count() > 1) m_Snapshot.reset();
+    }
+
+    glm::ivec2 changedMin, changedMax;
+    if (m_Snapshot && m_Snapshot->GetSearchMode() == m_Grid->GetSearchMode() &&
+        m_Grid->GetChangedRegion(m_SnapshotRevision, changedMin, changedMax)) {
+        // 没有任务在读这份快照: 只同步改动区域，代价与改动大小成正比
+        for (i32 y = changedMin.y; y <= changedMax.y; y++) {
+            for (i32 x = changedMin.x; x <= changedMax.x; x++) m_Snapshot->SetWalkable(x, y, m_Grid->IsWalkable(x, y));
+        }
+    } else {
+        // 只复制可走性 (不带原网格的搜索缓冲与加速数据)，加速数据在快照上重建
+        if (!m_Snapshot) m_Snapshot = CreateRef<NavGrid>();
+        m_Snapshot->CopyWalkability(*m_Grid);
+    }
+    m_Snapshot->UpdateSearchData();
+    m_SnapshotRevision = m_Grid->GetRevision();
+}
+
+void PathRequestQueue::Update() {
+    RefreshSnapshot();
+    if (!m_Snapshot) return;
+
+    using Clock = std::chrono::steady_clock;
+    const bool async = JobSystem::IsActive();
+    const auto begin = Clock::now();
+
+    u32 dispatched = 0;
+    while (!m_Queue.empty() && dispatched < m_Config.MaxDispatchPerFrame) {
+        if (async && m_Completion->InFlight.load() >= m_Config.MaxInFlight) break;
+        if (!async && dispatched > 0) {
+            f32 elapsedMs = std::chrono::duration<f32, std::milli>(Clock::now() - begin).count();
+            if (elapsedMs >= m_Config.SyncBudgetMs) break;
+        }
+
+        std::pop_heap(m_Queue.begin(), m_Queue.end(), HeapLess);
+        Request request = m_Queue.back();
+        m_Queue.pop_back();
+        if (!IsCurrent(request.Owner, request.Handle)) continue;   // 已作废，不占预算
+        dispatched++;
+
+        if (!async) {
+            PathResult result;
+            result.Handle = request.Handle;
+            result.Owner = request.Owner;
+            result.Found = m_Snapshot->FindPath(request.Start, request.Goal, result.Cells, m_SyncState);
+            result.GridRevision = m_SnapshotRevision;
+            m_Ready.push_back(std::move(result));
+            continue;
+        }
+
+        m_Completion->InFlight++;
+        Ref<const NavGrid> grid = m_Snapshot;
+        JobSystem::Submit([grid, revision = m_SnapshotRevision, completion = m_Completion, request]() {
+            thread_local NavSearchState state;   // 每个工作线程一份搜索缓冲
+            PathResult result;
+            result.Handle = request.Handle;
+            result.Owner = request.Owner;
+            result.Found = grid->FindPath(request.Start, request.Goal, result.Cells, state);
+            result.GridRevision = revision;
+            {
+                std::lock_guard<std::mutex> lock(completion->Mutex);
+                completion->Results.push_back(std::move(result));
+            }
+            completion->InFlight--;
+        });
+    }
+}
+
+bool PathRequestQueue::PopResult(PathResult& out) {
+    for (;;) {
+        if (m_ReadyIndex >= m_Ready.size()) {
+            m_Ready.clear();
+            m_ReadyIndex = 0;
+            std::lock_guard<std::mutex> lock(m_Completion->Mutex);
+            if (m_Completion->Results.empty()) return false;
+            m_Ready.swap(m_Completion->Results);
+        }
+
+        PathResult& result = m_Ready[m_ReadyIndex++];
+        if (!IsCurrent(result.Owner, result.Handle)) continue;   // 期间被取消或重新请求
+        m_Current.erase(result.Owner);
+        out = std::move(result);
+        return true;
+    }
+}
+
+} // namespace Engine
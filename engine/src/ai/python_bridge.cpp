@@ -61,7 +61,7 @@ PYBIND11_EMBEDDED_MODULE(engine, m) {
              py::arg("width"), py::arg("height"), py::arg("cell_size") = 1.0f)
         .def("set_walkable", &NavGrid::SetWalkable)
         .def("is_walkable", &NavGrid::IsWalkable)
-        .def("find_path", &NavGrid::FindPath);
+        .def("find_path", py::overload_cast<const glm::vec3&, const glm::vec3&>(&NavGrid::FindPath));
 }
 
 // ── Python 桥接实现 ─────────────────────────────────────────
@@ -92,6 +92,7 @@ void PythonBridge::Shutdown() {
 
 bool PythonBridge::ExecuteFile(const char* filepath) {
     if (!s_Initialized) return false;
+    py::gil_scoped_acquire gil;   // AI 工作线程运行时主线程不常驻 GIL
     try {
         py::eval_file(filepath);
         return true;
@@ -103,6 +104,7 @@ bool PythonBridge::ExecuteFile(const char* filepath) {
 
 bool PythonBridge::ExecuteString(const char* code) {
     if (!s_Initialized) return false;
+    py::gil_scoped_acquire gil;
     try {
         py::exec(code);
         return true;
@@ -114,6 +116,7 @@ bool PythonBridge::ExecuteString(const char* code) {
 
 bool PythonBridge::CallFunction(const char* moduleName, const char* funcName) {
     if (!s_Initialized) return false;
+    py::gil_scoped_acquire gil;
     try {
         auto mod = py::module_::import(moduleName);
         mod.attr(funcName)();
@@ -128,6 +131,7 @@ bool PythonBridge::IsInitialized() { return s_Initialized; }
 
 void PythonBridge::Tick(f32 dt) {
     if (!s_Initialized) return;
+    py::gil_scoped_acquire gil;
     try {
         auto mod = py::module_::import("ai_main");
         if (py::hasattr(mod, "update")) {
@@ -1,13 +1,22 @@
 #ifdef ENGINE_HAS_PYTHON
 
 #include "engine/ai/python_engine.h"
+#include "engine/ai/ai_batch.h"
+#include "engine/ai/ai_scheduler.h"
+#include "engine/ai/spatial_index.h"
 #include "engine/core/scene.h"
 #include "engine/core/ecs.h"
+#include "engine/debug/profiler.h"
 
 #include <Python.h>
 #include <sstream>
 #include <cmath>
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <mutex>
+#include <thread>
 
 namespace Engine {
 namespace AI {
@@ -19,6 +28,77 @@ namespace AI {
 bool PythonEngine::s_Initialized = false;
 std::string PythonEngine::s_LastError;
 
+namespace {
+
+/// AI 工作线程与主线程共用的锁 (同时保护 PythonEngine::s_LastError)；持锁期间不调用 Python
+std::mutex s_WorkerMutex;
+
+/// 作用域内持有 GIL。AI 工作线程运行时主线程不再常驻 GIL，每次调用 Python 都要先取得
+class GILGuard {
+public:
+    GILGuard() : m_State(PyGILState_Ensure()) {}
+    ~GILGuard() { PyGILState_Release(m_State); }
+    GILGuard(const GILGuard&) = delete;
+    GILGuard& operator=(const GILGuard&) = delete;
+private:
+    PyGILState_STATE m_State;
+};
+
+// 模块名 → 模块对象，"模块.函数" → 可调用对象；nullptr 表示导入失败/不存在 (持有 GIL 时访问)
+std::unordered_map<std::string, PyObject*> s_ModuleCache;
+std::unordered_map<std::string, PyObject*> s_FunctionCache;
+// 模块 → 是否有 update_ai_batch (主线程采集时查，不用取 GIL)
+std::unordered_map<std::string, bool> s_BatchCapable;
+
+PyObject* FindModule(const std::string& module) {
+    auto it = s_ModuleCache.find(module);
+    if (it != s_ModuleCache.end()) return it->second;
+
+    PyObject* pModuleName = PyUnicode_FromString(module.c_str());
+    PyObject* pModule = PyImport_Import(pModuleName);
+    Py_DECREF(pModuleName);
+    if (!pModule) {
+        PyErr_Print();
+        LOG_ERROR("[AI] 无法导入: %s", module.c_str());
+    }
+    s_ModuleCache.emplace(module, pModule);
+    return pModule;
+}
+
+PyObject* FindFunction(const std::string& module, const std::string& func) {
+    std::string key = module + "." + func;
+    auto it = s_FunctionCache.find(key);
+    if (it != s_FunctionCache.end()) return it->second;
+
+    PyObject* pFunc = nullptr;
+    if (PyObject* pModule = FindModule(module)) {
+        pFunc = PyObject_GetAttrString(pModule, func.c_str());
+        if (!pFunc || !PyCallable_Check(pFunc)) {
+            PyErr_Clear();
+            Py_XDECREF(pFunc);
+            pFunc = nullptr;
+        }
+    }
+    s_FunctionCache.emplace(std::move(key), pFunc);
+    return pFunc;
+}
+
+/// 把连续缓冲包装成 memoryview (不拷贝；调用返回后由 CallBatch release)
+template <typename T>
+PyObject* MakeView(std::vector<T>& data, bool writable) {
+    static T s_Empty[1] = {};
+    char* mem = reinterpret_cast<char*>(data.empty() ? s_Empty : data.data());
+    return PyMemoryView_FromMemory(mem, (Py_ssize_t)(data.size() * sizeof(T)),
+                                   writable ? PyBUF_WRITE : PyBUF_READ);
+}
+
+/// 内置模块 _engine_spatial (邻域查询，定义在 AIManager 部分)
+PyObject* InitSpatialModule();
+/// 等 AI 工作线程算完在途快照 (未开线程时立即返回，定义在 AIManager 部分)
+void WaitForWorkerIdle();
+
+} // namespace
+
 bool PythonEngine::Init(const std::string& scriptsPath) {
     if (s_Initialized) {
         LOG_WARN("[AI] Python 引擎已经初始化");
@@ -26,11 +106,17 @@ bool PythonEngine::Init(const std::string& scriptsPath) {
     }
 
     LOG_INFO("[AI] 正在初始化 Python 解释器...");
+    static bool s_InittabAdded = false;   // 内置模块表只能在首次初始化前追加
+    if (!s_InittabAdded) {
+        PyImport_AppendInittab("_engine_spatial", &InitSpatialModule);
+        s_InittabAdded = true;
+    }
     Py_Initialize();
 
     if (!Py_IsInitialized()) {
-        s_LastError = "Python 解释器初始化失败";
-        LOG_ERROR("[AI] %s", s_LastError.c_str());
+        std::string error = "Python 解释器初始化失败";
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
         return false;
     }
 
@@ -46,6 +132,8 @@ bool PythonEngine::Init(const std::string& scriptsPath) {
 void PythonEngine::Shutdown() {
     if (!s_Initialized) return;
     LOG_INFO("[AI] 关闭 Python 解释器...");
+    AIManager::SetThreaded(false);   // 工作线程须先停下并交还 GIL
+    ClearCache();
     Py_Finalize();
     s_Initialized = false;
 }
@@ -53,29 +141,36 @@ void PythonEngine::Shutdown() {
 bool PythonEngine::IsInitialized() { return s_Initialized; }
 
 bool PythonEngine::Execute(const std::string& code) {
-    if (!s_Initialized) { s_LastError = "Python 未初始化"; return false; }
+    if (!s_Initialized) { SetLastError("Python 未初始化"); return false; }
+    GILGuard gil;
     int result = PyRun_SimpleString(code.c_str());
     if (result != 0) {
-        s_LastError = "Python 执行失败";
-        LOG_ERROR("[AI] %s: %s", s_LastError.c_str(), code.c_str());
+        LOG_ERROR("[AI] Python 执行失败: %s", code.c_str());
+        SetLastError("Python 执行失败");
         return false;
     }
     return true;
 }
 
 bool PythonEngine::ExecuteFile(const std::string& filepath) {
-    if (!s_Initialized) { s_LastError = "Python 未初始化"; return false; }
+    if (!s_Initialized) { SetLastError("Python 未初始化"); return false; }
     FILE* fp = fopen(filepath.c_str(), "r");
     if (!fp) {
-        s_LastError = "无法打开: " + filepath;
-        LOG_ERROR("[AI] %s", s_LastError.c_str());
+        std::string error = "无法打开: " + filepath;
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
         return false;
     }
-    int result = PyRun_SimpleFile(fp, filepath.c_str());
+    int result;
+    {
+        GILGuard gil;
+        result = PyRun_SimpleFile(fp, filepath.c_str());
+    }
     fclose(fp);
     if (result != 0) {
-        s_LastError = "脚本失败: " + filepath;
-        LOG_ERROR("[AI] %s", s_LastError.c_str());
+        std::string error = "脚本失败: " + filepath;
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
         return false;
     }
     return true;
@@ -84,26 +179,14 @@ bool PythonEngine::ExecuteFile(const std::string& filepath) {
 std::string PythonEngine::CallFunction(const std::string& module,
                                         const std::string& func,
                                         const std::vector<std::string>& args) {
-    if (!s_Initialized) { s_LastError = "Python 未初始化"; return ""; }
-
-    PyObject* pModuleName = PyUnicode_FromString(module.c_str());
-    PyObject* pModule = PyImport_Import(pModuleName);
-    Py_DECREF(pModuleName);
-
-    if (!pModule) {
-        PyErr_Print();
-        s_LastError = "无法导入: " + module;
-        LOG_ERROR("[AI] %s", s_LastError.c_str());
-        return "";
-    }
-
-    PyObject* pFunc = PyObject_GetAttrString(pModule, func.c_str());
-    if (!pFunc || !PyCallable_Check(pFunc)) {
-        PyErr_Print();
-        Py_XDECREF(pFunc);
-        Py_DECREF(pModule);
-        s_LastError = "找不到函数: " + module + "." + func;
-        LOG_ERROR("[AI] %s", s_LastError.c_str());
+    if (!s_Initialized) { SetLastError("Python 未初始化"); return ""; }
+    GILGuard gil;
+
+    PyObject* pFunc = FindFunction(module, func);
+    if (!pFunc) {
+        std::string error = "找不到函数: " + module + "." + func;
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
         return "";
     }
 
@@ -114,13 +197,12 @@ std::string PythonEngine::CallFunction(const std::string& module,
 
     PyObject* pResult = PyObject_CallObject(pFunc, pArgs);
     Py_DECREF(pArgs);
-    Py_DECREF(pFunc);
-    Py_DECREF(pModule);
 
     if (!pResult) {
         PyErr_Print();
-        s_LastError = "调用失败: " + module + "." + func;
-        LOG_ERROR("[AI] %s", s_LastError.c_str());
+        std::string error = "调用失败: " + module + "." + func;
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
         return "";
     }
 
@@ -138,13 +220,11 @@ std::string PythonEngine::CallFunction(const std::string& module,
 std::string PythonEngine::GetVariable(const std::string& module,
                                        const std::string& varName) {
     if (!s_Initialized) return "";
-    PyObject* pModuleName = PyUnicode_FromString(module.c_str());
-    PyObject* pModule = PyImport_Import(pModuleName);
-    Py_DECREF(pModuleName);
-    if (!pModule) { PyErr_Print(); return ""; }
+    GILGuard gil;
+    PyObject* pModule = FindModule(module);
+    if (!pModule) return "";
 
     PyObject* pVar = PyObject_GetAttrString(pModule, varName.c_str());
-    Py_DECREF(pModule);
     if (!pVar) { PyErr_Print(); return ""; }
 
     std::string result;
@@ -158,7 +238,124 @@ std::string PythonEngine::GetVariable(const std::string& module,
     return result;
 }
 
-std::string PythonEngine::GetLastError() { return s_LastError; }
+bool PythonEngine::HasFunction(const std::string& module, const std::string& func) {
+    if (!s_Initialized) return false;
+    GILGuard gil;
+    return FindFunction(module, func) != nullptr;
+}
+
+bool PythonEngine::CallBatch(const std::string& module, AIBatch& batch) {
+    if (!s_Initialized) { SetLastError("Python 未初始化"); return false; }
+    GILGuard gil;
+
+    PyObject* pFunc = FindFunction(module, "update_ai_batch");
+    if (!pFunc) {
+        std::string error = "找不到函数: " + module + ".update_ai_batch";
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
+        return false;
+    }
+
+    PyObject* pBatch = PyDict_New();
+    auto setItem = [pBatch](const char* key, PyObject* value) {
+        PyDict_SetItemString(pBatch, key, value);
+        Py_DECREF(value);
+    };
+    // memoryview 指向 batch 内的 vector，调用返回后逐个 release，脚本留下的引用不会悬空
+    std::vector<PyObject*> views;
+    auto setView = [&](const char* key, PyObject* view) {
+        PyDict_SetItemString(pBatch, key, view);
+        views.push_back(view);
+    };
+    setItem("n", PyLong_FromUnsignedLong(batch.GetCount()));
+    setView("agent_f", MakeView(batch.Agents.Floats, false));
+    setView("agent_i", MakeView(batch.Agents.Ints, false));
+    setItem("enemy_n", PyLong_FromUnsignedLong(batch.Enemies.Rows));
+    setView("enemy_f", MakeView(batch.Enemies.Floats, false));
+    setView("enemy_i", MakeView(batch.Enemies.Ints, false));
+    setItem("ally_n", PyLong_FromUnsignedLong(batch.Allies.Rows));
+    setView("ally_f", MakeView(batch.Allies.Floats, false));
+    setView("ally_i", MakeView(batch.Allies.Ints, false));
+    setItem("squad_n", PyLong_FromUnsignedLong(batch.Squads.Rows));
+    setView("squad_f", MakeView(batch.Squads.Floats, false));
+    setView("squad_i", MakeView(batch.Squads.Ints, false));
+    setView("player", MakeView(batch.PlayerData, false));
+    setView("action_f", MakeView(batch.Actions.Floats, true));
+    setView("action_i", MakeView(batch.Actions.Ints, true));
+
+    PyObject* pOrders = PyList_New((Py_ssize_t)batch.Orders.size());
+    for (size_t i = 0; i < batch.Orders.size(); i++) {
+        PyList_SetItem(pOrders, (Py_ssize_t)i, PyUnicode_FromString(batch.Orders[i].c_str()));
+    }
+    setItem("orders", pOrders);
+
+    PyObject* pResult = PyObject_CallFunctionObjArgs(pFunc, pBatch, nullptr);
+    Py_DECREF(pBatch);
+    if (!pResult) PyErr_Print();
+    for (PyObject* view : views) {
+        // 脚本把缓冲导出给别的对象 (如 numpy.frombuffer) 且仍持有时 release 会失败
+        PyObject* pReleased = PyObject_CallMethod(view, "release", nullptr);
+        if (pReleased) {
+            Py_DECREF(pReleased);
+        } else {
+            PyErr_Clear();
+            LOG_WARN("[AI] %s.update_ai_batch 在调用之外仍持有批量缓冲", module.c_str());
+        }
+        Py_DECREF(view);
+    }
+    if (!pResult) {
+        std::string error = "调用失败: " + module + ".update_ai_batch";
+        LOG_ERROR("[AI] %s", error.c_str());
+        SetLastError(std::move(error));
+        return false;
+    }
+
+    // 可选返回 [(row, custom, order), ...]，只列出有字符串结果的行
+    if (pResult != Py_None) {
+        PyObject* pList = PySequence_Fast(pResult, "update_ai_batch 应返回序列或 None");
+        if (!pList) {
+            PyErr_Print();
+            Py_DECREF(pResult);
+            return false;
+        }
+        Py_ssize_t count = PySequence_Fast_GET_SIZE(pList);
+        for (Py_ssize_t i = 0; i < count; i++) {
+            PyObject* pItem = PySequence_Fast_GET_ITEM(pList, i);
+            if (!PyTuple_Check(pItem) || PyTuple_GET_SIZE(pItem) < 3) continue;
+            long row = PyLong_AsLong(PyTuple_GET_ITEM(pItem, 0));
+            const char* custom = PyUnicode_Check(PyTuple_GET_ITEM(pItem, 1)) ? PyUnicode_AsUTF8(PyTuple_GET_ITEM(pItem, 1)) : nullptr;
+            const char* order = PyUnicode_Check(PyTuple_GET_ITEM(pItem, 2)) ? PyUnicode_AsUTF8(PyTuple_GET_ITEM(pItem, 2)) : nullptr;
+            if (row < 0 || PyErr_Occurred()) { PyErr_Clear(); continue; }
+            batch.SetStrings((u32)row, custom ? custom : "", order ? order : "");
+        }
+        Py_DECREF(pList);
+    }
+    Py_DECREF(pResult);
+    return true;
+}
+
+void PythonEngine::ClearCache() {
+    // 工作线程可能正持有缓存里的函数对象调用: 先等它空闲。
+    // 新快照只由主线程的 AIManager::Update 交出，清理期间工作线程不会再开工
+    WaitForWorkerIdle();
+    s_BatchCapable.clear();
+    if (!s_Initialized) return;
+    GILGuard gil;
+    for (auto& [key, func] : s_FunctionCache) Py_XDECREF(func);
+    for (auto& [key, mod] : s_ModuleCache) Py_XDECREF(mod);
+    s_FunctionCache.clear();
+    s_ModuleCache.clear();
+}
+
+std::string PythonEngine::GetLastError() {
+    std::lock_guard<std::mutex> lock(s_WorkerMutex);
+    return s_LastError;
+}
+
+void PythonEngine::SetLastError(std::string error) {
+    std::lock_guard<std::mutex> lock(s_WorkerMutex);
+    s_LastError = std::move(error);
+}
 
 // ════════════════════════════════════════════════════════════
 // AIState 转换
@@ -191,6 +388,7 @@ AIState AIStateFromString(const std::string& str) {
 // ════════════════════════════════════════════════════════════
 
 std::deque<PlayerSnapshot> PlayerTracker::s_History;
+f32 PlayerTracker::s_SpeedSum = 0;
 u32 PlayerTracker::s_PlayerEntity = INVALID_ENTITY;
 glm::vec3 PlayerTracker::s_LastPosition = {0,0,0};
 f32 PlayerTracker::s_TotalTime = 0;
@@ -203,19 +401,21 @@ void PlayerTracker::Update(Scene& scene, f32 dt) {
     s_TotalTime += dt;
     auto& world = scene.GetWorld();
 
-    // 找到玩家实体（带 "Player" tag 的实体）
-    u32 playerEntity = INVALID_ENTITY;
-    for (auto e : world.GetEntities()) {
+    // 找到玩家实体（带 "Player" tag 的实体）；上一帧找到的仍有效就不再扫描全部实体
+    auto isPlayer = [&world](u32 e) {
         auto* tag = world.GetComponent<TagComponent>(e);
-        if (tag && (tag->Name == "Player" || tag->Name == "player")) {
-            playerEntity = e;
-            break;
-        }
+        if (tag && (tag->Name == "Player" || tag->Name == "player")) return true;
         // 或者看 SquadComponent 角色
         auto* sq = world.GetComponent<SquadComponent>(e);
-        if (sq && sq->Role == "player") {
-            playerEntity = e;
-            break;
+        return sq && sq->Role == "player";
+    };
+
+    u32 playerEntity = INVALID_ENTITY;
+    if (s_PlayerEntity != INVALID_ENTITY && isPlayer(s_PlayerEntity)) {
+        playerEntity = s_PlayerEntity;
+    } else {
+        for (auto e : world.GetEntities()) {
+            if (isPlayer(e)) { playerEntity = e; break; }
         }
     }
 
@@ -245,8 +445,12 @@ void PlayerTracker::Update(Scene& scene, f32 dt) {
     snap.Speed = speed;
     snap.Timestamp = s_TotalTime;
     s_History.push_back(snap);
+    s_SpeedSum += speed;
 
-    while (s_History.size() > MAX_HISTORY) s_History.pop_front();
+    while (s_History.size() > MAX_HISTORY) {
+        s_SpeedSum -= s_History.front().Speed;
+        s_History.pop_front();
+    }
 
     // 清理过期事件
     while (!s_AttackTimes.empty() && s_TotalTime - s_AttackTimes.front() > EVENT_WINDOW)
@@ -262,6 +466,7 @@ void PlayerTracker::Update(Scene& scene, f32 dt) {
 
 void PlayerTracker::Reset() {
     s_History.clear();
+    s_SpeedSum = 0;
     s_AttackTimes.clear();
     s_RetreatTimes.clear();
     s_PlayerEntity = INVALID_ENTITY;
@@ -285,9 +490,7 @@ f32 PlayerTracker::GetPlayerSpeed() {
 
 f32 PlayerTracker::GetAverageSpeed() {
     if (s_History.empty()) return 0;
-    f32 total = 0;
-    for (auto& s : s_History) total += s.Speed;
-    return total / (f32)s_History.size();
+    return std::max(s_SpeedSum, 0.0f) / (f32)s_History.size();
 }
 
 const std::deque<PlayerSnapshot>& PlayerTracker::GetHistory() { return s_History; }
@@ -351,14 +554,89 @@ AIAction AIAgent::UpdateAI(const AIContext& ctx) {
 
 u32 AIManager::s_AgentCount = 0;
 
+// ── 帧快照 ──────────────────────────────────────────────
+
+/// 一次逐个调用: 上下文在主线程序列化，结果由 RunPhase 填入
+struct AISingleCall {
+    u32 EntityID = 0;
+    std::string Module;
+    std::string ContextJson;
+    AIAction Result;
+};
+
+/// 一个阶段 (指挥官/队长/士兵) 采集到的 agent 与求出的动作
+struct AIFramePhase {
+    std::unordered_map<std::string, AIBatch> Batches;   // 脚本模块 → 批次 (跨帧复用缓冲)
+    std::vector<AISingleCall> Singles;
+    const char* OrderTarget = nullptr;                  // 本阶段命令的下发对象
+};
+
+namespace {
+
+/// 一帧的快照: 三个阶段按顺序求值
+struct AIFrame {
+    AIFramePhase Phases[3];
+};
+
+using AIClock = std::chrono::steady_clock;
+
+f32 ElapsedMs(AIClock::time_point start) {
+    return std::chrono::duration<f32, std::milli>(AIClock::now() - start).count();
+}
+
+// 双缓冲: 主线程采集 s_Frames[s_Back]，工作线程处理另一份
+AIFrame s_Frames[2];
+u32 s_Back = 0;
+AIFramePhase* s_Phase = nullptr;     // Submit 写入的阶段
+
+// 工作线程 (s_WorkFrame / s_WorkerMs / s_WorkerFrames / s_StopWorker 由 s_WorkerMutex 保护)
+std::thread s_Worker;
+std::condition_variable s_WorkReady, s_WorkDone;
+AIFrame* s_WorkFrame = nullptr;      // 交给工作线程、尚未算完的帧
+AIFrame* s_Pending = nullptr;        // 已交出、结果尚未应用的帧
+bool s_StopWorker = false;
+f32 s_WorkerMs = 0;
+u64 s_WorkerFrames = 0;
+PyThreadState* s_MainThreadState = nullptr;
+AIWorkerStats s_Stats;
+
+AIScheduler s_Scheduler;
+std::vector<AIScheduler::Candidate> s_Candidates;
+u32 s_Frame = 0;                     // AI 帧号 (区分本帧是否已按新动作移动)
+
+// 邻域索引: 工作线程空闲时在主线程重建，上下文采集与 _engine_spatial 共用
+AISpatialIndex s_Spatial;
+ECSWorld* s_SpatialWorld = nullptr;  // 建索引的 world (nullptr = 尚未建)
+std::thread::id s_MainThread;
+std::vector<AISpatialIndex::Hit> s_Hits;
+
+void WaitForWorkerIdle() {
+    if (!AIManager::IsThreaded()) return;
+    std::unique_lock<std::mutex> lock(s_WorkerMutex);
+    s_WorkDone.wait(lock, [] { return s_WorkFrame == nullptr; });
+}
+
+void ClearPhase(AIFramePhase& phase) {
+    for (auto& [module, batch] : phase.Batches) batch.Clear();
+    phase.Singles.clear();
+}
+
+} // namespace
+
 void AIManager::Init() {
     s_AgentCount = 0;
+    s_Scheduler.Reset();
+    s_Spatial.Clear();
+    s_SpatialWorld = nullptr;
     PlayerTracker::Reset();
     LOG_INFO("[AI] AIManager 已初始化 (层级指挥链模式)");
 }
 
 void AIManager::Shutdown() {
+    SetThreaded(false);
     s_AgentCount = 0;
+    s_Spatial.Clear();
+    s_SpatialWorld = nullptr;
     PlayerTracker::Reset();
     LOG_DEBUG("[AI] AIManager 已关闭");
 }
@@ -366,33 +644,340 @@ void AIManager::Shutdown() {
 void AIManager::Update(Scene& scene, f32 dt) {
     if (!PythonEngine::IsInitialized()) return;
 
-    // 0. 更新玩家行为追踪
+    auto frameStart = AIClock::now();
+    s_Frame++;
+
+    // 0. 更新玩家行为追踪，挑出本帧决策的 agent
     PlayerTracker::Update(scene, dt);
+    u32 thought = ScheduleAgents(scene, dt);
 
     // 1. 指挥官决策（全局态势 → 下发战术命令给队长）
-    UpdateCommanders(scene, dt);
-
     // 2. 小队长决策（接收命令 → 分解为子命令给士兵）
-    UpdateSquadLeaders(scene, dt);
-
     // 3. 士兵执行（接收子命令 → 本地决策 → 行动）
-    UpdateSoldiers(scene, dt);
+    void (*const phases[3])(Scene&, f32) = {UpdateCommanders, UpdateSquadLeaders, UpdateSoldiers};
+    const char* orderTargets[3] = {"leader", "soldier", nullptr};
+
+    if (!IsThreaded()) {
+        // 同步: 每阶段求值后立即应用，上级的命令当帧就能传到下级
+        RebuildSpatialIndex(scene);
+        AIFrame& frame = s_Frames[0];
+        for (u32 i = 0; i < 3; i++) {
+            s_Phase = &frame.Phases[i];
+            s_Phase->OrderTarget = orderTargets[i];
+            phases[i](scene, dt);
+            RunPhase(*s_Phase);
+            ApplyPhase(scene, *s_Phase, dt);
+        }
+        s_Phase = nullptr;
+    } else {
+        // 线程模式: 等上一份快照算完 → 应用其结果 → 采集本帧快照并交给工作线程。
+        // 工作线程在本帧其余系统和渲染期间求值，动作晚一帧生效
+        auto start = AIClock::now();
+        {
+            PROFILE_SCOPE("AI::Stall");
+            std::unique_lock<std::mutex> lock(s_WorkerMutex);
+            s_WorkDone.wait(lock, [] { return s_WorkFrame == nullptr; });
+            s_Stats.WorkerMs = s_WorkerMs;
+            s_Stats.Frames = s_WorkerFrames;
+        }
+        s_Stats.StallMs = ElapsedMs(start);
+        Profiler::RecordTimer("AI::Worker", s_Stats.WorkerMs);
+
+        start = AIClock::now();
+        if (s_Pending) {
+            PROFILE_SCOPE("AI::Apply");
+            for (auto& phase : s_Pending->Phases) ApplyPhase(scene, phase, dt);
+            s_Pending = nullptr;
+        }
+        s_Stats.ApplyMs = ElapsedMs(start);
+
+        start = AIClock::now();
+        AIFrame& back = s_Frames[s_Back];
+        {
+            PROFILE_SCOPE("AI::Gather");
+            RebuildSpatialIndex(scene);
+            for (u32 i = 0; i < 3; i++) {
+                s_Phase = &back.Phases[i];
+                s_Phase->OrderTarget = orderTargets[i];
+                phases[i](scene, dt);
+            }
+            s_Phase = nullptr;
+        }
+        s_Stats.GatherMs = ElapsedMs(start);
+
+        {
+            std::lock_guard<std::mutex> lock(s_WorkerMutex);
+            s_WorkFrame = &back;
+        }
+        s_WorkReady.notify_one();
+        s_Pending = &back;
+        s_Back ^= 1;
+    }
+
+    CoastAgents(scene, dt);
+    s_Scheduler.EndFrame(thought, ElapsedMs(frameStart));
+}
+
+// ── 思考调度 ────────────────────────────────────────────
+
+u32 AIManager::ScheduleAgents(Scene& scene, f32 dt) {
+    auto& world = scene.GetWorld();
+    glm::vec3 playerPos = PlayerTracker::GetPlayerPosition();
+    s_Candidates.clear();
+
+    world.ForEach<AIComponent>([&](Entity e, AIComponent& ai) {
+        ai.ThinkNow = false;
+
+        auto* hp = world.GetComponent<HealthComponent>(e);
+        if (hp && hp->Current <= 0) return;
+
+        AIRole role = AIRole::Soldier;
+        if (auto* sq = world.GetComponent<SquadComponent>(e)) {
+            if (sq->Role == "commander")   role = AIRole::Commander;
+            else if (sq->Role == "leader") role = AIRole::Leader;
+            if (sq->OrderStatus == "pending") ai.WakeRequested = true;   // 收到新命令
+        }
+
+        f32 dist = 0.0f;
+        if (auto* tr = world.GetComponent<TransformComponent>(e)) {
+            dist = glm::distance(tr->GetWorldPosition(), playerPos);
+        }
+        bool inRange = dist <= ai.DetectRange;
+        if (inRange && !ai.PlayerInRange) ai.WakeRequested = true;      // 发现玩家
+        ai.PlayerInRange = inRange;
+
+        f32 health = hp ? hp->Current : 0.0f;
+        f32 interval = s_Scheduler.GetInterval(role, dist, AIStateFromString(ai.State));
+        if (ai.LastHealth < 0.0f) {
+            ai.ThinkTimer = AIScheduler::InitialDelay(e, interval);     // 首次出现: 错开相位
+        } else if (health < ai.LastHealth) {
+            ai.WakeRequested = true;                                     // 受伤
+        }
+        ai.LastHealth = health;
+
+        ai.ThinkTimer -= dt;
+        ai.SinceLastThink += dt;
+        if (ai.ThinkTimer > 0.0f && !ai.WakeRequested) return;
+        s_Candidates.push_back({e, AIScheduler::GetPriority(role, -ai.ThinkTimer, ai.WakeRequested), interval});
+    });
+
+    AIScheduler::Select(s_Candidates, s_Scheduler.GetFrameQuota());
+
+    for (const auto& c : s_Candidates) {
+        auto* ai = world.GetComponent<AIComponent>(c.EntityID);
+        ai->ThinkNow = true;
+        ai->WakeRequested = false;
+        // 脚本里的计时器按两次决策之间的真实时间累加
+        ai->ThinkDeltaTime = ai->SinceLastThink;
+        ai->SinceLastThink = 0.0f;
+        // 按原相位排下一次；被事件提前唤醒或积压超过一个间隔的从现在重新计
+        f32 t = ai->ThinkTimer;
+        ai->ThinkTimer = (t > 0.0f || t < -c.Interval) ? c.Interval : t + c.Interval;
+    }
+    return (u32)s_Candidates.size();
+}
+
+void AIManager::CoastAgents(Scene& scene, f32 dt) {
+    auto& world = scene.GetWorld();
+    world.ForEach<AIComponent>([&](Entity e, AIComponent& ai) {
+        if (ai.MoveSpeed <= 0.001f || ai.LastMoveFrame == s_Frame) return;
+        auto* hp = world.GetComponent<HealthComponent>(e);
+        if (hp && hp->Current <= 0) { ai.MoveSpeed = 0.0f; return; }
+
+        AIAction action;
+        action.MoveDirection = ai.MoveDirection;
+        action.MoveSpeed = ai.MoveSpeed;
+        ApplyAction(scene, e, action, dt);
+    });
+}
+
+AIScheduler& AIManager::GetScheduler() { return s_Scheduler; }
+
+// ── 邻域索引 ────────────────────────────────────────────
+
+void AIManager::RebuildSpatialIndex(Scene& scene) {
+    PROFILE_SCOPE("AI::SpatialIndex");
+    s_SpatialWorld = &scene.GetWorld();
+    s_MainThread = std::this_thread::get_id();
+    s_Spatial.Build(*s_SpatialWorld);
+}
+
+const AISpatialIndex& AIManager::GetSpatialIndex() { return s_Spatial; }
+
+namespace {
+
+/// 只在主线程、索引建好后回答；否则返回 None，由 engine_api 回退
+bool SpatialReady() {
+    return s_SpatialWorld && std::this_thread::get_id() == s_MainThread;
+}
+
+bool SpatialCenter(u32 entityID, glm::vec3& pos) {
+    auto* tr = s_SpatialWorld->GetComponent<TransformComponent>(entityID);
+    if (!tr) return false;
+    pos = {tr->X, tr->Y, tr->Z};
+    return true;
+}
+
+/// 命中 → [{"id", "pos", "dist", "name"}, ...] (与 engine_api.find_nearby 的格式一致)
+PyObject* HitsToList(const std::vector<AISpatialIndex::Hit>& hits) {
+    PyObject* list = PyList_New((Py_ssize_t)hits.size());
+    if (!list) return nullptr;
+    for (size_t i = 0; i < hits.size(); i++) {
+        const AISpatialIndex::Entry& e = s_Spatial.GetEntry(hits[i].Index);
+        auto* tag = s_SpatialWorld->GetComponent<TagComponent>(e.EntityID);
+        PyObject* item = Py_BuildValue("{s:I,s:[d,d,d],s:d,s:s}",
+            "id", (unsigned)e.EntityID,
+            "pos", (double)e.Position.x, (double)e.Position.y, (double)e.Position.z,
+            "dist", (double)hits[i].Distance,
+            "name", tag ? tag->Name.c_str() : "");
+        if (!item) { Py_DECREF(list); return nullptr; }
+        PyList_SET_ITEM(list, (Py_ssize_t)i, item);
+    }
+    return list;
+}
+
+PyObject* Spatial_FindNearby(PyObject*, PyObject* args) {
+    unsigned entityID = 0;
+    float radius = 0;
+    if (!PyArg_ParseTuple(args, "If", &entityID, &radius)) return nullptr;
+    if (!SpatialReady()) Py_RETURN_NONE;
+
+    glm::vec3 pos;
+    if (!SpatialCenter(entityID, pos)) return PyList_New(0);
+    s_Spatial.QueryRadius(pos, radius, entityID, s_Hits);
+    return HitsToList(s_Hits);
+}
+
+PyObject* Spatial_KNearest(PyObject*, PyObject* args) {
+    unsigned entityID = 0, k = 0;
+    float maxRadius = std::numeric_limits<float>::max();
+    if (!PyArg_ParseTuple(args, "II|f", &entityID, &k, &maxRadius)) return nullptr;
+    if (!SpatialReady()) Py_RETURN_NONE;
+
+    glm::vec3 pos;
+    if (!SpatialCenter(entityID, pos)) return PyList_New(0);
+    s_Spatial.QueryKNearest(pos, k, maxRadius, entityID, s_Hits);
+    return HitsToList(s_Hits);
+}
+
+PyObject* Spatial_SquadMembers(PyObject*, PyObject* args) {
+    unsigned squadID = 0;
+    if (!PyArg_ParseTuple(args, "I", &squadID)) return nullptr;
+    if (!SpatialReady()) Py_RETURN_NONE;
+
+    const std::vector<u32>& members = s_Spatial.GetSquadMembers(squadID);
+    PyObject* list = PyList_New((Py_ssize_t)members.size());
+    if (!list) return nullptr;
+    for (size_t i = 0; i < members.size(); i++) {
+        PyList_SET_ITEM(list, (Py_ssize_t)i, PyLong_FromUnsignedLong(members[i]));
+    }
+    return list;
 }
 
+PyMethodDef s_SpatialMethods[] = {
+    {"find_nearby", Spatial_FindNearby, METH_VARARGS,
+     "find_nearby(entity_id, radius) -> [{id, pos, dist, name}] | None"},
+    {"k_nearest", Spatial_KNearest, METH_VARARGS,
+     "k_nearest(entity_id, k, max_radius=inf) -> [{id, pos, dist, name}] | None"},
+    {"squad_members", Spatial_SquadMembers, METH_VARARGS,
+     "squad_members(squad_id) -> [entity_id] | None"},
+    {nullptr, nullptr, 0, nullptr}
+};
+
+PyModuleDef s_SpatialModule = {
+    PyModuleDef_HEAD_INIT, "_engine_spatial",
+    "AI 邻域索引查询 (本帧快照，仅主线程)", -1, s_SpatialMethods,
+    nullptr, nullptr, nullptr, nullptr
+};
+
+PyObject* InitSpatialModule() { return PyModule_Create(&s_SpatialModule); }
+
+} // namespace
+
+// ── 工作线程 ────────────────────────────────────────────
+
+void AIManager::SetThreaded(bool threaded) {
+    if (threaded == IsThreaded()) return;
+
+    if (threaded) {
+        if (!PythonEngine::IsInitialized()) {
+            LOG_WARN("[AI] Python 未初始化，无法启动 AI 工作线程");
+            return;
+        }
+        s_StopWorker = false;
+        s_WorkFrame = nullptr;
+        s_Pending = nullptr;
+        s_Stats = {};
+        s_WorkerMs = 0;
+        s_WorkerFrames = 0;
+
+        // 主线程交出 GIL；之后所有 Python 调用经 GILGuard 按需获取
+        s_MainThreadState = PyEval_SaveThread();
+
+        s_Worker = std::thread([] {
+            std::unique_lock<std::mutex> lock(s_WorkerMutex);
+            for (;;) {
+                s_WorkReady.wait(lock, [] { return s_StopWorker || s_WorkFrame; });
+                if (!s_WorkFrame) break;
+
+                AIFrame* frame = s_WorkFrame;
+                lock.unlock();
+                auto start = AIClock::now();
+                for (auto& phase : frame->Phases) RunPhase(phase);
+                f32 ms = ElapsedMs(start);
+                lock.lock();
+
+                s_WorkerMs = ms;
+                s_WorkerFrames++;
+                s_WorkFrame = nullptr;
+                s_WorkDone.notify_all();
+            }
+        });
+        LOG_INFO("[AI] AI 工作线程已启动");
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(s_WorkerMutex);
+        s_StopWorker = true;
+    }
+    s_WorkReady.notify_one();
+    s_Worker.join();     // 在途快照算完才退出
+    PyEval_RestoreThread(s_MainThreadState);
+    s_MainThreadState = nullptr;
+
+    // 没来得及应用的结果丢弃，关闭后从同步模式重新开始
+    for (auto& frame : s_Frames) {
+        for (auto& phase : frame.Phases) ClearPhase(phase);
+    }
+    s_Pending = nullptr;
+    LOG_INFO("[AI] AI 工作线程已停止");
+}
+
+bool AIManager::IsThreaded() { return s_Worker.joinable(); }
+
+const AIWorkerStats& AIManager::GetWorkerStats() { return s_Stats; }
+
 // ── 阶段1：指挥官 ──────────────────────────────────────
 
 void AIManager::UpdateCommanders(Scene& scene, f32 dt) {
     auto& world = scene.GetWorld();
 
+    // 所有指挥官看到的小队概览相同，每帧只统计一次
+    AIContext overview;
+    bool hasOverview = false;
+
     for (auto e : world.GetEntities()) {
         auto* sq = world.GetComponent<SquadComponent>(e);
         if (!sq || sq->Role != "commander") continue;
 
         auto* aiComp = world.GetComponent<AIComponent>(e);
-        if (!aiComp) continue;
+        if (!aiComp || !aiComp->ThinkNow) continue;
 
-        auto* hpComp = world.GetComponent<HealthComponent>(e);
-        if (hpComp && hpComp->Current <= 0) continue;
+        if (!hasOverview) {
+            InjectCommanderData(scene, overview);
+            hasOverview = true;
+        }
 
         AIContext ctx = BuildContext(scene, e, dt);
         ctx.Role = "commander";
@@ -401,24 +986,10 @@ void AIManager::UpdateCommanders(Scene& scene, f32 dt) {
         InjectPlayerData(ctx);
 
         // 注入所有小队概览
-        InjectCommanderData(scene, ctx);
-
-        AIAgent agent;
-        agent.EntityID = e;
-        agent.State = AIStateFromString(aiComp->State);
-        agent.DetectRange = aiComp->DetectRange;
-        agent.AttackRange = aiComp->AttackRange;
-        agent.ScriptModule = aiComp->ScriptModule;
-
-        AIAction action = agent.UpdateAI(ctx);
-        aiComp->State = AIStateToString(action.NewState);
-        ApplyAction(scene, e, action, dt);
-
-        // 下发命令给所属队长
-        if (!action.OrderForSubordinates.empty()) {
-            DispatchOrders(scene, e, action.OrderForSubordinates, "leader");
-        }
+        ctx.AllSquads = overview.AllSquads;
 
+        // 命令下发给所属队长
+        Submit(e, aiComp->ScriptModule, ctx);
         s_AgentCount++;
     }
 }
@@ -433,10 +1004,7 @@ void AIManager::UpdateSquadLeaders(Scene& scene, f32 dt) {
         if (!sq || sq->Role != "leader") continue;
 
         auto* aiComp = world.GetComponent<AIComponent>(e);
-        if (!aiComp) continue;
-
-        auto* hpComp = world.GetComponent<HealthComponent>(e);
-        if (hpComp && hpComp->Current <= 0) continue;
+        if (!aiComp || !aiComp->ThinkNow) continue;
 
         AIContext ctx = BuildContext(scene, e, dt);
         ctx.Role = "leader";
@@ -446,21 +1014,8 @@ void AIManager::UpdateSquadLeaders(Scene& scene, f32 dt) {
         InjectPlayerData(ctx);
         InjectSquadData(scene, ctx, e);
 
-        AIAgent agent;
-        agent.EntityID = e;
-        agent.State = AIStateFromString(aiComp->State);
-        agent.DetectRange = aiComp->DetectRange;
-        agent.AttackRange = aiComp->AttackRange;
-        agent.ScriptModule = aiComp->ScriptModule;
-
-        AIAction action = agent.UpdateAI(ctx);
-        aiComp->State = AIStateToString(action.NewState);
-        ApplyAction(scene, e, action, dt);
-
-        // 下发子命令给本小队士兵
-        if (!action.OrderForSubordinates.empty()) {
-            DispatchOrders(scene, e, action.OrderForSubordinates, "soldier");
-        }
+        // 子命令下发给本小队士兵
+        Submit(e, aiComp->ScriptModule, ctx);
 
         sq->OrderStatus = "executing";
         s_AgentCount++;
@@ -472,34 +1027,15 @@ void AIManager::UpdateSquadLeaders(Scene& scene, f32 dt) {
 void AIManager::UpdateSoldiers(Scene& scene, f32 dt) {
     auto& world = scene.GetWorld();
 
-    // AI 距离 LOD: 远处 AI 降低更新频率
-    static u32 s_FrameCounter = 0;
-    s_FrameCounter++;
-    glm::vec3 playerPos = PlayerTracker::GetPlayerPosition();
-
     for (auto e : world.GetEntities()) {
         auto* sq = world.GetComponent<SquadComponent>(e);
         auto* aiComp = world.GetComponent<AIComponent>(e);
-        if (!aiComp) continue;
+        // 距离/状态 LOD 由 ScheduleAgents 决定
+        if (!aiComp || !aiComp->ThinkNow) continue;
 
         // 跳过指挥官和队长
         if (sq && (sq->Role == "commander" || sq->Role == "leader")) continue;
 
-        auto* hpComp = world.GetComponent<HealthComponent>(e);
-        if (hpComp && hpComp->Current <= 0) continue;
-
-        // ── 距离 LOD ──────────────────────────────────────
-        auto* tr = world.GetComponent<TransformComponent>(e);
-        if (tr) {
-            f32 dist = glm::distance(tr->GetWorldPosition(), playerPos);
-            // 近距离 (<30): 每帧更新
-            // 中距离 (30~60): 每 2 帧更新
-            // 远距离 (>60): 每 4 帧更新
-            if (dist > 60.0f && (s_FrameCounter % 4) != 0) continue;
-            if (dist > 30.0f && (s_FrameCounter % 2) != 0) continue;
-        }
-        // ────────────────────────────────────────────────
-
         AIContext ctx = BuildContext(scene, e, dt);
 
         if (sq) {
@@ -509,22 +1045,75 @@ void AIManager::UpdateSoldiers(Scene& scene, f32 dt) {
             InjectSquadData(scene, ctx, e);
         }
 
-        AIAgent agent;
-        agent.EntityID = e;
-        agent.State = AIStateFromString(aiComp->State);
-        agent.DetectRange = aiComp->DetectRange;
-        agent.AttackRange = aiComp->AttackRange;
-        agent.ScriptModule = aiComp->ScriptModule;
-
-        AIAction action = agent.UpdateAI(ctx);
-        aiComp->State = AIStateToString(action.NewState);
-        ApplyAction(scene, e, action, dt);
+        Submit(e, aiComp->ScriptModule, ctx);
 
         if (sq) sq->OrderStatus = "executing";
         s_AgentCount++;
     }
 }
 
+// ── 采集 / 求值 / 应用 ──────────────────────────────────
+
+void AIManager::Submit(u32 entityID, const std::string& module, const AIContext& ctx) {
+    auto it = s_BatchCapable.find(module);
+    if (it == s_BatchCapable.end()) {
+        it = s_BatchCapable.emplace(module, PythonEngine::HasFunction(module, "update_ai_batch")).first;
+    }
+    if (it->second) {
+        s_Phase->Batches[module].Add(entityID, ctx);
+        return;
+    }
+
+    AISingleCall& call = s_Phase->Singles.emplace_back();
+    call.EntityID = entityID;
+    call.Module = module;
+    call.ContextJson = ContextToJSON(ctx);
+}
+
+void AIManager::RunPhase(AIFramePhase& phase) {
+    for (auto& [module, batch] : phase.Batches) {
+        if (batch.GetCount() == 0) continue;
+        batch.Pack();
+        PythonEngine::CallBatch(module, batch);   // 失败时结果表保持初值 (状态不变、不移动)
+    }
+    for (auto& call : phase.Singles) {
+        call.Result = ParseAction(PythonEngine::CallFunction(call.Module, "update_ai", {call.ContextJson}));
+    }
+}
+
+void AIManager::ApplyPhase(Scene& scene, AIFramePhase& phase, f32 dt) {
+    auto& world = scene.GetWorld();
+    // 线程模式下结果晚一帧，期间被销毁的 agent 跳过
+    auto alive = [&world](u32 e) { return world.GetComponent<AIComponent>(e) != nullptr; };
+
+    for (auto& [module, batch] : phase.Batches) {
+        for (u32 row = 0; row < batch.GetCount(); row++) {
+            u32 e = batch.GetEntity(row);
+            if (alive(e)) ApplyResult(scene, e, batch.GetAction(row), dt, phase.OrderTarget);
+        }
+    }
+    for (auto& call : phase.Singles) {
+        if (alive(call.EntityID)) ApplyResult(scene, call.EntityID, call.Result, dt, phase.OrderTarget);
+    }
+    ClearPhase(phase);
+}
+
+void AIManager::ApplyResult(Scene& scene, u32 entityID, const AIAction& action,
+                            f32 dt, const char* orderTarget) {
+    if (auto* aiComp = scene.GetWorld().GetComponent<AIComponent>(entityID)) {
+        aiComp->State = AIStateToString(action.NewState);
+        // 下次决策前沿用这次的移动
+        aiComp->MoveDirection = action.MoveDirection;
+        aiComp->MoveSpeed = action.MoveSpeed;
+        aiComp->LastMoveFrame = s_Frame;
+    }
+    ApplyAction(scene, entityID, action, dt);
+
+    if (orderTarget && !action.OrderForSubordinates.empty()) {
+        DispatchOrders(scene, entityID, action.OrderForSubordinates, orderTarget);
+    }
+}
+
 // ── 命令下发 ────────────────────────────────────────────
 
 void AIManager::DispatchOrders(Scene& scene, u32 issuerEntity,
@@ -564,8 +1153,12 @@ AIContext AIManager::BuildContext(Scene& scene, u32 entityID, f32 dt) {
     AIContext ctx;
     ctx.EntityID = entityID;
     ctx.DeltaTime = dt;
+    ctx.FrameDeltaTime = dt;
 
     auto& world = scene.GetWorld();
+    if (auto* ai = world.GetComponent<AIComponent>(entityID)) {
+        if (ai->ThinkNow) ctx.DeltaTime = ai->ThinkDeltaTime;
+    }
 
     if (auto* tr = world.GetComponent<TransformComponent>(entityID)) {
         ctx.Position = {tr->X, tr->Y, tr->Z};
@@ -608,10 +1201,10 @@ void AIManager::InjectSquadData(Scene& scene, AIContext& ctx, u32 entityID) {
     ctx.SquadID = mySq->SquadID;
     u32 total = 0, alive = 0;
 
-    for (auto e : world.GetEntities()) {
+    for (u32 e : s_Spatial.GetSquadMembers(mySq->SquadID)) {
         if (e == entityID) continue;
         auto* sq = world.GetComponent<SquadComponent>(e);
-        if (!sq || sq->SquadID != mySq->SquadID) continue;
+        if (!sq || sq->SquadID != mySq->SquadID) continue;   // 建索引后换了小队
 
         total++;
 
@@ -642,39 +1235,39 @@ void AIManager::InjectSquadData(Scene& scene, AIContext& ctx, u32 entityID) {
 void AIManager::InjectCommanderData(Scene& scene, AIContext& ctx) {
     auto& world = scene.GetWorld();
 
-    // 收集所有小队信息
-    std::unordered_map<u32, AIContext::SquadSummary> squads;
+    // 收集所有小队信息 (小队表按 ID 升序)
+    for (u32 squadID : s_Spatial.GetSquadIDs()) {
+        if (squadID == 0) continue;
 
-    for (auto e : world.GetEntities()) {
-        auto* sq = world.GetComponent<SquadComponent>(e);
-        if (!sq || sq->SquadID == 0) continue;
+        AIContext::SquadSummary summary;
+        summary.SquadID = squadID;
 
-        auto& summary = squads[sq->SquadID];
-        summary.SquadID = sq->SquadID;
-        summary.TotalMembers++;
+        for (u32 e : s_Spatial.GetSquadMembers(squadID)) {
+            auto* sq = world.GetComponent<SquadComponent>(e);
+            if (!sq || sq->SquadID != squadID) continue;   // 建索引后换了小队
+            summary.TotalMembers++;
 
-        auto* hp = world.GetComponent<HealthComponent>(e);
-        auto* tr = world.GetComponent<TransformComponent>(e);
+            auto* hp = world.GetComponent<HealthComponent>(e);
+            auto* tr = world.GetComponent<TransformComponent>(e);
 
-        if (hp && hp->Current > 0) {
-            summary.AliveMembers++;
-            summary.AverageHealth += hp->Current;
-        }
-        if (tr) {
-            summary.CenterPosition += glm::vec3(tr->X, tr->Y, tr->Z);
-        }
+            if (hp && hp->Current > 0) {
+                summary.AliveMembers++;
+                summary.AverageHealth += hp->Current;
+            }
+            if (tr) {
+                summary.CenterPosition += glm::vec3(tr->X, tr->Y, tr->Z);
+            }
 
-        if (sq->Role == "leader") {
-            summary.CurrentOrder = sq->CurrentOrder.empty() ? "idle" : "active";
+            if (sq->Role == "leader") {
+                summary.CurrentOrder = sq->CurrentOrder.empty() ? "idle" : "active";
+            }
         }
-    }
 
-    for (auto& [id, s] : squads) {
-        if (s.TotalMembers > 0) {
-            s.AverageHealth /= (f32)s.AliveMembers;
-            s.CenterPosition /= (f32)s.TotalMembers;
+        if (summary.TotalMembers > 0) {
+            summary.AverageHealth /= (f32)summary.AliveMembers;
+            summary.CenterPosition /= (f32)summary.TotalMembers;
+            ctx.AllSquads.push_back(summary);
         }
-        ctx.AllSquads.push_back(s);
     }
 }
 
@@ -686,37 +1279,24 @@ std::vector<NearbyEntity> AIManager::FindNearbyEntities(
     std::vector<NearbyEntity> result;
     auto& world = scene.GetWorld();
 
-    for (auto e : world.GetEntities()) {
-        if (e == selfID) continue;
-
-        auto* tr = world.GetComponent<TransformComponent>(e);
-        if (!tr) continue;
-
-        glm::vec3 ePos = {tr->X, tr->Y, tr->Z};
-        f32 dist = glm::length(ePos - pos);
-
-        if (dist > range) continue;
+    // 本帧邻域索引，结果已按距离升序
+    s_Spatial.QueryRadius(pos, range, selfID, s_Hits);
+    result.reserve(s_Hits.size());
+    for (const auto& hit : s_Hits) {
+        const AISpatialIndex::Entry& entry = s_Spatial.GetEntry(hit.Index);
 
         NearbyEntity ne;
-        ne.EntityID = e;
-        ne.Position = ePos;
-        ne.Distance = dist;
-
-        if (auto* hp = world.GetComponent<HealthComponent>(e)) {
-            ne.Health = hp->Current;
-        }
-        if (auto* tag = world.GetComponent<TagComponent>(e)) {
+        ne.EntityID = entry.EntityID;
+        ne.Position = entry.Position;
+        ne.Distance = hit.Distance;
+        ne.Health = entry.Health;
+        if (auto* tag = world.GetComponent<TagComponent>(entry.EntityID)) {
             ne.Tag = tag->Name;
         }
 
         result.push_back(ne);
     }
 
-    std::sort(result.begin(), result.end(),
-        [](const NearbyEntity& a, const NearbyEntity& b) {
-            return a.Distance < b.Distance;
-        });
-
     return result;
 }
 
@@ -757,6 +1337,7 @@ std::string AIManager::ContextToJSON(const AIContext& ctx) {
     ss << "\"attack_range\":" << ctx.AttackRange << ",";
     ss << "\"move_speed\":" << ctx.MoveSpeed << ",";
     ss << "\"dt\":" << ctx.DeltaTime << ",";
+    ss << "\"frame_dt\":" << ctx.FrameDeltaTime << ",";
 
     // 小队信息
     ss << "\"role\":\"" << ctx.Role << "\",";
@@ -913,6 +1494,8 @@ std::vector<std::string> AIManager::ContextToArgs(const AIContext& ctx) {
 // ── 无 Python 时的 stub 实现 ────────────────────────────────
 
 #include "engine/ai/python_engine.h"
+#include "engine/ai/ai_scheduler.h"
+#include "engine/ai/spatial_index.h"
 #include "engine/core/scene.h"
 
 namespace Engine {
@@ -931,6 +1514,9 @@ bool PythonEngine::Execute(const std::string&) { return false; }
 bool PythonEngine::ExecuteFile(const std::string&) { return false; }
 std::string PythonEngine::CallFunction(const std::string&, const std::string&, const std::vector<std::string>&) { return ""; }
 std::string PythonEngine::GetVariable(const std::string&, const std::string&) { return ""; }
+bool PythonEngine::HasFunction(const std::string&, const std::string&) { return false; }
+bool PythonEngine::CallBatch(const std::string&, AIBatch&) { return false; }
+void PythonEngine::ClearCache() {}
 std::string PythonEngine::GetLastError() { return "Python not enabled"; }
 
 const char* AIStateToString(AIState state) {
@@ -958,6 +1544,7 @@ AIAction AIAgent::UpdateAI(const AIContext&) { return {}; }
 
 // PlayerTracker stubs
 std::deque<PlayerSnapshot> PlayerTracker::s_History;
+f32 PlayerTracker::s_SpeedSum = 0;
 u32 PlayerTracker::s_PlayerEntity = ~u32(0);  // INVALID_ENTITY
 glm::vec3 PlayerTracker::s_LastPosition = {0,0,0};
 f32 PlayerTracker::s_TotalTime = 0;
@@ -993,6 +1580,18 @@ void AIManager::InjectPlayerData(AIContext&) {}
 void AIManager::InjectSquadData(Scene&, AIContext&, u32) {}
 void AIManager::InjectCommanderData(Scene&, AIContext&) {}
 std::vector<NearbyEntity> AIManager::FindNearbyEntities(Scene&, u32, const glm::vec3&, f32) { return {}; }
+void AIManager::SetThreaded(bool) {}
+bool AIManager::IsThreaded() { return false; }
+const AIWorkerStats& AIManager::GetWorkerStats() { static AIWorkerStats s_Stats; return s_Stats; }
+AIScheduler& AIManager::GetScheduler() { static AIScheduler s_Scheduler; return s_Scheduler; }
+const AISpatialIndex& AIManager::GetSpatialIndex() { static AISpatialIndex s_Spatial; return s_Spatial; }
+void AIManager::RebuildSpatialIndex(Scene&) {}
+u32 AIManager::ScheduleAgents(Scene&, f32) { return 0; }
+void AIManager::CoastAgents(Scene&, f32) {}
+void AIManager::Submit(u32, const std::string&, const AIContext&) {}
+void AIManager::RunPhase(AIFramePhase&) {}
+void AIManager::ApplyPhase(Scene&, AIFramePhase&, f32) {}
+void AIManager::ApplyResult(Scene&, u32, const AIAction&, f32, const char*) {}
 void AIManager::ApplyAction(Scene&, u32, const AIAction&, f32) {}
 void AIManager::DispatchOrders(Scene&, u32, const std::string&, const std::string&) {}
 std::vector<std::string> AIManager::ContextToArgs(const AIContext&) { return {}; }
@@ -0,0 +1,206 @@
+#include "engine/ai/spatial_index.h"
+#include "engine/core/systems.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+namespace AI {
+
+namespace {
+
+constexpr u32 BUILD_GRAIN = 1024;   // 每个并行任务至少处理的条目数
+
+bool HitLess(const AISpatialIndex::Hit& a, const AISpatialIndex::Hit& b,
+             const std::vector<AISpatialIndex::Entry>& entries) {
+    if (a.Distance != b.Distance) return a.Distance < b.Distance;
+    return entries[a.Index].EntityID < entries[b.Index].EntityID;
+}
+
+/// 先在浮点域夹到 [0, count - 1] 再转整数: inf / 超出 i32 的值直接转换是未定义行为，NaN 取 0
+i32 ClampCell(f32 c, u32 count) {
+    if (!(c > 0.0f)) return 0;
+    return (i32)std::min(c, (f32)(count - 1));
+}
+
+} // namespace
+
+// ── 构建 ────────────────────────────────────────────────
+
+void AISpatialIndex::Build(ECSWorld& world) {
+    auto& transforms = world.GetComponentArray<TransformComponent>();
+    auto& healths = world.GetComponentArray<HealthComponent>();
+    auto& squads = world.GetComponentArray<SquadComponent>();
+
+    // 组件池在主线程取好；并行任务只读
+    u32 count = transforms.Size();
+    m_Entries.resize(count);
+    JobSystem::ParallelForRange(count, BUILD_GRAIN, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) {
+            const TransformComponent& tr = transforms.Data(i);
+            Entry& entry = m_Entries[i];
+            entry.EntityID = transforms.GetEntity(i);
+            entry.Position = {tr.X, tr.Y, tr.Z};
+            const HealthComponent* hp = healths.Get(entry.EntityID);
+            entry.Health = hp ? hp->Current : 0.0f;
+        }
+    });
+
+    m_SquadPairs.clear();
+    m_SquadPairs.reserve(squads.Size());
+    for (u32 i = 0; i < squads.Size(); i++) {
+        m_SquadPairs.emplace_back(squads.Data(i).SquadID, squads.GetEntity(i));
+    }
+
+    BuildGrid();
+    BuildSquads(m_SquadPairs);
+}
+
+void AISpatialIndex::Build(std::vector<Entry> entries,
+                           const std::vector<std::pair<u32, u32>>& squads) {
+    m_Entries = std::move(entries);
+    m_SquadPairs = squads;
+    BuildGrid();
+    BuildSquads(m_SquadPairs);
+}
+
+void AISpatialIndex::Clear() {
+    m_Entries.clear();
+    m_CellStart.clear();
+    m_Width = m_Height = 0;
+    for (auto& [id, members] : m_Squads) members.clear();
+    m_SquadIDs.clear();
+}
+
+void AISpatialIndex::BuildGrid() {
+    const u32 count = (u32)m_Entries.size();
+    if (count == 0) {
+        m_CellStart.assign(1, 0);
+        m_Width = m_Height = 0;
+        return;
+    }
+
+    m_Min = m_Max = m_Entries[0].Position;
+    for (const Entry& e : m_Entries) {
+        m_Min = glm::min(m_Min, e.Position);
+        m_Max = glm::max(m_Max, e.Position);
+    }
+
+    // 格子数超过上限时放大格子
+    m_GridCellSize = std::max(m_CellSize, 0.001f);
+    f32 extentX = m_Max.x - m_Min.x, extentZ = m_Max.z - m_Min.z;
+    for (;;) {
+        m_Width = (u32)(extentX / m_GridCellSize) + 1;
+        m_Height = (u32)(extentZ / m_GridCellSize) + 1;
+        if ((u64)m_Width * m_Height <= MAX_CELLS) break;
+        m_GridCellSize *= 2.0f;
+    }
+    m_Origin = {m_Min.x, m_Min.z};
+    const u32 cells = m_Width * m_Height;
+
+    m_CellOf.resize(count);
+    JobSystem::ParallelForRange(count, BUILD_GRAIN, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) {
+            const glm::vec3& p = m_Entries[i].Position;
+            m_CellOf[i] = (u32)CellZ(p.z) * m_Width + (u32)CellX(p.x);
+        }
+    });
+
+    // 计数排序: 同一格子的条目连续，格内保持原顺序
+    m_CellStart.assign(cells + 1, 0);
+    for (u32 i = 0; i < count; i++) m_CellStart[m_CellOf[i] + 1]++;
+    for (u32 c = 0; c < cells; c++) m_CellStart[c + 1] += m_CellStart[c];
+
+    m_Scratch.resize(count);
+    for (u32 i = 0; i < count; i++) {
+        m_Scratch[m_CellStart[m_CellOf[i]]++] = m_Entries[i];
+    }
+    // 散布时每格起点被推进到了下一格的起点，整体右移一格还原
+    for (u32 c = cells; c > 0; c--) m_CellStart[c] = m_CellStart[c - 1];
+    m_CellStart[0] = 0;
+    m_Entries.swap(m_Scratch);
+}
+
+void AISpatialIndex::BuildSquads(std::vector<std::pair<u32, u32>>& squads) {
+    for (auto& [id, members] : m_Squads) members.clear();
+    m_SquadIDs.clear();
+
+    std::sort(squads.begin(), squads.end());
+    for (const auto& [squadID, entity] : squads) {
+        auto& members = m_Squads[squadID];
+        if (members.empty()) m_SquadIDs.push_back(squadID);
+        members.push_back(entity);
+    }
+}
+
+i32 AISpatialIndex::CellX(f32 x) const {
+    return ClampCell(std::floor((x - m_Origin.x) / m_GridCellSize), m_Width);
+}
+
+i32 AISpatialIndex::CellZ(f32 z) const {
+    return ClampCell(std::floor((z - m_Origin.y) / m_GridCellSize), m_Height);
+}
+
+// ── 查询 ────────────────────────────────────────────────
+
+void AISpatialIndex::QueryRadius(const glm::vec3& pos, f32 radius, u32 excludeID,
+                                 std::vector<Hit>& out) const {
+    out.clear();
+    if (m_Entries.empty() || !(radius >= 0.0f)) return;
+
+    // 整个查询范围在包围盒之外
+    if (pos.x + radius < m_Min.x || pos.x - radius > m_Max.x ||
+        pos.z + radius < m_Min.z || pos.z - radius > m_Max.z) return;
+
+    i32 x0 = CellX(pos.x - radius), x1 = CellX(pos.x + radius);
+    i32 z0 = CellZ(pos.z - radius), z1 = CellZ(pos.z + radius);
+
+    for (i32 z = z0; z <= z1; z++) {
+        u32 row = (u32)z * m_Width;
+        // 同一行相邻格子的条目也连续，整行一段区间扫完
+        u32 begin = m_CellStart[row + (u32)x0];
+        u32 end = m_CellStart[row + (u32)x1 + 1];
+        for (u32 i = begin; i < end; i++) {
+            const Entry& e = m_Entries[i];
+            if (e.EntityID == excludeID) continue;
+            f32 dist = glm::length(e.Position - pos);
+            if (dist > radius) continue;
+            out.push_back({i, dist});
+        }
+    }
+
+    std::sort(out.begin(), out.end(),
+        [this](const Hit& a, const Hit& b) { return HitLess(a, b, m_Entries); });
+}
+
+void AISpatialIndex::QueryKNearest(const glm::vec3& pos, u32 k, f32 maxRadius, u32 excludeID,
+                                   std::vector<Hit>& out) const {
+    out.clear();
+    if (m_Entries.empty() || k == 0) return;
+
+    // 到包围盒最远角的距离: 半径达到它就已覆盖全部条目
+    glm::vec3 far = glm::max(glm::abs(m_Min - pos), glm::abs(m_Max - pos));
+    f32 reach = glm::length(far);
+    // max_radius 默认 inf: 封顶到 reach，结果不变
+    maxRadius = std::min(maxRadius, reach);
+
+    // 从一格开始倍增半径，直到找够 k 个 (半径内找够时，第 k 近一定在半径内)
+    f32 radius = m_GridCellSize;
+    for (;;) {
+        f32 r = std::min(radius, maxRadius);
+        QueryRadius(pos, r, excludeID, out);
+        if (out.size() >= k || r >= maxRadius || r >= reach) break;
+        radius *= 2.0f;
+    }
+    if (out.size() > k) out.resize(k);
+}
+
+const std::vector<u32>& AISpatialIndex::GetSquadMembers(u32 squadID) const {
+    static const std::vector<u32> s_Empty;
+    auto it = m_Squads.find(squadID);
+    return it != m_Squads.end() ? it->second : s_Empty;
+}
+
+} // namespace AI
+} // namespace Engine
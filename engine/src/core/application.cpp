@@ -13,12 +13,15 @@
 #include "engine/renderer/particle.h"
 #include "engine/renderer/sprite_batch.h"
 #include "engine/renderer/scene_renderer.h"
+#include "engine/renderer/texture_streamer.h"
 #include "engine/audio/audio_engine.h"
 #include "engine/debug/debug_draw.h"
 #include "engine/debug/debug_ui.h"
 #include "engine/debug/profiler.h"
 #include "engine/renderer/vulkan/vulkan_context.h"
 
+#include <filesystem>
+
 namespace Engine {
 
 Application* Application::s_Instance = nullptr;
@@ -40,6 +43,10 @@ Application::Application(const ApplicationConfig& config)
 
     InitSubsystems();
 
+    for (const auto& pack : config.AssetPacks) {
+        if (std::filesystem::exists(pack)) ResourceManager::MountPack(pack);
+    }
+
     LOG_INFO("[Application] 初始化完成");
 }
 
@@ -105,6 +112,9 @@ void Application::InitSubsystems() {
 
     JobSystem::Init();
     AsyncLoader::Init();
+    if (m_Backend == GraphicsBackend::OpenGL) {
+        TextureStreamer::Init();
+    }
 
     // SceneRenderer (延迟渲染管线)
     SceneRendererConfig renderCfg;
@@ -130,10 +140,12 @@ void Application::ShutdownSubsystems() {
 
     AudioEngine::Shutdown();
     SceneRenderer::Shutdown();
+    TextureStreamer::Shutdown();
     AsyncLoader::Shutdown();
     JobSystem::Shutdown();
     SceneManager::Clear();
     ResourceManager::Clear();
+    ResourceManager::UnmountPacks();
     if (m_Backend == GraphicsBackend::Vulkan) {
 #ifdef ENGINE_ENABLE_VULKAN
         VulkanRenderer::Shutdown();
@@ -165,7 +177,8 @@ void Application::Run() {
 
         f32 dt = Time::DeltaTime();
 
-        // 异步资源上传
+        // 异步资源上传 (纹理按字节预算逐 mip 流送，模型按数量)
+        TextureStreamer::Update();
         AsyncLoader::FlushUploads(4);
 
         // 窗口 Resize 检测
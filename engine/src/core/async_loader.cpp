@@ -2,8 +2,7 @@
 #include "engine/core/job_system.h"
 #include "engine/core/resource_manager.h"
 #include "engine/core/log.h"
-
-#include "stb_image.h"
+#include "engine/renderer/texture_streamer.h"
 
 #include <algorithm>
 
@@ -11,9 +10,7 @@ namespace Engine {
 
 // ── 静态成员定义 ────────────────────────────────────────────
 
-std::queue<TextureLoadResult>  AsyncLoader::s_TextureQueue;
 std::queue<MeshLoadResult>     AsyncLoader::s_MeshQueue;
-std::mutex                     AsyncLoader::s_TextureMutex;
 std::mutex                     AsyncLoader::s_MeshMutex;
 std::atomic<u32>               AsyncLoader::s_InFlight{0};
 bool                           AsyncLoader::s_Initialized = false;
@@ -33,16 +30,6 @@ void AsyncLoader::Shutdown() {
     JobSystem::WaitIdle();
 
     // 清理队列中未上传的数据
-    {
-        std::lock_guard<std::mutex> lock(s_TextureMutex);
-        while (!s_TextureQueue.empty()) {
-            auto& item = s_TextureQueue.front();
-            if (item.PixelData) {
-                stbi_image_free(item.PixelData);
-            }
-            s_TextureQueue.pop();
-        }
-    }
     {
         std::lock_guard<std::mutex> lock(s_MeshMutex);
         while (!s_MeshQueue.empty()) {
@@ -60,58 +47,22 @@ void AsyncLoader::Shutdown() {
 void AsyncLoader::LoadTextureAsync(const std::string& name,
                                     const std::string& filepath,
                                     std::function<void(Ref<Texture2D>)> callback) {
-    if (!s_Initialized) {
+    if (!s_Initialized || !TextureStreamer::IsActive()) {
         LOG_WARN("[AsyncLoader] 未初始化，回退到同步加载: %s", name.c_str());
         auto tex = ResourceManager::LoadTexture(name, filepath);
         if (callback) callback(tex);
         return;
     }
 
-    // 检查缓存
-    auto cached = ResourceManager::GetTexture(name);
-    if (cached) {
-        if (callback) callback(cached);
+    // 资源包内已是 GPU 就绪的 mip 链，无需解码，直接同步上传
+    if (ResourceManager::FindPacked(filepath, PackAssetType::Texture)) {
+        auto tex = ResourceManager::LoadTexture(name, filepath);
+        if (callback) callback(tex);
         return;
     }
 
-    s_InFlight++;
-
-    // 捕获到 lambda 中
-    std::string capName = name;
-    std::string capPath = filepath;
-    auto capCallback = std::move(callback);
-
-    JobSystem::Submit([capName, capPath, capCallback]() {
-        // ── 工作线程：纯 CPU 操作 ──────────────────────────────
-        stbi_set_flip_vertically_on_load(1);
-
-        int w, h, ch;
-        unsigned char* data = stbi_load(capPath.c_str(), &w, &h, &ch, 0);
-
-        if (!data) {
-            LOG_ERROR("[AsyncLoader] 纹理解码失败: %s", capPath.c_str());
-            s_InFlight--;
-            return;
-        }
-
-        LOG_DEBUG("[AsyncLoader] 纹理解码完成: %s (%dx%d, %d通道)", 
-                  capPath.c_str(), w, h, ch);
-
-        // 推入完成队列
-        TextureLoadResult result;
-        result.Name = capName;
-        result.FilePath = capPath;
-        result.PixelData = data;
-        result.Width = w;
-        result.Height = h;
-        result.Channels = ch;
-        result.Callback = capCallback;
-
-        {
-            std::lock_guard<std::mutex> lock(s_TextureMutex);
-            s_TextureQueue.push(std::move(result));
-        }
-    });
+    // 解码 + mip 生成 + 分帧上传全部由 TextureStreamer 负责
+    TextureStreamer::Request(name, filepath, std::move(callback));
 }
 
 // ── 异步模型加载 ────────────────────────────────────────────
@@ -155,42 +106,6 @@ void AsyncLoader::FlushUploads(u32 budget) {
 
     u32 uploaded = 0;
 
-    // ── 纹理上传 ────────────────────────────────────────────
-    while (budget == 0 || uploaded < budget) {
-        TextureLoadResult item;
-        {
-            std::lock_guard<std::mutex> lock(s_TextureMutex);
-            if (s_TextureQueue.empty()) break;
-            item = std::move(s_TextureQueue.front());
-            s_TextureQueue.pop();
-        }
-
-        // 主线程: 创建 GL 纹理
-        auto tex = std::make_shared<Texture2D>(
-            (u32)item.Width, (u32)item.Height, (u32)item.Channels, item.PixelData);
-
-        // 释放 CPU 像素数据
-        stbi_image_free(item.PixelData);
-        item.PixelData = nullptr;
-
-        if (tex->IsValid()) {
-            // 存入全局缓存
-            ResourceManager::CacheTexture(item.Name, tex);
-            LOG_INFO("[AsyncLoader] 纹理上传完成: %s (%dx%d)", 
-                     item.Name.c_str(), item.Width, item.Height);
-        } else {
-            LOG_ERROR("[AsyncLoader] 纹理 GPU 上传失败: %s", item.Name.c_str());
-        }
-
-        // 回调
-        if (item.Callback) {
-            item.Callback(tex);
-        }
-
-        s_InFlight--;
-        uploaded++;
-    }
-
     // ── 模型上传 ────────────────────────────────────────────
     while (budget == 0 || uploaded < budget) {
         MeshLoadResult item;
@@ -216,15 +131,12 @@ void AsyncLoader::FlushUploads(u32 budget) {
 // ── 状态查询 ────────────────────────────────────────────────
 
 bool AsyncLoader::IsIdle() {
-    return s_InFlight == 0;
+    return s_InFlight == 0 && TextureStreamer::IsIdle();
 }
 
 u32 AsyncLoader::GetPendingUploadCount() {
     u32 count = 0;
-    {
-        std::lock_guard<std::mutex> lock(s_TextureMutex);
-        count += (u32)s_TextureQueue.size();
-    }
+    count += TextureStreamer::GetStreamingCount();
     {
         std::lock_guard<std::mutex> lock(s_MeshMutex);
         count += (u32)s_MeshQueue.size();
@@ -233,7 +145,7 @@ u32 AsyncLoader::GetPendingUploadCount() {
 }
 
 u32 AsyncLoader::GetInFlightCount() {
-    return s_InFlight.load();
+    return s_InFlight.load() + TextureStreamer::GetInFlightCount();
 }
 
 } // namespace Engine
@@ -0,0 +1,560 @@
+#include "engine/core/cooked_asset.h"
+#include "engine/core/log.h"
+
+#include <cstring>
+#include <type_traits>
+
+namespace Engine {
+
+namespace {
+
+// ── 对齐工具 ────────────────────────────────────────────────
+
+constexpr u64 BLOB_ALIGN = 16;
+
+inline u64 AlignUp(u64 v) { return (v + BLOB_ALIGN - 1) & ~(BLOB_ALIGN - 1); }
+
+inline void PadTo(std::vector<u8>& out, u64 offset) {
+    if (out.size() < offset) out.resize(offset, 0);
+}
+
+template<typename T>
+inline void Append(std::vector<u8>& out, const T& value) {
+    const u8* p = (const u8*)&value;
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+// ── 顺序写 / 读 (预制体、LDtk 等变长结构) ────────────────────
+
+class BlobWriter {
+public:
+    explicit BlobWriter(std::vector<u8>& out) : m_Out(out) {}
+
+    void U8(u8 v)   { m_Out.push_back(v); }
+    void U32(u32 v) { Append(m_Out, v); }
+    void I32(i32 v) { Append(m_Out, v); }
+    void F32(f32 v) { Append(m_Out, v); }
+    void Str(const std::string& s) {
+        U32((u32)s.size());
+        m_Out.insert(m_Out.end(), s.begin(), s.end());
+    }
+    void Bytes(const void* data, size_t size) {
+        m_Out.insert(m_Out.end(), (const u8*)data, (const u8*)data + size);
+    }
+
+private:
+    std::vector<u8>& m_Out;
+};
+
+class BlobReader {
+public:
+    BlobReader(const u8* data, size_t size) : m_Cur(data), m_End(data + size) {}
+
+    bool Ok() const { return m_Ok; }
+
+    u8  U8()  { u8 v = 0;  Bytes(&v, 1); return v; }
+    u32 U32() { u32 v = 0; Bytes(&v, 4); return v; }
+    i32 I32() { i32 v = 0; Bytes(&v, 4); return v; }
+    f32 F32() { f32 v = 0; Bytes(&v, 4); return v; }
+    std::string Str() {
+        u32 len = U32();
+        if (!Check(len)) return {};
+        std::string s((const char*)m_Cur, len);
+        m_Cur += len;
+        return s;
+    }
+    bool Bytes(void* dst, size_t size) {
+        if (!Check(size)) return false;
+        std::memcpy(dst, m_Cur, size);
+        m_Cur += size;
+        return true;
+    }
+    /// 数组长度读取: 超出剩余字节数 (按最小元素大小估算) 视为损坏
+    u32 Count(size_t minElemSize) {
+        u32 n = U32();
+        if (minElemSize && (size_t)n > (size_t)(m_End - m_Cur) / minElemSize) m_Ok = false;
+        return m_Ok ? n : 0;
+    }
+
+private:
+    bool Check(size_t size) {
+        if (!m_Ok || (size_t)(m_End - m_Cur) < size) { m_Ok = false; return false; }
+        return true;
+    }
+
+    const u8* m_Cur;
+    const u8* m_End;
+    bool m_Ok = true;
+};
+
+// ── 模型布局 ────────────────────────────────────────────────
+
+struct ModelHeader {
+    u32 Magic;
+    u32 Version;
+    u32 MeshCount;
+    u32 StringsSize;
+    u64 StringsOffset;
+};
+
+struct SubmeshRecord {
+    u32 NameOffset;
+    u32 AlbedoOffset;
+    u32 NormalOffset;
+    u32 MetallicRoughnessOffset;
+    u32 VertexCount;
+    u32 IndexCount;
+    u64 VertexOffset;
+    u64 IndexOffset;
+    u32 VertexFormat;            // CookedVertexFormat
+    u32 MeshletCount;
+    u32 MeshletVertexCount;
+    u32 MeshletTriangleBytes;
+    u64 MeshletOffset;
+    u64 MeshletVertexOffset;
+    u64 MeshletTriangleOffset;
+};
+
+static_assert(sizeof(Meshlet) == 48, "Meshlet 布局变化需要提升 COOKED_MODEL_VERSION");
+
+inline u64 VertexStride(u32 format) {
+    return format == (u32)CookedVertexFormat::Packed ? sizeof(PackedMeshVertex) : sizeof(MeshVertex);
+}
+
+// ── 纹理布局 ────────────────────────────────────────────────
+
+struct TextureHeader {
+    u32 Magic;
+    u32 Version;
+    u32 Width;
+    u32 Height;
+    u32 Channels;
+    u32 Format;
+    u32 LevelCount;
+    u32 Reserved;
+};
+
+static_assert(sizeof(ModelHeader) == 24 && sizeof(SubmeshRecord) == 80, "模型布局变化需要提升版本");
+static_assert(sizeof(TextureHeader) == 32 && sizeof(CookedMipLevel) == 24, "纹理布局变化需要提升版本");
+
+// ── 预制体蓝图 ──────────────────────────────────────────────
+
+void WriteBlueprint(BlobWriter& w, const EntityBlueprint& bp) {
+    w.Str(bp.Name);
+    w.U32((u32)bp.Components.size());
+    for (const auto& snap : bp.Components) {
+        w.Str(snap.TypeName);
+        w.U32((u32)snap.FloatValues.size());
+        for (const auto& [k, v] : snap.FloatValues) { w.Str(k); w.F32(v); }
+        w.U32((u32)snap.StringValues.size());
+        for (const auto& [k, v] : snap.StringValues) { w.Str(k); w.Str(v); }
+    }
+    w.U32((u32)bp.Children.size());
+    for (const auto& child : bp.Children) WriteBlueprint(w, child);
+}
+
+bool ReadBlueprint(BlobReader& r, EntityBlueprint& bp, u32 depth) {
+    if (depth > 64) return false;   // 防御损坏数据导致的无限递归
+    bp.Name = r.Str();
+    u32 compCount = r.Count(12);
+    bp.Components.resize(compCount);
+    for (auto& snap : bp.Components) {
+        snap.TypeName = r.Str();
+        u32 floatCount = r.Count(8);
+        for (u32 i = 0; i < floatCount && r.Ok(); i++) {
+            std::string key = r.Str();
+            snap.FloatValues[key] = r.F32();
+        }
+        u32 strCount = r.Count(8);
+        for (u32 i = 0; i < strCount && r.Ok(); i++) {
+            std::string key = r.Str();
+            snap.StringValues[key] = r.Str();
+        }
+    }
+    u32 childCount = r.Count(12);
+    bp.Children.resize(childCount);
+    for (auto& child : bp.Children) {
+        if (!ReadBlueprint(r, child, depth + 1)) return false;
+    }
+    return r.Ok();
+}
+
+} // namespace
+
+// ── 模型 ────────────────────────────────────────────────────
+
+void CookedAsset::WriteModel(const std::vector<MeshCpuData>& meshes, std::vector<u8>& out,
+                             const CookedModelOptions& options) {
+    out.clear();
+
+    // 字符串表: offset 0 固定为空串
+    std::string strings(1, '\0');
+    auto addString = [&](const std::string& s) -> u32 {
+        if (s.empty()) return 0;
+        u32 offset = (u32)strings.size();
+        strings.append(s);
+        strings.push_back('\0');
+        return offset;
+    };
+
+    // 可选的派生数据 (量化顶点 / meshlet) 先算好，才能确定布局
+    std::vector<std::vector<PackedMeshVertex>> packed(options.Quantize ? meshes.size() : 0);
+    std::vector<MeshletData> meshlets(options.Meshlets ? meshes.size() : 0);
+
+    std::vector<SubmeshRecord> records(meshes.size());
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const auto& m = meshes[i];
+        auto& rec = records[i];
+        rec = {};
+        rec.NameOffset = addString(m.Name);
+        rec.AlbedoOffset = addString(m.AlbedoTexPath);
+        rec.NormalOffset = addString(m.NormalTexPath);
+        rec.MetallicRoughnessOffset = addString(m.MetallicRoughnessTexPath);
+        rec.VertexCount = (u32)m.Vertices.size();
+        rec.IndexCount = (u32)m.Indices.size();
+        rec.VertexFormat = (u32)CookedVertexFormat::Full;
+        if (options.Quantize) {
+            MeshOptimizer::Quantize(m.Vertices.data(), rec.VertexCount, packed[i]);
+            rec.VertexFormat = (u32)CookedVertexFormat::Packed;
+        }
+        if (options.Meshlets) {
+            MeshOptimizer::BuildMeshlets(m.Vertices.data(), rec.VertexCount,
+                                         m.Indices.data(), rec.IndexCount, meshlets[i]);
+            rec.MeshletCount = (u32)meshlets[i].Meshlets.size();
+            rec.MeshletVertexCount = (u32)meshlets[i].Vertices.size();
+            rec.MeshletTriangleBytes = (u32)meshlets[i].Triangles.size();
+        }
+    }
+
+    // 布局: header | records | strings | [vertices | indices | meshlets…] × N (各自 16 对齐)
+    u64 cursor = sizeof(ModelHeader) + records.size() * sizeof(SubmeshRecord);
+    u64 stringsOffset = cursor;
+    cursor = AlignUp(cursor + strings.size());
+    for (auto& rec : records) {
+        rec.VertexOffset = cursor;
+        cursor = AlignUp(cursor + (u64)rec.VertexCount * VertexStride(rec.VertexFormat));
+        rec.IndexOffset = cursor;
+        cursor = AlignUp(cursor + (u64)rec.IndexCount * sizeof(u32));
+        if (rec.MeshletCount) {
+            rec.MeshletOffset = cursor;
+            cursor = AlignUp(cursor + (u64)rec.MeshletCount * sizeof(Meshlet));
+            rec.MeshletVertexOffset = cursor;
+            cursor = AlignUp(cursor + (u64)rec.MeshletVertexCount * sizeof(u32));
+            rec.MeshletTriangleOffset = cursor;
+            cursor = AlignUp(cursor + rec.MeshletTriangleBytes);
+        }
+    }
+
+    ModelHeader header{COOKED_MODEL_MAGIC, COOKED_MODEL_VERSION, (u32)meshes.size(),
+                       (u32)strings.size(), stringsOffset};
+    out.reserve(cursor);
+    Append(out, header);
+    for (const auto& rec : records) Append(out, rec);
+    out.insert(out.end(), strings.begin(), strings.end());
+
+    auto write = [&](u64 offset, const void* data, size_t size) {
+        PadTo(out, offset);
+        out.insert(out.end(), (const u8*)data, (const u8*)data + size);
+    };
+    for (size_t i = 0; i < meshes.size(); i++) {
+        const auto& rec = records[i];
+        if (options.Quantize) {
+            write(rec.VertexOffset, packed[i].data(), packed[i].size() * sizeof(PackedMeshVertex));
+        } else {
+            write(rec.VertexOffset, meshes[i].Vertices.data(), meshes[i].Vertices.size() * sizeof(MeshVertex));
+        }
+        write(rec.IndexOffset, meshes[i].Indices.data(), meshes[i].Indices.size() * sizeof(u32));
+        if (rec.MeshletCount) {
+            const auto& ml = meshlets[i];
+            write(rec.MeshletOffset, ml.Meshlets.data(), ml.Meshlets.size() * sizeof(Meshlet));
+            write(rec.MeshletVertexOffset, ml.Vertices.data(), ml.Vertices.size() * sizeof(u32));
+            write(rec.MeshletTriangleOffset, ml.Triangles.data(), ml.Triangles.size());
+        }
+    }
+    PadTo(out, cursor);
+}
+
+bool CookedAsset::ReadModel(const u8* data, size_t size, std::vector<CookedMeshView>& out) {
+    out.clear();
+    if (size < sizeof(ModelHeader)) return false;
+
+    const auto* header = (const ModelHeader*)data;
+    if (header->Magic != COOKED_MODEL_MAGIC || header->Version != COOKED_MODEL_VERSION) {
+        LOG_ERROR("[Cooked] 模型格式不匹配 (version=%u, 需要 %u)", header->Version, COOKED_MODEL_VERSION);
+        return false;
+    }
+    u64 recordsEnd = sizeof(ModelHeader) + (u64)header->MeshCount * sizeof(SubmeshRecord);
+    if (recordsEnd > size || header->StringsOffset + header->StringsSize > size ||
+        header->StringsSize == 0 || data[header->StringsOffset + header->StringsSize - 1] != '\0') {
+        LOG_ERROR("[Cooked] 模型头部损坏");
+        return false;
+    }
+
+    const auto* records = (const SubmeshRecord*)(data + sizeof(ModelHeader));
+    const char* strings = (const char*)(data + header->StringsOffset);
+    auto str = [&](u32 offset) { return offset < header->StringsSize ? strings + offset : ""; };
+
+    out.reserve(header->MeshCount);
+    for (u32 i = 0; i < header->MeshCount; i++) {
+        const auto& rec = records[i];
+        bool packed = rec.VertexFormat == (u32)CookedVertexFormat::Packed;
+        if (rec.VertexFormat > (u32)CookedVertexFormat::Packed ||
+            rec.VertexOffset + (u64)rec.VertexCount * VertexStride(rec.VertexFormat) > size ||
+            rec.IndexOffset + (u64)rec.IndexCount * sizeof(u32) > size ||
+            (rec.MeshletCount &&
+             (rec.MeshletOffset + (u64)rec.MeshletCount * sizeof(Meshlet) > size ||
+              rec.MeshletVertexOffset + (u64)rec.MeshletVertexCount * sizeof(u32) > size ||
+              rec.MeshletTriangleOffset + rec.MeshletTriangleBytes > size))) {
+            LOG_ERROR("[Cooked] 子网格 %u 越界", i);
+            out.clear();
+            return false;
+        }
+        CookedMeshView view;
+        view.Name = str(rec.NameOffset);
+        if (packed) view.PackedVertices = (const PackedMeshVertex*)(data + rec.VertexOffset);
+        else        view.Vertices = (const MeshVertex*)(data + rec.VertexOffset);
+        view.VertexCount = rec.VertexCount;
+        view.Indices = (const u32*)(data + rec.IndexOffset);
+        view.IndexCount = rec.IndexCount;
+        view.AlbedoTexPath = str(rec.AlbedoOffset);
+        view.NormalTexPath = str(rec.NormalOffset);
+        view.MetallicRoughnessTexPath = str(rec.MetallicRoughnessOffset);
+        if (rec.MeshletCount) {
+            view.Meshlets = (const Meshlet*)(data + rec.MeshletOffset);
+            view.MeshletCount = rec.MeshletCount;
+            view.MeshletVertices = (const u32*)(data + rec.MeshletVertexOffset);
+            view.MeshletTriangles = data + rec.MeshletTriangleOffset;
+        }
+        out.push_back(view);
+    }
+    return true;
+}
+
+// ── 纹理 ────────────────────────────────────────────────────
+
+bool CookedAsset::WriteTexture(const MipChain& chain, CookedTextureFormat format, std::vector<u8>& out) {
+    out.clear();
+    if (chain.Levels.empty()) return false;
+
+    u32 levelCount = chain.GetLevelCount();
+    std::vector<CookedMipLevel> levels(levelCount);
+
+    u64 cursor = AlignUp(sizeof(TextureHeader) + levelCount * sizeof(CookedMipLevel));
+    for (u32 i = 0; i < levelCount; i++) {
+        const MipLevel& src = chain.Levels[i];
+        levels[i].Width = src.Width;
+        levels[i].Height = src.Height;
+        levels[i].Offset = cursor;
+        switch (format) {
+            case CookedTextureFormat::BC1:
+                levels[i].Size = BcEncoder::GetCompressedSize(BcFormat::BC1, src.Width, src.Height); break;
+            case CookedTextureFormat::BC3:
+                levels[i].Size = BcEncoder::GetCompressedSize(BcFormat::BC3, src.Width, src.Height); break;
+            default:
+                levels[i].Size = src.Size; break;
+        }
+        cursor = AlignUp(cursor + levels[i].Size);
+    }
+
+    TextureHeader header{COOKED_TEX_MAGIC, COOKED_TEX_VERSION, chain.Width, chain.Height,
+                         chain.Channels, (u32)format, levelCount, 0};
+    out.reserve(cursor);
+    Append(out, header);
+    for (const auto& lv : levels) Append(out, lv);
+    out.resize(cursor, 0);
+
+    for (u32 i = 0; i < levelCount; i++) {
+        const MipLevel& src = chain.Levels[i];
+        u8* dst = out.data() + levels[i].Offset;
+        if (format == CookedTextureFormat::Raw8) {
+            std::memcpy(dst, chain.GetLevelData(i), src.Size);
+        } else {
+            BcFormat bc = (format == CookedTextureFormat::BC1) ? BcFormat::BC1 : BcFormat::BC3;
+            BcEncoder::EncodeImage(chain.GetLevelData(i), src.Width, src.Height,
+                                   chain.Channels, bc, dst);
+        }
+    }
+    return true;
+}
+
+bool CookedAsset::ReadTexture(const u8* data, size_t size, CookedTextureView& out) {
+    if (size < sizeof(TextureHeader)) return false;
+
+    const auto* header = (const TextureHeader*)data;
+    if (header->Magic != COOKED_TEX_MAGIC || header->Version != COOKED_TEX_VERSION) {
+        LOG_ERROR("[Cooked] 纹理格式不匹配 (version=%u, 需要 %u)", header->Version, COOKED_TEX_VERSION);
+        return false;
+    }
+    if (header->LevelCount == 0 || header->Format > (u32)CookedTextureFormat::BC3 ||
+        sizeof(TextureHeader) + (u64)header->LevelCount * sizeof(CookedMipLevel) > size) {
+        LOG_ERROR("[Cooked] 纹理头部损坏");
+        return false;
+    }
+
+    const auto* levels = (const CookedMipLevel*)(data + sizeof(TextureHeader));
+    for (u32 i = 0; i < header->LevelCount; i++) {
+        if (levels[i].Offset + levels[i].Size > size) {
+            LOG_ERROR("[Cooked] 纹理 mip %u 越界", i);
+            return false;
+        }
+    }
+
+    out.Width = header->Width;
+    out.Height = header->Height;
+    out.Channels = header->Channels;
+    out.Format = (CookedTextureFormat)header->Format;
+    out.LevelCount = header->LevelCount;
+    out.Levels = levels;
+    out.Base = data;
+    return true;
+}
+
+// ── 预制体 ──────────────────────────────────────────────────
+
+void CookedAsset::WritePrefab(const Prefab& prefab, std::vector<u8>& out) {
+    out.clear();
+    BlobWriter w(out);
+    w.U32(COOKED_PREFAB_MAGIC);
+    w.U32(COOKED_DATA_VERSION);
+    w.Str(prefab.GetName());
+    WriteBlueprint(w, prefab.GetRoot());
+}
+
+Ref<Prefab> CookedAsset::ReadPrefab(const u8* data, size_t size) {
+    BlobReader r(data, size);
+    if (r.U32() != COOKED_PREFAB_MAGIC || r.U32() != COOKED_DATA_VERSION) {
+        LOG_ERROR("[Cooked] 预制体格式不匹配");
+        return nullptr;
+    }
+    auto prefab = std::make_shared<Prefab>(r.Str());
+    if (!ReadBlueprint(r, prefab->GetRoot(), 0)) {
+        LOG_ERROR("[Cooked] 预制体数据损坏: %s", prefab->GetName().c_str());
+        return nullptr;
+    }
+    return prefab;
+}
+
+// ── LDtk ────────────────────────────────────────────────────
+
+static_assert(std::is_trivially_copyable_v<LdtkTile>, "LdtkTile 需可整块拷贝");
+
+void CookedAsset::WriteLdtk(const LdtkProject& project, std::vector<u8>& out) {
+    out.clear();
+    BlobWriter w(out);
+    w.U32(COOKED_LDTK_MAGIC);
+    w.U32(COOKED_DATA_VERSION);
+    w.U32((u32)sizeof(LdtkTile));
+    w.Str(project.basePath);
+    w.I32(project.defaultGridSize);
+
+    w.U32((u32)project.levels.size());
+    for (const auto& level : project.levels) {
+        w.Str(level.identifier);
+        w.I32(level.uid);
+        w.I32(level.worldX); w.I32(level.worldY);
+        w.I32(level.pxWid);  w.I32(level.pxHei);
+
+        w.U32((u32)level.layers.size());
+        for (const auto& layer : level.layers) {
+            w.Str(layer.identifier);
+            w.Str(layer.type);
+            w.I32(layer.gridSize);
+            w.I32(layer.gridW); w.I32(layer.gridH);
+            w.I32(layer.pxOffsetX); w.I32(layer.pxOffsetY);
+            w.F32(layer.parallaxFactorX); w.F32(layer.parallaxFactorY);
+            w.F32(layer.opacity);
+            w.Str(layer.tilesetRelPath);
+            w.I32(layer.tilesetW); w.I32(layer.tilesetH);
+
+            // Tile / IntGrid 为 POD 数组，整块写入
+            w.U32((u32)layer.tiles.size());
+            w.Bytes(layer.tiles.data(), layer.tiles.size() * sizeof(LdtkTile));
+            w.U32((u32)layer.intGrid.size());
+            w.Bytes(layer.intGrid.data(), layer.intGrid.size() * sizeof(i32));
+
+            w.U32((u32)layer.entities.size());
+            for (const auto& ent : layer.entities) {
+                w.Str(ent.identifier);
+                w.I32(ent.px_x); w.I32(ent.px_y);
+                w.I32(ent.width); w.I32(ent.height);
+                w.F32(ent.pivotX); w.F32(ent.pivotY);
+                w.U32((u32)ent.fields.size());
+                for (const auto& [key, value] : ent.fields) {
+                    w.Str(key);
+                    w.U8((u8)value.index());
+                    if (auto* i = std::get_if<i32>(&value))              w.I32(*i);
+                    else if (auto* f = std::get_if<f32>(&value))         w.F32(*f);
+                    else if (auto* b = std::get_if<bool>(&value))        w.U8(*b ? 1 : 0);
+                    else if (auto* s = std::get_if<std::string>(&value)) w.Str(*s);
+                }
+            }
+        }
+    }
+}
+
+bool CookedAsset::ReadLdtk(const u8* data, size_t size, LdtkProject& project) {
+    BlobReader r(data, size);
+    if (r.U32() != COOKED_LDTK_MAGIC || r.U32() != COOKED_DATA_VERSION ||
+        r.U32() != (u32)sizeof(LdtkTile)) {
+        LOG_ERROR("[Cooked] LDtk 格式不匹配");
+        return false;
+    }
+    project.basePath = r.Str();
+    project.defaultGridSize = r.I32();
+
+    project.levels.resize(r.Count(28));
+    for (auto& level : project.levels) {
+        level.identifier = r.Str();
+        level.uid = r.I32();
+        level.worldX = r.I32(); level.worldY = r.I32();
+        level.pxWid = r.I32();  level.pxHei = r.I32();
+
+        level.layers.resize(r.Count(60));
+        for (auto& layer : level.layers) {
+            layer.identifier = r.Str();
+            layer.type = r.Str();
+            layer.gridSize = r.I32();
+            layer.gridW = r.I32(); layer.gridH = r.I32();
+            layer.pxOffsetX = r.I32(); layer.pxOffsetY = r.I32();
+            layer.parallaxFactorX = r.F32(); layer.parallaxFactorY = r.F32();
+            layer.opacity = r.F32();
+            layer.tilesetRelPath = r.Str();
+            layer.tilesetW = r.I32(); layer.tilesetH = r.I32();
+
+            layer.tiles.resize(r.Count(sizeof(LdtkTile)));
+            r.Bytes(layer.tiles.data(), layer.tiles.size() * sizeof(LdtkTile));
+            layer.intGrid.resize(r.Count(sizeof(i32)));
+            r.Bytes(layer.intGrid.data(), layer.intGrid.size() * sizeof(i32));
+
+            layer.entities.resize(r.Count(32));
+            for (auto& ent : layer.entities) {
+                ent.identifier = r.Str();
+                ent.px_x = r.I32(); ent.px_y = r.I32();
+                ent.width = r.I32(); ent.height = r.I32();
+                ent.pivotX = r.F32(); ent.pivotY = r.F32();
+                u32 fieldCount = r.Count(5);
+                for (u32 i = 0; i < fieldCount && r.Ok(); i++) {
+                    std::string key = r.Str();
+                    switch (r.U8()) {
+                        case 0: ent.fields[key] = r.I32(); break;
+                        case 1: ent.fields[key] = r.F32(); break;
+                        case 2: ent.fields[key] = (r.U8() != 0); break;
+                        case 3: ent.fields[key] = r.Str(); break;
+                        default: return false;
+                    }
+                }
+            }
+            if (!r.Ok()) break;
+        }
+        if (!r.Ok()) break;
+    }
+
+    if (!r.Ok()) {
+        LOG_ERROR("[Cooked] LDtk 数据损坏");
+        project.levels.clear();
+        return false;
+    }
+    return true;
+}
+
+} // namespace Engine
@@ -28,6 +28,33 @@ Entity ECSWorld::CreateEntity(const std::string& name) {
     return e;
 }
 
+void ECSWorld::CreateEntities(u32 count, std::vector<Entity>& out, const std::string& name) {
+    size_t first = out.size();
+    out.reserve(first + count);
+    m_Entities.reserve(m_Entities.size() + count);
+
+    for (u32 i = 0; i < count; i++) {
+        Entity e;
+        if (!m_FreeList.empty()) {
+            e = m_FreeList.back();
+            m_FreeList.pop_back();
+            m_Generation[e]++;  // 偶数→奇数 = 存活
+        } else {
+            e = m_NextEntity++;
+            if (e >= m_Generation.size()) {
+                // 按批次大小扩容，避免逐个 resize
+                m_Generation.resize(std::max<size_t>((size_t)e + 1, (size_t)e + (count - i)), 0);
+            }
+            m_Generation[e] = 1;
+        }
+        out.push_back(e);
+        m_Entities.push_back(e);
+    }
+
+    AddComponents<TagComponent>(out.data() + first, count,
+        [&](u32, TagComponent& tag) { tag.Name = name; });
+}
+
 void ECSWorld::DestroyEntity(Entity e) {
     // 移除所有组件
     for (auto& [type, pool] : m_Pools) {
@@ -2,9 +2,35 @@
 #include "engine/core/log.h"
 
 #include <algorithm>
+#include <memory>
 
 namespace Engine {
 
+namespace {
+
+/// 一次 RunChunks 调用的块: 参与的线程从 Next 认领，Done 计满时唤醒调用方
+struct ChunkGroup {
+    std::function<void(u32)> Fn;
+    u32 Count = 0;
+    std::atomic<u32> Next{0};
+    std::atomic<u32> Done{0};
+    std::mutex Mutex;
+    std::condition_variable CV;
+};
+
+void DrainChunks(ChunkGroup& group) {
+    u32 c;
+    while ((c = group.Next.fetch_add(1)) < group.Count) {
+        group.Fn(c);
+        if (group.Done.fetch_add(1) + 1 == group.Count) {
+            std::lock_guard<std::mutex> lock(group.Mutex);
+            group.CV.notify_all();
+        }
+    }
+}
+
+} // namespace
+
 // ── 静态成员定义 ────────────────────────────────────────────
 
 std::vector<std::thread>            JobSystem::s_Workers;
@@ -72,6 +98,28 @@ void JobSystem::Submit(std::function<void()> job) {
     s_QueueCV.notify_one();
 }
 
+// ── 分块执行 ────────────────────────────────────────────────
+
+void JobSystem::RunChunks(u32 numChunks, const std::function<void(u32)>& chunkFn) {
+    if (numChunks == 0) return;
+    if (numChunks == 1 || !s_Running) {
+        for (u32 c = 0; c < numChunks; c++) chunkFn(c);
+        return;
+    }
+
+    // 任务持有 group 的引用: 调用方返回后才被取出的任务只会发现块已认领完
+    auto group = std::make_shared<ChunkGroup>();
+    group->Fn = chunkFn;
+    group->Count = numChunks;
+    for (u32 i = 1; i < numChunks; i++) {
+        Submit([group] { DrainChunks(*group); });
+    }
+    DrainChunks(*group);
+
+    std::unique_lock<std::mutex> lock(group->Mutex);
+    group->CV.wait(lock, [&] { return group->Done.load() == numChunks; });
+}
+
 // ── 等待所有任务完成 ────────────────────────────────────────
 
 void JobSystem::WaitIdle() {
@@ -0,0 +1,579 @@
+#include "engine/core/json.h"
+#include "engine/core/simd.h"
+
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+namespace Engine {
+
+// ═══════════════════════════════════════════════════════════════
+// 第一阶段: 结构索引
+// ═══════════════════════════════════════════════════════════════
+
+namespace {
+
+constexpr size_t JSON_BLOCK = 64;
+constexpr u64 ODD_BITS = 0xAAAAAAAAAAAAAAAAull;
+
+/// 一个 64 字节块的字符分类位图 (bit i = 第 i 个字节)
+struct BlockMasks {
+    u64 Quote = 0;
+    u64 Backslash = 0;
+    u64 Op = 0;          // { } [ ] : ,
+    u64 Whitespace = 0;  // 空格 \t \n \r
+};
+
+#if defined(ENGINE_SIMD_SSE2)
+
+inline u64 Mask16(__m128i cmp, int shift) {
+    return (u64)(u16)_mm_movemask_epi8(cmp) << shift;
+}
+
+inline void Classify(const u8* p, BlockMasks& m) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lowerBit = _mm_set1_epi8(0x20);
+    const __m128i braceOpen = _mm_set1_epi8('{');    // '[' | 0x20 == '{'
+    const __m128i braceClose = _mm_set1_epi8('}');   // ']' | 0x20 == '}'
+    const __m128i colon = _mm_set1_epi8(':');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i space = _mm_set1_epi8(' ');
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i lf = _mm_set1_epi8('\n');
+    const __m128i cr = _mm_set1_epi8('\r');
+
+    for (int k = 0; k < 4; k++) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(p + k * 16));
+        __m128i lower = _mm_or_si128(v, lowerBit);
+        __m128i op = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(lower, braceOpen), _mm_cmpeq_epi8(lower, braceClose)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, colon), _mm_cmpeq_epi8(v, comma)));
+        __m128i ws = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(v, tab)),
+            _mm_or_si128(_mm_cmpeq_epi8(v, lf), _mm_cmpeq_epi8(v, cr)));
+
+        m.Quote      |= Mask16(_mm_cmpeq_epi8(v, quote), k * 16);
+        m.Backslash  |= Mask16(_mm_cmpeq_epi8(v, backslash), k * 16);
+        m.Op         |= Mask16(op, k * 16);
+        m.Whitespace |= Mask16(ws, k * 16);
+    }
+}
+
+#elif defined(ENGINE_SIMD_NEON)
+
+/// 4 个 16 字节比较结果 → 64 位掩码
+inline u64 MoveMask64(uint8x16_t c0, uint8x16_t c1, uint8x16_t c2, uint8x16_t c3) {
+    const uint8x16_t bits = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t s0 = vpaddq_u8(vandq_u8(c0, bits), vandq_u8(c1, bits));
+    uint8x16_t s1 = vpaddq_u8(vandq_u8(c2, bits), vandq_u8(c3, bits));
+    s0 = vpaddq_u8(s0, s1);
+    s0 = vpaddq_u8(s0, s0);
+    return vgetq_lane_u64(vreinterpretq_u64_u8(s0), 0);
+}
+
+inline void Classify(const u8* p, BlockMasks& m) {
+    uint8x16_t v[4], q[4], b[4], op[4], ws[4];
+    for (int k = 0; k < 4; k++) {
+        v[k] = vld1q_u8(p + k * 16);
+        uint8x16_t lower = vorrq_u8(v[k], vdupq_n_u8(0x20));
+        q[k] = vceqq_u8(v[k], vdupq_n_u8('"'));
+        b[k] = vceqq_u8(v[k], vdupq_n_u8('\\'));
+        op[k] = vorrq_u8(vorrq_u8(vceqq_u8(lower, vdupq_n_u8('{')), vceqq_u8(lower, vdupq_n_u8('}'))),
+                         vorrq_u8(vceqq_u8(v[k], vdupq_n_u8(':')), vceqq_u8(v[k], vdupq_n_u8(','))));
+        ws[k] = vorrq_u8(vorrq_u8(vceqq_u8(v[k], vdupq_n_u8(' ')), vceqq_u8(v[k], vdupq_n_u8('\t'))),
+                         vorrq_u8(vceqq_u8(v[k], vdupq_n_u8('\n')), vceqq_u8(v[k], vdupq_n_u8('\r'))));
+    }
+    m.Quote      = MoveMask64(q[0], q[1], q[2], q[3]);
+    m.Backslash  = MoveMask64(b[0], b[1], b[2], b[3]);
+    m.Op         = MoveMask64(op[0], op[1], op[2], op[3]);
+    m.Whitespace = MoveMask64(ws[0], ws[1], ws[2], ws[3]);
+}
+
+#else
+
+inline void Classify(const u8* p, BlockMasks& m) {
+    for (u32 i = 0; i < JSON_BLOCK; i++) {
+        u64 bit = 1ull << i;
+        switch (p[i]) {
+            case '"':  m.Quote |= bit; break;
+            case '\\': m.Backslash |= bit; break;
+            case '{': case '}': case '[': case ']': case ':': case ',':
+                m.Op |= bit; break;
+            case ' ': case '\t': case '\n': case '\r':
+                m.Whitespace |= bit; break;
+            default: break;
+        }
+    }
+}
+
+#endif
+
+/// 前缀异或: bit i = x[0] ^ ... ^ x[i] (引号之间置 1)
+inline u64 PrefixXor(u64 x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+/// 被反斜杠转义的字符位置 (奇数长度反斜杠序列之后的字符)
+/// prevEscaped: 上一块末尾是否留有未消费的转义
+inline u64 FindEscaped(u64 backslash, u64& prevEscaped) {
+    if (backslash == 0) {
+        u64 escaped = prevEscaped;
+        prevEscaped = 0;
+        return escaped;
+    }
+    // 减法把每段连续反斜杠的进位推到段尾后一位；与奇偶位比较得到段长奇偶
+    u64 potential = backslash & ~prevEscaped;
+    u64 maybeEscaped = potential << 1;
+    u64 codes = ((maybeEscaped | ODD_BITS) - potential) ^ ODD_BITS;
+    u64 escaped = codes ^ (backslash | prevEscaped);
+    prevEscaped = (codes & backslash) >> 63;
+    return escaped;
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+/// 按 JSON 数字文法扫描 -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+/// 返回数字之后的位置，不合文法时返回 npos
+size_t ScanNumber(std::string_view s, size_t pos) {
+    size_t n = s.size();
+    if (pos < n && s[pos] == '-') pos++;
+    if (pos >= n || !IsDigit(s[pos])) return std::string_view::npos;
+    if (s[pos] == '0') {
+        pos++;   // 不允许前导零
+    } else {
+        while (pos < n && IsDigit(s[pos])) pos++;
+    }
+    if (pos < n && s[pos] == '.') {
+        pos++;
+        if (pos >= n || !IsDigit(s[pos])) return std::string_view::npos;
+        while (pos < n && IsDigit(s[pos])) pos++;
+    }
+    if (pos < n && (s[pos] == 'e' || s[pos] == 'E')) {
+        pos++;
+        if (pos < n && (s[pos] == '+' || s[pos] == '-')) pos++;
+        if (pos >= n || !IsDigit(s[pos])) return std::string_view::npos;
+        while (pos < n && IsDigit(s[pos])) pos++;
+    }
+    return pos;
+}
+
+} // namespace
+
+bool JsonDocument::BuildStructuralIndex(std::string_view json, std::vector<u32>& positions) {
+    positions.clear();
+    positions.reserve(json.size() / 6 + 16);
+
+    const u8* src = (const u8*)json.data();
+    size_t size = json.size();
+
+    u64 prevEscaped = 0;
+    u64 prevInString = 0;      // 全 0 或全 1
+    u64 prevScalar = 0;        // 上一块最后一个字节是否为非引号标量
+
+    alignas(16) u8 tail[JSON_BLOCK];
+
+    for (size_t base = 0; base < size; base += JSON_BLOCK) {
+        const u8* block = src + base;
+        if (size - base < JSON_BLOCK) {
+            // 末尾不足一块: 复制并以空白填充
+            std::memset(tail, ' ', JSON_BLOCK);
+            std::memcpy(tail, block, size - base);
+            block = tail;
+        }
+
+        BlockMasks m;
+        Classify(block, m);
+
+        u64 escaped = FindEscaped(m.Backslash, prevEscaped);
+        u64 quote = m.Quote & ~escaped;
+
+        // 字符串内部 (含起始引号，不含结束引号)
+        u64 inString = PrefixXor(quote) ^ prevInString;
+        prevInString = (u64)((i64)inString >> 63);
+
+        // 标量起点: 非结构符、非空白，且前一个字节不是非引号标量
+        u64 scalar = ~(m.Op | m.Whitespace);
+        u64 nonQuoteScalar = scalar & ~quote;
+        u64 followsScalar = (nonQuoteScalar << 1) | prevScalar;
+        prevScalar = nonQuoteScalar >> 63;
+
+        // 字符串内容与结束引号不是结构位置
+        u64 stringTail = inString ^ quote;
+        u64 structurals = (m.Op | (scalar & ~followsScalar)) & ~stringTail;
+
+        while (structurals) {
+            positions.push_back((u32)(base + std::countr_zero(structurals)));
+            structurals &= structurals - 1;
+        }
+    }
+
+    return prevInString == 0;
+}
+
+// ═══════════════════════════════════════════════════════════════
+// 第二阶段: 语法校验 + 跳转表
+// ═══════════════════════════════════════════════════════════════
+
+bool JsonDocument::Parse(std::string_view json) {
+    m_Owned.clear();
+    m_Source = json;
+    return BuildTape();
+}
+
+bool JsonDocument::Parse(std::string&& json) {
+    m_Owned = std::move(json);
+    m_Source = m_Owned;
+    return BuildTape();
+}
+
+bool JsonDocument::LoadFile(const std::string& path) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        m_Error = "无法打开文件: " + path;
+        m_Tokens.clear();
+        return false;
+    }
+    std::ostringstream ss;
+    ss << file.rdbuf();
+    return Parse(std::move(ss).str());
+}
+
+bool JsonDocument::Fail(u32 token, const char* what) {
+    u32 offset = token < m_Tokens.size() ? m_Tokens[token] : (u32)m_Source.size();
+    u32 line = 1;
+    for (u32 i = 0; i < offset && i < m_Source.size(); i++) {
+        if (m_Source[i] == '\n') line++;
+    }
+    m_Error = std::string(what) + " (第 " + std::to_string(line) + " 行, 偏移 " + std::to_string(offset) + ")";
+    m_Tokens.clear();
+    m_Next.clear();
+    return false;
+}
+
+bool JsonDocument::BuildTape() {
+    m_Error.clear();
+    m_Next.clear();
+
+    if (m_Source.size() >= 0xFFFFFFFFu) {
+        m_Tokens.clear();
+        m_Error = "文件过大 (> 4 GB)";
+        return false;
+    }
+    if (!BuildStructuralIndex(m_Source, m_Tokens)) {
+        return Fail((u32)m_Tokens.size(), "字符串未闭合");
+    }
+    if (m_Tokens.empty()) {
+        return Fail(0, "空文档");
+    }
+
+    enum class State : u8 {
+        Value,              // 期望一个值
+        ArrayFirst,         // '[' 之后: 值或 ']'
+        ArrayNext,          // 数组元素之后: ',' 或 ']'
+        ObjectFirst,        // '{' 之后: 键或 '}'
+        ObjectKey,          // ',' 之后: 键
+        ObjectColon,        // 键之后: ':'
+        ObjectNext,         // 成员值之后: ',' 或 '}'
+        Done,
+    };
+
+    u32 count = (u32)m_Tokens.size();
+    m_Next.resize(count);
+    std::vector<u32> stack;
+    State state = State::Value;
+
+    auto isDelimiter = [&](size_t pos) {
+        if (pos >= m_Source.size()) return true;
+        char c = m_Source[pos];
+        return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == ',' ||
+               c == ']' || c == '}' || c == ':';
+    };
+    auto afterValue = [&]() {
+        if (stack.empty()) return State::Done;
+        return CharAt(stack.back()) == '{' ? State::ObjectNext : State::ArrayNext;
+    };
+
+    for (u32 i = 0; i < count; i++) {
+        u32 pos = m_Tokens[i];
+        char c = m_Source[pos];
+        m_Next[i] = i + 1;
+
+        switch (state) {
+            case State::ArrayFirst:
+                if (c == ']') goto close_container;
+                [[fallthrough]];
+            case State::Value:
+                switch (c) {
+                    case '{': stack.push_back(i); state = State::ObjectFirst; continue;
+                    case '[': stack.push_back(i); state = State::ArrayFirst; continue;
+                    case '"': break;
+                    case 't':
+                        if (m_Source.compare(pos, 4, "true") != 0 || !isDelimiter(pos + 4))
+                            return Fail(i, "非法字面量");
+                        break;
+                    case 'f':
+                        if (m_Source.compare(pos, 5, "false") != 0 || !isDelimiter(pos + 5))
+                            return Fail(i, "非法字面量");
+                        break;
+                    case 'n':
+                        if (m_Source.compare(pos, 4, "null") != 0 || !isDelimiter(pos + 4))
+                            return Fail(i, "非法字面量");
+                        break;
+                    default: {
+                        if (c != '-' && !IsDigit(c)) return Fail(i, "期望值");
+                        // 整个数字都要合文法 (拒绝 "1abc"、"-"、"01"、"1."): 读取时不再校验
+                        size_t end = ScanNumber(m_Source, pos);
+                        if (end == std::string_view::npos || !isDelimiter(end)) return Fail(i, "非法数字");
+                        break;
+                    }
+                }
+                state = afterValue();
+                continue;
+
+            case State::ObjectFirst:
+                if (c == '}') goto close_container;
+                [[fallthrough]];
+            case State::ObjectKey:
+                if (c != '"') return Fail(i, "期望键名");
+                state = State::ObjectColon;
+                continue;
+
+            case State::ObjectColon:
+                if (c != ':') return Fail(i, "期望 ':'");
+                state = State::Value;
+                continue;
+
+            case State::ArrayNext:
+                if (c == ',') { state = State::Value; continue; }
+                if (c == ']') goto close_container;
+                if (m_AllowMissingCommas && (c == '{' || c == '[')) {
+                    // 元素迭代本就跳过可选的 ','，只需放行语法
+                    char prev = CharAt(i - 1);
+                    if (prev == '}' || prev == ']') {
+                        stack.push_back(i);
+                        state = (c == '{') ? State::ObjectFirst : State::ArrayFirst;
+                        continue;
+                    }
+                }
+                return Fail(i, "期望 ',' 或 ']'");
+
+            case State::ObjectNext:
+                if (c == ',') { state = State::ObjectKey; continue; }
+                if (c == '}') goto close_container;
+                return Fail(i, "期望 ',' 或 '}'");
+
+            case State::Done:
+                return Fail(i, "文档结束后存在多余内容");
+        }
+
+    close_container:
+        {
+            char open = CharAt(stack.back());
+            if ((open == '{') != (c == '}')) return Fail(i, "括号不匹配");
+            m_Next[stack.back()] = i + 1;
+            stack.pop_back();
+            state = afterValue();
+        }
+    }
+
+    if (state != State::Done) {
+        return Fail(count, "文档不完整");
+    }
+    return true;
+}
+
+JsonValue JsonDocument::GetRoot() const {
+    if (m_Tokens.empty()) return {};
+    return JsonValue(this, 0);
+}
+
+std::string_view JsonDocument::StringAt(u32 token) const {
+    u32 start = m_Tokens[token] + 1;
+    u32 end = (token + 1 < m_Tokens.size()) ? m_Tokens[token + 1] : (u32)m_Source.size();
+    // 结束引号位于下一个 token 之前 (中间只可能是空白)
+    while (end > start && m_Source[end - 1] != '"') end--;
+    return m_Source.substr(start, end > start ? end - 1 - start : 0);
+}
+
+// ═══════════════════════════════════════════════════════════════
+// JsonValue
+// ═══════════════════════════════════════════════════════════════
+
+JsonType JsonValue::GetType() const {
+    if (!m_Doc) return JsonType::Invalid;
+    switch (m_Doc->CharAt(m_Token)) {
+        case '{': return JsonType::Object;
+        case '[': return JsonType::Array;
+        case '"': return JsonType::String;
+        case 't': case 'f': return JsonType::Bool;
+        case 'n': return JsonType::Null;
+        default:  return JsonType::Number;
+    }
+}
+
+f64 JsonValue::AsF64(f64 def) const {
+    if (!IsNumber()) return def;
+    const char* begin = m_Doc->m_Source.data() + m_Doc->m_Tokens[m_Token];
+    const char* end = m_Doc->m_Source.data() + m_Doc->m_Source.size();
+    f64 v = def;
+    auto res = std::from_chars(begin, end, v);
+    return res.ec == std::errc() ? v : def;
+}
+
+i64 JsonValue::AsI64(i64 def) const {
+    if (!IsNumber()) return def;
+    const char* begin = m_Doc->m_Source.data() + m_Doc->m_Tokens[m_Token];
+    const char* end = m_Doc->m_Source.data() + m_Doc->m_Source.size();
+    i64 v = def;
+    auto res = std::from_chars(begin, end, v);
+    if (res.ec != std::errc()) return def;
+    // 带小数/指数的数字按浮点截断
+    if (res.ptr != end && (*res.ptr == '.' || *res.ptr == 'e' || *res.ptr == 'E')) {
+        return (i64)AsF64((f64)def);
+    }
+    return v;
+}
+
+bool JsonValue::AsBool(bool def) const {
+    if (!IsBool()) return def;
+    return m_Doc->CharAt(m_Token) == 't';
+}
+
+std::string_view JsonValue::AsStringView() const {
+    if (!IsString()) return {};
+    return m_Doc->StringAt(m_Token);
+}
+
+namespace {
+
+void AppendUtf8(std::string& out, u32 cp) {
+    if (cp < 0x80) {
+        out += (char)cp;
+    } else if (cp < 0x800) {
+        out += (char)(0xC0 | (cp >> 6));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += (char)(0xE0 | (cp >> 12));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    } else {
+        out += (char)(0xF0 | (cp >> 18));
+        out += (char)(0x80 | ((cp >> 12) & 0x3F));
+        out += (char)(0x80 | ((cp >> 6) & 0x3F));
+        out += (char)(0x80 | (cp & 0x3F));
+    }
+}
+
+bool ParseHex4(std::string_view s, size_t pos, u32& out) {
+    if (pos + 4 > s.size()) return false;
+    auto res = std::from_chars(s.data() + pos, s.data() + pos + 4, out, 16);
+    return res.ec == std::errc() && res.ptr == s.data() + pos + 4;
+}
+
+} // namespace
+
+std::string JsonValue::AsString(std::string_view def) const {
+    if (!IsString()) return std::string(def);
+    std::string_view raw = m_Doc->StringAt(m_Token);
+    if (raw.find('\\') == std::string_view::npos) return std::string(raw);
+
+    std::string out;
+    out.reserve(raw.size());
+    for (size_t i = 0; i < raw.size(); i++) {
+        char c = raw[i];
+        if (c != '\\' || i + 1 >= raw.size()) {
+            out += c;
+            continue;
+        }
+        char e = raw[++i];
+        switch (e) {
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+                u32 cp = 0;
+                if (!ParseHex4(raw, i + 1, cp)) { out += e; break; }
+                i += 4;
+                // UTF-16 代理对
+                u32 low = 0;
+                if (cp >= 0xD800 && cp < 0xDC00 && i + 2 < raw.size() &&
+                    raw[i + 1] == '\\' && raw[i + 2] == 'u' && ParseHex4(raw, i + 3, low) &&
+                    low >= 0xDC00 && low < 0xE000) {
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                    i += 6;
+                }
+                AppendUtf8(out, cp);
+                break;
+            }
+            default: out += e; break;   // \" \\ \/
+        }
+    }
+    return out;
+}
+
+u32 JsonValue::Size() const {
+    u32 n = 0;
+    if (IsArray()) {
+        for (auto it = Elements().begin(), end = Elements().end(); it != end; ++it) n++;
+    } else if (IsObject()) {
+        for (auto it = Members().begin(), end = Members().end(); it != end; ++it) n++;
+    }
+    return n;
+}
+
+JsonValue JsonValue::operator[](u32 index) const {
+    if (!IsArray()) return {};
+    u32 i = 0;
+    for (JsonValue v : Elements()) {
+        if (i++ == index) return v;
+    }
+    return {};
+}
+
+JsonValue JsonValue::Find(std::string_view key) const {
+    if (!IsObject()) return {};
+    for (const auto& m : Members()) {
+        if (m.Key == key) return m.Value;
+    }
+    return {};
+}
+
+JsonRange<JsonElementIterator> JsonValue::Elements() const {
+    if (!IsArray()) return {{nullptr, 0}, {nullptr, 0}};
+    // 结束迭代器指向 ']'
+    return {{m_Doc, m_Token + 1}, {m_Doc, m_Doc->Skip(m_Token) - 1}};
+}
+
+JsonRange<JsonMemberIterator> JsonValue::Members() const {
+    if (!IsObject()) return {{nullptr, 0}, {nullptr, 0}};
+    return {{m_Doc, m_Token + 1}, {m_Doc, m_Doc->Skip(m_Token) - 1}};
+}
+
+JsonElementIterator& JsonElementIterator::operator++() {
+    u32 next = m_Doc->Skip(m_Token);
+    m_Token = (m_Doc->CharAt(next) == ',') ? next + 1 : next;
+    return *this;
+}
+
+JsonMember JsonMemberIterator::operator*() const {
+    return {m_Doc->StringAt(m_Token), JsonValue(m_Doc, m_Token + 2)};
+}
+
+JsonMemberIterator& JsonMemberIterator::operator++() {
+    u32 next = m_Doc->Skip(m_Token + 2);
+    m_Token = (m_Doc->CharAt(next) == ',') ? next + 1 : next;
+    return *this;
+}
+
+} // namespace Engine
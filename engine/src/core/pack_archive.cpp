@@ -0,0 +1,256 @@
+#include "engine/core/pack_archive.h"
+#include "engine/core/string_id.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace Engine {
+
+// ── PackArchive ─────────────────────────────────────────────
+
+PackArchive::~PackArchive() {
+    Close();
+}
+
+bool PackArchive::Open(const std::string& filepath) {
+    Close();
+
+    const u8* base = nullptr;
+    size_t size = 0;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filepath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        LOG_ERROR("[Pack] 无法打开: %s", filepath.c_str());
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    GetFileSizeEx(file, &fileSize);
+    size = (size_t)fileSize.QuadPart;
+    HANDLE mapping = size ? CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr) : nullptr;
+    if (mapping) base = (const u8*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!base) {
+        if (mapping) CloseHandle(mapping);
+        CloseHandle(file);
+        LOG_ERROR("[Pack] 映射失败: %s", filepath.c_str());
+        return false;
+    }
+    m_File = file;
+    m_Mapping = mapping;
+#else
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        LOG_ERROR("[Pack] 无法打开: %s", filepath.c_str());
+        return false;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        ::close(fd);
+        LOG_ERROR("[Pack] 空文件或无法读取大小: %s", filepath.c_str());
+        return false;
+    }
+    size = (size_t)st.st_size;
+    void* mem = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);   // 映射建立后即可关闭 fd
+    if (mem == MAP_FAILED) {
+        LOG_ERROR("[Pack] 映射失败: %s", filepath.c_str());
+        return false;
+    }
+    base = (const u8*)mem;
+#endif
+
+    m_Base = base;
+    m_Size = size;
+    m_Path = filepath;
+
+    // ── 校验头部与 TOC 范围 ────────────────────────────────
+    PackHeader header;
+    if (size < sizeof(PackHeader)) {
+        LOG_ERROR("[Pack] 文件过小: %s", filepath.c_str());
+        Close();
+        return false;
+    }
+    std::memcpy(&header, base, sizeof(header));
+    if (header.Magic != PACK_MAGIC || header.Version != PACK_VERSION) {
+        LOG_ERROR("[Pack] 格式不匹配: %s (magic=0x%08X version=%u, 需要 %u)",
+                  filepath.c_str(), header.Magic, header.Version, PACK_VERSION);
+        Close();
+        return false;
+    }
+    // 全部写成减法形式，构造的大偏移不会让加法回绕后通过检查
+    if (header.TocOffset > size || header.TocOffset % alignof(PackEntry) != 0 ||
+        header.EntryCount > (size - header.TocOffset) / sizeof(PackEntry) ||
+        header.NamesOffset > size || header.NamesSize > size - header.NamesOffset) {
+        LOG_ERROR("[Pack] TOC 越界: %s", filepath.c_str());
+        Close();
+        return false;
+    }
+    // 名称表以 '\0' 结尾，GetName 的 strlen 不会读出映射区
+    if (header.NamesSize == 0 || base[header.NamesOffset + header.NamesSize - 1] != '\0') {
+        LOG_ERROR("[Pack] 名称表未以 0 结尾: %s", filepath.c_str());
+        Close();
+        return false;
+    }
+
+    m_Entries = (const PackEntry*)(base + header.TocOffset);
+    m_Names = (const char*)(base + header.NamesOffset);
+    m_EntryCount = header.EntryCount;
+
+    for (u32 i = 0; i < m_EntryCount; i++) {
+        const PackEntry& e = m_Entries[i];
+        if (e.Offset > size || e.Size > size - e.Offset || e.NameOffset >= header.NamesSize) {
+            LOG_ERROR("[Pack] 条目 %u 越界: %s", i, filepath.c_str());
+            Close();
+            return false;
+        }
+    }
+
+    LOG_INFO("[Pack] 已挂载: %s (%u 个资源, %.2f MB)",
+             filepath.c_str(), m_EntryCount, (f64)size / (1024.0 * 1024.0));
+    return true;
+}
+
+void PackArchive::Close() {
+    if (!m_Base) return;
+#ifdef _WIN32
+    UnmapViewOfFile(m_Base);
+    if (m_Mapping) CloseHandle((HANDLE)m_Mapping);
+    if (m_File) CloseHandle((HANDLE)m_File);
+    m_Mapping = m_File = nullptr;
+#else
+    munmap((void*)m_Base, m_Size);
+#endif
+    m_Base = nullptr;
+    m_Size = 0;
+    m_Entries = nullptr;
+    m_Names = nullptr;
+    m_EntryCount = 0;
+}
+
+const PackEntry* PackArchive::Find(std::string_view name) const {
+    if (!m_Entries) return nullptr;
+
+    StringID hash = SID(name);
+    const PackEntry* end = m_Entries + m_EntryCount;
+    const PackEntry* it = std::lower_bound(m_Entries, end, hash,
+        [](const PackEntry& e, StringID h) { return e.NameHash < h; });
+
+    // 哈希冲突时逐个比对名称
+    for (; it != end && it->NameHash == hash; ++it) {
+        if (name == GetName(*it)) return it;
+    }
+    return nullptr;
+}
+
+PackBlob PackArchive::Lookup(std::string_view name, PackAssetType type) const {
+    const PackEntry* e = Find(name);
+    if (!e || e->Type != (u32)type) return {};
+    return {GetData(*e), (size_t)e->Size, e->Flags};
+}
+
+// ── PackWriter ──────────────────────────────────────────────
+
+void PackWriter::Add(const std::string& name, PackAssetType type,
+                     const void* data, size_t size, u32 flags) {
+    Item item{name, type, flags, {}};
+    item.Data.assign((const u8*)data, (const u8*)data + size);
+
+    for (auto& existing : m_Items) {
+        if (existing.Name == name) {
+            existing = std::move(item);
+            return;
+        }
+    }
+    m_Items.push_back(std::move(item));
+}
+
+u64 PackWriter::GetPayloadSize() const {
+    u64 total = 0;
+    for (const auto& item : m_Items) total += item.Data.size();
+    return total;
+}
+
+bool PackWriter::Write(const std::string& filepath) const {
+    std::ofstream out(filepath, std::ios::binary | std::ios::trunc);
+    if (!out.is_open()) {
+        LOG_ERROR("[Pack] 无法写入: %s", filepath.c_str());
+        return false;
+    }
+
+    auto alignUp = [](u64 v) { return (v + PACK_ALIGNMENT - 1) & ~(u64)(PACK_ALIGNMENT - 1); };
+    static const u8 zeros[PACK_ALIGNMENT] = {};
+
+    std::vector<PackEntry> entries;
+    entries.reserve(m_Items.size());
+    std::string names;
+
+    // ── blob 区 ────────────────────────────────────────────
+    PackHeader header;
+    out.write((const char*)&header, sizeof(header));
+    u64 cursor = sizeof(header);
+
+    for (const auto& item : m_Items) {
+        u64 aligned = alignUp(cursor);
+        out.write((const char*)zeros, (std::streamsize)(aligned - cursor));
+        cursor = aligned;
+
+        PackEntry e;
+        e.NameHash = SID(item.Name);
+        e.Type = (u32)item.Type;
+        e.Flags = item.Flags;
+        e.NameOffset = (u32)names.size();
+        e.Offset = cursor;
+        e.Size = item.Data.size();
+        entries.push_back(e);
+
+        names.append(item.Name);
+        names.push_back('\0');
+
+        out.write((const char*)item.Data.data(), (std::streamsize)item.Data.size());
+        cursor += item.Data.size();
+    }
+
+    // ── TOC + 名称表 ───────────────────────────────────────
+    std::stable_sort(entries.begin(), entries.end(),
+        [](const PackEntry& a, const PackEntry& b) { return a.NameHash < b.NameHash; });
+
+    u64 tocOffset = alignUp(cursor);
+    out.write((const char*)zeros, (std::streamsize)(tocOffset - cursor));
+    out.write((const char*)entries.data(), (std::streamsize)(entries.size() * sizeof(PackEntry)));
+    cursor = tocOffset + entries.size() * sizeof(PackEntry);
+
+    if (names.empty()) names.push_back('\0');   // 空包也写一个结尾 0，读取端要求名称表非空
+
+    header.EntryCount = (u32)entries.size();
+    header.TocOffset = tocOffset;
+    header.NamesOffset = cursor;
+    header.NamesSize = names.size();
+    out.write(names.data(), (std::streamsize)names.size());
+
+    out.seekp(0);
+    out.write((const char*)&header, sizeof(header));
+
+    if (!out.good()) {
+        LOG_ERROR("[Pack] 写入失败: %s", filepath.c_str());
+        return false;
+    }
+    LOG_INFO("[Pack] 已写入: %s (%u 个资源)", filepath.c_str(), header.EntryCount);
+    return true;
+}
+
+} // namespace Engine
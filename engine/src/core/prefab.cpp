@@ -1,4 +1,7 @@
 #include "engine/core/prefab.h"
+#include "engine/core/cooked_asset.h"
+#include "engine/core/resource_manager.h"
+#include "engine/core/json.h"
 #include "engine/core/log.h"
 
 #include <fstream>
@@ -230,13 +233,50 @@ bool Prefab::SaveToFile(const std::string& path) const {
     return true;
 }
 
-Ref<Prefab> Prefab::Deserialize(const std::string& /*json*/) {
-    // TODO: 实现 JSON 解析反序列化
-    LOG_WARN("[Prefab] Deserialize not yet implemented");
-    return nullptr;
+// ── JSON 反序列化 ───────────────────────────────────────────
+
+static void DeserializeBlueprint(JsonValue node, EntityBlueprint& bp) {
+    bp.Name = node.GetString("name", "Entity");
+    for (JsonValue comp : node["components"].Elements()) {
+        ComponentSnapshot snap;
+        for (const auto& [key, value] : comp.Members()) {
+            std::string k(key);
+            if (k == "type")            snap.TypeName = value.AsString();
+            else if (value.IsNumber())  snap.FloatValues[k] = value.AsF32();
+            else if (value.IsBool())    snap.FloatValues[k] = value.AsBool() ? 1.0f : 0.0f;
+            else if (value.IsString())  snap.StringValues[k] = value.AsString();
+        }
+        bp.Components.push_back(std::move(snap));
+    }
+    for (JsonValue child : node["children"].Elements()) {
+        bp.Children.emplace_back();
+        DeserializeBlueprint(child, bp.Children.back());
+    }
+}
+
+Ref<Prefab> Prefab::Deserialize(const std::string& json) {
+    JsonDocument doc;
+    if (!doc.Parse(std::string_view(json))) {
+        LOG_ERROR("[Prefab] JSON parse error: %s", doc.GetError().c_str());
+        return nullptr;
+    }
+    JsonValue root = doc.GetRoot();
+    JsonValue bp = root["root"];
+    if (!bp.IsObject()) {
+        LOG_ERROR("[Prefab] Missing \"root\" blueprint");
+        return nullptr;
+    }
+
+    auto prefab = CreateRef<Prefab>(root.GetString("prefab", "Prefab"));
+    DeserializeBlueprint(bp, prefab->GetRoot());
+    return prefab;
 }
 
 Ref<Prefab> Prefab::LoadFromFile(const std::string& path) {
+    if (PackBlob blob = ResourceManager::FindPacked(path, PackAssetType::Prefab)) {
+        return CookedAsset::ReadPrefab(blob.Data, blob.Size);
+    }
+
     std::ifstream file(path);
     if (!file.is_open()) {
         LOG_ERROR("[Prefab] Failed to load: %s", path.c_str());
@@ -0,0 +1,84 @@
+#include "engine/core/radix_sort.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Engine {
+
+static constexpr u32 RADIX_BUCKETS = 256;
+
+void RadixSorter::Sort(u32* keys, u32* values, u32 count, u32 keyBits) {
+    if (count <= 1) return;
+    u32 passes = (std::min(keyBits, 32u) + 7) / 8;
+
+    u32 chunks = 1;
+    if (count >= PARALLEL_THRESHOLD && JobSystem::IsActive()) {
+        chunks = std::max(1u, std::min(JobSystem::GetWorkerCount(), count / (PARALLEL_THRESHOLD / 2)));
+    }
+    auto chunkBegin = [count, chunks](u32 c) { return (u32)((u64)count * c / chunks); };
+
+    if (m_Keys.size() < count) {
+        m_Keys.resize(count);
+        m_Values.resize(count);
+    }
+    m_Histograms.resize((size_t)chunks * RADIX_BUCKETS);
+
+    u32* srcKeys = keys;
+    u32* srcValues = values;
+    u32* dstKeys = m_Keys.data();
+    u32* dstValues = m_Values.data();
+    u32* histograms = m_Histograms.data();
+
+    for (u32 pass = 0; pass < passes; pass++) {
+        u32 shift = pass * 8;
+
+        // 1. 各区间统计本趟 8 位的直方图
+        JobSystem::ParallelForRange(chunks, 1, [&](u32 begin, u32 end) {
+            for (u32 c = begin; c < end; c++) {
+                u32* hist = histograms + (size_t)c * RADIX_BUCKETS;
+                std::memset(hist, 0, RADIX_BUCKETS * sizeof(u32));
+                for (u32 i = chunkBegin(c), last = chunkBegin(c + 1); i < last; i++) {
+                    hist[(srcKeys[i] >> shift) & 0xFF]++;
+                }
+            }
+        });
+
+        // 2. 桶优先、区间其次的前缀和 → 每个区间在每个桶内的起始写入位置
+        u32 offset = 0;
+        bool trivial = false;
+        for (u32 b = 0; b < RADIX_BUCKETS; b++) {
+            u32 bucketTotal = 0;
+            for (u32 c = 0; c < chunks; c++) {
+                u32& h = histograms[(size_t)c * RADIX_BUCKETS + b];
+                u32 n = h;
+                h = offset;
+                offset += n;
+                bucketTotal += n;
+            }
+            if (bucketTotal == count) trivial = true;
+        }
+        if (trivial) continue;   // 所有键本趟同桶，顺序不变
+
+        // 3. 各区间按序分散写入 (稳定)
+        JobSystem::ParallelForRange(chunks, 1, [&](u32 begin, u32 end) {
+            for (u32 c = begin; c < end; c++) {
+                u32* hist = histograms + (size_t)c * RADIX_BUCKETS;
+                for (u32 i = chunkBegin(c), last = chunkBegin(c + 1); i < last; i++) {
+                    u32 pos = hist[(srcKeys[i] >> shift) & 0xFF]++;
+                    dstKeys[pos] = srcKeys[i];
+                    dstValues[pos] = srcValues[i];
+                }
+            }
+        });
+        std::swap(srcKeys, dstKeys);
+        std::swap(srcValues, dstValues);
+    }
+
+    if (srcKeys != keys) {
+        std::memcpy(keys, srcKeys, count * sizeof(u32));
+        std::memcpy(values, srcValues, count * sizeof(u32));
+    }
+}
+
+} // namespace Engine
@@ -1,5 +1,7 @@
 #include "engine/core/resource_manager.h"
 #include "engine/core/async_loader.h"
+#include "engine/core/cooked_asset.h"
+#include "engine/renderer/mesh_optimizer.h"
 
 #include <fstream>
 #include <sstream>
@@ -10,6 +12,8 @@ std::unordered_map<std::string, Ref<Shader>> ResourceManager::s_Shaders;
 std::unordered_map<std::string, Ref<Texture2D>> ResourceManager::s_Textures;
 std::unordered_map<std::string, Scope<Mesh>> ResourceManager::s_Meshes;
 std::unordered_map<std::string, Ref<Material>> ResourceManager::s_Materials;
+std::vector<Scope<PackArchive>> ResourceManager::s_Packs;
+bool ResourceManager::s_PackedVertexInput = false;
 
 // ── Shader ──────────────────────────────────────────────────
 
@@ -71,6 +75,13 @@ Ref<Texture2D> ResourceManager::LoadTexture(const std::string& name,
         LOG_DEBUG("[资源] Texture '%s' 已缓存", name.c_str());
         return it->second;
     }
+    if (PackBlob blob = FindPacked(filepath, PackAssetType::Texture)) {
+        auto cooked = CreateCookedTexture(blob, name);
+        if (cooked) {
+            s_Textures[name] = cooked;
+            return cooked;
+        }
+    }
     auto tex = std::make_shared<Texture2D>(filepath);
     if (tex->IsValid()) {
         s_Textures[name] = tex;
@@ -118,6 +129,78 @@ Mesh* ResourceManager::GetMesh(const std::string& name) {
     return nullptr;
 }
 
+// ── 资源包 ──────────────────────────────────────────────────
+
+bool ResourceManager::MountPack(const std::string& filepath) {
+    auto pack = CreateScope<PackArchive>();
+    if (!pack->Open(filepath)) return false;
+    s_Packs.push_back(std::move(pack));
+    return true;
+}
+
+void ResourceManager::UnmountPacks() {
+    s_Packs.clear();
+}
+
+PackBlob ResourceManager::FindPacked(const std::string& name, PackAssetType type) {
+    for (auto it = s_Packs.rbegin(); it != s_Packs.rend(); ++it) {
+        if (PackBlob blob = (*it)->Lookup(name, type)) return blob;
+    }
+    return {};
+}
+
+Ref<Texture2D> ResourceManager::CreateCookedTexture(const PackBlob& blob, const std::string& name) {
+    CookedTextureView view;
+    if (!CookedAsset::ReadTexture(blob.Data, blob.Size, view)) return nullptr;
+
+    // mip 链已离线生成: 直接从映射内存逐层上传，不经解码
+    Ref<Texture2D> tex;
+    if (view.Format == CookedTextureFormat::Raw8) {
+        tex = std::make_shared<Texture2D>(view.Width, view.Height, view.Channels, view.LevelCount);
+        for (u32 i = 0; i < view.LevelCount; i++)
+            tex->UploadMipRows(i, 0, view.Levels[i].Height, view.GetLevelData(i));
+    } else {
+        BcFormat bc = (view.Format == CookedTextureFormat::BC1) ? BcFormat::BC1 : BcFormat::BC3;
+        tex = std::make_shared<Texture2D>(view.Width, view.Height, bc, view.LevelCount);
+        for (u32 i = 0; i < view.LevelCount; i++)
+            tex->UploadCompressedMip(i, view.GetLevelData(i), (u32)view.Levels[i].Size);
+    }
+    if (!tex->IsValid()) return nullptr;
+    tex->SetResidentLevel(0);
+    LOG_INFO("[资源] Texture '%s' 已从资源包加载 (%ux%u, %u mip)",
+             name.c_str(), view.Width, view.Height, view.LevelCount);
+    return tex;
+}
+
+std::vector<std::string> ResourceManager::LoadCookedModel(const PackBlob& blob, const std::string& filepath) {
+    std::vector<std::string> names;
+    std::vector<CookedMeshView> views;
+    if (!CookedAsset::ReadModel(blob.Data, blob.Size, views)) return names;
+
+    for (const auto& view : views) {
+        std::string meshName = view.Name;
+        if (view.PackedVertices && s_PackedVertexInput) {
+            StoreMesh(meshName, CreateScope<Mesh>(view.PackedVertices, view.VertexCount,
+                                                  view.Indices, view.IndexCount));
+        } else if (view.PackedVertices) {
+            // 着色器可能直接读 aBitangent: 解压成完整顶点，包体积的收益仍保留
+            std::vector<MeshVertex> vertices;
+            MeshOptimizer::Dequantize(view.PackedVertices, view.VertexCount, vertices);
+            StoreMesh(meshName, CreateScope<Mesh>(vertices.data(), view.VertexCount,
+                                                  view.Indices, view.IndexCount));
+        } else {
+            StoreMesh(meshName, CreateScope<Mesh>(view.Vertices, view.VertexCount,
+                                                  view.Indices, view.IndexCount));
+        }
+        if (*view.AlbedoTexPath) LoadTexture(meshName + "_albedo", view.AlbedoTexPath);
+        if (*view.NormalTexPath) LoadTexture(meshName + "_normal", view.NormalTexPath);
+        if (*view.MetallicRoughnessTexPath) LoadTexture(meshName + "_mr", view.MetallicRoughnessTexPath);
+        names.push_back(meshName);
+    }
+    LOG_INFO("[资源] 模型已从资源包加载: %s (%zu 个 mesh)", filepath.c_str(), names.size());
+    return names;
+}
+
 // ── 全局 ────────────────────────────────────────────────────
 
 void ResourceManager::Clear() {
@@ -159,6 +242,10 @@ Ref<Material> ResourceManager::CreateMaterial(const std::string& name, Ref<Shade
 // ── Model (glTF / OBJ) ────────────────────────────────────
 
 std::vector<std::string> ResourceManager::LoadModel(const std::string& filepath) {
+    if (PackBlob blob = FindPacked(filepath, PackAssetType::Mesh)) {
+        return LoadCookedModel(blob, filepath);
+    }
+
     std::vector<std::string> names;
 
     // 检测后缀
@@ -0,0 +1,620 @@
+#include "engine/core/scene_serializer.h"
+#include "engine/core/log.h"
+#include "engine/core/components.h"
+#include "engine/core/systems.h"
+#include "engine/physics/physics_world.h"
+#include "engine/renderer/animation.h"
+
+#include <cstring>
+#include <fstream>
+
+namespace Engine {
+
+// ═══════════════════════════════════════════════════════════════
+// 二进制场景格式
+// ═══════════════════════════════════════════════════════════════
+//
+// 所有记录均为定长 POD (u32/f32/u16/u8)，按 4 字节对齐。
+// 实体以保存时的序号 (0..EntityCount-1) 引用，加载时映射为新分配的 Entity。
+// 字符串统一存放在文件末尾的字符串表，记录中只保存 {偏移, 长度}。
+
+namespace {
+
+struct StrRef {
+    u32 Offset = 0;
+    u32 Length = 0;
+};
+
+struct SceneBinaryHeader {
+    u32 Magic = SCENE_BINARY_MAGIC;
+    u32 Version = SCENE_BINARY_VERSION;
+    u32 EntityCount = 0;
+    u32 BlockCount = 0;
+    u32 PointLightCount = 0;
+    u32 SpotLightCount = 0;
+    u32 StringsOffset = 0;
+    u32 StringsSize = 0;
+    StrRef Name;
+    f32 DirDirection[3] = {};
+    f32 DirColor[3] = {};
+    f32 DirIntensity = 0;
+    u32 Reserved[3] = {};
+};
+static_assert(sizeof(SceneBinaryHeader) == 80, "SceneBinaryHeader 布局变化需提升版本号");
+
+struct PointLightRecord {
+    f32 Position[3], Color[3];
+    f32 Intensity, Constant, Linear, Quadratic;
+};
+
+struct SpotLightRecord {
+    f32 Position[3], Direction[3], Color[3];
+    f32 Intensity, InnerCutoff, OuterCutoff, Constant, Linear, Quadratic;
+};
+
+/// 组件块 ID — 只能追加，不可重排
+enum class SceneBlockId : u32 {
+    Tag = 1,
+    Transform,
+    Render,
+    Material,
+    Health,
+    Velocity,
+    AI,
+    Lifetime,
+    Collider,
+    RigidBody,
+    Script,
+    Squad,
+    RotationAnim,
+    Animator,
+};
+
+struct SceneBlockHeader {
+    u32 Id = 0;
+    u32 Count = 0;
+    u32 RecordSize = 0;   // 校验用；未知块据此跳过
+    u32 Reserved = 0;
+};
+
+// ── 组件记录 ────────────────────────────────────────────────
+
+struct TagRecord          { StrRef Name; };
+struct TransformRecord    { f32 Position[3], Rotation[3], Scale[3]; };
+struct RenderRecord       { StrRef MeshType, ObjPath; f32 Color[3], Shininess; };
+struct MaterialRecord {
+    f32 Diffuse[3], Specular[3];
+    f32 Shininess, Roughness, Metallic;
+    StrRef TextureName, NormalMapName;
+    u32 Emissive;
+    f32 EmissiveColor[3], EmissiveIntensity;
+};
+struct HealthRecord       { f32 Current, Max; };
+struct VelocityRecord     { f32 V[3]; };
+struct AIRecord           { StrRef ScriptModule, State; f32 DetectRange, AttackRange; };
+struct LifetimeRecord     { f32 TimeRemaining; };
+struct ColliderRecord {
+    u32 Shape;
+    f32 SphereRadius, CapsuleRadius, CapsuleHeight;
+    u16 Layer, Mask;
+    u8  IsTrigger, UseCCD, Pad[2];
+};
+struct RigidBodyRecord {
+    f32 Mass, Restitution, Friction, LinearDamping, AngularDamping;
+    u8  IsStatic, UseGravity, CanSleep, Pad;
+};
+struct ScriptRecord       { StrRef Module; u32 Enabled; };
+struct SquadRecord        { u32 SquadID; StrRef Role; };
+struct RotationAnimRecord { f32 Speed[3]; };
+struct AnimatorRecord     { StrRef CurrentClip; f32 PlaybackSpeed; u8 Loop, Playing, Pad[2]; };
+
+// ── 写入 ────────────────────────────────────────────────────
+
+class SceneBlobWriter {
+public:
+    explicit SceneBlobWriter(std::vector<u8>& out) : m_Out(out) {}
+
+    template<typename T>
+    T* Reserve(size_t count = 1) {
+        size_t offset = m_Out.size();
+        m_Out.resize(offset + sizeof(T) * count);
+        return (T*)(m_Out.data() + offset);
+    }
+
+    template<typename T>
+    void Write(const T& value) { *Reserve<T>() = value; }
+
+    StrRef Intern(const std::string& s) {
+        StrRef ref{(u32)m_Strings.size(), (u32)s.size()};
+        m_Strings.append(s);
+        return ref;
+    }
+
+    const std::string& GetStrings() const { return m_Strings; }
+
+private:
+    std::vector<u8>& m_Out;
+    std::string m_Strings;
+};
+
+/// 写出一个组件块: 直接遍历组件池的稠密数组
+/// 注意 Reserve 可能使先前返回的指针失效，因此先写实体序号再写记录
+template<typename T, typename Record, typename Fill>
+void WriteBlock(SceneBlobWriter& w, ECSWorld& world, const std::vector<u32>& indexOf,
+                SceneBlockId id, u32& blockCount, Fill&& fill) {
+    auto& pool = world.GetComponentArray<T>();
+    u32 count = pool.Size();
+    if (count == 0) return;
+
+    SceneBlockHeader header;
+    header.Id = (u32)id;
+    header.Count = count;
+    header.RecordSize = sizeof(Record);
+    w.Write(header);
+
+    u32* indices = w.Reserve<u32>(count);
+    const Entity* entities = pool.RawEntities();
+    for (u32 i = 0; i < count; i++) indices[i] = indexOf[entities[i]];
+
+    // Reserve 已清零 (填充字节确定)；字符串字段在 fill 中写入字符串表，不影响 blob 指针
+    Record* records = w.Reserve<Record>(count);
+    const T* data = pool.RawData();
+    for (u32 i = 0; i < count; i++) fill(data[i], records[i]);
+
+    blockCount++;
+}
+
+// ── 读取 ────────────────────────────────────────────────────
+
+class SceneBlobReader {
+public:
+    SceneBlobReader(const u8* data, size_t size) : m_Data(data), m_Size(size) {}
+
+    template<typename T>
+    const T* Read(size_t count = 1) {
+        size_t bytes = sizeof(T) * count;
+        if (count > m_Size / sizeof(T) || m_Pos + bytes > m_Size) {
+            m_Failed = true;
+            return nullptr;
+        }
+        const T* p = (const T*)(m_Data + m_Pos);
+        m_Pos += bytes;
+        return p;
+    }
+
+    bool Failed() const { return m_Failed; }
+
+private:
+    const u8* m_Data;
+    size_t m_Size;
+    size_t m_Pos = 0;
+    bool m_Failed = false;
+};
+
+struct StringTable {
+    const char* Data = nullptr;
+    u32 Size = 0;
+
+    std::string Get(const StrRef& ref) const {
+        if ((u64)ref.Offset + ref.Length > Size) return {};
+        return std::string(Data + ref.Offset, ref.Length);
+    }
+};
+
+/// 把一个组件块批量写入对应组件池
+template<typename T, typename Record, typename Fill>
+bool ReadBlock(ECSWorld& world, const SceneBlockHeader& header, const u32* indices,
+               const Record* records, const std::vector<Entity>& entities,
+               std::vector<Entity>& scratch, Fill&& fill) {
+    if (header.RecordSize != sizeof(Record)) {
+        LOG_ERROR("[SceneSerializer] 组件块 %u 记录大小不匹配 (%u != %zu)",
+                  header.Id, header.RecordSize, sizeof(Record));
+        return false;
+    }
+
+    scratch.resize(header.Count);
+    for (u32 i = 0; i < header.Count; i++) {
+        if (indices[i] >= entities.size()) {
+            LOG_ERROR("[SceneSerializer] 组件块 %u 实体序号越界: %u", header.Id, indices[i]);
+            return false;
+        }
+        scratch[i] = entities[indices[i]];
+    }
+
+    world.AddComponents<T>(scratch.data(), header.Count,
+        [&](u32 i, T& c) { fill(records[i], c); });
+    return true;
+}
+
+template<typename T, typename Record>
+struct BlockType {};
+
+void CopyVec3(f32* dst, const glm::vec3& v) { dst[0] = v.x; dst[1] = v.y; dst[2] = v.z; }
+glm::vec3 ToVec3(const f32* v) { return {v[0], v[1], v[2]}; }
+
+} // namespace
+
+// ═══════════════════════════════════════════════════════════════
+// 保存
+// ═══════════════════════════════════════════════════════════════
+
+bool SceneSerializer::SaveBinary(const Scene& scene, const std::string& filepath) {
+    std::vector<u8> blob;
+    SaveBinaryToMemory(scene, blob);
+
+    std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        LOG_ERROR("[SceneSerializer] 无法写入文件: %s", filepath.c_str());
+        return false;
+    }
+    file.write((const char*)blob.data(), (std::streamsize)blob.size());
+
+    LOG_INFO("[SceneSerializer] 二进制场景已保存: %s (%u 个实体, %zu KB)",
+             filepath.c_str(), scene.GetEntityCount(), blob.size() / 1024);
+    return file.good();
+}
+
+void SceneSerializer::SaveBinaryToMemory(const Scene& scene, std::vector<u8>& out) {
+    auto& s = const_cast<Scene&>(scene);
+    auto& world = s.GetWorld();
+    const auto& entities = world.GetEntities();
+
+    out.clear();
+    SceneBlobWriter w(out);
+
+    // Entity → 保存序号
+    Entity maxEntity = 0;
+    for (Entity e : entities) maxEntity = std::max(maxEntity, e);
+    std::vector<u32> indexOf(entities.empty() ? 0 : (size_t)maxEntity + 1, ~0u);
+    for (u32 i = 0; i < (u32)entities.size(); i++) indexOf[entities[i]] = i;
+
+    w.Reserve<SceneBinaryHeader>();
+    SceneBinaryHeader header;
+    header.EntityCount = (u32)entities.size();
+    header.PointLightCount = (u32)s.GetPointLights().size();
+    header.SpotLightCount = (u32)s.GetSpotLights().size();
+    header.Name = w.Intern(scene.GetName());
+    CopyVec3(header.DirDirection, s.GetDirLight().Direction);
+    CopyVec3(header.DirColor, s.GetDirLight().Color);
+    header.DirIntensity = s.GetDirLight().Intensity;
+
+    // ── 光照 ────────────────────────────────────────────────
+    for (const auto& pl : s.GetPointLights()) {
+        PointLightRecord r;
+        CopyVec3(r.Position, pl.Position);
+        CopyVec3(r.Color, pl.Color);
+        r.Intensity = pl.Intensity;
+        r.Constant = pl.Constant; r.Linear = pl.Linear; r.Quadratic = pl.Quadratic;
+        w.Write(r);
+    }
+    for (const auto& sl : s.GetSpotLights()) {
+        SpotLightRecord r;
+        CopyVec3(r.Position, sl.Position);
+        CopyVec3(r.Direction, sl.Direction);
+        CopyVec3(r.Color, sl.Color);
+        r.Intensity = sl.Intensity;
+        r.InnerCutoff = sl.InnerCutoff; r.OuterCutoff = sl.OuterCutoff;
+        r.Constant = sl.Constant; r.Linear = sl.Linear; r.Quadratic = sl.Quadratic;
+        w.Write(r);
+    }
+
+    // ── 组件块 ──────────────────────────────────────────────
+    u32 blocks = 0;
+
+    WriteBlock<TagComponent, TagRecord>(w, world, indexOf, SceneBlockId::Tag, blocks,
+        [&](const TagComponent& c, TagRecord& r) { r.Name = w.Intern(c.Name); });
+
+    WriteBlock<TransformComponent, TransformRecord>(w, world, indexOf, SceneBlockId::Transform, blocks,
+        [](const TransformComponent& c, TransformRecord& r) {
+            r.Position[0] = c.X;    r.Position[1] = c.Y;    r.Position[2] = c.Z;
+            r.Rotation[0] = c.RotX; r.Rotation[1] = c.RotY; r.Rotation[2] = c.RotZ;
+            r.Scale[0] = c.ScaleX;  r.Scale[1] = c.ScaleY;  r.Scale[2] = c.ScaleZ;
+        });
+
+    WriteBlock<RenderComponent, RenderRecord>(w, world, indexOf, SceneBlockId::Render, blocks,
+        [&](const RenderComponent& c, RenderRecord& r) {
+            r.MeshType = w.Intern(c.MeshType);
+            r.ObjPath = w.Intern(c.ObjPath);
+            r.Color[0] = c.ColorR; r.Color[1] = c.ColorG; r.Color[2] = c.ColorB;
+            r.Shininess = c.Shininess;
+        });
+
+    WriteBlock<MaterialComponent, MaterialRecord>(w, world, indexOf, SceneBlockId::Material, blocks,
+        [&](const MaterialComponent& c, MaterialRecord& r) {
+            r.Diffuse[0] = c.DiffuseR;   r.Diffuse[1] = c.DiffuseG;   r.Diffuse[2] = c.DiffuseB;
+            r.Specular[0] = c.SpecularR; r.Specular[1] = c.SpecularG; r.Specular[2] = c.SpecularB;
+            r.Shininess = c.Shininess;
+            r.Roughness = c.Roughness;
+            r.Metallic = c.Metallic;
+            r.TextureName = w.Intern(c.TextureName);
+            r.NormalMapName = w.Intern(c.NormalMapName);
+            r.Emissive = c.Emissive ? 1 : 0;
+            r.EmissiveColor[0] = c.EmissiveR; r.EmissiveColor[1] = c.EmissiveG; r.EmissiveColor[2] = c.EmissiveB;
+            r.EmissiveIntensity = c.EmissiveIntensity;
+        });
+
+    WriteBlock<HealthComponent, HealthRecord>(w, world, indexOf, SceneBlockId::Health, blocks,
+        [](const HealthComponent& c, HealthRecord& r) { r.Current = c.Current; r.Max = c.Max; });
+
+    WriteBlock<VelocityComponent, VelocityRecord>(w, world, indexOf, SceneBlockId::Velocity, blocks,
+        [](const VelocityComponent& c, VelocityRecord& r) { r.V[0] = c.VX; r.V[1] = c.VY; r.V[2] = c.VZ; });
+
+    WriteBlock<AIComponent, AIRecord>(w, world, indexOf, SceneBlockId::AI, blocks,
+        [&](const AIComponent& c, AIRecord& r) {
+            r.ScriptModule = w.Intern(c.ScriptModule);
+            r.State = w.Intern(c.State);
+            r.DetectRange = c.DetectRange;
+            r.AttackRange = c.AttackRange;
+        });
+
+    WriteBlock<LifetimeComponent, LifetimeRecord>(w, world, indexOf, SceneBlockId::Lifetime, blocks,
+        [](const LifetimeComponent& c, LifetimeRecord& r) { r.TimeRemaining = c.TimeRemaining; });
+
+    WriteBlock<ColliderComponent, ColliderRecord>(w, world, indexOf, SceneBlockId::Collider, blocks,
+        [](const ColliderComponent& c, ColliderRecord& r) {
+            r.Shape = (u32)c.Shape;
+            r.SphereRadius = c.SphereRadius;
+            r.CapsuleRadius = c.CapsuleRadius;
+            r.CapsuleHeight = c.CapsuleHeight;
+            r.Layer = c.Layer;
+            r.Mask = c.Mask;
+            r.IsTrigger = c.IsTrigger;
+            r.UseCCD = c.UseCCD;
+        });
+
+    WriteBlock<RigidBodyComponent, RigidBodyRecord>(w, world, indexOf, SceneBlockId::RigidBody, blocks,
+        [](const RigidBodyComponent& c, RigidBodyRecord& r) {
+            r.Mass = c.Mass;
+            r.Restitution = c.Restitution;
+            r.Friction = c.Friction;
+            r.LinearDamping = c.LinearDamping;
+            r.AngularDamping = c.AngularDamping;
+            r.IsStatic = c.IsStatic;
+            r.UseGravity = c.UseGravity;
+            r.CanSleep = c.CanSleep;
+        });
+
+    WriteBlock<ScriptComponent, ScriptRecord>(w, world, indexOf, SceneBlockId::Script, blocks,
+        [&](const ScriptComponent& c, ScriptRecord& r) {
+            r.Module = w.Intern(c.ScriptModule);
+            r.Enabled = c.Enabled ? 1 : 0;
+        });
+
+    WriteBlock<SquadComponent, SquadRecord>(w, world, indexOf, SceneBlockId::Squad, blocks,
+        [&](const SquadComponent& c, SquadRecord& r) {
+            r.SquadID = c.SquadID;
+            r.Role = w.Intern(c.Role);
+        });
+
+    WriteBlock<RotationAnimComponent, RotationAnimRecord>(w, world, indexOf, SceneBlockId::RotationAnim, blocks,
+        [](const RotationAnimComponent& c, RotationAnimRecord& r) {
+            r.Speed[0] = c.SpeedX; r.Speed[1] = c.SpeedY; r.Speed[2] = c.SpeedZ;
+        });
+
+    WriteBlock<AnimatorComponent, AnimatorRecord>(w, world, indexOf, SceneBlockId::Animator, blocks,
+        [&](const AnimatorComponent& c, AnimatorRecord& r) {
+            r.CurrentClip = w.Intern(c.CurrentClip);
+            r.PlaybackSpeed = c.PlaybackSpeed;
+            r.Loop = c.Loop;
+            r.Playing = c.Playing;
+        });
+
+    // ── 字符串表 ────────────────────────────────────────────
+    header.BlockCount = blocks;
+    header.StringsOffset = (u32)out.size();
+    header.StringsSize = (u32)w.GetStrings().size();
+    out.insert(out.end(), w.GetStrings().begin(), w.GetStrings().end());
+    std::memcpy(out.data(), &header, sizeof(header));
+}
+
+// ═══════════════════════════════════════════════════════════════
+// 加载
+// ═══════════════════════════════════════════════════════════════
+
+Ref<Scene> SceneSerializer::LoadFromMemory(const u8* data, size_t size) {
+    SceneBlobReader r(data, size);
+    const SceneBinaryHeader* header = r.Read<SceneBinaryHeader>();
+    if (!header || header->Magic != SCENE_BINARY_MAGIC) {
+        LOG_ERROR("[SceneSerializer] 不是二进制场景");
+        return nullptr;
+    }
+    if (header->Version != SCENE_BINARY_VERSION) {
+        LOG_ERROR("[SceneSerializer] 二进制场景版本不匹配: %u (需要 %u)",
+                  header->Version, SCENE_BINARY_VERSION);
+        return nullptr;
+    }
+    if ((u64)header->StringsOffset + header->StringsSize > size) {
+        LOG_ERROR("[SceneSerializer] 字符串表越界");
+        return nullptr;
+    }
+    StringTable strings{(const char*)data + header->StringsOffset, header->StringsSize};
+
+    auto scene = std::make_shared<Scene>(strings.Get(header->Name));
+    auto& world = scene->GetWorld();
+
+    // 添加默认系统 (与 JSON 加载一致)
+    world.AddSystem<MovementSystem>();
+    world.AddSystem<LifetimeSystem>();
+
+    // ── 光照 ────────────────────────────────────────────────
+    auto& dl = scene->GetDirLight();
+    dl.Direction = ToVec3(header->DirDirection);
+    dl.Color = ToVec3(header->DirColor);
+    dl.Intensity = header->DirIntensity;
+
+    const auto* points = r.Read<PointLightRecord>(header->PointLightCount);
+    const auto* spots = r.Read<SpotLightRecord>(header->SpotLightCount);
+    if (r.Failed()) {
+        LOG_ERROR("[SceneSerializer] 光源数据越界");
+        return nullptr;
+    }
+    for (u32 i = 0; i < header->PointLightCount; i++) {
+        auto& pl = scene->AddPointLight();
+        pl.Position = ToVec3(points[i].Position);
+        pl.Color = ToVec3(points[i].Color);
+        pl.Intensity = points[i].Intensity;
+        pl.Constant = points[i].Constant; pl.Linear = points[i].Linear; pl.Quadratic = points[i].Quadratic;
+    }
+    for (u32 i = 0; i < header->SpotLightCount; i++) {
+        auto& sl = scene->AddSpotLight();
+        sl.Position = ToVec3(spots[i].Position);
+        sl.Direction = ToVec3(spots[i].Direction);
+        sl.Color = ToVec3(spots[i].Color);
+        sl.Intensity = spots[i].Intensity;
+        sl.InnerCutoff = spots[i].InnerCutoff; sl.OuterCutoff = spots[i].OuterCutoff;
+        sl.Constant = spots[i].Constant; sl.Linear = spots[i].Linear; sl.Quadratic = spots[i].Quadratic;
+    }
+
+    // ── 实体 (批量分配) ─────────────────────────────────────
+    std::vector<Entity> entities;
+    world.CreateEntities(header->EntityCount, entities);
+
+    // ── 组件块 ──────────────────────────────────────────────
+    std::vector<Entity> scratch;
+    for (u32 b = 0; b < header->BlockCount; b++) {
+        const SceneBlockHeader* block = r.Read<SceneBlockHeader>();
+        const u32* indices = block ? r.Read<u32>(block->Count) : nullptr;
+        const u8* records = indices ? r.Read<u8>((size_t)block->Count * block->RecordSize) : nullptr;
+        if (!records) {
+            LOG_ERROR("[SceneSerializer] 组件块 %u 数据越界", b);
+            return nullptr;
+        }
+
+        auto read = [&]<typename T, typename Record>(BlockType<T, Record>, auto&& fill) {
+            return ReadBlock<T, Record>(world, *block, indices, (const Record*)records,
+                                        entities, scratch, fill);
+        };
+        auto S = [&](const StrRef& ref) { return strings.Get(ref); };
+
+        bool ok = true;
+        switch ((SceneBlockId)block->Id) {
+            case SceneBlockId::Tag:
+                ok = read(BlockType<TagComponent, TagRecord>{}, [&](const TagRecord& rec, TagComponent& c) {
+                    c.Name = S(rec.Name);
+                });
+                break;
+            case SceneBlockId::Transform:
+                ok = read(BlockType<TransformComponent, TransformRecord>{},
+                    [](const TransformRecord& rec, TransformComponent& c) {
+                        c.X = rec.Position[0];    c.Y = rec.Position[1];    c.Z = rec.Position[2];
+                        c.RotX = rec.Rotation[0]; c.RotY = rec.Rotation[1]; c.RotZ = rec.Rotation[2];
+                        c.ScaleX = rec.Scale[0];  c.ScaleY = rec.Scale[1];  c.ScaleZ = rec.Scale[2];
+                    });
+                break;
+            case SceneBlockId::Render:
+                ok = read(BlockType<RenderComponent, RenderRecord>{},
+                    [&](const RenderRecord& rec, RenderComponent& c) {
+                        c.MeshType = S(rec.MeshType);
+                        c.ObjPath = S(rec.ObjPath);
+                        c.ColorR = rec.Color[0]; c.ColorG = rec.Color[1]; c.ColorB = rec.Color[2];
+                        c.Shininess = rec.Shininess;
+                    });
+                break;
+            case SceneBlockId::Material:
+                ok = read(BlockType<MaterialComponent, MaterialRecord>{},
+                    [&](const MaterialRecord& rec, MaterialComponent& c) {
+                        c.DiffuseR = rec.Diffuse[0];   c.DiffuseG = rec.Diffuse[1];   c.DiffuseB = rec.Diffuse[2];
+                        c.SpecularR = rec.Specular[0]; c.SpecularG = rec.Specular[1]; c.SpecularB = rec.Specular[2];
+                        c.Shininess = rec.Shininess;
+                        c.Roughness = rec.Roughness;
+                        c.Metallic = rec.Metallic;
+                        c.TextureName = S(rec.TextureName);
+                        c.NormalMapName = S(rec.NormalMapName);
+                        c.Emissive = rec.Emissive != 0;
+                        c.EmissiveR = rec.EmissiveColor[0];
+                        c.EmissiveG = rec.EmissiveColor[1];
+                        c.EmissiveB = rec.EmissiveColor[2];
+                        c.EmissiveIntensity = rec.EmissiveIntensity;
+                    });
+                break;
+            case SceneBlockId::Health:
+                ok = read(BlockType<HealthComponent, HealthRecord>{},
+                    [](const HealthRecord& rec, HealthComponent& c) { c.Current = rec.Current; c.Max = rec.Max; });
+                break;
+            case SceneBlockId::Velocity:
+                ok = read(BlockType<VelocityComponent, VelocityRecord>{},
+                    [](const VelocityRecord& rec, VelocityComponent& c) {
+                        c.VX = rec.V[0]; c.VY = rec.V[1]; c.VZ = rec.V[2];
+                    });
+                break;
+            case SceneBlockId::AI:
+                ok = read(BlockType<AIComponent, AIRecord>{}, [&](const AIRecord& rec, AIComponent& c) {
+                    c.ScriptModule = S(rec.ScriptModule);
+                    c.State = S(rec.State);
+                    c.DetectRange = rec.DetectRange;
+                    c.AttackRange = rec.AttackRange;
+                });
+                break;
+            case SceneBlockId::Lifetime:
+                ok = read(BlockType<LifetimeComponent, LifetimeRecord>{},
+                    [](const LifetimeRecord& rec, LifetimeComponent& c) { c.TimeRemaining = rec.TimeRemaining; });
+                break;
+            case SceneBlockId::Collider:
+                ok = read(BlockType<ColliderComponent, ColliderRecord>{},
+                    [](const ColliderRecord& rec, ColliderComponent& c) {
+                        c.Shape = (ColliderShape)rec.Shape;
+                        c.SphereRadius = rec.SphereRadius;
+                        c.CapsuleRadius = rec.CapsuleRadius;
+                        c.CapsuleHeight = rec.CapsuleHeight;
+                        c.Layer = rec.Layer;
+                        c.Mask = rec.Mask;
+                        c.IsTrigger = rec.IsTrigger != 0;
+                        c.UseCCD = rec.UseCCD != 0;
+                    });
+                break;
+            case SceneBlockId::RigidBody:
+                ok = read(BlockType<RigidBodyComponent, RigidBodyRecord>{},
+                    [](const RigidBodyRecord& rec, RigidBodyComponent& c) {
+                        c.Mass = rec.Mass;
+                        c.Restitution = rec.Restitution;
+                        c.Friction = rec.Friction;
+                        c.LinearDamping = rec.LinearDamping;
+                        c.AngularDamping = rec.AngularDamping;
+                        c.IsStatic = rec.IsStatic != 0;
+                        c.UseGravity = rec.UseGravity != 0;
+                        c.CanSleep = rec.CanSleep != 0;
+                    });
+                break;
+            case SceneBlockId::Script:
+                ok = read(BlockType<ScriptComponent, ScriptRecord>{},
+                    [&](const ScriptRecord& rec, ScriptComponent& c) {
+                        c.ScriptModule = S(rec.Module);
+                        c.Enabled = rec.Enabled != 0;
+                    });
+                break;
+            case SceneBlockId::Squad:
+                ok = read(BlockType<SquadComponent, SquadRecord>{},
+                    [&](const SquadRecord& rec, SquadComponent& c) {
+                        c.SquadID = rec.SquadID;
+                        c.Role = S(rec.Role);
+                    });
+                break;
+            case SceneBlockId::RotationAnim:
+                ok = read(BlockType<RotationAnimComponent, RotationAnimRecord>{},
+                    [](const RotationAnimRecord& rec, RotationAnimComponent& c) {
+                        c.SpeedX = rec.Speed[0]; c.SpeedY = rec.Speed[1]; c.SpeedZ = rec.Speed[2];
+                    });
+                break;
+            case SceneBlockId::Animator:
+                ok = read(BlockType<AnimatorComponent, AnimatorRecord>{},
+                    [&](const AnimatorRecord& rec, AnimatorComponent& c) {
+                        c.CurrentClip = S(rec.CurrentClip);
+                        c.PlaybackSpeed = rec.PlaybackSpeed;
+                        c.Loop = rec.Loop != 0;
+                        c.Playing = rec.Playing != 0;
+                    });
+                break;
+            default:
+                // 新版本追加的组件块: 记录已整体跳过
+                LOG_WARN("[SceneSerializer] 跳过未知组件块 %u", block->Id);
+                break;
+        }
+        if (!ok) return nullptr;
+    }
+
+    LOG_INFO("[SceneSerializer] 二进制场景已加载: %s (%u 个实体, %u 个组件块)",
+             scene->GetName().c_str(), scene->GetEntityCount(), header->BlockCount);
+    return scene;
+}
+
+} // namespace Engine
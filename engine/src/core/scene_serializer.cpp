@@ -1,12 +1,16 @@
 #include "engine/core/scene_serializer.h"
 #include "engine/core/log.h"
+#include "engine/core/resource_manager.h"
+#include "engine/core/cooked_asset.h"
+#include "engine/core/json.h"
 #include "engine/physics/physics_world.h"
 #include "engine/renderer/animation.h"
 
+#include <charconv>
+#include <cstring>
 #include <fstream>
 #include <sstream>
-#include <iomanip>
-#include <cmath>
+#include <string_view>
 
 namespace Engine {
 
@@ -16,40 +20,39 @@ namespace Engine {
 
 class JsonWriter {
 public:
-    JsonWriter() { m_SS << std::fixed << std::setprecision(4); }
-
-    void BeginObject() { m_SS << "{"; m_Stack.push_back('{'); m_First.push_back(true); }
-    void EndObject()   { m_Stack.pop_back(); m_First.pop_back(); m_SS << "}"; }
-    void BeginArray()  { m_SS << "["; m_Stack.push_back('['); m_First.push_back(true); }
-    void EndArray()    { m_Stack.pop_back(); m_First.pop_back(); m_SS << "]"; }
+    void BeginObject() { ArrayComma(); m_Out += '{'; m_Stack.push_back('{'); m_First.push_back(true); }
+    void EndObject()   { m_Stack.pop_back(); m_First.pop_back(); m_Out += '}'; }
+    void BeginArray()  { ArrayComma(); m_Out += '['; m_Stack.push_back('['); m_First.push_back(true); }
+    void EndArray()    { m_Stack.pop_back(); m_First.pop_back(); m_Out += ']'; }
 
     void Key(const std::string& key) {
         Comma();
-        m_SS << "\"" << key << "\":";
+        m_Out += '"'; m_Out += key; m_Out += "\":";
     }
 
     void ValueStr(const std::string& val) {
         if (m_Stack.back() == '[') Comma();
-        m_SS << "\"" << Escape(val) << "\"";
+        m_Out += '"'; Escape(val); m_Out += '"';
     }
 
     void ValueF32(f32 val) {
         if (m_Stack.back() == '[') Comma();
-        // 整数按整数输出避免干扰
-        if (val == std::floor(val) && std::abs(val) < 1e7f)
-            m_SS << (i64)val;
-        else
-            m_SS << val;
+        // 最短可往返表示: 整数输出为整数，小数不丢精度
+        char buf[32];
+        auto res = std::to_chars(buf, buf + sizeof(buf), val);
+        m_Out.append(buf, res.ptr);
     }
 
     void ValueI32(i32 val) {
         if (m_Stack.back() == '[') Comma();
-        m_SS << val;
+        char buf[16];
+        auto res = std::to_chars(buf, buf + sizeof(buf), val);
+        m_Out.append(buf, res.ptr);
     }
 
     void ValueBool(bool val) {
         if (m_Stack.back() == '[') Comma();
-        m_SS << (val ? "true" : "false");
+        m_Out += (val ? "true" : "false");
     }
 
     void KeyStr(const std::string& k, const std::string& v) { Key(k); ValueStr(v); }
@@ -63,170 +66,53 @@ public:
         EndArray();
     }
 
-    std::string GetString() const { return m_SS.str(); }
+    std::string& GetString() { return m_Out; }
 
 private:
     void Comma() {
-        if (!m_First.back()) m_SS << ",";
+        if (!m_First.back()) m_Out += ',';
         else m_First.back() = false;
     }
 
-    static std::string Escape(const std::string& s) {
-        std::string out;
+    // 数组内的对象/数组元素同样需要逗号分隔
+    void ArrayComma() {
+        if (!m_Stack.empty() && m_Stack.back() == '[') Comma();
+    }
+
+    void Escape(const std::string& s) {
         for (char c : s) {
-            if (c == '"') out += "\\\"";
-            else if (c == '\\') out += "\\\\";
-            else if (c == '\n') out += "\\n";
-            else out += c;
+            if (c == '"') m_Out += "\\\"";
+            else if (c == '\\') m_Out += "\\\\";
+            else if (c == '\n') m_Out += "\\n";
+            else m_Out += c;
         }
-        return out;
     }
 
-    std::stringstream m_SS;
+    std::string m_Out;
     std::vector<char> m_Stack;
     std::vector<bool> m_First;
 };
 
 // ═══════════════════════════════════════════════════════════════
-// JSON 解析辅助 (简易 tokenizer)
+// 保存
 // ═══════════════════════════════════════════════════════════════
 
-enum class TokenType { LBrace, RBrace, LBracket, RBracket, Colon, Comma,
-                       String, Number, Bool, Null, End };
-
-struct Token {
-    TokenType Type;
-    std::string Str;
-    f64 Num = 0;
-    bool BoolVal = false;
-};
-
-class JsonParser {
-public:
-    JsonParser(const std::string& json) : m_Src(json), m_Pos(0) {}
-
-    Token Next() {
-        SkipWhitespace();
-        if (m_Pos >= m_Src.size()) return {TokenType::End};
-
-        char c = m_Src[m_Pos];
-        switch (c) {
-            case '{': m_Pos++; return {TokenType::LBrace};
-            case '}': m_Pos++; return {TokenType::RBrace};
-            case '[': m_Pos++; return {TokenType::LBracket};
-            case ']': m_Pos++; return {TokenType::RBracket};
-            case ':': m_Pos++; return {TokenType::Colon};
-            case ',': m_Pos++; return {TokenType::Comma};
-            case '"': return ReadString();
-            default:
-                if (c == '-' || (c >= '0' && c <= '9')) return ReadNumber();
-                if (c == 't' || c == 'f') return ReadBool();
-                if (c == 'n') { m_Pos += 4; return {TokenType::Null}; }
-                m_Pos++;
-                return {TokenType::End};
-        }
-    }
-
-    Token Peek() {
-        size_t saved = m_Pos;
-        auto t = Next();
-        m_Pos = saved;
-        return t;
-    }
-
-    void Expect(TokenType type) {
-        auto t = Next();
-        if (t.Type != type) {
-            LOG_ERROR("[SceneSerializer] JSON 解析错误: 期望 token %d, 得到 %d (pos=%zu)",
-                      (int)type, (int)t.Type, m_Pos);
-        }
-    }
-
-    std::string ExpectStr() { auto t = Next(); return t.Str; }
-    f64 ExpectNum()         { auto t = Next(); return t.Num; }
-    bool ExpectBool()       { auto t = Next(); return t.BoolVal; }
-
-    // 读取 [x, y, z] 数组
-    glm::vec3 ReadVec3() {
-        Expect(TokenType::LBracket);
-        f32 x = (f32)ExpectNum(); Expect(TokenType::Comma);
-        f32 y = (f32)ExpectNum(); Expect(TokenType::Comma);
-        f32 z = (f32)ExpectNum();
-        Expect(TokenType::RBracket);
-        return {x, y, z};
-    }
-
-    bool IsEnd() { SkipWhitespace(); return m_Pos >= m_Src.size(); }
-
-private:
-    void SkipWhitespace() {
-        while (m_Pos < m_Src.size() && 
-               (m_Src[m_Pos] == ' ' || m_Src[m_Pos] == '\n' ||
-                m_Src[m_Pos] == '\r' || m_Src[m_Pos] == '\t'))
-            m_Pos++;
-    }
-
-    Token ReadString() {
-        m_Pos++; // skip opening "
-        std::string s;
-        while (m_Pos < m_Src.size() && m_Src[m_Pos] != '"') {
-            if (m_Src[m_Pos] == '\\') {
-                m_Pos++;
-                if (m_Pos < m_Src.size()) {
-                    switch (m_Src[m_Pos]) {
-                        case '"':  s += '"'; break;
-                        case '\\': s += '\\'; break;
-                        case 'n':  s += '\n'; break;
-                        default:   s += m_Src[m_Pos]; break;
-                    }
-                }
-            } else {
-                s += m_Src[m_Pos];
-            }
-            m_Pos++;
-        }
-        if (m_Pos < m_Src.size()) m_Pos++; // skip closing "
-        return {TokenType::String, s};
-    }
-
-    Token ReadNumber() {
-        size_t start = m_Pos;
-        if (m_Src[m_Pos] == '-') m_Pos++;
-        while (m_Pos < m_Src.size() && ((m_Src[m_Pos] >= '0' && m_Src[m_Pos] <= '9') || m_Src[m_Pos] == '.'))
-            m_Pos++;
-        // 科学计数法
-        if (m_Pos < m_Src.size() && (m_Src[m_Pos] == 'e' || m_Src[m_Pos] == 'E')) {
-            m_Pos++;
-            if (m_Pos < m_Src.size() && (m_Src[m_Pos] == '+' || m_Src[m_Pos] == '-')) m_Pos++;
-            while (m_Pos < m_Src.size() && m_Src[m_Pos] >= '0' && m_Src[m_Pos] <= '9') m_Pos++;
-        }
-        std::string numStr = m_Src.substr(start, m_Pos - start);
-        Token t;
-        t.Type = TokenType::Number;
-        t.Num = std::stod(numStr);
-        return t;
-    }
+bool SceneSerializer::Save(const Scene& scene, const std::string& filepath) {
+    std::string json = SaveToString(scene);
 
-    Token ReadBool() {
-        Token t;
-        t.Type = TokenType::Bool;
-        if (m_Src.substr(m_Pos, 4) == "true") {
-            t.BoolVal = true;  m_Pos += 4;
-        } else {
-            t.BoolVal = false; m_Pos += 5;
-        }
-        return t;
+    std::ofstream file(filepath, std::ios::binary);
+    if (!file.is_open()) {
+        LOG_ERROR("[SceneSerializer] 无法写入文件: %s", filepath.c_str());
+        return false;
     }
+    file.write(json.data(), (std::streamsize)json.size());
+    file.close();
 
-    std::string m_Src;
-    size_t m_Pos;
-};
-
-// ═══════════════════════════════════════════════════════════════
-// 保存
-// ═══════════════════════════════════════════════════════════════
+    LOG_INFO("[SceneSerializer] 场景已保存: %s (%u 个实体)", filepath.c_str(), scene.GetEntityCount());
+    return true;
+}
 
-bool SceneSerializer::Save(const Scene& scene, const std::string& filepath) {
+std::string SceneSerializer::SaveToString(const Scene& scene) {
     JsonWriter w;
     w.BeginObject();
 
@@ -440,64 +326,34 @@ bool SceneSerializer::Save(const Scene& scene, const std::string& filepath) {
 
     w.EndObject();
 
-    // 写入文件
-    std::ofstream file(filepath);
-    if (!file.is_open()) {
-        LOG_ERROR("[SceneSerializer] 无法写入文件: %s", filepath.c_str());
-        return false;
-    }
-    file << w.GetString();
-    file.close();
-
-    LOG_INFO("[SceneSerializer] 场景已保存: %s (%u 个实体)", filepath.c_str(), world.GetEntityCount());
-    return true;
+    return std::move(w.GetString());
 }
 
 // ═══════════════════════════════════════════════════════════════
 // 加载
 // ═══════════════════════════════════════════════════════════════
 
-// 辅助：跳过对象中未知的 key-value
-static void SkipValue(JsonParser& p) {
-    auto t = p.Next();
-    switch (t.Type) {
-        case TokenType::LBrace: {
-            while (p.Peek().Type != TokenType::RBrace) {
-                p.Next(); // key
-                p.Expect(TokenType::Colon);
-                SkipValue(p);
-                if (p.Peek().Type == TokenType::Comma) p.Next();
-            }
-            p.Expect(TokenType::RBrace);
-            break;
-        }
-        case TokenType::LBracket: {
-            while (p.Peek().Type != TokenType::RBracket) {
-                SkipValue(p);
-                if (p.Peek().Type == TokenType::Comma) p.Next();
-            }
-            p.Expect(TokenType::RBracket);
-            break;
-        }
-        default: break; // string, number, bool, null 已消费
+// 辅助：读取 [x, y, z] 数组
+static glm::vec3 ReadVec3(JsonValue v, glm::vec3 def = glm::vec3(0.0f)) {
+    u32 i = 0;
+    for (JsonValue c : v.Elements()) {
+        if (i < 3) def[i] = c.AsF32(def[i]);
+        i++;
     }
+    return def;
 }
 
-// 辅助：读取对象的 key-value 对
-static void ReadObjectFields(JsonParser& p, std::function<void(const std::string& key)> handler) {
-    p.Expect(TokenType::LBrace);
-    while (p.Peek().Type != TokenType::RBrace) {
-        std::string key = p.ExpectStr();
-        p.Expect(TokenType::Colon);
-        handler(key);
-        if (p.Peek().Type == TokenType::Comma) p.Next();
+Ref<Scene> SceneSerializer::Load(const std::string& filepath) {
+    // 资源包内的二进制场景直接在映射内存上读取，无需拷贝
+    if (PackBlob blob = ResourceManager::FindPacked(filepath, PackAssetType::Scene)) {
+        if (blob.Flags == (u32)CookedSceneEncoding::Binary) {
+            return LoadFromMemory(blob.Data, blob.Size);
+        }
+        return LoadFromString(std::string_view((const char*)blob.Data, blob.Size));
     }
-    p.Expect(TokenType::RBrace);
-}
 
-Ref<Scene> SceneSerializer::Load(const std::string& filepath) {
     // 读取文件
-    std::ifstream file(filepath);
+    std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         LOG_ERROR("[SceneSerializer] 无法读取文件: %s", filepath.c_str());
         return nullptr;
@@ -505,8 +361,31 @@ Ref<Scene> SceneSerializer::Load(const std::string& filepath) {
     std::stringstream ss;
     ss << file.rdbuf();
     file.close();
+    std::string data = ss.str();
+
+    // 按文件头魔数区分二进制 / JSON
+    u32 magic = 0;
+    if (data.size() >= sizeof(magic)) std::memcpy(&magic, data.data(), sizeof(magic));
+    if (magic == SCENE_BINARY_MAGIC) {
+        return LoadFromMemory((const u8*)data.data(), data.size());
+    }
+    return LoadFromString(data);
+}
+
+Ref<Scene> SceneSerializer::LoadFromString(std::string_view json) {
+    JsonDocument doc;
+    // 旧版写出器在数组内的对象之间漏写逗号 ("}{")，这类存档仍可加载
+    doc.SetAllowMissingArrayCommas(true);
+    if (!doc.Parse(json)) {
+        LOG_ERROR("[SceneSerializer] JSON 解析错误: %s", doc.GetError().c_str());
+        return nullptr;
+    }
+    JsonValue root = doc.GetRoot();
+    if (!root.IsObject()) {
+        LOG_ERROR("[SceneSerializer] 场景根节点必须是对象");
+        return nullptr;
+    }
 
-    JsonParser p(ss.str());
     auto scene = std::make_shared<Scene>();
     auto& world = scene->GetWorld();
 
@@ -514,235 +393,184 @@ Ref<Scene> SceneSerializer::Load(const std::string& filepath) {
     world.AddSystem<MovementSystem>();
     world.AddSystem<LifetimeSystem>();
 
-    ReadObjectFields(p, [&](const std::string& key) {
+    for (const auto& [key, value] : root.Members()) {
         if (key == "name") {
-            scene->SetName(p.ExpectStr());
+            scene->SetName(value.AsString());
         }
         else if (key == "directionalLight") {
             auto& dl = scene->GetDirLight();
-            ReadObjectFields(p, [&](const std::string& k) {
-                if (k == "direction")  dl.Direction = p.ReadVec3();
-                else if (k == "color") dl.Color = p.ReadVec3();
-                else if (k == "intensity") dl.Intensity = (f32)p.ExpectNum();
-                else SkipValue(p);
-            });
+            for (const auto& [k, v] : value.Members()) {
+                if (k == "direction")  dl.Direction = ReadVec3(v, dl.Direction);
+                else if (k == "color") dl.Color = ReadVec3(v, dl.Color);
+                else if (k == "intensity") dl.Intensity = v.AsF32(dl.Intensity);
+            }
         }
         else if (key == "pointLights") {
-            p.Expect(TokenType::LBracket);
-            while (p.Peek().Type != TokenType::RBracket) {
+            for (JsonValue light : value.Elements()) {
                 auto& pl = scene->AddPointLight();
-                ReadObjectFields(p, [&](const std::string& k) {
-                    if (k == "position")      pl.Position = p.ReadVec3();
-                    else if (k == "color")    pl.Color = p.ReadVec3();
-                    else if (k == "intensity")  pl.Intensity = (f32)p.ExpectNum();
-                    else if (k == "constant")   pl.Constant = (f32)p.ExpectNum();
-                    else if (k == "linear")     pl.Linear = (f32)p.ExpectNum();
-                    else if (k == "quadratic")  pl.Quadratic = (f32)p.ExpectNum();
-                    else SkipValue(p);
-                });
-                if (p.Peek().Type == TokenType::Comma) p.Next();
+                for (const auto& [k, v] : light.Members()) {
+                    if (k == "position")      pl.Position = ReadVec3(v, pl.Position);
+                    else if (k == "color")    pl.Color = ReadVec3(v, pl.Color);
+                    else if (k == "intensity")  pl.Intensity = v.AsF32(pl.Intensity);
+                    else if (k == "constant")   pl.Constant = v.AsF32(pl.Constant);
+                    else if (k == "linear")     pl.Linear = v.AsF32(pl.Linear);
+                    else if (k == "quadratic")  pl.Quadratic = v.AsF32(pl.Quadratic);
+                }
             }
-            p.Expect(TokenType::RBracket);
         }
         else if (key == "spotLights") {
-            p.Expect(TokenType::LBracket);
-            while (p.Peek().Type != TokenType::RBracket) {
+            for (JsonValue light : value.Elements()) {
                 auto& sl = scene->AddSpotLight();
-                ReadObjectFields(p, [&](const std::string& k) {
-                    if (k == "position")       sl.Position = p.ReadVec3();
-                    else if (k == "direction") sl.Direction = p.ReadVec3();
-                    else if (k == "color")     sl.Color = p.ReadVec3();
-                    else if (k == "intensity")   sl.Intensity = (f32)p.ExpectNum();
-                    else if (k == "innerCutoff") sl.InnerCutoff = (f32)p.ExpectNum();
-                    else if (k == "outerCutoff") sl.OuterCutoff = (f32)p.ExpectNum();
-                    else if (k == "constant")    sl.Constant = (f32)p.ExpectNum();
-                    else if (k == "linear")      sl.Linear = (f32)p.ExpectNum();
-                    else if (k == "quadratic")   sl.Quadratic = (f32)p.ExpectNum();
-                    else SkipValue(p);
-                });
-                if (p.Peek().Type == TokenType::Comma) p.Next();
+                for (const auto& [k, v] : light.Members()) {
+                    if (k == "position")       sl.Position = ReadVec3(v, sl.Position);
+                    else if (k == "direction") sl.Direction = ReadVec3(v, sl.Direction);
+                    else if (k == "color")     sl.Color = ReadVec3(v, sl.Color);
+                    else if (k == "intensity")   sl.Intensity = v.AsF32(sl.Intensity);
+                    else if (k == "innerCutoff") sl.InnerCutoff = v.AsF32(sl.InnerCutoff);
+                    else if (k == "outerCutoff") sl.OuterCutoff = v.AsF32(sl.OuterCutoff);
+                    else if (k == "constant")    sl.Constant = v.AsF32(sl.Constant);
+                    else if (k == "linear")      sl.Linear = v.AsF32(sl.Linear);
+                    else if (k == "quadratic")   sl.Quadratic = v.AsF32(sl.Quadratic);
+                }
             }
-            p.Expect(TokenType::RBracket);
         }
         else if (key == "entities") {
-            p.Expect(TokenType::LBracket);
-            while (p.Peek().Type != TokenType::RBracket) {
-                // 先创建实体
-                std::string entityName = "Entity";
-                // 两遍扫描太复杂，先创建再改名
+            for (JsonValue ent : value.Elements()) {
+                // 旧 ID 不保留，统一分配新 ID
                 Entity entity = scene->CreateEntity();
 
-                ReadObjectFields(p, [&](const std::string& k) {
-                    if (k == "id") {
-                        p.ExpectNum(); // 跳过旧 ID（创建新 ID）
-                    }
-                    else if (k == "tag") {
-                        ReadObjectFields(p, [&](const std::string& tk) {
-                            if (tk == "name") {
-                                auto* tag = world.GetComponent<TagComponent>(entity);
-                                if (tag) tag->Name = p.ExpectStr();
-                            } else SkipValue(p);
-                        });
+                for (const auto& [k, comp] : ent.Members()) {
+                    if (k == "tag") {
+                        auto* tag = world.GetComponent<TagComponent>(entity);
+                        if (tag) tag->Name = comp.GetString("name", tag->Name);
                     }
                     else if (k == "transform") {
                         auto& tr = world.AddComponent<TransformComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& tk) {
-                            if (tk == "x") tr.X = (f32)p.ExpectNum();
-                            else if (tk == "y") tr.Y = (f32)p.ExpectNum();
-                            else if (tk == "z") tr.Z = (f32)p.ExpectNum();
-                            else if (tk == "rotX") tr.RotX = (f32)p.ExpectNum();
-                            else if (tk == "rotY") tr.RotY = (f32)p.ExpectNum();
-                            else if (tk == "rotZ") tr.RotZ = (f32)p.ExpectNum();
-                            else if (tk == "scaleX") tr.ScaleX = (f32)p.ExpectNum();
-                            else if (tk == "scaleY") tr.ScaleY = (f32)p.ExpectNum();
-                            else if (tk == "scaleZ") tr.ScaleZ = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "x") tr.X = v.AsF32();
+                            else if (f == "y") tr.Y = v.AsF32();
+                            else if (f == "z") tr.Z = v.AsF32();
+                            else if (f == "rotX") tr.RotX = v.AsF32();
+                            else if (f == "rotY") tr.RotY = v.AsF32();
+                            else if (f == "rotZ") tr.RotZ = v.AsF32();
+                            else if (f == "scaleX") tr.ScaleX = v.AsF32(1.0f);
+                            else if (f == "scaleY") tr.ScaleY = v.AsF32(1.0f);
+                            else if (f == "scaleZ") tr.ScaleZ = v.AsF32(1.0f);
+                        }
                     }
                     else if (k == "render") {
                         auto& rc = world.AddComponent<RenderComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& rk) {
-                            if (rk == "meshType") rc.MeshType = p.ExpectStr();
-                            else if (rk == "objPath") rc.ObjPath = p.ExpectStr();
-                            else if (rk == "colorR") rc.ColorR = (f32)p.ExpectNum();
-                            else if (rk == "colorG") rc.ColorG = (f32)p.ExpectNum();
-                            else if (rk == "colorB") rc.ColorB = (f32)p.ExpectNum();
-                            else if (rk == "shininess") rc.Shininess = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "meshType") rc.MeshType = v.AsString(rc.MeshType);
+                            else if (f == "objPath") rc.ObjPath = v.AsString();
+                            else if (f == "colorR") rc.ColorR = v.AsF32(rc.ColorR);
+                            else if (f == "colorG") rc.ColorG = v.AsF32(rc.ColorG);
+                            else if (f == "colorB") rc.ColorB = v.AsF32(rc.ColorB);
+                            else if (f == "shininess") rc.Shininess = v.AsF32(rc.Shininess);
+                        }
                     }
                     else if (k == "material") {
                         auto& mat = world.AddComponent<MaterialComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& mk) {
-                            if (mk == "diffuseR") mat.DiffuseR = (f32)p.ExpectNum();
-                            else if (mk == "diffuseG") mat.DiffuseG = (f32)p.ExpectNum();
-                            else if (mk == "diffuseB") mat.DiffuseB = (f32)p.ExpectNum();
-                            else if (mk == "specularR") mat.SpecularR = (f32)p.ExpectNum();
-                            else if (mk == "specularG") mat.SpecularG = (f32)p.ExpectNum();
-                            else if (mk == "specularB") mat.SpecularB = (f32)p.ExpectNum();
-                            else if (mk == "shininess") mat.Shininess = (f32)p.ExpectNum();
-                            else if (mk == "roughness") mat.Roughness = (f32)p.ExpectNum();
-                            else if (mk == "metallic") mat.Metallic = (f32)p.ExpectNum();
-                            else if (mk == "textureName") mat.TextureName = p.ExpectStr();
-                            else if (mk == "normalMapName") mat.NormalMapName = p.ExpectStr();
-                            else if (mk == "emissive") mat.Emissive = p.ExpectBool();
-                            else if (mk == "emissiveR") mat.EmissiveR = (f32)p.ExpectNum();
-                            else if (mk == "emissiveG") mat.EmissiveG = (f32)p.ExpectNum();
-                            else if (mk == "emissiveB") mat.EmissiveB = (f32)p.ExpectNum();
-                            else if (mk == "emissiveIntensity") mat.EmissiveIntensity = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "diffuseR") mat.DiffuseR = v.AsF32(mat.DiffuseR);
+                            else if (f == "diffuseG") mat.DiffuseG = v.AsF32(mat.DiffuseG);
+                            else if (f == "diffuseB") mat.DiffuseB = v.AsF32(mat.DiffuseB);
+                            else if (f == "specularR") mat.SpecularR = v.AsF32(mat.SpecularR);
+                            else if (f == "specularG") mat.SpecularG = v.AsF32(mat.SpecularG);
+                            else if (f == "specularB") mat.SpecularB = v.AsF32(mat.SpecularB);
+                            else if (f == "shininess") mat.Shininess = v.AsF32(mat.Shininess);
+                            else if (f == "roughness") mat.Roughness = v.AsF32(mat.Roughness);
+                            else if (f == "metallic") mat.Metallic = v.AsF32(mat.Metallic);
+                            else if (f == "textureName") mat.TextureName = v.AsString();
+                            else if (f == "normalMapName") mat.NormalMapName = v.AsString();
+                            else if (f == "emissive") mat.Emissive = v.AsBool();
+                            else if (f == "emissiveR") mat.EmissiveR = v.AsF32(mat.EmissiveR);
+                            else if (f == "emissiveG") mat.EmissiveG = v.AsF32(mat.EmissiveG);
+                            else if (f == "emissiveB") mat.EmissiveB = v.AsF32(mat.EmissiveB);
+                            else if (f == "emissiveIntensity") mat.EmissiveIntensity = v.AsF32(mat.EmissiveIntensity);
+                        }
                     }
                     else if (k == "health") {
                         auto& hp = world.AddComponent<HealthComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& hk) {
-                            if (hk == "current") hp.Current = (f32)p.ExpectNum();
-                            else if (hk == "max") hp.Max = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        hp.Current = comp.GetF32("current", hp.Current);
+                        hp.Max = comp.GetF32("max", hp.Max);
                     }
                     else if (k == "velocity") {
                         auto& vel = world.AddComponent<VelocityComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& vk) {
-                            if (vk == "vx") vel.VX = (f32)p.ExpectNum();
-                            else if (vk == "vy") vel.VY = (f32)p.ExpectNum();
-                            else if (vk == "vz") vel.VZ = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        vel.VX = comp.GetF32("vx");
+                        vel.VY = comp.GetF32("vy");
+                        vel.VZ = comp.GetF32("vz");
                     }
                     else if (k == "ai") {
                         auto& ai = world.AddComponent<AIComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& ak) {
-                            if (ak == "scriptModule") ai.ScriptModule = p.ExpectStr();
-                            else if (ak == "state") ai.State = p.ExpectStr();
-                            else if (ak == "detectRange") ai.DetectRange = (f32)p.ExpectNum();
-                            else if (ak == "attackRange") ai.AttackRange = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "scriptModule") ai.ScriptModule = v.AsString(ai.ScriptModule);
+                            else if (f == "state") ai.State = v.AsString(ai.State);
+                            else if (f == "detectRange") ai.DetectRange = v.AsF32(ai.DetectRange);
+                            else if (f == "attackRange") ai.AttackRange = v.AsF32(ai.AttackRange);
+                        }
                     }
                     else if (k == "lifetime") {
                         auto& lt = world.AddComponent<LifetimeComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& lk) {
-                            if (lk == "timeRemaining") lt.TimeRemaining = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        lt.TimeRemaining = comp.GetF32("timeRemaining", lt.TimeRemaining);
                     }
                     else if (k == "collider") {
                         auto& col = world.AddComponent<ColliderComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& ck) {
-                            if (ck == "shape") col.Shape = (ColliderShape)(i32)p.ExpectNum();
-                            else if (ck == "sphereRadius") col.SphereRadius = (f32)p.ExpectNum();
-                            else if (ck == "capsuleRadius") col.CapsuleRadius = (f32)p.ExpectNum();
-                            else if (ck == "capsuleHeight") col.CapsuleHeight = (f32)p.ExpectNum();
-                            else if (ck == "layer") col.Layer = (u16)p.ExpectNum();
-                            else if (ck == "mask") col.Mask = (u16)p.ExpectNum();
-                            else if (ck == "isTrigger") col.IsTrigger = p.ExpectBool();
-                            else if (ck == "useCCD") col.UseCCD = p.ExpectBool();
-                            else SkipValue(p);
-                        });
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "shape") col.Shape = (ColliderShape)v.AsI32();
+                            else if (f == "sphereRadius") col.SphereRadius = v.AsF32(col.SphereRadius);
+                            else if (f == "capsuleRadius") col.CapsuleRadius = v.AsF32(col.CapsuleRadius);
+                            else if (f == "capsuleHeight") col.CapsuleHeight = v.AsF32(col.CapsuleHeight);
+                            else if (f == "layer") col.Layer = (u16)v.AsI32(col.Layer);
+                            else if (f == "mask") col.Mask = (u16)v.AsI32(col.Mask);
+                            else if (f == "isTrigger") col.IsTrigger = v.AsBool();
+                            else if (f == "useCCD") col.UseCCD = v.AsBool();
+                        }
                     }
                     else if (k == "rigidBody") {
                         auto& rb = world.AddComponent<RigidBodyComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& rk) {
-                            if (rk == "mass") rb.Mass = (f32)p.ExpectNum();
-                            else if (rk == "restitution") rb.Restitution = (f32)p.ExpectNum();
-                            else if (rk == "friction") rb.Friction = (f32)p.ExpectNum();
-                            else if (rk == "linearDamping") rb.LinearDamping = (f32)p.ExpectNum();
-                            else if (rk == "angularDamping") rb.AngularDamping = (f32)p.ExpectNum();
-                            else if (rk == "isStatic") rb.IsStatic = p.ExpectBool();
-                            else if (rk == "useGravity") rb.UseGravity = p.ExpectBool();
-                            else if (rk == "canSleep") rb.CanSleep = p.ExpectBool();
-                            else SkipValue(p);
-                        });
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "mass") rb.Mass = v.AsF32(rb.Mass);
+                            else if (f == "restitution") rb.Restitution = v.AsF32(rb.Restitution);
+                            else if (f == "friction") rb.Friction = v.AsF32(rb.Friction);
+                            else if (f == "linearDamping") rb.LinearDamping = v.AsF32(rb.LinearDamping);
+                            else if (f == "angularDamping") rb.AngularDamping = v.AsF32(rb.AngularDamping);
+                            else if (f == "isStatic") rb.IsStatic = v.AsBool(rb.IsStatic);
+                            else if (f == "useGravity") rb.UseGravity = v.AsBool(rb.UseGravity);
+                            else if (f == "canSleep") rb.CanSleep = v.AsBool(rb.CanSleep);
+                        }
                     }
                     else if (k == "script") {
                         auto& sc = world.AddComponent<ScriptComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& sk) {
-                            if (sk == "module") sc.ScriptModule = p.ExpectStr();
-                            else if (sk == "enabled") sc.Enabled = p.ExpectBool();
-                            else SkipValue(p);
-                        });
+                        sc.ScriptModule = comp.GetString("module");
+                        sc.Enabled = comp.GetBool("enabled", sc.Enabled);
                     }
                     else if (k == "squad") {
                         auto& sq = world.AddComponent<SquadComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& qk) {
-                            if (qk == "squadID") sq.SquadID = (u32)p.ExpectNum();
-                            else if (qk == "role") sq.Role = p.ExpectStr();
-                            else SkipValue(p);
-                        });
+                        sq.SquadID = (u32)comp.GetI32("squadID");
+                        sq.Role = comp.GetString("role", sq.Role);
                     }
                     else if (k == "rotationAnim") {
                         auto& ra = world.AddComponent<RotationAnimComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& rk) {
-                            if (rk == "speedX") ra.SpeedX = (f32)p.ExpectNum();
-                            else if (rk == "speedY") ra.SpeedY = (f32)p.ExpectNum();
-                            else if (rk == "speedZ") ra.SpeedZ = (f32)p.ExpectNum();
-                            else SkipValue(p);
-                        });
+                        ra.SpeedX = comp.GetF32("speedX", ra.SpeedX);
+                        ra.SpeedY = comp.GetF32("speedY", ra.SpeedY);
+                        ra.SpeedZ = comp.GetF32("speedZ", ra.SpeedZ);
                     }
                     else if (k == "animator") {
                         auto& anim = world.AddComponent<AnimatorComponent>(entity);
-                        ReadObjectFields(p, [&](const std::string& ak) {
-                            if (ak == "currentClip") anim.CurrentClip = p.ExpectStr();
-                            else if (ak == "playbackSpeed") anim.PlaybackSpeed = (f32)p.ExpectNum();
-                            else if (ak == "loop") anim.Loop = p.ExpectBool();
-                            else if (ak == "playing") anim.Playing = p.ExpectBool();
-                            else SkipValue(p);
-                        });
-                    }
-                    else {
-                        SkipValue(p); // 未知组件，跳过
+                        for (const auto& [f, v] : comp.Members()) {
+                            if (f == "currentClip") anim.CurrentClip = v.AsString();
+                            else if (f == "playbackSpeed") anim.PlaybackSpeed = v.AsF32(anim.PlaybackSpeed);
+                            else if (f == "loop") anim.Loop = v.AsBool(anim.Loop);
+                            else if (f == "playing") anim.Playing = v.AsBool(anim.Playing);
+                        }
                     }
-                });
-
-                if (p.Peek().Type == TokenType::Comma) p.Next();
+                    // 未知组件忽略
+                }
             }
-            p.Expect(TokenType::RBracket);
         }
-        else {
-            SkipValue(p); // 未知顶级字段
-        }
-    });
+        // 未知顶级字段忽略
+    }
 
     LOG_INFO("[SceneSerializer] 场景已加载: %s (%u 个实体, %zu 点光, %zu 聚光)",
              scene->GetName().c_str(), scene->GetEntityCount(),
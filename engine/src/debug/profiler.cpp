@@ -43,13 +43,22 @@ void Profiler::EndTimer(const std::string& name) {
     }
 }
 
+void Profiler::RecordTimer(const std::string& name, f64 ms) {
+    if (!s_Enabled) return;
+    TimerResult result;
+    result.Name = name;
+    result.DurationMs = ms;
+    result.OtherThread = true;
+    s_CurrentFrame.Timers.push_back(result);
+}
+
 void Profiler::EndFrame() {
     if (!s_Enabled) return;
 
     // 帧总时间 = 顶层计时器之和
     f64 total = 0;
     for (auto& t : s_CurrentFrame.Timers) {
-        if (t.Depth == 0) total += t.DurationMs;
+        if (t.Depth == 0 && !t.OtherThread) total += t.DurationMs;
 
         // 存入历史（环形缓冲区）
         auto& hist = s_History[t.Name];
@@ -113,6 +113,15 @@ void StatOverlay::RecordSceneInfo(u32 entities, u32 activeLights, u32 particleEm
     s_ParticleEmitters = particleEmitters;
 }
 
+void StatOverlay::RecordParticles(u32 visibleEmitters, u32 culledEmitters, u32 drawnParticles,
+                                  u32 sortedParticles, u32 uploadBytes) {
+    s_ParticleVisibleEmitters = visibleEmitters;
+    s_ParticleCulledEmitters = culledEmitters;
+    s_ParticlesDrawn = drawnParticles;
+    s_ParticlesSorted = sortedParticles;
+    s_ParticleUploadBytes = uploadBytes;
+}
+
 // ── 渲染 ────────────────────────────────────────────────────
 
 void StatOverlay::Render() {
@@ -290,6 +299,9 @@ void StatOverlay::RenderSceneInfo() {
     ImGui::Text("  Entities:       %u", s_Entities);
     ImGui::Text("  Active Lights:  %u", s_ActiveLights);
     ImGui::Text("  Particle Emit:  %u", s_ParticleEmitters);
+    ImGui::Text("  Emit Vis/Cull:  %u / %u", s_ParticleVisibleEmitters, s_ParticleCulledEmitters);
+    ImGui::Text("  Particles:      %u (sorted %u)", s_ParticlesDrawn, s_ParticlesSorted);
+    ImGui::Text("  Inst Upload:    %.1f KB", s_ParticleUploadBytes / 1024.0f);
     ImGui::Separator();
 }
 
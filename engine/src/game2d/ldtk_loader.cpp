@@ -1,12 +1,12 @@
 #include "engine/game2d/ldtk_loader.h"
 #include "engine/core/log.h"
+#include "engine/core/cooked_asset.h"
+#include "engine/core/resource_manager.h"
+#include "engine/core/json.h"
 
-#include <nlohmann/json.hpp>
-#include <fstream>
+#include <algorithm>
 #include <filesystem>
 
-using json = nlohmann::json;
-
 namespace Engine {
 
 bool LdtkLoader::Load(const std::string& path, LdtkProject& project) {
@@ -15,21 +15,21 @@ bool LdtkLoader::Load(const std::string& path, LdtkProject& project) {
     project.basePath.clear();
     project.defaultGridSize = 16;
 
-    // ── 读取 JSON 文件 ─────────────────────────────
-    std::ifstream file(path);
-    if (!file.is_open()) {
-        LOG_ERROR("[LDtk] 无法打开文件: %s", path.c_str());
-        return false;
+    // ── 已 cook 的二进制版本 (资源包) ───────────────
+    if (PackBlob blob = ResourceManager::FindPacked(path, PackAssetType::Ldtk)) {
+        if (CookedAsset::ReadLdtk(blob.Data, blob.Size, project)) {
+            LOG_INFO("[LDtk] 从资源包加载: %s (%zu 个关卡)", path.c_str(), project.levels.size());
+            return true;
+        }
     }
 
-    json root;
-    try {
-        root = json::parse(file);
-    } catch (const json::parse_error& e) {
-        LOG_ERROR("[LDtk] JSON 解析失败: %s", e.what());
+    // ── 读取 JSON 文件 ─────────────────────────────
+    JsonDocument doc;
+    if (!doc.LoadFile(path)) {
+        LOG_ERROR("[LDtk] JSON 解析失败: %s (%s)", path.c_str(), doc.GetError().c_str());
         return false;
     }
-    file.close();
+    JsonValue root = doc.GetRoot();
 
     // ── 基路径 ─────────────────────────────────────
     std::filesystem::path fsPath(path);
@@ -40,7 +40,7 @@ bool LdtkLoader::Load(const std::string& path, LdtkProject& project) {
         project.basePath += '/';
     }
 
-    project.defaultGridSize = root.value("defaultGridSize", 16);
+    project.defaultGridSize = root.GetI32("defaultGridSize", 16);
 
     LOG_INFO("[LDtk] 加载项目: %s (网格 %d px)", path.c_str(), project.defaultGridSize);
 
@@ -48,61 +48,52 @@ bool LdtkLoader::Load(const std::string& path, LdtkProject& project) {
     std::unordered_map<i32, std::string> tilesetPaths;
     std::unordered_map<i32, std::pair<i32,i32>> tilesetSizes;
 
-    if (root.contains("defs") && root["defs"].contains("tilesets")) {
-        for (auto& ts : root["defs"]["tilesets"]) {
-            i32 uid = ts.value("uid", -1);
-            std::string relPath = ts.value("relPath", "");
-            i32 pxW = ts.value("pxWid", 0);
-            i32 pxH = ts.value("pxHei", 0);
-            tilesetPaths[uid] = relPath;
-            tilesetSizes[uid] = {pxW, pxH};
-        }
+    for (JsonValue ts : root["defs"]["tilesets"].Elements()) {
+        i32 uid = ts.GetI32("uid", -1);
+        tilesetPaths[uid] = ts.GetString("relPath");
+        tilesetSizes[uid] = {ts.GetI32("pxWid"), ts.GetI32("pxHei")};
     }
 
     // ── 解析 Levels ────────────────────────────────
-    if (!root.contains("levels") || !root["levels"].is_array()) {
+    JsonValue levels = root["levels"];
+    if (!levels.IsArray()) {
         LOG_WARN("[LDtk] 项目中无 levels 数组");
         return true;  // 合法的空项目
     }
-    const auto& levels = root["levels"];
 
-    for (auto& lvl : levels) {
+    for (JsonValue lvl : levels.Elements()) {
         LdtkLevel level;
-        level.identifier = lvl.value("identifier", "unnamed");
-        level.uid = lvl.value("uid", 0);
-        level.worldX = lvl.value("worldX", 0);
-        level.worldY = lvl.value("worldY", 0);
-        level.pxWid = lvl.value("pxWid", 0);
-        level.pxHei = lvl.value("pxHei", 0);
+        level.identifier = lvl.GetString("identifier", "unnamed");
+        level.uid = lvl.GetI32("uid");
+        level.worldX = lvl.GetI32("worldX");
+        level.worldY = lvl.GetI32("worldY");
+        level.pxWid = lvl.GetI32("pxWid");
+        level.pxHei = lvl.GetI32("pxHei");
 
         LOG_INFO("[LDtk]   Level: %s (%dx%d px)", level.identifier.c_str(),
                  level.pxWid, level.pxHei);
 
         // ── 解析 layerInstances ────────────────────
-        if (!lvl.contains("layerInstances")) continue;
-        const auto& layerArr = lvl["layerInstances"];
+        JsonValue layerArr = lvl["layerInstances"];
+        if (!layerArr) continue;
 
-        for (auto& li : layerArr) {
+        for (JsonValue li : layerArr.Elements()) {
             LdtkLayer layer;
-            layer.identifier = li.value("__identifier", "");
-            layer.type = li.value("__type", "");
-            layer.gridSize = li.value("__gridSize", 16);
-            layer.gridW = li.value("__cWid", 0);
-            layer.gridH = li.value("__cHei", 0);
-            layer.pxOffsetX = li.value("__pxTotalOffsetX", 0);
-            layer.pxOffsetY = li.value("__pxTotalOffsetY", 0);
-            layer.opacity = li.value("__opacity", 1.0f);
+            layer.identifier = li.GetString("__identifier");
+            layer.type = li.GetString("__type");
+            layer.gridSize = li.GetI32("__gridSize", 16);
+            layer.gridW = li.GetI32("__cWid");
+            layer.gridH = li.GetI32("__cHei");
+            layer.pxOffsetX = li.GetI32("__pxTotalOffsetX");
+            layer.pxOffsetY = li.GetI32("__pxTotalOffsetY");
+            layer.opacity = li.GetF32("__opacity", 1.0f);
 
             // 视差因子 (LDtk 1.3+ __parallaxFactorX/Y)
-            if (li.contains("__parallaxFactorX")) {
-                layer.parallaxFactorX = li["__parallaxFactorX"].get<f32>();
-            }
-            if (li.contains("__parallaxFactorY")) {
-                layer.parallaxFactorY = li["__parallaxFactorY"].get<f32>();
-            }
+            layer.parallaxFactorX = li.GetF32("__parallaxFactorX", layer.parallaxFactorX);
+            layer.parallaxFactorY = li.GetF32("__parallaxFactorY", layer.parallaxFactorY);
 
             // Tileset 信息
-            i32 tsUid = li.value("__tilesetDefUid", -1);
+            i32 tsUid = li.GetI32("__tilesetDefUid", -1);
             if (tsUid >= 0 && tilesetPaths.count(tsUid)) {
                 layer.tilesetRelPath = tilesetPaths[tsUid];
                 layer.tilesetW = tilesetSizes[tsUid].first;
@@ -112,77 +103,75 @@ bool LdtkLoader::Load(const std::string& path, LdtkProject& project) {
             // ── 解析 Tiles ──────────────────────────
             // autoLayerTiles (Auto-Layer 生成的) 和
             // gridTiles (手动放置的) 合并
+            // 瓦片是文件的主体: 单遍遍历成员，不做按键查找
 
-            auto parseTiles = [&](const json& arr) {
-                for (auto& t : arr) {
+            auto parseTiles = [&](JsonValue arr) {
+                layer.tiles.reserve(layer.tiles.size() + arr.Size());
+                for (JsonValue t : arr.Elements()) {
                     LdtkTile tile;
-                    if (t.contains("px") && t["px"].size() >= 2) {
-                        tile.px_x = t["px"][0].get<i32>();
-                        tile.px_y = t["px"][1].get<i32>();
-                    }
-                    if (t.contains("src") && t["src"].size() >= 2) {
-                        tile.src_x = t["src"][0].get<i32>();
-                        tile.src_y = t["src"][1].get<i32>();
+                    for (const auto& [key, v] : t.Members()) {
+                        if (key == "px") {
+                            tile.px_x = v[0u].AsI32();
+                            tile.px_y = v[1u].AsI32();
+                        } else if (key == "src") {
+                            tile.src_x = v[0u].AsI32();
+                            tile.src_y = v[1u].AsI32();
+                        } else if (key == "f") {
+                            tile.flip = (u8)v.AsI32();
+                        }
                     }
-                    tile.flip = t.value("f", 0);
                     layer.tiles.push_back(tile);
                 }
             };
 
-            if (li.contains("autoLayerTiles")) {
-                parseTiles(li["autoLayerTiles"]);
-            }
-            if (li.contains("gridTiles")) {
-                parseTiles(li["gridTiles"]);
-            }
+            parseTiles(li["autoLayerTiles"]);
+            parseTiles(li["gridTiles"]);
 
             // ── IntGrid (碰撞数据等) ─────────────────
-            if (li.contains("intGridCsv")) {
+            if (JsonValue csv = li["intGridCsv"]) {
                 layer.intGrid.clear();
-                for (auto& v : li["intGridCsv"]) {
-                    layer.intGrid.push_back(v.get<i32>());
+                layer.intGrid.reserve(csv.Size());
+                for (JsonValue v : csv.Elements()) {
+                    layer.intGrid.push_back(v.AsI32());
                 }
             }
 
             // ── Entity 实例 (spawn point/NPC/物品等) ───
-            if (li.contains("entityInstances")) {
-                for (auto& ei : li["entityInstances"]) {
-                    LdtkEntity entity;
-                    entity.identifier = ei.value("__identifier", "");
-
-                    if (ei.contains("px") && ei["px"].size() >= 2) {
-                        entity.px_x = ei["px"][0].get<i32>();
-                        entity.px_y = ei["px"][1].get<i32>();
-                    }
-                    entity.width  = ei.value("width", 16);
-                    entity.height = ei.value("height", 16);
+            for (JsonValue ei : li["entityInstances"].Elements()) {
+                LdtkEntity entity;
+                entity.identifier = ei.GetString("__identifier");
 
-                    if (ei.contains("__pivot") && ei["__pivot"].size() >= 2) {
-                        entity.pivotX = ei["__pivot"][0].get<f32>();
-                        entity.pivotY = ei["__pivot"][1].get<f32>();
-                    }
+                if (JsonValue px = ei["px"]; px.Size() >= 2) {
+                    entity.px_x = px[0u].AsI32();
+                    entity.px_y = px[1u].AsI32();
+                }
+                entity.width  = ei.GetI32("width", 16);
+                entity.height = ei.GetI32("height", 16);
 
-                    // 解析自定义字段
-                    if (ei.contains("fieldInstances")) {
-                        for (auto& fi : ei["fieldInstances"]) {
-                            std::string fid = fi.value("__identifier", "");
-                            std::string ftype = fi.value("__type", "");
-                            if (fid.empty() || fi["__value"].is_null()) continue;
-
-                            if (ftype == "Int" || ftype == "Integer") {
-                                entity.fields[fid] = fi["__value"].get<i32>();
-                            } else if (ftype == "Float") {
-                                entity.fields[fid] = fi["__value"].get<f32>();
-                            } else if (ftype == "Bool" || ftype == "Boolean") {
-                                entity.fields[fid] = fi["__value"].get<bool>();
-                            } else if (ftype == "String" || ftype == "Enum") {
-                                entity.fields[fid] = fi["__value"].get<std::string>();
-                            }
-                        }
-                    }
+                if (JsonValue pivot = ei["__pivot"]; pivot.Size() >= 2) {
+                    entity.pivotX = pivot[0u].AsF32();
+                    entity.pivotY = pivot[1u].AsF32();
+                }
 
-                    layer.entities.push_back(std::move(entity));
+                // 解析自定义字段
+                for (JsonValue fi : ei["fieldInstances"].Elements()) {
+                    std::string fid = fi.GetString("__identifier");
+                    std::string ftype = fi.GetString("__type");
+                    JsonValue value = fi["__value"];
+                    if (fid.empty() || !value || value.IsNull()) continue;
+
+                    if (ftype == "Int" || ftype == "Integer") {
+                        entity.fields[fid] = value.AsI32();
+                    } else if (ftype == "Float") {
+                        entity.fields[fid] = value.AsF32();
+                    } else if (ftype == "Bool" || ftype == "Boolean") {
+                        entity.fields[fid] = value.AsBool();
+                    } else if (ftype == "String" || ftype == "Enum") {
+                        entity.fields[fid] = value.AsString();
+                    }
                 }
+
+                layer.entities.push_back(std::move(entity));
             }
 
             LOG_INFO("[LDtk]     Layer: %s (%s) %dx%d, %zu tiles, %zu entities",
@@ -0,0 +1,193 @@
+#include "engine/game2d/tile_collision_grid.h"
+#include "engine/game2d/tilemap.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Engine {
+
+// 贴边容差: 边缘恰好落在 tile 边界上时算接触而不算重叠
+static constexpr f32 SKIN = 0.001f;
+
+static constexpr u32 SOLID_PLANE = 0;
+
+/// TileCollision → 位平面 (None 返回 CLASS_COUNT)
+static u32 PlaneOf(TileCollision collision) {
+    return collision == TileCollision::None ? TileCollisionGrid::CLASS_COUNT : (u32)collision - 1;
+}
+
+/// word 内 [lo, hi] 位 (0..63) 的掩码
+static u64 BitRange(u32 lo, u32 hi) {
+    return (~0ull << lo) & (~0ull >> (63 - hi));
+}
+
+/// 第 word 个 u64 与列区间 [x0, x1] 相交部分的掩码
+static u64 WordMask(u32 word, u32 x0, u32 x1) {
+    u32 lo = word == (x0 >> 6) ? (x0 & 63) : 0;
+    u32 hi = word == (x1 >> 6) ? (x1 & 63) : 63;
+    return BitRange(lo, hi);
+}
+
+void TileCollisionGrid::Resize(u32 width, u32 height) {
+    m_Width = width;
+    m_Height = height;
+    m_WordsPerRow = (width + 63) / 64;
+    m_Bits.assign((size_t)CLASS_COUNT * height * m_WordsPerRow, 0);
+}
+
+void TileCollisionGrid::Set(u32 x, u32 y, TileCollision collision) {
+    if (x >= m_Width || y >= m_Height) return;
+    u64 bit = 1ull << (x & 63);
+    u32 target = PlaneOf(collision);
+    for (u32 plane = 0; plane < CLASS_COUNT; plane++) {
+        u64& word = Row(plane, y)[x >> 6];
+        word = plane == target ? (word | bit) : (word & ~bit);
+    }
+}
+
+TileCollision TileCollisionGrid::Get(u32 x, u32 y) const {
+    if (x >= m_Width || y >= m_Height) return TileCollision::None;
+    for (u32 plane = 0; plane < CLASS_COUNT; plane++) {
+        if ((Row(plane, y)[x >> 6] >> (x & 63)) & 1) return (TileCollision)(plane + 1);
+    }
+    return TileCollision::None;
+}
+
+bool TileCollisionGrid::Test(TileCollision collision, u32 x, u32 y) const {
+    u32 plane = PlaneOf(collision);
+    if (plane >= CLASS_COUNT || x >= m_Width || y >= m_Height) return false;
+    return (Row(plane, y)[x >> 6] >> (x & 63)) & 1;
+}
+
+const u64* TileCollisionGrid::GetRow(TileCollision collision, u32 y) const {
+    u32 plane = PlaneOf(collision);
+    if (plane >= CLASS_COUNT || y >= m_Height) return nullptr;
+    return Row(plane, y);
+}
+
+bool TileCollisionGrid::RowAny(u32 plane, u32 y, u32 x0, u32 x1) const {
+    const u64* row = Row(plane, y);
+    for (u32 w = x0 >> 6; w <= (x1 >> 6); w++) {
+        if (row[w] & WordMask(w, x0, x1)) return true;
+    }
+    return false;
+}
+
+i32 TileCollisionGrid::FindColumn(u32 plane, u32 y0, u32 y1, u32 x0, u32 x1, bool ascending) const {
+    u32 first = x0 >> 6, last = x1 >> 6;
+    for (u32 i = 0; i <= last - first; i++) {
+        u32 w = ascending ? first + i : last - i;
+        u64 acc = 0;
+        for (u32 y = y0; y <= y1; y++) acc |= Row(plane, y)[w];
+        acc &= WordMask(w, x0, x1);
+        if (!acc) continue;
+        return (i32)(w * 64 + (ascending ? std::countr_zero(acc) : 63 - std::countl_zero(acc)));
+    }
+    return -1;
+}
+
+bool TileCollisionGrid::AnyInRect(TileCollision collision, i32 x0, i32 y0, i32 x1, i32 y1) const {
+    if (x0 > x1 || y0 > y1) return false;
+    if (x0 < 0 || y0 < 0 || x1 >= (i32)m_Width || y1 >= (i32)m_Height) return true;
+    u32 plane = PlaneOf(collision);
+    if (plane >= CLASS_COUNT) return false;
+    for (i32 y = y0; y <= y1; y++) {
+        if (RowAny(plane, (u32)y, (u32)x0, (u32)x1)) return true;
+    }
+    return false;
+}
+
+// ── 扫掠 ────────────────────────────────────────────────────
+// 只检查移动中新进入的列 (行)，第一个阻挡列 (行) 的边界就是接触位置
+
+f32 TileCollisionGrid::SweepX(const glm::vec2& center, const glm::vec2& halfSize, f32 dx) const {
+    if (dx == 0.0f) return 0.0f;
+    i32 y0 = (i32)std::floor(center.y - halfSize.y + SKIN);
+    i32 y1 = std::max(y0, (i32)std::floor(center.y + halfSize.y - SKIN));
+    if (y0 < 0 || y1 >= (i32)m_Height) return 0.0f;
+
+    // 新进入的列 [first, last] 中第一个阻挡列；地图以外的列都阻挡
+    i32 w = (i32)m_Width;
+    if (dx > 0.0f) {
+        f32 right = center.x + halfSize.x;
+        i32 first = (i32)std::floor(right - SKIN) + 1;
+        i32 last = (i32)std::floor(right + dx - SKIN);
+        if (last < first) return dx;
+
+        i32 hit = first;
+        if (first >= 0 && first < w) {
+            hit = FindColumn(SOLID_PLANE, y0, y1, first, std::min(last, w - 1), true);
+            if (hit < 0) {
+                if (last < w) return dx;
+                hit = w;
+            }
+        }
+        return std::min(dx, std::max(0.0f, (f32)hit - right));
+    }
+
+    f32 left = center.x - halfSize.x;
+    i32 first = (i32)std::floor(left + SKIN) - 1;
+    i32 last = (i32)std::floor(left + dx + SKIN);
+    if (last > first) return dx;
+
+    i32 hit = first;
+    if (first >= 0 && first < w) {
+        hit = FindColumn(SOLID_PLANE, y0, y1, std::max(last, 0), first, false);
+        if (hit < 0) {
+            if (last >= 0) return dx;
+            hit = -1;
+        }
+    }
+    return std::max(dx, std::min(0.0f, (f32)(hit + 1) - left));
+}
+
+f32 TileCollisionGrid::SweepY(const glm::vec2& center, const glm::vec2& halfSize, f32 dy) const {
+    if (dy == 0.0f) return 0.0f;
+    i32 x0 = (i32)std::floor(center.x - halfSize.x + SKIN);
+    i32 x1 = std::max(x0, (i32)std::floor(center.x + halfSize.x - SKIN));
+    if (x0 < 0 || x1 >= (i32)m_Width) return 0.0f;
+
+    i32 h = (i32)m_Height;
+    if (dy > 0.0f) {
+        f32 top = center.y + halfSize.y;
+        i32 first = (i32)std::floor(top - SKIN) + 1;
+        i32 last = (i32)std::floor(top + dy - SKIN);
+        for (i32 y = first; y <= last; y++) {
+            if (y < 0 || y >= h || RowAny(SOLID_PLANE, (u32)y, (u32)x0, (u32)x1)) {
+                return std::min(dy, std::max(0.0f, (f32)y - top));
+            }
+        }
+        return dy;
+    }
+
+    f32 bottom = center.y - halfSize.y;
+    i32 first = (i32)std::floor(bottom + SKIN) - 1;
+    i32 last = (i32)std::floor(bottom + dy + SKIN);
+    for (i32 y = first; y >= last; y--) {
+        if (y < 0 || y >= h || RowAny(SOLID_PLANE, (u32)y, (u32)x0, (u32)x1)) {
+            return std::max(dy, std::min(0.0f, (f32)(y + 1) - bottom));
+        }
+    }
+    return dy;
+}
+
+glm::vec2 TileCollisionGrid::MoveAndSlide(const glm::vec2& oldPos, const glm::vec2& newPos,
+                                          const glm::vec2& halfSize) const {
+    glm::vec2 result = oldPos;
+    result.x += SweepX(result, halfSize, newPos.x - oldPos.x);
+    result.y += SweepY(result, halfSize, newPos.y - oldPos.y);
+    return result;
+}
+
+void TileCollisionGrid::MoveAndSlideBatch(const glm::vec2* oldPos, glm::vec2* newPos,
+                                          const glm::vec2* halfSize, u32 count) const {
+    JobSystem::ParallelForRange(count, 256, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) {
+            newPos[i] = MoveAndSlide(oldPos[i], newPos[i], halfSize[i]);
+        }
+    });
+}
+
+} // namespace Engine
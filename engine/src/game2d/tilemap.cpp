@@ -1,23 +1,107 @@
 #include "engine/game2d/tilemap.h"
+#include "engine/game2d/tilemap_chunks.h"
 #include "engine/renderer/sprite_batch.h"
 #include "engine/core/resource_manager.h"
 #include "engine/core/log.h"
+#include "engine/core/json.h"
 
+#include <atomic>
+#include <algorithm>
 #include <fstream>
 #include <cmath>
 
 namespace Engine {
 
 TileData Tilemap::s_EmptyTile = {};
+static std::atomic<u32> s_ChunkVersionCounter{0};
 
 Tilemap::Tilemap(u32 width, u32 height, u32 tileSize)
-    : m_Width(width), m_Height(height), m_TileSize(tileSize) {}
+    : m_Width(width), m_Height(height), m_TileSize(tileSize) {
+    m_CollisionGrid.Resize(width, height);
+}
 
+// Tiled JSON 子集:
+//   width/height/tilewidth, layers[] 中 type == "tilelayer" 的 data (gid 数组, 0=空;
+//   gid - firstgid + 1 即本引擎的 TileID),
+//   tilesets[0] 的 image/columns/firstgid, 以及 tiles[].properties 中的
+//   "collision" ("solid"/"water"/"interact") 与 "interact" (整数)
 bool Tilemap::LoadFromJSON(const std::string& filepath) {
-    // 简易 JSON 读取 — 未来可替换为 nlohmann::json
-    // 目前仅支持手动构建
-    LOG_WARN("[Tilemap] JSON 加载暂未实现, 请使用 API 手动构建: %s", filepath.c_str());
-    return false;
+    JsonDocument doc;
+    if (!doc.LoadFile(filepath)) {
+        LOG_ERROR("[Tilemap] JSON 解析失败: %s (%s)", filepath.c_str(), doc.GetError().c_str());
+        return false;
+    }
+    JsonValue root = doc.GetRoot();
+
+    i32 width = root.GetI32("width");
+    i32 height = root.GetI32("height");
+    if (width <= 0 || height <= 0) {
+        LOG_ERROR("[Tilemap] 缺少有效的 width/height: %s", filepath.c_str());
+        return false;
+    }
+    m_Width = (u32)width;
+    m_Height = (u32)height;
+    m_TileSize = (u32)root.GetI32("tilewidth", (i32)m_TileSize);
+    m_Layers.clear();
+    m_CollisionGrid.Resize(m_Width, m_Height);
+
+    // ── Tileset (只取第一个) ───────────────────────
+    i32 firstGid = 1;
+    std::unordered_map<i32, TileData> tileProps;   // 本地 TileID → 碰撞属性
+    if (JsonValue ts = root["tilesets"][0u]) {
+        firstGid = ts.GetI32("firstgid", 1);
+        if (ts.Contains("image")) SetTilesetTexture(ts.GetString("image"));
+        if (i32 cols = ts.GetI32("columns"); cols > 0) m_TilesetColumns = (u32)cols;
+
+        for (JsonValue tile : ts["tiles"].Elements()) {
+            TileData data;
+            for (JsonValue prop : tile["properties"].Elements()) {
+                JsonValue name = prop["name"];
+                JsonValue value = prop["value"];
+                if (name.Equals("collision")) {
+                    if (value.Equals("solid"))         data.Collision = TileCollision::Solid;
+                    else if (value.Equals("water"))    data.Collision = TileCollision::Water;
+                    else if (value.Equals("interact")) data.Collision = TileCollision::Interact;
+                } else if (name.Equals("interact")) {
+                    data.InteractType = (u8)value.AsI32();
+                }
+            }
+            tileProps[tile.GetI32("id")] = data;
+        }
+    }
+
+    // ── Tile 层 ────────────────────────────────────
+    const u32 count = m_Width * m_Height;
+    for (JsonValue layerJson : root["layers"].Elements()) {
+        if (!layerJson["type"].Equals("tilelayer")) continue;
+
+        AddLayer(layerJson.GetString("name", "Layer"), (i32)m_Layers.size());
+        TilemapLayer& layer = m_Layers.back();
+        layer.Visible = layerJson.GetBool("visible", true);
+
+        u32 i = 0;
+        for (JsonValue gidJson : layerJson["data"].Elements()) {
+            if (i >= count) break;
+            // 高 3 位是 Tiled 的翻转标志，这里不支持翻转，直接去掉
+            i64 gid = gidJson.AsI64() & 0x1FFFFFFF;
+            if (gid >= firstGid) {
+                i32 local = (i32)gid - firstGid;
+                auto it = tileProps.find(local);
+                TileData& tile = layer.Tiles[i];
+                if (it != tileProps.end()) tile = it->second;
+                tile.TileID = (u16)(local + 1);
+            }
+            i++;
+        }
+    }
+
+    for (u32 y = 0; y < m_Height; y++) {
+        for (u32 x = 0; x < m_Width; x++) RefreshCollision(x, y);
+    }
+
+    LOG_INFO("[Tilemap] 已加载: %s (%ux%u, %u 层)", filepath.c_str(),
+             m_Width, m_Height, (u32)m_Layers.size());
+    return true;
 }
 
 void Tilemap::AddLayer(const std::string& name, i32 zOrder) {
@@ -25,6 +109,7 @@ void Tilemap::AddLayer(const std::string& name, i32 zOrder) {
     layer.Name = name;
     layer.ZOrder = zOrder;
     layer.Tiles.resize(m_Width * m_Height);
+    layer.ChunkVersions.assign(GetChunkCountX() * GetChunkCountY(), ++s_ChunkVersionCounter);
     m_Layers.push_back(std::move(layer));
 }
 
@@ -42,24 +127,54 @@ const TileData& Tilemap::GetTile(u32 layerIdx, u32 x, u32 y) const {
 
 void Tilemap::SetTile(u32 layerIdx, u32 x, u32 y, const TileData& tile) {
     if (layerIdx >= m_Layers.size() || x >= m_Width || y >= m_Height) return;
-    m_Layers[layerIdx].Tiles[y * m_Width + x] = tile;
+    TileData& dst = m_Layers[layerIdx].Tiles[y * m_Width + x];
+    if (dst.TileID == tile.TileID && dst.Collision == tile.Collision &&
+        dst.InteractType == tile.InteractType) return;
+    dst = tile;
+    MarkDirty(layerIdx, x, y);
 }
 
-TileCollision Tilemap::GetCollision(u32 x, u32 y) const {
+void Tilemap::MarkDirty(u32 layerIdx, u32 x, u32 y) {
+    if (layerIdx >= m_Layers.size() || x >= m_Width || y >= m_Height) return;
+    auto& versions = m_Layers[layerIdx].ChunkVersions;
+    u32 chunksX = GetChunkCountX();
+    u32 chunksY = GetChunkCountY();
+    u32 version = ++s_ChunkVersionCounter;
+
+    RefreshCollision(x, y);
+
+    u32 cx = x / CHUNK_SIZE, cy = y / CHUNK_SIZE;
+    versions[cy * chunksX + cx] = version;
+    // 边缘 tile 影响相邻区块的 autotile 结果
+    u32 lx = x % CHUNK_SIZE, ly = y % CHUNK_SIZE;
+    if (lx == 0 && cx > 0)                        versions[cy * chunksX + cx - 1] = version;
+    if (lx == CHUNK_SIZE - 1 && cx + 1 < chunksX) versions[cy * chunksX + cx + 1] = version;
+    if (ly == 0 && cy > 0)                        versions[(cy - 1) * chunksX + cx] = version;
+    if (ly == CHUNK_SIZE - 1 && cy + 1 < chunksY) versions[(cy + 1) * chunksX + cx] = version;
+}
+
+u32 Tilemap::GetChunkVersion(u32 layerIdx, u32 cx, u32 cy) const {
+    if (layerIdx >= m_Layers.size() || cx >= GetChunkCountX() || cy >= GetChunkCountY()) return 0;
+    return m_Layers[layerIdx].ChunkVersions[cy * GetChunkCountX() + cx];
+}
+
+void Tilemap::RefreshCollision(u32 x, u32 y) {
     // 在所有层中查找最高优先碰撞
     TileCollision result = TileCollision::None;
     for (auto& layer : m_Layers) {
-        if (x < m_Width && y < m_Height) {
-            auto& td = layer.Tiles[y * m_Width + x];
-            if (td.Collision > result)
-                result = td.Collision;
-        }
+        auto& td = layer.Tiles[y * m_Width + x];
+        if (td.Collision > result)
+            result = td.Collision;
     }
-    return result;
+    m_CollisionGrid.Set(x, y, result);
+}
+
+TileCollision Tilemap::GetCollision(u32 x, u32 y) const {
+    return m_CollisionGrid.Get(x, y);
 }
 
 bool Tilemap::IsSolid(u32 x, u32 y) const {
-    return GetCollision(x, y) == TileCollision::Solid;
+    return m_CollisionGrid.Test(TileCollision::Solid, x, y);
 }
 
 glm::ivec2 Tilemap::WorldToTile(const glm::vec2& worldPos) const {
@@ -71,25 +186,45 @@ glm::vec2 Tilemap::TileToWorld(u32 x, u32 y) const {
 }
 
 bool Tilemap::CheckAABBCollision(const glm::vec2& pos, const glm::vec2& size) const {
-    // 获取 AABB 覆盖的 Tile 范围
+    // AABB 覆盖的 Tile 范围，逐行按位掩码检查 (地图边界 = 碰撞)
     i32 minX = (i32)std::floor(pos.x - size.x * 0.5f);
     i32 minY = (i32)std::floor(pos.y - size.y * 0.5f);
     i32 maxX = (i32)std::floor(pos.x + size.x * 0.5f);
     i32 maxY = (i32)std::floor(pos.y + size.y * 0.5f);
-
-    for (i32 y = minY; y <= maxY; y++) {
-        for (i32 x = minX; x <= maxX; x++) {
-            if (x < 0 || y < 0 || x >= (i32)m_Width || y >= (i32)m_Height) {
-                return true; // 地图边界 = 碰撞
-            }
-            if (IsSolid((u32)x, (u32)y)) return true;
-        }
-    }
-    return false;
+    return m_CollisionGrid.AnyInRect(TileCollision::Solid, minX, minY, maxX, maxY);
 }
 
 // ── TilemapRenderer ────────────────────────────────────────
 
+glm::vec4 TilemapRenderer::GetTileUV(u16 tileID, u32 tileSize, u32 columns, u32 texWidth, u32 texHeight) {
+    u32 tileIdx = tileID - 1; // TileID 从 1 开始
+    u32 col = tileIdx % columns;
+    u32 row = tileIdx / columns;
+
+    // 计算 tileset 图集中的 UV 子区域
+    // stbi Y翻转: PNG top=0 → OpenGL v=1.0, 需要 1.0-v 补偿
+    f32 tileU0 = (f32)(col * tileSize) / (f32)texWidth;
+    f32 tileU1 = (f32)((col + 1) * tileSize) / (f32)texWidth;
+    f32 tileV0 = 1.0f - (f32)((row + 1) * tileSize) / (f32)texHeight; // 底边
+    f32 tileV1 = 1.0f - (f32)(row * tileSize) / (f32)texHeight;       // 顶边
+
+    // half-pixel inset 防止采样到相邻 tile
+    f32 halfPxU = 0.5f / (f32)texWidth;
+    f32 halfPxV = 0.5f / (f32)texHeight;
+    return {tileU0 + halfPxU, tileV0 + halfPxV, tileU1 - halfPxU, tileV1 - halfPxV};
+}
+
+/// 相机可见的 tile 范围 (含边界)
+static void VisibleTileRange(const Tilemap& map, const glm::vec2& cameraPos, const glm::vec2& viewportSize,
+                             glm::ivec2& minTile, glm::ivec2& maxTile) {
+    f32 halfW = viewportSize.x * 0.5f;
+    f32 halfH = viewportSize.y * 0.5f;
+    minTile.x = std::max(0, (i32)std::floor(cameraPos.x - halfW));
+    minTile.y = std::max(0, (i32)std::floor(cameraPos.y - halfH));
+    maxTile.x = std::min((i32)map.GetWidth() - 1,  (i32)std::ceil(cameraPos.x + halfW));
+    maxTile.y = std::min((i32)map.GetHeight() - 1, (i32)std::ceil(cameraPos.y + halfH));
+}
+
 void TilemapRenderer::Draw(const Tilemap& map,
                            const glm::vec2& cameraPos,
                            const glm::vec2& viewportSize,
@@ -103,52 +238,45 @@ void TilemapRenderer::Draw(const Tilemap& map,
     u32 texH = tex->GetHeight();
 
     // 计算可见 Tile 范围
-    f32 halfW = viewportSize.x * 0.5f;
-    f32 halfH = viewportSize.y * 0.5f;
-    i32 minX = std::max(0, (i32)std::floor(cameraPos.x - halfW));
-    i32 minY = std::max(0, (i32)std::floor(cameraPos.y - halfH));
-    i32 maxX = std::min((i32)map.GetWidth() - 1,  (i32)std::ceil(cameraPos.x + halfW));
-    i32 maxY = std::min((i32)map.GetHeight() - 1, (i32)std::ceil(cameraPos.y + halfH));
+    glm::ivec2 minTile, maxTile;
+    VisibleTileRange(map, cameraPos, viewportSize, minTile, maxTile);
 
     // 逐层绘制
     for (u32 l = 0; l < map.GetLayerCount(); l++) {
         auto& layer = map.GetLayer(l);
         if (!layer.Visible) continue;
 
-        for (i32 y = minY; y <= maxY; y++) {
-            for (i32 x = minX; x <= maxX; x++) {
+        for (i32 y = minTile.y; y <= maxTile.y; y++) {
+            for (i32 x = minTile.x; x <= maxTile.x; x++) {
                 auto& tile = map.GetTile(l, (u32)x, (u32)y);
                 if (tile.TileID == 0) continue; // 0 = 空 Tile
 
-                // 计算图集中的 UV
-                u32 tileIdx = tile.TileID - 1; // TileID 从 1 开始
-                u32 col = tileIdx % tilesetCols;
-                u32 row = tileIdx / tilesetCols;
-
                 glm::vec2 pos((f32)x, (f32)y);
                 glm::vec2 size(1.0f, 1.0f);
-
-                // 计算 tileset 图集中的 UV 子区域
-                // stbi Y翻转: PNG top=0 → OpenGL v=1.0, 需要 1.0-v 补偿
-                f32 tileU0 = (f32)(col * tileSize) / (f32)texW;
-                f32 tileU1 = (f32)((col + 1) * tileSize) / (f32)texW;
-                f32 tileV0 = 1.0f - (f32)((row + 1) * tileSize) / (f32)texH; // 底边
-                f32 tileV1 = 1.0f - (f32)(row * tileSize) / (f32)texH;       // 顶边
-
-                // half-pixel inset 防止采样到相邻 tile
-                f32 halfPxU = 0.5f / (f32)texW;
-                f32 halfPxV = 0.5f / (f32)texH;
-                tileU0 += halfPxU;
-                tileV0 += halfPxV;
-                tileU1 -= halfPxU;
-                tileV1 -= halfPxV;
-
                 SpriteBatch::Draw(tex, pos, size,
-                                  {tileU0, tileV0, tileU1, tileV1}, 0.0f,
+                                  GetTileUV(tile.TileID, tileSize, tilesetCols, texW, texH), 0.0f,
                                   glm::vec4(1.0f));
             }
         }
     }
 }
 
+void TilemapRenderer::Draw(TilemapChunkCache& cache,
+                           const Tilemap& map,
+                           const glm::vec2& cameraPos,
+                           const glm::vec2& viewportSize,
+                           const glm::mat4& transform) {
+    cache.Rebuild(map);
+    cache.Upload();
+
+    glm::ivec2 minTile, maxTile;
+    VisibleTileRange(map, cameraPos, viewportSize, minTile, maxTile);
+
+    // 层从下往上，静态网格按提交顺序绘制
+    for (u32 l = 0; l < map.GetLayerCount(); l++) {
+        if (!map.GetLayer(l).Visible) continue;
+        cache.Draw(l, minTile, maxTile, transform);
+    }
+}
+
 } // namespace Engine
@@ -0,0 +1,120 @@
+#include "engine/game2d/tilemap_chunks.h"
+#include "engine/renderer/sprite_batch.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+
+namespace Engine {
+
+TilemapChunkCache::TilemapChunkCache() = default;
+TilemapChunkCache::~TilemapChunkCache() = default;
+
+void TilemapChunkCache::SetMesher(TileMesher mesher) {
+    m_Mesher = std::move(mesher);
+    for (Chunk& chunk : m_Chunks) chunk.BuiltVersion = 0;
+}
+
+TileMesher TilemapChunkCache::CreateTilesetMesher(const Ref<Texture2D>& tileset, u32 tileSize, u32 columns) {
+    return [tileset, tileSize, columns](const Tilemap& map, u32 layer, u32 x, u32 y, SpriteCommandList& out) {
+        if (!tileset || !tileset->IsValid()) return;
+        u16 tileID = map.GetTile(layer, x, y).TileID;
+        glm::vec4 uv = TilemapRenderer::GetTileUV(tileID, tileSize, columns,
+                                                  tileset->GetWidth(), tileset->GetHeight());
+        out.Draw(tileset->GetID(), {(f32)x, (f32)y}, {1.0f, 1.0f}, uv, 0.0f, glm::vec4(1.0f));
+    };
+}
+
+void TilemapChunkCache::Invalidate() {
+    m_Chunks.clear();
+    m_MapWidth = m_MapHeight = 0;
+    m_ChunksX = m_ChunksY = m_Layers = 0;
+}
+
+u32 TilemapChunkCache::Rebuild(const Tilemap& map) {
+    if (!m_Mesher) return 0;
+
+    if (map.GetWidth() != m_MapWidth || map.GetHeight() != m_MapHeight || map.GetLayerCount() != m_Layers) {
+        m_MapWidth = map.GetWidth();
+        m_MapHeight = map.GetHeight();
+        m_ChunksX = map.GetChunkCountX();
+        m_ChunksY = map.GetChunkCountY();
+        m_Layers = map.GetLayerCount();
+        m_Chunks.clear();
+        m_Chunks.resize((size_t)m_Layers * m_ChunksY * m_ChunksX);
+    }
+
+    m_Stale.clear();
+    for (u32 l = 0; l < m_Layers; l++) {
+        for (u32 cy = 0; cy < m_ChunksY; cy++) {
+            for (u32 cx = 0; cx < m_ChunksX; cx++) {
+                u32 index = (l * m_ChunksY + cy) * m_ChunksX + cx;
+                if (m_Chunks[index].BuiltVersion != map.GetChunkVersion(l, cx, cy)) m_Stale.push_back(index);
+            }
+        }
+    }
+    if (m_Stale.empty()) return 0;
+
+    // 每个任务区间一组列表/构建器，区块之间互不共享
+    JobSystem::ParallelForRange((u32)m_Stale.size(), 1, [this, &map](u32 begin, u32 end) {
+        SpriteCommandList list;
+        SpriteBatchBuilder builder;
+        builder.SetLayerSortMode(0, SpriteSortMode::Texture);
+        const SpriteCommandList* lists[] = {&list};
+
+        for (u32 i = begin; i < end; i++) {
+            u32 index = m_Stale[i];
+            u32 cx = index % m_ChunksX;
+            u32 cy = (index / m_ChunksX) % m_ChunksY;
+            u32 layer = index / (m_ChunksX * m_ChunksY);
+
+            u32 x0 = cx * Tilemap::CHUNK_SIZE, x1 = std::min(x0 + Tilemap::CHUNK_SIZE, m_MapWidth);
+            u32 y0 = cy * Tilemap::CHUNK_SIZE, y1 = std::min(y0 + Tilemap::CHUNK_SIZE, m_MapHeight);
+            list.Clear();
+            for (u32 y = y0; y < y1; y++) {
+                for (u32 x = x0; x < x1; x++) {
+                    if (map.GetTile(layer, x, y).TileID == 0) continue;
+                    m_Mesher(map, layer, x, y, list);
+                }
+            }
+
+            Chunk& chunk = m_Chunks[index];
+            builder.Build(lists, 1, SpriteBatch::MAX_QUADS);
+            chunk.Vertices.resize((size_t)builder.GetQuadCount() * 4);
+            builder.WriteVertices(0, builder.GetQuadCount(), chunk.Vertices.data());
+            chunk.Batches = builder.GetQuadCount() > 0 ? builder.GetBatches() : std::vector<SpriteDrawBatch>{};
+            chunk.BuiltVersion = map.GetChunkVersion(layer, cx, cy);
+            chunk.NeedsUpload = true;
+        }
+    });
+    return (u32)m_Stale.size();
+}
+
+void TilemapChunkCache::Upload() {
+    for (Chunk& chunk : m_Chunks) {
+        if (!chunk.NeedsUpload) continue;
+        chunk.NeedsUpload = false;
+        u32 quads = (u32)(chunk.Vertices.size() / 4);
+        if (quads == 0 && !chunk.Mesh) continue;
+        if (!chunk.Mesh) chunk.Mesh = CreateScope<SpriteStaticMesh>();
+        chunk.Mesh->Upload(chunk.Vertices.data(), quads, chunk.Batches);
+    }
+}
+
+void TilemapChunkCache::Draw(u32 layer, const glm::ivec2& minTile, const glm::ivec2& maxTile,
+                             const glm::mat4& transform) const {
+    if (layer >= m_Layers || m_ChunksX == 0 || m_ChunksY == 0) return;
+
+    i32 size = (i32)Tilemap::CHUNK_SIZE;
+    i32 cx0 = std::max(0, minTile.x / size), cx1 = std::min((i32)m_ChunksX - 1, maxTile.x / size);
+    i32 cy0 = std::max(0, minTile.y / size), cy1 = std::min((i32)m_ChunksY - 1, maxTile.y / size);
+    for (i32 cy = cy0; cy <= cy1; cy++) {
+        for (i32 cx = cx0; cx <= cx1; cx++) {
+            const Chunk& chunk = GetChunk(layer, (u32)cx, (u32)cy);
+            if (chunk.Mesh && chunk.Mesh->GetQuadCount() > 0) {
+                SpriteBatch::DrawStaticMesh(*chunk.Mesh, transform);
+            }
+        }
+    }
+}
+
+} // namespace Engine
@@ -1,18 +1,78 @@
 #include "engine/renderer/animation.h"
+#include "engine/core/job_system.h"
 #include "engine/core/log.h"
+#include "engine/core/simd.h"
+#include "engine/core/components.h"
+#include "engine/renderer/frustum.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
+#include <glm/gtx/matrix_decompose.hpp>
+
+#include <algorithm>
+#include <cfloat>
+#include <chrono>
 
 namespace Engine {
 
+// ── AffineTransform ─────────────────────────────────────────
+
+AffineTransform AffineTransform::FromPose(const BonePose& pose) {
+    glm::mat3 r = glm::mat3_cast(pose.Rotation);
+    AffineTransform out;
+    for (int i = 0; i < 3; i++) {
+        out.Rows[i] = glm::vec4(r[0][i] * pose.Scale.x, r[1][i] * pose.Scale.y,
+                                r[2][i] * pose.Scale.z, pose.Position[i]);
+    }
+    return out;
+}
+
+AffineTransform AffineTransform::FromMat4(const glm::mat4& m) {
+    AffineTransform out;
+    for (int i = 0; i < 3; i++) out.Rows[i] = glm::vec4(m[0][i], m[1][i], m[2][i], m[3][i]);
+    return out;
+}
+
+glm::mat4 AffineTransform::ToMat4() const {
+    return glm::mat4(Rows[0].x, Rows[1].x, Rows[2].x, 0.0f,
+                     Rows[0].y, Rows[1].y, Rows[2].y, 0.0f,
+                     Rows[0].z, Rows[1].z, Rows[2].z, 0.0f,
+                     Rows[0].w, Rows[1].w, Rows[2].w, 1.0f);
+}
+
+AffineTransform AffineTransform::operator*(const AffineTransform& rhs) const {
+    using namespace Simd;
+    F4 b0 = Load(&rhs.Rows[0].x);
+    F4 b1 = Load(&rhs.Rows[1].x);
+    F4 b2 = Load(&rhs.Rows[2].x);
+    AffineTransform out;
+    for (int i = 0; i < 3; i++) {
+        const glm::vec4& a = Rows[i];
+        F4 r = MulAdd(Set1(a.x), b0, MulAdd(Set1(a.y), b1, Mul(Set1(a.z), b2)));
+        Store(&out.Rows[i].x, r);
+        out.Rows[i].w += a.w;   // 右侧末行 (0,0,0,1)
+    }
+    return out;
+}
+
 // ── Skeleton ────────────────────────────────────────────────
 
 i32 Skeleton::AddBone(const Bone& bone) {
     i32 idx = (i32)m_Bones.size();
     m_BoneNameMap[bone.Name] = idx;
     m_Bones.push_back(bone);
+
+    // 绑定姿势分解为 TRS，供实例采样时填充无通道的骨骼
+    BonePose rest;
+    glm::vec3 skew;
+    glm::vec4 perspective;
+    if (!glm::decompose(bone.LocalTransform, rest.Scale, rest.Rotation,
+                        rest.Position, skew, perspective)) {
+        rest = BonePose{};
+    }
+    m_RestPose.push_back(rest);
+    m_InverseBind.push_back(AffineTransform::FromMat4(bone.InverseBindMatrix));
     return idx;
 }
 
@@ -26,20 +86,33 @@ void Skeleton::ComputeBoneMatrices(std::vector<glm::mat4>& outMatrices) const {
     u32 count = GetBoneCount();
     outMatrices.resize(count);
 
-    // 临时存储全局变换
-    std::vector<glm::mat4> globalTransforms(count);
-
+    // 第一遍: 输出数组先存全局变换 (父骨骼索引总小于子骨骼)
     for (u32 i = 0; i < count; i++) {
         const Bone& bone = m_Bones[i];
         if (bone.ParentIndex < 0) {
             // 根骨骼
-            globalTransforms[i] = bone.LocalTransform;
+            outMatrices[i] = bone.LocalTransform;
         } else {
             // 子骨骼 = 父全局 * 自身局部
-            globalTransforms[i] = globalTransforms[bone.ParentIndex] * bone.LocalTransform;
+            outMatrices[i] = outMatrices[bone.ParentIndex] * bone.LocalTransform;
         }
-        // Final = GlobalTransform * InverseBindMatrix
-        outMatrices[i] = globalTransforms[i] * bone.InverseBindMatrix;
+    }
+    // 第二遍: Final = GlobalTransform * InverseBindMatrix (子骨骼已不再读取父全局)
+    for (u32 i = 0; i < count; i++) {
+        outMatrices[i] = outMatrices[i] * m_Bones[i].InverseBindMatrix;
+    }
+}
+
+void Skeleton::ComputeBoneMatrices(const BonePose* localPose, AffineTransform* modelPose,
+                                   glm::mat4* outMatrices) const {
+    u32 count = GetBoneCount();
+    for (u32 i = 0; i < count; i++) {
+        AffineTransform local = AffineTransform::FromPose(localPose[i]);
+
+        // 父骨骼索引总小于子骨骼，顺序遍历即可
+        i32 parent = m_Bones[i].ParentIndex;
+        modelPose[i] = parent < 0 ? local : modelPose[parent] * local;
+        outMatrices[i] = (modelPose[i] * m_InverseBind[i]).ToMat4();
     }
 }
 
@@ -50,15 +123,15 @@ glm::vec3 AnimationSampler::InterpolatePosition(
     if (keys.empty()) return glm::vec3(0.0f);
     if (keys.size() == 1) return keys[0].Value;
 
-    // 找到当前时间所在的两个关键帧
-    for (size_t i = 0; i < keys.size() - 1; i++) {
-        if (time < keys[i + 1].Time) {
-            f32 dt = keys[i + 1].Time - keys[i].Time;
-            f32 factor = (dt > 0.0f) ? (time - keys[i].Time) / dt : 0.0f;
-            return glm::mix(keys[i].Value, keys[i + 1].Value, factor);
-        }
-    }
-    return keys.back().Value;
+    // 二分查找当前时间所在的两个关键帧
+    auto it = std::upper_bound(keys.begin(), keys.end(), time,
+                               [](f32 t, const auto& key) { return t < key.Time; });
+    if (it == keys.end()) return keys.back().Value;
+    if (it == keys.begin()) it++;
+    size_t i = (size_t)(it - keys.begin()) - 1;
+    f32 dt = keys[i + 1].Time - keys[i].Time;
+    f32 factor = (dt > 0.0f) ? (time - keys[i].Time) / dt : 0.0f;
+    return glm::mix(keys[i].Value, keys[i + 1].Value, factor);
 }
 
 glm::quat AnimationSampler::InterpolateRotation(
@@ -66,14 +139,15 @@ glm::quat AnimationSampler::InterpolateRotation(
     if (keys.empty()) return glm::quat(1, 0, 0, 0);
     if (keys.size() == 1) return keys[0].Value;
 
-    for (size_t i = 0; i < keys.size() - 1; i++) {
-        if (time < keys[i + 1].Time) {
-            f32 dt = keys[i + 1].Time - keys[i].Time;
-            f32 factor = (dt > 0.0f) ? (time - keys[i].Time) / dt : 0.0f;
-            return glm::slerp(keys[i].Value, keys[i + 1].Value, factor);
-        }
-    }
-    return keys.back().Value;
+    // 二分查找当前时间所在的两个关键帧
+    auto it = std::upper_bound(keys.begin(), keys.end(), time,
+                               [](f32 t, const auto& key) { return t < key.Time; });
+    if (it == keys.end()) return keys.back().Value;
+    if (it == keys.begin()) it++;
+    size_t i = (size_t)(it - keys.begin()) - 1;
+    f32 dt = keys[i + 1].Time - keys[i].Time;
+    f32 factor = (dt > 0.0f) ? (time - keys[i].Time) / dt : 0.0f;
+    return glm::slerp(keys[i].Value, keys[i + 1].Value, factor);
 }
 
 glm::vec3 AnimationSampler::InterpolateScale(
@@ -81,14 +155,15 @@ glm::vec3 AnimationSampler::InterpolateScale(
     if (keys.empty()) return glm::vec3(1.0f);
     if (keys.size() == 1) return keys[0].Value;
 
-    for (size_t i = 0; i < keys.size() - 1; i++) {
-        if (time < keys[i + 1].Time) {
-            f32 dt = keys[i + 1].Time - keys[i].Time;
-            f32 factor = (dt > 0.0f) ? (time - keys[i].Time) / dt : 0.0f;
-            return glm::mix(keys[i].Value, keys[i + 1].Value, factor);
-        }
-    }
-    return keys.back().Value;
+    // 二分查找当前时间所在的两个关键帧
+    auto it = std::upper_bound(keys.begin(), keys.end(), time,
+                               [](f32 t, const auto& key) { return t < key.Time; });
+    if (it == keys.end()) return keys.back().Value;
+    if (it == keys.begin()) it++;
+    size_t i = (size_t)(it - keys.begin()) - 1;
+    f32 dt = keys[i + 1].Time - keys[i].Time;
+    f32 factor = (dt > 0.0f) ? (time - keys[i].Time) / dt : 0.0f;
+    return glm::mix(keys[i].Value, keys[i + 1].Value, factor);
 }
 
 void AnimationSampler::Sample(const AnimationClip& clip, f32 time,
@@ -110,43 +185,332 @@ void AnimationSampler::Sample(const AnimationClip& clip, f32 time,
     }
 }
 
+void AnimationSampler::SamplePose(const AnimationClip& clip, f32 time,
+                                  const Skeleton& skeleton, BonePose* outPose,
+                                  u32 boneLimit) {
+    u32 boneCount = skeleton.GetBoneCount();
+    const auto& rest = skeleton.GetRestPose();
+    for (u32 i = 0; i < boneCount; i++) outPose[i] = rest[i];
+
+    i32 limit = (i32)std::min(boneLimit, boneCount);
+    for (const auto& channel : clip.Channels) {
+        if (channel.BoneIndex < 0 || channel.BoneIndex >= limit) continue;
+
+        BonePose& pose = outPose[channel.BoneIndex];
+        if (!channel.PositionKeys.empty()) pose.Position = InterpolatePosition(channel.PositionKeys, time);
+        if (!channel.RotationKeys.empty()) pose.Rotation = InterpolateRotation(channel.RotationKeys, time);
+        if (!channel.ScaleKeys.empty())    pose.Scale    = InterpolateScale(channel.ScaleKeys, time);
+    }
+}
+
+// ── AnimationSet ────────────────────────────────────────────
+
+i32 AnimationSet::FindClip(const std::string& name) const {
+    for (size_t i = 0; i < Clips.size(); i++) {
+        if (Clips[i].Name == name) return (i32)i;
+    }
+    return -1;
+}
+
+void AnimationSet::CompressClips(const AnimationCompressionSettings& settings, bool keepRaw) {
+    Compressed.clear();
+    if (!SkeletonData) return;
+
+    Compressed.resize(Clips.size());
+    u32 rawBytes = 0, packedBytes = 0;
+    for (size_t i = 0; i < Clips.size(); i++) {
+        AnimationCompressionStats stats;
+        if (!Compressed[i].Build(Clips[i], *SkeletonData, settings, &stats)) continue;
+        rawBytes += stats.RawBytes;
+        packedBytes += stats.CompressedBytes;
+        if (!keepRaw) Clips[i].Channels.clear();
+    }
+    LOG_INFO("[Animation] 压缩 %zu 个剪辑: %u → %u 字节", Clips.size(), rawBytes, packedBytes);
+}
+
+// ── PoseArena ───────────────────────────────────────────────
+
+u32 PoseArena::Allocate(u32 boneCount) {
+    u32 offset = m_Used;
+    m_Used += boneCount;
+    if (m_Used > m_Local.size()) {
+        // 按 1.5 倍增长，避免实例逐个加入时反复扩容
+        size_t capacity = std::max<size_t>(m_Used, m_Local.size() + m_Local.size() / 2);
+        m_Local.resize(capacity);
+        m_Model.resize(capacity);
+    }
+    return offset;
+}
+
+// ── BonePaletteBuffer ───────────────────────────────────────
+
+void BonePaletteBuffer::SetExternalStorage(AffineTransform* data, u32 capacity) {
+    m_External = data != nullptr;
+    m_Data = m_External ? data : m_Owned.data();
+    m_Capacity = m_External ? capacity : (u32)m_Owned.size();
+    m_Used = 0;
+}
+
+u32 BonePaletteBuffer::Allocate(u32 boneCount) {
+    if (m_Used + boneCount > m_Capacity) {
+        if (m_External) return INVALID_PALETTE_OFFSET;
+        size_t capacity = std::max<size_t>(m_Used + boneCount, m_Owned.size() + m_Owned.size() / 2);
+        m_Owned.resize(capacity);
+        m_Data = m_Owned.data();
+        m_Capacity = (u32)capacity;
+    }
+    u32 offset = m_Used;
+    m_Used += boneCount;
+    return offset;
+}
+
 // ── AnimationSystem ─────────────────────────────────────────
 
+namespace {
+
+f32 WrapClipTime(f32 time, f32 duration, bool loop) {
+    if (!loop) return std::clamp(time, 0.0f, duration);
+    time = fmodf(time, duration);
+    return time < 0.0f ? time + duration : time;
+}
+
+} // namespace
+
 void AnimationSystem::Update(ECSWorld& world, f32 dt) {
+    using Clock = std::chrono::steady_clock;
+    auto frameStart = Clock::now();
+
     auto& pool = world.GetComponentArray<AnimatorComponent>();
     u32 count = pool.Size();
+    u32 levelCount = (u32)m_LOD.Levels.size();
+
+    // 串行阶段: 推进时间、解析剪辑、剔除、选 LOD，收集本帧待采样的实例
+    m_Arena.Reset();
+    m_Jobs.clear();
+    m_Blends.clear();
+    m_Candidates.clear();
+    m_Stats = {};
+    if (m_Palette) m_Palette->Reset();
 
     for (u32 i = 0; i < count; i++) {
         AnimatorComponent& anim = pool.Data(i);
-        if (!anim.Playing || !anim.SkeletonRef) continue;
-
-        // 查找当前动画
-        AnimationClip* clip = nullptr;
-        for (auto& c : anim.Clips) {
-            if (c.Name == anim.CurrentClip) {
-                clip = &c;
-                break;
+        anim.PaletteOffset = INVALID_PALETTE_OFFSET;
+        if (!anim.Animations || !anim.Animations->SkeletonData) continue;
+        if (!anim.Playing) {
+            // 停止播放的实例姿势不变，但仍要出现在本帧调色板里
+            if (m_Palette && !anim.BoneMatrices.empty()) {
+                anim.PaletteOffset = m_Palette->Allocate((u32)anim.BoneMatrices.size());
+                PoseJob hold{};
+                hold.Animator = &anim;
+                hold.Kind = JobKind::Hold;
+                if (anim.PaletteOffset != INVALID_PALETTE_OFFSET) m_Blends.push_back(hold);
             }
+            continue;
+        }
+
+        const AnimationSet& set = *anim.Animations;
+        if (anim.ClipIndex < 0 || anim.ClipIndex >= (i32)set.Clips.size()) {
+            anim.ClipIndex = set.FindClip(anim.CurrentClip);
+            anim.Cursor.Reset();
+            anim.PoseValid = false;
+            if (anim.ClipIndex < 0) continue;
         }
-        if (!clip || clip->Duration <= 0.0f) continue;
+        const AnimationClip* clip = &set.Clips[anim.ClipIndex];
+        if (clip->Duration <= 0.0f) continue;
 
         // 时间推进
         anim.CurrentTime += dt * anim.PlaybackSpeed;
         if (anim.Loop) {
-            anim.CurrentTime = fmodf(anim.CurrentTime, clip->Duration);
-            if (anim.CurrentTime < 0) anim.CurrentTime += clip->Duration;
-        } else {
-            if (anim.CurrentTime >= clip->Duration) {
-                anim.CurrentTime = clip->Duration;
-                anim.Playing = false;
+            anim.CurrentTime = WrapClipTime(anim.CurrentTime, clip->Duration, true);
+        } else if (anim.CurrentTime >= clip->Duration) {
+            anim.CurrentTime = clip->Duration;
+            anim.Playing = false;
+        }
+        m_Stats.Animators++;
+
+        const Skeleton* skeleton = set.SkeletonData.get();
+        u32 boneCount = skeleton->GetBoneCount();
+        if (anim.BoneMatrices.size() != boneCount) {
+            anim.BoneMatrices.assign(boneCount, glm::mat4(1.0f));   // 未采样前为绑定姿势
+            anim.PoseValid = false;
+        }
+        const CompressedClip* compressed = nullptr;
+        if (anim.ClipIndex < (i32)set.Compressed.size() && !set.Compressed[anim.ClipIndex].IsEmpty()) {
+            compressed = &set.Compressed[anim.ClipIndex];
+        }
+
+        // 视锥剔除: 不可见的实例只推进时间，恢复可见时立即重新采样
+        Entity entity = pool.GetEntity(i);
+        glm::vec3 center(0.0f);
+        if (auto* tr = world.GetComponent<TransformComponent>(entity)) center = tr->GetWorldPosition();
+        if (m_View.CullFrustum && !m_View.CullFrustum->IsSphereVisible(center, anim.BoundsRadius)) {
+            anim.PoseValid = false;
+            m_Stats.Culled++;
+            continue;
+        }
+
+        // 选 LOD: 有投影信息按屏幕尺寸，否则按距离；都不满足取最后一级
+        f32 distance = glm::length(center - m_View.CameraPosition);
+        bool byScreen = m_View.ProjectionScale > 0.0f;
+        f32 screenSize = byScreen ? 2.0f * anim.BoundsRadius * m_View.ProjectionScale / std::max(distance, 1e-3f) : 0.0f;
+        AnimationLODLevel lod;
+        u32 level = 0;
+        if (levelCount > 0) {
+            level = levelCount - 1;
+            for (u32 l = 0; l < levelCount; l++) {
+                const AnimationLODLevel& candidate = m_LOD.Levels[l];
+                if (byScreen ? screenSize >= candidate.MinScreenSize : distance <= candidate.MaxDistance) {
+                    level = l;
+                    break;
+                }
+            }
+            lod = m_LOD.Levels[level];
+        }
+        u32 interval = std::max(lod.UpdateInterval, 1u);
+        anim.LODLevel = (u8)level;
+        if (m_Palette) anim.PaletteOffset = m_Palette->Allocate(boneCount);
+        if (anim.FramesSinceEval < 0xFFFF) anim.FramesSinceEval++;
+
+        PoseJob job{};
+        job.Animator = &anim;
+        job.Clip = clip;
+        job.Compressed = compressed;
+        job.SkeletonData = skeleton;
+        job.Time = anim.CurrentTime;
+        job.BoneLimit = lod.MaxBones > 0 ? std::min(lod.MaxBones, boneCount) : boneCount;
+        job.Interval = interval;
+        job.Kind = JobKind::Evaluate;
+
+        if (anim.PoseValid && interval > 1) {
+            if (anim.FramesSinceEval < interval && anim.PrevMatrices.size() == boneCount &&
+                anim.NextMatrices.size() == boneCount) {
+                job.Kind = JobKind::Interpolate;
+                job.Time = (f32)anim.FramesSinceEval / (f32)interval;
+                m_Blends.push_back(job);
+                m_Stats.Interpolated++;
+                continue;
+            }
+            // 预采样下一次采样时刻，中间帧由插值补齐
+            job.Kind = JobKind::EvaluateAhead;
+            job.Time = WrapClipTime(anim.CurrentTime + (f32)interval * dt * anim.PlaybackSpeed,
+                                    clip->Duration, anim.Loop);
+        }
+
+        // 优先级: 首次/恢复可见最高；其余按投影尺寸 (或距离倒数) × 逾期帧数
+        f32 size = byScreen ? screenSize : 1.0f / (1.0f + distance);
+        job.Priority = anim.PoseValid ? size * (f32)anim.FramesSinceEval / (f32)interval : FLT_MAX;
+        m_Candidates.push_back(job);
+    }
+
+    // 预算: 按实测每骨骼耗时换算本帧可采样的骨骼数，高优先级先入选
+    f64 boneBudget = m_LOD.FrameBudgetMs > 0.0f ? m_LOD.FrameBudgetMs * 1e6 / m_NsPerBone : DBL_MAX;
+    if (boneBudget < DBL_MAX) {
+        std::sort(m_Candidates.begin(), m_Candidates.end(),
+                  [](const PoseJob& a, const PoseJob& b) { return a.Priority > b.Priority; });
+    }
+    f64 usedBones = 0.0;
+    for (PoseJob& job : m_Candidates) {
+        AnimatorComponent& anim = *job.Animator;
+        if (usedBones > 0.0 && usedBones + job.BoneLimit > boneBudget) {
+            // 推迟: 降频实例停在上次预采样的姿势 (只在刚逾期的一帧补齐)，
+            // 下帧优先级随逾期帧数升高。还没有插值端点 (首次降频、LOD 从逐帧切到降频) 时保持当前姿势
+            m_Stats.Deferred++;
+            u32 boneCount = job.SkeletonData->GetBoneCount();
+            if (job.Kind == JobKind::EvaluateAhead && anim.FramesSinceEval == job.Interval &&
+                anim.PrevMatrices.size() == boneCount && anim.NextMatrices.size() == boneCount) {
+                job.Kind = JobKind::Interpolate;
+                job.Time = 1.0f;
+                m_Blends.push_back(job);
+            } else if (anim.PaletteOffset != INVALID_PALETTE_OFFSET) {
+                job.Kind = JobKind::Hold;
+                m_Blends.push_back(job);
             }
+            continue;
+        }
+        usedBones += job.BoneLimit;
+
+        if (job.Kind == JobKind::Evaluate && job.Interval > 1) {
+            // 首次采样后错开各实例的预采样相位，避免同一帧集中采样
+            anim.FramesSinceEval = (u16)(job.Interval - 1 - (u32)(&anim - pool.RawData()) % job.Interval);
+        } else {
+            anim.FramesSinceEval = 0;
         }
+        anim.PoseValid = true;
+
+        job.PoseOffset = m_Arena.Allocate(job.SkeletonData->GetBoneCount());
+        m_Jobs.push_back(job);
+        m_Stats.Evaluated++;
+        m_Stats.EvaluatedBones += job.BoneLimit;
+    }
+
+    // 并行阶段: 每个实例只写自己的姿势切片和矩阵
+    auto jobStart = Clock::now();
+    JobSystem::ParallelFor(0u, (u32)m_Jobs.size(), [this](u32 i) { RunJob(m_Jobs[i]); });
+    auto jobEnd = Clock::now();
+    JobSystem::ParallelFor(0u, (u32)m_Blends.size(), [this](u32 i) { RunJob(m_Blends[i]); });
+    auto frameEnd = Clock::now();
+
+    if (m_Stats.EvaluatedBones > 0) {
+        f64 ns = std::chrono::duration<f64, std::nano>(jobEnd - jobStart).count();
+        m_NsPerBone = (f32)(m_NsPerBone * 0.8 + ns / m_Stats.EvaluatedBones * 0.2);
+    }
+    m_Stats.UpdateMs = std::chrono::duration<f32, std::milli>(frameEnd - frameStart).count();
+}
 
-        // 采样关键帧 → 更新骨骼局部变换
-        AnimationSampler::Sample(*clip, anim.CurrentTime, *anim.SkeletonRef);
+void AnimationSystem::RunJob(const PoseJob& job) {
+    AnimatorComponent& anim = *job.Animator;
+    if (job.Kind == JobKind::Hold) {
+        WritePalette(anim);
+        return;
+    }
+
+    u32 boneCount = job.SkeletonData->GetBoneCount();
+    if (job.Kind == JobKind::Interpolate) {
+        f32 t = std::min(job.Time, 1.0f);
+        for (u32 b = 0; b < boneCount; b++) {
+            anim.BoneMatrices[b] = anim.PrevMatrices[b] + (anim.NextMatrices[b] - anim.PrevMatrices[b]) * t;
+        }
+        WritePalette(anim);
+        return;
+    }
+
+    BonePose* local = m_Arena.Local(job.PoseOffset);
+    if (job.Compressed) {
+        if (job.BoneLimit < boneCount) {
+            const auto& rest = job.SkeletonData->GetRestPose();
+            std::copy(rest.begin() + job.BoneLimit, rest.end(), local + job.BoneLimit);
+        }
+        job.Compressed->Sample(job.Time, anim.Cursor, local, job.BoneLimit);
+    } else {
+        AnimationSampler::SamplePose(*job.Clip, job.Time, *job.SkeletonData, local, job.BoneLimit);
+    }
+    AffineTransform* model = m_Arena.Model(job.PoseOffset);
+
+    if (job.Kind == JobKind::Evaluate) {
+        job.SkeletonData->ComputeBoneMatrices(local, model, anim.BoneMatrices.data());
+        if (job.Interval > 1) {
+            // 降频实例的插值端点先都取当前姿势
+            anim.PrevMatrices = anim.BoneMatrices;
+            anim.NextMatrices = anim.BoneMatrices;
+        }
+        WritePalette(anim);
+        return;
+    }
+
+    // EvaluateAhead: 旧的预采样姿势即当前时刻，成为新的起点
+    std::swap(anim.PrevMatrices, anim.NextMatrices);
+    if (anim.PrevMatrices.size() != boneCount) anim.PrevMatrices = anim.BoneMatrices;
+    anim.NextMatrices.resize(boneCount);
+    job.SkeletonData->ComputeBoneMatrices(local, model, anim.NextMatrices.data());
+    anim.BoneMatrices = anim.PrevMatrices;
+    WritePalette(anim);
+}
 
-        // 计算最终骨骼矩阵
-        anim.SkeletonRef->ComputeBoneMatrices(anim.BoneMatrices);
+void AnimationSystem::WritePalette(const AnimatorComponent& anim) {
+    if (anim.PaletteOffset == INVALID_PALETTE_OFFSET) return;
+    AffineTransform* out = m_Palette->Data(anim.PaletteOffset);
+    for (size_t b = 0; b < anim.BoneMatrices.size(); b++) {
+        out[b] = AffineTransform::FromMat4(anim.BoneMatrices[b]);
     }
 }
 
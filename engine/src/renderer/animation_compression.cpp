@@ -0,0 +1,307 @@
+#include "engine/renderer/animation_compression.h"
+#include "engine/renderer/animation.h"
+#include "engine/core/simd.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+// ── 压缩期辅助 ──────────────────────────────────────────────
+
+namespace {
+
+constexpr f32 QUANT_MAX = 65535.0f;
+
+/// 旋转: xyz + 由单位长度重建的 w (w >= 0)
+glm::vec4 RebuildRotation(const glm::vec3& xyz) {
+    f32 w2 = 1.0f - glm::dot(xyz, xyz);
+    return glm::vec4(xyz, w2 > 0.0f ? std::sqrt(w2) : 0.0f);
+}
+
+/// 与运行时一致的插值: 旋转 nlerp (同半球)，平移/缩放 lerp
+glm::vec4 Interpolate(bool rotation, const glm::vec4& a, const glm::vec4& b, f32 t) {
+    if (!rotation) return glm::mix(a, b, t);
+    glm::vec4 bb = glm::dot(a, b) < 0.0f ? -b : b;
+    glm::vec4 r = glm::mix(a, bb, t);
+    f32 len = glm::length(r);
+    return len > 0.0f ? r / len : glm::vec4(0, 0, 0, 1);
+}
+
+f32 Error(bool rotation, const glm::vec4& exact, const glm::vec4& approx) {
+    if (rotation) {
+        f32 d = std::min(1.0f, std::abs(glm::dot(exact, approx)));
+        return 2.0f * std::acos(d);
+    }
+    glm::vec3 diff = glm::abs(glm::vec3(exact) - glm::vec3(approx));
+    return std::max({diff.x, diff.y, diff.z});
+}
+
+} // namespace
+
+// ── 压缩 ────────────────────────────────────────────────────
+
+bool CompressedClip::Build(const AnimationClip& clip, const Skeleton& skeleton,
+                           const AnimationCompressionSettings& settings,
+                           AnimationCompressionStats* stats) {
+    *this = CompressedClip{};
+    if (skeleton.GetBoneCount() == 0 || settings.SampleRate <= 0.0f) {
+        LOG_WARN("[AnimCompress] 剪辑 '%s': 骨架为空或采样率无效", clip.Name.c_str());
+        return false;
+    }
+
+    m_Name = clip.Name;
+    m_Duration = std::max(clip.Duration, 0.0f);
+    m_SampleRate = settings.SampleRate;
+    m_BoneCount = skeleton.GetBoneCount();
+    m_TrackStride = (m_BoneCount + 3) & ~3u;
+
+    f32 frames = std::ceil(m_Duration * m_SampleRate) + 1.0f;
+    if (frames > 65535.0f) {
+        LOG_WARN("[AnimCompress] 剪辑 '%s' 过长 (%.1f 秒)", clip.Name.c_str(), m_Duration);
+        *this = CompressedClip{};
+        return false;
+    }
+    m_FrameCount = (u32)frames;
+    // 时长不是采样间隔的整数倍时把帧均匀摊开，使最后一帧恰好落在 m_Duration:
+    // 帧 i 的时刻为 i * Duration / (FrameCount - 1)，Sample 用同一比例换算
+    if (m_FrameCount > 1) m_SampleRate = (f32)(m_FrameCount - 1) / m_Duration;
+
+    // 均匀重采样 (每帧完整姿势，无通道的骨骼即绑定姿势)
+    std::vector<BonePose> sampled((size_t)m_FrameCount * m_BoneCount);
+    for (u32 f = 0; f < m_FrameCount; f++) {
+        f32 time = (f + 1 == m_FrameCount) ? m_Duration : (f32)f / m_SampleRate;
+        AnimationSampler::SamplePose(clip, time, skeleton, &sampled[(size_t)f * m_BoneCount]);
+    }
+
+    AnimationCompressionStats local;
+    for (const auto& ch : clip.Channels) {
+        local.RawBytes += (u32)(ch.PositionKeys.size() * sizeof(PositionKey) +
+                                ch.RotationKeys.size() * sizeof(RotationKey) +
+                                ch.ScaleKeys.size() * sizeof(ScaleKey));
+    }
+
+    m_Tracks.resize((size_t)TRACK_KIND_COUNT * m_TrackStride);
+    m_Groups.resize(m_Tracks.size() / 4);
+
+    const f32 tolerance[TRACK_KIND_COUNT] = {
+        settings.RotationTolerance, settings.PositionTolerance, settings.ScaleTolerance};
+    f32* maxError[TRACK_KIND_COUNT] = {
+        &local.MaxRotationError, &local.MaxPositionError, &local.MaxScaleError};
+
+    std::vector<glm::vec4> exact(m_FrameCount);
+    std::vector<glm::vec4> decoded(m_FrameCount);
+    std::vector<u16> quantized((size_t)m_FrameCount * 3);
+    std::vector<u32> keys;
+
+    for (u32 kind = 0; kind < TRACK_KIND_COUNT; kind++) {
+        bool rotation = kind == TRACK_ROTATION;
+        for (u32 bone = 0; bone < m_TrackStride; bone++) {
+            u32 t = TrackIndex(kind, bone);
+            TrackGroup& group = m_Groups[t / 4];
+            u32 lane = t % 4;
+
+            // 填充轨道 (骨骼数补齐到 4): 单帧零值，输出会被丢弃
+            if (bone >= m_BoneCount) {
+                for (u32 c = 0; c < 3; c++) group.Min[c][lane] = group.Step[c][lane] = 0.0f;
+                m_Tracks[t] = {(u32)m_Frames.size(), 1};
+                m_Frames.push_back(0);
+                m_Values.insert(m_Values.end(), 3, 0);
+                continue;
+            }
+
+            for (u32 f = 0; f < m_FrameCount; f++) {
+                const BonePose& p = sampled[(size_t)f * m_BoneCount + bone];
+                if (rotation) {
+                    glm::quat q = glm::normalize(p.Rotation);
+                    if (q.w < 0.0f) q = -q;
+                    exact[f] = glm::vec4(q.x, q.y, q.z, q.w);
+                } else {
+                    exact[f] = glm::vec4(kind == TRACK_POSITION ? p.Position : p.Scale, 0.0f);
+                }
+            }
+
+            // 值域归一化 + 16 位量化
+            glm::vec3 lo(exact[0]), hi(exact[0]);
+            for (u32 f = 1; f < m_FrameCount; f++) {
+                lo = glm::min(lo, glm::vec3(exact[f]));
+                hi = glm::max(hi, glm::vec3(exact[f]));
+            }
+            glm::vec3 step = (hi - lo) / QUANT_MAX;
+            for (u32 c = 0; c < 3; c++) {
+                group.Min[c][lane] = lo[c];
+                group.Step[c][lane] = step[c];
+            }
+            for (u32 f = 0; f < m_FrameCount; f++) {
+                glm::vec3 v;
+                for (u32 c = 0; c < 3; c++) {
+                    f32 n = step[c] > 0.0f ? (exact[f][c] - lo[c]) / step[c] : 0.0f;
+                    u16 q = (u16)std::clamp(std::lround(n), 0l, 65535l);
+                    quantized[f * 3 + c] = q;
+                    v[c] = lo[c] + (f32)q * step[c];
+                }
+                decoded[f] = rotation ? RebuildRotation(v) : glm::vec4(v, 0.0f);
+            }
+
+            // 曲线拟合: 从锚点出发尽量延长线段，只要中间各帧的插值误差都在上限内
+            auto segmentFits = [&](u32 a, u32 b) {
+                for (u32 f = a + 1; f < b; f++) {
+                    f32 alpha = (f32)(f - a) / (f32)(b - a);
+                    if (Error(rotation, exact[f], Interpolate(rotation, decoded[a], decoded[b], alpha)) >
+                        tolerance[kind]) return false;
+                }
+                return true;
+            };
+
+            keys.clear();
+            keys.push_back(0);
+            bool constant = true;
+            for (u32 f = 1; f < m_FrameCount && constant; f++) {
+                constant = Error(rotation, exact[f], decoded[0]) <= tolerance[kind];
+            }
+            if (!constant) {
+                u32 anchor = 0;
+                while (anchor + 1 < m_FrameCount) {
+                    u32 end = anchor + 1;
+                    while (end + 1 < m_FrameCount && segmentFits(anchor, end + 1)) end++;
+                    keys.push_back(end);
+                    anchor = end;
+                }
+            }
+
+            // 实测误差 (含量化)
+            for (u32 k = 0; k < keys.size(); k++) {
+                u32 a = keys[k];
+                u32 b = k + 1 < keys.size() ? keys[k + 1] : a;
+                u32 last = k + 1 < keys.size() ? b : m_FrameCount - 1;
+                for (u32 f = a; f <= last; f++) {
+                    f32 alpha = b > a ? (f32)(f - a) / (f32)(b - a) : 0.0f;
+                    f32 err = Error(rotation, exact[f], Interpolate(rotation, decoded[a], decoded[b], alpha));
+                    *maxError[kind] = std::max(*maxError[kind], err);
+                }
+            }
+
+            m_Tracks[t] = {(u32)m_Frames.size(), (u32)keys.size()};
+            for (u32 f : keys) {
+                m_Frames.push_back((u16)f);
+                m_Values.insert(m_Values.end(), &quantized[f * 3], &quantized[f * 3] + 3);
+            }
+            local.KeptKeys += (u32)keys.size();
+            local.SampledKeys += m_FrameCount;
+        }
+    }
+
+    local.CompressedBytes = GetMemoryUsage();
+    if (stats) *stats = local;
+    return true;
+}
+
+u32 CompressedClip::GetMemoryUsage() const {
+    return (u32)(m_Tracks.size() * sizeof(Track) + m_Groups.size() * sizeof(TrackGroup) +
+                 m_Frames.size() * sizeof(u16) + m_Values.size() * sizeof(u16));
+}
+
+// ── 采样 ────────────────────────────────────────────────────
+
+void CompressedClip::SampleGroup(u32 kind, u32 group, f32 frame, u16* cursorKeys,
+                                 f32 out[4][4]) const {
+    alignas(16) f32 a[3][4], b[3][4], f0[4], span[4];
+
+    // 每条轨道: 游标向后推进到 [k, k+1) 区间，取出两端帧号与量化值
+    for (u32 lane = 0; lane < 4; lane++) {
+        const Track& track = m_Tracks[group * 4 + lane];
+        const u16* frames = &m_Frames[track.KeyOffset];
+        u32 k = cursorKeys[lane];
+        u32 next = k;
+        if (track.KeyCount > 1) {
+            while (k + 2 < track.KeyCount && frames[k + 1] <= frame) k++;
+            next = k + 1;
+        }
+        cursorKeys[lane] = (u16)k;
+        f0[lane] = frames[k];
+        span[lane] = (f32)(frames[next] - frames[k]);
+
+        const u16* va = &m_Values[(size_t)(track.KeyOffset + k) * 3];
+        const u16* vb = &m_Values[(size_t)(track.KeyOffset + next) * 3];
+        for (u32 c = 0; c < 3; c++) {
+            a[c][lane] = (f32)va[c];
+            b[c][lane] = (f32)vb[c];
+        }
+    }
+
+    // 4 条轨道并行: 反量化 → lerp / nlerp
+    using namespace Simd;
+    const TrackGroup& range = m_Groups[group];
+    F4 zero = Set1(0.0f), one = Set1(1.0f);
+    // 单帧轨道 span = 0: 分母取 1，alpha 落在 [0, 1] 外的部分被截断
+    F4 t = Div(Sub(Set1(frame), Load(f0)), Max(Load(span), one));
+    t = Min(Max(t, zero), one);
+    F4 ax = MulAdd(Load(a[0]), Load(range.Step[0]), Load(range.Min[0]));
+    F4 ay = MulAdd(Load(a[1]), Load(range.Step[1]), Load(range.Min[1]));
+    F4 az = MulAdd(Load(a[2]), Load(range.Step[2]), Load(range.Min[2]));
+    F4 bx = MulAdd(Load(b[0]), Load(range.Step[0]), Load(range.Min[0]));
+    F4 by = MulAdd(Load(b[1]), Load(range.Step[1]), Load(range.Min[1]));
+    F4 bz = MulAdd(Load(b[2]), Load(range.Step[2]), Load(range.Min[2]));
+
+    if (kind != TRACK_ROTATION) {
+        Store(out[0], MulAdd(Sub(bx, ax), t, ax));
+        Store(out[1], MulAdd(Sub(by, ay), t, ay));
+        Store(out[2], MulAdd(Sub(bz, az), t, az));
+        return;
+    }
+
+    F4 aw = Sqrt(Max(zero, Sub(one, MulAdd(ax, ax, MulAdd(ay, ay, Mul(az, az))))));
+    F4 bw = Sqrt(Max(zero, Sub(one, MulAdd(bx, bx, MulAdd(by, by, Mul(bz, bz))))));
+
+    // 最短路径: 点积为负时翻转 b
+    F4 dot = MulAdd(ax, bx, MulAdd(ay, by, MulAdd(az, bz, Mul(aw, bw))));
+    bx = FlipSign(bx, dot);
+    by = FlipSign(by, dot);
+    bz = FlipSign(bz, dot);
+    bw = FlipSign(bw, dot);
+
+    F4 rx = MulAdd(Sub(bx, ax), t, ax);
+    F4 ry = MulAdd(Sub(by, ay), t, ay);
+    F4 rz = MulAdd(Sub(bz, az), t, az);
+    F4 rw = MulAdd(Sub(bw, aw), t, aw);
+    F4 inv = Div(one, Sqrt(Max(MulAdd(rx, rx, MulAdd(ry, ry, MulAdd(rz, rz, Mul(rw, rw)))),
+                               Set1(1e-12f))));
+    Store(out[0], Mul(rx, inv));
+    Store(out[1], Mul(ry, inv));
+    Store(out[2], Mul(rz, inv));
+    Store(out[3], Mul(rw, inv));
+}
+
+void CompressedClip::Sample(f32 time, AnimationCursor& cursor, BonePose* outPose,
+                            u32 boneLimit) const {
+    if (IsEmpty()) return;
+    u32 boneCount = std::min(boneLimit, m_BoneCount);
+
+    f32 frame = std::clamp(time * m_SampleRate, 0.0f, (f32)(m_FrameCount - 1));
+    if (cursor.Keys.size() != m_Tracks.size() || frame < cursor.LastFrame) {
+        cursor.Keys.assign(m_Tracks.size(), 0);
+    }
+    cursor.LastFrame = frame;
+
+    alignas(16) f32 out[4][4];
+    for (u32 kind = 0; kind < TRACK_KIND_COUNT; kind++) {
+        for (u32 base = 0; base < boneCount; base += 4) {
+            u32 t = TrackIndex(kind, base);
+            SampleGroup(kind, t / 4, frame, &cursor.Keys[t], out);
+
+            u32 lanes = std::min(4u, boneCount - base);
+            for (u32 lane = 0; lane < lanes; lane++) {
+                BonePose& pose = outPose[base + lane];
+                if (kind == TRACK_ROTATION) {
+                    pose.Rotation = glm::quat(out[3][lane], out[0][lane], out[1][lane], out[2][lane]);
+                } else {
+                    glm::vec3 v(out[0][lane], out[1][lane], out[2][lane]);
+                    (kind == TRACK_POSITION ? pose.Position : pose.Scale) = v;
+                }
+            }
+        }
+    }
+}
+
+} // namespace Engine
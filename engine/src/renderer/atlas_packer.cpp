@@ -0,0 +1,185 @@
+#include "engine/renderer/atlas_packer.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Engine {
+
+// ── Skyline ─────────────────────────────────────────────────
+
+void SkylinePacker::Init(u32 width, u32 height) {
+    m_Width = width;
+    m_Height = height;
+    m_UsedArea = 0;
+    m_Skyline.clear();
+    m_Skyline.push_back({0, 0, width});
+}
+
+bool SkylinePacker::Fit(u32 index, u32 w, u32 h, u32& y, u64& waste) const {
+    u32 x = m_Skyline[index].X;
+    if (x + w > m_Width) return false;
+
+    // 底边为跨越各段的最高点
+    y = 0;
+    u32 remaining = w;
+    for (u32 i = index; remaining > 0; i++) {
+        y = std::max(y, m_Skyline[i].Y);
+        if (y + h > m_Height) return false;
+        remaining -= std::min(remaining, m_Skyline[i].W);
+    }
+
+    // 矩形下方被盖住的空隙
+    waste = 0;
+    remaining = w;
+    for (u32 i = index; remaining > 0; i++) {
+        u32 span = std::min(remaining, m_Skyline[i].W);
+        waste += (u64)(y - m_Skyline[i].Y) * span;
+        remaining -= span;
+    }
+    return true;
+}
+
+bool SkylinePacker::Pack(u32 w, u32 h, AtlasRect& out) {
+    if (w == 0 || h == 0) return false;
+
+    u32 bestIndex = ~0u;
+    u32 bestTop = ~0u;
+    u64 bestWaste = ~0ull;
+    u32 bestY = 0;
+    for (u32 i = 0; i < (u32)m_Skyline.size(); i++) {
+        u32 y;
+        u64 waste;
+        if (!Fit(i, w, h, y, waste)) continue;
+        if (y + h < bestTop || (y + h == bestTop && waste < bestWaste)) {
+            bestIndex = i;
+            bestTop = y + h;
+            bestWaste = waste;
+            bestY = y;
+        }
+    }
+    if (bestIndex == ~0u) return false;
+
+    out = {m_Skyline[bestIndex].X, bestY, w, h};
+    m_UsedArea += (u64)w * h;
+
+    // 插入新段，截掉被它覆盖的后续段
+    m_Skyline.insert(m_Skyline.begin() + bestIndex, {out.X, bestY + h, w});
+    u32 right = out.X + w;
+    for (u32 i = bestIndex + 1; i < (u32)m_Skyline.size();) {
+        Segment& seg = m_Skyline[i];
+        if (seg.X >= right) break;
+        u32 segRight = seg.X + seg.W;
+        if (segRight <= right) {
+            m_Skyline.erase(m_Skyline.begin() + i);
+            continue;
+        }
+        seg.W = segRight - right;
+        seg.X = right;
+        break;
+    }
+
+    // 合并等高的相邻段
+    for (u32 i = 0; i + 1 < (u32)m_Skyline.size();) {
+        if (m_Skyline[i].Y == m_Skyline[i + 1].Y) {
+            m_Skyline[i].W += m_Skyline[i + 1].W;
+            m_Skyline.erase(m_Skyline.begin() + i + 1);
+        } else {
+            i++;
+        }
+    }
+    return true;
+}
+
+f32 SkylinePacker::GetOccupancy() const {
+    u64 total = (u64)m_Width * m_Height;
+    return total ? (f32)((f64)m_UsedArea / (f64)total) : 0.0f;
+}
+
+// ── 图集构建 ────────────────────────────────────────────────
+
+AtlasBuilder::AtlasBuilder(u32 pageSize, u32 padding)
+    : m_PageSize(pageSize), m_Padding(padding) {}
+
+void AtlasBuilder::Add(u32 key, const u8* rgba, u32 width, u32 height, u32 sourceHeight) {
+    if (!rgba || width == 0 || height == 0) return;
+    Pending image;
+    image.Key = key;
+    image.Width = width;
+    image.Height = height;
+    image.SourceHeight = std::max(sourceHeight, height);
+    image.Pixels.assign(rgba, rgba + (size_t)width * height * 4);
+    m_Pending.push_back(std::move(image));
+}
+
+void AtlasBuilder::Clear() {
+    m_Pending.clear();
+    m_Pages.clear();
+    m_Entries.clear();
+}
+
+const AtlasEntry* AtlasBuilder::Find(u32 key) const {
+    for (const AtlasEntry& entry : m_Entries) {
+        if (entry.Key == key) return &entry;
+    }
+    return nullptr;
+}
+
+void AtlasBuilder::Blit(Page& page, const Pending& image, const AtlasRect& rect) const {
+    // rect 含 padding: 四周挤出边缘像素
+    u32 p = m_Padding;
+    for (u32 row = 0; row < rect.H; row++) {
+        u32 srcRow = (u32)std::clamp((i32)row - (i32)p, 0, (i32)image.Height - 1);
+        const u8* src = image.Pixels.data() + (size_t)srcRow * image.Width * 4;
+        u8* dst = page.Pixels.data() + ((size_t)(rect.Y + row) * m_PageSize + rect.X) * 4;
+        for (u32 i = 0; i < p; i++) {
+            std::memcpy(dst + (size_t)i * 4, src, 4);
+            std::memcpy(dst + (size_t)(p + image.Width + i) * 4, src + (size_t)(image.Width - 1) * 4, 4);
+        }
+        std::memcpy(dst + (size_t)p * 4, src, (size_t)image.Width * 4);
+    }
+}
+
+bool AtlasBuilder::Pack() {
+    // 高的先放，天际线更平整
+    std::stable_sort(m_Pending.begin(), m_Pending.end(), [](const Pending& a, const Pending& b) {
+        return a.Height != b.Height ? a.Height > b.Height : a.Width > b.Width;
+    });
+
+    bool allPacked = true;
+    for (const Pending& image : m_Pending) {
+        u32 w = image.Width + m_Padding * 2;
+        u32 h = image.Height + m_Padding * 2;
+        if (w > m_PageSize || h > m_PageSize) {
+            LOG_WARN("[Atlas] 图像 %ux%u 超过页尺寸 %u，跳过", image.Width, image.Height, m_PageSize);
+            allPacked = false;
+            continue;
+        }
+
+        AtlasRect rect;
+        u32 pageIndex = 0;
+        for (; pageIndex < (u32)m_Pages.size(); pageIndex++) {
+            if (m_Pages[pageIndex].Packer.Pack(w, h, rect)) break;
+        }
+        if (pageIndex == (u32)m_Pages.size()) {
+            Page& page = m_Pages.emplace_back();
+            page.Packer.Init(m_PageSize, m_PageSize);
+            page.Pixels.assign((size_t)m_PageSize * m_PageSize * 4, 0);
+            page.Packer.Pack(w, h, rect);
+        }
+        Blit(m_Pages[pageIndex], image, rect);
+
+        AtlasEntry entry;
+        entry.Key = image.Key;
+        entry.Page = pageIndex;
+        entry.Rect = {rect.X + m_Padding, rect.Y + m_Padding, image.Width, image.Height};
+        f32 inv = 1.0f / (f32)m_PageSize;
+        entry.UVRect = {entry.Rect.X * inv, entry.Rect.Y * inv,
+                        (entry.Rect.X + image.Width) * inv, (entry.Rect.Y + image.SourceHeight) * inv};
+        m_Entries.push_back(entry);
+    }
+    m_Pending.clear();
+    return allPacked;
+}
+
+} // namespace Engine
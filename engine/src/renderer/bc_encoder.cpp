@@ -0,0 +1,218 @@
+#include "engine/renderer/bc_encoder.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Engine {
+
+namespace {
+
+// ── 565 打包 / 展开 ─────────────────────────────────────────
+
+inline u16 Pack565(const u8* c) {
+    return (u16)(((c[0] * 31 + 127) / 255) << 11 |
+                 ((c[1] * 63 + 127) / 255) << 5 |
+                 ((c[2] * 31 + 127) / 255));
+}
+
+inline void Unpack565(u16 v, u8* c) {
+    u8 r = (u8)((v >> 11) & 31), g = (u8)((v >> 5) & 63), b = (u8)(v & 31);
+    c[0] = (u8)((r << 3) | (r >> 2));
+    c[1] = (u8)((g << 2) | (g >> 4));
+    c[2] = (u8)((b << 3) | (b >> 2));
+    c[3] = 255;
+}
+
+/// BC1 调色板: fourColor (c0 > c1 或 BC3 颜色块) 为 4 色, 否则 3 色 + 透明黑
+void BuildPalette(u16 c0, u16 c1, bool fourColor, u8 palette[4][4]) {
+    Unpack565(c0, palette[0]);
+    Unpack565(c1, palette[1]);
+    if (fourColor) {
+        for (int i = 0; i < 3; i++) {
+            palette[2][i] = (u8)((2 * palette[0][i] + palette[1][i] + 1) / 3);
+            palette[3][i] = (u8)((palette[0][i] + 2 * palette[1][i] + 1) / 3);
+        }
+        palette[2][3] = palette[3][3] = 255;
+    } else {
+        for (int i = 0; i < 3; i++)
+            palette[2][i] = (u8)((palette[0][i] + palette[1][i]) / 2);
+        palette[2][3] = 255;
+        palette[3][0] = palette[3][1] = palette[3][2] = palette[3][3] = 0;
+    }
+}
+
+void WriteU16(u8* out, u16 v) { out[0] = (u8)(v & 0xFF); out[1] = (u8)(v >> 8); }
+u16  ReadU16(const u8* in)    { return (u16)(in[0] | (in[1] << 8)); }
+
+// ── 颜色块 (BC1 / BC3 共用) ─────────────────────────────────
+
+void EncodeColorBlock(const u8* rgba, u8* out) {
+    u8 lo[3] = {255, 255, 255}, hi[3] = {0, 0, 0};
+    for (int p = 0; p < 16; p++) {
+        for (int c = 0; c < 3; c++) {
+            lo[c] = std::min(lo[c], rgba[p * 4 + c]);
+            hi[c] = std::max(hi[c], rgba[p * 4 + c]);
+        }
+    }
+    // 包围盒内缩 1/16，减少端点量化误差
+    u8 maxC[3], minC[3];
+    for (int c = 0; c < 3; c++) {
+        int inset = (hi[c] - lo[c]) >> 4;
+        maxC[c] = (u8)std::max(0, hi[c] - inset);
+        minC[c] = (u8)std::min(255, lo[c] + inset);
+    }
+
+    // 包围盒对角线只覆盖正相关方向: 与跨度最大的通道负相关的通道交换端点
+    int major = 0;
+    for (int c = 1; c < 3; c++)
+        if (hi[c] - lo[c] > hi[major] - lo[major]) major = c;
+    int mean[3] = {0, 0, 0};
+    for (int p = 0; p < 16; p++)
+        for (int c = 0; c < 3; c++) mean[c] += rgba[p * 4 + c];
+    for (int c = 0; c < 3; c++) mean[c] = (mean[c] + 8) / 16;
+    for (int c = 0; c < 3; c++) {
+        if (c == major) continue;
+        int cov = 0;
+        for (int p = 0; p < 16; p++)
+            cov += (rgba[p * 4 + major] - mean[major]) * (rgba[p * 4 + c] - mean[c]);
+        if (cov < 0) std::swap(maxC[c], minC[c]);
+    }
+
+    u16 c0 = Pack565(maxC), c1 = Pack565(minC);
+    if (c0 < c1) std::swap(c0, c1);
+    WriteU16(out, c0);
+    WriteU16(out + 2, c1);
+
+    u32 indices = 0;
+    if (c0 != c1) {
+        u8 palette[4][4];
+        BuildPalette(c0, c1, true, palette);
+        for (int p = 0; p < 16; p++) {
+            const u8* px = rgba + p * 4;
+            int best = 0, bestDist = 0x7FFFFFFF;
+            for (int i = 0; i < 4; i++) {
+                int dr = px[0] - palette[i][0], dg = px[1] - palette[i][1], db = px[2] - palette[i][2];
+                int d = dr * dr + dg * dg + db * db;
+                if (d < bestDist) { bestDist = d; best = i; }
+            }
+            indices |= (u32)best << (p * 2);
+        }
+    }
+    out[4] = (u8)(indices);
+    out[5] = (u8)(indices >> 8);
+    out[6] = (u8)(indices >> 16);
+    out[7] = (u8)(indices >> 24);
+}
+
+// ── Alpha 块 (BC3) ──────────────────────────────────────────
+
+void EncodeAlphaBlock(const u8* rgba, u8* out) {
+    u8 a0 = 0, a1 = 255;
+    for (int p = 0; p < 16; p++) {
+        a0 = std::max(a0, rgba[p * 4 + 3]);
+        a1 = std::min(a1, rgba[p * 4 + 3]);
+    }
+    out[0] = a0;
+    out[1] = a1;
+
+    u64 bits = 0;
+    if (a0 != a1) {
+        // a0 > a1: 8 级插值
+        u8 palette[8] = {a0, a1};
+        for (int i = 2; i < 8; i++)
+            palette[i] = (u8)(((8 - i) * a0 + (i - 1) * a1 + 3) / 7);
+        for (int p = 0; p < 16; p++) {
+            int a = rgba[p * 4 + 3];
+            int best = 0, bestDist = 256;
+            for (int i = 0; i < 8; i++) {
+                int d = std::abs(a - palette[i]);
+                if (d < bestDist) { bestDist = d; best = i; }
+            }
+            bits |= (u64)best << (p * 3);
+        }
+    }
+    for (int i = 0; i < 6; i++) out[2 + i] = (u8)(bits >> (i * 8));
+}
+
+void DecodeColorBlock(const u8* block, u8* rgba, bool forceOpaque) {
+    u16 c0 = ReadU16(block), c1 = ReadU16(block + 2);
+    u8 palette[4][4];
+    BuildPalette(c0, c1, forceOpaque || c0 > c1, palette);
+    u32 indices = (u32)block[4] | ((u32)block[5] << 8) | ((u32)block[6] << 16) | ((u32)block[7] << 24);
+    for (int p = 0; p < 16; p++) {
+        std::memcpy(rgba + p * 4, palette[(indices >> (p * 2)) & 3], 4);
+    }
+}
+
+} // namespace
+
+// ── BcEncoder ───────────────────────────────────────────────
+
+size_t BcEncoder::GetCompressedSize(BcFormat format, u32 width, u32 height) {
+    size_t blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    return blocksX * blocksY * GetBlockBytes(format);
+}
+
+void BcEncoder::EncodeBlockBC1(const u8* rgba, u8* out) {
+    EncodeColorBlock(rgba, out);
+}
+
+void BcEncoder::EncodeBlockBC3(const u8* rgba, u8* out) {
+    EncodeAlphaBlock(rgba, out);
+    EncodeColorBlock(rgba, out + 8);
+}
+
+void BcEncoder::DecodeBlockBC1(const u8* block, u8* rgba) {
+    DecodeColorBlock(block, rgba, false);
+}
+
+void BcEncoder::DecodeBlockBC3(const u8* block, u8* rgba) {
+    DecodeColorBlock(block + 8, rgba, true);
+
+    u8 a0 = block[0], a1 = block[1];
+    u8 palette[8] = {a0, a1};
+    if (a0 > a1) {
+        for (int i = 2; i < 8; i++)
+            palette[i] = (u8)(((8 - i) * a0 + (i - 1) * a1 + 3) / 7);
+    } else {
+        for (int i = 2; i < 6; i++)
+            palette[i] = (u8)(((6 - i) * a0 + (i - 1) * a1 + 2) / 5);
+        palette[6] = 0;
+        palette[7] = 255;
+    }
+    u64 bits = 0;
+    for (int i = 0; i < 6; i++) bits |= (u64)block[2 + i] << (i * 8);
+    for (int p = 0; p < 16; p++) {
+        rgba[p * 4 + 3] = palette[(bits >> (p * 3)) & 7];
+    }
+}
+
+void BcEncoder::EncodeImage(const u8* pixels, u32 width, u32 height, u32 channels,
+                            BcFormat format, u8* out) {
+    u32 blocksX = (width + 3) / 4, blocksY = (height + 3) / 4;
+    u32 blockBytes = GetBlockBytes(format);
+    u8 block[64];
+
+    for (u32 by = 0; by < blocksY; by++) {
+        for (u32 bx = 0; bx < blocksX; bx++) {
+            // 取 4x4 像素 (边缘 clamp)，统一扩展为 RGBA
+            for (u32 y = 0; y < 4; y++) {
+                u32 sy = std::min(by * 4 + y, height - 1);
+                for (u32 x = 0; x < 4; x++) {
+                    u32 sx = std::min(bx * 4 + x, width - 1);
+                    const u8* src = pixels + ((size_t)sy * width + sx) * channels;
+                    u8* dst = block + (y * 4 + x) * 4;
+                    dst[0] = src[0];
+                    dst[1] = channels > 1 ? src[1] : src[0];
+                    dst[2] = channels > 2 ? src[2] : src[0];
+                    dst[3] = channels > 3 ? src[3] : 255;
+                }
+            }
+            u8* dst = out + ((size_t)by * blocksX + bx) * blockBytes;
+            if (format == BcFormat::BC1) EncodeBlockBC1(block, dst);
+            else                         EncodeBlockBC3(block, dst);
+        }
+    }
+}
+
+} // namespace Engine
@@ -2,6 +2,7 @@
 #include "engine/core/log.h"
 
 #include <glad/glad.h>
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -61,6 +62,7 @@ Font::Font(const std::string& filepath, f32 pixelHeight) {
     }
 
     m_LineHeight = pixelHeight;
+    m_BitmapUsedRows = std::min((u32)result, ATLAS_SIZE);
 
     // 将单通道 atlas 转为 RGBA (白色 + alpha)
     // 这样就能直接用 SpriteBatch 的标准 shader
@@ -83,6 +85,7 @@ Font::Font(const std::string& filepath, f32 pixelHeight) {
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
+    m_Bitmap = std::move(atlasData);
     m_Valid = true;
     LOG_INFO("[Font] 已加载: %s (%.0fpx, %d 字形)", 
              filepath.c_str(), pixelHeight, result);
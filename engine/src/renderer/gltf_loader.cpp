@@ -151,7 +151,7 @@ static std::vector<AnimationClip> ParseAnimations(const cgltf_data* data,
 
 // ── 加载 ────────────────────────────────────────────────────
 
-std::vector<GltfMesh> GltfLoader::Load(const std::string& filepath) {
+std::vector<GltfMesh> GltfLoader::Load(const std::string& filepath, bool createGpuMesh) {
     std::vector<GltfMesh> results;
 
     cgltf_options options = {};
@@ -181,9 +181,17 @@ std::vector<GltfMesh> GltfLoader::Load(const std::string& filepath) {
     auto clips = ParseAnimations(data, skin);
 
     bool hasSkinData = skin && skeleton->GetBoneCount() > 0;
+    AnimationSetRef animations;
     if (hasSkinData) {
         LOG_INFO("[glTF] 蒙皮数据: %u 骨骼, %zu 动画片段",
                  skeleton->GetBoneCount(), clips.size());
+        // 文件内所有蒙皮网格共享同一份骨架和剪辑
+        auto set = CreateRef<AnimationSet>();
+        set->SkeletonData = skeleton;
+        set->Clips = std::move(clips);
+        // 保留原始关键帧: AnimLayerStack / RootMotionExtractor 仍按原始通道工作
+        set->CompressClips({}, true);
+        animations = set;
     }
 
     // 遍历所有 mesh
@@ -374,14 +382,23 @@ std::vector<GltfMesh> GltfLoader::Load(const std::string& filepath) {
 
             // 构建 Mesh 并加入结果
             GltfMesh gltfMesh;
-            gltfMesh.MeshData = std::make_unique<Mesh>(vertices, indices);
+            if (createGpuMesh && meshHasSkin) {
+                std::vector<SkinningUtils::SkinVertex> gpuVerts(skinVerts.size());
+                for (size_t v = 0; v < skinVerts.size(); v++) gpuVerts[v] = ToSkinVertex(skinVerts[v]);
+                gltfMesh.MeshData = std::make_unique<Mesh>(gpuVerts.data(), (u32)gpuVerts.size(),
+                                                           indices.data(), (u32)indices.size());
+            } else if (createGpuMesh) {
+                gltfMesh.MeshData = std::make_unique<Mesh>(vertices, indices);
+            } else {
+                gltfMesh.Vertices = std::move(vertices);
+                gltfMesh.Indices = std::move(indices);
+            }
             gltfMesh.Material = mat;
             gltfMesh.Name = mesh.name ? mesh.name : ("mesh_" + std::to_string(mi));
             gltfMesh.HasSkin = meshHasSkin;
             if (meshHasSkin) {
                 gltfMesh.SkinVertices = std::move(skinVerts);
-                gltfMesh.SkeletonRef = skeleton;
-                gltfMesh.Clips = clips;
+                gltfMesh.Animations = animations;
             }
             results.push_back(std::move(gltfMesh));
         }
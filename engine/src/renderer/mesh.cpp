@@ -13,6 +13,14 @@
 #define M_PI 3.14159265358979323846
 #endif
 
+// 精简版 glad 头未包含的 GL 3.3 顶点格式
+#ifndef GL_HALF_FLOAT
+#define GL_HALF_FLOAT 0x140B
+#endif
+#ifndef GL_INT_2_10_10_10_REV
+#define GL_INT_2_10_10_10_REV 0x8D9F
+#endif
+
 namespace Engine {
 
 // ── 辅助：计算切线/副切线 ────────────────────────────────────
@@ -61,20 +69,25 @@ static void CalcTangents(std::vector<MeshVertex>& vertices,
 // ── 构造 / 析构 ─────────────────────────────────────────────
 
 Mesh::Mesh(const std::vector<MeshVertex>& vertices, const std::vector<u32>& indices)
-    : m_Vertices(vertices), m_IndexCount((u32)indices.size())
+    : Mesh(vertices.data(), (u32)vertices.size(), indices.data(), (u32)indices.size())
+{
+}
+
+Mesh::Mesh(const MeshVertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount)
+    : m_VertexCount(vertexCount), m_IndexCount(indexCount)
 {
     glGenVertexArrays(1, &m_VAO);
     glBindVertexArray(m_VAO);
 
     glGenBuffers(1, &m_VBO);
     glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(MeshVertex),
-                 vertices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, (size_t)vertexCount * sizeof(MeshVertex),
+                 vertices, GL_STATIC_DRAW);
 
     glGenBuffers(1, &m_IBO);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(u32),
-                 indices.data(), GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (size_t)indexCount * sizeof(u32),
+                 indices, GL_STATIC_DRAW);
 
     glEnableVertexAttribArray(0);
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(MeshVertex),
@@ -95,6 +108,60 @@ Mesh::Mesh(const std::vector<MeshVertex>& vertices, const std::vector<u32>& indi
     glBindVertexArray(0);
 }
 
+Mesh::Mesh(const PackedMeshVertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount)
+    : m_VertexCount(vertexCount), m_IndexCount(indexCount)
+{
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+
+    glGenBuffers(1, &m_VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, (size_t)vertexCount * sizeof(PackedMeshVertex),
+                 vertices, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_IBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (size_t)indexCount * sizeof(u32),
+                 indices, GL_STATIC_DRAW);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedMeshVertex),
+                          (void*)offsetof(PackedMeshVertex, Position));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedMeshVertex),
+                          (void*)offsetof(PackedMeshVertex, Normal));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, sizeof(PackedMeshVertex),
+                          (void*)offsetof(PackedMeshVertex, TexCoord));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 4, GL_INT_2_10_10_10_REV, GL_TRUE, sizeof(PackedMeshVertex),
+                          (void*)offsetof(PackedMeshVertex, Tangent));
+    // location 4 (aBitangent) 不启用: 读到默认常量 (0,0,0,1)，着色器据此改用 cross(N, T) * w
+
+    glBindVertexArray(0);
+}
+
+Mesh::Mesh(const SkinningUtils::SkinVertex* vertices, u32 vertexCount, const u32* indices, u32 indexCount)
+    : m_VertexCount(vertexCount), m_IndexCount(indexCount), m_HasSkin(true)
+{
+    glGenVertexArrays(1, &m_VAO);
+    glBindVertexArray(m_VAO);
+
+    glGenBuffers(1, &m_VBO);
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    glBufferData(GL_ARRAY_BUFFER, (size_t)vertexCount * sizeof(SkinningUtils::SkinVertex),
+                 vertices, GL_STATIC_DRAW);
+
+    glGenBuffers(1, &m_IBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_IBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, (size_t)indexCount * sizeof(u32),
+                 indices, GL_STATIC_DRAW);
+
+    SkinningUtils::SetupSkinVertexVAO();
+
+    glBindVertexArray(0);
+}
+
 Mesh::~Mesh() {
     if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
     if (m_VBO) glDeleteBuffers(1, &m_VBO);
@@ -102,12 +169,11 @@ Mesh::~Mesh() {
 }
 
 Mesh::Mesh(Mesh&& other) noexcept
-    : m_VAO(other.m_VAO), m_VBO(other.m_VBO), m_IBO(other.m_IBO),
-      m_IndexCount(other.m_IndexCount),
-      m_Vertices(std::move(other.m_Vertices))
+    : m_VertexCount(other.m_VertexCount), m_IndexCount(other.m_IndexCount),
+      m_VAO(other.m_VAO), m_VBO(other.m_VBO), m_IBO(other.m_IBO), m_HasSkin(other.m_HasSkin)
 {
     other.m_VAO = other.m_VBO = other.m_IBO = 0;
-    other.m_IndexCount = 0;
+    other.m_VertexCount = other.m_IndexCount = 0;
 }
 
 Mesh& Mesh::operator=(Mesh&& other) noexcept {
@@ -120,10 +186,11 @@ Mesh& Mesh::operator=(Mesh&& other) noexcept {
         m_VAO = other.m_VAO;
         m_VBO = other.m_VBO;
         m_IBO = other.m_IBO;
+        m_VertexCount = other.m_VertexCount;
         m_IndexCount = other.m_IndexCount;
-        m_Vertices = std::move(other.m_Vertices);
+        m_HasSkin = other.m_HasSkin;
         other.m_VAO = other.m_VBO = other.m_IBO = 0;
-        other.m_IndexCount = 0;
+        other.m_VertexCount = other.m_IndexCount = 0;
     }
     return *this;
 }
@@ -162,17 +229,28 @@ static void ParseFaceToken(const std::string& token, int& vi, int& vti, int& vni
 Scope<Mesh> Mesh::LoadOBJ(const std::string& filepath) {
     LOG_INFO("加载 OBJ: %s", filepath.c_str());
 
+    std::vector<MeshVertex> vertices;
+    std::vector<u32> indices;
+    if (!ParseOBJ(filepath, vertices, indices)) return nullptr;
+
+    LOG_INFO("OBJ 完成: %zu 顶点, %zu 索引", vertices.size(), indices.size());
+    return std::make_unique<Mesh>(vertices, indices);
+}
+
+bool Mesh::ParseOBJ(const std::string& filepath,
+                    std::vector<MeshVertex>& vertices,
+                    std::vector<u32>& indices) {
     std::ifstream file(filepath);
     if (!file.is_open()) {
         LOG_ERROR("无法打开: %s", filepath.c_str());
-        return nullptr;
+        return false;
     }
 
+    vertices.clear();
+    indices.clear();
     std::vector<glm::vec3> positions;
     std::vector<glm::vec3> normals;
     std::vector<glm::vec2> texcoords;
-    std::vector<MeshVertex> vertices;
-    std::vector<u32> indices;
     std::unordered_map<std::string, u32> uniqueVerts;
 
     std::string line;
@@ -239,9 +317,7 @@ Scope<Mesh> Mesh::LoadOBJ(const std::string& filepath) {
 
     // 计算切线
     CalcTangents(vertices, indices);
-
-    LOG_INFO("OBJ 完成: %zu 顶点, %zu 索引", vertices.size(), indices.size());
-    return std::make_unique<Mesh>(vertices, indices);
+    return true;
 }
 
 // ── 预置几何体 ──────────────────────────────────────────────
@@ -0,0 +1,446 @@
+#include "engine/renderer/mesh_optimizer.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace Engine {
+
+namespace {
+
+// ── 邻接表: 顶点 → 引用它的三角形 ───────────────────────────
+
+struct TriangleAdjacency {
+    std::vector<u32> Counts;    // 每顶点的三角形数
+    std::vector<u32> Offsets;   // 前缀和
+    std::vector<u32> Data;      // 三角形序号
+
+    void Build(const u32* indices, u32 indexCount, u32 vertexCount) {
+        u32 triCount = indexCount / 3;
+        Counts.assign(vertexCount, 0);
+        Offsets.assign(vertexCount, 0);
+        Data.resize(triCount * 3);
+
+        for (u32 i = 0; i < triCount * 3; i++) Counts[indices[i]]++;
+        u32 offset = 0;
+        for (u32 v = 0; v < vertexCount; v++) {
+            Offsets[v] = offset;
+            offset += Counts[v];
+        }
+        // 填充时借用 Offsets 作游标，结束后回退
+        for (u32 t = 0; t < triCount; t++) {
+            for (u32 k = 0; k < 3; k++) {
+                u32 v = indices[t * 3 + k];
+                Data[Offsets[v]++] = t;
+            }
+        }
+        for (u32 v = 0; v < vertexCount; v++) Offsets[v] -= Counts[v];
+    }
+};
+
+// ── FIFO 缓存模拟 ───────────────────────────────────────────
+// 时间戳法: 顶点在缓存中 ⇔ 当前时间 - 入缓存时间 < cacheSize
+
+class FifoCache {
+public:
+    FifoCache(u32 vertexCount, u32 cacheSize)
+        : m_Stamps(vertexCount, 0), m_Size(cacheSize), m_Time(cacheSize + 1) {}
+
+    /// 访问顶点，未命中返回 true
+    bool Access(u32 v) {
+        if (m_Time - m_Stamps[v] > m_Size) {
+            m_Stamps[v] = m_Time++;
+            return true;
+        }
+        return false;
+    }
+
+    /// 清空 (只推进时间，不必重置数组)
+    void Flush() { m_Time += m_Size + 1; }
+
+private:
+    std::vector<u32> m_Stamps;
+    u32 m_Size;
+    u32 m_Time;
+};
+
+u32 CountMisses(const u32* indices, u32 triBegin, u32 triEnd, FifoCache& cache) {
+    u32 misses = 0;
+    for (u32 i = triBegin * 3; i < triEnd * 3; i++) {
+        misses += cache.Access(indices[i]) ? 1 : 0;
+    }
+    return misses;
+}
+
+// ── Tipsify 取下一个扇心顶点 ─────────────────────────────────
+
+i64 SkipDeadEnd(const std::vector<u32>& live, std::vector<u32>& deadEnd,
+                u32& cursor, u32 vertexCount) {
+    while (!deadEnd.empty()) {
+        u32 d = deadEnd.back();
+        deadEnd.pop_back();
+        if (live[d] > 0) return d;
+    }
+    while (cursor < vertexCount) {
+        if (live[cursor] > 0) return cursor;
+        cursor++;
+    }
+    return -1;
+}
+
+u16 ToHalf(f32 v) { return glm::packHalf1x16(v); }
+
+} // namespace
+
+// ── 顶点缓存优化 (Tipsify, Sander et al. 2007) ───────────────
+
+void MeshOptimizer::OptimizeVertexCache(u32* indices, u32 indexCount, u32 vertexCount,
+                                        u32 cacheSize, std::vector<u32>* clusters) {
+    u32 triCount = indexCount / 3;
+    if (clusters) clusters->assign(1, 0);
+    if (triCount == 0) return;
+
+    TriangleAdjacency adj;
+    adj.Build(indices, indexCount, vertexCount);
+
+    std::vector<u32> live = adj.Counts;           // 每顶点尚未输出的三角形数
+    std::vector<u32> stamps(vertexCount, 0);
+    std::vector<u8>  emitted(triCount, 0);
+    std::vector<u32> deadEnd;
+    std::vector<u32> candidates;
+    std::vector<u32> result;
+    result.reserve(triCount * 3);
+    deadEnd.reserve(triCount * 3);
+
+    u32 time = cacheSize + 1;
+    u32 cursor = 0;
+    i64 fan = 0;
+    while (live[(u32)fan] == 0) fan++;
+
+    while (fan >= 0) {
+        candidates.clear();
+        u32 f = (u32)fan;
+
+        // 以 f 为扇心输出所有未输出的相邻三角形
+        for (u32 k = 0; k < adj.Counts[f]; k++) {
+            u32 t = adj.Data[adj.Offsets[f] + k];
+            if (emitted[t]) continue;
+            emitted[t] = 1;
+            for (u32 c = 0; c < 3; c++) {
+                u32 v = indices[t * 3 + c];
+                result.push_back(v);
+                deadEnd.push_back(v);
+                candidates.push_back(v);
+                live[v]--;
+                if (time - stamps[v] > cacheSize) stamps[v] = time++;
+            }
+        }
+
+        // 候选: 仍有剩余三角形且输出后大概率仍在缓存中的顶点，越"老"越优先
+        i64 best = -1;
+        i64 bestPriority = -1;
+        for (u32 v : candidates) {
+            if (live[v] == 0) continue;
+            i64 priority = 0;
+            if ((i64)time - stamps[v] + 2 * (i64)live[v] <= (i64)cacheSize) {
+                priority = (i64)time - stamps[v];
+            }
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                best = v;
+            }
+        }
+        if (best < 0) {
+            // 死路: 跳到别处，形成簇边界
+            best = SkipDeadEnd(live, deadEnd, cursor, vertexCount);
+            if (best >= 0 && clusters && (u32)result.size() / 3 < triCount) {
+                clusters->push_back((u32)result.size() / 3);
+            }
+        }
+        fan = best;
+    }
+
+    std::copy(result.begin(), result.end(), indices);
+}
+
+// ── 过度绘制优化 ────────────────────────────────────────────
+// 1. 在 Tipsify 硬边界内，按 ACMR 阈值切出更细的软簇
+// 2. 每簇计算面积加权的质心与法线，按 dot(质心 - 网格中心, 簇法线) 降序:
+//    朝外且远离中心的簇先画，凸状物体上被遮挡的面更晚绘制，深度测试可提前剔除
+
+void MeshOptimizer::OptimizeOverdraw(u32* indices, u32 indexCount,
+                                     const MeshVertex* vertices, u32 vertexCount,
+                                     const std::vector<u32>& clusters,
+                                     f32 threshold, u32 cacheSize) {
+    u32 triCount = indexCount / 3;
+    if (triCount == 0 || clusters.empty()) return;
+
+    // ── 软边界 ──────────────────────────────────────
+    std::vector<u32> bounds;
+    FifoCache cache(vertexCount, cacheSize);
+    for (size_t c = 0; c < clusters.size(); c++) {
+        u32 begin = clusters[c];
+        u32 end = (c + 1 < clusters.size()) ? clusters[c + 1] : triCount;
+        if (begin >= end) continue;
+
+        cache.Flush();
+        f32 clusterAcmr = (f32)CountMisses(indices, begin, end, cache) / (f32)(end - begin);
+
+        cache.Flush();
+        bounds.push_back(begin);
+        u32 start = begin, misses = 0;
+        for (u32 t = begin; t < end; t++) {
+            misses += CountMisses(indices, t, t + 1, cache);
+            // 当前前缀的 ACMR 已不差于整簇: 在此切开，对全局缓存效率影响有限
+            if (t + 1 < end && (f32)misses / (f32)(t + 1 - start) <= clusterAcmr * threshold) {
+                bounds.push_back(t + 1);
+                start = t + 1;
+                misses = 0;
+                cache.Flush();
+            }
+        }
+    }
+
+    // ── 网格中心 ────────────────────────────────────
+    glm::vec3 meshCenter(0.0f);
+    f32 meshArea = 0.0f;
+    for (u32 t = 0; t < triCount; t++) {
+        const glm::vec3& a = vertices[indices[t * 3 + 0]].Position;
+        const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+        const glm::vec3& c = vertices[indices[t * 3 + 2]].Position;
+        f32 area = glm::length(glm::cross(b - a, c - a));
+        meshCenter += (a + b + c) * (area / 3.0f);
+        meshArea += area;
+    }
+    if (meshArea > 0.0f) meshCenter /= meshArea;
+
+    // ── 簇排序键 ────────────────────────────────────
+    u32 clusterCount = (u32)bounds.size();
+    std::vector<f32> sortKey(clusterCount);
+    for (u32 c = 0; c < clusterCount; c++) {
+        u32 begin = bounds[c];
+        u32 end = (c + 1 < clusterCount) ? bounds[c + 1] : triCount;
+
+        glm::vec3 centroid(0.0f), normal(0.0f);
+        f32 area = 0.0f;
+        for (u32 t = begin; t < end; t++) {
+            const glm::vec3& a = vertices[indices[t * 3 + 0]].Position;
+            const glm::vec3& b = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3& cc = vertices[indices[t * 3 + 2]].Position;
+            glm::vec3 n = glm::cross(b - a, cc - a);   // 长度 = 2 × 面积
+            f32 triArea = glm::length(n);
+            centroid += (a + b + cc) * (triArea / 3.0f);
+            normal += n;
+            area += triArea;
+        }
+        if (area > 0.0f) centroid /= area;
+        f32 len = glm::length(normal);
+        if (len > 0.0f) normal /= len;
+        sortKey[c] = glm::dot(centroid - meshCenter, normal);
+    }
+
+    std::vector<u32> order(clusterCount);
+    std::iota(order.begin(), order.end(), 0u);
+    std::stable_sort(order.begin(), order.end(),
+                     [&](u32 a, u32 b) { return sortKey[a] > sortKey[b]; });
+
+    std::vector<u32> result;
+    result.reserve(indexCount);
+    for (u32 c : order) {
+        u32 begin = bounds[c];
+        u32 end = (c + 1 < clusterCount) ? bounds[c + 1] : triCount;
+        result.insert(result.end(), indices + begin * 3, indices + end * 3);
+    }
+    std::copy(result.begin(), result.end(), indices);
+}
+
+// ── 顶点读取优化 ────────────────────────────────────────────
+
+u32 MeshOptimizer::OptimizeVertexFetch(std::vector<MeshVertex>& vertices, std::vector<u32>& indices) {
+    constexpr u32 UNUSED = ~0u;
+    std::vector<u32> remap(vertices.size(), UNUSED);
+    std::vector<MeshVertex> reordered;
+    reordered.reserve(vertices.size());
+
+    for (u32& index : indices) {
+        if (remap[index] == UNUSED) {
+            remap[index] = (u32)reordered.size();
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    vertices.swap(reordered);
+    return (u32)vertices.size();
+}
+
+void MeshOptimizer::Optimize(std::vector<MeshVertex>& vertices, std::vector<u32>& indices,
+                             f32 overdrawThreshold) {
+    if (indices.size() < 3) return;
+    std::vector<u32> clusters;
+    OptimizeVertexCache(indices.data(), (u32)indices.size(), (u32)vertices.size(),
+                        DEFAULT_CACHE_SIZE, &clusters);
+    OptimizeOverdraw(indices.data(), (u32)indices.size(), vertices.data(), (u32)vertices.size(),
+                     clusters, overdrawThreshold);
+    OptimizeVertexFetch(vertices, indices);
+}
+
+// ── 统计 ────────────────────────────────────────────────────
+
+VertexCacheStats MeshOptimizer::AnalyzeVertexCache(const u32* indices, u32 indexCount,
+                                                   u32 vertexCount, u32 cacheSize) {
+    VertexCacheStats stats;
+    u32 triCount = indexCount / 3;
+    if (triCount == 0) return stats;
+
+    FifoCache cache(vertexCount, cacheSize);
+    stats.Transformed = CountMisses(indices, 0, triCount, cache);
+
+    std::vector<u8> used(vertexCount, 0);
+    u32 unique = 0;
+    for (u32 i = 0; i < triCount * 3; i++) {
+        if (!used[indices[i]]) {
+            used[indices[i]] = 1;
+            unique++;
+        }
+    }
+    stats.ACMR = (f32)stats.Transformed / (f32)triCount;
+    stats.ATVR = unique ? (f32)stats.Transformed / (f32)unique : 0.0f;
+    return stats;
+}
+
+// ── 量化 ────────────────────────────────────────────────────
+
+void MeshOptimizer::Quantize(const MeshVertex* vertices, u32 vertexCount,
+                             std::vector<PackedMeshVertex>& out) {
+    out.resize(vertexCount);
+    for (u32 i = 0; i < vertexCount; i++) {
+        const MeshVertex& v = vertices[i];
+        PackedMeshVertex& p = out[i];
+
+        p.Position[0] = ToHalf(v.Position.x);
+        p.Position[1] = ToHalf(v.Position.y);
+        p.Position[2] = ToHalf(v.Position.z);
+        p.Position[3] = ToHalf(1.0f);
+
+        glm::vec3 n = glm::length(v.Normal) > 1e-6f ? glm::normalize(v.Normal) : glm::vec3(0, 1, 0);
+        glm::vec3 t = glm::length(v.Tangent) > 1e-6f ? glm::normalize(v.Tangent) : glm::vec3(1, 0, 0);
+        // 副切线只保留相对 cross(N, T) 的方向 (镜像 UV 时为 -1)
+        f32 sign = glm::dot(glm::cross(n, t), v.Bitangent) < 0.0f ? -1.0f : 1.0f;
+
+        p.Normal  = glm::packSnorm3x10_1x2(glm::vec4(n, 0.0f));
+        p.Tangent = glm::packSnorm3x10_1x2(glm::vec4(t, sign));
+
+        p.TexCoord[0] = ToHalf(v.TexCoord.x);
+        p.TexCoord[1] = ToHalf(v.TexCoord.y);
+    }
+}
+
+void MeshOptimizer::Dequantize(const PackedMeshVertex* vertices, u32 vertexCount,
+                               std::vector<MeshVertex>& out) {
+    out.resize(vertexCount);
+    for (u32 i = 0; i < vertexCount; i++) {
+        const PackedMeshVertex& p = vertices[i];
+        MeshVertex& v = out[i];
+
+        v.Position = {glm::unpackHalf1x16(p.Position[0]), glm::unpackHalf1x16(p.Position[1]),
+                      glm::unpackHalf1x16(p.Position[2])};
+        v.Normal = glm::vec3(glm::unpackSnorm3x10_1x2(p.Normal));
+        glm::vec4 t = glm::unpackSnorm3x10_1x2(p.Tangent);
+        v.Tangent = glm::vec3(t);
+        v.Bitangent = glm::cross(v.Normal, v.Tangent) * (t.w < 0.0f ? -1.0f : 1.0f);
+        v.TexCoord = {glm::unpackHalf1x16(p.TexCoord[0]), glm::unpackHalf1x16(p.TexCoord[1])};
+    }
+}
+
+// ── Meshlet ─────────────────────────────────────────────────
+
+void MeshOptimizer::BuildMeshlets(const MeshVertex* vertices, u32 vertexCount,
+                                  const u32* indices, u32 indexCount, MeshletData& out,
+                                  u32 maxVertices, u32 maxTriangles) {
+    out.Meshlets.clear();
+    out.Vertices.clear();
+    out.Triangles.clear();
+    maxVertices = std::clamp(maxVertices, 3u, 256u);   // 局部索引为 u8
+    u32 triCount = indexCount / 3;
+    if (triCount == 0 || maxTriangles == 0) return;
+
+    std::vector<u32> localIndex(vertexCount, ~0u);
+    Meshlet current;
+
+    auto finish = [&]() {
+        if (current.TriangleCount == 0) return;
+
+        // 包围球: 顶点 AABB 中心 + 最远距离
+        glm::vec3 lo(1e30f), hi(-1e30f);
+        for (u32 i = 0; i < current.VertexCount; i++) {
+            u32 v = out.Vertices[current.VertexOffset + i];
+            lo = glm::min(lo, vertices[v].Position);
+            hi = glm::max(hi, vertices[v].Position);
+            localIndex[v] = ~0u;
+        }
+        current.Center = (lo + hi) * 0.5f;
+        f32 radius2 = 0.0f;
+        for (u32 i = 0; i < current.VertexCount; i++) {
+            glm::vec3 d = vertices[out.Vertices[current.VertexOffset + i]].Position - current.Center;
+            radius2 = std::max(radius2, glm::dot(d, d));
+        }
+        current.Radius = std::sqrt(radius2);
+
+        // 法线锥: 轴 = 面法线平均，半角由与轴夹角最大的面决定
+        std::vector<glm::vec3> normals;
+        normals.reserve(current.TriangleCount);
+        glm::vec3 axis(0.0f);
+        for (u32 t = 0; t < current.TriangleCount; t++) {
+            const u8* tri = &out.Triangles[current.TriangleOffset + t * 3];
+            const glm::vec3& a = vertices[out.Vertices[current.VertexOffset + tri[0]]].Position;
+            const glm::vec3& b = vertices[out.Vertices[current.VertexOffset + tri[1]]].Position;
+            const glm::vec3& c = vertices[out.Vertices[current.VertexOffset + tri[2]]].Position;
+            glm::vec3 n = glm::cross(b - a, c - a);
+            f32 len = glm::length(n);
+            if (len <= 0.0f) continue;   // 退化三角形不影响朝向
+            n /= len;
+            normals.push_back(n);
+            axis += n;
+        }
+        f32 axisLen = glm::length(axis);
+        current.ConeCutoff = 1.0f;
+        if (axisLen > 0.0f && !normals.empty()) {
+            axis /= axisLen;
+            f32 minDot = 1.0f;
+            for (const auto& n : normals) minDot = std::min(minDot, glm::dot(n, axis));
+            current.ConeAxis = axis;
+            // 所有面与轴夹角 < 90° 才可能整簇背向，sin(半角) 作为剔除阈值
+            if (minDot > 0.0f) current.ConeCutoff = std::sqrt(1.0f - minDot * minDot);
+        }
+
+        out.Meshlets.push_back(current);
+        current = Meshlet();
+        current.VertexOffset = (u32)out.Vertices.size();
+        current.TriangleOffset = (u32)out.Triangles.size();
+    };
+
+    for (u32 t = 0; t < triCount; t++) {
+        const u32* tri = indices + t * 3;
+        u32 newVerts = 0;
+        for (u32 k = 0; k < 3; k++) {
+            if (localIndex[tri[k]] == ~0u) newVerts++;
+        }
+        if (current.VertexCount + newVerts > maxVertices || current.TriangleCount + 1 > maxTriangles) {
+            finish();
+        }
+        for (u32 k = 0; k < 3; k++) {
+            u32 v = tri[k];
+            if (localIndex[v] == ~0u) {
+                localIndex[v] = current.VertexCount++;
+                out.Vertices.push_back(v);
+            }
+            out.Triangles.push_back((u8)localIndex[v]);
+        }
+        current.TriangleCount++;
+    }
+    finish();
+}
+
+} // namespace Engine
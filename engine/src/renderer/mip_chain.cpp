@@ -0,0 +1,216 @@
+#include "engine/renderer/mip_chain.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Engine {
+
+// ── 滤波核 ──────────────────────────────────────────────────
+
+namespace {
+
+constexpr f32 PI = 3.14159265358979f;
+constexpr f32 KAISER_RADIUS = 3.0f;   // 以目标像素为单位的支撑半径
+constexpr f32 KAISER_ALPHA  = 4.0f;
+
+/// 第一类零阶修正 Bessel 函数 (级数展开)
+f32 BesselI0(f32 x) {
+    f32 sum = 1.0f, term = 1.0f;
+    f32 halfX = x * 0.5f;
+    for (int k = 1; k < 16; k++) {
+        term *= (halfX / (f32)k) * (halfX / (f32)k);
+        sum += term;
+        if (term < sum * 1e-7f) break;
+    }
+    return sum;
+}
+
+f32 Sinc(f32 x) {
+    if (std::fabs(x) < 1e-5f) return 1.0f;
+    return std::sin(PI * x) / (PI * x);
+}
+
+/// Kaiser 窗 sinc, t 以目标像素为单位
+f32 KaiserWeight(f32 t) {
+    f32 r = t / KAISER_RADIUS;
+    if (r <= -1.0f || r >= 1.0f) return 0.0f;
+    return Sinc(t) * BesselI0(KAISER_ALPHA * std::sqrt(1.0f - r * r)) / BesselI0(KAISER_ALPHA);
+}
+
+// ── 一维重采样表 ────────────────────────────────────────────
+// 每个目标像素记录源像素起点与权重 (已归一化)
+
+struct Taps {
+    std::vector<i32> Start;
+    std::vector<u32> Count;
+    std::vector<f32> Weights;   // 按目标像素展开, 每个占 MaxTaps 个
+    u32 MaxTaps = 0;
+};
+
+void BuildTaps(u32 srcSize, u32 dstSize, MipFilter filter, Taps& taps) {
+    f32 scale = (f32)srcSize / (f32)dstSize;   // >= 1
+    f32 support = (filter == MipFilter::Box) ? scale * 0.5f : scale * KAISER_RADIUS;
+
+    taps.MaxTaps = (u32)std::ceil(support * 2.0f) + 2;
+    taps.Start.assign(dstSize, 0);
+    taps.Count.assign(dstSize, 0);
+    taps.Weights.assign((size_t)dstSize * taps.MaxTaps, 0.0f);
+
+    for (u32 d = 0; d < dstSize; d++) {
+        f32 center = ((f32)d + 0.5f) * scale;
+        i32 first = (i32)std::floor(center - support);
+        i32 last  = (i32)std::ceil(center + support);
+        f32* w = &taps.Weights[(size_t)d * taps.MaxTaps];
+
+        u32 n = 0;
+        f32 total = 0.0f;
+        for (i32 s = first; s < last && n < taps.MaxTaps; s++, n++) {
+            f32 weight;
+            if (filter == MipFilter::Box) {
+                // 源像素 [s, s+1) 与目标覆盖区 [c - support, c + support) 的重叠长度
+                f32 lo = std::max((f32)s, center - support);
+                f32 hi = std::min((f32)s + 1.0f, center + support);
+                weight = std::max(0.0f, hi - lo);
+            } else {
+                weight = KaiserWeight(((f32)s + 0.5f - center) / scale);
+            }
+            w[n] = weight;
+            total += weight;
+        }
+
+        if (std::fabs(total) > 1e-6f) {
+            for (u32 i = 0; i < n; i++) w[i] /= total;
+        }
+        taps.Start[d] = first;
+        taps.Count[d] = n;
+    }
+}
+
+inline i32 ClampIndex(i32 v, u32 size) {
+    return v < 0 ? 0 : (v >= (i32)size ? (i32)size - 1 : v);
+}
+
+// ── 2:1 Box 快速路径 (偶数尺寸) ─────────────────────────────
+
+void DownsampleBox2x2(const u8* src, u32 srcW, u32 channels, u8* dst, u32 dstW, u32 dstH) {
+    size_t srcStride = (size_t)srcW * channels;
+    for (u32 y = 0; y < dstH; y++) {
+        const u8* row0 = src + (size_t)(y * 2) * srcStride;
+        const u8* row1 = row0 + srcStride;
+        u8* out = dst + (size_t)y * dstW * channels;
+        for (u32 x = 0; x < dstW; x++) {
+            const u8* p0 = row0 + (size_t)(x * 2) * channels;
+            const u8* p1 = row1 + (size_t)(x * 2) * channels;
+            for (u32 c = 0; c < channels; c++) {
+                u32 sum = (u32)p0[c] + p0[c + channels] + p1[c] + p1[c + channels];
+                out[x * channels + c] = (u8)((sum + 2) >> 2);
+            }
+        }
+    }
+}
+
+// ── 通用可分离重采样 (水平 → 垂直) ─────────────────────────
+
+void DownsampleSeparable(const u8* src, u32 srcW, u32 srcH, u32 channels,
+                         u8* dst, u32 dstW, u32 dstH, MipFilter filter,
+                         std::vector<f32>& scratch) {
+    Taps tx, ty;
+    BuildTaps(srcW, dstW, filter, tx);
+    BuildTaps(srcH, dstH, filter, ty);
+
+    // 水平 pass: srcH 行 × dstW 列 (float 中间结果)
+    scratch.assign((size_t)srcH * dstW * channels, 0.0f);
+    for (u32 y = 0; y < srcH; y++) {
+        const u8* row = src + (size_t)y * srcW * channels;
+        f32* out = &scratch[(size_t)y * dstW * channels];
+        for (u32 x = 0; x < dstW; x++) {
+            const f32* w = &tx.Weights[(size_t)x * tx.MaxTaps];
+            for (u32 c = 0; c < channels; c++) {
+                f32 acc = 0.0f;
+                for (u32 i = 0; i < tx.Count[x]; i++) {
+                    i32 sx = ClampIndex(tx.Start[x] + (i32)i, srcW);
+                    acc += w[i] * (f32)row[(size_t)sx * channels + c];
+                }
+                out[x * channels + c] = acc;
+            }
+        }
+    }
+
+    // 垂直 pass
+    size_t rowFloats = (size_t)dstW * channels;
+    for (u32 y = 0; y < dstH; y++) {
+        const f32* w = &ty.Weights[(size_t)y * ty.MaxTaps];
+        u8* out = dst + (size_t)y * rowFloats;
+        for (size_t k = 0; k < rowFloats; k++) {
+            f32 acc = 0.0f;
+            for (u32 i = 0; i < ty.Count[y]; i++) {
+                i32 sy = ClampIndex(ty.Start[y] + (i32)i, srcH);
+                acc += w[i] * scratch[(size_t)sy * rowFloats + k];
+            }
+            out[k] = (u8)std::clamp((i32)std::lround(acc), 0, 255);
+        }
+    }
+}
+
+} // namespace
+
+// ── MipChain ────────────────────────────────────────────────
+
+u32 MipChain::CountLevels(u32 width, u32 height) {
+    u32 size = std::max(width, height);
+    u32 levels = 1;
+    while (size > 1) { size >>= 1; levels++; }
+    return levels;
+}
+
+bool MipChain::Build(const u8* pixels, u32 width, u32 height, u32 channels,
+                     MipFilter filter, MipChain& out) {
+    if (!pixels || width == 0 || height == 0 || channels == 0 || channels > 4) {
+        LOG_ERROR("[MipChain] 无效输入: %ux%u, %u 通道", width, height, channels);
+        return false;
+    }
+
+    out.Width = width;
+    out.Height = height;
+    out.Channels = channels;
+    out.Levels.clear();
+
+    // 先算出全部层级布局，一次性分配
+    u32 levelCount = CountLevels(width, height);
+    size_t total = 0;
+    u32 w = width, h = height;
+    for (u32 i = 0; i < levelCount; i++) {
+        MipLevel lv;
+        lv.Width = w;
+        lv.Height = h;
+        lv.Offset = total;
+        lv.Size = (size_t)w * h * channels;
+        total += lv.Size;
+        out.Levels.push_back(lv);
+        w = std::max(1u, w / 2);
+        h = std::max(1u, h / 2);
+    }
+    out.Pixels.resize(total);
+    std::memcpy(out.Pixels.data(), pixels, out.Levels[0].Size);
+
+    std::vector<f32> scratch;
+    for (u32 i = 1; i < levelCount; i++) {
+        const MipLevel& src = out.Levels[i - 1];
+        const MipLevel& dst = out.Levels[i];
+        const u8* srcData = out.Pixels.data() + src.Offset;
+        u8* dstData = out.Pixels.data() + dst.Offset;
+
+        bool even = (src.Width == dst.Width * 2) && (src.Height == dst.Height * 2);
+        if (filter == MipFilter::Box && even) {
+            DownsampleBox2x2(srcData, src.Width, channels, dstData, dst.Width, dst.Height);
+        } else {
+            DownsampleSeparable(srcData, src.Width, src.Height, channels,
+                                dstData, dst.Width, dst.Height, filter, scratch);
+        }
+    }
+    return true;
+}
+
+} // namespace Engine
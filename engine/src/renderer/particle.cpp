@@ -1,23 +1,28 @@
 #include "engine/renderer/particle.h"
+#include "engine/core/job_system.h"
 #include "engine/core/log.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/type_ptr.hpp>
 
-#include <cmath>
-#include <cstdlib>
 #include <algorithm>
-#include <random>
 
 namespace Engine {
 
-std::vector<Particle> ParticleSystem::s_Pool;
+std::vector<Scope<ParticleEmitter>> ParticleSystem::s_Emitters;
+std::vector<ParticleEmitter*> ParticleSystem::s_Active;
+std::vector<ParticleEmitterHandle> ParticleSystem::s_ImmediateEmitters;
+u32 ParticleSystem::s_NextSeed = 1;
+ParticleLODSettings ParticleSystem::s_LOD;
+ParticleDrawList ParticleSystem::s_DrawList;
+glm::vec3 ParticleSystem::s_CameraPosition = {0, 0, 0};
+bool ParticleSystem::s_HasCamera = false;
 u32 ParticleSystem::s_AliveCount = 0;
 u32 ParticleSystem::s_QuadVAO = 0;
 u32 ParticleSystem::s_QuadVBO = 0;
 u32 ParticleSystem::s_InstanceVBO = 0;
+u32 ParticleSystem::s_InstanceCapacity = 0;
 Ref<Shader> ParticleSystem::s_Shader = nullptr;
-std::vector<ParticleSystem::InstanceData> ParticleSystem::s_InstanceBuffer;
 
 // ── 实例化粒子着色器 ────────────────────────────────────────
 
@@ -71,11 +76,20 @@ static const float quadVerts[] = {
     -1, -1, 0,   1,  1, 0,  -1, 1, 0,
 };
 
-static std::mt19937 s_RNG(std::random_device{}());
-
-static float RandFloat(float lo, float hi) {
-    std::uniform_real_distribution<float> dist(lo, hi);
-    return dist(s_RNG);
+static constexpr u32 INITIAL_INSTANCE_CAPACITY = 1000;
+
+// 实例属性指向实例缓冲区中第 firstInstance 个实例 (GL 4.5 核心之外的 BaseInstance 不可用)
+static void BindInstanceAttributes(u32 firstInstance) {
+    size_t base = (size_t)firstInstance * sizeof(ParticleInstance);
+    // aParticlePos (location 1) / aSize (2) / aColor (3) / aAlpha (4)
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance),
+                          (void*)(base + offsetof(ParticleInstance, Position)));
+    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance),
+                          (void*)(base + offsetof(ParticleInstance, Size)));
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance),
+                          (void*)(base + offsetof(ParticleInstance, Color)));
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(ParticleInstance),
+                          (void*)(base + offsetof(ParticleInstance, Alpha)));
 }
 
 void ParticleSystem::Init() {
@@ -93,38 +107,19 @@ void ParticleSystem::Init() {
 
     // 实例数据缓冲区
     glBindBuffer(GL_ARRAY_BUFFER, s_InstanceVBO);
-    glBufferData(GL_ARRAY_BUFFER, 1000 * sizeof(InstanceData), nullptr, GL_DYNAMIC_DRAW);
-
-    // aParticlePos (location 1)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
-                          (void*)offsetof(InstanceData, Position));
-    glVertexAttribDivisor(1, 1);
-
-    // aSize (location 2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
-                          (void*)offsetof(InstanceData, Size));
-    glVertexAttribDivisor(2, 1);
-
-    // aColor (location 3)
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
-                          (void*)offsetof(InstanceData, Color));
-    glVertexAttribDivisor(3, 1);
-
-    // aAlpha (location 4)
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(InstanceData),
-                          (void*)offsetof(InstanceData, Alpha));
-    glVertexAttribDivisor(4, 1);
+    s_InstanceCapacity = INITIAL_INSTANCE_CAPACITY;
+    glBufferData(GL_ARRAY_BUFFER, s_InstanceCapacity * sizeof(ParticleInstance), nullptr, GL_DYNAMIC_DRAW);
+
+    BindInstanceAttributes(0);
+    for (u32 loc = 1; loc <= 4; loc++) {
+        glEnableVertexAttribArray(loc);
+        glVertexAttribDivisor(loc, 1);
+    }
 
     glBindVertexArray(0);
 
     s_Shader = std::make_shared<Shader>(pVert, pFrag);
-    s_Pool.resize(1000);
-    s_InstanceBuffer.reserve(1000);
-    LOG_INFO("[粒子] 初始化完成 - 实例化渲染 (池大小: %zu)", s_Pool.size());
+    LOG_INFO("[粒子] 初始化完成 - SoA 发射器 + 实例化渲染");
 }
 
 void ParticleSystem::Shutdown() {
@@ -132,104 +127,113 @@ void ParticleSystem::Shutdown() {
     if (s_QuadVBO)     { glDeleteBuffers(1, &s_QuadVBO);       s_QuadVBO = 0; }
     if (s_InstanceVBO) { glDeleteBuffers(1, &s_InstanceVBO);   s_InstanceVBO = 0; }
     s_Shader.reset();
-    s_Pool.clear();
-    s_InstanceBuffer.clear();
+    s_Emitters.clear();
+    s_Active.clear();
+    s_ImmediateEmitters.clear();
+    s_InstanceCapacity = 0;
+    s_HasCamera = false;
+    s_AliveCount = 0;
 }
 
-void ParticleSystem::RespawnParticle(Particle& p, const ParticleEmitterConfig& cfg) {
-    p.Position = cfg.Position;
-    p.Life = RandFloat(cfg.MinLife, cfg.MaxLife);
-    p.MaxLife = p.Life;
-    p.Size = RandFloat(cfg.MinSize, cfg.MaxSize);
-    p.Color = cfg.ColorStart;
-
-    // 随机方向 (在锥形范围内)
-    float spreadRad = cfg.SpreadAngle * 3.14159f / 180.0f;
-    float theta = RandFloat(0, 6.28318f);
-    float phi   = RandFloat(0, spreadRad);
-    float sp = sinf(phi);
-    glm::vec3 randDir(sp * cosf(theta), cosf(phi), sp * sinf(theta));
-
-    // 校正方向
-    glm::vec3 dir = glm::normalize(cfg.Direction);
-    if (glm::abs(glm::dot(dir, glm::vec3(0,1,0))) < 0.99f) {
-        glm::vec3 right = glm::normalize(glm::cross(dir, glm::vec3(0,1,0)));
-        glm::vec3 up = glm::cross(right, dir);
-        p.Velocity = (dir * randDir.y + right * randDir.x + up * randDir.z);
-    } else {
-        p.Velocity = randDir;
-    }
-    p.Velocity *= RandFloat(cfg.MinSpeed, cfg.MaxSpeed);
-    p.Gravity = cfg.Gravity;
-    p.ColorStart = cfg.ColorStart;
-    p.ColorEnd = cfg.ColorEnd;
-}
+// ── 发射器管理 ──────────────────────────────────────────────
 
-void ParticleSystem::Emit(const ParticleEmitterConfig& config, f32 dt) {
-    u32 toEmit = (u32)(config.EmitRate * dt);
-    if (toEmit < 1 && RandFloat(0, 1) < config.EmitRate * dt) toEmit = 1;
-
-    u32 emitted = 0;
-    for (auto& p : s_Pool) {
-        if (emitted >= toEmit) break;
-        if (!p.IsAlive()) {
-            RespawnParticle(p, config);
-            emitted++;
+ParticleEmitterHandle ParticleSystem::CreateEmitter(const ParticleEmitterConfig& config) {
+    auto emitter = CreateScope<ParticleEmitter>(config, s_NextSeed++);
+    for (size_t i = 0; i < s_Emitters.size(); i++) {
+        if (!s_Emitters[i]) {
+            s_Emitters[i] = std::move(emitter);
+            return (ParticleEmitterHandle)(i + 1);
         }
     }
+    s_Emitters.push_back(std::move(emitter));
+    return (ParticleEmitterHandle)s_Emitters.size();
 }
 
-void ParticleSystem::Update(f32 dt) {
-    s_AliveCount = 0;
-    for (auto& p : s_Pool) {
-        if (!p.IsAlive()) continue;
-        p.Life -= dt;
-        if (p.Life <= 0) continue;
+void ParticleSystem::DestroyEmitter(ParticleEmitterHandle handle) {
+    if (handle == INVALID_PARTICLE_EMITTER || handle > s_Emitters.size()) return;
+    std::erase(s_Active, s_Emitters[handle - 1].get());
+    s_Emitters[handle - 1].reset();
+    std::erase(s_ImmediateEmitters, handle);
+}
 
-        p.Velocity.y += p.Gravity * dt;
-        p.Position += p.Velocity * dt;
+ParticleEmitter* ParticleSystem::GetEmitter(ParticleEmitterHandle handle) {
+    if (handle == INVALID_PARTICLE_EMITTER || handle > s_Emitters.size()) return nullptr;
+    return s_Emitters[handle - 1].get();
+}
 
-        // 颜色插值
-        f32 t = (p.MaxLife > 0.001f) ? (1.0f - p.Life / p.MaxLife) : 1.0f;
-        p.Color = glm::mix(p.ColorStart, p.ColorEnd, t);
+u32 ParticleSystem::GetEmitterCount() {
+    return (u32)std::count_if(s_Emitters.begin(), s_Emitters.end(),
+                              [](const Scope<ParticleEmitter>& e) { return e != nullptr; });
+}
+
+// 发射后粒子外观只取决于发射器上的这些参数，其余 (位置/方向/速度/寿命/尺寸范围) 只影响新粒子
+static bool SameAppearance(const ParticleEmitterConfig& a, const ParticleEmitterConfig& b) {
+    return a.ColorStart == b.ColorStart && a.ColorEnd == b.ColorEnd &&
+           a.SizeStart == b.SizeStart && a.SizeEnd == b.SizeEnd &&
+           a.AlphaStart == b.AlphaStart && a.AlphaEnd == b.AlphaEnd &&
+           a.Gravity == b.Gravity && a.Drag == b.Drag && a.MaxParticles == b.MaxParticles &&
+           a.AlphaBlend == b.AlphaBlend;
+}
 
-        s_AliveCount++;
+void ParticleSystem::Emit(const ParticleEmitterConfig& config, f32 dt) {
+    ParticleEmitter* target = nullptr;
+    for (ParticleEmitterHandle handle : s_ImmediateEmitters) {
+        ParticleEmitter* emitter = GetEmitter(handle);
+        if (emitter && SameAppearance(emitter->GetConfig(), config)) { target = emitter; break; }
+    }
+    if (!target) {
+        ParticleEmitterHandle handle = CreateEmitter(config);
+        s_ImmediateEmitters.push_back(handle);
+        target = GetEmitter(handle);
+        target->Emitting = false;
     }
+    target->SetConfig(config);
+    target->EmitRateScale = s_HasCamera ? s_LOD.EmitRateScale(glm::length(config.Position - s_CameraPosition)) : 1.0f;
+    target->EmitOverTime(dt);
+}
+
+// ── 更新 ────────────────────────────────────────────────────
+
+void ParticleSystem::Update(f32 dt) {
+    s_Active.clear();
+    for (auto& emitter : s_Emitters) {
+        if (!emitter) continue;
+        // 发射率距离 LOD (按发射点)
+        emitter->EmitRateScale = s_HasCamera
+            ? s_LOD.EmitRateScale(glm::length(emitter->GetConfig().Position - s_CameraPosition)) : 1.0f;
+        s_Active.push_back(emitter.get());
+    }
+    ParticleEmitter::UpdateAll(s_Active.data(), (u32)s_Active.size(), dt);
+
+    s_AliveCount = 0;
+    for (ParticleEmitter* emitter : s_Active) s_AliveCount += emitter->GetAliveCount();
 }
 
 void ParticleSystem::Draw(const f32* viewProjectionMatrix,
+                           const glm::vec3& cameraPosition,
                            const glm::vec3& cameraRight,
                            const glm::vec3& cameraUp) {
+    s_CameraPosition = cameraPosition;
+    s_HasCamera = true;
     if (s_AliveCount == 0) return;
 
-    // 收集活粒子实例数据
-    s_InstanceBuffer.clear();
-    for (auto& p : s_Pool) {
-        if (!p.IsAlive()) continue;
-        InstanceData id;
-        id.Position = p.Position;
-        id.Size = p.Size;
-        id.Color = p.Color;
-        id.Alpha = (p.MaxLife > 0.001f) ? (p.Life / p.MaxLife) : 0.0f;
-        s_InstanceBuffer.push_back(id);
-    }
-
-    if (s_InstanceBuffer.empty()) return;
+    // 剔除 + 实例写入 + alpha 混合部分排序
+    s_DrawList.Build(s_Active.data(), (u32)s_Active.size(), glm::make_mat4(viewProjectionMatrix),
+                     cameraPosition, s_LOD);
+    const auto& instances = s_DrawList.GetInstances();
+    u32 total = (u32)instances.size();
+    u32 additive = s_DrawList.GetAdditiveCount();
+    if (total == 0) return;
 
-    // 上传实例数据 (使用 glMapBufferRange 减少同步开销)
+    // 上传实例数据 (容量不足时按 1.5 倍扩容)
     glBindBuffer(GL_ARRAY_BUFFER, s_InstanceVBO);
-    size_t dataSize = s_InstanceBuffer.size() * sizeof(InstanceData);
-    // 如果缓冲区不够大，重新分配
-    size_t currentCapacity = s_Pool.size() * sizeof(InstanceData);
-    if (dataSize > currentCapacity) {
-        glBufferData(GL_ARRAY_BUFFER, dataSize, s_InstanceBuffer.data(), GL_DYNAMIC_DRAW);
-    } else {
-        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)dataSize, s_InstanceBuffer.data());
+    if (total > s_InstanceCapacity) {
+        s_InstanceCapacity = std::max(total, s_InstanceCapacity + s_InstanceCapacity / 2);
+        glBufferData(GL_ARRAY_BUFFER, s_InstanceCapacity * sizeof(ParticleInstance), nullptr, GL_DYNAMIC_DRAW);
     }
+    glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)(total * sizeof(ParticleInstance)), instances.data());
 
-    // 叠加混合
     glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE);
     glDepthMask(GL_FALSE);
 
     s_Shader->Bind();
@@ -237,9 +241,19 @@ void ParticleSystem::Draw(const f32* viewProjectionMatrix,
     s_Shader->SetVec3("uRight", cameraRight.x, cameraRight.y, cameraRight.z);
     s_Shader->SetVec3("uUp", cameraUp.x, cameraUp.y, cameraUp.z);
 
-    // 单次实例化 DrawCall！
     glBindVertexArray(s_QuadVAO);
-    glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)s_InstanceBuffer.size());
+    // 叠加混合 (与顺序无关)
+    if (additive > 0) {
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)additive);
+    }
+    // alpha 混合 (已从后往前排序)
+    if (total > additive) {
+        BindInstanceAttributes(additive);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        glDrawArraysInstanced(GL_TRIANGLES, 0, 6, (GLsizei)(total - additive));
+        BindInstanceAttributes(0);
+    }
     glBindVertexArray(0);
 
     // 恢复 GL 状态到默认
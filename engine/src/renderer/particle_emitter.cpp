@@ -0,0 +1,356 @@
+#include "engine/renderer/particle_emitter.h"
+#include "engine/core/job_system.h"
+#include "engine/core/simd.h"
+#include "engine/renderer/frustum.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Engine {
+
+using namespace Simd;
+
+// ── 构造与配置 ──────────────────────────────────────────────
+
+ParticleEmitter::ParticleEmitter(const ParticleEmitterConfig& config, u32 seed)
+    : m_Config(config), m_Rng(seed) {
+    Allocate(config.MaxParticles);
+}
+
+void ParticleEmitter::SetConfig(const ParticleEmitterConfig& config) {
+    u32 oldCapacity = m_Config.MaxParticles;
+    m_Config = config;
+    if (config.MaxParticles != oldCapacity) Allocate(config.MaxParticles);
+}
+
+void ParticleEmitter::Allocate(u32 capacity) {
+    u32 stride = (capacity + 3) & ~3u;
+    u32 keep = std::min(m_Alive, capacity);
+
+    std::vector<f32> storage((size_t)stride * STREAM_COUNT, 0.0f);
+    for (u32 s = 0; s < STREAM_COUNT; s++) {
+        if (keep > 0) std::memcpy(storage.data() + (size_t)s * stride, m_Streams[s], keep * sizeof(f32));
+    }
+    m_Storage = std::move(storage);
+    m_Stride = stride;
+    m_Alive = keep;
+    for (u32 s = 0; s < STREAM_COUNT; s++) m_Streams[s] = m_Storage.data() + (size_t)s * stride;
+}
+
+f32 ParticleEmitter::Random(f32 lo, f32 hi) {
+    std::uniform_real_distribution<f32> dist(lo, hi);
+    return dist(m_Rng);
+}
+
+// ── 发射 ────────────────────────────────────────────────────
+
+u32 ParticleEmitter::Emit(u32 count) {
+    const ParticleEmitterConfig& cfg = m_Config;
+    count = std::min(count, cfg.MaxParticles - std::min(m_Alive, cfg.MaxParticles));
+    if (count == 0) return 0;
+
+    // 锥形发射的局部基: y 轴对齐 Direction
+    glm::vec3 dir = glm::normalize(cfg.Direction);
+    glm::vec3 right(1, 0, 0), up(0, 0, 1);
+    if (glm::abs(glm::dot(dir, glm::vec3(0, 1, 0))) < 0.99f) {
+        right = glm::normalize(glm::cross(dir, glm::vec3(0, 1, 0)));
+        up = glm::cross(right, dir);
+    } else {
+        dir = glm::vec3(0, 1, 0);
+    }
+    f32 spreadRad = glm::radians(cfg.SpreadAngle);
+
+    f32** s = m_Streams;
+    for (u32 n = 0; n < count; n++) {
+        u32 i = m_Alive++;
+
+        f32 theta = Random(0.0f, 6.28318f);
+        f32 phi = Random(0.0f, spreadRad);
+        f32 sp = std::sin(phi);
+        glm::vec3 velocity = (dir * std::cos(phi) + right * (sp * std::cos(theta)) + up * (sp * std::sin(theta))) *
+                             Random(cfg.MinSpeed, cfg.MaxSpeed);
+        f32 life = std::max(Random(cfg.MinLife, cfg.MaxLife), 1e-4f);
+        f32 size = Random(cfg.MinSize, cfg.MaxSize);
+
+        s[POS_X][i] = cfg.Position.x;
+        s[POS_Y][i] = cfg.Position.y;
+        s[POS_Z][i] = cfg.Position.z;
+        s[VEL_X][i] = velocity.x;
+        s[VEL_Y][i] = velocity.y;
+        s[VEL_Z][i] = velocity.z;
+        s[LIFE][i] = life;
+        s[INV_MAX_LIFE][i] = 1.0f / life;
+        s[BASE_SIZE][i] = size;
+        s[COLOR_R][i] = cfg.ColorStart.r;
+        s[COLOR_G][i] = cfg.ColorStart.g;
+        s[COLOR_B][i] = cfg.ColorStart.b;
+        s[ALPHA][i] = cfg.AlphaStart;
+        s[SIZE][i] = size * cfg.SizeStart;
+    }
+    return count;
+}
+
+u32 ParticleEmitter::EmitOverTime(f32 dt) {
+    m_EmitAccumulator += (f32)m_Config.EmitRate * EmitRateScale * dt;
+    u32 count = (u32)m_EmitAccumulator;
+    m_EmitAccumulator -= (f32)count;
+    return Emit(count);
+}
+
+// ── 模拟内核 ────────────────────────────────────────────────
+
+void ParticleEmitter::Simulate(f32 dt, u32 begin, u32 end) {
+    end = std::min(end, m_Alive);
+    if (begin >= end) return;
+    end = (end + 3) & ~3u;                     // 补齐到整组，尾部空位在容量内
+
+    const ParticleEmitterConfig& cfg = m_Config;
+    F4 vdt    = Set1(dt);
+    F4 zero   = Set1(0.0f);
+    F4 one    = Set1(1.0f);
+    F4 gravity = Set1(cfg.Gravity * dt);
+    F4 damping = Set1(std::max(0.0f, 1.0f - cfg.Drag * dt));
+    F4 r0 = Set1(cfg.ColorStart.r), rd = Set1(cfg.ColorEnd.r - cfg.ColorStart.r);
+    F4 g0 = Set1(cfg.ColorStart.g), gd = Set1(cfg.ColorEnd.g - cfg.ColorStart.g);
+    F4 b0 = Set1(cfg.ColorStart.b), bd = Set1(cfg.ColorEnd.b - cfg.ColorStart.b);
+    F4 a0 = Set1(cfg.AlphaStart),   ad = Set1(cfg.AlphaEnd - cfg.AlphaStart);
+    F4 s0 = Set1(cfg.SizeStart),    sd = Set1(cfg.SizeEnd - cfg.SizeStart);
+
+    f32* const* s = m_Streams;
+    for (u32 i = begin; i < end; i += 4) {
+        // 寿命与进度 t = 1 - life / maxLife，夹到 [0, 1]
+        F4 life = Sub(Load(s[LIFE] + i), vdt);
+        Store(s[LIFE] + i, life);
+        F4 t = Min(Max(Sub(one, Mul(life, Load(s[INV_MAX_LIFE] + i))), zero), one);
+
+        // 半隐式欧拉: 先速度后位置
+        F4 vx = Mul(Load(s[VEL_X] + i), damping);
+        F4 vy = Mul(Add(Load(s[VEL_Y] + i), gravity), damping);
+        F4 vz = Mul(Load(s[VEL_Z] + i), damping);
+        Store(s[VEL_X] + i, vx);
+        Store(s[VEL_Y] + i, vy);
+        Store(s[VEL_Z] + i, vz);
+        Store(s[POS_X] + i, MulAdd(vx, vdt, Load(s[POS_X] + i)));
+        Store(s[POS_Y] + i, MulAdd(vy, vdt, Load(s[POS_Y] + i)));
+        Store(s[POS_Z] + i, MulAdd(vz, vdt, Load(s[POS_Z] + i)));
+
+        // 颜色/透明度/尺寸曲线
+        Store(s[COLOR_R] + i, MulAdd(rd, t, r0));
+        Store(s[COLOR_G] + i, MulAdd(gd, t, g0));
+        Store(s[COLOR_B] + i, MulAdd(bd, t, b0));
+        Store(s[ALPHA] + i, MulAdd(ad, t, a0));
+        Store(s[SIZE] + i, Mul(Load(s[BASE_SIZE] + i), MulAdd(sd, t, s0)));
+    }
+}
+
+// ── 压缩 ────────────────────────────────────────────────────
+
+void ParticleEmitter::MoveParticle(u32 from, u32 to) {
+    for (u32 s = 0; s < STREAM_COUNT; s++) m_Streams[s][to] = m_Streams[s][from];
+}
+
+void ParticleEmitter::Compact() {
+    const f32* life = m_Streams[LIFE];
+    u32 i = 0;
+    while (i < m_Alive) {
+        if (life[i] > 0.0f) { i++; continue; }
+        // 用末尾粒子填补 (末尾粒子本帧已模拟过)，i 原地再检查一次
+        m_Alive--;
+        if (i != m_Alive) MoveParticle(m_Alive, i);
+    }
+}
+
+void ParticleEmitter::ComputeBounds() {
+    if (m_Alive == 0) {
+        m_Bounds = {glm::vec3(1e30f), glm::vec3(-1e30f)};
+        return;
+    }
+    const f32* px = m_Streams[POS_X];
+    const f32* py = m_Streams[POS_Y];
+    const f32* pz = m_Streams[POS_Z];
+
+    // 整组走 SIMD，尾部 (不足 4 个) 逐个处理，避免读到容量内的失效粒子
+    F4 minX = Set1(1e30f), minY = minX, minZ = minX;
+    F4 maxX = Set1(-1e30f), maxY = maxX, maxZ = maxX;
+    u32 groups = m_Alive & ~3u;
+    for (u32 i = 0; i < groups; i += 4) {
+        F4 x = Load(px + i), y = Load(py + i), z = Load(pz + i);
+        minX = Min(minX, x); maxX = Max(maxX, x);
+        minY = Min(minY, y); maxY = Max(maxY, y);
+        minZ = Min(minZ, z); maxZ = Max(maxZ, z);
+    }
+    alignas(16) f32 lo[3][4], hi[3][4];
+    Store(lo[0], minX); Store(lo[1], minY); Store(lo[2], minZ);
+    Store(hi[0], maxX); Store(hi[1], maxY); Store(hi[2], maxZ);
+    glm::vec3 bmin(1e30f), bmax(-1e30f);
+    for (int l = 0; l < 4; l++) {
+        bmin = glm::min(bmin, glm::vec3(lo[0][l], lo[1][l], lo[2][l]));
+        bmax = glm::max(bmax, glm::vec3(hi[0][l], hi[1][l], hi[2][l]));
+    }
+    for (u32 i = groups; i < m_Alive; i++) {
+        glm::vec3 p(px[i], py[i], pz[i]);
+        bmin = glm::min(bmin, p);
+        bmax = glm::max(bmax, p);
+    }
+
+    // 公告板半边长 = 尺寸，按曲线上的最大值外扩
+    f32 margin = m_Config.MaxSize * std::max(m_Config.SizeStart, m_Config.SizeEnd);
+    m_Bounds = {bmin - glm::vec3(margin), bmax + glm::vec3(margin)};
+}
+
+void ParticleEmitter::Update(f32 dt) {
+    if (Emitting) EmitOverTime(dt);
+    Simulate(dt, 0, m_Alive);
+    Compact();
+    ComputeBounds();
+}
+
+void ParticleEmitter::WriteInstances(u32 begin, u32 end, ParticleInstance* out) const {
+    end = std::min(end, m_Alive);
+    f32* const* s = m_Streams;
+    for (u32 i = begin; i < end; i++) {
+        ParticleInstance& inst = out[i - begin];
+        inst.Position = {s[POS_X][i], s[POS_Y][i], s[POS_Z][i]};
+        inst.Size = s[SIZE][i];
+        inst.Color = {s[COLOR_R][i], s[COLOR_G][i], s[COLOR_B][i]};
+        inst.Alpha = s[ALPHA][i];
+    }
+}
+
+// ── 多发射器并行更新 ────────────────────────────────────────
+
+void ParticleEmitter::UpdateAll(ParticleEmitter* const* emitters, u32 count, f32 dt) {
+    // 发射会改变存活数，必须在切块之前串行完成。
+    // 块按发射器顺序全局编号，每个发射器记下自己的第一个块号 (不需要额外的任务数组)
+    u32 totalChunks = 0;
+    for (u32 e = 0; e < count; e++) {
+        ParticleEmitter* emitter = emitters[e];
+        if (emitter->Emitting) emitter->EmitOverTime(dt);
+        emitter->m_FirstChunk = totalChunks;
+        totalChunks += (emitter->m_Alive + SIMULATE_CHUNK - 1) / SIMULATE_CHUNK;
+    }
+
+    JobSystem::ParallelForRange(totalChunks, 1, [emitters, count, dt](u32 begin, u32 end) {
+        // 首块号 <= begin 的最后一个发射器 (没有块的发射器与下一个首块号相同，被跳过)
+        u32 e = (u32)(std::upper_bound(emitters, emitters + count, begin,
+                                       [](u32 chunk, const ParticleEmitter* em) { return chunk < em->m_FirstChunk; }) -
+                      emitters) - 1;
+        for (u32 chunk = begin; chunk < end; chunk++) {
+            while (e + 1 < count && emitters[e + 1]->m_FirstChunk <= chunk) e++;
+            ParticleEmitter* emitter = emitters[e];
+            u32 b = (chunk - emitter->m_FirstChunk) * SIMULATE_CHUNK;
+            emitter->Simulate(dt, b, std::min(b + SIMULATE_CHUNK, emitter->m_Alive));
+        }
+    });
+    JobSystem::ParallelForRange(count, 1, [emitters](u32 begin, u32 end) {
+        for (u32 e = begin; e < end; e++) {
+            emitters[e]->Compact();
+            emitters[e]->ComputeBounds();
+        }
+    });
+}
+
+// ── 剔除 / LOD / 排序 ───────────────────────────────────────
+
+f32 ParticleLODSettings::EmitRateScale(f32 distance) const {
+    if (CullDistance > 0.0f && distance > CullDistance) return 0.0f;
+    if (distance <= FullRateDistance || CullDistance <= FullRateDistance) return 1.0f;
+    f32 t = (distance - FullRateDistance) / (CullDistance - FullRateDistance);
+    return 1.0f + (MinRateScale - 1.0f) * std::min(t, 1.0f);
+}
+
+void ParticleDrawList::Build(ParticleEmitter* const* emitters, u32 count, const glm::mat4& viewProjection,
+                             const glm::vec3& cameraPosition, const ParticleLODSettings& settings) {
+    m_Additive.clear();
+    m_Blended.clear();
+    m_WriteTasks.clear();
+    m_Stats = {};
+
+    Frustum frustum;
+    frustum.ExtractFromVP(viewProjection);
+    for (u32 e = 0; e < count; e++) {
+        const ParticleEmitter* emitter = emitters[e];
+        if (emitter->GetAliveCount() == 0) continue;
+        const AABB& bounds = emitter->GetBounds();
+        f32 distance = glm::length(glm::clamp(cameraPosition, bounds.Min, bounds.Max) - cameraPosition);
+        if ((settings.CullDistance > 0.0f && distance > settings.CullDistance) || !frustum.IsAABBVisible(bounds)) {
+            m_Stats.CulledEmitters++;
+            continue;
+        }
+        m_Stats.VisibleEmitters++;
+        (emitter->GetConfig().AlphaBlend ? m_Blended : m_Additive).push_back(emitter);
+    }
+
+    // 叠加混合在前，alpha 混合在后；各发射器的存活区间按块并行写入预先算好的位置
+    u32 total = 0;
+    auto addTasks = [&](const std::vector<const ParticleEmitter*>& list) {
+        for (const ParticleEmitter* emitter : list) {
+            u32 alive = emitter->GetAliveCount();
+            for (u32 b = 0; b < alive; b += ParticleEmitter::SIMULATE_CHUNK) {
+                u32 end = std::min(b + ParticleEmitter::SIMULATE_CHUNK, alive);
+                m_WriteTasks.push_back({emitter, b, end, total});
+                total += end - b;
+            }
+        }
+    };
+    addTasks(m_Additive);
+    m_AdditiveCount = total;
+    addTasks(m_Blended);
+
+    m_Instances.resize(total);
+    ParticleInstance* out = m_Instances.data();
+    const WriteTask* tasks = m_WriteTasks.data();
+    JobSystem::ParallelForRange((u32)m_WriteTasks.size(), 1, [out, tasks](u32 begin, u32 end) {
+        for (u32 t = begin; t < end; t++) {
+            tasks[t].Emitter->WriteInstances(tasks[t].Begin, tasks[t].End, out + tasks[t].Offset);
+        }
+    });
+
+    if (settings.SortAlphaBlended && total - m_AdditiveCount > 1) SortBackToFront(viewProjection);
+
+    m_Stats.DrawnParticles = total;
+    m_Stats.UploadBytes = total * (u32)sizeof(ParticleInstance);
+    m_Stats.DrawCalls = (m_AdditiveCount > 0 ? 1 : 0) + (total > m_AdditiveCount ? 1 : 0);
+}
+
+void ParticleDrawList::SortBackToFront(const glm::mat4& viewProjection) {
+    u32 first = m_AdditiveCount;
+    u32 n = (u32)m_Instances.size() - first;
+    m_SortKeys.resize(n);
+    m_SortIndices.resize(n);
+    m_Scratch.resize(n);
+
+    // 视深 = 裁剪空间 w，量化到 16 位: 最远为 0，排序后从远到近
+    glm::vec4 wRow(viewProjection[0][3], viewProjection[1][3], viewProjection[2][3], viewProjection[3][3]);
+    const ParticleInstance* src = m_Instances.data() + first;
+    f32* depth = reinterpret_cast<f32*>(m_Scratch.data());   // 暂借 scratch 存浮点深度
+    f32 minDepth = 1e30f, maxDepth = -1e30f;
+    for (u32 i = 0; i < n; i++) {
+        const glm::vec3& p = src[i].Position;
+        f32 d = wRow.x * p.x + wRow.y * p.y + wRow.z * p.z + wRow.w;
+        depth[i] = d;
+        minDepth = std::min(minDepth, d);
+        maxDepth = std::max(maxDepth, d);
+    }
+    f32 scale = maxDepth > minDepth ? 65535.0f / (maxDepth - minDepth) : 0.0f;
+    u32* keys = m_SortKeys.data();
+    u32* indices = m_SortIndices.data();
+    JobSystem::ParallelForRange(n, RadixSorter::PARALLEL_THRESHOLD, [=](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) {
+            keys[i] = (u32)((maxDepth - depth[i]) * scale);
+            indices[i] = i;
+        }
+    });
+
+    m_Sorter.Sort(keys, indices, n, 16);
+
+    ParticleInstance* scratch = m_Scratch.data();
+    JobSystem::ParallelForRange(n, RadixSorter::PARALLEL_THRESHOLD, [=](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) scratch[i] = src[indices[i]];
+    });
+    std::copy(m_Scratch.begin(), m_Scratch.end(), m_Instances.begin() + first);
+    m_Stats.SortedParticles = n;
+}
+
+} // namespace Engine
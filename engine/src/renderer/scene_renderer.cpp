@@ -22,12 +22,14 @@
 #include "engine/debug/debug_draw.h"
 #include "engine/debug/debug_ui.h"
 #include "engine/debug/profiler.h"
+#include "engine/debug/stat_system.h"
 
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <cmath>
 #include <vector>
 #include <array>
 
@@ -64,6 +66,7 @@ f32  SceneRenderer::s_Exposure = 1.2f;
 bool SceneRenderer::s_BloomEnabled = true;
 int  SceneRenderer::s_GBufDebugMode = 0;
 SceneFrameStats SceneRenderer::s_FrameStats = {};
+SceneCullResults SceneRenderer::s_CullResults = {};
 
 // ── 初始化 ──────────────────────────────────────────────────
 
@@ -491,7 +494,12 @@ void SceneRenderer::ForwardPass(Scene& scene, PerspectiveCamera& camera) {
     // 粒子
     ParticleSystem::Draw(
         glm::value_ptr(camera.GetViewProjectionMatrix()),
-        camera.GetRight(), camera.GetUp());
+        camera.GetPosition(), camera.GetRight(), camera.GetUp());
+    {
+        const ParticleDrawStats& ps = ParticleSystem::GetDrawStats();
+        StatOverlay::RecordParticles(ps.VisibleEmitters, ps.CulledEmitters, ps.DrawnParticles,
+                                     ps.SortedParticles, ps.UploadBytes);
+    }
 
     // 调试线框
     DebugDraw::Flush(glm::value_ptr(camera.GetViewProjectionMatrix()));
@@ -526,6 +534,12 @@ void SceneRenderer::RenderEntitiesDeferred(Scene& scene, PerspectiveCamera& came
     Frustum frustum;
     frustum.ExtractFromVP(camera.GetViewProjectionMatrix());
 
+    // 记录本帧剔除信息 (动画 LOD 下一帧使用)
+    s_CullResults.ViewFrustum = frustum;
+    s_CullResults.CameraPosition = camera.GetPosition();
+    s_CullResults.ProjectionScale = (f32)s_Height / (2.0f * std::tan(glm::radians(camera.GetFOV()) * 0.5f));
+    s_CullResults.FrameIndex++;
+
     // ── 批处理路径 (实例化 G-Buffer Shader) ─────────────────
     BatchRenderer::ResetStats();
     BatchRenderer::Begin(s_GBufInstancedShader.get());
@@ -765,4 +779,8 @@ const SceneFrameStats& SceneRenderer::GetFrameStats() {
     return s_FrameStats;
 }
 
+const SceneCullResults& SceneRenderer::GetCullResults() {
+    return s_CullResults;
+}
+
 } // namespace Engine
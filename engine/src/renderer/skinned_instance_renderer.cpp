@@ -0,0 +1,240 @@
+#include "engine/renderer/skinned_instance_renderer.h"
+#include "engine/core/log.h"
+
+#include <glad/glad.h>
+
+#include <algorithm>
+
+namespace Engine {
+
+// ── 静态成员 ────────────────────────────────────────────────
+
+SkinnedInstanceConfig SkinnedInstanceRenderer::s_Config;
+bool SkinnedInstanceRenderer::s_Initialized = false;
+BonePaletteBuffer SkinnedInstanceRenderer::s_Palette;
+u32 SkinnedInstanceRenderer::s_PaletteTexture = 0;
+std::vector<u32>   SkinnedInstanceRenderer::s_RingBuffers;
+std::vector<void*> SkinnedInstanceRenderer::s_RingFences;
+u32 SkinnedInstanceRenderer::s_RingIndex = 0;
+bool SkinnedInstanceRenderer::s_Mapped = false;
+u32 SkinnedInstanceRenderer::s_UploadedBones = 0;
+u32 SkinnedInstanceRenderer::s_InstanceVBO = 0;
+std::vector<SkinnedInstanceData> SkinnedInstanceRenderer::s_Instances;
+Mesh* SkinnedInstanceRenderer::s_CurrentMesh = nullptr;
+Shader* SkinnedInstanceRenderer::s_CurrentShader = nullptr;
+u32 SkinnedInstanceRenderer::s_DrawCalls = 0;
+u32 SkinnedInstanceRenderer::s_TotalInstances = 0;
+
+namespace {
+
+constexpr u32 TEXELS_PER_BONE = 3;   // AffineTransform 的 3 行
+constexpr GLuint64 FENCE_TIMEOUT_NS = 1000000000ull;
+
+u32 PaletteRows(u32 bones) {
+    u32 texels = bones * TEXELS_PER_BONE;
+    return (texels + SkinnedInstanceRenderer::PALETTE_TEXTURE_WIDTH - 1) /
+           SkinnedInstanceRenderer::PALETTE_TEXTURE_WIDTH;
+}
+
+} // namespace
+
+// ── 初始化 ──────────────────────────────────────────────────
+
+void SkinnedInstanceRenderer::Init(const SkinnedInstanceConfig& config) {
+    if (s_Initialized) return;
+    s_Config = config;
+    s_Config.RingSize = std::max(s_Config.RingSize, 1u);
+
+    // 调色板纹理按整行分配，PBO 与纹理同尺寸
+    u32 rows = PaletteRows(s_Config.MaxPaletteBones);
+    GLsizeiptr ringBytes = (GLsizeiptr)rows * PALETTE_TEXTURE_WIDTH * 4 * sizeof(f32);
+
+    glGenTextures(1, &s_PaletteTexture);
+    glBindTexture(GL_TEXTURE_2D, s_PaletteTexture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, PALETTE_TEXTURE_WIDTH, rows, 0, GL_RGBA, GL_FLOAT, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    s_RingBuffers.resize(s_Config.RingSize);
+    s_RingFences.assign(s_Config.RingSize, nullptr);
+    glGenBuffers((GLsizei)s_RingBuffers.size(), s_RingBuffers.data());
+    for (u32 pbo : s_RingBuffers) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, ringBytes, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    glGenBuffers(1, &s_InstanceVBO);
+    glBindBuffer(GL_ARRAY_BUFFER, s_InstanceVBO);
+    glBufferData(GL_ARRAY_BUFFER, s_Config.MaxInstances * sizeof(SkinnedInstanceData), nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    s_Instances.reserve(s_Config.MaxInstances);
+
+    s_RingIndex = 0;
+    s_Mapped = false;
+    s_Initialized = true;
+    LOG_INFO("[SkinnedInstanceRenderer] 初始化完成: 调色板 %u 骨骼 × %u 段, 最大 %u 实例/批",
+             s_Config.MaxPaletteBones, s_Config.RingSize, s_Config.MaxInstances);
+}
+
+void SkinnedInstanceRenderer::Shutdown() {
+    if (!s_Initialized) return;
+    if (s_Mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_RingBuffers[s_RingIndex]);
+        glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        s_Mapped = false;
+    }
+    s_Palette.SetExternalStorage(nullptr, 0);
+
+    for (void* fence : s_RingFences) {
+        if (fence) glDeleteSync((GLsync)fence);
+    }
+    s_RingFences.clear();
+    glDeleteBuffers((GLsizei)s_RingBuffers.size(), s_RingBuffers.data());
+    s_RingBuffers.clear();
+    if (s_PaletteTexture) { glDeleteTextures(1, &s_PaletteTexture); s_PaletteTexture = 0; }
+    if (s_InstanceVBO) { glDeleteBuffers(1, &s_InstanceVBO); s_InstanceVBO = 0; }
+    s_Instances.clear();
+    s_CurrentMesh = nullptr;
+    s_CurrentShader = nullptr;
+    s_Initialized = false;
+}
+
+// ── 调色板上传环 ────────────────────────────────────────────
+
+void SkinnedInstanceRenderer::BeginFrame() {
+    if (!s_Initialized || s_Mapped) return;
+
+    // 本分段上次的拷贝若 GPU 仍未完成则等待 (RingSize 帧前提交，通常已完成)
+    u32 slot = s_RingIndex;
+    GLsync fence = (GLsync)s_RingFences[slot];
+    if (fence) {
+        if (glClientWaitSync(fence, 0, FENCE_TIMEOUT_NS) == GL_TIMEOUT_EXPIRED) {
+            LOG_WARN("[SkinnedInstanceRenderer] 调色板分段 %u 等待超时", slot);
+        }
+        glDeleteSync(fence);
+        s_RingFences[slot] = nullptr;
+    }
+
+    u32 rows = PaletteRows(s_Config.MaxPaletteBones);
+    GLsizeiptr bytes = (GLsizeiptr)rows * PALETTE_TEXTURE_WIDTH * 4 * sizeof(f32);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_RingBuffers[slot]);
+    void* mapped = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, bytes,
+                                    GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    if (!mapped) {
+        // 退回内部数组: 本帧调色板不上传，蒙皮实例沿用上一帧纹理 (姿势可能错位一帧)
+        LOG_ERROR("[SkinnedInstanceRenderer] 调色板 PBO 映射失败");
+        s_Palette.SetExternalStorage(nullptr, 0);
+        return;
+    }
+    s_Palette.SetExternalStorage((AffineTransform*)mapped, s_Config.MaxPaletteBones);
+    s_Mapped = true;
+}
+
+void SkinnedInstanceRenderer::UploadPalette() {
+    if (!s_Initialized || !s_Mapped) return;
+
+    u32 slot = s_RingIndex;
+    u32 used = s_Palette.GetUsed();
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, s_RingBuffers[slot]);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    s_Mapped = false;
+
+    // 只拷贝已用的整行
+    u32 rows = PaletteRows(used);
+    if (rows > 0) {
+        glBindTexture(GL_TEXTURE_2D, s_PaletteTexture);
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, PALETTE_TEXTURE_WIDTH, rows, GL_RGBA, GL_FLOAT, nullptr);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        s_RingFences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    s_UploadedBones = used;
+
+    // 映射已解除: 调色板改回内部数组，偏移在本帧内仍然有效 (只用于 Submit)
+    s_Palette.SetExternalStorage(nullptr, 0);
+    s_RingIndex = (slot + 1) % (u32)s_RingBuffers.size();
+}
+
+// ── 批次管理 ────────────────────────────────────────────────
+
+void SkinnedInstanceRenderer::Begin(Mesh* mesh, Shader* shader) {
+    if (mesh && !mesh->HasSkinAttributes()) {
+        // 普通 Mesh 没有 location 5/6，着色器读到的骨骼权重全为 0
+        LOG_ERROR("[SkinnedInstanceRenderer] 网格没有骨骼属性，需由蒙皮顶点构建 (GltfMesh::MeshData)");
+        mesh = nullptr;
+    }
+    s_CurrentMesh = mesh;
+    s_CurrentShader = shader;
+    s_Instances.clear();
+}
+
+void SkinnedInstanceRenderer::Submit(const glm::mat4& model, u32 paletteOffset) {
+    if (paletteOffset == INVALID_PALETTE_OFFSET) return;
+    s_Instances.push_back({model, paletteOffset, {0, 0, 0}});
+}
+
+void SkinnedInstanceRenderer::End() {
+    if (!s_Initialized || !s_CurrentMesh || !s_CurrentShader || s_Instances.empty()) return;
+
+    s_CurrentShader->Bind();
+    glActiveTexture(GL_TEXTURE0 + PALETTE_TEXTURE_UNIT);
+    glBindTexture(GL_TEXTURE_2D, s_PaletteTexture);
+    s_CurrentShader->SetInt("uBonePalette", (i32)PALETTE_TEXTURE_UNIT);
+    s_CurrentShader->SetInt("uHasSkinning", 1);
+
+    u32 vao = s_CurrentMesh->GetVAO();
+    glBindVertexArray(vao);
+
+    constexpr u32 BASE = INSTANCE_ATTRIB_START;
+    u32 total = (u32)s_Instances.size();
+    for (u32 offset = 0; offset < total; offset += s_Config.MaxInstances) {
+        u32 batchSize = std::min(total - offset, s_Config.MaxInstances);
+
+        // 缓冲区孤立 (Buffer Orphaning) 以避免 GPU 等待
+        glBindBuffer(GL_ARRAY_BUFFER, s_InstanceVBO);
+        glBufferData(GL_ARRAY_BUFFER, s_Config.MaxInstances * sizeof(SkinnedInstanceData), nullptr, GL_DYNAMIC_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, batchSize * sizeof(SkinnedInstanceData), &s_Instances[offset]);
+
+        // Model 矩阵 → location 8~11
+        for (u32 i = 0; i < 4; i++) {
+            glEnableVertexAttribArray(BASE + i);
+            glVertexAttribPointer(BASE + i, 4, GL_FLOAT, GL_FALSE, sizeof(SkinnedInstanceData),
+                                  (void*)(sizeof(glm::vec4) * i));
+            glVertexAttribDivisor(BASE + i, 1);
+        }
+        // 调色板偏移 → location 12 (整型属性)
+        glEnableVertexAttribArray(BASE + 4);
+        glVertexAttribIPointer(BASE + 4, 1, GL_UNSIGNED_INT, sizeof(SkinnedInstanceData),
+                               (void*)offsetof(SkinnedInstanceData, PaletteOffset));
+        glVertexAttribDivisor(BASE + 4, 1);
+
+        if (s_CurrentMesh->GetIndexCount() > 0) {
+            glDrawElementsInstanced(GL_TRIANGLES, s_CurrentMesh->GetIndexCount(), GL_UNSIGNED_INT,
+                                    nullptr, (GLsizei)batchSize);
+        } else {
+            glDrawArraysInstanced(GL_TRIANGLES, 0, s_CurrentMesh->GetVertexCount(), (GLsizei)batchSize);
+        }
+        s_DrawCalls++;
+        s_TotalInstances += batchSize;
+    }
+
+    // 清理分频器
+    for (u32 loc = BASE; loc <= BASE + 4; loc++) {
+        glVertexAttribDivisor(loc, 0);
+        glDisableVertexAttribArray(loc);
+    }
+    glBindVertexArray(0);
+    glActiveTexture(GL_TEXTURE0);
+    s_Instances.clear();
+}
+
+void SkinnedInstanceRenderer::ResetStats() {
+    s_DrawCalls = 0;
+    s_TotalInstances = 0;
+}
+
+} // namespace Engine
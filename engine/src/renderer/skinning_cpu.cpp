@@ -0,0 +1,74 @@
+#include "engine/renderer/skinning_utils.h"
+#include "engine/core/simd.h"
+
+#include <cmath>
+
+// CPU 蒙皮放在单独的编译单元: 不依赖 GL，工具与无头测试可以只链接这一部分。
+
+namespace Engine {
+
+using namespace Simd;
+
+namespace {
+
+glm::vec3 TransformDirection(const glm::vec3 cof[3], f32 sign, const glm::vec3& v) {
+    glm::vec3 r = cof[0] * v.x + cof[1] * v.y + cof[2] * v.z;
+    f32 len2 = glm::dot(r, r);
+    return len2 > 0.0f ? r * (sign / std::sqrt(len2)) : v;
+}
+
+} // namespace
+
+void SkinningUtils::SkinVertices(const SkinVertex* src, u32 count,
+                                 const glm::mat4* boneMatrices, u32 boneCount,
+                                 SkinVertex* dst) {
+    for (u32 v = 0; v < count; v++) {
+        const SkinVertex& in = src[v];
+        SkinVertex out = in;
+
+        // 权重和偏离 1 时按和归一化 (同着色器)，直接折算进每个权重
+        f32 total = in.Weights[0] + in.Weights[1] + in.Weights[2] + in.Weights[3];
+        f32 scale = (total > 0.0f && std::abs(total - 1.0f) > 0.001f) ? 1.0f / total : 1.0f;
+
+        // 加权混合骨骼矩阵的 4 列 (第 4 列 w 分量不参与后续计算)
+        F4 c0 = Set1(0.0f), c1 = c0, c2 = c0, c3 = c0;
+        bool skinned = false;
+        for (int i = 0; i < 4; i++) {
+            i32 id = in.BoneIDs[i];
+            if (id < 0 || id >= (i32)boneCount || in.Weights[i] == 0.0f) continue;
+            const f32* m = &boneMatrices[id][0][0];
+            F4 w = Set1(in.Weights[i] * scale);
+            c0 = MulAdd(w, Load(m + 0), c0);
+            c1 = MulAdd(w, Load(m + 4), c1);
+            c2 = MulAdd(w, Load(m + 8), c2);
+            c3 = MulAdd(w, Load(m + 12), c3);
+            skinned = true;
+        }
+        if (!skinned) {
+            dst[v] = out;
+            continue;
+        }
+
+        // 位置: c0·x + c1·y + c2·z + c3
+        alignas(16) f32 pos[4];
+        Store(pos, MulAdd(c0, Set1(in.Position.x), MulAdd(c1, Set1(in.Position.y),
+                          MulAdd(c2, Set1(in.Position.z), c3))));
+        out.Position = {pos[0], pos[1], pos[2]};
+
+        // 方向: 上 3×3 的逆转置 = 余子式矩阵 / det，归一化后只剩 det 的符号
+        alignas(16) f32 a[4], b[4], c[4];
+        Store(a, c0);
+        Store(b, c1);
+        Store(c, c2);
+        glm::vec3 x(a[0], a[1], a[2]), y(b[0], b[1], b[2]), z(c[0], c[1], c[2]);
+        glm::vec3 cof[3] = {glm::cross(y, z), glm::cross(z, x), glm::cross(x, y)};
+        f32 sign = glm::dot(x, cof[0]) < 0.0f ? -1.0f : 1.0f;
+        out.Normal    = TransformDirection(cof, sign, in.Normal);
+        out.Tangent   = TransformDirection(cof, sign, in.Tangent);
+        out.Bitangent = TransformDirection(cof, sign, in.Bitangent);
+
+        dst[v] = out;
+    }
+}
+
+} // namespace Engine
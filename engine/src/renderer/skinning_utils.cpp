@@ -43,41 +43,17 @@ void SkinningUtils::SetupSkinningAttributes(u32 boneIDOffset, u32 weightOffset,
 
 void SkinningUtils::SetupSkinVertexVAO() {
     u32 stride = sizeof(SkinVertex);
-
-    // location = 0: aPos (vec3)
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride,
-        (void*)offsetof(SkinVertex, Position));
-
-    // location = 1: aNormal (vec3)
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride,
-        (void*)offsetof(SkinVertex, Normal));
-
-    // location = 2: aUV (vec2)
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride,
-        (void*)offsetof(SkinVertex, UV));
-
-    // location = 3: aTangent (vec3)
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, stride,
-        (void*)offsetof(SkinVertex, Tangent));
-
-    // location = 4: aBitangent (vec3)
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, stride,
-        (void*)offsetof(SkinVertex, Bitangent));
-
-    // location = 5: aBoneIDs (ivec4) — 整型属性
-    glEnableVertexAttribArray(5);
-    glVertexAttribIPointer(5, 4, GL_INT, stride,
-        (void*)offsetof(SkinVertex, BoneIDs));
-
-    // location = 6: aWeights (vec4)
-    glEnableVertexAttribArray(6);
-    glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, stride,
-        (void*)offsetof(SkinVertex, Weights));
+    for (const SkinVertexAttribute& attr : SKIN_VERTEX_LAYOUT) {
+        glEnableVertexAttribArray(attr.Location);
+        if (attr.Integer) {
+            // 骨骼索引为整型属性，不能走浮点转换
+            glVertexAttribIPointer(attr.Location, (GLint)attr.Components, GL_INT, stride,
+                                   (void*)(uintptr_t)attr.Offset);
+        } else {
+            glVertexAttribPointer(attr.Location, (GLint)attr.Components, GL_FLOAT, GL_FALSE, stride,
+                                  (void*)(uintptr_t)attr.Offset);
+        }
+    }
 }
 
 } // namespace Engine
@@ -1,13 +1,17 @@
 #include "engine/renderer/sprite_batch.h"
 #include "engine/renderer/font.h"
 #include "engine/core/application.h"
+#include "engine/core/job_system.h"
 #include "engine/core/log.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <algorithm>
 #include <cmath>
+#include <mutex>
+#include <vector>
 
 namespace Engine {
 
@@ -22,15 +26,6 @@ static void LogNoopOnce(const char* action) {
     s_Logged = true;
 }
 
-// ── 顶点结构 ────────────────────────────────────────────────
-
-struct SpriteVertex {
-    glm::vec2 Position;
-    glm::vec2 TexCoord;
-    glm::vec4 Color;
-    f32 TexIndex;  // 0 = 白色纹理 (纯色), 1~15 = 用户纹理
-};
-
 // ── 内置着色器 ──────────────────────────────────────────────
 
 static const char* s_SpriteVS = R"(
@@ -96,15 +91,28 @@ static u32 s_EBO = 0;
 static Ref<Shader> s_Shader = nullptr;
 static u32 s_WhiteTexture = 0;
 
-static SpriteVertex* s_VertexBuffer = nullptr;
-static SpriteVertex* s_VertexPtr = nullptr;
-static u32 s_QuadCount = 0;
+// 记录 / 合并
+static SpriteCommandList s_MainList;
+static std::vector<Scope<SpriteCommandList>> s_ListPool;   // AcquireList 复用，跨帧保留容量
+static u32 s_AcquiredCount = 0;
+static std::mutex s_ListMutex;
+static SpriteBatchBuilder s_Builder;
+static std::vector<const SpriteCommandList*> s_MergeLists;
+
+// 静态网格: 本帧提交的 (网格, 变换)，End 时先画
+struct StaticMeshDraw {
+    const SpriteStaticMesh* Mesh;
+    glm::mat4 Transform;
+};
+static std::vector<StaticMeshDraw> s_StaticDraws;
+
+// 顶点环: RING_SIZE 段，每段 SEGMENT_QUADS 个四边形
+static std::vector<void*> s_RingFences;   // GLsync
+static u32 s_RingIndex = 0;
+
 static u32 s_TotalQuadCount = 0;  // 累计统计
 static u32 s_DrawCalls = 0;
 
-static u32 s_TextureSlots[SpriteBatch::MAX_TEXTURE_SLOTS];
-static u32 s_TextureSlotIndex = 1; // slot 0 = 白色纹理
-
 static glm::mat4 s_Projection = glm::mat4(1.0f);
 
 // GL 状态备份 (Begin 保存, End 恢复)
@@ -112,49 +120,49 @@ static GLint s_PrevDepthTest = 0;
 static GLint s_PrevBlend = 0;
 static GLint s_PrevCullFace = 0;
 
+static constexpr u64 FENCE_TIMEOUT_NS = 100'000'000;   // 100 ms
+static constexpr size_t SEGMENT_BYTES = (size_t)SpriteBatch::SEGMENT_QUADS * 4 * sizeof(SpriteVertex);
+
 // ── 初始化 ──────────────────────────────────────────────────
 
+void SpriteBatch::BindVertexAttributes(size_t baseOffset) {
+    // Position
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
+                          (void*)(baseOffset + offsetof(SpriteVertex, Position)));
+    // TexCoord
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
+                          (void*)(baseOffset + offsetof(SpriteVertex, TexCoord)));
+    // Color
+    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
+                          (void*)(baseOffset + offsetof(SpriteVertex, Color)));
+    // TexIndex
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
+                          (void*)(baseOffset + offsetof(SpriteVertex, TexIndex)));
+}
+
 void SpriteBatch::Init() {
     if (!IsOpenGLBackend()) {
         LogNoopOnce("Init");
         return;
     }
 
-    // 顶点缓冲
-    s_VertexBuffer = new SpriteVertex[MAX_VERTICES];
-
     glGenVertexArrays(1, &s_VAO);
     glGenBuffers(1, &s_VBO);
     glGenBuffers(1, &s_EBO);
 
     glBindVertexArray(s_VAO);
 
-    // VBO (动态)
+    // VBO: RING_SIZE 段顶点环，每帧写入时不等待 GPU 读完整个缓冲
     glBindBuffer(GL_ARRAY_BUFFER, s_VBO);
-    glBufferData(GL_ARRAY_BUFFER, MAX_VERTICES * sizeof(SpriteVertex), nullptr, GL_DYNAMIC_DRAW);
-
-    // 顶点属性
-    // Position
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
-                          (void*)offsetof(SpriteVertex, Position));
-    // TexCoord
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
-                          (void*)offsetof(SpriteVertex, TexCoord));
-    // Color
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 4, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
-                          (void*)offsetof(SpriteVertex, Color));
-    // TexIndex
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex),
-                          (void*)offsetof(SpriteVertex, TexIndex));
+    glBufferData(GL_ARRAY_BUFFER, RING_SIZE * SEGMENT_BYTES, nullptr, GL_DYNAMIC_DRAW);
+    for (u32 i = 0; i < 4; i++) glEnableVertexAttribArray(i);
+    BindVertexAttributes(0);
 
-    // 索引缓冲 (预生成)
-    auto* indices = new u32[MAX_INDICES];
+    // 索引缓冲 (预生成，覆盖一整段)
+    constexpr u32 segmentIndices = SEGMENT_QUADS * 6;
+    std::vector<u32> indices(segmentIndices);
     u32 offset = 0;
-    for (u32 i = 0; i < MAX_INDICES; i += 6) {
+    for (u32 i = 0; i < segmentIndices; i += 6) {
         indices[i + 0] = offset + 0;
         indices[i + 1] = offset + 1;
         indices[i + 2] = offset + 2;
@@ -164,10 +172,11 @@ void SpriteBatch::Init() {
         offset += 4;
     }
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, MAX_INDICES * sizeof(u32), indices, GL_STATIC_DRAW);
-    delete[] indices;
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, segmentIndices * sizeof(u32), indices.data(), GL_STATIC_DRAW);
 
     glBindVertexArray(0);
+    s_RingFences.assign(RING_SIZE, nullptr);
+    s_RingIndex = 0;
 
     // 白色纹理 (1x1)
     u32 whiteData = 0xFFFFFFFF;
@@ -186,39 +195,94 @@ void SpriteBatch::Init() {
         glUniform1i(glGetUniformLocation(s_Shader->GetID(), name.c_str()), i);
     }
 
-    // 纹理槽初始化
-    s_TextureSlots[0] = s_WhiteTexture;
-    for (u32 i = 1; i < MAX_TEXTURE_SLOTS; i++) s_TextureSlots[i] = 0;
+    s_MainList.Reserve(MAX_QUADS);
 
-    LOG_INFO("[SpriteBatch] 初始化完成 (最大 %u 四边形/批次)", MAX_QUADS);
+    LOG_INFO("[SpriteBatch] 初始化完成 (顶点环 %u × %u 四边形，单批最多 %u)",
+             RING_SIZE, SEGMENT_QUADS, MAX_QUADS);
 }
 
 void SpriteBatch::Shutdown() {
     if (!IsOpenGLBackend()) return;
 
-    delete[] s_VertexBuffer;
-    s_VertexBuffer = nullptr;
-
+    for (void* fence : s_RingFences) {
+        if (fence) glDeleteSync((GLsync)fence);
+    }
+    s_RingFences.clear();
     if (s_VAO) { glDeleteVertexArrays(1, &s_VAO); s_VAO = 0; }
     if (s_VBO) { glDeleteBuffers(1, &s_VBO); s_VBO = 0; }
     if (s_EBO) { glDeleteBuffers(1, &s_EBO); s_EBO = 0; }
     if (s_WhiteTexture) { glDeleteTextures(1, &s_WhiteTexture); s_WhiteTexture = 0; }
     s_Shader.reset();
+    s_MainList = SpriteCommandList{};
+    s_ListPool.clear();
+    s_StaticDraws.clear();
+    s_AcquiredCount = 0;
     LOG_DEBUG("[SpriteBatch] 已清理");
 }
 
-// ── 开始/结束 ───────────────────────────────────────────────
+// ── 静态网格 ────────────────────────────────────────────────
 
-void SpriteBatch::Begin(u32 screenWidth, u32 screenHeight) {
-    if (!IsOpenGLBackend()) {
-        s_DrawCalls = 0;
-        s_TotalQuadCount = 0;
-        return;
+SpriteStaticMesh::~SpriteStaticMesh() {
+    if (m_VAO) glDeleteVertexArrays(1, &m_VAO);
+    if (m_VBO) glDeleteBuffers(1, &m_VBO);
+}
+
+void SpriteStaticMesh::Upload(const SpriteVertex* vertices, u32 quadCount,
+                              const std::vector<SpriteDrawBatch>& batches) {
+    if (!IsOpenGLBackend()) return;
+    // 共享索引缓冲只覆盖一段顶点环
+    if (quadCount > SpriteBatch::SEGMENT_QUADS) {
+        LOG_WARN("[SpriteBatch] 静态网格 %u 个四边形超过上限 %u，截断", quadCount, SpriteBatch::SEGMENT_QUADS);
+        quadCount = SpriteBatch::SEGMENT_QUADS;
     }
 
-    s_Projection = glm::ortho(0.0f, (f32)screenWidth, (f32)screenHeight, 0.0f, -1.0f, 1.0f);
+    m_Batches.clear();
+    for (const SpriteDrawBatch& batch : batches) {
+        if (batch.FirstQuad >= quadCount) break;
+        m_Batches.push_back(batch);
+        SpriteDrawBatch& last = m_Batches.back();
+        last.QuadCount = std::min(last.QuadCount, quadCount - last.FirstQuad);
+    }
+    m_QuadCount = quadCount;
+
+    if (!m_VAO) {
+        glGenVertexArrays(1, &m_VAO);
+        glGenBuffers(1, &m_VBO);
+        glBindVertexArray(m_VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+        for (u32 i = 0; i < 4; i++) glEnableVertexAttribArray(i);
+        SpriteBatch::BindVertexAttributes(0);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, s_EBO);
+        glBindVertexArray(0);
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, m_VBO);
+    size_t bytes = (size_t)quadCount * 4 * sizeof(SpriteVertex);
+    if (quadCount > m_CapacityQuads) {
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)bytes, vertices, GL_STATIC_DRAW);
+        m_CapacityQuads = quadCount;
+    } else if (bytes > 0) {
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)bytes, vertices);
+    }
+}
+
+// ── 开始/结束 ───────────────────────────────────────────────
+
+static void ResetLists() {
+    s_MainList.Clear();
+    s_StaticDraws.clear();
+    std::lock_guard<std::mutex> lock(s_ListMutex);
+    for (u32 i = 0; i < s_AcquiredCount; i++) s_ListPool[i]->Clear();
+    s_AcquiredCount = 0;
+}
+
+void SpriteBatch::Begin(u32 screenWidth, u32 screenHeight) {
     s_DrawCalls = 0;
     s_TotalQuadCount = 0;
+    ResetLists();
+    if (!IsOpenGLBackend()) return;
+
+    s_Projection = glm::ortho(0.0f, (f32)screenWidth, (f32)screenHeight, 0.0f, -1.0f, 1.0f);
 
     // 保存 GL 状态 (一次性, 不在每次 Flush 中重复)
     glGetIntegerv(GL_DEPTH_TEST, &s_PrevDepthTest);
@@ -229,22 +293,16 @@ void SpriteBatch::Begin(u32 screenWidth, u32 screenHeight) {
     glDisable(GL_CULL_FACE);
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    StartBatch();
-}
-
-void SpriteBatch::StartBatch() {
-    if (!IsOpenGLBackend()) return;
-
-    s_QuadCount = 0;
-    s_VertexPtr = s_VertexBuffer;
-    s_TextureSlotIndex = 1;
 }
 
 void SpriteBatch::End() {
-    if (!IsOpenGLBackend()) return;
+    if (!IsOpenGLBackend()) {
+        ResetLists();
+        return;
+    }
 
     Flush();
+    ResetLists();
 
     // 恢复 GL 状态 (一次性)
     if (s_PrevDepthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
@@ -252,37 +310,127 @@ void SpriteBatch::End() {
     if (!s_PrevBlend) glDisable(GL_BLEND);
 }
 
+void SpriteBatch::FlushStaticMeshes() {
+    if (s_StaticDraws.empty()) return;
+
+    s_Shader->Bind();
+    for (const StaticMeshDraw& draw : s_StaticDraws) {
+        const SpriteStaticMesh& mesh = *draw.Mesh;
+        if (mesh.m_QuadCount == 0 || !mesh.m_VAO) continue;
+
+        glm::mat4 mvp = s_Projection * draw.Transform;
+        s_Shader->SetMat4("uProjection", glm::value_ptr(mvp));
+        glBindVertexArray(mesh.m_VAO);
+        for (const SpriteDrawBatch& batch : mesh.m_Batches) {
+            for (u32 t = 0; t < batch.TextureCount; t++) {
+                glActiveTexture(GL_TEXTURE0 + t);
+                glBindTexture(GL_TEXTURE_2D, t == 0 ? s_WhiteTexture : batch.Textures[t]);
+            }
+            glDrawElements(GL_TRIANGLES, batch.QuadCount * 6, GL_UNSIGNED_INT,
+                           (void*)((size_t)batch.FirstQuad * 6 * sizeof(u32)));
+            s_DrawCalls++;
+        }
+        s_TotalQuadCount += mesh.m_QuadCount;
+    }
+    glBindVertexArray(0);
+}
+
 void SpriteBatch::Flush() {
     if (!IsOpenGLBackend()) return;
 
-    if (s_QuadCount == 0) return;
-
-    u32 dataSize = (u32)((u8*)s_VertexPtr - (u8*)s_VertexBuffer);
+    FlushStaticMeshes();
 
-    // 绑定纹理
-    for (u32 i = 0; i < s_TextureSlotIndex; i++) {
-        glActiveTexture(GL_TEXTURE0 + i);
-        glBindTexture(GL_TEXTURE_2D, s_TextureSlots[i]);
+    // 合并排序所有列表
+    s_MergeLists.clear();
+    s_MergeLists.push_back(&s_MainList);
+    {
+        std::lock_guard<std::mutex> lock(s_ListMutex);
+        for (u32 i = 0; i < s_AcquiredCount; i++) s_MergeLists.push_back(s_ListPool[i].get());
     }
+    s_Builder.Build(s_MergeLists.data(), (u32)s_MergeLists.size(), MAX_QUADS);
+    const auto& batches = s_Builder.GetBatches();
+    if (s_Builder.GetQuadCount() == 0) return;
 
-    // 缓冲区孤立 (Buffer Orphaning) 以避免 GPU 同步等待
-    glBindBuffer(GL_ARRAY_BUFFER, s_VBO);
-    glBufferData(GL_ARRAY_BUFFER, MAX_VERTICES * sizeof(SpriteVertex), nullptr, GL_DYNAMIC_DRAW);
-    
-    // 上传顶点
-    glBufferSubData(GL_ARRAY_BUFFER, 0, dataSize, s_VertexBuffer);
-
-    // 渲染
     s_Shader->Bind();
     s_Shader->SetMat4("uProjection", glm::value_ptr(s_Projection));
-
     glBindVertexArray(s_VAO);
-    glDrawElements(GL_TRIANGLES, s_QuadCount * 6, GL_UNSIGNED_INT, nullptr);
+    glBindBuffer(GL_ARRAY_BUFFER, s_VBO);
+
+    // 按段写入: 每段放若干完整批次，写满或写完后绘制并打 fence
+    u32 b = 0;
+    while (b < (u32)batches.size()) {
+        u32 firstQuad = batches[b].FirstQuad;
+        u32 e = b;
+        while (e < (u32)batches.size() &&
+               batches[e].FirstQuad + batches[e].QuadCount - firstQuad <= SEGMENT_QUADS) e++;
+        u32 quads = batches[e - 1].FirstQuad + batches[e - 1].QuadCount - firstQuad;
+
+        // 等待 GPU 读完本段 (RING_SIZE 帧之前的数据)
+        u32 slot = s_RingIndex;
+        if (GLsync fence = (GLsync)s_RingFences[slot]) {
+            if (glClientWaitSync(fence, 0, FENCE_TIMEOUT_NS) == GL_TIMEOUT_EXPIRED) {
+                LOG_WARN("[SpriteBatch] 顶点环等待超时 (段 %u)", slot);
+            }
+            glDeleteSync(fence);
+            s_RingFences[slot] = nullptr;
+        }
+
+        size_t segmentOffset = slot * SEGMENT_BYTES;
+        auto* mapped = (SpriteVertex*)glMapBufferRange(GL_ARRAY_BUFFER, (GLintptr)segmentOffset,
+                                                       (GLsizeiptr)(quads * 4 * sizeof(SpriteVertex)),
+                                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT |
+                                                       GL_MAP_UNSYNCHRONIZED_BIT);
+        if (!mapped) {
+            LOG_ERROR("[SpriteBatch] 顶点环映射失败，丢弃 %u 个四边形", quads);
+            break;
+        }
+        JobSystem::ParallelForRange(quads, 4096, [mapped, firstQuad](u32 begin, u32 end) {
+            s_Builder.WriteVertices(firstQuad + begin, firstQuad + end, mapped + (size_t)begin * 4);
+        });
+        glUnmapBuffer(GL_ARRAY_BUFFER);
+
+        BindVertexAttributes(segmentOffset);
+        for (u32 i = b; i < e; i++) {
+            const SpriteDrawBatch& batch = batches[i];
+            // 绑定纹理
+            for (u32 t = 0; t < batch.TextureCount; t++) {
+                glActiveTexture(GL_TEXTURE0 + t);
+                glBindTexture(GL_TEXTURE_2D, t == 0 ? s_WhiteTexture : batch.Textures[t]);
+            }
+            glDrawElements(GL_TRIANGLES, batch.QuadCount * 6, GL_UNSIGNED_INT,
+                           (void*)((size_t)(batch.FirstQuad - firstQuad) * 6 * sizeof(u32)));
+            s_DrawCalls++;
+        }
+        s_TotalQuadCount += quads;
+
+        s_RingFences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s_RingIndex = (s_RingIndex + 1) % RING_SIZE;
+        b = e;
+    }
+
+    BindVertexAttributes(0);
     glBindVertexArray(0);
+}
+
+void SpriteBatch::SetLayer(u8 layer) {
+    s_MainList.SetLayer(layer);
+}
+
+void SpriteBatch::SetLayerSortMode(u8 layer, SpriteSortMode mode) {
+    s_Builder.SetLayerSortMode(layer, mode);
+}
+
+void SpriteBatch::DrawStaticMesh(const SpriteStaticMesh& mesh, const glm::mat4& transform) {
+    if (!IsOpenGLBackend()) return;
+    s_StaticDraws.push_back({&mesh, transform});
+}
 
-    s_DrawCalls++;
-    s_TotalQuadCount += s_QuadCount;
-    StartBatch();
+SpriteCommandList& SpriteBatch::AcquireList() {
+    std::lock_guard<std::mutex> lock(s_ListMutex);
+    if (s_AcquiredCount == s_ListPool.size()) s_ListPool.push_back(CreateScope<SpriteCommandList>());
+    SpriteCommandList& list = *s_ListPool[s_AcquiredCount++];
+    list.Clear();
+    return list;
 }
 
 // ── 绘制 ────────────────────────────────────────────────────
@@ -306,71 +454,7 @@ void SpriteBatch::Draw(Ref<Texture2D> texture,
                        const glm::vec4& tint) {
     if (!IsOpenGLBackend()) return;
 
-    if (s_QuadCount >= MAX_QUADS) Flush();
-
-    // 查找或分配纹理槽位
-    f32 texIndex = 0.0f;
-    u32 texID = texture ? texture->GetID() : 0;
-    if (texID != 0) {
-        // 查找是否已绑定
-        for (u32 i = 1; i < s_TextureSlotIndex; i++) {
-            if (s_TextureSlots[i] == texID) {
-                texIndex = (f32)i;
-                break;
-            }
-        }
-        // 未找到 → 分配新槽位
-        if (texIndex == 0.0f) {
-            if (s_TextureSlotIndex >= MAX_TEXTURE_SLOTS) Flush();
-            s_TextureSlots[s_TextureSlotIndex] = texID;
-            texIndex = (f32)s_TextureSlotIndex;
-            s_TextureSlotIndex++;
-        }
-    }
-
-    // 四个角的位置 (旋转支持)
-    glm::vec2 positions[4];
-    if (std::abs(rotation) < 0.001f) {
-        // 无旋转 — 快速路径
-        positions[0] = position;                                          // 左上
-        positions[1] = {position.x + size.x, position.y};                // 右上
-        positions[2] = {position.x + size.x, position.y + size.y};       // 右下
-        positions[3] = {position.x, position.y + size.y};                // 左下
-    } else {
-        // 绕中心旋转
-        glm::vec2 center = position + size * 0.5f;
-        f32 c = cosf(rotation);
-        f32 s = sinf(rotation);
-        glm::vec2 halfSize = size * 0.5f;
-        glm::vec2 corners[4] = {
-            {-halfSize.x, -halfSize.y},
-            { halfSize.x, -halfSize.y},
-            { halfSize.x,  halfSize.y},
-            {-halfSize.x,  halfSize.y},
-        };
-        for (int i = 0; i < 4; i++) {
-            positions[i] = center + glm::vec2(
-                corners[i].x * c - corners[i].y * s,
-                corners[i].x * s + corners[i].y * c
-            );
-        }
-    }
-
-    // UV 坐标 (从 uvRect 提取子区域)
-    f32 u0 = uvRect.x, v0 = uvRect.y;
-    f32 u1 = uvRect.z, v1 = uvRect.w;
-    glm::vec2 uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
-
-    // 写入 4 个顶点
-    for (int i = 0; i < 4; i++) {
-        s_VertexPtr->Position = positions[i];
-        s_VertexPtr->TexCoord = uvs[i];
-        s_VertexPtr->Color = tint;
-        s_VertexPtr->TexIndex = texIndex;
-        s_VertexPtr++;
-    }
-
-    s_QuadCount++;
+    s_MainList.Draw(texture ? texture->GetID() : 0, position, size, uvRect, rotation, tint);
 }
 
 void SpriteBatch::DrawRect(const glm::vec2& position,
@@ -391,22 +475,7 @@ void SpriteBatch::DrawText(Font& font,
 
     if (!font.IsValid()) return;
 
-    // 查找或分配字体纹理槽位
     u32 fontTexID = font.GetTextureID();
-    f32 texIndex = 0.0f;
-    for (u32 i = 1; i < s_TextureSlotIndex; i++) {
-        if (s_TextureSlots[i] == fontTexID) {
-            texIndex = (f32)i;
-            break;
-        }
-    }
-    if (texIndex == 0.0f && fontTexID != 0) {
-        if (s_TextureSlotIndex >= MAX_TEXTURE_SLOTS) Flush();
-        s_TextureSlots[s_TextureSlotIndex] = fontTexID;
-        texIndex = (f32)s_TextureSlotIndex;
-        s_TextureSlotIndex++;
-    }
-
     f32 cursorX = position.x;
     f32 cursorY = position.y;
 
@@ -417,16 +486,6 @@ void SpriteBatch::DrawText(Font& font,
             continue;
         }
 
-        if (s_QuadCount >= MAX_QUADS) {
-            Flush();
-            // Flush 重置了纹理槽，重新分配字体纹理
-            if (fontTexID != 0) {
-                s_TextureSlots[s_TextureSlotIndex] = fontTexID;
-                texIndex = (f32)s_TextureSlotIndex;
-                s_TextureSlotIndex++;
-            }
-        }
-
         const auto& g = font.GetGlyph(c);
 
         f32 x = cursorX + g.OffsetX * scale;
@@ -434,32 +493,8 @@ void SpriteBatch::DrawText(Font& font,
         f32 w = g.Width * scale;
         f32 h = g.Height * scale;
 
-        // 4 个顶点 (左上、右上、右下、左下)
-        s_VertexPtr->Position = {x, y};
-        s_VertexPtr->TexCoord = {g.U0, g.V0};
-        s_VertexPtr->Color = color;
-        s_VertexPtr->TexIndex = texIndex;
-        s_VertexPtr++;
-
-        s_VertexPtr->Position = {x + w, y};
-        s_VertexPtr->TexCoord = {g.U1, g.V0};
-        s_VertexPtr->Color = color;
-        s_VertexPtr->TexIndex = texIndex;
-        s_VertexPtr++;
-
-        s_VertexPtr->Position = {x + w, y + h};
-        s_VertexPtr->TexCoord = {g.U1, g.V1};
-        s_VertexPtr->Color = color;
-        s_VertexPtr->TexIndex = texIndex;
-        s_VertexPtr++;
-
-        s_VertexPtr->Position = {x, y + h};
-        s_VertexPtr->TexCoord = {g.U0, g.V1};
-        s_VertexPtr->Color = color;
-        s_VertexPtr->TexIndex = texIndex;
-        s_VertexPtr++;
-
-        s_QuadCount++;
+        s_MainList.Draw(fontTexID, {x, y}, {w, h}, {g.U0, g.V0, g.U1, g.V1}, 0.0f, color);
+
         cursorX += g.Advance * scale;
     }
 }
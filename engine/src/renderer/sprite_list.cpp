@@ -0,0 +1,208 @@
+#include "engine/renderer/sprite_list.h"
+#include "engine/core/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+static constexpr u32 SPRITE_DEPTH_BITS = 12;
+static constexpr u32 SPRITE_TEXTURE_BITS = 12;
+static constexpr u32 SPRITE_MAX_QUADS_PER_LIST = 1u << 24;
+
+// ── 纹理重定向 ──────────────────────────────────────────────
+
+std::vector<SpriteTextureRemap::Entry> SpriteTextureRemap::s_Entries;
+
+void SpriteTextureRemap::Set(u32 sourceID, u32 pageID, const glm::vec4& uvRect) {
+    if (sourceID == 0 || sourceID >= MAX_TEXTURE_ID) {
+        LOG_WARN("[SpriteBatch] 纹理 ID %u 超出重定向表范围", sourceID);
+        return;
+    }
+    if (sourceID >= s_Entries.size()) s_Entries.resize(sourceID + 1);
+    s_Entries[sourceID] = {pageID, uvRect};
+}
+
+void SpriteTextureRemap::Remove(u32 sourceID) {
+    if (sourceID < s_Entries.size()) s_Entries[sourceID] = {};
+}
+
+void SpriteTextureRemap::Clear() {
+    s_Entries.clear();
+}
+
+// ── 命令列表 ────────────────────────────────────────────────
+
+void SpriteCommandList::Clear() {
+    m_Quads.clear();
+    m_TextureIDs.clear();
+    m_SortInfo.clear();
+    m_Layer = 0;
+}
+
+void SpriteCommandList::Reserve(u32 quads) {
+    m_Quads.reserve(quads);
+    m_TextureIDs.reserve(quads);
+    m_SortInfo.reserve(quads);
+}
+
+void SpriteCommandList::Draw(u32 textureID, const glm::vec2& position, const glm::vec2& size,
+                             const glm::vec4& uvRect, f32 rotation, const glm::vec4& tint, f32 depth) {
+    glm::vec4 uv = uvRect;
+    SpriteTextureRemap::Apply(textureID, uv);
+    constexpr f32 depthScale = (f32)((1u << SPRITE_DEPTH_BITS) - 1);
+    u32 quantized = (u32)(std::clamp(depth, 0.0f, 1.0f) * depthScale + 0.5f);
+    m_Quads.push_back({position, size, uv, tint, rotation});
+    m_TextureIDs.push_back(textureID);
+    m_SortInfo.push_back(((u32)m_Layer << 24) | quantized);
+}
+
+void SpriteCommandList::Expand(const SpriteQuad& quad, f32 texIndex, SpriteVertex* out) {
+    const glm::vec2& position = quad.Position;
+    const glm::vec2& size = quad.Size;
+
+    // 四个角的位置 (旋转支持)
+    glm::vec2 positions[4];
+    if (std::abs(quad.Rotation) < 0.001f) {
+        // 无旋转 — 快速路径
+        positions[0] = position;                                          // 左上
+        positions[1] = {position.x + size.x, position.y};                // 右上
+        positions[2] = {position.x + size.x, position.y + size.y};       // 右下
+        positions[3] = {position.x, position.y + size.y};                // 左下
+    } else {
+        // 绕中心旋转
+        glm::vec2 center = position + size * 0.5f;
+        f32 c = cosf(quad.Rotation);
+        f32 s = sinf(quad.Rotation);
+        glm::vec2 halfSize = size * 0.5f;
+        glm::vec2 corners[4] = {
+            {-halfSize.x, -halfSize.y},
+            { halfSize.x, -halfSize.y},
+            { halfSize.x,  halfSize.y},
+            {-halfSize.x,  halfSize.y},
+        };
+        for (int i = 0; i < 4; i++) {
+            positions[i] = center + glm::vec2(
+                corners[i].x * c - corners[i].y * s,
+                corners[i].x * s + corners[i].y * c
+            );
+        }
+    }
+
+    // UV 坐标 (从 uvRect 提取子区域)
+    f32 u0 = quad.UV.x, v0 = quad.UV.y;
+    f32 u1 = quad.UV.z, v1 = quad.UV.w;
+    glm::vec2 uvs[4] = {{u0, v0}, {u1, v0}, {u1, v1}, {u0, v1}};
+
+    for (int i = 0; i < 4; i++) {
+        out[i].Position = positions[i];
+        out[i].TexCoord = uvs[i];
+        out[i].Color = quad.Color;
+        out[i].TexIndex = texIndex;
+    }
+}
+
+// ── 合并 / 排序 / 分批 ──────────────────────────────────────
+
+void SpriteBatchBuilder::Build(const SpriteCommandList* const* lists, u32 count, u32 maxQuadsPerBatch) {
+    if (count > MAX_LISTS) {
+        LOG_WARN("[SpriteBatch] 命令列表过多 (%u)，只合并前 %u 个", count, MAX_LISTS);
+        count = MAX_LISTS;
+    }
+    m_Lists.assign(lists, lists + count);
+    m_Batches.clear();
+
+    u32 total = 0;
+    for (const SpriteCommandList* list : m_Lists) {
+        total += std::min(list->GetQuadCount(), SPRITE_MAX_QUADS_PER_LIST);
+    }
+    m_Keys.resize(total);
+    m_Order.resize(total);
+    m_Slots.resize(total);
+    if (total == 0) return;
+
+    // 1. 生成排序键: 纹理按本帧首次出现的顺序编号 (0 = 纯色)
+    // 成员 map 跨帧复用，避免每帧堆分配
+    m_TextureRanks.clear();
+    constexpr u32 maxRank = (1u << SPRITE_TEXTURE_BITS) - 1;
+    u32 nextRank = 1;
+    u32 lastTexture = 0, lastRank = 0;
+    u32 out = 0;
+    for (u32 l = 0; l < count; l++) {
+        const SpriteCommandList* list = m_Lists[l];
+        u32 quads = std::min(list->GetQuadCount(), SPRITE_MAX_QUADS_PER_LIST);
+        for (u32 q = 0; q < quads; q++, out++) {
+            u32 info = list->GetSortInfo(q);
+            u32 layer = info >> 24;
+            u32 key = layer << 24;
+            if (m_LayerModes[layer] == SpriteSortMode::Texture) {
+                u32 texture = list->GetTextureID(q);
+                if (texture != lastTexture) {
+                    lastTexture = texture;
+                    if (texture == 0) {
+                        lastRank = 0;
+                    } else {
+                        auto [it, inserted] = m_TextureRanks.try_emplace(texture, nextRank);
+                        if (inserted) nextRank = std::min(nextRank + 1, maxRank);
+                        lastRank = it->second;
+                    }
+                }
+                key |= (lastRank << SPRITE_DEPTH_BITS) | (info & ((1u << SPRITE_DEPTH_BITS) - 1));
+            }
+            m_Keys[out] = key;
+            m_Order[out] = (l << 24) | q;
+        }
+    }
+
+    // 2. 稳定基数排序 (全部同层同键时各趟都会被跳过)
+    m_Sorter.Sort(m_Keys.data(), m_Order.data(), total, 32);
+
+    // 3. 按排序结果分批并分配纹理槽
+    maxQuadsPerBatch = std::max(maxQuadsPerBatch, 1u);
+    SpriteDrawBatch batch;
+    lastTexture = 0;
+    u32 lastSlot = 0;
+    for (u32 i = 0; i < total; i++) {
+        u32 order = m_Order[i];
+        u32 texture = m_Lists[order >> 24]->GetTextureID(order & 0xFFFFFF);
+
+        bool full = batch.QuadCount >= maxQuadsPerBatch;
+        u32 slot = 0;
+        if (texture != 0 && !full) {
+            if (texture == lastTexture) {
+                slot = lastSlot;
+            } else {
+                for (u32 s = 1; s < batch.TextureCount; s++) {
+                    if (batch.Textures[s] == texture) { slot = s; break; }
+                }
+                if (slot == 0 && batch.TextureCount >= SpriteDrawBatch::MAX_TEXTURE_SLOTS) full = true;
+            }
+        }
+        if (full) {
+            m_Batches.push_back(batch);
+            batch = SpriteDrawBatch{};
+            batch.FirstQuad = i;
+            slot = 0;
+        }
+        if (texture != 0 && slot == 0) {
+            slot = batch.TextureCount++;
+            batch.Textures[slot] = texture;
+        }
+        lastTexture = texture;
+        lastSlot = slot;
+        m_Slots[i] = (u8)slot;
+        batch.QuadCount++;
+    }
+    m_Batches.push_back(batch);
+}
+
+void SpriteBatchBuilder::WriteVertices(u32 begin, u32 end, SpriteVertex* out) const {
+    for (u32 i = begin; i < end; i++) {
+        u32 order = m_Order[i];
+        const SpriteQuad& quad = m_Lists[order >> 24]->GetQuad(order & 0xFFFFFF);
+        SpriteCommandList::Expand(quad, (f32)m_Slots[i], out);
+        out += 4;
+    }
+}
+
+} // namespace Engine
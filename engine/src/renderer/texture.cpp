@@ -5,6 +5,8 @@
 
 #include "stb_image.h"
 
+#include <algorithm>
+
 namespace Engine {
 
 // ── 纹理参数辅助 ─────────────────────────────────────────────
@@ -121,6 +123,53 @@ Texture2D::Texture2D(u32 width, u32 height, u32 channels, const void* data)
     LOG_DEBUG("纹理已创建: %ux%u (%u通道)", m_Width, m_Height, channels);
 }
 
+// ── 构造 (流式: 仅分配存储) ──────────────────────────────────
+
+Texture2D::Texture2D(u32 width, u32 height, u32 channels, u32 mipLevels)
+    : m_Width(width), m_Height(height), m_Channels(channels), m_MipLevels(mipLevels)
+{
+    if (!ResolveFormat(channels, m_InternalFormat, m_DataFormat))
+        return;
+    if (m_MipLevels == 0) m_MipLevels = 1;
+
+    glGenTextures(1, &m_ID);
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+    SetupDefaultParams();
+    glTexStorage2D(GL_TEXTURE_2D, (GLsizei)m_MipLevels, m_InternalFormat, m_Width, m_Height);
+
+    // 尚无任何层就绪: 采样范围先收窄到最粗层，随上传逐步下放
+    m_ResidentLevel = m_MipLevels - 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)m_ResidentLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)(m_MipLevels - 1));
+    ApplyAnisotropy();
+
+    LOG_DEBUG("纹理存储已分配: %ux%u (%u通道, %u mip)", m_Width, m_Height, channels, m_MipLevels);
+}
+
+// ── 构造 (BC 压缩存储) ───────────────────────────────────────
+
+Texture2D::Texture2D(u32 width, u32 height, BcFormat format, u32 mipLevels)
+    : m_Width(width), m_Height(height), m_MipLevels(mipLevels), m_Compressed(true)
+{
+    m_Channels = (format == BcFormat::BC1) ? 3 : 4;
+    m_InternalFormat = (format == BcFormat::BC1) ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+                                                 : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+    if (m_MipLevels == 0) m_MipLevels = 1;
+
+    glGenTextures(1, &m_ID);
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+    SetupDefaultParams();
+    glTexStorage2D(GL_TEXTURE_2D, (GLsizei)m_MipLevels, m_InternalFormat, m_Width, m_Height);
+
+    m_ResidentLevel = m_MipLevels - 1;
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)m_ResidentLevel);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, (GLint)(m_MipLevels - 1));
+    ApplyAnisotropy();
+
+    LOG_DEBUG("压缩纹理存储已分配: %ux%u (%s, %u mip)", m_Width, m_Height,
+              format == BcFormat::BC1 ? "BC1" : "BC3", m_MipLevels);
+}
+
 // ── 析构 / 绑定 ──────────────────────────────────────────────
 
 Texture2D::~Texture2D() {
@@ -144,6 +193,35 @@ void Texture2D::SetData(const void* data, u32 size) {
     glGenerateMipmap(GL_TEXTURE_2D);
 }
 
+void Texture2D::UploadMipRows(u32 level, u32 rowBegin, u32 rowCount, const void* pixels) {
+    if (!m_ID || m_Compressed || level >= m_MipLevels) return;
+    u32 w = std::max(1u, m_Width >> level);
+
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+    // RGB8/R8 行宽不一定是 4 的倍数
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, (GLint)level, 0, (GLint)rowBegin, (GLsizei)w, (GLsizei)rowCount,
+                    m_DataFormat, GL_UNSIGNED_BYTE, pixels);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+}
+
+void Texture2D::UploadCompressedMip(u32 level, const void* data, u32 size) {
+    if (!m_ID || !m_Compressed || level >= m_MipLevels) return;
+    u32 w = std::max(1u, m_Width >> level);
+    u32 h = std::max(1u, m_Height >> level);
+
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+    glCompressedTexSubImage2D(GL_TEXTURE_2D, (GLint)level, 0, 0, (GLsizei)w, (GLsizei)h,
+                              m_InternalFormat, (GLsizei)size, data);
+}
+
+void Texture2D::SetResidentLevel(u32 level) {
+    if (!m_ID || level >= m_MipLevels) return;
+    m_ResidentLevel = level;
+    glBindTexture(GL_TEXTURE_2D, m_ID);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, (GLint)level);
+}
+
 void Texture2D::SetFilterNearest() {
     if (!m_ID) return;
     glBindTexture(GL_TEXTURE_2D, m_ID);
@@ -0,0 +1,92 @@
+#include "engine/renderer/texture_atlas.h"
+#include "engine/renderer/font.h"
+#include "engine/renderer/sprite_list.h"
+#include "engine/core/log.h"
+
+#include "stb_image.h"
+
+#include <algorithm>
+
+namespace Engine {
+
+TextureAtlas::TextureAtlas(u32 pageSize, u32 padding, bool nearestFilter)
+    : m_Builder(pageSize, padding), m_NearestFilter(nearestFilter) {}
+
+TextureAtlas::~TextureAtlas() {
+    ClearRemap();
+}
+
+void TextureAtlas::ClearRemap() {
+    for (u32 id : m_RemappedIDs) SpriteTextureRemap::Remove(id);
+    m_RemappedIDs.clear();
+}
+
+bool TextureAtlas::AddTexture(const Ref<Texture2D>& texture, const std::string& filepath) {
+    if (!texture || !texture->IsValid()) return false;
+
+    // 与 Texture2D 相同的行序 (翻转)，统一展开为 RGBA
+    stbi_set_flip_vertically_on_load(1);
+    int width, height, channels;
+    unsigned char* data = stbi_load(filepath.c_str(), &width, &height, &channels, 4);
+    if (!data) {
+        LOG_WARN("[Atlas] 无法读取图像: %s", filepath.c_str());
+        return false;
+    }
+    if ((u32)width != texture->GetWidth() || (u32)height != texture->GetHeight()) {
+        LOG_WARN("[Atlas] 图像尺寸与纹理不符: %s", filepath.c_str());
+        stbi_image_free(data);
+        return false;
+    }
+    m_Builder.Add(texture->GetID(), data, (u32)width, (u32)height);
+    stbi_image_free(data);
+    return true;
+}
+
+void TextureAtlas::AddPixels(u32 textureID, const u8* rgba, u32 width, u32 height, u32 sourceHeight) {
+    m_Builder.Add(textureID, rgba, width, height, sourceHeight);
+}
+
+bool TextureAtlas::AddFont(const Font& font) {
+    if (!font.IsValid() || font.GetBitmap().empty()) return false;
+
+    // 与 Font 自身纹理相同: 白色 + alpha
+    u32 size = font.GetBitmapSize();
+    u32 rows = std::max(font.GetBitmapUsedRows(), 1u);
+    const std::vector<u8>& bitmap = font.GetBitmap();
+    std::vector<u8> rgba((size_t)size * rows * 4);
+    for (size_t i = 0; i < (size_t)size * rows; i++) {
+        rgba[i * 4 + 0] = 255;
+        rgba[i * 4 + 1] = 255;
+        rgba[i * 4 + 2] = 255;
+        rgba[i * 4 + 3] = bitmap[i];
+    }
+    m_Builder.Add(font.GetTextureID(), rgba.data(), size, rows, size);
+    return true;
+}
+
+bool TextureAtlas::Build() {
+    bool allPacked = m_Builder.Pack();
+
+    ClearRemap();
+    m_Pages.clear();
+    u32 pageSize = m_Builder.GetPageSize();
+    for (u32 i = 0; i < m_Builder.GetPageCount(); i++) {
+        auto page = CreateRef<Texture2D>(pageSize, pageSize, m_Builder.GetPagePixels(i).data());
+        if (m_NearestFilter) page->SetFilterNearest();
+        m_Pages.push_back(page);
+    }
+
+    for (const AtlasEntry& entry : m_Builder.GetEntries()) {
+        SpriteTextureRemap::Set(entry.Key, m_Pages[entry.Page]->GetID(), entry.UVRect);
+        m_RemappedIDs.push_back(entry.Key);
+    }
+
+    for (u32 i = 0; i < GetPageCount(); i++) {
+        LOG_INFO("[Atlas] 页 %u: %ux%u，装填率 %.1f%%", i, pageSize, pageSize,
+                 m_Builder.GetPageOccupancy(i) * 100.0f);
+    }
+    LOG_INFO("[Atlas] %zu 张纹理打包为 %u 页", m_Builder.GetEntries().size(), GetPageCount());
+    return allPacked;
+}
+
+} // namespace Engine
@@ -0,0 +1,324 @@
+#include "engine/renderer/texture_streamer.h"
+#include "engine/core/job_system.h"
+#include "engine/core/resource_manager.h"
+#include "engine/core/log.h"
+
+#include <glad/glad.h>
+
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Engine {
+
+// ── 静态成员定义 ────────────────────────────────────────────
+
+TextureStreamerConfig TextureStreamer::s_Config;
+bool TextureStreamer::s_Initialized = false;
+
+std::queue<Scope<TextureStreamer::DecodedTexture>> TextureStreamer::s_DecodedQueue;
+std::mutex       TextureStreamer::s_DecodedMutex;
+std::atomic<u32> TextureStreamer::s_InFlight{0};
+
+std::vector<Scope<TextureStreamer::StreamState>> TextureStreamer::s_Streams;
+std::unordered_map<std::string, std::vector<std::function<void(Ref<Texture2D>)>>> TextureStreamer::s_Waiters;
+std::vector<TextureStreamer::UploadCommand> TextureStreamer::s_Commands;
+
+std::vector<u32>   TextureStreamer::s_StagingBuffers;
+std::vector<void*> TextureStreamer::s_StagingFences;
+u32 TextureStreamer::s_StagingIndex = 0;
+u32 TextureStreamer::s_LastFrameBytes = 0;
+
+static constexpr u32 MIN_UPLOAD_BUDGET = 256 * 1024;
+static constexpr size_t STAGING_ALIGN  = 16;
+
+// ── 初始化 / 关闭 ───────────────────────────────────────────
+
+void TextureStreamer::Init(const TextureStreamerConfig& config) {
+    if (s_Initialized) return;
+
+    s_Config = config;
+    s_Config.UploadBudgetBytes  = std::max(s_Config.UploadBudgetBytes, MIN_UPLOAD_BUDGET);
+    s_Config.StagingBufferCount = std::max(s_Config.StagingBufferCount, 1u);
+
+    s_StagingBuffers.resize(s_Config.StagingBufferCount, 0);
+    s_StagingFences.assign(s_Config.StagingBufferCount, nullptr);
+    glGenBuffers((GLsizei)s_StagingBuffers.size(), s_StagingBuffers.data());
+    for (u32 pbo : s_StagingBuffers) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+        glBufferData(GL_PIXEL_UNPACK_BUFFER, s_Config.UploadBudgetBytes, nullptr, GL_STREAM_DRAW);
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    s_StagingIndex = 0;
+    s_LastFrameBytes = 0;
+    s_Initialized = true;
+    LOG_INFO("[TextureStreamer] 初始化完成: 预算 %u KB/帧, %u 个 PBO",
+             s_Config.UploadBudgetBytes / 1024, s_Config.StagingBufferCount);
+}
+
+void TextureStreamer::Shutdown() {
+    if (!s_Initialized) return;
+
+    // 等待所有解码任务完成
+    JobSystem::WaitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(s_DecodedMutex);
+        while (!s_DecodedQueue.empty()) s_DecodedQueue.pop();
+    }
+    s_Streams.clear();
+    s_Waiters.clear();
+    s_Commands.clear();
+
+    for (void* fence : s_StagingFences) {
+        if (fence) glDeleteSync((GLsync)fence);
+    }
+    s_StagingFences.clear();
+    if (!s_StagingBuffers.empty()) {
+        glDeleteBuffers((GLsizei)s_StagingBuffers.size(), s_StagingBuffers.data());
+        s_StagingBuffers.clear();
+    }
+
+    s_InFlight = 0;
+    s_Initialized = false;
+    LOG_INFO("[TextureStreamer] 已关闭");
+}
+
+// ── 提交请求 ────────────────────────────────────────────────
+
+void TextureStreamer::Request(const std::string& name,
+                              const std::string& filepath,
+                              std::function<void(Ref<Texture2D>)> callback) {
+    if (!s_Initialized) {
+        LOG_WARN("[TextureStreamer] 未初始化，回退到同步加载: %s", name.c_str());
+        auto tex = ResourceManager::LoadTexture(name, filepath);
+        if (callback) callback(tex);
+        return;
+    }
+
+    // 已缓存 (含已发布、仍在细化中的纹理)
+    auto cached = ResourceManager::GetTexture(name);
+    if (cached) {
+        if (callback) callback(cached);
+        return;
+    }
+
+    // 已在流送中: 合并回调
+    auto it = s_Waiters.find(name);
+    if (it != s_Waiters.end()) {
+        if (callback) it->second.push_back(std::move(callback));
+        return;
+    }
+    auto& waiters = s_Waiters[name];
+    if (callback) waiters.push_back(std::move(callback));
+
+    s_InFlight++;
+    MipFilter filter = s_Config.Filter;
+
+    JobSystem::Submit([name, filepath, filter]() {
+        // ── 工作线程: 解码 + mip 生成 ───────────────────────────
+        stbi_set_flip_vertically_on_load_thread(1);
+
+        int w, h, ch;
+        unsigned char* data = stbi_load(filepath.c_str(), &w, &h, &ch, 0);
+        if (!data) {
+            LOG_ERROR("[TextureStreamer] 纹理解码失败: %s", filepath.c_str());
+            auto failed = CreateScope<DecodedTexture>();
+            failed->Name = name;
+            failed->FilePath = filepath;
+            std::lock_guard<std::mutex> lock(s_DecodedMutex);
+            s_DecodedQueue.push(std::move(failed));
+            return;
+        }
+
+        auto decoded = CreateScope<DecodedTexture>();
+        decoded->Name = name;
+        decoded->FilePath = filepath;
+        if (!MipChain::Build(data, (u32)w, (u32)h, (u32)ch, filter, decoded->Chain)) {
+            decoded->Chain = MipChain{};
+        }
+        stbi_image_free(data);
+
+        LOG_DEBUG("[TextureStreamer] 解码完成: %s (%dx%d, %d通道, %u mip)",
+                  filepath.c_str(), w, h, ch, decoded->Chain.GetLevelCount());
+
+        std::lock_guard<std::mutex> lock(s_DecodedMutex);
+        s_DecodedQueue.push(std::move(decoded));
+    });
+}
+
+// ── 接收解码结果 ────────────────────────────────────────────
+
+void TextureStreamer::AcceptDecoded() {
+    while (true) {
+        Scope<DecodedTexture> item;
+        {
+            std::lock_guard<std::mutex> lock(s_DecodedMutex);
+            if (s_DecodedQueue.empty()) break;
+            item = std::move(s_DecodedQueue.front());
+            s_DecodedQueue.pop();
+        }
+        s_InFlight--;
+
+        const MipChain& chain = item->Chain;
+        Ref<Texture2D> tex;
+        if (chain.GetLevelCount() > 0) {
+            tex = CreateRef<Texture2D>(chain.Width, chain.Height, chain.Channels, chain.GetLevelCount());
+        }
+
+        if (!tex || !tex->IsValid()) {
+            LOG_ERROR("[TextureStreamer] 纹理创建失败: %s", item->Name.c_str());
+            auto it = s_Waiters.find(item->Name);
+            if (it != s_Waiters.end()) {
+                for (auto& cb : it->second) cb(nullptr);
+                s_Waiters.erase(it);
+            }
+            continue;
+        }
+
+        auto stream = CreateScope<StreamState>();
+        stream->Name = item->Name;
+        stream->Texture = tex;
+        stream->Chain = std::move(item->Chain);
+        stream->Level = stream->Chain.GetLevelCount() - 1;
+        stream->Row = 0;
+        s_Streams.push_back(std::move(stream));
+    }
+}
+
+// ── 首次可采样: 放入缓存并回调 ──────────────────────────────
+
+void TextureStreamer::Publish(StreamState& stream) {
+    stream.Published = true;
+    ResourceManager::CacheTexture(stream.Name, stream.Texture);
+
+    auto it = s_Waiters.find(stream.Name);
+    if (it != s_Waiters.end()) {
+        auto callbacks = std::move(it->second);
+        s_Waiters.erase(it);
+        for (auto& cb : callbacks) cb(stream.Texture);
+    }
+}
+
+// ── 每帧上传 ────────────────────────────────────────────────
+
+void TextureStreamer::Update() {
+    if (!s_Initialized) return;
+
+    s_LastFrameBytes = 0;
+    AcceptDecoded();
+    if (s_Streams.empty()) return;
+
+    // 该 PBO 上次的拷贝若 GPU 仍未消费完，本帧跳过上传 (绝不阻塞主线程)
+    u32 slot = s_StagingIndex;
+    GLsync fence = (GLsync)s_StagingFences[slot];
+    if (fence) {
+        GLenum status = glClientWaitSync(fence, 0, 0);
+        if (status == GL_TIMEOUT_EXPIRED) return;
+        glDeleteSync(fence);
+        s_StagingFences[slot] = nullptr;
+    }
+
+    // 越粗的层越优先: 所有纹理先拿到低分辨率版本，再整体向 level 0 细化
+    std::stable_sort(s_Streams.begin(), s_Streams.end(),
+        [](const Scope<StreamState>& a, const Scope<StreamState>& b) {
+            return a->Level > b->Level;
+        });
+
+    u32 pbo = s_StagingBuffers[slot];
+    size_t budget = s_Config.UploadBudgetBytes;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo);
+    u8* mapped = (u8*)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, (GLsizeiptr)budget,
+                                       GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+    if (!mapped) {
+        glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        LOG_ERROR("[TextureStreamer] PBO 映射失败");
+        return;
+    }
+
+    // ── 1. 在预算内把行数据写入 PBO ─────────────────────────
+    s_Commands.clear();
+    size_t offset = 0;
+    for (auto& streamPtr : s_Streams) {
+        StreamState& s = *streamPtr;
+        while (true) {
+            const MipLevel& lv = s.Chain.Levels[s.Level];
+            size_t rowBytes = (size_t)lv.Width * s.Chain.Channels;
+            size_t aligned = (offset + STAGING_ALIGN - 1) & ~(STAGING_ALIGN - 1);
+            if (aligned >= budget) break;
+
+            u32 rowsLeft = lv.Height - s.Row;
+            u32 rowsFit = (u32)std::min<size_t>(rowsLeft, (budget - aligned) / rowBytes);
+            if (rowsFit == 0) break;
+
+            const u8* src = s.Chain.GetLevelData(s.Level) + (size_t)s.Row * rowBytes;
+            size_t bytes = (size_t)rowsFit * rowBytes;
+            std::memcpy(mapped + aligned, src, bytes);
+
+            UploadCommand cmd;
+            cmd.Stream = &s;
+            cmd.Level = s.Level;
+            cmd.RowBegin = s.Row;
+            cmd.RowCount = rowsFit;
+            cmd.Offset = aligned;
+            cmd.LevelComplete = (rowsFit == rowsLeft);
+            s_Commands.push_back(cmd);
+
+            offset = aligned + bytes;
+            s.Row += rowsFit;
+            if (s.Row < lv.Height) break;       // 本层剩余部分留到下一帧
+            if (s.Level == 0) break;            // 全部完成
+            s.Level--;
+            s.Row = 0;
+        }
+        if (offset >= budget) break;
+    }
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+
+    // ── 2. 从 PBO 拷贝到纹理 (GPU 端异步完成) ────────────────
+    for (const auto& cmd : s_Commands) {
+        StreamState& s = *cmd.Stream;
+        s.Texture->UploadMipRows(cmd.Level, cmd.RowBegin, cmd.RowCount,
+                                 (const void*)(uintptr_t)cmd.Offset);
+        if (cmd.LevelComplete) {
+            s.Texture->SetResidentLevel(cmd.Level);
+            if (!s.Published) Publish(s);
+        }
+    }
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (!s_Commands.empty()) {
+        s_StagingFences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        s_StagingIndex = (slot + 1) % (u32)s_StagingBuffers.size();
+    }
+    s_LastFrameBytes = (u32)offset;
+
+    // ── 3. 移除已完全驻留的纹理，释放 CPU mip 数据 ──────────
+    std::erase_if(s_Streams, [](const Scope<StreamState>& s) {
+        bool done = s->Level == 0 && s->Row >= s->Chain.Levels[0].Height;
+        if (done) {
+            LOG_INFO("[TextureStreamer] 纹理流送完成: %s (%ux%u)",
+                     s->Name.c_str(), s->Chain.Width, s->Chain.Height);
+        }
+        return done;
+    });
+}
+
+// ── 状态查询 ────────────────────────────────────────────────
+
+u64 TextureStreamer::GetPendingBytes() {
+    u64 total = 0;
+    for (const auto& s : s_Streams) {
+        const MipLevel& lv = s->Chain.Levels[s->Level];
+        total += lv.Offset + (u64)(lv.Height - s->Row) * lv.Width * s->Chain.Channels;
+    }
+    return total;
+}
+
+bool TextureStreamer::IsIdle() {
+    return s_InFlight == 0 && s_Streams.empty();
+}
+
+} // namespace Engine
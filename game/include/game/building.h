@@ -92,7 +92,7 @@ public:
     void Update(ECSWorld& world, f32 dt) override;
     const char* GetName() const override { return "BuildingSystem"; }
 
-    /// 设置寻路网格 (放置建筑时同步更新)
+    /// 设置寻路网格 (放置/拆除阻挡型建筑时只改对应格子，寻路数据与流场按改动区域局部修复)
     void SetNavGrid(NavGrid* grid) { m_NavGrid = grid; }
 
     /// 进入/退出建造模式
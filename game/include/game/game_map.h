@@ -36,8 +36,11 @@ public:
     /// 程序化生成 (width × height Tile)
     void Generate(u32 width, u32 height);
 
-    /// Tilemap ↔ NavGrid 同步
+    /// Tilemap ↔ NavGrid 同步 (整张地图)
     void SyncNavGrid();
+    /// 只同步 [min, max] 矩形内的格子 (含两端)。改了少量 Tile 后调用，
+    /// NavGrid 的改动记录随之只覆盖这块区域，寻路数据和流场局部修复
+    void SyncNavGrid(const glm::ivec2& min, const glm::ivec2& max);
 
     // ── Getter ──────────────────────────────────────────
     Tilemap&       GetTilemap()  { return m_Tilemap; }
@@ -3,6 +3,8 @@
 #include "engine/core/types.h"
 #include "engine/core/ecs.h"
 #include "engine/ai/behavior_tree.h"
+#include "engine/ai/flow_field.h"
+#include "engine/ai/path_request_queue.h"
 
 #include <glm/glm.hpp>
 #include <string>
@@ -32,8 +34,9 @@ struct ZombieComponent : public Component {
     f32 BuildingDamage    = 2.0f;    // 对建筑的伤害
     u32 XPReward          = 5;       // 击杀奖励经验
 
-    // 寻路
-    std::vector<glm::vec3> Path;     // A* 路径点列表
+    // 寻路 (优先沿玩家流场移动；不在流场覆盖范围内时才用自己的 A* 路径，
+    // 路径异步求解，新路径到达前沿旧路径走；地形改动只让经过改动区域的路径提前刷新)
+    std::vector<glm::vec3> Path;     // A* 路径点列表 (世界 XZ，z 为 2D 的 Y)
     u32 PathIndex         = 0;
     f32 PathRefreshTimer  = 0.0f;    // 路径刷新计时
     f32 PathRefreshRate   = 1.0f;    // 每秒刷新一次路径
@@ -75,14 +78,29 @@ inline ZombiePreset GetZombiePreset(ZombieType type) {
 // ── 丧尸系统 ──────────────────────────────────────────────
 
 class NavGrid;  // 前向声明
+class Tilemap;
+struct TransformComponent;
 
 class ZombieSystem : public System {
 public:
     void Update(ECSWorld& world, f32 dt) override;
     const char* GetName() const override { return "ZombieSystem"; }
 
-    /// 设置寻路网格
-    void SetNavGrid(NavGrid* grid) { m_NavGrid = grid; }
+    /// 设置寻路网格 (同时作为追击流场和异步寻路队列的网格)
+    void SetNavGrid(NavGrid* grid) {
+        m_NavGrid = grid;
+        m_FlowFields.SetNavGrid(grid);
+        m_PathQueue.SetNavGrid(grid);
+    }
+
+    /// 追击流场的积分半径 (格)。仇恨中的丧尸共用以玩家为目标的一张流场
+    void SetFlowFieldRange(f32 range) { m_FlowFieldRange = range; }
+    const FlowFieldCache& GetFlowFields() const { return m_FlowFields; }
+    /// 流场覆盖不到的丧尸的 A* 请求队列 (按离玩家的距离排优先级，近的先算)
+    PathRequestQueue& GetPathQueue() { return m_PathQueue; }
+
+    /// 设置地形碰撞 (本帧移动过的丧尸在 AI 更新后一次性批量解算)
+    void SetTilemap(const Tilemap* tilemap) { m_Tilemap = tilemap; }
 
     /// 设置玩家实体 (追踪目标)
     void SetPlayerEntity(Entity player) { m_Player = player; }
@@ -92,9 +110,26 @@ public:
 
 private:
     void UpdateZombieAI(ECSWorld& world, Entity e, ZombieComponent& zombie, f32 dt);
+    /// 沿流场走一步 (已在玩家格子里则直接朝玩家走)；所在格不在流场内时返回 false
+    bool FollowFlowField(TransformComponent& tr, const ZombieComponent& zombie,
+                         const glm::vec2& playerPos, f32 dt) const;
 
     NavGrid* m_NavGrid = nullptr;
+    FlowFieldCache m_FlowFields;
+    const FlowField* m_PlayerField = nullptr;   // 本帧以玩家为目标的流场
+    f32 m_FlowFieldRange = 48.0f;
+    PathRequestQueue m_PathQueue;
+    u32 m_NavRevision = 0;                      // 上一帧看到的 NavGrid 可走性版本
+    bool m_NavChanged = false;                  // 本帧可走性是否变化
+    glm::ivec2 m_NavChangedMin = {0, 0}, m_NavChangedMax = {-1, -1};
+    const Tilemap* m_Tilemap = nullptr;
     Entity   m_Player  = INVALID_ENTITY;
+
+    // 批量碰撞的每帧临时数组 (复用容量)
+    std::vector<TransformComponent*> m_Moved;
+    std::vector<glm::vec2> m_OldPos;
+    std::vector<glm::vec2> m_NewPos;
+    std::vector<glm::vec2> m_HalfSizes;
 };
 
 // ── 丧尸刷新器 ────────────────────────────────────────────
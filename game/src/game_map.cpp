@@ -189,6 +189,8 @@ void GameMap::Generate(u32 width, u32 height) {
     // 同步 NavGrid
     m_NavGrid = NavGrid(width, height, 1.0f);
     SyncNavGrid();
+    // 生成的地图大片空旷、代价均匀: 用 JPS+ (路径仍是最短)
+    m_NavGrid.SetSearchMode(NavSearchMode::JumpPoint);
 }
 
 void GameMap::PlaceRoom(u32 x, u32 y, u32 w, u32 h) {
@@ -287,11 +289,16 @@ void GameMap::ScatterObjects() {
 }
 
 void GameMap::SyncNavGrid() {
-    u32 w = m_Tilemap.GetWidth();
-    u32 h = m_Tilemap.GetHeight();
+    SyncNavGrid({0, 0}, {(i32)m_Tilemap.GetWidth() - 1, (i32)m_Tilemap.GetHeight() - 1});
+}
+
+void GameMap::SyncNavGrid(const glm::ivec2& min, const glm::ivec2& max) {
+    u32 x0 = (u32)std::max(min.x, 0), y0 = (u32)std::max(min.y, 0);
+    u32 x1 = std::min((u32)std::max(max.x + 1, 0), m_Tilemap.GetWidth());
+    u32 y1 = std::min((u32)std::max(max.y + 1, 0), m_Tilemap.GetHeight());
 
-    for (u32 y = 0; y < h; y++) {
-        for (u32 x = 0; x < w; x++) {
+    for (u32 y = y0; y < y1; y++) {
+        for (u32 x = x0; x < x1; x++) {
             bool walkable = true;
             for (u32 layer = 0; layer < m_Tilemap.GetLayerCount(); layer++) {
                 auto& tile = m_Tilemap.GetTile(layer, x, y);
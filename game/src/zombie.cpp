@@ -1,6 +1,8 @@
 #include "game/zombie.h"
 #include "engine/ai/behavior_tree.h"
+#include "engine/game2d/collision2d.h"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 
@@ -10,17 +12,106 @@ namespace Engine {
 //  ZombieSystem
 // ════════════════════════════════════════════════════════════
 
+/// 地形碰撞盒半尺寸 (略小于实体推挤半径，Tank 仍能通过 1 格宽的门)
+static f32 GetZombieHalfSize(ZombieType type) {
+    return type == ZombieType::Tank ? 0.45f : 0.3f;
+}
+
+/// 路径从 from 开始的剩余部分是否经过改动区域 (外扩 1 格: 对角一步还依赖两侧格子)
+static bool PathCrossesRegion(const std::vector<glm::vec3>& path, u32 from, f32 cellSize,
+                              const glm::ivec2& changedMin, const glm::ivec2& changedMax) {
+    for (u32 i = from; i < path.size(); i++) {
+        i32 cx = (i32)(path[i].x / cellSize), cy = (i32)(path[i].z / cellSize);
+        if (cx >= changedMin.x - 1 && cx <= changedMax.x + 1 && cy >= changedMin.y - 1 && cy <= changedMax.y + 1) {
+            return true;
+        }
+    }
+    return false;
+}
+
 void ZombieSystem::Update(ECSWorld& world, f32 dt) {
+    // 可走性变化 (建造/拆除): 记下改动区域，只有经过它的路径需要重算
+    m_NavChanged = false;
+    if (m_NavGrid && m_NavGrid->GetRevision() != m_NavRevision) {
+        m_NavGrid->GetChangedRegion(m_NavRevision, m_NavChangedMin, m_NavChangedMax);
+        m_NavRevision = m_NavGrid->GetRevision();
+        m_NavChanged = true;
+    }
+
+    // 玩家流场: 玩家换了格子时重算，地形变化时局部修复，所有追击的丧尸共用
+    m_PlayerField = nullptr;
+    if (m_NavGrid && m_Player != INVALID_ENTITY) {
+        if (auto* ptr = world.GetComponent<TransformComponent>(m_Player)) {
+            f32 cell = m_NavGrid->GetCellSize();
+            glm::ivec2 goal = {(i32)(ptr->X / cell), (i32)(ptr->Y / cell)};
+            m_FlowFields.RequestGoal(m_Player, goal, m_FlowFieldRange);
+            m_FlowFields.Update();
+            m_PlayerField = m_FlowFields.Get(m_Player);
+        }
+    }
+
+    // 取回上一帧派发的寻路结果 (丧尸已被移除的结果直接丢弃)
+    PathResult result;
+    while (m_PathQueue.PopResult(result)) {
+        auto* zombie = world.GetComponent<ZombieComponent>((Entity)result.Owner);
+        if (!zombie) continue;
+        f32 cell = m_NavGrid ? m_NavGrid->GetCellSize() : 1.0f;
+        zombie->Path.clear();
+        for (const glm::ivec2& c : result.Cells) {
+            zombie->Path.push_back({(c.x + 0.5f) * cell, 0.0f, (c.y + 0.5f) * cell});
+        }
+        zombie->PathIndex = 0;
+
+        // 求解所用的快照之后地形又变了，且路径经过改动区域: 下次 AI 更新立即重新请求
+        glm::ivec2 changedMin, changedMax;
+        if (m_NavGrid && result.GridRevision != m_NavGrid->GetRevision()) {
+            m_NavGrid->GetChangedRegion(result.GridRevision, changedMin, changedMax);
+            if (PathCrossesRegion(zombie->Path, 0, cell, changedMin, changedMax)) zombie->PathRefreshTimer = 0.0f;
+        }
+    }
+
+    m_Moved.clear();
+    m_OldPos.clear();
+    m_NewPos.clear();
+    m_HalfSizes.clear();
+
     world.ForEach<ZombieComponent>([&](Entity e, ZombieComponent& zombie) {
+        auto* tr = world.GetComponent<TransformComponent>(e);
+        glm::vec2 before = tr ? glm::vec2(tr->X, tr->Y) : glm::vec2(0.0f);
+
         UpdateZombieAI(world, e, zombie, dt);
+
+        if (m_Tilemap && tr && (tr->X != before.x || tr->Y != before.y)) {
+            m_Moved.push_back(tr);
+            m_OldPos.push_back(before);
+            m_NewPos.push_back({tr->X, tr->Y});
+            f32 half = GetZombieHalfSize(zombie.Type);
+            m_HalfSizes.push_back({half, half});
+        }
     });
+
+    // 本帧提交的寻路请求按优先级派发到工作线程
+    m_PathQueue.Update();
+
+    // 所有移动过的丧尸一次解算地形碰撞
+    if (!m_Moved.empty()) {
+        Collision2D::MoveAndSlideBatch(*m_Tilemap, m_OldPos.data(), m_NewPos.data(),
+                                       m_HalfSizes.data(), (u32)m_Moved.size());
+        for (size_t i = 0; i < m_Moved.size(); i++) {
+            m_Moved[i]->X = m_NewPos[i].x;
+            m_Moved[i]->Y = m_NewPos[i].y;
+        }
+    }
 }
 
 void ZombieSystem::UpdateZombieAI(ECSWorld& world, Entity e,
                                    ZombieComponent& zombie, f32 dt) {
     auto* tr = world.GetComponent<TransformComponent>(e);
     auto* hp = world.GetComponent<HealthComponent>(e);
-    if (!tr || !hp || hp->Current <= 0) return;
+    if (!tr || !hp || hp->Current <= 0) {
+        m_PathQueue.Cancel(e);   // 死亡: 作废未完成的寻路
+        return;
+    }
 
     glm::vec2 zombiePos = {tr->X, tr->Y};
     glm::vec2 playerPos = {0, 0};
@@ -51,6 +142,7 @@ void ZombieSystem::UpdateZombieAI(ECSWorld& world, Entity e,
         zombie.IsAggro = false;
         zombie.Target = INVALID_ENTITY;
         zombie.Path.clear();
+        m_PathQueue.Cancel(e);
     }
 
     if (zombie.IsAggro && zombie.Target != INVALID_ENTITY) {
@@ -68,20 +160,31 @@ void ZombieSystem::UpdateZombieAI(ECSWorld& world, Entity e,
             return;  // 攻击时不移动
         }
 
-        // 3) A* 寻路追击
+        // 3) 沿玩家流场追击
+        if (FollowFlowField(*tr, zombie, playerPos, dt)) {
+            zombie.Path.clear();
+            m_PathQueue.Cancel(e);
+            return;
+        }
+
+        // 4) 流场覆盖不到 (绕路太远): 提交异步 A* 请求，离玩家越近越优先
+        if (m_NavChanged && !zombie.Path.empty() &&
+            PathCrossesRegion(zombie.Path, zombie.PathIndex, m_NavGrid->GetCellSize(), m_NavChangedMin, m_NavChangedMax)) {
+            zombie.PathRefreshTimer = 0.0f;
+        }
         zombie.PathRefreshTimer -= dt;
         if (zombie.PathRefreshTimer <= 0 && m_NavGrid) {
             zombie.PathRefreshTimer = zombie.PathRefreshRate;
-            glm::vec3 start = {zombiePos.x, zombiePos.y, 0};
-            glm::vec3 goal  = {playerPos.x, playerPos.y, 0};
-            zombie.Path = m_NavGrid->FindPath(start, goal);
-            zombie.PathIndex = 0;
+            f32 cell = m_NavGrid->GetCellSize();
+            glm::ivec2 start = {(i32)(zombiePos.x / cell), (i32)(zombiePos.y / cell)};
+            glm::ivec2 goal  = {(i32)(playerPos.x / cell), (i32)(playerPos.y / cell)};
+            m_PathQueue.Submit(e, start, goal, -distToPlayer);
         }
 
         // 沿路径移动
         if (!zombie.Path.empty() && zombie.PathIndex < zombie.Path.size()) {
             glm::vec2 target2d = {zombie.Path[zombie.PathIndex].x,
-                                   zombie.Path[zombie.PathIndex].y};
+                                   zombie.Path[zombie.PathIndex].z};
             glm::vec2 diff = target2d - zombiePos;
             f32 dist = std::sqrt(diff.x * diff.x + diff.y * diff.y);
 
@@ -105,7 +208,7 @@ void ZombieSystem::UpdateZombieAI(ECSWorld& world, Entity e,
             }
         }
     } else {
-        // 4) 游荡
+        // 5) 游荡
         zombie.WanderTimer -= dt;
         if (zombie.WanderTimer <= 0) {
             zombie.WanderTimer = 2.0f + (std::rand() % 30) * 0.1f;
@@ -120,6 +223,29 @@ void ZombieSystem::UpdateZombieAI(ECSWorld& world, Entity e,
     }
 }
 
+bool ZombieSystem::FollowFlowField(TransformComponent& tr, const ZombieComponent& zombie,
+                                   const glm::vec2& playerPos, f32 dt) const {
+    if (!m_PlayerField) return false;
+    f32 cellSize = m_NavGrid->GetCellSize();
+    i32 cx = (i32)(tr.X / cellSize), cy = (i32)(tr.Y / cellSize);
+    if (!m_PlayerField->IsReachable(cx, cy)) return false;
+
+    // 朝下一格的中心走
+    glm::ivec2 step = m_PlayerField->GetDirection(cx, cy);
+    glm::vec2 target = step == glm::ivec2(0) ? playerPos
+                                             : (glm::vec2(cx + step.x, cy + step.y) + 0.5f) * cellSize;
+    glm::vec2 diff = target - glm::vec2(tr.X, tr.Y);
+    f32 dist = std::sqrt(diff.x * diff.x + diff.y * diff.y);
+    if (dist < 1e-4f) return true;
+
+    glm::vec2 dir = diff / dist;
+    f32 move = std::min(zombie.MoveSpeed * dt, dist);
+    tr.X += dir.x * move;
+    tr.Y += dir.y * move;
+    tr.RotZ = std::atan2(dir.y, dir.x);
+    return true;
+}
+
 Entity ZombieSystem::SpawnZombie(ECSWorld& world, const glm::vec2& pos,
                                   ZombieType type) {
     auto preset = GetZombiePreset(type);
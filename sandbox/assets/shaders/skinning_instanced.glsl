@@ -0,0 +1,82 @@
+#version 450 core
+
+// ── 实例化骨骼蒙皮顶点着色器 ────────────────────────────────
+// 配合 SkinnedInstanceRenderer: 所有实例的骨骼矩阵在一张 RGBA32F 调色板纹理中，
+// 每骨骼 3 个 texel (3×4 行主序仿射矩阵)，实例属性给出调色板起始偏移。
+// 蒙皮公式与 skinning.glsl 相同 (CPU 路径 SkinningUtils::SkinVertices 亦同)
+
+// ── 顶点输入 ────────────────────────────────────────────────
+layout(location = 0) in vec3 aPos;
+layout(location = 1) in vec3 aNormal;
+layout(location = 2) in vec2 aUV;
+layout(location = 3) in vec3 aTangent;
+layout(location = 4) in vec3 aBitangent;
+layout(location = 5) in ivec4 aBoneIDs;     // 骨骼索引 (最多4个)
+layout(location = 6) in vec4  aWeights;      // 骨骼权重 (最多4个)
+
+// ── 实例输入 ────────────────────────────────────────────────
+layout(location = 8)  in mat4 aModel;        // 占 8~11
+layout(location = 12) in uint aPaletteOffset;
+
+// ── Uniforms ────────────────────────────────────────────────
+uniform mat4 uView;
+uniform mat4 uProjection;
+uniform sampler2D uBonePalette;
+uniform bool uHasSkinning;
+
+uniform mat4 uLightSpaceMatrix;              // 阴影贴图用
+
+// ── 输出到片段着色器 ────────────────────────────────────────
+out vec3 vWorldPos;
+out vec3 vNormal;
+out vec2 vUV;
+out vec3 vTangent;
+out vec3 vBitangent;
+out vec4 vLightSpacePos;
+
+mat4 FetchBone(int bone) {
+    int width = textureSize(uBonePalette, 0).x;
+    int texel = (int(aPaletteOffset) + bone) * 3;
+    vec4 r0 = texelFetch(uBonePalette, ivec2(texel % width, texel / width), 0); texel++;
+    vec4 r1 = texelFetch(uBonePalette, ivec2(texel % width, texel / width), 0); texel++;
+    vec4 r2 = texelFetch(uBonePalette, ivec2(texel % width, texel / width), 0);
+    return transpose(mat4(r0, r1, r2, vec4(0.0, 0.0, 0.0, 1.0)));
+}
+
+void main() {
+    mat4 skinMatrix = mat4(1.0);
+
+    if (uHasSkinning) {
+        skinMatrix = mat4(0.0);
+
+        // 累加骨骼变换 (最多4个骨骼影响)
+        for (int i = 0; i < 4; i++) {
+            if (aBoneIDs[i] >= 0 && aBoneIDs[i] < 128) {
+                skinMatrix += aWeights[i] * FetchBone(aBoneIDs[i]);
+            }
+        }
+
+        // 权重归一化保护
+        float totalWeight = aWeights.x + aWeights.y + aWeights.z + aWeights.w;
+        if (totalWeight > 0.0 && abs(totalWeight - 1.0) > 0.001) {
+            skinMatrix /= totalWeight;
+        }
+    }
+
+    // 最终世界空间位置
+    vec4 worldPos = aModel * skinMatrix * vec4(aPos, 1.0);
+    vWorldPos = worldPos.xyz;
+
+    // 法线变换 (使用法线矩阵)
+    mat3 normalMatrix = mat3(transpose(inverse(aModel * skinMatrix)));
+    vNormal    = normalize(normalMatrix * aNormal);
+    vTangent   = normalize(normalMatrix * aTangent);
+    vBitangent = normalize(normalMatrix * aBitangent);
+
+    vUV = aUV;
+
+    // 阴影空间坐标
+    vLightSpacePos = uLightSpaceMatrix * worldPos;
+
+    gl_Position = uProjection * uView * worldPos;
+}
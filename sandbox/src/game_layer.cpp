@@ -59,6 +59,7 @@ void GameLayer::OnAttach() {
 
     // 配置系统
     zombieSys.SetNavGrid(&m_GameMap.GetNavGrid());
+    zombieSys.SetTilemap(&m_GameMap.GetTilemap());
     buildingSys.SetNavGrid(&m_GameMap.GetNavGrid());
     timeSys.SetTimeScale(10.0f);   // 加速: 10 游戏分钟/秒
 
@@ -97,11 +98,13 @@ void GameLayer::OnAttach() {
     m_Spawner.SetWaveInterval(25.0f);
 
     // ── 加载贴图 ──────────────────────────────────────────
-    auto loadTex = [](const std::string& path) -> Ref<Texture2D> {
+    std::vector<std::pair<Ref<Texture2D>, std::string>> atlasSources;
+    auto loadTex = [&atlasSources](const std::string& path) -> Ref<Texture2D> {
         auto tex = std::make_shared<Texture2D>(path);
         if (tex->IsValid()) {
             tex->SetFilterNearest();  // Pixel Art: 最近邻采样
             LOG_INFO("[GameLayer] 加载贴图: %s (%ux%u)", path.c_str(), tex->GetWidth(), tex->GetHeight());
+            atlasSources.emplace_back(tex, path);
         } else {
             LOG_WARN("[GameLayer] 贴图加载失败: %s", path.c_str());
         }
@@ -120,6 +123,12 @@ void GameLayer::OnAttach() {
 
     m_TexWater    = loadTex("assets/textures/tiles/WaterTile.png");
 
+    // LDtk tileset 也一起打进图集
+    for (auto& [relPath, tex] : m_LdtkTilesets) {
+        if (tex && tex->IsValid()) atlasSources.emplace_back(tex, m_LdtkProject.basePath + relPath);
+    }
+    BuildSpriteAtlas(atlasSources);
+
     // ── 初始化 AutotileSet ───────────────────────────────
     m_AutoGrass     = CreateStandardAutotile(176.0f, 80.0f);
     m_AutoGrassWall = CreateStandardAutotile(176.0f, 80.0f);
@@ -130,6 +139,18 @@ void GameLayer::OnAttach() {
     LOG_INFO("[GameLayer] 丧尸生存原型启动!");
 }
 
+void GameLayer::BuildSpriteAtlas(const std::vector<std::pair<Ref<Texture2D>, std::string>>& sources) {
+    // 精灵表、tileset 共用图集页: 原有 SpriteBatch::Draw 调用自动重定向到页纹理，
+    // 同层精灵可合并为少数几次绘制
+    m_SpriteAtlas = CreateScope<TextureAtlas>(2048, 1, true);
+    for (auto& [tex, path] : sources) {
+        m_SpriteAtlas->AddTexture(tex, path);
+    }
+    if (!m_SpriteAtlas->Build()) {
+        LOG_WARN("[GameLayer] 部分贴图未能打进图集，将单独绘制");
+    }
+}
+
 void GameLayer::OnDetach() {
     m_Scene.reset();
 }
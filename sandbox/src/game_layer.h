@@ -3,6 +3,7 @@
 #include "engine/engine.h"
 #include "engine/game2d/autotile.h"
 #include "engine/game2d/ldtk_loader.h"
+#include "engine/game2d/tilemap_chunks.h"
 #include "game/game_map.h"
 #include "game/combat.h"
 #include "game/zombie.h"
@@ -49,6 +50,8 @@ private:
 
     // ── 渲染 ────────────────────────────────────────────
     void RenderTilemap();
+    /// 程序化地图区块网格的 tile 生成 (工作线程调用，只读)
+    void MeshTile(const Tilemap& tilemap, u32 layer, u32 x, u32 y, SpriteCommandList& out) const;
     void RenderLdtkMap();
     void RenderEntities();
     void RenderBuildPreview();
@@ -120,6 +123,11 @@ private:
     LdtkProject m_LdtkProject;
     std::unordered_map<std::string, Ref<Texture2D>> m_LdtkTilesets;
     bool LoadLdtkMap(const std::string& path);
+
+    // ── 精灵图集 (在所有纹理之后声明，先于它们析构) ──────
+    Scope<TextureAtlas> m_SpriteAtlas;
+    Scope<TilemapChunkCache> m_TileChunks;   // 程序化地图的区块网格
+    void BuildSpriteAtlas(const std::vector<std::pair<Ref<Texture2D>, std::string>>& sources);
 };
 
 } // namespace Engine
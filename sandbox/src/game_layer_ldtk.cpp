@@ -81,6 +81,7 @@ bool GameLayer::LoadLdtkMap(const std::string& path) {
                     }
                 }
             }
+            nav.SetSearchMode(NavSearchMode::JumpPoint);
             LOG_INFO("[LDtk] 碰撞层 '%s': %dx%d, %d 个不可行走格子",
                      layer.identifier.c_str(), navW, navH, count);
             break;
@@ -7,6 +7,9 @@
 #include "engine/core/application.h"
 #include "engine/renderer/vulkan/vulkan_context.h"
 #include "engine/renderer/sprite_batch.h"
+#include "engine/game2d/tilemap_chunks.h"
+
+#include <glm/gtc/matrix_transform.hpp>
 
 #include <glad/glad.h>
 
@@ -15,6 +18,10 @@
 
 namespace Engine {
 
+// SpriteBatch 层 (程序化地图为静态区块网格，先于这些层绘制)
+static constexpr u8 SPRITE_LAYER_MAP     = 1;   // LDtk 图层
+static constexpr u8 SPRITE_LAYER_OVERLAY = 2;   // 实体/建造预览/夜晚/HUD
+
 // ── 着色回退 ────────────────────────────────────────────────
 
 glm::vec4 GameLayer::GetTileColor(u16 tileID) {
@@ -68,6 +75,7 @@ void GameLayer::OnRender() {
     SpriteBatch::Begin(screenW, screenH);
 
     RenderTilemap();
+    SpriteBatch::SetLayer(SPRITE_LAYER_OVERLAY);
     RenderEntities();
     if (m_BuildingSys->IsInBuildMode()) RenderBuildPreview();
     if (m_TimeSys && m_TimeSys->IsNight()) RenderNightOverlay();
@@ -77,10 +85,87 @@ void GameLayer::OnRender() {
 }
 
 // ── 程序化地图渲染 ──────────────────────────────────────────
+// 地面/装饰/障碍物三层烘焙成 32×32 区块的静态网格 (TilemapChunkCache)，
+// 只有 SetTile 改过的区块才在工作线程上重建；每帧只按可见区块提交。
+// 网格坐标为 tile 单位、y 向上，由 transform 映射到屏幕。
+
+void GameLayer::MeshTile(const Tilemap& tilemap, u32 layer, u32 x, u32 y, SpriteCommandList& out) const {
+    const TileData& tile = tilemap.GetTile(layer, x, y);
+    glm::vec2 topLeft = {(f32)x, (f32)(y + 1)};
+    glm::vec2 tileSize = {1.0f, -1.0f};   // 屏幕上向下展开
+
+    if (layer == 0) {
+        // ── 地面层 — Autotile ───────────────────────────────
+        // 4-bit Bitmask: 上1 右2 下4 左8
+        u32 mapW = tilemap.GetWidth();
+        u32 mapH = tilemap.GetHeight();
+        u16 nUp    = (y > 0)        ? tilemap.GetTile(0, x, y - 1).TileID : 0;
+        u16 nRight = (x < mapW - 1) ? tilemap.GetTile(0, x + 1, y).TileID : 0;
+        u16 nDown  = (y < mapH - 1) ? tilemap.GetTile(0, x, y + 1).TileID : 0;
+        u16 nLeft  = (x > 0)        ? tilemap.GetTile(0, x - 1, y).TileID : 0;
+        u8 mask = AutotileSet::CalcBitmask(tile.TileID, nUp, nRight, nDown, nLeft);
+
+        // 选择纹理和 AutotileSet
+        Texture2D* tex = nullptr;
+        const AutotileSet* autoSet = nullptr;
+
+        switch (tile.TileID) {
+            case 1:  tex = m_TexGrass.get();     autoSet = &m_AutoGrass;  break;
+            case 2:  tex = m_TexDirt.get();      break;  // 泥土: 无 autotile
+            case 3:  tex = m_TexRockWall.get();  autoSet = &m_AutoRock;   break;
+            case 4:  tex = m_TexWater.get();     autoSet = &m_AutoWater;  break;
+            case 5:  tex = m_TexSand.get();      autoSet = &m_AutoSand;   break;
+            default: break;
+        }
+
+        if (tex && tex->IsValid() && autoSet) {
+            out.Draw(tex->GetID(), topLeft, tileSize, autoSet->GetUV(mask), 0.0f, glm::vec4(1.0f));
+        } else if (tex && tex->IsValid()) {
+            out.Draw(tex->GetID(), topLeft, tileSize, {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f, glm::vec4(1.0f));
+        } else {
+            out.Draw(0, topLeft, tileSize, {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f, GetTileColor(tile.TileID));
+        }
+    } else if (layer == 1) {
+        // ── 装饰层 — 居中的小色块 ───────────────────────────
+        glm::vec4 decorColor;
+        switch (tile.TileID) {
+            case 20: decorColor = {0.35f, 0.55f, 0.28f, 0.6f}; break;
+            case 21: decorColor = {0.85f, 0.45f, 0.55f, 0.7f}; break;
+            case 22: decorColor = {0.50f, 0.48f, 0.45f, 0.5f}; break;
+            default: decorColor = {0.5f, 0.5f, 0.5f, 0.4f}; break;
+        }
+        f32 decorScale = 0.4f;
+        f32 inset = (1.0f - decorScale) * 0.5f;
+        out.Draw(0, {topLeft.x + inset, topLeft.y - inset}, {decorScale, -decorScale},
+                 {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f, decorColor);
+    } else if (layer == 2) {
+        // ── 障碍物层 ────────────────────────────────────────
+        Texture2D* tex = nullptr;
+        glm::vec4 objUv = {0.0f, 0.0f, 1.0f, 1.0f};
+        switch (tile.TileID) {
+            case 12:
+                tex = m_TexFence.get();
+                objUv = {0.0f, 0.0f, 0.25f, 0.75f};
+                break;
+            case 13:
+                tex = m_TexRockWall.get();
+                objUv = {16.0f/176.0f, 16.0f/80.0f, 32.0f/176.0f, 32.0f/80.0f};
+                break;
+            default: break;
+        }
+
+        if (tex && tex->IsValid()) {
+            out.Draw(tex->GetID(), topLeft, tileSize, objUv, 0.0f, glm::vec4(1.0f));
+        } else {
+            out.Draw(0, topLeft, tileSize, {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f, GetTileColor(tile.TileID));
+        }
+    }
+}
 
 void GameLayer::RenderTilemap() {
     // LDtk 地图优先
     if (m_UseLdtk) {
+        SpriteBatch::SetLayer(SPRITE_LAYER_MAP);
         RenderLdtkMap();
         return;
     }
@@ -88,121 +173,30 @@ void GameLayer::RenderTilemap() {
     auto& tilemap = m_GameMap.GetTilemap();
     auto vp = GetViewport();
 
-    // 可见范围 (裁剪)
-    i32 startX = std::max(0, (i32)std::floor(vp.CamPos.x));
-    i32 startY = std::max(0, (i32)std::floor(vp.CamPos.y));
-    i32 endX = std::min((i32)tilemap.GetWidth(), (i32)std::ceil(vp.CamPos.x + vp.ViewW) + 1);
-    i32 endY = std::min((i32)tilemap.GetHeight(), (i32)std::ceil(vp.CamPos.y + vp.ViewH) + 1);
-
-    f32 tileScreenW = vp.TileScreenW;
-    f32 tileScreenH = vp.TileScreenH;
-    f32 screenH = vp.ScreenH;
-    glm::vec2 camPos = vp.CamPos;
-
-    // ── 地面层 — Autotile 渲染 ──────────────────────────────
-    i32 mapW = (i32)tilemap.GetWidth();
-    i32 mapH = (i32)tilemap.GetHeight();
-    for (i32 y = startY; y < endY; y++) {
-        for (i32 x = startX; x < endX; x++) {
-            auto& tile = tilemap.GetTile(0, x, y);
-            if (tile.TileID == 0) continue;
-
-            // 像素完美对齐
-            f32 sx = std::round((x - camPos.x) * tileScreenW);
-            f32 sy = std::round(screenH - (y - camPos.y + 1) * tileScreenH);
-            f32 tw = std::round((x + 1 - camPos.x) * tileScreenW) - sx;
-            f32 th = std::round(screenH - (y - camPos.y) * tileScreenH) - sy;
-            glm::vec2 drawPos = {sx, sy};
-            glm::vec2 drawSize = {tw, th};
-
-            // 4-bit Bitmask: 上1 右2 下4 左8
-            u16 nUp    = (y > 0)        ? tilemap.GetTile(0, x, y - 1).TileID : 0;
-            u16 nRight = (x < mapW - 1) ? tilemap.GetTile(0, x + 1, y).TileID : 0;
-            u16 nDown  = (y < mapH - 1) ? tilemap.GetTile(0, x, y + 1).TileID : 0;
-            u16 nLeft  = (x > 0)        ? tilemap.GetTile(0, x - 1, y).TileID : 0;
-            u8 mask = AutotileSet::CalcBitmask(tile.TileID, nUp, nRight, nDown, nLeft);
-
-            // 选择纹理和 AutotileSet
-            Ref<Texture2D> tex = nullptr;
-            AutotileSet* autoSet = nullptr;
-
-            switch (tile.TileID) {
-                case 1:  tex = m_TexGrass;     autoSet = &m_AutoGrass;  break;
-                case 2:  tex = m_TexDirt;      break;  // 泥土: 无 autotile
-                case 3:  tex = m_TexRockWall;  autoSet = &m_AutoRock;   break;
-                case 4:  tex = m_TexWater;     autoSet = &m_AutoWater;  break;
-                case 5:  tex = m_TexSand;      autoSet = &m_AutoSand;   break;
-                default: break;
-            }
-
-            if (tex && tex->IsValid() && autoSet) {
-                glm::vec4 uv = autoSet->GetUV(mask);
-                SpriteBatch::Draw(tex, drawPos, drawSize, uv, 0.0f);
-            } else if (tex && tex->IsValid()) {
-                SpriteBatch::Draw(tex, drawPos, drawSize,
-                                  {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f);
-            } else {
-                glm::vec4 color = GetTileColor(tile.TileID);
-                SpriteBatch::DrawRect(drawPos, drawSize, color);
-            }
-        }
+    if (!m_TileChunks) {
+        m_TileChunks = CreateScope<TilemapChunkCache>();
+        m_TileChunks->SetMesher([this](const Tilemap& map, u32 layer, u32 x, u32 y, SpriteCommandList& out) {
+            MeshTile(map, layer, x, y, out);
+        });
     }
+    m_TileChunks->Rebuild(tilemap);
+    m_TileChunks->Upload();
 
-    // ── 装饰层 (layer 1) ────────────────────────────────────
-    for (i32 y = startY; y < endY; y++) {
-        for (i32 x = startX; x < endX; x++) {
-            auto& tile = tilemap.GetTile(1, x, y);
-            if (tile.TileID == 0) continue;
-
-            f32 sx = (x - camPos.x) * tileScreenW;
-            f32 sy = screenH - (y - camPos.y + 1) * tileScreenH;
-
-            glm::vec4 decorColor;
-            switch (tile.TileID) {
-                case 20: decorColor = {0.35f, 0.55f, 0.28f, 0.6f}; break;
-                case 21: decorColor = {0.85f, 0.45f, 0.55f, 0.7f}; break;
-                case 22: decorColor = {0.50f, 0.48f, 0.45f, 0.5f}; break;
-                default: decorColor = {0.5f, 0.5f, 0.5f, 0.4f}; break;
-            }
-            f32 decorScale = 0.4f;
-            f32 dw = tileScreenW * decorScale;
-            f32 dh = tileScreenH * decorScale;
-            f32 ox = (tileScreenW - dw) * 0.5f;
-            f32 oy = (tileScreenH - dh) * 0.5f;
-            SpriteBatch::DrawRect({sx + ox, sy + oy}, {dw, dh}, decorColor);
-        }
-    }
-
-    // ── 障碍物层 (layer 2) — Y 轴排序 ──────────────────────
-    for (i32 y = startY; y < endY; y++) {
-        for (i32 x = startX; x < endX; x++) {
-            auto& tile = tilemap.GetTile(2, x, y);
-            if (tile.TileID == 0) continue;
-
-            glm::vec4 color = GetTileColor(tile.TileID);
-            f32 sx = (x - camPos.x) * tileScreenW;
-            f32 sy = screenH - (y - camPos.y + 1) * tileScreenH;
-
-            Ref<Texture2D> tex = nullptr;
-            glm::vec4 objUv = {0.0f, 0.0f, 1.0f, 1.0f};
-            switch (tile.TileID) {
-                case 12:
-                    tex = m_TexFence;
-                    objUv = {0.0f, 0.0f, 0.25f, 0.75f};
-                    break;
-                case 13:
-                    tex = m_TexRockWall;
-                    objUv = {16.0f/176.0f, 16.0f/80.0f, 32.0f/176.0f, 32.0f/80.0f};
-                    break;
-                default: break;
-            }
-
-            if (tex && tex->IsValid()) {
-                SpriteBatch::Draw(tex, {sx, sy}, {tileScreenW + 1, tileScreenH + 1}, objUv, 0.0f);
-            } else {
-                SpriteBatch::DrawRect({sx, sy}, {tileScreenW + 1, tileScreenH + 1}, color);
-            }
-        }
+    // 可见范围 (裁剪)
+    glm::ivec2 minTile = {std::max(0, (i32)std::floor(vp.CamPos.x)),
+                          std::max(0, (i32)std::floor(vp.CamPos.y))};
+    glm::ivec2 maxTile = {std::min((i32)tilemap.GetWidth() - 1, (i32)std::ceil(vp.CamPos.x + vp.ViewW)),
+                          std::min((i32)tilemap.GetHeight() - 1, (i32)std::ceil(vp.CamPos.y + vp.ViewH))};
+
+    // tile 坐标 → 屏幕像素: sx = (x - cam.x) * tileW, sy = screenH - (y - cam.y) * tileH
+    // 相机偏移对齐到整像素，保持像素风清晰
+    glm::vec2 camPx = glm::round(vp.CamPos * glm::vec2(vp.TileScreenW, vp.TileScreenH));
+    glm::mat4 transform(1.0f);
+    transform = glm::translate(transform, glm::vec3(-camPx.x, vp.ScreenH + camPx.y, 0.0f));
+    transform = glm::scale(transform, glm::vec3(vp.TileScreenW, -vp.TileScreenH, 1.0f));
+
+    for (u32 layer = 0; layer < std::min(tilemap.GetLayerCount(), 3u); layer++) {
+        m_TileChunks->Draw(layer, minTile, maxTile, transform);
     }
 }
 
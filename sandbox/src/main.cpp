@@ -8,7 +8,8 @@ int main() {
     Engine::Application app({
         .Title = "Zombie Survival",
         .Width = 1280,
-        .Height = 720
+        .Height = 720,
+        .AssetPacks = {"assets.pak"}   // tools/cook 产物，不存在时读取散文件
     });
     app.PushLayer(Engine::CreateScope<Engine::GameLayer>());
     app.Run();
@@ -0,0 +1,66 @@
+/**
+ * @file nav_test_utils.h
+ * @brief 寻路相关测试共用的网格构造与 Dijkstra 参考解
+ *
+ * test_nav_grid / test_flow_field / test_path_request_queue 共用。
+ */
+
+#pragma once
+
+#include "engine/ai/behavior_tree.h"
+
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+namespace Engine::NavTest {
+
+/// 随机障碍网格: 每格以 blockedPercent% 的概率不可走 (同一 seed 结果固定)
+inline NavGrid MakeRandomGrid(u32 w, u32 h, u32 seed, u32 blockedPercent) {
+    NavGrid grid(w, h);
+    std::mt19937 rng(seed);
+    for (u32 y = 0; y < h; y++) {
+        for (u32 x = 0; x < w; x++) grid.SetWalkable((i32)x, (i32)y, rng() % 100 >= blockedPercent);
+    }
+    return grid;
+}
+
+/// 参考解: 8 邻接、不切角的 Dijkstra，从 source 到各格的最短代价 (不可达为 -1)。
+/// 直走/斜走代价由调用方给出；stopAt 出队后提前结束 (其余格子的代价不保证最短)
+template <typename T>
+std::vector<T> ReferenceField(const NavGrid& grid, glm::ivec2 source, T straight, T diagonal,
+                              glm::ivec2 stopAt = {-1, -1}) {
+    i32 w = (i32)grid.GetWidth(), h = (i32)grid.GetHeight();
+    std::vector<T> dist((size_t)w * h, T(-1));
+    if (!grid.IsWalkable(source.x, source.y)) return dist;
+    using Item = std::pair<T, i32>;
+    std::priority_queue<Item, std::vector<Item>, std::greater<Item>> open;
+    dist[source.y * w + source.x] = T(0);
+    open.push({T(0), source.y * w + source.x});
+    while (!open.empty()) {
+        auto [d, idx] = open.top();
+        open.pop();
+        if (d > dist[idx]) continue;
+        i32 x = idx % w, y = idx / w;
+        if (x == stopAt.x && y == stopAt.y) break;
+        for (i32 dy = -1; dy <= 1; dy++) {
+            for (i32 dx = -1; dx <= 1; dx++) {
+                if ((!dx && !dy) || !grid.IsWalkable(x + dx, y + dy)) continue;
+                if (dx && dy && (!grid.IsWalkable(x + dx, y) || !grid.IsWalkable(x, y + dy))) continue;
+                T nd = d + ((dx && dy) ? diagonal : straight);
+                i32 n = (y + dy) * w + (x + dx);
+                if (dist[n] < T(0) || nd < dist[n]) { dist[n] = nd; open.push({nd, n}); }
+            }
+        }
+    }
+    return dist;
+}
+
+/// NavGrid::FindPath 的代价 (直走 1、斜走 1.414) 下 start → goal 的最短代价，不可达返回 -1
+inline f32 ReferenceCost(const NavGrid& grid, glm::ivec2 start, glm::ivec2 goal) {
+    if (!grid.IsWalkable(start.x, start.y) || !grid.IsWalkable(goal.x, goal.y)) return -1.0f;
+    return ReferenceField(grid, start, 1.0f, 1.414f, goal)[goal.y * (i32)grid.GetWidth() + goal.x];
+}
+
+} // namespace Engine::NavTest
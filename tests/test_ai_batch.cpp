@@ -0,0 +1,175 @@
+/**
+ * @file test_ai_batch.cpp
+ * @brief 批量 AI 上下文打包单元测试
+ *
+ * 测试 agent/附近实体/队友按列存放且区间正确、命令字符串去重、
+ * 玩家数据与小队概览只存一份，以及结果表初值和动作读取。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/ai_batch.h"
+
+using namespace Engine;
+using namespace Engine::AI;
+
+namespace {
+
+AIContext MakeContext(u32 id, const glm::vec3& pos, u32 enemies) {
+    AIContext ctx;
+    ctx.EntityID = id;
+    ctx.Position = pos;
+    ctx.Health = 50.0f + (f32)id;
+    ctx.CurrentState = AIState::Patrol;
+    ctx.DeltaTime = 0.05f * (f32)id;   // 距上次决策 (可跨多帧)
+    ctx.FrameDeltaTime = 0.016f;
+    for (u32 i = 0; i < enemies; i++) {
+        NearbyEntity e;
+        e.EntityID = 100 + id * 10 + i;
+        e.Position = pos + glm::vec3((f32)i + 1.0f, 0, 0);
+        e.Distance = (f32)i + 1.0f;
+        e.Health = 10.0f * (f32)(i + 1);
+        ctx.NearbyEnemies.push_back(e);
+    }
+    return ctx;
+}
+
+} // namespace
+
+TEST(AIBatchTest, PacksAgentsAndEnemiesAsColumns) {
+    AIBatch batch;
+    batch.Clear();
+    batch.Add(7, MakeContext(7, {1, 2, 3}, 2));
+    batch.Add(8, MakeContext(8, {4, 5, 6}, 0));
+    batch.Add(9, MakeContext(9, {7, 8, 9}, 3));
+    batch.Pack();
+
+    ASSERT_EQ(batch.GetCount(), 3u);
+    EXPECT_EQ(batch.GetEntity(2), 9u);
+
+    // 每列连续: 第 c 列占 [c * n, (c + 1) * n)
+    const u32 n = 3;
+    EXPECT_EQ(batch.Agents.Floats.size(), (size_t)AIBatch::Agent::FloatCount * n);
+    EXPECT_FLOAT_EQ(batch.Agents.Floats[AIBatch::Agent::PosX * n + 0], 1.0f);
+    EXPECT_FLOAT_EQ(batch.Agents.Floats[AIBatch::Agent::PosX * n + 2], 7.0f);
+    EXPECT_FLOAT_EQ(batch.Agents.Floats[AIBatch::Agent::PosZ * n + 1], 6.0f);
+    EXPECT_FLOAT_EQ(batch.Agents.F(AIBatch::Agent::Health, 1), 58.0f);
+    EXPECT_FLOAT_EQ(batch.Agents.F(AIBatch::Agent::DeltaTime, 2), 0.45f);
+    EXPECT_FLOAT_EQ(batch.Agents.F(AIBatch::Agent::FrameDeltaTime, 2), 0.016f);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::EntityID, 0), 7);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::State, 0), (i32)AIState::Patrol);
+
+    // 附近实体: 每个 agent 一段连续区间
+    EXPECT_EQ(batch.Enemies.Rows, 5u);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::EnemyBegin, 0), 0);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::EnemyCount, 0), 2);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::EnemyCount, 1), 0);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::EnemyBegin, 2), 2);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::EnemyCount, 2), 3);
+    EXPECT_EQ(batch.Enemies.I(AIBatch::Enemy::EntityID, 2), 190);
+    EXPECT_FLOAT_EQ(batch.Enemies.F(AIBatch::Enemy::Dist, 4), 3.0f);
+    EXPECT_FLOAT_EQ(batch.Enemies.F(AIBatch::Enemy::PosX, 1), 3.0f);
+}
+
+TEST(AIBatchTest, SharesOrdersPlayerAndSquads) {
+    AIBatch batch;
+    batch.Clear();
+
+    AIContext a = MakeContext(1, {}, 0);
+    a.CurrentOrder = R"({"type":"attack"})";
+    a.Role = "leader";
+    a.HasPlayerData = true;
+    a.PlayerPosition = {10, 0, 20};
+    a.PlayerAttackCount = 3;
+    AIContext::SquadSummary squad;
+    squad.SquadID = 4;
+    squad.AliveMembers = 2;
+    squad.CurrentOrder = "active";
+    a.AllSquads.push_back(squad);
+
+    AIContext b = a;
+    b.EntityID = 2;
+    AIContext c = MakeContext(3, {}, 0);
+    c.CurrentOrder = R"({"type":"hold"})";
+
+    AllyInfo ally;
+    ally.EntityID = 2;
+    ally.State = "Chase";
+    ally.Role = "soldier";
+    ally.Distance = 1.5f;
+    c.SquadMembers.push_back(ally);
+
+    batch.Add(1, a);
+    batch.Add(2, b);
+    batch.Add(3, c);
+    batch.Pack();
+
+    // 相同命令只传一份
+    ASSERT_EQ(batch.Orders.size(), 2u);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::Order, 0), 0);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::Order, 1), 0);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::Order, 2), 1);
+    EXPECT_EQ(batch.Orders[1], R"({"type":"hold"})");
+
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::Role, 0), 1);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::Role, 2), 0);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::HasPlayer, 0), 1);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::HasPlayer, 2), 0);
+    EXPECT_FLOAT_EQ(batch.PlayerData[AIBatch::Player::PosZ], 20.0f);
+    EXPECT_FLOAT_EQ(batch.PlayerData[AIBatch::Player::AttackCount], 3.0f);
+
+    // 小队概览只有一份
+    ASSERT_EQ(batch.Squads.Rows, 1u);
+    EXPECT_EQ(batch.Squads.I(AIBatch::Squad::SquadID, 0), 4);
+    EXPECT_EQ(batch.Squads.I(AIBatch::Squad::HasOrder, 0), 1);
+
+    ASSERT_EQ(batch.Allies.Rows, 1u);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::AllyBegin, 2), 0);
+    EXPECT_EQ(batch.Agents.I(AIBatch::Agent::AllyCount, 2), 1);
+    EXPECT_EQ(batch.Allies.I(AIBatch::Ally::State, 0), (i32)AIState::Chase);
+    EXPECT_FLOAT_EQ(batch.Allies.F(AIBatch::Ally::Dist, 0), 1.5f);
+
+    // Clear 后复用
+    batch.Clear();
+    batch.Add(5, MakeContext(5, {}, 1));
+    batch.Pack();
+    EXPECT_EQ(batch.GetCount(), 1u);
+    EXPECT_TRUE(batch.Orders.empty());
+    EXPECT_EQ(batch.Squads.Rows, 0u);
+    EXPECT_EQ(batch.Enemies.Rows, 1u);
+}
+
+TEST(AIBatchTest, ActionsDefaultToCurrentStateAndReadBack) {
+    AIBatch batch;
+    batch.Clear();
+    AIContext ctx = MakeContext(1, {}, 0);
+    ctx.CurrentState = AIState::Attack;
+    batch.Add(1, ctx);
+    batch.Add(2, MakeContext(2, {}, 0));
+    batch.Pack();
+
+    // 脚本没写的行: 保持当前状态、不移动
+    AIAction untouched = batch.GetAction(0);
+    EXPECT_EQ(untouched.NewState, AIState::Attack);
+    EXPECT_FLOAT_EQ(untouched.MoveSpeed, 0.0f);
+    EXPECT_TRUE(untouched.OrderForSubordinates.empty());
+
+    // 模拟 Python 写回
+    batch.Actions.I(AIBatch::Action::State, 1) = (i32)AIState::Flee;
+    batch.Actions.I(AIBatch::Action::Target, 1) = 42;
+    batch.Actions.F(AIBatch::Action::DirX, 1) = 1.0f;
+    batch.Actions.F(AIBatch::Action::Speed, 1) = 3.5f;
+    batch.SetStrings(1, "retreat", R"({"type":"regroup"})");
+    batch.SetStrings(9, "ignored", "");   // 越界行号被忽略
+
+    AIAction action = batch.GetAction(1);
+    EXPECT_EQ(action.NewState, AIState::Flee);
+    EXPECT_EQ(action.TargetEntityID, 42u);
+    EXPECT_FLOAT_EQ(action.MoveDirection.x, 1.0f);
+    EXPECT_FLOAT_EQ(action.MoveSpeed, 3.5f);
+    EXPECT_EQ(action.CustomAction, "retreat");
+    EXPECT_EQ(action.OrderForSubordinates, R"({"type":"regroup"})");
+
+    // 非法状态值回落到 Idle
+    batch.Actions.I(AIBatch::Action::State, 0) = 99;
+    EXPECT_EQ(batch.GetAction(0).NewState, AIState::Idle);
+}
@@ -0,0 +1,121 @@
+/**
+ * @file test_ai_scheduler.cpp
+ * @brief AI 思考调度单元测试
+ *
+ * 测试思考间隔随角色/距离/状态变化、首次调度相位错开、
+ * 候选按优先级截断，以及按测得耗时换算每帧配额。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/ai_scheduler.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Engine;
+using namespace Engine::AI;
+
+TEST(AISchedulerTest, IntervalDependsOnRoleDistanceAndState) {
+    AIScheduler scheduler;
+    AIScheduler::Settings s;
+    s.NearDistance = 10.0f;
+    s.FarDistance = 50.0f;
+    s.NearInterval = 0.0f;
+    s.MidInterval = 0.1f;
+    s.FarInterval = 0.4f;
+    s.IdleScale = 2.0f;
+    s.CombatMaxInterval = 0.2f;
+    s.LeaderInterval = 0.15f;
+    s.CommanderInterval = 0.5f;
+    scheduler.SetSettings(s);
+
+    // 近处每帧
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 5.0f, AIState::Chase), 0.0f);
+    // 距离分档 (Dead 不受状态影响)
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 20.0f, AIState::Dead), 0.1f);
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 80.0f, AIState::Dead), 0.4f);
+    // 闲置放慢，战斗封顶
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 80.0f, AIState::Idle), 0.8f);
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 80.0f, AIState::Patrol), 0.8f);
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 80.0f, AIState::Attack), 0.2f);
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Soldier, 20.0f, AIState::Flee), 0.1f);
+    // 指挥链按角色固定
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Leader, 80.0f, AIState::Idle), 0.15f);
+    EXPECT_FLOAT_EQ(scheduler.GetInterval(AIRole::Commander, 5.0f, AIState::Attack), 0.5f);
+}
+
+TEST(AISchedulerTest, InitialDelaySpreadsAgentsAcrossInterval) {
+    const f32 interval = 1.0f;
+    const u32 buckets = 10;
+    u32 counts[buckets] = {};
+    for (u32 id = 1; id <= 1000; id++) {
+        f32 d = AIScheduler::InitialDelay(id, interval);
+        ASSERT_GE(d, 0.0f);
+        ASSERT_LT(d, interval);
+        counts[std::min((u32)(d * buckets), buckets - 1)]++;
+    }
+    // 每个十分位都有大致 1/10 的 agent
+    for (u32 b = 0; b < buckets; b++) {
+        EXPECT_GT(counts[b], 80u);
+        EXPECT_LT(counts[b], 120u);
+    }
+    EXPECT_FLOAT_EQ(AIScheduler::InitialDelay(7, 0.0f), 0.0f);
+}
+
+TEST(AISchedulerTest, SelectKeepsHighestPriority) {
+    // 事件唤醒 > 指挥链 > 逾期久的士兵
+    EXPECT_GT(AIScheduler::GetPriority(AIRole::Soldier, 0.0f, true),
+              AIScheduler::GetPriority(AIRole::Commander, 5.0f, false));
+    EXPECT_GT(AIScheduler::GetPriority(AIRole::Leader, 0.0f, false),
+              AIScheduler::GetPriority(AIRole::Soldier, 5.0f, false));
+
+    std::vector<AIScheduler::Candidate> candidates;
+    for (u32 i = 0; i < 20; i++) {
+        candidates.push_back({i, AIScheduler::GetPriority(AIRole::Soldier, 0.01f * (f32)i, i == 3), 0.1f});
+    }
+    AIScheduler::Select(candidates, 5);
+    ASSERT_EQ(candidates.size(), 5u);
+
+    std::vector<u32> ids;
+    for (auto& c : candidates) ids.push_back(c.EntityID);
+    std::sort(ids.begin(), ids.end());
+    EXPECT_EQ(ids, (std::vector<u32>{3, 16, 17, 18, 19}));
+
+    // 不超过配额时原样保留
+    AIScheduler::Select(candidates, 10);
+    EXPECT_EQ(candidates.size(), 5u);
+}
+
+TEST(AISchedulerTest, QuotaFollowsMeasuredCost) {
+    AIScheduler scheduler;
+    AIScheduler::Settings s;
+    s.BudgetMs = 2.0f;
+    s.MinAgentsPerFrame = 4;
+    scheduler.SetSettings(s);
+
+    // 还没有耗时数据: 不限
+    EXPECT_EQ(scheduler.GetFrameQuota(), std::numeric_limits<u32>::max());
+
+    scheduler.EndFrame(100, 5.0f);   // 0.05 ms / agent
+    EXPECT_FLOAT_EQ(scheduler.GetCostPerAgentMs(), 0.05f);
+    EXPECT_EQ(scheduler.GetFrameQuota(), 40u);
+
+    // 一帧尖峰只按指数平均影响估计
+    scheduler.EndFrame(10, 10.0f);   // 1 ms / agent
+    EXPECT_NEAR(scheduler.GetCostPerAgentMs(), 0.145f, 1e-5f);
+    EXPECT_EQ(scheduler.GetFrameQuota(), 13u);
+
+    // 很慢时也保底
+    for (int i = 0; i < 50; i++) scheduler.EndFrame(1, 10.0f);
+    EXPECT_EQ(scheduler.GetFrameQuota(), 4u);
+
+    // 没有思考的帧不更新估计
+    f32 before = scheduler.GetCostPerAgentMs();
+    scheduler.EndFrame(0, 3.0f);
+    EXPECT_FLOAT_EQ(scheduler.GetCostPerAgentMs(), before);
+
+    // 预算为 0 = 不限
+    s.BudgetMs = 0.0f;
+    scheduler.SetSettings(s);
+    EXPECT_EQ(scheduler.GetFrameQuota(), std::numeric_limits<u32>::max());
+}
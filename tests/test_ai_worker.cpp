@@ -0,0 +1,182 @@
+/**
+ * @file test_ai_worker.cpp
+ * @brief AI 工作线程模式单元测试 (需 ENGINE_HAS_PYTHON)
+ *
+ * 测试线程模式下决策结果晚一帧应用、Python 比一帧慢时的等待计时、
+ * 关闭线程时丢弃在途结果并回到同步模式，ClearCache 先等工作线程算完，
+ * 以及 CallBatch 返回后脚本留下的 memoryview 已被 release。
+ */
+
+#include <gtest/gtest.h>
+
+#ifdef ENGINE_HAS_PYTHON
+
+#include "engine/ai/ai_batch.h"
+#include "engine/ai/python_engine.h"
+#include "engine/core/scene.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace Engine;
+using namespace Engine::AI;
+
+namespace {
+
+// 第 n 次调用返回 STATES[n % 4]；计数在 sleep 之后才加，用来判断调用是否已经结束
+const char* const STATES[4] = {"Idle", "Patrol", "Chase", "Attack"};
+
+const char* const SCRIPT = R"PY(
+import sys, types
+_src = '''
+import time
+calls = 0
+delay = 0.0
+STATES = ["Idle", "Patrol", "Chase", "Attack"]
+
+def reset(d):
+    global calls, delay
+    calls = 0
+    delay = float(d)
+    return ""
+
+def get_calls():
+    return str(calls)
+
+def update_ai(ctx_json):
+    global calls
+    time.sleep(delay)
+    calls += 1
+    return STATES[calls % 4] + "|0,0,0|0|0||"
+'''
+_m = types.ModuleType("worker_test_ai")
+exec(_src, _m.__dict__)
+sys.modules["worker_test_ai"] = _m
+
+_batch_src = '''
+kept = None
+
+def update_ai_batch(raw):
+    global kept
+    kept = raw["action_f"]
+    kept[0:4] = bytes(4)
+
+def probe():
+    try:
+        kept.tobytes()
+        return "alive"
+    except ValueError:
+        return "released"
+'''
+_b = types.ModuleType("worker_test_batch")
+exec(_batch_src, _b.__dict__)
+sys.modules["worker_test_batch"] = _b
+)PY";
+
+class AIWorkerTest : public ::testing::Test {
+protected:
+    static void SetUpTestSuite() {
+        PythonEngine::Init(".");
+        PythonEngine::Execute(SCRIPT);
+    }
+    static void TearDownTestSuite() {
+        AIManager::Shutdown();
+        PythonEngine::Shutdown();
+    }
+
+    void SetUp() override {
+        ASSERT_TRUE(PythonEngine::IsInitialized());
+        AIManager::Init();
+        m_Agent = m_Scene.CreateEntity("Agent");
+        auto& world = m_Scene.GetWorld();
+        if (!world.GetComponent<TransformComponent>(m_Agent)) world.AddComponent<TransformComponent>(m_Agent);
+        world.AddComponent<HealthComponent>(m_Agent);
+        world.AddComponent<AIComponent>(m_Agent).ScriptModule = "worker_test_ai";
+    }
+    void TearDown() override { AIManager::SetThreaded(false); }
+
+    static void Reset(f32 delaySeconds) {
+        PythonEngine::CallFunction("worker_test_ai", "reset", {std::to_string(delaySeconds)});
+    }
+    static int Calls() { return std::stoi(PythonEngine::CallFunction("worker_test_ai", "get_calls", {})); }
+    const std::string& State() { return m_Scene.GetWorld().GetComponent<AIComponent>(m_Agent)->State; }
+
+    Scene m_Scene;
+    Entity m_Agent = INVALID_ENTITY;
+};
+
+} // namespace
+
+TEST_F(AIWorkerTest, ResultsApplyOneFrameLate) {
+    Reset(0.03f);
+    AIManager::SetThreaded(true);
+    ASSERT_TRUE(AIManager::IsThreaded());
+    const f32 dt = 1.0f / 60.0f;
+
+    // 第 1 帧只交出快照
+    AIManager::Update(m_Scene, dt);
+    EXPECT_EQ(State(), "Idle");
+
+    // 第 2 帧: Python (30 ms) 比主线程慢，等待计入 StallMs；随后应用第 1 次决策
+    AIManager::Update(m_Scene, dt);
+    EXPECT_EQ(State(), STATES[1]);
+    const AIWorkerStats& stats = AIManager::GetWorkerStats();
+    EXPECT_EQ(stats.Frames, 1u);
+    EXPECT_GT(stats.StallMs, 10.0f);
+    EXPECT_GE(stats.WorkerMs, 25.0f);
+
+    // 主线程自己忙得比 Python 久时不再等待
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    AIManager::Update(m_Scene, dt);
+    EXPECT_EQ(State(), STATES[2]);
+    EXPECT_EQ(stats.Frames, 2u);
+    EXPECT_LT(stats.StallMs, 20.0f);
+}
+
+TEST_F(AIWorkerTest, SwitchToSyncDropsPendingResult) {
+    Reset(0.02f);
+    AIManager::SetThreaded(true);
+    const f32 dt = 1.0f / 60.0f;
+    AIManager::Update(m_Scene, dt);
+
+    // 关闭时等在途调用结束，但其结果不应用
+    AIManager::SetThreaded(false);
+    EXPECT_FALSE(AIManager::IsThreaded());
+    EXPECT_EQ(Calls(), 1);
+    EXPECT_EQ(State(), "Idle");
+
+    // 同步模式当帧求值当帧生效
+    AIManager::Update(m_Scene, dt);
+    EXPECT_EQ(Calls(), 2);
+    EXPECT_EQ(State(), STATES[2]);
+}
+
+TEST_F(AIWorkerTest, ClearCacheWaitsForWorker) {
+    Reset(0.05f);
+    AIManager::SetThreaded(true);
+    const f32 dt = 1.0f / 60.0f;
+    AIManager::Update(m_Scene, dt);
+
+    // 工作线程还在 update_ai 里: ClearCache 须等它返回后才释放函数对象
+    PythonEngine::ClearCache();
+    EXPECT_EQ(Calls(), 1);
+
+    // 重新导入后照常晚一帧应用
+    AIManager::Update(m_Scene, dt);
+    EXPECT_EQ(State(), STATES[1]);
+    AIManager::Update(m_Scene, dt);
+    EXPECT_EQ(State(), STATES[2]);
+}
+
+TEST_F(AIWorkerTest, BatchViewsReleasedAfterCall) {
+    AIBatch batch;
+    batch.Actions.Resize(1, AIBatch::Action::FloatCount, AIBatch::Action::IntCount);
+    batch.Actions.F(0, 0) = 1.0f;
+    ASSERT_TRUE(PythonEngine::CallBatch("worker_test_batch", batch));
+    EXPECT_EQ(batch.Actions.F(0, 0), 0.0f);
+
+    // 脚本保存的 memoryview 在调用返回后不再指向 batch
+    EXPECT_EQ(PythonEngine::CallFunction("worker_test_batch", "probe", {}), "released");
+}
+
+#endif // ENGINE_HAS_PYTHON
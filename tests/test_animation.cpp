@@ -0,0 +1,488 @@
+/**
+ * @file test_animation.cpp
+ * @brief 骨骼动画单元测试
+ *
+ * 测试共享骨架的实例各自持有独立姿势、并行更新与旧的串行路径结果一致、
+ * 剪辑按名称只解析一次、姿势缓冲池的复用，压缩剪辑的误差上限、
+ * 时长不是采样间隔整数倍时的末帧时刻、游标回绕和 3×4 仿射变换组合，以及 LOD 降频插值、剔除跳过、帧预算和减骨。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/animation.h"
+#include "engine/core/job_system.h"
+#include "engine/core/components.h"
+#include "engine/renderer/frustum.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <cmath>
+
+using namespace Engine;
+
+namespace {
+
+/// 三节链状骨架 + 两个剪辑 ("swing" 旋转根骨骼, "slide" 平移末端)
+AnimationSetRef MakeAnimationSet() {
+    auto skeleton = CreateRef<Skeleton>();
+    for (i32 i = 0; i < 3; i++) {
+        Bone bone;
+        bone.Name = "bone_" + std::to_string(i);
+        bone.ParentIndex = i - 1;
+        bone.LocalTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0, i == 0 ? 0.0f : 1.0f, 0));
+        bone.InverseBindMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0, -(f32)i, 0));
+        skeleton->AddBone(bone);
+    }
+
+    auto set = CreateRef<AnimationSet>();
+    set->SkeletonData = skeleton;
+
+    AnimationClip swing;
+    swing.Name = "swing";
+    swing.Duration = 2.0f;
+    AnimationChannel root;
+    root.BoneIndex = 0;
+    root.RotationKeys = {
+        {0.0f, glm::quat(1, 0, 0, 0)},
+        {1.0f, glm::angleAxis(glm::radians(90.0f), glm::vec3(0, 0, 1))},
+        {2.0f, glm::quat(1, 0, 0, 0)},
+    };
+    swing.Channels.push_back(root);
+    set->Clips.push_back(swing);
+
+    AnimationClip slide;
+    slide.Name = "slide";
+    slide.Duration = 1.0f;
+    AnimationChannel tip;
+    tip.BoneIndex = 2;
+    tip.PositionKeys = {{0.0f, {0, 1, 0}}, {1.0f, {1, 1, 0}}};
+    slide.Channels.push_back(tip);
+    set->Clips.push_back(slide);
+    return set;
+}
+
+bool NearlyEqual(const glm::mat4& a, const glm::mat4& b, f32 eps = 1e-4f) {
+    for (int c = 0; c < 4; c++)
+        for (int r = 0; r < 4; r++)
+            if (std::abs(a[c][r] - b[c][r]) > eps) return false;
+    return true;
+}
+
+/// 8 根骨骼、2 秒、30 Hz 关键帧的剪辑: 旋转/平移为正弦曲线，缩放恒定，
+/// 第 7 根骨骼没有通道 (应取绑定姿势)
+AnimationSetRef MakeWavySet() {
+    auto skeleton = CreateRef<Skeleton>();
+    for (i32 i = 0; i < 8; i++) {
+        Bone bone;
+        bone.Name = "b" + std::to_string(i);
+        bone.ParentIndex = i - 1;
+        bone.LocalTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0.5f, 0, 0));
+        skeleton->AddBone(bone);
+    }
+    auto set = CreateRef<AnimationSet>();
+    set->SkeletonData = skeleton;
+
+    AnimationClip clip;
+    clip.Name = "wave";
+    clip.Duration = 2.0f;
+    for (i32 b = 0; b < 7; b++) {
+        AnimationChannel ch;
+        ch.BoneIndex = b;
+        for (u32 k = 0; k <= 60; k++) {
+            f32 t = (f32)k / 30.0f;
+            f32 phase = t * 3.14159f + (f32)b;
+            ch.PositionKeys.push_back({t, {0.5f, std::sin(phase) * 0.2f, 0.1f * (f32)b}});
+            ch.RotationKeys.push_back({t, glm::angleAxis(std::sin(phase), glm::normalize(glm::vec3(1, b, 2)))});
+            ch.ScaleKeys.push_back({t, glm::vec3(1.0f)});
+        }
+        clip.Channels.push_back(std::move(ch));
+    }
+    set->Clips.push_back(std::move(clip));
+    return set;
+}
+
+/// 创建播放指定剪辑、位于 position 的动画实体
+Entity SpawnAnimated(ECSWorld& world, const AnimationSetRef& set, const char* clip,
+                     const glm::vec3& position) {
+    Entity e = world.CreateEntity("Animated");
+    world.AddComponent<TransformComponent>(e).WorldMatrix = glm::translate(glm::mat4(1.0f), position);
+    auto& anim = world.AddComponent<AnimatorComponent>(e);
+    anim.Animations = set;
+    anim.Play(clip);
+    return e;
+}
+
+f32 RotationError(const glm::quat& a, const glm::quat& b) {
+    return 2.0f * std::acos(std::min(1.0f, std::abs(glm::dot(a, b))));
+}
+
+} // namespace
+
+TEST(AnimationTest, SharedSkeletonIndependentPoses) {
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    Entity a = world.CreateEntity("A");
+    Entity b = world.CreateEntity("B");
+    world.AddComponent<AnimatorComponent>(a);
+    world.AddComponent<AnimatorComponent>(b);
+    auto& animA = *world.GetComponent<AnimatorComponent>(a);
+    auto& animB = *world.GetComponent<AnimatorComponent>(b);
+    animA.Animations = set;
+    animB.Animations = set;
+    animA.CurrentClip = "swing";
+    animB.CurrentClip = "swing";
+    animB.CurrentTime = 1.0f;
+
+    AnimationSystem system;
+    system.Update(world, 0.0f);
+
+    const auto& ma = world.GetComponent<AnimatorComponent>(a)->BoneMatrices;
+    const auto& mb = world.GetComponent<AnimatorComponent>(b)->BoneMatrices;
+    ASSERT_EQ(ma.size(), 3u);
+    ASSERT_EQ(mb.size(), 3u);
+
+    // A 处于绑定姿势，B 的根骨骼转了 90°
+    for (u32 i = 0; i < 3; i++) EXPECT_TRUE(NearlyEqual(ma[i], glm::mat4(1.0f)));
+    glm::vec4 tipB = mb[2] * glm::vec4(0, 2, 0, 1);
+    EXPECT_NEAR(tipB.x, -2.0f, 1e-4f);
+    EXPECT_NEAR(tipB.y, 0.0f, 1e-4f);
+
+    // 共享骨架本身未被修改
+    EXPECT_TRUE(NearlyEqual(set->SkeletonData->GetBone(0).LocalTransform, glm::mat4(1.0f)));
+}
+
+TEST(AnimationTest, ParallelMatchesLegacySerialPath) {
+    JobSystem::Init(3);
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    constexpr u32 COUNT = 300;
+    std::vector<Entity> entities;
+    for (u32 i = 0; i < COUNT; i++) {
+        Entity e = world.CreateEntity("E");
+        auto& anim = world.AddComponent<AnimatorComponent>(e);
+        anim.Animations = set;
+        anim.CurrentClip = (i % 2) ? "swing" : "slide";
+        anim.CurrentTime = (f32)i * 0.013f;
+        anim.PlaybackSpeed = 0.5f + (f32)(i % 7) * 0.25f;
+        entities.push_back(e);
+    }
+
+    AnimationSystem system;
+    for (int frame = 0; frame < 3; frame++) system.Update(world, 1.0f / 60.0f);
+    JobSystem::Shutdown();
+
+    // 旧路径: 可写骨架副本 → Sample 写 LocalTransform → ComputeBoneMatrices
+    Skeleton scratch = *set->SkeletonData;
+    std::vector<glm::mat4> expected;
+    for (Entity e : entities) {
+        const auto& anim = *world.GetComponent<AnimatorComponent>(e);
+        ASSERT_GE(anim.ClipIndex, 0);
+        scratch = *set->SkeletonData;
+        AnimationSampler::Sample(set->Clips[anim.ClipIndex], anim.CurrentTime, scratch);
+        scratch.ComputeBoneMatrices(expected);
+        ASSERT_EQ(anim.BoneMatrices.size(), expected.size());
+        for (size_t b = 0; b < expected.size(); b++) {
+            EXPECT_TRUE(NearlyEqual(anim.BoneMatrices[b], expected[b]));
+        }
+    }
+    EXPECT_EQ(system.GetPoseArena().GetUsed(), COUNT * 3);
+}
+
+TEST(AnimationTest, ClipResolvedOnceAndPlaySwitches) {
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    Entity e = world.CreateEntity("E");
+    auto& anim = world.AddComponent<AnimatorComponent>(e);
+    anim.Animations = set;
+    anim.CurrentClip = "slide";
+    anim.Loop = false;
+
+    AnimationSystem system;
+    system.Update(world, 0.25f);
+    EXPECT_EQ(anim.ClipIndex, 1);
+    EXPECT_FLOAT_EQ(anim.CurrentTime, 0.25f);
+
+    // 非循环播放到末尾后停止
+    system.Update(world, 2.0f);
+    EXPECT_FLOAT_EQ(anim.CurrentTime, 1.0f);
+    EXPECT_FALSE(anim.Playing);
+
+    anim.Play("swing");
+    system.Update(world, 0.5f);
+    EXPECT_EQ(anim.ClipIndex, 0);
+    EXPECT_TRUE(anim.Playing);
+
+    // 未知剪辑: 跳过，不改动上一帧矩阵
+    auto before = anim.BoneMatrices;
+    anim.Play("missing");
+    system.Update(world, 0.5f);
+    EXPECT_EQ(anim.ClipIndex, -1);
+    EXPECT_EQ(anim.BoneMatrices, before);
+}
+
+TEST(AnimationTest, PoseArenaReusesCapacity) {
+    PoseArena arena;
+    u32 a = arena.Allocate(10);
+    u32 b = arena.Allocate(20);
+    EXPECT_EQ(a, 0u);
+    EXPECT_EQ(b, 10u);
+    u32 capacity = arena.GetCapacity();
+    EXPECT_GE(capacity, 30u);
+
+    arena.Reset();
+    EXPECT_EQ(arena.Allocate(30), 0u);
+    EXPECT_EQ(arena.GetCapacity(), capacity);
+}
+
+TEST(AnimationTest, CompressedClipWithinErrorBounds) {
+    auto set = MakeWavySet();
+    const Skeleton& skeleton = *set->SkeletonData;
+    const AnimationClip& clip = set->Clips[0];
+
+    AnimationCompressionSettings settings;
+    settings.PositionTolerance = 1e-3f;
+    settings.RotationTolerance = 1e-3f;
+    CompressedClip compressed;
+    AnimationCompressionStats stats;
+    ASSERT_TRUE(compressed.Build(clip, skeleton, settings, &stats));
+
+    EXPECT_LT(stats.CompressedBytes * 2, stats.RawBytes);
+    EXPECT_LT(stats.KeptKeys, stats.SampledKeys);
+    EXPECT_LE(stats.MaxPositionError, settings.PositionTolerance);
+    EXPECT_LE(stats.MaxRotationError, settings.RotationTolerance);
+    EXPECT_LE(stats.MaxScaleError, settings.ScaleTolerance);
+
+    // 任意时刻 (含帧间) 与原始剪辑对比；帧间 nlerp 与 slerp 的差异计入余量
+    std::vector<BonePose> raw(8), packed(8);
+    AnimationCursor cursor;
+    for (f32 t = 0.0f; t <= clip.Duration; t += 0.0137f) {
+        AnimationSampler::SamplePose(clip, t, skeleton, raw.data());
+        compressed.Sample(t, cursor, packed.data());
+        for (u32 b = 0; b < 8; b++) {
+            EXPECT_LT(glm::length(raw[b].Position - packed[b].Position), 3e-3f) << "bone " << b << " t " << t;
+            EXPECT_LT(RotationError(raw[b].Rotation, packed[b].Rotation), 3e-3f) << "bone " << b << " t " << t;
+            EXPECT_LT(glm::length(raw[b].Scale - packed[b].Scale), 1e-4f);
+        }
+    }
+    // 无通道的骨骼保持绑定姿势
+    EXPECT_NEAR(packed[7].Position.x, 0.5f, 1e-4f);
+}
+
+TEST(AnimationTest, CompressedClipOddDurationKeepsTiming) {
+    // 1.05 秒 @ 30 Hz 不是整数帧: 末帧须恰好对应 Duration，帧间时刻不能漂移
+    auto set = MakeWavySet();
+    const Skeleton& skeleton = *set->SkeletonData;
+    AnimationClip ramp;
+    ramp.Name = "ramp";
+    ramp.Duration = 1.05f;
+    AnimationChannel ch;
+    ch.BoneIndex = 0;
+    ch.PositionKeys = {{0.0f, {0, 0, 0}}, {1.05f, {10.5f, 0, 0}}};
+    ramp.Channels.push_back(ch);
+
+    CompressedClip compressed;
+    ASSERT_TRUE(compressed.Build(ramp, skeleton));
+
+    std::vector<BonePose> raw(8), packed(8);
+    AnimationCursor cursor;
+    for (f32 t : {0.0f, 0.5f, 1.0f, 1.02f, 1.04f, 1.05f}) {
+        AnimationSampler::SamplePose(ramp, t, skeleton, raw.data());
+        compressed.Sample(t, cursor, packed.data());
+        EXPECT_NEAR(packed[0].Position.x, raw[0].Position.x, 2e-3f) << "t " << t;
+    }
+}
+
+TEST(AnimationTest, CursorRewindMatchesFreshCursor) {
+    auto set = MakeWavySet();
+    CompressedClip compressed;
+    ASSERT_TRUE(compressed.Build(set->Clips[0], *set->SkeletonData));
+
+    std::vector<BonePose> a(8), b(8);
+    AnimationCursor running;
+    for (f32 t = 0.0f; t < 1.9f; t += 0.1f) compressed.Sample(t, running, a.data());
+
+    // 循环回绕: 时间回退后结果应与全新游标一致
+    for (f32 t : {0.05f, 0.75f, 1.99f, 0.3f}) {
+        AnimationCursor fresh;
+        compressed.Sample(t, running, a.data());
+        compressed.Sample(t, fresh, b.data());
+        for (u32 i = 0; i < 8; i++) {
+            EXPECT_EQ(a[i].Position, b[i].Position);
+            EXPECT_EQ(a[i].Rotation, b[i].Rotation);
+        }
+    }
+}
+
+TEST(AnimationTest, SystemUsesCompressedClips) {
+    auto raw = MakeWavySet();
+    auto packed = CreateRef<AnimationSet>(*raw);
+    packed->CompressClips({}, false);
+    ASSERT_EQ(packed->Compressed.size(), 1u);
+    EXPECT_TRUE(packed->Clips[0].Channels.empty());
+    EXPECT_FLOAT_EQ(packed->Clips[0].Duration, 2.0f);
+
+    ECSWorld world;
+    Entity a = world.CreateEntity("Raw");
+    Entity b = world.CreateEntity("Packed");
+    world.AddComponent<AnimatorComponent>(a).Animations = raw;
+    world.AddComponent<AnimatorComponent>(b).Animations = packed;
+    for (Entity e : {a, b}) world.GetComponent<AnimatorComponent>(e)->Play("wave");
+
+    AnimationSystem system;
+    for (int frame = 0; frame < 90; frame++) {
+        system.Update(world, 1.0f / 60.0f);
+        const auto& ma = world.GetComponent<AnimatorComponent>(a)->BoneMatrices;
+        const auto& mb = world.GetComponent<AnimatorComponent>(b)->BoneMatrices;
+        ASSERT_EQ(ma.size(), mb.size());
+        for (size_t i = 0; i < ma.size(); i++) {
+            EXPECT_TRUE(NearlyEqual(ma[i], mb[i], 2e-3f)) << "frame " << frame << " bone " << i;
+        }
+    }
+}
+
+TEST(AnimationTest, AffineTransformMatchesMat4) {
+    BonePose pa, pb;
+    pa.Position = {1, 2, 3};
+    pa.Rotation = glm::angleAxis(0.7f, glm::normalize(glm::vec3(1, 1, 0)));
+    pa.Scale = {2, 1, 0.5f};
+    pb.Position = {-1, 0.5f, 4};
+    pb.Rotation = glm::angleAxis(-1.2f, glm::vec3(0, 0, 1));
+
+    auto toMat4 = [](const BonePose& p) {
+        return glm::translate(glm::mat4(1.0f), p.Position) * glm::mat4_cast(p.Rotation) *
+               glm::scale(glm::mat4(1.0f), p.Scale);
+    };
+    glm::mat4 expected = toMat4(pa) * toMat4(pb);
+    AffineTransform combined = AffineTransform::FromPose(pa) * AffineTransform::FromPose(pb);
+    EXPECT_TRUE(NearlyEqual(combined.ToMat4(), expected));
+    EXPECT_TRUE(NearlyEqual(AffineTransform::FromMat4(expected).ToMat4(), expected));
+}
+
+TEST(AnimationTest, CulledInstancesSkipAndResume) {
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    Entity e = SpawnAnimated(world, set, "slide", {0, 0, 50});   // 相机背后
+
+    Frustum frustum;
+    frustum.ExtractFromVP(glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 100.0f) *
+                          glm::lookAt(glm::vec3(0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0)));
+    AnimationSystem system;
+    system.SetView({glm::vec3(0), 0.0f, &frustum});
+
+    for (int frame = 0; frame < 10; frame++) system.Update(world, 0.05f);
+    EXPECT_EQ(system.GetStats().Culled, 1u);
+    EXPECT_EQ(system.GetStats().Evaluated, 0u);
+    const auto* anim = world.GetComponent<AnimatorComponent>(e);
+    EXPECT_NEAR(anim->CurrentTime, 0.5f, 1e-4f);                  // 不可见时时间照常推进
+    EXPECT_FALSE(anim->PoseValid);
+
+    // 回到视野内: 当帧立即按当前时刻采样
+    world.GetComponent<TransformComponent>(e)->WorldMatrix = glm::translate(glm::mat4(1.0f), glm::vec3(0, 0, -5));
+    system.Update(world, 0.05f);
+    EXPECT_EQ(system.GetStats().Evaluated, 1u);
+    anim = world.GetComponent<AnimatorComponent>(e);
+    // slide 在 0.55 s 时末端骨骼 x = 0.55
+    EXPECT_NEAR(anim->BoneMatrices[2][3].x, 0.55f, 1e-4f);
+}
+
+TEST(AnimationTest, FarInstancesInterpolateBetweenSamples) {
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    Entity nearE = SpawnAnimated(world, set, "slide", {0, 0, 0});
+    Entity farE = SpawnAnimated(world, set, "slide", {0, 0, 100});
+
+    AnimationLODSettings lod;
+    lod.Levels = {{0.0f, 10.0f, 1, 0}, {0.0f, 1e30f, 4, 0}};
+    AnimationSystem system;
+    system.SetLODSettings(lod);
+
+    u32 farEvaluations = 0;
+    for (int frame = 0; frame < 40; frame++) {
+        system.Update(world, 1.0f / 60.0f);
+        farEvaluations += system.GetStats().Evaluated - 1;
+        EXPECT_EQ(world.GetComponent<AnimatorComponent>(farE)->LODLevel, 1u);
+        if (frame < 8) continue;   // 首个采样窗口内相位错开，之后应与逐帧采样一致
+
+        // slide 是线性平移，降频采样 + 矩阵插值应与逐帧采样一致
+        const auto& a = world.GetComponent<AnimatorComponent>(nearE)->BoneMatrices;
+        const auto& b = world.GetComponent<AnimatorComponent>(farE)->BoneMatrices;
+        for (size_t i = 0; i < a.size(); i++) {
+            EXPECT_TRUE(NearlyEqual(a[i], b[i], 1e-4f)) << "frame " << frame << " bone " << i;
+        }
+    }
+    // 40 帧、每 4 帧采样一次 (外加首帧)
+    EXPECT_LE(farEvaluations, 11u);
+    EXPECT_GE(farEvaluations, 9u);
+}
+
+TEST(AnimationTest, FrameBudgetDefersButEveryInstanceUpdates) {
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 20; i++) entities.push_back(SpawnAnimated(world, set, "swing", {0, 0, 0}));
+
+    AnimationLODSettings lod;
+    lod.FrameBudgetMs = 1e-6f;   // 每帧只够采样一个实例
+    AnimationSystem system;
+    system.SetLODSettings(lod);
+
+    system.Update(world, 0.01f);
+    EXPECT_EQ(system.GetStats().Evaluated, 1u);
+    EXPECT_EQ(system.GetStats().Deferred, 19u);
+
+    for (int frame = 1; frame < 20; frame++) system.Update(world, 0.01f);
+    // 从未采样的实例优先级最高，20 帧内每个实例都应至少采样一次
+    for (Entity e : entities) EXPECT_TRUE(world.GetComponent<AnimatorComponent>(e)->PoseValid);
+}
+
+TEST(AnimationTest, FrameBudgetSurvivesLODIntervalChange) {
+    auto set = MakeAnimationSet();
+    ECSWorld world;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 12; i++) entities.push_back(SpawnAnimated(world, set, "swing", {0, 0, 0}));
+
+    // 先逐帧采样: 没有插值端点
+    AnimationLODSettings lod;
+    lod.Levels = {{0.0f, 1e30f, 1, 0}};
+    AnimationSystem system;
+    system.SetLODSettings(lod);
+    system.Update(world, 0.01f);
+    for (Entity e : entities) EXPECT_TRUE(world.GetComponent<AnimatorComponent>(e)->NextMatrices.empty());
+
+    // 中途切到每 4 帧采样且预算只够一个实例: 被推迟到逾期的实例不能对空端点插值
+    lod.Levels = {{0.0f, 1e30f, 4, 0}};
+    lod.FrameBudgetMs = 1e-6f;
+    system.SetLODSettings(lod);
+    for (int frame = 0; frame < 40; frame++) {
+        system.Update(world, 0.01f);
+        for (Entity e : entities) {
+            const auto* anim = world.GetComponent<AnimatorComponent>(e);
+            ASSERT_EQ(anim->BoneMatrices.size(), 3u);
+            for (const auto& m : anim->BoneMatrices) ASSERT_TRUE(std::isfinite(m[3].x));
+        }
+    }
+    // 预算轮转下每个实例都已重新预采样
+    for (Entity e : entities) EXPECT_EQ(world.GetComponent<AnimatorComponent>(e)->NextMatrices.size(), 3u);
+}
+
+TEST(AnimationTest, BoneReductionKeepsRestPose) {
+    auto set = MakeAnimationSet();
+    auto packed = CreateRef<AnimationSet>(*set);
+    packed->CompressClips({}, false);
+
+    ECSWorld world;
+    Entity a = SpawnAnimated(world, set, "slide", {0, 0, 0});
+    Entity b = SpawnAnimated(world, packed, "slide", {0, 0, 0});
+
+    AnimationLODSettings lod;
+    lod.Levels = {{0.0f, 1e30f, 1, 2}};   // 只采样前两根骨骼
+    AnimationSystem system;
+    system.SetLODSettings(lod);
+    system.Update(world, 0.5f);
+
+    EXPECT_EQ(system.GetStats().EvaluatedBones, 4u);
+    for (Entity e : {a, b}) {
+        // slide 只驱动第 3 根骨骼，减骨后它保持绑定姿势 (蒙皮矩阵为单位阵)
+        const auto& m = world.GetComponent<AnimatorComponent>(e)->BoneMatrices;
+        EXPECT_TRUE(NearlyEqual(m[2], glm::mat4(1.0f)));
+    }
+}
@@ -0,0 +1,261 @@
+/**
+ * @file test_compiled_behavior_tree.cpp
+ * @brief 编译行为树单元测试
+ *
+ * 测试组合/装饰节点与旧的节点树结果一致、Running 节点直接恢复 (前面的兄弟不重新求值)、
+ * Repeater 计数存放在每个 agent 的状态里、构建器的结构校验，
+ * 多个 agent 共享一棵树在 JobSystem 上并行 tick，以及未声明叶子访问的组件类型时退回串行 tick。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/compiled_behavior_tree.h"
+#include "engine/core/job_system.h"
+#include "engine/core/components.h"
+
+#include <atomic>
+#include <thread>
+
+using namespace Engine;
+
+namespace {
+
+CompiledBehaviorTree::ActionFunc Returns(BTStatus status, int* calls = nullptr) {
+    return [status, calls](const BTTickContext&) {
+        if (calls) (*calls)++;
+        return status;
+    };
+}
+
+CompiledBehaviorTree::ConditionFunc Is(bool value, int* calls = nullptr) {
+    return [value, calls](const BTTickContext&) {
+        if (calls) (*calls)++;
+        return value;
+    };
+}
+
+} // namespace
+
+TEST(CompiledBehaviorTreeTest, CompositesMatchNodeTree) {
+    // Selector( Sequence(true, Failure), Inverter(false), Success )
+    BTBuilder b;
+    b.Selector()
+        .Sequence().Condition("a", Is(true)).Action("b", Returns(BTStatus::Failure)).End()
+        .Inverter().Condition("c", Is(false)).End()
+        .Action("d", Returns(BTStatus::Success))
+     .End();
+    auto tree = b.Build();
+    ASSERT_TRUE(tree);
+    EXPECT_EQ(tree->GetNodeCount(), 7u);
+    EXPECT_EQ(tree->GetNode(0).Next, 7u);
+    EXPECT_EQ(tree->GetNode(1).Next, 4u);
+
+    auto seq = CreateRef<BTSequence>();
+    seq->AddChild(CreateRef<BTCondition>("a", [] { return true; }));
+    seq->AddChild(CreateRef<BTAction>("b", [](f32) { return BTStatus::Failure; }));
+    auto sel = CreateRef<BTSelector>();
+    sel->AddChild(seq);
+    sel->AddChild(CreateRef<BTInverter>(CreateRef<BTCondition>("c", [] { return false; })));
+    sel->AddChild(CreateRef<BTAction>("d", [](f32) { return BTStatus::Success; }));
+    BehaviorTree legacy;
+    legacy.SetRoot(sel);
+
+    BTAgentState state;
+    EXPECT_EQ(tree->Tick(state, {}), legacy.Tick(0.0f));
+    EXPECT_EQ(state.LastStatus, BTStatus::Success);
+    EXPECT_EQ(state.Running, BTAgentState::NONE);
+
+    // 空组合
+    BTBuilder empty;
+    empty.Selector().End();
+    BTAgentState s2;
+    EXPECT_EQ(empty.Build()->Tick(s2, {}), BTStatus::Failure);
+}
+
+TEST(CompiledBehaviorTreeTest, RunningNodeResumesWithoutReevaluatingSiblings) {
+    int condCalls = 0, moveCalls = 0, attackCalls = 0;
+    int moveTicks = 3;
+    BTBuilder b;
+    b.Sequence()
+        .Condition("HasTarget", Is(true, &condCalls))
+        .Action("MoveTo", [&](const BTTickContext&) {
+            moveCalls++;
+            return --moveTicks > 0 ? BTStatus::Running : BTStatus::Success;
+        })
+        .Action("Attack", Returns(BTStatus::Success, &attackCalls))
+     .End();
+    auto tree = b.Build();
+    ASSERT_TRUE(tree);
+
+    BTAgentState state;
+    EXPECT_EQ(tree->Tick(state, {}), BTStatus::Running);
+    EXPECT_EQ(state.Running, 2u);
+    EXPECT_EQ(tree->Tick(state, {}), BTStatus::Running);
+    EXPECT_EQ(tree->Tick(state, {}), BTStatus::Success);
+    EXPECT_EQ(condCalls, 1);     // 恢复时不重查条件
+    EXPECT_EQ(moveCalls, 3);
+    EXPECT_EQ(attackCalls, 1);
+    EXPECT_EQ(state.Running, BTAgentState::NONE);
+
+    // 完成后下一次从根开始
+    moveTicks = 1;
+    EXPECT_EQ(tree->Tick(state, {}), BTStatus::Success);
+    EXPECT_EQ(condCalls, 2);
+
+    // Reset 放弃进行中的节点
+    moveTicks = 5;
+    EXPECT_EQ(tree->Tick(state, {}), BTStatus::Running);
+    CompiledBehaviorTree::Reset(state);
+    EXPECT_EQ(state.Running, BTAgentState::NONE);
+    tree->Tick(state, {});
+    EXPECT_EQ(condCalls, 4);
+}
+
+TEST(CompiledBehaviorTreeTest, RepeaterCountsPerAgent) {
+    int calls = 0;
+    BTBuilder b;
+    b.Sequence()
+        .Repeater(3).Action("Step", Returns(BTStatus::Success, &calls)).End()
+        .Action("Done", Returns(BTStatus::Success))
+     .End();
+    auto tree = b.Build();
+    ASSERT_TRUE(tree);
+
+    // 与 BTRepeater 一致: 每次 tick 完成一次孩子，第 3 次时成功
+    BTRepeater legacy(CreateRef<BTAction>("Step", [](f32) { return BTStatus::Success; }), 3);
+
+    BTAgentState a, other;
+    for (int i = 0; i < 3; i++) {
+        BTStatus expected = legacy.Tick(0.0f);
+        EXPECT_EQ(tree->Tick(a, {}), expected);
+        EXPECT_EQ(a.Counters[0], (u16)(i + 1));
+    }
+    EXPECT_EQ(calls, 3);
+    EXPECT_EQ(a.Running, BTAgentState::NONE);
+
+    // 另一个 agent 的计数独立
+    EXPECT_EQ(tree->Tick(other, {}), BTStatus::Running);
+    EXPECT_EQ(other.Counters[0], 1u);
+
+    // 重新进入时计数清零
+    EXPECT_EQ(tree->Tick(a, {}), BTStatus::Running);
+    EXPECT_EQ(a.Counters[0], 1u);
+}
+
+TEST(CompiledBehaviorTreeTest, BuilderRejectsMalformedTrees) {
+    {
+        BTBuilder b;
+        b.Sequence().Action("a", Returns(BTStatus::Success));   // 未 End
+        EXPECT_FALSE(b.Build());
+    }
+    {
+        BTBuilder b;
+        b.Action("a", Returns(BTStatus::Success)).Action("b", Returns(BTStatus::Success));   // 两个根
+        EXPECT_FALSE(b.Build());
+    }
+    {
+        BTBuilder b;
+        b.Inverter().Action("a", Returns(BTStatus::Success)).Action("b", Returns(BTStatus::Success)).End();
+        EXPECT_FALSE(b.Build());
+    }
+    {
+        BTBuilder b;
+        b.Sequence().Inverter().End().End();   // 装饰节点没有孩子
+        EXPECT_FALSE(b.Build());
+    }
+    {
+        BTBuilder b;
+        b.Sequence();
+        for (u32 i = 0; i <= BTAgentState::MAX_COUNTERS; i++) {
+            b.Repeater(2).Action("a", Returns(BTStatus::Success)).End();
+        }
+        b.End();
+        EXPECT_FALSE(b.Build());
+    }
+}
+
+TEST(CompiledBehaviorTreeTest, SystemTicksSharedTreeInParallel) {
+    // 血量低于 50 时回血 (每帧 +10，运行到满 100)，否则失败
+    BTBuilder b;
+    b.Sequence()
+        .Condition("Hurt", [](const BTTickContext& ctx) {
+            return ctx.World->GetComponent<HealthComponent>(ctx.Self)->Current < 50.0f;
+        })
+        .Action("Heal", [](const BTTickContext& ctx) {
+            auto* hp = ctx.World->GetComponent<HealthComponent>(ctx.Self);
+            hp->Current += 10.0f;
+            return hp->Current >= 100.0f ? BTStatus::Success : BTStatus::Running;
+        })
+     .End();
+    auto tree = b.Build();
+    ASSERT_TRUE(tree);
+
+    JobSystem::Init(3);
+    ECSWorld world;
+    constexpr u32 COUNT = 1000;
+    std::vector<Entity> entities;
+    for (u32 i = 0; i < COUNT; i++) {
+        Entity e = world.CreateEntity("Agent");
+        world.AddComponent<HealthComponent>(e).Current = (f32)(i % 100);
+        world.AddComponent<BehaviorTreeComponent>(e).Tree = tree;
+        entities.push_back(e);
+    }
+
+    BehaviorTreeSystem system;
+    system.UsesComponents<HealthComponent>();
+    for (int frame = 0; frame < 12; frame++) system.Update(world, 1.0f / 60.0f);
+    JobSystem::Shutdown();
+
+    for (u32 i = 0; i < COUNT; i++) {
+        f32 start = (f32)(i % 100);
+        auto* hp = world.GetComponent<HealthComponent>(entities[i]);
+        auto* bt = world.GetComponent<BehaviorTreeComponent>(entities[i]);
+        if (start < 50.0f) {
+            // 回到 >= 100 后条件不再满足，之后每帧失败
+            EXPECT_GE(hp->Current, 100.0f);
+            EXPECT_LT(hp->Current, 110.0f);
+            EXPECT_EQ(bt->State.LastStatus, BTStatus::Failure);
+        } else {
+            EXPECT_EQ(hp->Current, start);
+            EXPECT_EQ(bt->State.LastStatus, BTStatus::Failure);
+        }
+        EXPECT_EQ(bt->State.Running, BTAgentState::NONE);
+    }
+}
+
+TEST(CompiledBehaviorTreeTest, ParallelTickRequiresDeclaredComponents) {
+    // 叶子访问的 VelocityComponent 在 world 里还没有池
+    std::thread::id mainThread = std::this_thread::get_id();
+    std::atomic<u32> offThread{0};
+    BTBuilder b;
+    b.Condition("Moving", [&](const BTTickContext& ctx) {
+        if (std::this_thread::get_id() != mainThread) offThread++;
+        return ctx.World->HasComponent<VelocityComponent>(ctx.Self);
+    });
+    auto tree = b.Build();
+    ASSERT_TRUE(tree);
+
+    JobSystem::Init(3);
+    auto spawn = [&](ECSWorld& world) {
+        for (u32 i = 0; i < 500; i++) {
+            world.AddComponent<BehaviorTreeComponent>(world.CreateEntity("Agent")).Tree = tree;
+        }
+    };
+
+    // 未声明: 串行 tick (池由主线程上的第一次访问建出)
+    ECSWorld serialWorld;
+    spawn(serialWorld);
+    BehaviorTreeSystem serial;
+    serial.Update(serialWorld, 0.016f);
+    EXPECT_EQ(offThread.load(), 0u);
+
+    // 声明后并行 tick: 池在 tick 前由主线程建好，工作线程只读
+    ECSWorld world;
+    spawn(world);
+    BehaviorTreeSystem parallel;
+    parallel.UsesComponents<VelocityComponent>();
+    parallel.Update(world, 0.016f);
+    JobSystem::Shutdown();
+
+    auto& pool = world.GetComponentArray<BehaviorTreeComponent>();
+    for (u32 i = 0; i < pool.Size(); i++) EXPECT_EQ(pool.Data(i).State.LastStatus, BTStatus::Failure);
+}
@@ -170,3 +170,43 @@ TEST(ECSTest, DestroyEntityCleansUpComponents) {
     EXPECT_EQ(world.GetComponent<TransformComponent>(e), nullptr);
     EXPECT_EQ(world.GetComponent<HealthComponent>(e), nullptr);
 }
+
+// ── 批量创建 / 批量添加 ─────────────────────────────────────
+
+TEST(ECSTest, CreateEntitiesBulk) {
+    ECSWorld world;
+    Entity first = world.CreateEntity("First");
+    world.DestroyEntity(first);
+
+    std::vector<Entity> entities;
+    world.CreateEntities(100, entities, "Bulk");
+    ASSERT_EQ(entities.size(), 100u);
+    EXPECT_EQ(world.GetEntityCount(), 100u);
+    EXPECT_EQ(entities[0], first);  // 先复用 free list
+    for (Entity e : entities) {
+        EXPECT_TRUE(world.IsAlive(e));
+        auto* tag = world.GetComponent<TagComponent>(e);
+        ASSERT_NE(tag, nullptr);
+        EXPECT_EQ(tag->Name, "Bulk");
+    }
+}
+
+TEST(ECSTest, AddComponentsBulk) {
+    ECSWorld world;
+    std::vector<Entity> entities;
+    world.CreateEntities(10, entities);
+
+    // 已存在的组件应被重置后重新填充
+    world.AddComponent<HealthComponent>(entities[3]).Max = 999.0f;
+
+    world.AddComponents<HealthComponent>(entities.data(), 10,
+        [](u32 i, HealthComponent& hp) { hp.Current = (f32)i; });
+
+    EXPECT_EQ(world.GetComponentArray<HealthComponent>().Size(), 10u);
+    for (u32 i = 0; i < 10; i++) {
+        auto* hp = world.GetComponent<HealthComponent>(entities[i]);
+        ASSERT_NE(hp, nullptr);
+        EXPECT_FLOAT_EQ(hp->Current, (f32)i);
+        EXPECT_FLOAT_EQ(hp->Max, 100.0f);
+    }
+}
@@ -0,0 +1,173 @@
+/**
+ * @file test_flow_field.cpp
+ * @brief 流场单元测试
+ *
+ * 测试积分代价与逐格 Dijkstra 参考解一致、沿方向逐格走必到目标且代价严格下降、
+ * 积分半径外不可达，局部修复与整张重算的代价一致，以及缓存只在目标换格时重算、
+ * 可走性局部变化时只修复涉及的流场。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/flow_field.h"
+#include "engine/ai/behavior_tree.h"
+#include "nav_test_utils.h"
+
+#include <random>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::NavTest;
+
+TEST(FlowFieldTest, CostMatchesDijkstra) {
+    NavGrid grid = MakeRandomGrid(60, 45, 5, 25);
+    FlowField field;
+    for (glm::ivec2 goal : {glm::ivec2(30, 20), glm::ivec2(0, 0), glm::ivec2(59, 44)}) {
+        grid.SetWalkable(goal.x, goal.y, true);
+        field.Compute(grid, goal);
+        std::vector<i32> expected = ReferenceField(grid, goal, 10, 14);   // 整数代价 10/14，不可达为 -1
+
+        u32 reached = 0;
+        for (i32 y = 0; y < 45; y++) {
+            for (i32 x = 0; x < 60; x++) {
+                i32 ref = expected[y * 60 + x];
+                ASSERT_EQ(field.IsReachable(x, y), ref >= 0) << x << "," << y;
+                if (ref < 0) continue;
+                reached++;
+                EXPECT_NEAR(field.GetCost(x, y), ref * 0.1f, 1e-4f);
+            }
+        }
+        EXPECT_EQ(field.GetReachedCount(), reached);
+    }
+}
+
+TEST(FlowFieldTest, DirectionsDescendToGoal) {
+    NavGrid grid = MakeRandomGrid(50, 50, 9, 30);
+    glm::ivec2 goal = {25, 25};
+    grid.SetWalkable(goal.x, goal.y, true);
+    FlowField field;
+    field.Compute(grid, goal);
+    EXPECT_EQ(field.GetDirection(goal.x, goal.y), glm::ivec2(0, 0));
+
+    for (i32 y = 0; y < 50; y++) {
+        for (i32 x = 0; x < 50; x++) {
+            if (!field.IsReachable(x, y)) continue;
+            glm::ivec2 cell = {x, y};
+            for (u32 steps = 0; cell != goal; steps++) {
+                ASSERT_LT(steps, 2500u);
+                glm::ivec2 dir = field.GetDirection(cell.x, cell.y);
+                glm::ivec2 next = cell + dir;
+                ASSERT_TRUE(grid.IsWalkable(next.x, next.y));
+                if (dir.x && dir.y) {
+                    // 不切角
+                    ASSERT_TRUE(grid.IsWalkable(cell.x + dir.x, cell.y));
+                    ASSERT_TRUE(grid.IsWalkable(cell.x, cell.y + dir.y));
+                }
+                ASSERT_LT(field.GetCost(next.x, next.y), field.GetCost(cell.x, cell.y));
+                cell = next;
+            }
+        }
+    }
+}
+
+TEST(FlowFieldTest, MaxCostLimitsIntegration) {
+    NavGrid grid(200, 200);
+    FlowField field;
+    field.Compute(grid, {100, 100}, 10.0f);
+    EXPECT_TRUE(field.IsReachable(110, 100));
+    EXPECT_FALSE(field.IsReachable(111, 100));
+    EXPECT_TRUE(field.IsReachable(107, 107));   // 7 × 1.4 = 9.8
+    EXPECT_FALSE(field.IsReachable(108, 108));
+    EXPECT_LT(field.GetReachedCount(), 500u);
+    EXPECT_FLOAT_EQ(field.GetCost(0, 0), -1.0f);
+
+    // 不可走的目标: 整张场不可达
+    grid.SetWalkable(5, 5, false);
+    field.Compute(grid, {5, 5});
+    EXPECT_FALSE(field.IsReachable(5, 5));
+    EXPECT_FALSE(field.IsReachable(6, 6));
+}
+
+TEST(FlowFieldTest, RepairMatchesRecompute) {
+    NavGrid grid = MakeRandomGrid(80, 70, 13, 22);
+    glm::ivec2 goal = {40, 35};
+    grid.SetWalkable(goal.x, goal.y, true);
+    std::mt19937 rng(8);
+
+    for (f32 maxCost : {1e30f, 25.0f}) {
+        FlowField repaired, fresh;
+        repaired.Compute(grid, goal, maxCost);
+        for (u32 round = 0; round < 20; round++) {
+            // 堵上或打通一小块 (目标格保持可走)
+            u32 before = grid.GetRevision();
+            i32 x0 = (i32)(rng() % 76), y0 = (i32)(rng() % 66);
+            bool walkable = round % 2 == 1;
+            for (i32 y = y0; y < y0 + 4; y++) {
+                for (i32 x = x0; x < x0 + 1 + (i32)(rng() % 4); x++) {
+                    if (glm::ivec2(x, y) != goal) grid.SetWalkable(x, y, walkable);
+                }
+            }
+            glm::ivec2 lo, hi;
+            ASSERT_TRUE(grid.GetChangedRegion(before, lo, hi));
+            if (lo.x <= hi.x) repaired.Repair(grid, lo, hi);
+            fresh.Compute(grid, goal, maxCost);
+
+            EXPECT_EQ(repaired.GetReachedCount(), fresh.GetReachedCount()) << "round " << round;
+            for (i32 y = 0; y < 70; y++) {
+                for (i32 x = 0; x < 80; x++) {
+                    ASSERT_EQ(repaired.IsReachable(x, y), fresh.IsReachable(x, y)) << x << "," << y;
+                    ASSERT_FLOAT_EQ(repaired.GetCost(x, y), fresh.GetCost(x, y)) << x << "," << y;
+                    // 方向可以在等价路径间不同，但必须走到代价更低的可走邻格
+                    glm::ivec2 dir = repaired.GetDirection(x, y);
+                    if (dir == glm::ivec2(0)) continue;
+                    ASSERT_TRUE(grid.IsWalkable(x + dir.x, y + dir.y));
+                    ASSERT_LT(repaired.GetCost(x + dir.x, y + dir.y), repaired.GetCost(x, y));
+                }
+            }
+        }
+    }
+}
+
+TEST(FlowFieldTest, CacheRecomputesOnlyWhenStale) {
+    NavGrid grid(64, 64);
+    FlowFieldCache cache;
+    cache.SetNavGrid(&grid);
+    EXPECT_EQ(cache.Get(1), nullptr);
+
+    cache.RequestGoal(1, {10, 10}, 30.0f);
+    cache.RequestGoal(2, {50, 50}, 30.0f);
+    cache.Update();
+    EXPECT_EQ(cache.GetRecomputedCount(), 2u);
+    ASSERT_NE(cache.Get(1), nullptr);
+    EXPECT_EQ(cache.Get(1)->GetGoal(), glm::ivec2(10, 10));
+
+    // 目标没换格
+    cache.RequestGoal(1, {10, 10}, 30.0f);
+    cache.Update();
+    EXPECT_EQ(cache.GetRecomputedCount(), 0u);
+
+    // 只有换了格的目标重算
+    cache.RequestGoal(1, {11, 10}, 30.0f);
+    cache.Update();
+    EXPECT_EQ(cache.GetRecomputedCount(), 1u);
+    EXPECT_EQ(cache.Get(1)->GetDirection(12, 10), glm::ivec2(-1, 0));
+
+    // 可走性局部变化 → 只修复覆盖到改动的流场；不变的写入不算变化
+    grid.SetWalkable(30, 30, true);
+    cache.Update();
+    EXPECT_EQ(cache.GetRecomputedCount(), 0u);
+    EXPECT_EQ(cache.GetRepairedCount(), 0u);
+    grid.SetWalkable(11, 11, false);
+    cache.Update();
+    EXPECT_EQ(cache.GetRecomputedCount(), 0u);
+    EXPECT_EQ(cache.GetRepairedCount(), 1u);
+    EXPECT_FALSE(cache.Get(1)->IsReachable(11, 11));
+    EXPECT_EQ(cache.Get(2)->GetGridRevision(), grid.GetRevision());
+
+    // 改动记录不够用时整张重算
+    for (u32 i = 0; i <= NavGrid::CHANGE_HISTORY; i++) grid.SetWalkable(40, 5, i % 2 != 0);
+    cache.Update();
+    EXPECT_EQ(cache.GetRecomputedCount(), 2u);
+
+    cache.Remove(2);
+    EXPECT_EQ(cache.Get(2), nullptr);
+}
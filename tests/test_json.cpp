@@ -0,0 +1,217 @@
+/**
+ * @file test_json.cpp
+ * @brief JSON 解析器单元测试
+ *
+ * 测试结构索引 (与逐字节参考实现对照，覆盖跨块进位与转义)、语法校验、
+ * 按需 DOM 访问、字符串转义处理，以及 Prefab 的 JSON 往返。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/core/json.h"
+#include "engine/core/prefab.h"
+
+#include <random>
+
+using namespace Engine;
+
+namespace {
+
+/// 逐字节参考实现: 与 SIMD 版本的位运算定义逐项对应
+bool ReferenceIndex(std::string_view s, std::vector<u32>& out) {
+    out.clear();
+    auto isOp = [](char c) { return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ','; };
+    auto isWs = [](char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; };
+
+    bool inString = false;
+    bool prevNonQuoteScalar = false;
+    u32 backslashRun = 0;
+    for (u32 i = 0; i < s.size(); i++) {
+        char c = s[i];
+        bool escaped = (backslashRun % 2) == 1;
+        backslashRun = (c == '\\') ? (escaped ? 0 : backslashRun) + 1 : 0;
+        if (c == '\\' && escaped) backslashRun = 0;   // 被转义的反斜杠不开启新序列
+
+        bool quote = (c == '"') && !escaped;
+        if (quote) inString = !inString;
+        bool scalar = !isOp(c) && !isWs(c);
+        bool nonQuoteScalar = scalar && !quote;
+        bool stringTail = inString != quote;
+        if ((isOp(c) || (scalar && !prevNonQuoteScalar)) && !stringTail) out.push_back(i);
+        prevNonQuoteScalar = nonQuoteScalar;
+    }
+    return !inString;
+}
+
+} // namespace
+
+// ── 结构索引 ────────────────────────────────────────────────
+
+TEST(JsonTest, StructuralIndexSimple) {
+    std::vector<u32> pos;
+    ASSERT_TRUE(JsonDocument::BuildStructuralIndex(R"({"a": [1, true], "b:{": "x"})", pos));
+    // {  "a"  :  [  1  ,  true  ]  ,  "b:{"  :  "x"  }
+    std::vector<u32> expected = {0, 1, 4, 6, 7, 8, 10, 14, 15, 17, 22, 24, 27};
+    EXPECT_EQ(pos, expected);
+}
+
+TEST(JsonTest, StructuralIndexMatchesReference) {
+    const char alphabet[] = "\"\\{}[]:, \nab1-";
+    std::mt19937 rng(1234);
+    for (int iter = 0; iter < 2000; iter++) {
+        std::string s(rng() % 300, ' ');
+        // 偏向生成长反斜杠序列，覆盖跨 64 字节块的奇偶进位
+        for (auto& c : s) c = (rng() % 4 == 0) ? '\\' : alphabet[rng() % (sizeof(alphabet) - 1)];
+
+        std::vector<u32> simd, ref;
+        bool okSimd = JsonDocument::BuildStructuralIndex(s, simd);
+        bool okRef = ReferenceIndex(s, ref);
+        ASSERT_EQ(okSimd, okRef) << s;
+        ASSERT_EQ(simd, ref) << s;
+    }
+}
+
+// ── 语法校验 ────────────────────────────────────────────────
+
+TEST(JsonTest, RejectsMalformed) {
+    const char* bad[] = {
+        "", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "[1 2]", "{\"a\":tru}",
+        "[\"unterminated]", "{1:2}", "[1]]", "[}", "{\"a\":1} 2", "[nullx]",
+        "1abc", "-", "[-]", "[01]", "[1.]", "[.5]", "[1e]", "[1e+]", "[--1]", "{\"a\":1.5x}", "[+1]",
+    };
+    for (const char* s : bad) {
+        JsonDocument doc;
+        EXPECT_FALSE(doc.Parse(std::string_view(s))) << s;
+        EXPECT_FALSE(doc.GetError().empty());
+        EXPECT_FALSE(doc.GetRoot().IsValid());
+    }
+
+    // 合法数字
+    const char* good[] = {"0", "-0", "[-0.5e-3]", "[0,1E+2,12.25]", "{\"a\":-7}"};
+    for (const char* s : good) {
+        JsonDocument doc;
+        EXPECT_TRUE(doc.Parse(std::string_view(s))) << s << ": " << doc.GetError();
+    }
+}
+
+TEST(JsonTest, LegacyMissingArrayCommas) {
+    // 旧版场景: 仅在开启兼容时接受数组元素之间缺逗号
+    const char* legacy = "[{\"a\":1}{\"a\":2}[3][4],{\"a\":5}]";
+    JsonDocument strict;
+    EXPECT_FALSE(strict.Parse(std::string_view(legacy)));
+    JsonDocument lenient;
+    lenient.SetAllowMissingArrayCommas(true);
+    ASSERT_TRUE(lenient.Parse(std::string_view(legacy))) << lenient.GetError();
+    JsonValue root = lenient.GetRoot();
+    ASSERT_EQ(root.Size(), 5u);
+    EXPECT_EQ(root[1].GetI32("a"), 2);
+    EXPECT_EQ(root[3][0].AsI32(), 4);
+    EXPECT_EQ(root[4].GetI32("a"), 5);
+
+    JsonDocument stillStrict;
+    stillStrict.SetAllowMissingArrayCommas(true);
+    EXPECT_FALSE(stillStrict.Parse(std::string_view("[1 2]")));
+    EXPECT_FALSE(stillStrict.Parse(std::string_view("{\"a\":{}\"b\":1}")));
+}
+
+// ── DOM 访问 ────────────────────────────────────────────────
+
+TEST(JsonTest, AccessValues) {
+    JsonDocument doc;
+    ASSERT_TRUE(doc.Parse(std::string(R"({
+        "name": "Level_0", "uid": 42, "scale": -1.5e2, "ok": true, "none": null,
+        "px": [16, 32], "empty": [], "obj": {}, "nested": {"deep": [{"v": 7}]}
+    })")));
+
+    JsonValue root = doc.GetRoot();
+    ASSERT_TRUE(root.IsObject());
+    EXPECT_EQ(root.Size(), 9u);
+    EXPECT_EQ(root["name"].AsStringView(), "Level_0");
+    EXPECT_TRUE(root["name"].Equals("Level_0"));
+    EXPECT_EQ(root.GetI32("uid"), 42);
+    EXPECT_FLOAT_EQ(root.GetF32("scale"), -150.0f);
+    EXPECT_EQ(root["scale"].AsI32(), -150);
+    EXPECT_TRUE(root.GetBool("ok"));
+    EXPECT_TRUE(root["none"].IsNull());
+    EXPECT_EQ(root.GetI32("missing", 16), 16);
+    EXPECT_EQ(root.GetString("uid", "fallback"), "fallback");  // 类型不符 → 默认值
+
+    EXPECT_EQ(root["px"].Size(), 2u);
+    EXPECT_EQ(root["px"][1].AsI32(), 32);
+    EXPECT_FALSE(root["px"][2].IsValid());
+    EXPECT_EQ(root["empty"].Size(), 0u);
+    EXPECT_EQ(root["obj"].Size(), 0u);
+    EXPECT_EQ(root["nested"]["deep"][0].GetI32("v"), 7);
+
+    std::vector<std::string_view> keys;
+    for (const auto& m : root.Members()) keys.push_back(m.Key);
+    ASSERT_EQ(keys.size(), 9u);
+    EXPECT_EQ(keys.front(), "name");
+    EXPECT_EQ(keys.back(), "nested");
+
+    i32 sum = 0;
+    for (JsonValue v : root["px"].Elements()) sum += v.AsI32();
+    EXPECT_EQ(sum, 48);
+}
+
+TEST(JsonTest, StringEscapes) {
+    JsonDocument doc;
+    ASSERT_TRUE(doc.Parse(std::string_view(R"(["a\"b\\", "tab\tnl\n", "中文", "😀", ""])")));
+    JsonValue root = doc.GetRoot();
+    EXPECT_EQ(root[0].AsString(), "a\"b\\");
+    EXPECT_EQ(root[0].AsStringView(), R"(a\"b\\)");   // 原始内容不处理转义
+    EXPECT_EQ(root[1].AsString(), "tab\tnl\n");
+    EXPECT_EQ(root[2].AsString(), "中文");
+    EXPECT_EQ(root[3].AsString(), "\xF0\x9F\x98\x80");
+    EXPECT_EQ(root[4].AsString(), "");
+}
+
+TEST(JsonTest, LargeDocumentAcrossBlocks) {
+    std::string json = "[";
+    for (int i = 0; i < 5000; i++) {
+        if (i) json += ",";
+        json += "{\"id\":" + std::to_string(i) + ",\"s\":\"x\\\\\\\"y\"}";
+    }
+    json += "]";
+
+    JsonDocument doc;
+    ASSERT_TRUE(doc.Parse(json)) << doc.GetError();
+    JsonValue root = doc.GetRoot();
+    EXPECT_EQ(root.Size(), 5000u);
+    i64 sum = 0;
+    for (JsonValue v : root.Elements()) {
+        sum += v.GetI32("id");
+        ASSERT_EQ(v["s"].AsString(), "x\\\"y");
+    }
+    EXPECT_EQ(sum, 5000 * 4999 / 2);
+}
+
+TEST(JsonTest, PrefabRoundTrip) {
+    Prefab prefab("Crate");
+    auto& root = prefab.GetRoot();
+    root.Name = "Crate";
+    ComponentSnapshot snap;
+    snap.TypeName = "Transform";
+    snap.FloatValues["X"] = 1.5f;
+    snap.FloatValues["ScaleY"] = 2.0f;
+    root.Components.push_back(snap);
+    root.Children.emplace_back();
+    root.Children[0].Name = "Lid";
+    ComponentSnapshot mat;
+    mat.TypeName = "Material";
+    mat.StringValues["TextureName"] = "wood";
+    root.Children[0].Components.push_back(mat);
+
+    auto loaded = Prefab::Deserialize(prefab.Serialize());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->GetName(), "Crate");
+    const auto& r = loaded->GetRoot();
+    ASSERT_EQ(r.Components.size(), 1u);
+    EXPECT_EQ(r.Components[0].TypeName, "Transform");
+    EXPECT_FLOAT_EQ(r.Components[0].FloatValues.at("X"), 1.5f);
+    EXPECT_FLOAT_EQ(r.Components[0].FloatValues.at("ScaleY"), 2.0f);
+    ASSERT_EQ(r.Children.size(), 1u);
+    EXPECT_EQ(r.Children[0].Name, "Lid");
+    EXPECT_EQ(r.Children[0].Components[0].StringValues.at("TextureName"), "wood");
+
+    EXPECT_EQ(Prefab::Deserialize("{\"prefab\": \"x\"}"), nullptr);
+}
@@ -0,0 +1,252 @@
+/**
+ * @file test_mesh_optimizer.cpp
+ * @brief 网格优化单元测试
+ *
+ * 测试三角形重排对 ACMR 的改善且不改变几何、顶点读取重排、顶点量化精度与解压 (副切线重建)、
+ * meshlet 划分的完整性与法线锥剔除，以及量化/meshlet 数据的 cook 往返。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/mesh_optimizer.h"
+#include "engine/core/cooked_asset.h"
+
+#include <glm/gtc/packing.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+using namespace Engine;
+
+namespace {
+
+/// n × n 格子的平面 (z = 0，法线 +Z)，三角形顺序随机打乱
+void MakeGrid(u32 n, std::vector<MeshVertex>& vertices, std::vector<u32>& indices, bool shuffle) {
+    vertices.clear();
+    indices.clear();
+    for (u32 y = 0; y <= n; y++) {
+        for (u32 x = 0; x <= n; x++) {
+            MeshVertex v{};
+            v.Position = {(f32)x, (f32)y, 0.0f};
+            v.Normal = {0, 0, 1};
+            v.TexCoord = {(f32)x / n, (f32)y / n};
+            v.Tangent = {1, 0, 0};
+            v.Bitangent = {0, 1, 0};
+            vertices.push_back(v);
+        }
+    }
+    std::vector<std::array<u32, 3>> tris;
+    for (u32 y = 0; y < n; y++) {
+        for (u32 x = 0; x < n; x++) {
+            u32 i0 = y * (n + 1) + x, i1 = i0 + 1, i2 = i0 + n + 1, i3 = i2 + 1;
+            tris.push_back({i0, i1, i3});
+            tris.push_back({i0, i3, i2});
+        }
+    }
+    if (shuffle) std::shuffle(tris.begin(), tris.end(), std::mt19937(7));
+    for (const auto& t : tris) indices.insert(indices.end(), t.begin(), t.end());
+}
+
+/// 三角形集合 (每个三角形旋转到最小索引在前，保留绕序)
+std::vector<std::array<glm::vec3, 3>> TriangleSet(const std::vector<MeshVertex>& v, const std::vector<u32>& idx) {
+    std::vector<std::array<glm::vec3, 3>> out;
+    for (size_t i = 0; i < idx.size(); i += 3) {
+        std::array<glm::vec3, 3> t = {v[idx[i]].Position, v[idx[i + 1]].Position, v[idx[i + 2]].Position};
+        auto less = [](const glm::vec3& a, const glm::vec3& b) {
+            return std::tie(a.x, a.y, a.z) < std::tie(b.x, b.y, b.z);
+        };
+        while (less(t[1], t[0]) || less(t[2], t[0])) std::rotate(t.begin(), t.begin() + 1, t.end());
+        out.push_back(t);
+    }
+    std::sort(out.begin(), out.end(), [](const auto& a, const auto& b) {
+        for (int k = 0; k < 3; k++) {
+            if (a[k] != b[k]) return std::tie(a[k].x, a[k].y, a[k].z) < std::tie(b[k].x, b[k].y, b[k].z);
+        }
+        return false;
+    });
+    return out;
+}
+
+} // namespace
+
+TEST(MeshOptimizerTest, VertexCacheImprovesAcmr) {
+    std::vector<MeshVertex> vertices;
+    std::vector<u32> indices;
+    MakeGrid(64, vertices, indices, true);
+    auto original = TriangleSet(vertices, indices);
+
+    auto before = MeshOptimizer::AnalyzeVertexCache(indices.data(), (u32)indices.size(), (u32)vertices.size());
+    std::vector<u32> clusters;
+    MeshOptimizer::OptimizeVertexCache(indices.data(), (u32)indices.size(), (u32)vertices.size(),
+                                       MeshOptimizer::DEFAULT_CACHE_SIZE, &clusters);
+    auto after = MeshOptimizer::AnalyzeVertexCache(indices.data(), (u32)indices.size(), (u32)vertices.size());
+
+    EXPECT_GT(before.ACMR, 2.0f);
+    EXPECT_LT(after.ACMR, 0.8f);
+    EXPECT_LT(after.ATVR, 1.5f);
+    ASSERT_FALSE(clusters.empty());
+    EXPECT_EQ(clusters[0], 0u);
+    EXPECT_TRUE(std::is_sorted(clusters.begin(), clusters.end()));
+    EXPECT_EQ(TriangleSet(vertices, indices), original);
+
+    // 过度绘制排序只允许有限地牺牲缓存效率
+    MeshOptimizer::OptimizeOverdraw(indices.data(), (u32)indices.size(), vertices.data(),
+                                    (u32)vertices.size(), clusters, 1.05f);
+    auto overdraw = MeshOptimizer::AnalyzeVertexCache(indices.data(), (u32)indices.size(), (u32)vertices.size());
+    EXPECT_LT(overdraw.ACMR, after.ACMR * 1.15f);
+    EXPECT_EQ(TriangleSet(vertices, indices), original);
+}
+
+TEST(MeshOptimizerTest, VertexFetchFirstUseOrder) {
+    std::vector<MeshVertex> vertices;
+    std::vector<u32> indices;
+    MakeGrid(8, vertices, indices, true);
+    MeshVertex unused{};
+    unused.Position = {-100, -100, -100};
+    vertices.insert(vertices.begin() + 3, unused);   // 未引用顶点
+    for (u32& i : indices) if (i >= 3) i++;
+    auto original = TriangleSet(vertices, indices);
+
+    u32 count = MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+    EXPECT_EQ(count, 81u);
+    EXPECT_EQ(vertices.size(), 81u);
+    EXPECT_EQ(TriangleSet(vertices, indices), original);
+
+    // 每个索引首次出现时恰好等于已出现的最大值 + 1
+    u32 next = 0;
+    for (u32 i : indices) {
+        ASSERT_LE(i, next);
+        if (i == next) next++;
+    }
+}
+
+TEST(MeshOptimizerTest, QuantizePrecision) {
+    std::vector<MeshVertex> vertices(3);
+    vertices[0].Position = {1.25f, -3.5f, 100.0f};
+    vertices[0].Normal = glm::normalize(glm::vec3(1, 2, 3));
+    vertices[0].TexCoord = {0.3f, 4.75f};
+    vertices[0].Tangent = glm::normalize(glm::vec3(3, 0, -1));
+    vertices[0].Bitangent = glm::cross(vertices[0].Normal, vertices[0].Tangent);
+    vertices[1] = vertices[0];
+    vertices[1].Bitangent = -vertices[0].Bitangent;   // 镜像 UV
+    vertices[2].Normal = {0, 0, 0};                   // 退化输入不应产生 NaN
+
+    std::vector<PackedMeshVertex> packed;
+    MeshOptimizer::Quantize(vertices.data(), 3, packed);
+    ASSERT_EQ(packed.size(), 3u);
+
+    const auto& p = packed[0];
+    glm::vec3 pos(glm::unpackHalf1x16(p.Position[0]), glm::unpackHalf1x16(p.Position[1]),
+                  glm::unpackHalf1x16(p.Position[2]));
+    EXPECT_NEAR(pos.x, 1.25f, 1e-3f);
+    EXPECT_NEAR(pos.y, -3.5f, 1e-3f);
+    EXPECT_NEAR(pos.z, 100.0f, 0.1f);
+
+    glm::vec4 n = glm::unpackSnorm3x10_1x2(p.Normal);
+    glm::vec4 t = glm::unpackSnorm3x10_1x2(p.Tangent);
+    EXPECT_GT(glm::dot(glm::vec3(n), vertices[0].Normal), 0.999f);
+    EXPECT_GT(glm::dot(glm::vec3(t), vertices[0].Tangent), 0.999f);
+    EXPECT_EQ(t.w, 1.0f);
+    EXPECT_EQ(glm::unpackSnorm3x10_1x2(packed[1].Tangent).w, -1.0f);
+
+    EXPECT_NEAR(glm::unpackHalf1x16(p.TexCoord[0]), 0.3f, 1e-3f);
+    EXPECT_NEAR(glm::unpackHalf1x16(p.TexCoord[1]), 4.75f, 1e-3f);
+
+    glm::vec4 fallback = glm::unpackSnorm3x10_1x2(packed[2].Normal);
+    EXPECT_NEAR(fallback.y, 1.0f, 1e-3f);
+}
+
+TEST(MeshOptimizerTest, DequantizeRebuildsBitangent) {
+    std::vector<MeshVertex> vertices(2);
+    vertices[0].Position = {1.25f, -3.5f, 100.0f};
+    vertices[0].Normal = glm::normalize(glm::vec3(1, 2, 3));
+    vertices[0].TexCoord = {0.3f, 4.75f};
+    vertices[0].Tangent = glm::normalize(glm::cross(vertices[0].Normal, glm::vec3(0, 1, 0)));
+    vertices[0].Bitangent = glm::cross(vertices[0].Normal, vertices[0].Tangent);
+    vertices[1] = vertices[0];
+    vertices[1].Bitangent = -vertices[0].Bitangent;   // 镜像 UV
+
+    std::vector<PackedMeshVertex> packed;
+    MeshOptimizer::Quantize(vertices.data(), 2, packed);
+    std::vector<MeshVertex> unpacked;
+    MeshOptimizer::Dequantize(packed.data(), 2, unpacked);
+    ASSERT_EQ(unpacked.size(), 2u);
+
+    for (u32 i = 0; i < 2; i++) {
+        const MeshVertex& a = vertices[i];
+        const MeshVertex& b = unpacked[i];
+        EXPECT_NEAR(glm::length(b.Position - a.Position), 0.0f, 0.1f);
+        EXPECT_NEAR(glm::length(b.TexCoord - a.TexCoord), 0.0f, 1e-3f);
+        EXPECT_GT(glm::dot(b.Normal, a.Normal), 0.999f);
+        EXPECT_GT(glm::dot(b.Tangent, a.Tangent), 0.999f);
+        // 副切线不再是默认的 (0, 0, 1) 或 0，方向含镜像符号
+        EXPECT_GT(glm::dot(b.Bitangent, a.Bitangent), 0.99f);
+    }
+}
+
+TEST(MeshOptimizerTest, MeshletsCoverMeshAndCull) {
+    std::vector<MeshVertex> vertices;
+    std::vector<u32> indices;
+    MakeGrid(32, vertices, indices, false);
+    MeshOptimizer::Optimize(vertices, indices);
+
+    MeshletData data;
+    MeshOptimizer::BuildMeshlets(vertices.data(), (u32)vertices.size(), indices.data(),
+                                 (u32)indices.size(), data);
+    ASSERT_FALSE(data.Meshlets.empty());
+
+    // 还原出的三角形与原网格一致，且每簇不超上限
+    std::vector<u32> rebuilt;
+    for (const auto& m : data.Meshlets) {
+        EXPECT_LE(m.VertexCount, MeshOptimizer::MAX_MESHLET_VERTICES);
+        EXPECT_LE(m.TriangleCount, MeshOptimizer::MAX_MESHLET_TRIANGLES);
+        for (u32 i = 0; i < m.TriangleCount * 3; i++) {
+            u8 local = data.Triangles[m.TriangleOffset + i];
+            ASSERT_LT(local, m.VertexCount);
+            rebuilt.push_back(data.Vertices[m.VertexOffset + local]);
+        }
+        for (u32 i = 0; i < m.VertexCount; i++) {
+            glm::vec3 d = vertices[data.Vertices[m.VertexOffset + i]].Position - m.Center;
+            EXPECT_LE(glm::length(d), m.Radius + 1e-4f);
+        }
+    }
+    EXPECT_EQ(rebuilt, indices);
+
+    // 平面朝 +Z: 从背面看整簇可剔除，从正面看不可
+    const Meshlet& m = data.Meshlets[0];
+    EXPECT_NEAR(m.ConeAxis.z, 1.0f, 1e-4f);
+    EXPECT_NEAR(m.ConeCutoff, 0.0f, 1e-3f);
+    EXPECT_TRUE(m.IsBackfacing(m.Center + glm::vec3(0, 0, -50)));
+    EXPECT_FALSE(m.IsBackfacing(m.Center + glm::vec3(0, 0, 50)));
+}
+
+TEST(MeshOptimizerTest, CookedPackedModelRoundTrip) {
+    std::vector<MeshCpuData> meshes(1);
+    meshes[0].Name = "grid";
+    MakeGrid(16, meshes[0].Vertices, meshes[0].Indices, false);
+
+    CookedModelOptions options;
+    options.Quantize = true;
+    options.Meshlets = true;
+    std::vector<u8> full, packed;
+    CookedAsset::WriteModel(meshes, full);
+    CookedAsset::WriteModel(meshes, packed, options);
+    EXPECT_LT(packed.size(), full.size());
+
+    std::vector<CookedMeshView> views;
+    ASSERT_TRUE(CookedAsset::ReadModel(packed.data(), packed.size(), views));
+    ASSERT_EQ(views.size(), 1u);
+    EXPECT_EQ(views[0].Vertices, nullptr);
+    ASSERT_NE(views[0].PackedVertices, nullptr);
+    EXPECT_EQ(views[0].VertexCount, meshes[0].Vertices.size());
+    EXPECT_EQ(glm::unpackHalf1x16(views[0].PackedVertices[17].Position[0]), 0.0f);
+    EXPECT_EQ(glm::unpackHalf1x16(views[0].PackedVertices[17].Position[1]), 1.0f);
+    ASSERT_GT(views[0].MeshletCount, 0u);
+    EXPECT_EQ(views[0].Meshlets[0].VertexOffset, 0u);
+    EXPECT_EQ(views[0].MeshletTriangles[0], 0u);
+
+    // 不带选项时仍是完整顶点，且无 meshlet
+    ASSERT_TRUE(CookedAsset::ReadModel(full.data(), full.size(), views));
+    EXPECT_NE(views[0].Vertices, nullptr);
+    EXPECT_EQ(views[0].MeshletCount, 0u);
+}
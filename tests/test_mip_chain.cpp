@@ -0,0 +1,80 @@
+/**
+ * @file test_mip_chain.cpp
+ * @brief CPU mip 链生成单元测试
+ *
+ * 测试层级数量/尺寸/内存布局，以及 Box 与 Kaiser 滤波的基本正确性。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/mip_chain.h"
+
+using namespace Engine;
+
+// ── 层级布局 ────────────────────────────────────────────────
+
+TEST(MipChainTest, LevelCount) {
+    EXPECT_EQ(MipChain::CountLevels(1, 1), 1u);
+    EXPECT_EQ(MipChain::CountLevels(256, 256), 9u);
+    EXPECT_EQ(MipChain::CountLevels(4096, 16), 13u);
+    EXPECT_EQ(MipChain::CountLevels(300, 200), 9u);
+}
+
+TEST(MipChainTest, NonPowerOfTwoLayout) {
+    std::vector<u8> pixels(300 * 200 * 3, 128);
+    MipChain chain;
+    ASSERT_TRUE(MipChain::Build(pixels.data(), 300, 200, 3, MipFilter::Box, chain));
+
+    ASSERT_EQ(chain.GetLevelCount(), 9u);
+    EXPECT_EQ(chain.Levels[1].Width, 150u);
+    EXPECT_EQ(chain.Levels[1].Height, 100u);
+    EXPECT_EQ(chain.Levels[2].Width, 75u);
+    EXPECT_EQ(chain.Levels[3].Width, 37u);
+    EXPECT_EQ(chain.Levels.back().Width, 1u);
+    EXPECT_EQ(chain.Levels.back().Height, 1u);
+
+    // 所有层紧密排列
+    size_t expected = 0;
+    for (const auto& lv : chain.Levels) {
+        EXPECT_EQ(lv.Offset, expected);
+        expected += lv.Size;
+    }
+    EXPECT_EQ(chain.GetTotalSize(), expected);
+}
+
+// ── 滤波 ────────────────────────────────────────────────────
+
+TEST(MipChainTest, BoxAveragesQuads) {
+    // 2x2 单通道: 0, 100, 200, 60 → 平均 90
+    u8 pixels[4] = {0, 100, 200, 60};
+    MipChain chain;
+    ASSERT_TRUE(MipChain::Build(pixels, 2, 2, 1, MipFilter::Box, chain));
+    ASSERT_EQ(chain.GetLevelCount(), 2u);
+    EXPECT_EQ(chain.GetLevelData(1)[0], 90);
+}
+
+TEST(MipChainTest, FiltersPreserveConstantColor) {
+    std::vector<u8> pixels(37 * 19 * 4);
+    for (size_t i = 0; i < pixels.size(); i += 4) {
+        pixels[i] = 10; pixels[i + 1] = 80; pixels[i + 2] = 160; pixels[i + 3] = 255;
+    }
+
+    for (MipFilter filter : {MipFilter::Box, MipFilter::Kaiser}) {
+        MipChain chain;
+        ASSERT_TRUE(MipChain::Build(pixels.data(), 37, 19, 4, filter, chain));
+        for (u32 l = 1; l < chain.GetLevelCount(); l++) {
+            const u8* p = chain.GetLevelData(l);
+            EXPECT_EQ(p[0], 10);
+            EXPECT_EQ(p[1], 80);
+            EXPECT_EQ(p[2], 160);
+            EXPECT_EQ(p[3], 255);
+        }
+    }
+}
+
+TEST(MipChainTest, RejectsInvalidInput) {
+    MipChain chain;
+    EXPECT_FALSE(MipChain::Build(nullptr, 4, 4, 4, MipFilter::Box, chain));
+    u8 px[4] = {};
+    EXPECT_FALSE(MipChain::Build(px, 0, 4, 4, MipFilter::Box, chain));
+    EXPECT_FALSE(MipChain::Build(px, 1, 1, 5, MipFilter::Box, chain));
+}
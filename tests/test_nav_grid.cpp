@@ -0,0 +1,302 @@
+/**
+ * @file test_nav_grid.cpp
+ * @brief A* 寻路单元测试
+ *
+ * 测试路径代价与 Dijkstra 参考解一致、路径连续且不切角、不可达/起终点相同等边界情况，
+ * 以及同一工作缓冲连续查询 (代号复用) 与世界坐标接口的换算。
+ * JPS+ 模式的代价与参考解一致；HPA* 模式的可达性与参考解一致、路径合法且接近最短；
+ * 可走性改动后加速数据失效并退回 A*；改动记录覆盖的局部修复与整体重建结果一致。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/behavior_tree.h"
+#include "nav_test_utils.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::NavTest;
+
+namespace {
+
+f32 StepCost(const glm::ivec2& a, const glm::ivec2& b) {
+    return (a.x != b.x && a.y != b.y) ? 1.414f : 1.0f;
+}
+
+/// 路径首尾正确、逐格相邻、可走且不切角，返回总代价
+f32 CheckPath(const NavGrid& grid, const std::vector<glm::ivec2>& path, glm::ivec2 s, glm::ivec2 g) {
+    EXPECT_EQ(path.front(), s);
+    EXPECT_EQ(path.back(), g);
+    f32 cost = 0.0f;
+    for (size_t i = 1; i < path.size(); i++) {
+        glm::ivec2 a = path[i - 1], b = path[i];
+        EXPECT_LE(std::abs(a.x - b.x), 1);
+        EXPECT_LE(std::abs(a.y - b.y), 1);
+        EXPECT_NE(a, b);
+        EXPECT_TRUE(grid.IsWalkable(b.x, b.y));
+        if (a.x != b.x && a.y != b.y) {
+            EXPECT_TRUE(grid.IsWalkable(b.x, a.y));
+            EXPECT_TRUE(grid.IsWalkable(a.x, b.y));
+        }
+        cost += StepCost(a, b);
+    }
+    return cost;
+}
+
+} // namespace
+
+TEST(NavGridTest, PathCostMatchesDijkstra) {
+    NavGrid grid = MakeRandomGrid(48, 40, 17, 28);
+    NavSearchState state;
+    std::vector<glm::ivec2> path;
+    std::mt19937 rng(3);
+
+    u32 found = 0;
+    for (u32 q = 0; q < 300; q++) {
+        glm::ivec2 s = {(i32)(rng() % 48), (i32)(rng() % 40)};
+        glm::ivec2 g = {(i32)(rng() % 48), (i32)(rng() % 40)};
+        f32 expected = ReferenceCost(grid, s, g);
+        bool ok = grid.FindPath(s, g, path, state);
+        ASSERT_EQ(ok, expected >= 0.0f) << q;
+        if (!ok) {
+            EXPECT_TRUE(path.empty());
+            continue;
+        }
+        found++;
+
+        ASSERT_EQ(path.front(), s);
+        ASSERT_EQ(path.back(), g);
+        f32 cost = 0.0f;
+        for (size_t i = 1; i < path.size(); i++) {
+            glm::ivec2 a = path[i - 1], b = path[i];
+            ASSERT_LE(std::abs(a.x - b.x), 1);
+            ASSERT_LE(std::abs(a.y - b.y), 1);
+            ASSERT_TRUE(grid.IsWalkable(b.x, b.y));
+            if (a.x != b.x && a.y != b.y) {
+                // 不切角
+                ASSERT_TRUE(grid.IsWalkable(b.x, a.y));
+                ASSERT_TRUE(grid.IsWalkable(a.x, b.y));
+            }
+            cost += StepCost(a, b);
+        }
+        EXPECT_NEAR(cost, expected, 1e-3f) << q;
+    }
+    EXPECT_GT(found, 100u);
+}
+
+TEST(NavGridTest, EdgeCases) {
+    NavGrid grid(10, 10);
+    NavSearchState state;
+    std::vector<glm::ivec2> path;
+
+    // 起点即终点
+    ASSERT_TRUE(grid.FindPath({3, 3}, {3, 3}, path, state));
+    ASSERT_EQ(path.size(), 1u);
+
+    // 终点被围住
+    for (i32 dy = -1; dy <= 1; dy++) {
+        for (i32 dx = -1; dx <= 1; dx++) {
+            if (dx || dy) grid.SetWalkable(7 + dx, 7 + dy, false);
+        }
+    }
+    EXPECT_FALSE(grid.FindPath({0, 0}, {7, 7}, path, state));
+    EXPECT_TRUE(path.empty());
+    EXPECT_GT(state.GetExpandedCount(), 50u);
+
+    // 越界 / 不可走的起点
+    EXPECT_FALSE(grid.FindPath({-1, 0}, {2, 2}, path, state));
+    EXPECT_FALSE(grid.FindPath({6, 6}, {2, 2}, path, state));
+
+    // 打开一个缺口后同一缓冲再次查询 (代号复用，旧状态不残留)
+    grid.SetWalkable(7, 6, true);
+    ASSERT_TRUE(grid.FindPath({0, 0}, {7, 7}, path, state));
+    EXPECT_EQ(path.back(), glm::ivec2(7, 7));
+}
+
+TEST(NavGridTest, ShortQueryExpandsFewNodes) {
+    // 大网格上的短路径: 展开数只与路径附近有关
+    NavGrid grid(512, 512);
+    NavSearchState state;
+    std::vector<glm::ivec2> path;
+    ASSERT_TRUE(grid.FindPath({100, 100}, {103, 100}, path, state));
+    EXPECT_EQ(path.size(), 4u);
+    EXPECT_LE(state.GetExpandedCount(), 4u);
+}
+
+TEST(NavGridTest, WorldPathUsesXZCellCenters) {
+    NavGrid grid(8, 8, 2.0f);
+    for (i32 y = 0; y < 7; y++) grid.SetWalkable(3, y, false);
+
+    std::vector<glm::vec3> path;
+    ASSERT_TRUE(grid.FindPath({1.0f, 0.0f, 1.0f}, {15.0f, 0.0f, 1.0f}, path));
+    EXPECT_FLOAT_EQ(path.front().x, 1.0f);
+    EXPECT_FLOAT_EQ(path.front().z, 1.0f);
+    EXPECT_FLOAT_EQ(path.back().x, 15.0f);
+    EXPECT_FLOAT_EQ(path.back().z, 1.0f);
+    // 绕过墙顶 (网格 y = 7 → z = 15)
+    bool passedTop = false;
+    for (const glm::vec3& p : path) {
+        EXPECT_FLOAT_EQ(p.y, 0.0f);
+        if (p.x == 7.0f) passedTop = p.z == 15.0f;
+    }
+    EXPECT_TRUE(passedTop);
+
+    // 返回值版本与输出参数版本一致
+    std::vector<glm::vec3> copy = grid.FindPath({1.0f, 0.0f, 1.0f}, {15.0f, 0.0f, 1.0f});
+    EXPECT_EQ(copy, path);
+}
+
+TEST(NavGridTest, JumpPointMatchesDijkstra) {
+    // 不同障碍密度: 稀疏时跳跃很长，稠密时跳点很多
+    for (u32 blocked : {5u, 20u, 35u}) {
+        NavGrid grid = MakeRandomGrid(70, 45, 100 + blocked, blocked);
+        grid.SetSearchMode(NavSearchMode::JumpPoint);
+        NavSearchState state;
+        std::vector<glm::ivec2> path;
+        std::mt19937 rng(blocked);
+
+        for (u32 q = 0; q < 300; q++) {
+            glm::ivec2 s = {(i32)(rng() % 70), (i32)(rng() % 45)};
+            glm::ivec2 g = {(i32)(rng() % 70), (i32)(rng() % 45)};
+            f32 expected = ReferenceCost(grid, s, g);
+            bool ok = grid.FindPath(s, g, path, state);
+            ASSERT_EQ(ok, expected >= 0.0f) << blocked << ":" << q;
+            if (!ok) continue;
+            EXPECT_NEAR(CheckPath(grid, path, s, g), expected, 1e-3f) << blocked << ":" << q;
+        }
+    }
+}
+
+TEST(NavGridTest, JumpPointExpandsFewerNodesInOpenAreas) {
+    NavGrid grid(200, 200);
+    for (i32 y = 20; y < 180; y++) grid.SetWalkable(100, y, false);
+    NavSearchState state;
+    std::vector<glm::ivec2> path;
+
+    ASSERT_TRUE(grid.FindPath({10, 100}, {190, 100}, path, state));
+    u32 astar = state.GetExpandedCount();
+
+    grid.SetSearchMode(NavSearchMode::JumpPoint);
+    ASSERT_TRUE(grid.FindPath({10, 100}, {190, 100}, path, state));
+    EXPECT_LT(state.GetExpandedCount() * 20, astar);
+}
+
+TEST(NavGridTest, HierarchicalPathsAreValidAndNearOptimal) {
+    NavGrid grid = MakeRandomGrid(90, 70, 41, 22);
+    // 几道长墙，迫使路径跨越多个簇
+    for (i32 y = 0; y < 60; y++) grid.SetWalkable(30, y, false);
+    for (i32 y = 10; y < 70; y++) grid.SetWalkable(60, y, false);
+    grid.SetSearchMode(NavSearchMode::Hierarchical);
+    EXPECT_GT(grid.GetAbstractNodeCount(), 0u);
+
+    NavSearchState state;
+    std::vector<glm::ivec2> path;
+    std::mt19937 rng(8);
+    f32 optimal = 0.0f, found = 0.0f;
+    for (u32 q = 0; q < 300; q++) {
+        glm::ivec2 s = {(i32)(rng() % 90), (i32)(rng() % 70)};
+        glm::ivec2 g = {(i32)(rng() % 90), (i32)(rng() % 70)};
+        f32 expected = ReferenceCost(grid, s, g);
+        bool ok = grid.FindPath(s, g, path, state);
+        ASSERT_EQ(ok, expected >= 0.0f) << q;
+        if (!ok) continue;
+        f32 cost = CheckPath(grid, path, s, g);
+        EXPECT_GE(cost, expected - 1e-3f);
+        EXPECT_LE(cost, expected * 1.5f + 2.0f) << q;
+        optimal += expected;
+        found += cost;
+    }
+    // 整体只比最短路径长一点
+    EXPECT_LT(found, optimal * 1.15f);
+}
+
+TEST(NavGridTest, SearchDataInvalidatedByWalkableChanges) {
+    NavGrid grid(40, 40);
+    grid.SetSearchMode(NavSearchMode::JumpPoint);
+    EXPECT_TRUE(grid.IsSearchDataValid());
+
+    // 可走性不变的写入不会让数据失效
+    grid.SetWalkable(5, 5, true);
+    EXPECT_TRUE(grid.IsSearchDataValid());
+
+    for (i32 y = 0; y < 39; y++) grid.SetWalkable(20, y, false);
+    EXPECT_FALSE(grid.IsSearchDataValid());
+
+    // 失效期间网格坐标版退回 A*，结果仍然正确
+    NavSearchState state;
+    std::vector<glm::ivec2> path;
+    ASSERT_TRUE(grid.FindPath({2, 2}, {30, 2}, path, state));
+    EXPECT_NEAR(CheckPath(grid, path, {2, 2}, {30, 2}), ReferenceCost(grid, {2, 2}, {30, 2}), 1e-3f);
+
+    // 世界坐标版会先重建
+    std::vector<glm::vec3> world;
+    ASSERT_TRUE(grid.FindPath({2.5f, 0.0f, 2.5f}, {30.5f, 0.0f, 2.5f}, world));
+    EXPECT_TRUE(grid.IsSearchDataValid());
+    ASSERT_TRUE(grid.FindPath({2, 2}, {30, 2}, path, state));
+    EXPECT_NEAR(CheckPath(grid, path, {2, 2}, {30, 2}), ReferenceCost(grid, {2, 2}, {30, 2}), 1e-3f);
+}
+
+TEST(NavGridTest, ChangedRegionTracksEdits) {
+    NavGrid grid(64, 64);
+    glm::ivec2 lo, hi;
+    ASSERT_TRUE(grid.GetChangedRegion(grid.GetRevision(), lo, hi));
+    EXPECT_GT(lo.x, hi.x);   // 没有改动
+
+    u32 before = grid.GetRevision();
+    grid.SetWalkable(10, 20, false);
+    grid.SetWalkable(12, 18, false);
+    grid.SetWalkable(12, 18, false);   // 不变的写入不记录
+    EXPECT_EQ(grid.GetRevision(), before + 2);
+    ASSERT_TRUE(grid.GetChangedRegion(before, lo, hi));
+    EXPECT_EQ(lo, glm::ivec2(10, 18));
+    EXPECT_EQ(hi, glm::ivec2(12, 20));
+    ASSERT_TRUE(grid.GetChangedRegion(before + 1, lo, hi));
+    EXPECT_EQ(lo, glm::ivec2(12, 18));
+    EXPECT_EQ(hi, glm::ivec2(12, 18));
+
+    // 超出记录长度: 返回 false，矩形为整张网格
+    for (u32 i = 0; i <= NavGrid::CHANGE_HISTORY; i++) grid.SetWalkable(0, 0, i % 2 != 0);
+    EXPECT_FALSE(grid.GetChangedRegion(before, lo, hi));
+    EXPECT_EQ(lo, glm::ivec2(0, 0));
+    EXPECT_EQ(hi, glm::ivec2(63, 63));
+}
+
+TEST(NavGridTest, IncrementalRepairMatchesRebuild) {
+    for (NavSearchMode mode : {NavSearchMode::JumpPoint, NavSearchMode::Hierarchical}) {
+        NavGrid grid = MakeRandomGrid(96, 80, 21, 20);
+        grid.SetSearchMode(mode);
+        std::mt19937 rng(4);
+        NavSearchState repairedState, rebuiltState;
+        std::vector<glm::ivec2> repairedPath, rebuiltPath;
+
+        for (u32 round = 0; round < 12; round++) {
+            // 随机一块小矩形 (含簇边界附近) 整块堵上或打通，再零星改几格
+            i32 x0 = (i32)(rng() % 90), y0 = (i32)(rng() % 74);
+            bool walkable = round % 3 == 0;
+            for (i32 y = y0; y < y0 + 1 + (i32)(rng() % 6); y++) {
+                for (i32 x = x0; x < x0 + 1 + (i32)(rng() % 6); x++) grid.SetWalkable(x, y, walkable);
+            }
+            grid.SetWalkable(x0 + 3, y0 - 1, !walkable);
+            grid.UpdateSearchData();
+            ASSERT_TRUE(grid.IsSearchDataValid());
+
+            NavGrid rebuilt = grid;
+            rebuilt.SetSearchMode(mode);
+            EXPECT_EQ(grid.GetAbstractNodeCount(), rebuilt.GetAbstractNodeCount());
+            EXPECT_EQ(grid.GetAbstractEdgeCount(), rebuilt.GetAbstractEdgeCount());
+
+            for (u32 q = 0; q < 40; q++) {
+                glm::ivec2 s = {(i32)(rng() % 96), (i32)(rng() % 80)};
+                glm::ivec2 g = {(i32)(rng() % 96), (i32)(rng() % 80)};
+                repairedPath.clear();
+                rebuiltPath.clear();
+                bool found = grid.FindPath(s, g, repairedPath, repairedState);
+                ASSERT_EQ(found, rebuilt.FindPath(s, g, rebuiltPath, rebuiltState));
+                ASSERT_EQ(repairedPath, rebuiltPath) << "round " << round << " query " << q;
+                EXPECT_EQ(repairedState.GetExpandedCount(), rebuiltState.GetExpandedCount());
+            }
+        }
+    }
+}
@@ -0,0 +1,341 @@
+/**
+ * @file test_pack_archive.cpp
+ * @brief 资源包与 cook 二进制格式单元测试
+ *
+ * 测试 PackWriter → PackArchive (mmap) 往返、截断/溢出的头部与条目被拒绝、各类 cooked blob 的
+ * 编解码，以及 BC1/BC3 块压缩的基本精度。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/core/pack_archive.h"
+#include "engine/core/cooked_asset.h"
+#include "engine/renderer/bc_encoder.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+std::string TempPackPath(const char* name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// 把 blob 放进包再 mmap 读回，确保读取端看到的是对齐的映射内存
+struct PackRoundTrip {
+    std::string Path;
+    PackArchive Archive;
+
+    PackRoundTrip(const char* file, const PackWriter& writer) : Path(TempPackPath(file)) {
+        EXPECT_TRUE(writer.Write(Path));
+        EXPECT_TRUE(Archive.Open(Path));
+    }
+    ~PackRoundTrip() {
+        Archive.Close();
+        std::remove(Path.c_str());
+    }
+};
+
+} // namespace
+
+// ── 资源包 ──────────────────────────────────────────────────
+
+TEST(PackArchiveTest, WriteAndLookup) {
+    PackWriter writer;
+    const char a[] = "hello";
+    const u32 b[] = {1, 2, 3, 4, 5};
+    writer.Add("text/a.txt", PackAssetType::Raw, a, sizeof(a));
+    writer.Add("data/b.bin", PackAssetType::Scene, b, sizeof(b), 7);
+    writer.Add("text/a.txt", PackAssetType::Raw, "world", 6);   // 覆盖同名
+    EXPECT_EQ(writer.GetEntryCount(), 2u);
+
+    PackRoundTrip rt("engine_test_lookup.pak", writer);
+    ASSERT_TRUE(rt.Archive.IsOpen());
+    EXPECT_EQ(rt.Archive.GetEntryCount(), 2u);
+
+    PackBlob text = rt.Archive.Lookup("text/a.txt", PackAssetType::Raw);
+    ASSERT_TRUE(text);
+    EXPECT_STREQ((const char*)text.Data, "world");
+
+    PackBlob bin = rt.Archive.Lookup("data/b.bin", PackAssetType::Scene);
+    ASSERT_TRUE(bin);
+    EXPECT_EQ(bin.Size, sizeof(b));
+    EXPECT_EQ(bin.Flags, 7u);
+    EXPECT_EQ((uintptr_t)bin.Data % PACK_ALIGNMENT, 0u);
+    EXPECT_EQ(((const u32*)bin.Data)[4], 5u);
+
+    // 类型不符 / 不存在
+    EXPECT_FALSE(rt.Archive.Lookup("data/b.bin", PackAssetType::Mesh));
+    EXPECT_FALSE(rt.Archive.Lookup("missing", PackAssetType::Raw));
+}
+
+TEST(PackArchiveTest, RejectsCorruptFile) {
+    std::string path = TempPackPath("engine_test_corrupt.pak");
+    FILE* f = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(f, nullptr);
+    const char junk[64] = "not a pack";
+    std::fwrite(junk, 1, sizeof(junk), f);
+    std::fclose(f);
+
+    PackArchive archive;
+    EXPECT_FALSE(archive.Open(path));
+    EXPECT_FALSE(archive.IsOpen());
+    std::remove(path.c_str());
+}
+
+TEST(PackArchiveTest, RejectsTruncatedAndOverflowingHeaders) {
+    PackWriter writer;
+    writer.Add("a.bin", PackAssetType::Raw, "abcdefgh", 8);
+    writer.Add("b.bin", PackAssetType::Raw, "12345678", 8);
+    std::string path = TempPackPath("engine_test_overflow.pak");
+    ASSERT_TRUE(writer.Write(path));
+
+    std::vector<u8> good;
+    {
+        std::ifstream in(path, std::ios::binary);
+        good.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    ASSERT_GE(good.size(), sizeof(PackHeader));
+    PackHeader header;
+    std::memcpy(&header, good.data(), sizeof(header));
+
+    // 改写一份副本后打开，期望失败
+    auto opens = [&](const std::function<void(std::vector<u8>&)>& corrupt) {
+        std::vector<u8> bytes = good;
+        corrupt(bytes);
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+        }
+        PackArchive archive;
+        bool ok = archive.Open(path);
+        EXPECT_EQ(ok, archive.IsOpen());
+        return ok;
+    };
+    auto setHeader = [](std::vector<u8>& bytes, const PackHeader& h) {
+        std::memcpy(bytes.data(), &h, sizeof(h));
+    };
+    const u64 huge = std::numeric_limits<u64>::max() - 7;
+
+    EXPECT_TRUE(opens([](std::vector<u8>&) {}));
+
+    // 截断: 名称表 / TOC 落在文件外
+    EXPECT_FALSE(opens([](std::vector<u8>& b) { b.resize(b.size() - 3); }));
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { b.resize(header.TocOffset + 8); }));
+
+    // TocOffset + EntryCount * 32 回绕
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { PackHeader h = header; h.TocOffset = huge; setHeader(b, h); }));
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { PackHeader h = header; h.EntryCount = 0xFFFFFFFFu; setHeader(b, h); }));
+    // NamesOffset + NamesSize 回绕
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { PackHeader h = header; h.NamesSize = huge; setHeader(b, h); }));
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { PackHeader h = header; h.NamesOffset = huge; setHeader(b, h); }));
+    // 名称表为空 / 不以 0 结尾
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { PackHeader h = header; h.NamesSize = 0; setHeader(b, h); }));
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) { b.back() = 'x'; }));
+
+    // 条目 Offset + Size 回绕
+    EXPECT_FALSE(opens([&](std::vector<u8>& b) {
+        PackEntry e;
+        std::memcpy(&e, b.data() + header.TocOffset, sizeof(e));
+        e.Offset = 16;
+        e.Size = huge;
+        std::memcpy(b.data() + header.TocOffset, &e, sizeof(e));
+    }));
+
+    std::remove(path.c_str());
+
+    // 空包仍可打开
+    PackWriter empty;
+    PackRoundTrip rt("engine_test_empty.pak", empty);
+    EXPECT_EQ(rt.Archive.GetEntryCount(), 0u);
+}
+
+// ── Cooked 格式 ─────────────────────────────────────────────
+
+TEST(CookedAssetTest, ModelRoundTrip) {
+    std::vector<MeshCpuData> meshes(2);
+    meshes[0].Name = "gltf_Body";
+    meshes[0].AlbedoTexPath = "models/body.png";
+    for (u32 i = 0; i < 5; i++) {
+        MeshVertex v{};
+        v.Position = {(f32)i, 0, 0};
+        meshes[0].Vertices.push_back(v);
+    }
+    meshes[0].Indices = {0, 1, 2, 2, 3, 4};
+    meshes[1].Name = "gltf_Empty";
+
+    std::vector<u8> blob;
+    CookedAsset::WriteModel(meshes, blob);
+
+    PackWriter writer;
+    writer.Add("models/a.gltf", PackAssetType::Mesh, blob);
+    PackRoundTrip rt("engine_test_model.pak", writer);
+    PackBlob packed = rt.Archive.Lookup("models/a.gltf", PackAssetType::Mesh);
+    ASSERT_TRUE(packed);
+
+    std::vector<CookedMeshView> views;
+    ASSERT_TRUE(CookedAsset::ReadModel(packed.Data, packed.Size, views));
+    ASSERT_EQ(views.size(), 2u);
+    EXPECT_STREQ(views[0].Name, "gltf_Body");
+    EXPECT_STREQ(views[0].AlbedoTexPath, "models/body.png");
+    EXPECT_STREQ(views[0].NormalTexPath, "");
+    EXPECT_EQ(views[0].VertexCount, 5u);
+    EXPECT_EQ(views[0].IndexCount, 6u);
+    EXPECT_FLOAT_EQ(views[0].Vertices[4].Position.x, 4.0f);
+    EXPECT_EQ(views[0].Indices[5], 4u);
+    EXPECT_EQ((uintptr_t)views[0].Vertices % 16, 0u);
+    EXPECT_EQ(views[1].VertexCount, 0u);
+
+    // 截断数据必须被拒绝
+    EXPECT_FALSE(CookedAsset::ReadModel(blob.data(), 40, views));
+}
+
+TEST(CookedAssetTest, TextureMipsRaw) {
+    std::vector<u8> pixels(8 * 4 * 4, 200);
+    MipChain chain;
+    ASSERT_TRUE(MipChain::Build(pixels.data(), 8, 4, 4, MipFilter::Box, chain));
+
+    std::vector<u8> blob;
+    ASSERT_TRUE(CookedAsset::WriteTexture(chain, CookedTextureFormat::Raw8, blob));
+
+    CookedTextureView view;
+    ASSERT_TRUE(CookedAsset::ReadTexture(blob.data(), blob.size(), view));
+    EXPECT_EQ(view.Width, 8u);
+    EXPECT_EQ(view.Height, 4u);
+    EXPECT_EQ(view.Channels, 4u);
+    ASSERT_EQ(view.LevelCount, chain.GetLevelCount());
+    for (u32 i = 0; i < view.LevelCount; i++) {
+        EXPECT_EQ(view.Levels[i].Width, chain.Levels[i].Width);
+        EXPECT_EQ(view.Levels[i].Size, chain.Levels[i].Size);
+        EXPECT_EQ(view.Levels[i].Offset % 16, 0u);
+        EXPECT_EQ(std::memcmp(view.GetLevelData(i), chain.GetLevelData(i), chain.Levels[i].Size), 0);
+    }
+}
+
+TEST(CookedAssetTest, TextureMipsCompressed) {
+    std::vector<u8> pixels(16 * 16 * 3, 90);
+    MipChain chain;
+    ASSERT_TRUE(MipChain::Build(pixels.data(), 16, 16, 3, MipFilter::Box, chain));
+
+    std::vector<u8> blob;
+    ASSERT_TRUE(CookedAsset::WriteTexture(chain, CookedTextureFormat::BC1, blob));
+
+    CookedTextureView view;
+    ASSERT_TRUE(CookedAsset::ReadTexture(blob.data(), blob.size(), view));
+    EXPECT_EQ(view.Format, CookedTextureFormat::BC1);
+    EXPECT_EQ(view.Levels[0].Size, 4u * 4u * 8u);     // 4x4 块
+    EXPECT_EQ(view.Levels[4].Size, 8u);               // 1x1 也占整块
+}
+
+TEST(CookedAssetTest, PrefabRoundTrip) {
+    Prefab prefab("Zombie");
+    auto& root = prefab.GetRoot();
+    root.Name = "ZombieRoot";
+    ComponentSnapshot tr;
+    tr.TypeName = "Transform";
+    tr.FloatValues["X"] = 1.5f;
+    tr.StringValues["Mesh"] = "cube";
+    root.Components.push_back(tr);
+    root.Children.push_back({"Head", {}, {}});
+
+    std::vector<u8> blob;
+    CookedAsset::WritePrefab(prefab, blob);
+    auto loaded = CookedAsset::ReadPrefab(blob.data(), blob.size());
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->GetName(), "Zombie");
+    EXPECT_EQ(loaded->GetRoot().Name, "ZombieRoot");
+    ASSERT_EQ(loaded->GetRoot().Components.size(), 1u);
+    EXPECT_FLOAT_EQ(loaded->GetRoot().Components[0].FloatValues.at("X"), 1.5f);
+    EXPECT_EQ(loaded->GetRoot().Components[0].StringValues.at("Mesh"), "cube");
+    ASSERT_EQ(loaded->GetRoot().Children.size(), 1u);
+    EXPECT_EQ(loaded->GetRoot().Children[0].Name, "Head");
+
+    EXPECT_EQ(CookedAsset::ReadPrefab(blob.data(), blob.size() - 3), nullptr);
+}
+
+TEST(CookedAssetTest, LdtkRoundTrip) {
+    LdtkProject project;
+    project.basePath = "maps/";
+    project.defaultGridSize = 16;
+    LdtkLevel level;
+    level.identifier = "Level_0";
+    level.uid = 3;
+    level.worldX = 0; level.worldY = 0; level.pxWid = 64; level.pxHei = 32;
+    LdtkLayer layer{};
+    layer.identifier = "Ground";
+    layer.type = "Tiles";
+    layer.gridSize = 16; layer.gridW = 4; layer.gridH = 2;
+    layer.tilesetRelPath = "tiles.png";
+    layer.tiles.push_back({16, 0, 32, 48, 1});
+    layer.intGrid = {1, -1, 2, 0, 0, 0, 0, 1};
+    LdtkEntity ent;
+    ent.identifier = "PlayerSpawn";
+    ent.fields["hp"] = 100;
+    ent.fields["speed"] = 2.5f;
+    ent.fields["boss"] = true;
+    ent.fields["tag"] = std::string("p1");
+    layer.entities.push_back(ent);
+    level.layers.push_back(layer);
+    project.levels.push_back(level);
+
+    std::vector<u8> blob;
+    CookedAsset::WriteLdtk(project, blob);
+
+    LdtkProject loaded;
+    ASSERT_TRUE(CookedAsset::ReadLdtk(blob.data(), blob.size(), loaded));
+    EXPECT_EQ(loaded.basePath, "maps/");
+    ASSERT_EQ(loaded.levels.size(), 1u);
+    const auto& l = loaded.levels[0].layers.at(0);
+    EXPECT_EQ(l.identifier, "Ground");
+    ASSERT_EQ(l.tiles.size(), 1u);
+    EXPECT_EQ(l.tiles[0].src_y, 48);
+    EXPECT_EQ(l.tiles[0].flip, 1);
+    EXPECT_EQ(l.intGrid, layer.intGrid);
+    const auto& f = l.entities.at(0).fields;
+    EXPECT_EQ(std::get<i32>(f.at("hp")), 100);
+    EXPECT_FLOAT_EQ(std::get<f32>(f.at("speed")), 2.5f);
+    EXPECT_TRUE(std::get<bool>(f.at("boss")));
+    EXPECT_EQ(std::get<std::string>(f.at("tag")), "p1");
+}
+
+// ── BC 压缩 ─────────────────────────────────────────────────
+
+TEST(BcEncoderTest, SolidBlockIsExact) {
+    // 565 可精确表示的颜色: 压缩后应无损
+    u8 rgba[64];
+    for (int i = 0; i < 16; i++) {
+        rgba[i * 4 + 0] = 255; rgba[i * 4 + 1] = 0; rgba[i * 4 + 2] = 255; rgba[i * 4 + 3] = 77;
+    }
+    u8 block[16], decoded[64];
+    BcEncoder::EncodeBlockBC3(rgba, block);
+    BcEncoder::DecodeBlockBC3(block, decoded);
+    for (int i = 0; i < 64; i++) EXPECT_EQ(decoded[i], rgba[i]) << "byte " << i;
+}
+
+TEST(BcEncoderTest, GradientErrorIsBounded) {
+    u8 rgba[64];
+    for (int i = 0; i < 16; i++) {
+        u8 v = (u8)(i * 16);
+        rgba[i * 4 + 0] = v; rgba[i * 4 + 1] = v; rgba[i * 4 + 2] = (u8)(255 - v); rgba[i * 4 + 3] = 255;
+    }
+    u8 block[8], decoded[64];
+    BcEncoder::EncodeBlockBC1(rgba, block);
+    BcEncoder::DecodeBlockBC1(block, decoded);
+
+    int maxErr = 0;
+    for (int i = 0; i < 16; i++) {
+        for (int c = 0; c < 3; c++)
+            maxErr = std::max(maxErr, std::abs((int)decoded[i * 4 + c] - (int)rgba[i * 4 + c]));
+        EXPECT_EQ(decoded[i * 4 + 3], 255);
+    }
+    // 4 级调色板覆盖 0..240 的跨度，单通道误差不应超过半个台阶 + 量化误差
+    EXPECT_LE(maxErr, 48);
+}
@@ -0,0 +1,316 @@
+/**
+ * @file test_particles.cpp
+ * @brief 粒子发射器单元测试
+ *
+ * 测试 SoA 发射器的预算上限、交换压缩、SIMD 内核与逐粒子标量参考一致，
+ * 以及多发射器经 JobSystem 并行更新与串行更新结果相同；
+ * 绘制列表的视锥/距离剔除、发射率 LOD 与 alpha 混合粒子的从后往前基数排序。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/particle_emitter.h"
+#include "engine/core/job_system.h"
+#include "engine/core/radix_sort.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+ParticleEmitterConfig MakeConfig(u32 budget) {
+    ParticleEmitterConfig cfg;
+    cfg.MaxParticles = budget;
+    cfg.EmitRate = 1000;
+    cfg.MinLife = 0.5f;
+    cfg.MaxLife = 1.5f;
+    cfg.SizeStart = 1.0f;
+    cfg.SizeEnd = 0.25f;
+    cfg.AlphaStart = 0.9f;
+    cfg.AlphaEnd = 0.1f;
+    cfg.Drag = 0.5f;
+    return cfg;
+}
+
+/// 单个粒子的标量状态，按 Simulate 的公式逐步积分
+struct ScalarParticle {
+    glm::vec3 Position, Velocity, Color;
+    f32 Life, MaxLife, BaseSize, Size, Alpha;
+
+    void Step(const ParticleEmitterConfig& cfg, f32 dt) {
+        Life -= dt;
+        f32 t = std::clamp(1.0f - Life / MaxLife, 0.0f, 1.0f);
+        f32 damping = std::max(0.0f, 1.0f - cfg.Drag * dt);
+        Velocity.y += cfg.Gravity * dt;
+        Velocity *= damping;
+        Position += Velocity * dt;
+        Color = cfg.ColorStart + (cfg.ColorEnd - cfg.ColorStart) * t;
+        Alpha = cfg.AlphaStart + (cfg.AlphaEnd - cfg.AlphaStart) * t;
+        Size = BaseSize * (cfg.SizeStart + (cfg.SizeEnd - cfg.SizeStart) * t);
+    }
+};
+
+ScalarParticle ReadParticle(const ParticleEmitter& e, u32 i) {
+    using S = ParticleEmitter;
+    ScalarParticle p;
+    p.Position = {e.GetStream(S::POS_X)[i], e.GetStream(S::POS_Y)[i], e.GetStream(S::POS_Z)[i]};
+    p.Velocity = {e.GetStream(S::VEL_X)[i], e.GetStream(S::VEL_Y)[i], e.GetStream(S::VEL_Z)[i]};
+    p.Color = {e.GetStream(S::COLOR_R)[i], e.GetStream(S::COLOR_G)[i], e.GetStream(S::COLOR_B)[i]};
+    p.Life = e.GetStream(S::LIFE)[i];
+    p.MaxLife = 1.0f / e.GetStream(S::INV_MAX_LIFE)[i];
+    p.BaseSize = e.GetStream(S::BASE_SIZE)[i];
+    p.Size = e.GetStream(S::SIZE)[i];
+    p.Alpha = e.GetStream(S::ALPHA)[i];
+    return p;
+}
+
+} // namespace
+
+TEST(ParticleTest, EmitRespectsBudget) {
+    ParticleEmitter emitter(MakeConfig(100));
+    EXPECT_EQ(emitter.Emit(60), 60u);
+    EXPECT_EQ(emitter.Emit(60), 40u);
+    EXPECT_EQ(emitter.GetAliveCount(), 100u);
+    EXPECT_EQ(emitter.Emit(1), 0u);
+
+    // 缩小预算时丢弃超出部分
+    ParticleEmitterConfig smaller = emitter.GetConfig();
+    smaller.MaxParticles = 30;
+    emitter.SetConfig(smaller);
+    EXPECT_EQ(emitter.GetAliveCount(), 30u);
+}
+
+TEST(ParticleTest, EmitOverTimeAccumulatesFraction) {
+    ParticleEmitterConfig cfg = MakeConfig(1000);
+    cfg.EmitRate = 30;
+    ParticleEmitter emitter(cfg);
+
+    // 30/秒 × 1/60 秒 = 0.5 个/帧，两帧一个
+    u32 emitted = 0;
+    for (int i = 0; i < 60; i++) emitted += emitter.EmitOverTime(1.0f / 60.0f);
+    EXPECT_NEAR((f32)emitted, 30.0f, 1.0f);
+}
+
+TEST(ParticleTest, SimdKernelMatchesScalarReference) {
+    ParticleEmitterConfig cfg = MakeConfig(37);   // 非 4 的倍数，覆盖尾部
+    ParticleEmitter emitter(cfg, 7);
+    emitter.Emit(37);
+
+    std::vector<ScalarParticle> reference;
+    for (u32 i = 0; i < emitter.GetAliveCount(); i++) reference.push_back(ReadParticle(emitter, i));
+
+    const f32 dt = 1.0f / 60.0f;
+    for (int frame = 0; frame < 20; frame++) {
+        emitter.Simulate(dt, 0, emitter.GetAliveCount());
+        for (auto& p : reference) p.Step(cfg, dt);
+    }
+
+    ASSERT_EQ(emitter.GetAliveCount(), (u32)reference.size());
+    for (u32 i = 0; i < emitter.GetAliveCount(); i++) {
+        ScalarParticle p = ReadParticle(emitter, i);
+        const ScalarParticle& r = reference[i];
+        EXPECT_NEAR(p.Life, r.Life, 1e-5f);
+        EXPECT_NEAR(p.Position.x, r.Position.x, 1e-4f);
+        EXPECT_NEAR(p.Position.y, r.Position.y, 1e-4f);
+        EXPECT_NEAR(p.Position.z, r.Position.z, 1e-4f);
+        EXPECT_NEAR(p.Velocity.y, r.Velocity.y, 1e-4f);
+        EXPECT_NEAR(p.Color.g, r.Color.g, 1e-5f);
+        EXPECT_NEAR(p.Alpha, r.Alpha, 1e-5f);
+        EXPECT_NEAR(p.Size, r.Size, 1e-5f);
+    }
+}
+
+TEST(ParticleTest, CompactKeepsAliveParticlesDense) {
+    ParticleEmitterConfig cfg = MakeConfig(256);
+    cfg.MinLife = 0.1f;
+    cfg.MaxLife = 1.0f;
+    ParticleEmitter emitter(cfg, 3);
+    emitter.Emit(256);
+
+    // 记录每个粒子的发射尺寸作为身份，推进到一部分粒子死亡
+    std::vector<f32> survivors;
+    const f32 dt = 0.25f;
+    for (u32 i = 0; i < 256; i++) {
+        if (emitter.GetStream(ParticleEmitter::LIFE)[i] - 2 * dt > 0.0f) {
+            survivors.push_back(emitter.GetStream(ParticleEmitter::BASE_SIZE)[i]);
+        }
+    }
+    emitter.Simulate(dt, 0, emitter.GetAliveCount());
+    emitter.Compact();
+    emitter.Simulate(dt, 0, emitter.GetAliveCount());
+    emitter.Compact();
+
+    ASSERT_EQ(emitter.GetAliveCount(), (u32)survivors.size());
+    ASSERT_LT(emitter.GetAliveCount(), 256u);
+    std::vector<f32> alive;
+    for (u32 i = 0; i < emitter.GetAliveCount(); i++) {
+        EXPECT_GT(emitter.GetStream(ParticleEmitter::LIFE)[i], 0.0f);
+        alive.push_back(emitter.GetStream(ParticleEmitter::BASE_SIZE)[i]);
+    }
+    std::sort(alive.begin(), alive.end());
+    std::sort(survivors.begin(), survivors.end());
+    EXPECT_EQ(alive, survivors);
+
+    std::vector<ParticleInstance> instances(emitter.GetAliveCount());
+    emitter.WriteInstances(0, emitter.GetAliveCount(), instances.data());
+    for (u32 i = 0; i < emitter.GetAliveCount(); i++) {
+        EXPECT_FLOAT_EQ(instances[i].Size, emitter.GetStream(ParticleEmitter::SIZE)[i]);
+        EXPECT_FLOAT_EQ(instances[i].Position.y, emitter.GetStream(ParticleEmitter::POS_Y)[i]);
+    }
+}
+
+TEST(ParticleTest, ParallelUpdateAllMatchesSerial) {
+    // 一个发射器跨多个 SIMULATE_CHUNK，另有两个小发射器，中间夹一个不发射的空发射器
+    std::vector<ParticleEmitterConfig> configs = {MakeConfig(40000), MakeConfig(100), MakeConfig(500), MakeConfig(3)};
+    auto build = [&](std::vector<ParticleEmitter>& out) {
+        out.clear();
+        for (size_t i = 0; i < configs.size(); i++) out.emplace_back(configs[i], (u32)i + 1);
+        out[1].Emitting = false;
+    };
+
+    std::vector<ParticleEmitter> serial, parallel;
+    build(serial);
+    build(parallel);
+
+    const f32 dt = 1.0f / 30.0f;
+    for (int frame = 0; frame < 30; frame++) {
+        for (auto& e : serial) e.Update(dt);
+    }
+
+    JobSystem::Init(3);
+    std::vector<ParticleEmitter*> ptrs;
+    for (auto& e : parallel) ptrs.push_back(&e);
+    for (int frame = 0; frame < 30; frame++) {
+        ParticleEmitter::UpdateAll(ptrs.data(), (u32)ptrs.size(), dt);
+    }
+    JobSystem::Shutdown();
+
+    for (size_t e = 0; e < serial.size(); e++) {
+        ASSERT_EQ(serial[e].GetAliveCount(), parallel[e].GetAliveCount());
+        EXPECT_EQ(serial[e].GetAliveCount() > 0, e != 1);
+        for (u32 s = 0; s < ParticleEmitter::STREAM_COUNT; s++) {
+            auto stream = (ParticleEmitter::Stream)s;
+            for (u32 i = 0; i < serial[e].GetAliveCount(); i++) {
+                ASSERT_EQ(serial[e].GetStream(stream)[i], parallel[e].GetStream(stream)[i]);
+            }
+        }
+    }
+}
+
+TEST(ParticleTest, BoundsContainAllParticles) {
+    ParticleEmitterConfig cfg = MakeConfig(203);
+    cfg.Position = {5, 1, -3};
+    cfg.SpreadAngle = 80.0f;
+    ParticleEmitter emitter(cfg, 11);
+    emitter.Emit(203);
+    for (int i = 0; i < 10; i++) emitter.Update(0.05f);
+
+    const AABB& b = emitter.GetBounds();
+    f32 margin = cfg.MaxSize * std::max(cfg.SizeStart, cfg.SizeEnd);
+    for (u32 i = 0; i < emitter.GetAliveCount(); i++) {
+        glm::vec3 p = ReadParticle(emitter, i).Position;
+        EXPECT_TRUE(glm::all(glm::greaterThanEqual(p - glm::vec3(margin), b.Min - 1e-5f)));
+        EXPECT_TRUE(glm::all(glm::lessThanEqual(p + glm::vec3(margin), b.Max + 1e-5f)));
+    }
+}
+
+TEST(ParticleTest, RadixSortMatchesStableSort) {
+    std::mt19937 rng(5);
+    for (u32 threads : {0u, 3u}) {
+        if (threads > 0) JobSystem::Init(threads);
+        for (u32 bits : {16u, 32u}) {
+            const u32 n = 50000;   // 超过并行阈值
+            std::vector<u32> keys(n), values(n);
+            for (u32 i = 0; i < n; i++) {
+                keys[i] = bits == 32 ? (u32)rng() : (u32)(rng() & 0xFFFF);
+                values[i] = i;
+            }
+            std::vector<u32> order(n);
+            std::iota(order.begin(), order.end(), 0u);
+            std::stable_sort(order.begin(), order.end(), [&](u32 a, u32 b) { return keys[a] < keys[b]; });
+
+            std::vector<u32> sortedKeys = keys;
+            RadixSorter sorter;
+            sorter.Sort(sortedKeys.data(), values.data(), n, bits);
+            for (u32 i = 0; i < n; i++) {
+                ASSERT_EQ(values[i], order[i]);
+                ASSERT_EQ(sortedKeys[i], keys[order[i]]);
+            }
+        }
+        if (threads > 0) JobSystem::Shutdown();
+    }
+}
+
+TEST(ParticleTest, EmitRateScaleByDistance) {
+    ParticleLODSettings lod;
+    lod.FullRateDistance = 10.0f;
+    lod.CullDistance = 110.0f;
+    lod.MinRateScale = 0.2f;
+    EXPECT_FLOAT_EQ(lod.EmitRateScale(5.0f), 1.0f);
+    EXPECT_FLOAT_EQ(lod.EmitRateScale(60.0f), 0.6f);
+    EXPECT_FLOAT_EQ(lod.EmitRateScale(110.0f), 0.2f);
+    EXPECT_FLOAT_EQ(lod.EmitRateScale(111.0f), 0.0f);
+
+    // 倍数作用于 EmitOverTime
+    ParticleEmitterConfig cfg = MakeConfig(10000);
+    cfg.EmitRate = 1000;
+    ParticleEmitter emitter(cfg);
+    emitter.EmitRateScale = 0.25f;
+    EXPECT_EQ(emitter.EmitOverTime(1.0f), 250u);
+}
+
+TEST(ParticleTest, DrawListCullsAndSortsBackToFront) {
+    // 相机在原点看向 -Z
+    glm::mat4 vp = glm::perspective(glm::radians(60.0f), 1.0f, 0.1f, 500.0f) *
+                   glm::lookAt(glm::vec3(0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0));
+    auto make = [](glm::vec3 pos, bool alphaBlend, u32 count, u32 seed) {
+        ParticleEmitterConfig cfg = MakeConfig(count);
+        cfg.Position = pos;
+        cfg.Direction = {0, 0, -1};
+        cfg.SpreadAngle = 60.0f;
+        cfg.MinSpeed = 5.0f;
+        cfg.MaxSpeed = 20.0f;
+        cfg.AlphaBlend = alphaBlend;
+        ParticleEmitter e(cfg, seed);
+        e.Emit(count);
+        e.Update(0.1f);
+        return e;
+    };
+    std::vector<ParticleEmitter> emitters;
+    emitters.push_back(make({0, 0, -10}, false, 100, 1));    // 可见，叠加
+    emitters.push_back(make({0, 0, 30}, false, 100, 2));     // 相机背后
+    emitters.push_back(make({0, 0, -300}, true, 100, 3));    // 超出剔除距离
+    emitters.push_back(make({1, 0, -20}, true, 300, 4));     // 可见，alpha 混合
+    emitters.push_back(make({-1, 0, -15}, true, 200, 5));    // 可见，alpha 混合
+    std::vector<ParticleEmitter*> ptrs;
+    for (auto& e : emitters) ptrs.push_back(&e);
+
+    ParticleLODSettings lod;
+    lod.CullDistance = 150.0f;
+    ParticleDrawList list;
+    list.Build(ptrs.data(), (u32)ptrs.size(), vp, glm::vec3(0), lod);
+
+    const ParticleDrawStats& stats = list.GetStats();
+    EXPECT_EQ(stats.VisibleEmitters, 3u);
+    EXPECT_EQ(stats.CulledEmitters, 2u);
+    u32 expected = emitters[0].GetAliveCount() + emitters[3].GetAliveCount() + emitters[4].GetAliveCount();
+    EXPECT_EQ(stats.DrawnParticles, expected);
+    EXPECT_EQ(list.GetAdditiveCount(), emitters[0].GetAliveCount());
+    EXPECT_EQ(stats.SortedParticles, expected - list.GetAdditiveCount());
+    EXPECT_EQ(stats.UploadBytes, expected * (u32)sizeof(ParticleInstance));
+    EXPECT_EQ(stats.DrawCalls, 2u);
+
+    // alpha 混合部分按视深非增 (允许 16 位量化误差)
+    const auto& inst = list.GetInstances();
+    f32 range = 0.0f;
+    for (u32 i = list.GetAdditiveCount(); i < inst.size(); i++) range = std::max(range, -inst[i].Position.z);
+    for (u32 i = list.GetAdditiveCount() + 1; i < inst.size(); i++) {
+        EXPECT_GE(-inst[i - 1].Position.z, -inst[i].Position.z - range / 65535.0f * 2.0f);
+    }
+}
@@ -0,0 +1,231 @@
+/**
+ * @file test_path_request_queue.cpp
+ * @brief 异步寻路请求队列单元测试
+ *
+ * 测试结果与直接 FindPath 一致、重新请求/取消的旧结果被丢弃、按优先级和每帧上限派发，
+ * 快照随网格改动同步，以及工作线程求解期间修改网格不影响在途请求 (读的是快照)；
+ * 快照只复制可走性，并行循环不等在途的寻路任务。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/path_request_queue.h"
+#include "engine/core/job_system.h"
+#include "nav_test_utils.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+using namespace Engine::NavTest;
+
+namespace {
+
+/// 取完队列里所有结果
+std::vector<PathResult> Drain(PathRequestQueue& queue) {
+    std::vector<PathResult> results;
+    PathResult result;
+    while (queue.PopResult(result)) results.push_back(std::move(result));
+    return results;
+}
+
+} // namespace
+
+TEST(PathRequestQueueTest, ResultsMatchDirectFindPath) {
+    NavGrid grid = MakeRandomGrid(64, 64, 3, 25);
+    PathRequestQueue queue;
+    queue.SetNavGrid(&grid);
+    queue.SetConfig({64, 64, 1e6f});
+
+    std::mt19937 rng(11);
+    std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+    for (u64 owner = 0; owner < 40; owner++) {
+        glm::ivec2 s = {(i32)(rng() % 64), (i32)(rng() % 64)};
+        glm::ivec2 g = {(i32)(rng() % 64), (i32)(rng() % 64)};
+        queries.push_back({s, g});
+        queue.Submit(owner, s, g);
+        EXPECT_TRUE(queue.IsPending(owner));
+    }
+    queue.Update();
+    std::vector<PathResult> results = Drain(queue);
+    ASSERT_EQ(results.size(), 40u);
+
+    NavSearchState state;
+    std::vector<glm::ivec2> expected;
+    for (const PathResult& r : results) {
+        EXPECT_FALSE(queue.IsPending(r.Owner));
+        auto [s, g] = queries[r.Owner];
+        bool found = grid.FindPath(s, g, expected, state);
+        EXPECT_EQ(r.Found, found);
+        EXPECT_EQ(r.Cells, expected);
+    }
+}
+
+TEST(PathRequestQueueTest, ResubmitAndCancelDropStaleRequests) {
+    NavGrid grid(32, 32);
+    PathRequestQueue queue;
+    queue.SetNavGrid(&grid);
+
+    PathHandle first = queue.Submit(1, {0, 0}, {10, 0});
+    PathHandle second = queue.Submit(1, {0, 0}, {20, 0});
+    EXPECT_NE(first, second);
+    queue.Submit(2, {0, 0}, {5, 5});
+    queue.Cancel(2);
+    EXPECT_FALSE(queue.IsPending(2));
+
+    queue.Update();
+    std::vector<PathResult> results = Drain(queue);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].Handle, second);
+    EXPECT_EQ(results[0].Cells.back(), glm::ivec2(20, 0));
+}
+
+TEST(PathRequestQueueTest, DispatchesByPriorityWithinFrameLimit) {
+    NavGrid grid(32, 32);
+    PathRequestQueue queue;
+    queue.SetNavGrid(&grid);
+    queue.SetConfig({2, 64, 1e6f});
+
+    queue.Submit(1, {0, 0}, {1, 0}, 1.0f);
+    queue.Submit(2, {0, 0}, {2, 0}, 5.0f);
+    queue.Submit(3, {0, 0}, {3, 0}, 3.0f);
+    queue.Submit(4, {0, 0}, {4, 0}, 4.0f);
+    queue.Cancel(4);   // 作废的请求不占每帧名额
+
+    queue.Update();
+    std::vector<PathResult> results = Drain(queue);
+    ASSERT_EQ(results.size(), 2u);
+    EXPECT_EQ(results[0].Owner, 2u);
+    EXPECT_EQ(results[1].Owner, 3u);
+
+    queue.Update();
+    results = Drain(queue);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].Owner, 1u);
+    EXPECT_EQ(queue.GetQueuedCount(), 0u);
+}
+
+TEST(PathRequestQueueTest, SnapshotFollowsGridEdits) {
+    NavGrid grid(40, 40);
+    grid.SetSearchMode(NavSearchMode::JumpPoint);
+    PathRequestQueue queue;
+    queue.SetNavGrid(&grid);
+
+    queue.Submit(1, {2, 20}, {37, 20});
+    queue.Update();
+    std::vector<PathResult> results = Drain(queue);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_TRUE(results[0].Found);
+    EXPECT_EQ(results[0].GridRevision, grid.GetRevision());
+
+    // 封墙后的请求看到新的可走性 (快照就地同步改动区域)
+    for (i32 y = 0; y < 40; y++) grid.SetWalkable(20, y, false);
+    queue.Submit(1, {2, 20}, {37, 20});
+    queue.Update();
+    results = Drain(queue);
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_FALSE(results[0].Found);
+    EXPECT_EQ(results[0].GridRevision, grid.GetRevision());
+
+    grid.SetWalkable(20, 7, true);
+    queue.Submit(1, {2, 20}, {37, 20});
+    queue.Update();
+    results = Drain(queue);
+    ASSERT_EQ(results.size(), 1u);
+    ASSERT_TRUE(results[0].Found);
+    EXPECT_NE(std::find(results[0].Cells.begin(), results[0].Cells.end(), glm::ivec2(20, 7)), results[0].Cells.end());
+}
+
+TEST(PathRequestQueueTest, WorkersSolveAgainstSnapshot) {
+    JobSystem::Init(3);
+    NavGrid grid(48, 48);
+    grid.SetSearchMode(NavSearchMode::JumpPoint);
+    PathRequestQueue queue;
+    queue.SetNavGrid(&grid);
+    queue.SetConfig({16, 8, 1.0f});
+
+    for (u64 owner = 0; owner < 100; owner++) {
+        queue.Submit(owner, {0, (i32)(owner % 48)}, {47, 47 - (i32)(owner % 48)}, (f32)owner);
+    }
+    queue.Update();
+    EXPECT_LE(queue.GetInFlightCount(), 8u);
+    u32 firstBatch = 100 - queue.GetQueuedCount();
+    EXPECT_GE(firstBatch, 8u);
+    EXPECT_LE(firstBatch, 16u);
+
+    // 在途请求读的是快照: 主线程封住一整列也不影响它们
+    for (i32 y = 0; y < 48; y++) grid.SetWalkable(24, y, false);
+
+    std::vector<PathResult> results;
+    for (u32 frame = 0; frame < 1000 && results.size() < 100; frame++) {
+        queue.WaitIdle();
+        for (PathResult& r : Drain(queue)) results.push_back(std::move(r));
+        queue.Update();
+    }
+    JobSystem::Shutdown();
+
+    ASSERT_EQ(results.size(), 100u);
+    u32 found = 0;
+    for (const PathResult& r : results) {
+        if (!r.Found) continue;
+        found++;
+        EXPECT_GE(r.Owner, 100u - firstBatch);   // 优先级最高的先派发
+        for (size_t i = 1; i < r.Cells.size(); i++) {
+            glm::ivec2 d = glm::abs(r.Cells[i] - r.Cells[i - 1]);
+            ASSERT_LE(std::max(d.x, d.y), 1);
+        }
+    }
+    // 第一帧派发的请求在封墙前的快照上求解，之后的请求都找不到路
+    EXPECT_EQ(found, firstBatch);
+}
+
+TEST(PathRequestQueueTest, SnapshotCopiesWalkabilityOnly) {
+    NavGrid grid = MakeRandomGrid(64, 64, 5, 20);
+    grid.SetSearchMode(NavSearchMode::JumpPoint);
+    grid.SetWalkable(0, 0, true);
+    grid.SetWalkable(63, 63, true);
+    grid.UpdateSearchData();
+
+    NavGrid snapshot;
+    snapshot.CopyWalkability(grid);
+    EXPECT_EQ(snapshot.GetSearchMode(), NavSearchMode::JumpPoint);
+    EXPECT_TRUE(snapshot.IsSearchDataValid());
+    EXPECT_TRUE(std::equal(grid.GetWalkableData(), grid.GetWalkableData() + 64 * 64, snapshot.GetWalkableData()));
+
+    NavSearchState a, b;
+    std::vector<glm::ivec2> expected, cells;
+    bool found = grid.FindPath({0, 0}, {63, 63}, expected, a);
+    EXPECT_EQ(snapshot.FindPath({0, 0}, {63, 63}, cells, b), found);
+    EXPECT_EQ(cells, expected);
+
+    // 之后的改动仍可局部修复
+    snapshot.SetWalkable(10, 10, false);
+    snapshot.UpdateSearchData();
+    EXPECT_TRUE(snapshot.IsSearchDataValid());
+}
+
+TEST(PathRequestQueueTest, ParallelForDoesNotWaitForPathJobs) {
+    JobSystem::Init(2);
+    std::atomic<bool> release{false}, finished{false};
+    JobSystem::Submit([&] {
+        while (!release.load()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        finished = true;
+    });
+
+    // 长任务占着一个工作线程时，并行循环只等自己的块
+    std::vector<u32> values(1000, 0);
+    JobSystem::ParallelForRange(1000, 16, [&](u32 begin, u32 end) {
+        for (u32 i = begin; i < end; i++) values[i] = i * 2;
+    });
+    JobSystem::ParallelFor(0, 1000, [&](u32 i) { values[i] += 1; });
+    EXPECT_FALSE(finished.load());
+    for (u32 i = 0; i < 1000; i++) ASSERT_EQ(values[i], i * 2 + 1);
+
+    release = true;
+    JobSystem::WaitIdle();
+    EXPECT_TRUE(finished.load());
+    JobSystem::Shutdown();
+}
@@ -0,0 +1,158 @@
+/**
+ * @file test_scene_serializer.cpp
+ * @brief 场景序列化单元测试
+ *
+ * 测试 JSON 与二进制两种格式的往返一致性、浮点精度、旧版 (数组对象间缺逗号) JSON 的加载，
+ * 以及损坏数据的拒绝。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/core/scene_serializer.h"
+#include "engine/core/components.h"
+#include "engine/physics/physics_world.h"
+
+#include <cstring>
+
+using namespace Engine;
+
+namespace {
+
+Ref<Scene> MakeScene() {
+    auto scene = CreateRef<Scene>("TestScene");
+    scene->GetDirLight().Intensity = 0.7f;
+    scene->AddPointLight().Position = {1.25f, 2.5f, -3.125f};
+    scene->AddSpotLight().OuterCutoff = 22.5f;
+
+    auto& world = scene->GetWorld();
+    for (u32 i = 0; i < 64; i++) {
+        Entity e = scene->CreateEntity("Entity_" + std::to_string(i));
+        auto& tr = world.AddComponent<TransformComponent>(e);
+        tr.X = (f32)i * 0.1f;
+        tr.Y = 1.0f / 3.0f;
+        tr.RotZ = -0.123456f;
+
+        if (i % 2 == 0) {
+            auto& rc = world.AddComponent<RenderComponent>(e);
+            rc.MeshType = "sphere";
+            rc.ColorG = 0.333333f;
+        }
+        if (i % 3 == 0) {
+            auto& ai = world.AddComponent<AIComponent>(e);
+            ai.ScriptModule = "zombie_ai";
+            ai.State = "Chase";
+        }
+        if (i % 5 == 0) {
+            auto& col = world.AddComponent<ColliderComponent>(e);
+            col.Shape = ColliderShape::Sphere;
+            col.Layer = 4;
+            col.IsTrigger = true;
+        }
+    }
+    return scene;
+}
+
+/// 逐实体比较 (两边实体按创建顺序一一对应)
+void ExpectScenesEqual(Scene& a, Scene& b) {
+    EXPECT_EQ(a.GetName(), b.GetName());
+    EXPECT_FLOAT_EQ(a.GetDirLight().Intensity, b.GetDirLight().Intensity);
+    ASSERT_EQ(a.GetPointLights().size(), b.GetPointLights().size());
+    EXPECT_EQ(a.GetPointLights()[0].Position, b.GetPointLights()[0].Position);
+    ASSERT_EQ(a.GetSpotLights().size(), b.GetSpotLights().size());
+    EXPECT_EQ(a.GetSpotLights()[0].OuterCutoff, b.GetSpotLights()[0].OuterCutoff);
+
+    auto& wa = a.GetWorld();
+    auto& wb = b.GetWorld();
+    ASSERT_EQ(wa.GetEntityCount(), wb.GetEntityCount());
+    for (u32 i = 0; i < wa.GetEntityCount(); i++) {
+        Entity ea = wa.GetEntities()[i];
+        Entity eb = wb.GetEntities()[i];
+        EXPECT_EQ(wa.GetComponent<TagComponent>(ea)->Name, wb.GetComponent<TagComponent>(eb)->Name);
+
+        auto* ta = wa.GetComponent<TransformComponent>(ea);
+        auto* tb = wb.GetComponent<TransformComponent>(eb);
+        ASSERT_NE(tb, nullptr);
+        // 两种格式都必须逐位还原浮点值
+        EXPECT_EQ(ta->X, tb->X);
+        EXPECT_EQ(ta->Y, tb->Y);
+        EXPECT_EQ(ta->RotZ, tb->RotZ);
+
+        auto* ra = wa.GetComponent<RenderComponent>(ea);
+        auto* rb = wb.GetComponent<RenderComponent>(eb);
+        ASSERT_EQ(ra == nullptr, rb == nullptr);
+        if (ra) {
+            EXPECT_EQ(ra->MeshType, rb->MeshType);
+            EXPECT_EQ(ra->ColorG, rb->ColorG);
+        }
+
+        auto* aa = wa.GetComponent<AIComponent>(ea);
+        auto* ab = wb.GetComponent<AIComponent>(eb);
+        ASSERT_EQ(aa == nullptr, ab == nullptr);
+        if (aa) {
+            EXPECT_EQ(aa->ScriptModule, ab->ScriptModule);
+            EXPECT_EQ(aa->State, ab->State);
+        }
+
+        auto* ca = wa.GetComponent<ColliderComponent>(ea);
+        auto* cb = wb.GetComponent<ColliderComponent>(eb);
+        ASSERT_EQ(ca == nullptr, cb == nullptr);
+        if (ca) {
+            EXPECT_EQ(ca->Shape, cb->Shape);
+            EXPECT_EQ(ca->Layer, cb->Layer);
+            EXPECT_EQ(ca->IsTrigger, cb->IsTrigger);
+        }
+    }
+}
+
+} // namespace
+
+TEST(SceneSerializerTest, JsonRoundTrip) {
+    auto scene = MakeScene();
+    std::string json = SceneSerializer::SaveToString(*scene);
+    auto loaded = SceneSerializer::LoadFromString(json);
+    ASSERT_NE(loaded, nullptr);
+    ExpectScenesEqual(*scene, *loaded);
+}
+
+TEST(SceneSerializerTest, LoadsLegacyJsonWithoutArrayCommas) {
+    auto scene = MakeScene();
+    std::string json = SceneSerializer::SaveToString(*scene);
+
+    // 旧版写出器的输出: 数组内相邻对象之间没有逗号
+    std::string legacy;
+    for (size_t i = 0; i < json.size(); i++) {
+        if (json.compare(i, 3, "},{") == 0) { legacy += "}{"; i += 2; continue; }
+        legacy += json[i];
+    }
+    ASSERT_NE(legacy, json);
+
+    auto loaded = SceneSerializer::LoadFromString(legacy);
+    ASSERT_NE(loaded, nullptr);
+    ExpectScenesEqual(*scene, *loaded);
+}
+
+TEST(SceneSerializerTest, BinaryRoundTrip) {
+    auto scene = MakeScene();
+    std::vector<u8> blob;
+    SceneSerializer::SaveBinaryToMemory(*scene, blob);
+    u32 magic = 0;
+    std::memcpy(&magic, blob.data(), sizeof(magic));
+    EXPECT_EQ(magic, SCENE_BINARY_MAGIC);
+
+    auto loaded = SceneSerializer::LoadFromMemory(blob.data(), blob.size());
+    ASSERT_NE(loaded, nullptr);
+    ExpectScenesEqual(*scene, *loaded);
+}
+
+TEST(SceneSerializerTest, BinaryRejectsCorruptData) {
+    auto scene = MakeScene();
+    std::vector<u8> blob;
+    SceneSerializer::SaveBinaryToMemory(*scene, blob);
+
+    // 截断
+    EXPECT_EQ(SceneSerializer::LoadFromMemory(blob.data(), blob.size() / 2), nullptr);
+
+    // 版本号不符
+    std::vector<u8> wrongVersion = blob;
+    wrongVersion[4] = 0xFF;
+    EXPECT_EQ(SceneSerializer::LoadFromMemory(wrongVersion.data(), wrongVersion.size()), nullptr);
+}
@@ -0,0 +1,233 @@
+/**
+ * @file test_skinning.cpp
+ * @brief 蒙皮单元测试
+ *
+ * 测试 CPU 蒙皮与着色器公式 (从骨骼调色板取 3×4 行重建矩阵) 结果一致，
+ * AnimationSystem 为可见实例分配并写入调色板切片，以及蒙皮顶点属性布局
+ * (与 skinning_instanced.glsl 的 location 一致、不与实例属性重叠)。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/skinning_utils.h"
+#include "engine/renderer/skinned_instance_renderer.h"
+#include "engine/renderer/gltf_loader.h"
+#include "engine/renderer/animation.h"
+#include "engine/renderer/frustum.h"
+#include "engine/core/components.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+#include <cmath>
+
+using namespace Engine;
+
+namespace {
+
+using SkinVertex = SkinningUtils::SkinVertex;
+
+/// 按 skinning_instanced.glsl 逐句翻译: 调色板取骨骼、加权、归一化、逆转置变换法线
+SkinVertex ShaderReference(const SkinVertex& v, const AffineTransform* palette) {
+    auto fetchBone = [&](i32 bone) {
+        const AffineTransform& t = palette[bone];
+        return glm::transpose(glm::mat4(t.Rows[0], t.Rows[1], t.Rows[2], glm::vec4(0, 0, 0, 1)));
+    };
+    glm::mat4 skin(0.0f);
+    for (int i = 0; i < 4; i++) {
+        if (v.BoneIDs[i] >= 0 && v.BoneIDs[i] < 128) skin += v.Weights[i] * fetchBone(v.BoneIDs[i]);
+    }
+    f32 total = v.Weights[0] + v.Weights[1] + v.Weights[2] + v.Weights[3];
+    if (total > 0.0f && std::abs(total - 1.0f) > 0.001f) skin /= total;
+
+    SkinVertex out = v;
+    out.Position = glm::vec3(skin * glm::vec4(v.Position, 1.0f));
+    glm::mat3 normalMatrix = glm::mat3(glm::transpose(glm::inverse(skin)));
+    out.Normal    = glm::normalize(normalMatrix * v.Normal);
+    out.Tangent   = glm::normalize(normalMatrix * v.Tangent);
+    out.Bitangent = glm::normalize(normalMatrix * v.Bitangent);
+    return out;
+}
+
+bool NearlyEqual(const glm::vec3& a, const glm::vec3& b, f32 eps = 1e-4f) {
+    return glm::all(glm::lessThanEqual(glm::abs(a - b), glm::vec3(eps)));
+}
+
+} // namespace
+
+TEST(SkinningTest, CpuSkinningMatchesShaderFormula) {
+    // 旋转 + 平移 + 非均匀缩放 (其中一根为镜像)，检验逆转置路径
+    constexpr u32 BONES = 6;
+    std::vector<glm::mat4> bones(BONES);
+    for (u32 b = 0; b < BONES; b++) {
+        glm::vec3 scale(1.0f + 0.2f * b, 1.0f, b == 3 ? -0.7f : 1.0f - 0.1f * b);
+        bones[b] = glm::translate(glm::mat4(1.0f), glm::vec3(b, -0.5f * b, 0.25f)) *
+                   glm::mat4_cast(glm::angleAxis(0.4f * b + 0.1f, glm::normalize(glm::vec3(1, b, 2)))) *
+                   glm::scale(glm::mat4(1.0f), scale);
+    }
+    BonePaletteBuffer palette;
+    u32 offset = palette.Allocate(BONES);
+    for (u32 b = 0; b < BONES; b++) palette.Data(offset)[b] = AffineTransform::FromMat4(bones[b]);
+
+    std::vector<SkinVertex> vertices;
+    for (u32 i = 0; i < 64; i++) {
+        SkinVertex v;
+        f32 t = (f32)i * 0.37f;
+        v.Position  = {std::sin(t) * 2.0f, std::cos(t * 1.3f), t * 0.1f};
+        v.Normal    = glm::normalize(glm::vec3(std::cos(t), 1.0f, std::sin(t)));
+        v.Tangent   = glm::normalize(glm::vec3(1.0f, 0.0f, std::sin(t)));
+        v.Bitangent = glm::cross(v.Normal, v.Tangent);
+        v.UV = {t, 1.0f - t};
+        for (int k = 0; k < 4; k++) v.BoneIDs[k] = (i32)((i + k * 2) % BONES);
+        v.Weights[0] = 0.5f; v.Weights[1] = 0.3f; v.Weights[2] = 0.15f; v.Weights[3] = 0.05f;
+        if (i % 4 == 1) v.Weights[3] = 0.0f;              // 权重和 0.95 → 归一化
+        if (i % 4 == 2) v.BoneIDs[2] = -1;                // 无效骨骼被跳过
+        if (i % 4 == 3) { v.Weights[0] = 1.0f; v.Weights[1] = v.Weights[2] = v.Weights[3] = 0.0f; }
+        vertices.push_back(v);
+    }
+
+    std::vector<SkinVertex> skinned(vertices.size());
+    SkinningUtils::SkinVertices(vertices.data(), (u32)vertices.size(), bones.data(), BONES, skinned.data());
+
+    for (size_t i = 0; i < vertices.size(); i++) {
+        SkinVertex ref = ShaderReference(vertices[i], palette.Data(offset));
+        EXPECT_TRUE(NearlyEqual(skinned[i].Position, ref.Position)) << "vertex " << i;
+        EXPECT_TRUE(NearlyEqual(skinned[i].Normal, ref.Normal)) << "vertex " << i;
+        EXPECT_TRUE(NearlyEqual(skinned[i].Tangent, ref.Tangent)) << "vertex " << i;
+        EXPECT_TRUE(NearlyEqual(skinned[i].Bitangent, ref.Bitangent)) << "vertex " << i;
+        EXPECT_EQ(skinned[i].UV, vertices[i].UV);
+    }
+
+    // 原地蒙皮结果相同
+    std::vector<SkinVertex> inPlace = vertices;
+    SkinningUtils::SkinVertices(inPlace.data(), (u32)inPlace.size(), bones.data(), BONES, inPlace.data());
+    for (size_t i = 0; i < inPlace.size(); i++) EXPECT_EQ(inPlace[i].Position, skinned[i].Position);
+}
+
+TEST(SkinningTest, UnweightedVerticesPassThrough) {
+    glm::mat4 bone = glm::translate(glm::mat4(1.0f), glm::vec3(5, 0, 0));
+    SkinVertex v;
+    v.Position = {1, 2, 3};
+    v.Normal = {0, 1, 0};
+    SkinVertex out;
+    SkinningUtils::SkinVertices(&v, 1, &bone, 1, &out);
+    EXPECT_EQ(out.Position, v.Position);
+    EXPECT_EQ(out.Normal, v.Normal);
+}
+
+TEST(SkinningTest, AnimationSystemWritesPalette) {
+    auto skeleton = CreateRef<Skeleton>();
+    for (i32 i = 0; i < 4; i++) {
+        Bone bone;
+        bone.Name = "b" + std::to_string(i);
+        bone.ParentIndex = i - 1;
+        bone.LocalTransform = glm::translate(glm::mat4(1.0f), glm::vec3(0, 1, 0));
+        skeleton->AddBone(bone);
+    }
+    auto set = CreateRef<AnimationSet>();
+    set->SkeletonData = skeleton;
+    AnimationClip clip;
+    clip.Name = "bend";
+    clip.Duration = 1.0f;
+    AnimationChannel ch;
+    ch.BoneIndex = 1;
+    ch.RotationKeys = {{0.0f, glm::quat(1, 0, 0, 0)}, {1.0f, glm::angleAxis(1.0f, glm::vec3(0, 0, 1))}};
+    clip.Channels.push_back(ch);
+    set->Clips.push_back(clip);
+    AnimationSetRef shared = set;
+
+    ECSWorld world;
+    std::vector<Entity> entities;
+    for (int i = 0; i < 4; i++) {
+        Entity e = world.CreateEntity("Skinned");
+        // 第 3 个放到相机背后 (被剔除)
+        world.AddComponent<TransformComponent>(e).WorldMatrix =
+            glm::translate(glm::mat4(1.0f), glm::vec3(i, 0, i == 2 ? 20.0f : -5.0f));
+        auto& anim = world.AddComponent<AnimatorComponent>(e);
+        anim.Animations = shared;
+        anim.Play("bend");
+        entities.push_back(e);
+    }
+
+    Frustum frustum;
+    frustum.ExtractFromVP(glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f) *
+                          glm::lookAt(glm::vec3(0), glm::vec3(0, 0, -1), glm::vec3(0, 1, 0)));
+    BonePaletteBuffer palette;
+    AnimationSystem system;
+    system.SetView({glm::vec3(0), 0.0f, &frustum});
+    system.SetPalette(&palette);
+
+    for (int frame = 0; frame < 3; frame++) {
+        if (frame == 2) world.GetComponent<AnimatorComponent>(entities[3])->Playing = false;
+        system.Update(world, 0.1f);
+
+        EXPECT_EQ(palette.GetUsed(), 3u * 4u);
+        std::vector<bool> used(palette.GetUsed(), false);
+        for (size_t i = 0; i < entities.size(); i++) {
+            const auto* anim = world.GetComponent<AnimatorComponent>(entities[i]);
+            if (i == 2) {
+                EXPECT_EQ(anim->PaletteOffset, INVALID_PALETTE_OFFSET);
+                continue;
+            }
+            ASSERT_NE(anim->PaletteOffset, INVALID_PALETTE_OFFSET);
+            for (u32 b = 0; b < 4; b++) {
+                // 切片互不重叠，内容为本帧蒙皮矩阵的 3×4 行
+                EXPECT_FALSE(used[anim->PaletteOffset + b]);
+                used[anim->PaletteOffset + b] = true;
+                const AffineTransform& t = palette.Data(anim->PaletteOffset)[b];
+                glm::mat4 expected = anim->BoneMatrices[b];
+                for (int r = 0; r < 3; r++) {
+                    for (int c = 0; c < 4; c++) EXPECT_FLOAT_EQ(t.Rows[r][c], expected[c][r]);
+                }
+            }
+        }
+    }
+}
+
+TEST(SkinningTest, ExternalPaletteStorageIsBounded) {
+    std::vector<AffineTransform> storage(10);
+    BonePaletteBuffer palette;
+    palette.SetExternalStorage(storage.data(), (u32)storage.size());
+    EXPECT_EQ(palette.Allocate(6), 0u);
+    EXPECT_EQ(palette.Allocate(6), INVALID_PALETTE_OFFSET);   // 外部存储不扩容
+    EXPECT_EQ(palette.Allocate(4), 6u);
+    EXPECT_EQ(palette.Data(6), storage.data() + 6);
+
+    palette.SetExternalStorage(nullptr, 0);                    // 回到内部数组，可增长
+    EXPECT_FALSE(palette.IsExternal());
+    EXPECT_EQ(palette.Allocate(100), 0u);
+}
+
+TEST(SkinningTest, SkinVertexLayoutMatchesShader) {
+    // skinning_instanced.glsl: aPos..aBitangent 为 0~4，aBoneIDs (ivec4) 5，aWeights (vec4) 6
+    const u32 expectedComponents[] = {3, 3, 2, 3, 3, 4, 4};
+    u32 end = 0;
+    for (u32 i = 0; i < 7; i++) {
+        const SkinVertexAttribute& attr = SKIN_VERTEX_LAYOUT[i];
+        EXPECT_EQ(attr.Location, i);
+        EXPECT_EQ(attr.Components, expectedComponents[i]);
+        EXPECT_EQ(attr.Integer, i == 5);
+        EXPECT_GE(attr.Offset, end);   // 属性之间不重叠
+        end = attr.Offset + attr.Components * 4;
+        EXPECT_LT(attr.Location, SkinnedInstanceRenderer::INSTANCE_ATTRIB_START);
+    }
+    EXPECT_LE(end, (u32)sizeof(SkinVertex));
+
+    // glTF 蒙皮顶点转换后骨骼索引/权重落在 location 5/6 读取的位置
+    GltfSkinVertex src;
+    src.Position = {1, 2, 3};
+    src.TexCoord = {0.25f, 0.75f};
+    src.BoneIDs = {7, 3, 0, 12};
+    src.Weights = {0.5f, 0.25f, 0.125f, 0.125f};
+    SkinVertex v = ToSkinVertex(src);
+    const u8* bytes = (const u8*)&v;
+    const i32* ids = (const i32*)(bytes + SKIN_VERTEX_LAYOUT[5].Offset);
+    const f32* weights = (const f32*)(bytes + SKIN_VERTEX_LAYOUT[6].Offset);
+    const f32* uv = (const f32*)(bytes + SKIN_VERTEX_LAYOUT[2].Offset);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_EQ(ids[i], src.BoneIDs[i]);
+        EXPECT_EQ(weights[i], src.Weights[i]);
+    }
+    EXPECT_EQ(uv[0], 0.25f);
+    EXPECT_EQ(uv[1], 0.75f);
+    EXPECT_EQ(v.Position, src.Position);
+}
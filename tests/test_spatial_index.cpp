@@ -0,0 +1,168 @@
+/**
+ * @file test_spatial_index.cpp
+ * @brief AI 邻域索引单元测试
+ *
+ * 测试半径查询与暴力扫描一致 (含排除自身、排序)、k 近邻、
+ * 小队成员表、分布极散时网格自动放大格子，以及 inf/NaN 半径不越界。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/ai/spatial_index.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+
+using namespace Engine;
+using namespace Engine::AI;
+
+namespace {
+
+std::vector<AISpatialIndex::Entry> RandomEntries(u32 count, f32 extent, u32 seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<f32> xz(-extent, extent), y(0.0f, 4.0f);
+    std::vector<AISpatialIndex::Entry> entries(count);
+    for (u32 i = 0; i < count; i++) {
+        entries[i].EntityID = i + 1;
+        entries[i].Position = {xz(rng), y(rng), xz(rng)};
+        entries[i].Health = (f32)i;
+    }
+    return entries;
+}
+
+/// 暴力扫描，按 (距离, 实体 ID) 排序后的实体 ID
+std::vector<u32> BruteForce(const std::vector<AISpatialIndex::Entry>& entries,
+                            const glm::vec3& pos, f32 radius, u32 excludeID) {
+    std::vector<std::pair<f32, u32>> hits;
+    for (const auto& e : entries) {
+        if (e.EntityID == excludeID) continue;
+        f32 dist = glm::length(e.Position - pos);
+        if (dist <= radius) hits.push_back({dist, e.EntityID});
+    }
+    std::sort(hits.begin(), hits.end());
+    std::vector<u32> ids;
+    for (auto& h : hits) ids.push_back(h.second);
+    return ids;
+}
+
+std::vector<u32> HitIDs(const AISpatialIndex& index, const std::vector<AISpatialIndex::Hit>& hits) {
+    std::vector<u32> ids;
+    for (auto& h : hits) ids.push_back(index.GetEntry(h.Index).EntityID);
+    return ids;
+}
+
+} // namespace
+
+TEST(AISpatialIndexTest, RadiusMatchesBruteForce) {
+    auto entries = RandomEntries(2000, 100.0f, 7);
+    AISpatialIndex index(8.0f);
+    index.Build(entries);
+    ASSERT_EQ(index.GetCount(), 2000u);
+
+    std::vector<AISpatialIndex::Hit> hits;
+    for (u32 q = 0; q < 50; q++) {
+        const auto& self = entries[q * 37];
+        f32 radius = 2.0f + (f32)q;
+        index.QueryRadius(self.Position, radius, self.EntityID, hits);
+        EXPECT_EQ(HitIDs(index, hits), BruteForce(entries, self.Position, radius, self.EntityID));
+        for (auto& h : hits) {
+            EXPECT_EQ(index.GetEntry(h.Index).Health, (f32)(index.GetEntry(h.Index).EntityID - 1));
+        }
+    }
+
+    // 查询点在包围盒外
+    index.QueryRadius({500, 0, 500}, 10.0f, 0, hits);
+    EXPECT_TRUE(hits.empty());
+    index.QueryRadius({105, 0, 0}, 10.0f, 0, hits);
+    EXPECT_EQ(HitIDs(index, hits), BruteForce(entries, {105, 0, 0}, 10.0f, 0));
+}
+
+TEST(AISpatialIndexTest, KNearest) {
+    auto entries = RandomEntries(500, 50.0f, 11);
+    AISpatialIndex index(4.0f);
+    index.Build(entries);
+
+    std::vector<AISpatialIndex::Hit> hits;
+    const f32 inf = std::numeric_limits<f32>::max();
+    for (u32 k : {1u, 5u, 40u}) {
+        const auto& self = entries[k];
+        index.QueryKNearest(self.Position, k, inf, self.EntityID, hits);
+        auto expected = BruteForce(entries, self.Position, inf, self.EntityID);
+        expected.resize(k);
+        EXPECT_EQ(HitIDs(index, hits), expected);
+    }
+
+    // k 超过总数: 返回除自身外的全部
+    index.QueryKNearest(entries[0].Position, 1000, inf, entries[0].EntityID, hits);
+    EXPECT_EQ(hits.size(), 499u);
+
+    // 半径上限
+    index.QueryKNearest(entries[0].Position, 1000, 10.0f, entries[0].EntityID, hits);
+    EXPECT_EQ(HitIDs(index, hits), BruteForce(entries, entries[0].Position, 10.0f, entries[0].EntityID));
+}
+
+TEST(AISpatialIndexTest, SquadMembership) {
+    std::vector<AISpatialIndex::Entry> entries(6);
+    for (u32 i = 0; i < 6; i++) entries[i].EntityID = i + 1;
+
+    AISpatialIndex index;
+    index.Build(entries, {{2, 5}, {1, 3}, {2, 1}, {1, 4}, {2, 6}});
+    EXPECT_EQ(index.GetSquadIDs(), (std::vector<u32>{1, 2}));
+    EXPECT_EQ(index.GetSquadMembers(1), (std::vector<u32>{3, 4}));
+    EXPECT_EQ(index.GetSquadMembers(2), (std::vector<u32>{1, 5, 6}));
+    EXPECT_TRUE(index.GetSquadMembers(9).empty());
+
+    // 重建后旧小队清空
+    index.Build(entries, {{3, 2}});
+    EXPECT_EQ(index.GetSquadIDs(), (std::vector<u32>{3}));
+    EXPECT_TRUE(index.GetSquadMembers(1).empty());
+    EXPECT_EQ(index.GetSquadMembers(3), (std::vector<u32>{2}));
+}
+
+TEST(AISpatialIndexTest, SparseWorldAndEmpty) {
+    AISpatialIndex index(1.0f);
+    std::vector<AISpatialIndex::Hit> hits;
+
+    index.Build({});
+    index.QueryRadius({0, 0, 0}, 100.0f, 0, hits);
+    EXPECT_TRUE(hits.empty());
+
+    // 相距极远: 格子数超上限时放大格子，查询仍正确
+    std::vector<AISpatialIndex::Entry> entries(4);
+    entries[0] = {{-1e6f, 0, -1e6f}, 0, 1};
+    entries[1] = {{1e6f, 0, 1e6f}, 0, 2};
+    entries[2] = {{0, 0, 0}, 0, 3};
+    entries[3] = {{0.5f, 0, 0}, 0, 4};
+    index.Build(entries);
+
+    index.QueryRadius({0, 0, 0}, 1.0f, 0, hits);
+    EXPECT_EQ(HitIDs(index, hits), (std::vector<u32>{3, 4}));
+    index.QueryRadius({0, 0, 0}, 1.0f, 3, hits);
+    EXPECT_EQ(HitIDs(index, hits), (std::vector<u32>{4}));
+    index.QueryKNearest({1e6f, 0, 1e6f}, 1, std::numeric_limits<f32>::max(), 0, hits);
+    EXPECT_EQ(HitIDs(index, hits), (std::vector<u32>{2}));
+}
+
+TEST(AISpatialIndexTest, InfiniteAndNaNRadius) {
+    auto entries = RandomEntries(300, 50.0f, 5);
+    AISpatialIndex index(4.0f);
+    index.Build(entries);
+
+    // 半径/坐标为 inf 时格子下标先夹紧再转换，结果等同覆盖全部
+    const f32 inf = std::numeric_limits<f32>::infinity();
+    std::vector<AISpatialIndex::Hit> hits;
+    index.QueryRadius(entries[0].Position, inf, entries[0].EntityID, hits);
+    EXPECT_EQ(HitIDs(index, hits), BruteForce(entries, entries[0].Position, inf, entries[0].EntityID));
+
+    index.QueryKNearest(entries[0].Position, 10, inf, entries[0].EntityID, hits);
+    auto expected = BruteForce(entries, entries[0].Position, inf, entries[0].EntityID);
+    expected.resize(10);
+    EXPECT_EQ(HitIDs(index, hits), expected);
+
+    // 远超 i32 范围的查询点
+    index.QueryKNearest({1e30f, 0, -1e30f}, 3, inf, 0, hits);
+    EXPECT_EQ(hits.size(), 3u);
+
+    index.QueryRadius(entries[0].Position, std::numeric_limits<f32>::quiet_NaN(), 0, hits);
+    EXPECT_TRUE(hits.empty());
+}
@@ -0,0 +1,152 @@
+/**
+ * @file test_sprite_batch.cpp
+ * @brief 精灵合并排序单元测试
+ *
+ * 测试 SpriteBatchBuilder 的层优先、Submission 层保持提交顺序、Texture 层按
+ * (纹理, 深度) 分组、纹理槽满时切分批次，以及多个命令列表 (含并行填写) 的合并。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/sprite_list.h"
+#include "engine/core/job_system.h"
+
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+/// 用颜色 r 分量记录提交序号，便于从输出顶点还原顺序
+void DrawTagged(SpriteCommandList& list, u32 texture, f32 tag, f32 depth = 0.0f) {
+    list.Draw(texture, {tag, 0.0f}, {1.0f, 1.0f}, {0, 0, 1, 1}, 0.0f, {tag, 0, 0, 1}, depth);
+}
+
+std::vector<SpriteVertex> Flatten(const SpriteBatchBuilder& builder) {
+    std::vector<SpriteVertex> out((size_t)builder.GetQuadCount() * 4);
+    builder.WriteVertices(0, builder.GetQuadCount(), out.data());
+    return out;
+}
+
+/// 由批次表与顶点的纹理槽还原每个四边形的纹理 ID
+std::vector<u32> ResolveTextures(const SpriteBatchBuilder& builder, const std::vector<SpriteVertex>& verts) {
+    std::vector<u32> textures;
+    for (const auto& batch : builder.GetBatches()) {
+        for (u32 q = batch.FirstQuad; q < batch.FirstQuad + batch.QuadCount; q++) {
+            u32 slot = (u32)verts[(size_t)q * 4].TexIndex;
+            EXPECT_LT(slot, batch.TextureCount);
+            textures.push_back(batch.Textures[slot]);
+        }
+    }
+    return textures;
+}
+
+} // namespace
+
+TEST(SpriteBatchTest, SubmissionLayerKeepsOrderAndLayersSortFirst) {
+    SpriteCommandList list;
+    list.SetLayer(2);
+    DrawTagged(list, 7, 0);
+    DrawTagged(list, 8, 1);
+    list.SetLayer(1);
+    DrawTagged(list, 8, 2);
+    DrawTagged(list, 0, 3);
+    DrawTagged(list, 7, 4);
+
+    SpriteBatchBuilder builder;
+    const SpriteCommandList* lists[] = {&list};
+    builder.Build(lists, 1, 10000);
+    auto verts = Flatten(builder);
+
+    // 层 1 (提交顺序 2,3,4) 在层 2 (0,1) 之前
+    f32 expected[] = {2, 3, 4, 0, 1};
+    for (u32 q = 0; q < 5; q++) EXPECT_FLOAT_EQ(verts[q * 4].Color.r, expected[q]);
+    ASSERT_EQ(builder.GetBatches().size(), 1u);
+    EXPECT_EQ(builder.GetBatches()[0].TextureCount, 3u);   // 白色 + 7 + 8
+
+    std::vector<u32> textures = ResolveTextures(builder, verts);
+    std::vector<u32> expectedTextures = {8, 0, 7, 7, 8};
+    EXPECT_EQ(textures, expectedTextures);
+}
+
+TEST(SpriteBatchTest, TextureLayerGroupsByTextureThenDepth) {
+    SpriteCommandList list;
+    DrawTagged(list, 5, 0, 0.9f);
+    DrawTagged(list, 6, 1, 0.5f);
+    DrawTagged(list, 5, 2, 0.1f);
+    DrawTagged(list, 6, 3, 0.2f);
+    DrawTagged(list, 5, 4, 0.5f);
+
+    SpriteBatchBuilder builder;
+    builder.SetLayerSortMode(0, SpriteSortMode::Texture);
+    const SpriteCommandList* lists[] = {&list};
+    builder.Build(lists, 1, 10000);
+    auto verts = Flatten(builder);
+
+    // 纹理按首次出现排序 (5 在 6 前)，同纹理内深度小的先画
+    f32 expected[] = {2, 4, 0, 3, 1};
+    for (u32 q = 0; q < 5; q++) EXPECT_FLOAT_EQ(verts[q * 4].Color.r, expected[q]);
+}
+
+TEST(SpriteBatchTest, SplitsBatchesWhenSlotsOrQuadsRunOut) {
+    SpriteCommandList list;
+    // 40 种纹理交替出现: 提交顺序下每 15 种纹理就要切一次
+    for (u32 i = 0; i < 400; i++) DrawTagged(list, 100 + i % 40, (f32)i);
+
+    SpriteBatchBuilder builder;
+    const SpriteCommandList* lists[] = {&list};
+    builder.Build(lists, 1, 10000);
+    auto verts = Flatten(builder);
+    EXPECT_GT(builder.GetBatches().size(), 20u);
+    std::vector<u32> textures = ResolveTextures(builder, verts);
+    for (u32 i = 0; i < 400; i++) ASSERT_EQ(textures[i], 100 + i % 40);
+
+    // Texture 模式下同纹理连续，40 种纹理只需 3 批
+    builder.SetLayerSortMode(0, SpriteSortMode::Texture);
+    builder.Build(lists, 1, 10000);
+    EXPECT_EQ(builder.GetBatches().size(), 3u);
+    verts = Flatten(builder);
+    textures = ResolveTextures(builder, verts);
+    for (u32 i = 1; i < 400; i++) ASSERT_GE(textures[i], textures[i - 1]);
+
+    // 单批四边形上限
+    builder.Build(lists, 1, 64);
+    for (const auto& batch : builder.GetBatches()) EXPECT_LE(batch.QuadCount, 64u);
+    u32 total = 0;
+    for (const auto& batch : builder.GetBatches()) total += batch.QuadCount;
+    EXPECT_EQ(total, 400u);
+}
+
+TEST(SpriteBatchTest, MergesListsFilledInParallel) {
+    constexpr u32 LISTS = 8;
+    constexpr u32 PER_LIST = 3000;
+    std::vector<SpriteCommandList> lists(LISTS);
+
+    JobSystem::Init(3);
+    JobSystem::ParallelFor(0, LISTS, [&](u32 l) {
+        lists[l].SetLayer(l % 2 == 0 ? 0 : 3);
+        for (u32 i = 0; i < PER_LIST; i++) DrawTagged(lists[l], 1 + (i % 4), (f32)(l * PER_LIST + i));
+    });
+
+    SpriteBatchBuilder builder;
+    builder.SetLayerSortMode(0, SpriteSortMode::Texture);
+    std::vector<const SpriteCommandList*> ptrs;
+    for (auto& l : lists) ptrs.push_back(&l);
+    builder.Build(ptrs.data(), LISTS, 10000);
+    JobSystem::Shutdown();
+
+    ASSERT_EQ(builder.GetQuadCount(), LISTS * PER_LIST);
+    auto verts = Flatten(builder);
+
+    // 前一半为层 0 (偶数号列表)，后一半为层 3 且保持列表内提交顺序
+    u32 half = LISTS * PER_LIST / 2;
+    for (u32 q = 0; q < half; q++) {
+        u32 tag = (u32)verts[(size_t)q * 4].Color.r;
+        ASSERT_EQ((tag / PER_LIST) % 2, 0u);
+    }
+    for (u32 q = half + 1; q < LISTS * PER_LIST; q++) {
+        u32 prev = (u32)verts[(size_t)(q - 1) * 4].Color.r;
+        u32 tag = (u32)verts[(size_t)q * 4].Color.r;
+        ASSERT_EQ((tag / PER_LIST) % 2, 1u);
+        ASSERT_LT(prev, tag);
+    }
+}
@@ -0,0 +1,178 @@
+/**
+ * @file test_texture_atlas.cpp
+ * @brief 图集装箱单元测试
+ *
+ * 测试 SkylinePacker 的矩形互不重叠且不越界、AtlasBuilder 的像素拷贝与边缘挤出、
+ * 超出单页时开新页，以及 SpriteTextureRemap 把提交的纹理/UV 重定向到图集页。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/renderer/atlas_packer.h"
+#include "engine/renderer/sprite_list.h"
+
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+bool Overlaps(const AtlasRect& a, const AtlasRect& b) {
+    return a.X < b.X + b.W && b.X < a.X + a.W && a.Y < b.Y + b.H && b.Y < a.Y + a.H;
+}
+
+/// 每个像素写入 (key, x, y, 255)，便于校验拷贝位置
+std::vector<u8> MakeImage(u8 key, u32 w, u32 h) {
+    std::vector<u8> pixels((size_t)w * h * 4);
+    for (u32 y = 0; y < h; y++) {
+        for (u32 x = 0; x < w; x++) {
+            u8* p = &pixels[((size_t)y * w + x) * 4];
+            p[0] = key; p[1] = (u8)x; p[2] = (u8)y; p[3] = 255;
+        }
+    }
+    return pixels;
+}
+
+const u8* PagePixel(const AtlasBuilder& builder, u32 page, u32 x, u32 y) {
+    return &builder.GetPagePixels(page)[((size_t)y * builder.GetPageSize() + x) * 4];
+}
+
+} // namespace
+
+TEST(TextureAtlasTest, SkylinePacksWithoutOverlap) {
+    SkylinePacker packer;
+    packer.Init(512, 512);
+
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<u32> dist(4, 48);
+    std::vector<AtlasRect> rects;
+    for (u32 i = 0; i < 400; i++) {
+        AtlasRect r;
+        if (!packer.Pack(dist(rng), dist(rng), r)) continue;
+        ASSERT_LE(r.X + r.W, 512u);
+        ASSERT_LE(r.Y + r.H, 512u);
+        rects.push_back(r);
+    }
+    ASSERT_GT(rects.size(), 100u);
+    for (size_t i = 0; i < rects.size(); i++) {
+        for (size_t j = i + 1; j < rects.size(); j++) {
+            ASSERT_FALSE(Overlaps(rects[i], rects[j])) << i << " / " << j;
+        }
+    }
+
+    // 超宽的矩形应被拒绝，而不是越界
+    AtlasRect big;
+    EXPECT_FALSE(packer.Pack(513, 1, big));
+    EXPECT_GT(packer.GetOccupancy(), 0.5f);
+}
+
+TEST(TextureAtlasTest, SkylineFillsUniformTilesCompletely) {
+    SkylinePacker packer;
+    packer.Init(256, 256);
+    AtlasRect r;
+    for (u32 i = 0; i < 64; i++) ASSERT_TRUE(packer.Pack(32, 32, r));
+    EXPECT_FALSE(packer.Pack(32, 32, r));
+    EXPECT_FLOAT_EQ(packer.GetOccupancy(), 1.0f);
+}
+
+TEST(TextureAtlasTest, BuilderCopiesPixelsAndExtrudesEdges) {
+    AtlasBuilder builder(64, 1);
+    auto a = MakeImage(1, 10, 6);
+    auto b = MakeImage(2, 4, 12);
+    builder.Add(101, a.data(), 10, 6);
+    builder.Add(102, b.data(), 4, 12);
+    ASSERT_TRUE(builder.Pack());
+    ASSERT_EQ(builder.GetPageCount(), 1u);
+
+    const AtlasEntry* ea = builder.Find(101);
+    ASSERT_NE(ea, nullptr);
+    EXPECT_EQ(ea->Rect.W, 10u);
+    EXPECT_EQ(ea->Rect.H, 6u);
+    for (u32 y = 0; y < 6; y++) {
+        for (u32 x = 0; x < 10; x++) {
+            const u8* p = PagePixel(builder, ea->Page, ea->Rect.X + x, ea->Rect.Y + y);
+            ASSERT_EQ(p[0], 1);
+            ASSERT_EQ(p[1], x);
+            ASSERT_EQ(p[2], y);
+        }
+    }
+    // padding 为边缘像素的复制
+    const u8* left = PagePixel(builder, 0, ea->Rect.X - 1, ea->Rect.Y + 3);
+    EXPECT_EQ(left[0], 1); EXPECT_EQ(left[1], 0); EXPECT_EQ(left[2], 3);
+    const u8* corner = PagePixel(builder, 0, ea->Rect.X + 10, ea->Rect.Y + 6);
+    EXPECT_EQ(corner[0], 1); EXPECT_EQ(corner[1], 9); EXPECT_EQ(corner[2], 5);
+
+    // 两张图 (含 padding) 互不重叠
+    const AtlasEntry* eb = builder.Find(102);
+    ASSERT_NE(eb, nullptr);
+    AtlasRect pa = {ea->Rect.X - 1, ea->Rect.Y - 1, 12, 8};
+    AtlasRect pb = {eb->Rect.X - 1, eb->Rect.Y - 1, 6, 14};
+    EXPECT_FALSE(Overlaps(pa, pb));
+
+    EXPECT_FLOAT_EQ(ea->UVRect.x, ea->Rect.X / 64.0f);
+    EXPECT_FLOAT_EQ(ea->UVRect.w, (ea->Rect.Y + 6) / 64.0f);
+}
+
+TEST(TextureAtlasTest, BuilderOpensPagesAndSkipsOversized) {
+    AtlasBuilder builder(32, 0);
+    auto tile = MakeImage(3, 16, 16);
+    for (u32 i = 0; i < 6; i++) builder.Add(10 + i, tile.data(), 16, 16);
+    auto huge = MakeImage(4, 40, 8);
+    builder.Add(99, huge.data(), 40, 8);
+
+    EXPECT_FALSE(builder.Pack());           // 40 宽放不进 32 的页
+    EXPECT_EQ(builder.Find(99), nullptr);
+    EXPECT_EQ(builder.GetEntries().size(), 6u);
+    EXPECT_EQ(builder.GetPageCount(), 2u);   // 每页 4 块
+    EXPECT_FLOAT_EQ(builder.GetPageOccupancy(0), 1.0f);
+}
+
+TEST(TextureAtlasTest, PartialSourceKeepsFullTextureUVSpace) {
+    // 只打包前 8 行 (如字体位图的已用部分)，UV 仍按 32 行的源纹理换算
+    AtlasBuilder builder(64, 0);
+    auto rows = MakeImage(5, 32, 8);
+    builder.Add(7, rows.data(), 32, 8, 32);
+    ASSERT_TRUE(builder.Pack());
+    const AtlasEntry* e = builder.Find(7);
+    ASSERT_NE(e, nullptr);
+    EXPECT_EQ(e->Rect.H, 8u);
+    EXPECT_FLOAT_EQ(e->UVRect.w - e->UVRect.y, 32.0f / 64.0f);
+}
+
+TEST(TextureAtlasTest, RemapRedirectsSubmittedSprites) {
+    SpriteTextureRemap::Clear();
+    SpriteTextureRemap::Set(12, 900, {0.5f, 0.25f, 0.75f, 0.5f});
+
+    SpriteCommandList list;
+    list.Draw(12, {0, 0}, {1, 1}, {0.0f, 0.0f, 0.5f, 1.0f}, 0.0f, glm::vec4(1.0f));
+    list.Draw(13, {0, 0}, {1, 1}, {0.0f, 0.0f, 0.5f, 1.0f}, 0.0f, glm::vec4(1.0f));
+    list.Draw(0, {0, 0}, {1, 1}, {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f, glm::vec4(1.0f));
+
+    EXPECT_EQ(list.GetTextureID(0), 900u);
+    const glm::vec4& uv = list.GetQuad(0).UV;
+    EXPECT_FLOAT_EQ(uv.x, 0.5f);
+    EXPECT_FLOAT_EQ(uv.y, 0.25f);
+    EXPECT_FLOAT_EQ(uv.z, 0.625f);
+    EXPECT_FLOAT_EQ(uv.w, 0.5f);
+
+    EXPECT_EQ(list.GetTextureID(1), 13u);   // 未打包的纹理不变
+    EXPECT_EQ(list.GetTextureID(2), 0u);    // 纯色不变
+
+    // 两张纹理进同一页后合为一个纹理槽
+    SpriteTextureRemap::Set(13, 900, {0.0f, 0.0f, 0.5f, 0.5f});
+    list.Clear();
+    for (u32 i = 0; i < 20; i++) {
+        list.Draw(12 + i % 2, {0, 0}, {1, 1}, {0, 0, 1, 1}, 0.0f, glm::vec4(1.0f));
+    }
+    SpriteBatchBuilder builder;
+    const SpriteCommandList* lists[] = {&list};
+    builder.Build(lists, 1, 10000);
+    ASSERT_EQ(builder.GetBatches().size(), 1u);
+    EXPECT_EQ(builder.GetBatches()[0].TextureCount, 2u);
+
+    SpriteTextureRemap::Remove(12);
+    list.Clear();
+    list.Draw(12, {0, 0}, {1, 1}, {0, 0, 1, 1}, 0.0f, glm::vec4(1.0f));
+    EXPECT_EQ(list.GetTextureID(0), 12u);
+    SpriteTextureRemap::Clear();
+}
@@ -0,0 +1,186 @@
+/**
+ * @file test_tile_collision.cpp
+ * @brief 位压缩碰撞网格单元测试
+ *
+ * 测试碰撞位随 SetTile 增量更新且与逐层合并的结果一致、跨 64 列边界的矩形查询、
+ * X/Y 扫掠停在 tile 边缘 (含地图边界与起点重叠)，以及批量解算与逐个解算结果相同。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/game2d/collision2d.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace Engine;
+
+namespace {
+
+TileData Solid() { return {1, TileCollision::Solid}; }
+
+/// 130×40 两层随机地图 (宽度跨 3 个 u64)
+Tilemap MakeRandomMap(u32 seed) {
+    Tilemap map(130, 40, 16);
+    map.AddLayer("ground");
+    map.AddLayer("objects");
+    std::mt19937 rng(seed);
+    for (u32 l = 0; l < 2; l++) {
+        for (u32 y = 0; y < map.GetHeight(); y++) {
+            for (u32 x = 0; x < map.GetWidth(); x++) {
+                u32 r = rng() % 20;
+                TileCollision c = r == 0 ? TileCollision::Solid
+                                : r == 1 ? TileCollision::Water
+                                : r == 2 ? TileCollision::Interact : TileCollision::None;
+                map.SetTile(l, x, y, {1, c});
+            }
+        }
+    }
+    return map;
+}
+
+/// 逐 tile 的参考实现 (与旧版 CheckAABBCollision 相同)
+bool BruteAABB(const Tilemap& map, i32 minX, i32 minY, i32 maxX, i32 maxY) {
+    for (i32 y = minY; y <= maxY; y++) {
+        for (i32 x = minX; x <= maxX; x++) {
+            if (x < 0 || y < 0 || x >= (i32)map.GetWidth() || y >= (i32)map.GetHeight()) return true;
+            // 各层取最大值
+            TileCollision merged = TileCollision::None;
+            for (u32 l = 0; l < map.GetLayerCount(); l++) {
+                merged = std::max(merged, map.GetLayer(l).Tiles[y * map.GetWidth() + x].Collision);
+            }
+            if (merged == TileCollision::Solid) return true;
+        }
+    }
+    return false;
+}
+
+} // namespace
+
+TEST(TileCollisionTest, GridTracksMergedLayers) {
+    Tilemap map = MakeRandomMap(3);
+    const TileCollisionGrid& grid = map.GetCollisionGrid();
+    for (u32 y = 0; y < map.GetHeight(); y++) {
+        for (u32 x = 0; x < map.GetWidth(); x++) {
+            TileCollision a = map.GetLayer(0).Tiles[y * map.GetWidth() + x].Collision;
+            TileCollision b = map.GetLayer(1).Tiles[y * map.GetWidth() + x].Collision;
+            ASSERT_EQ(grid.Get(x, y), std::max(a, b)) << x << "," << y;
+        }
+    }
+
+    // 清除两层后该 tile 回到 None
+    map.SetTile(0, 70, 5, {1, TileCollision::Solid});
+    map.SetTile(1, 70, 5, {1, TileCollision::None});
+    EXPECT_TRUE(map.IsSolid(70, 5));
+    map.SetTile(0, 70, 5, {1, TileCollision::None});
+    EXPECT_EQ(map.GetCollision(70, 5), TileCollision::None);
+    EXPECT_FALSE(grid.Test(TileCollision::Solid, 70, 5));
+
+    // 直接改写引用后 MarkDirty 刷新
+    map.GetTile(1, 71, 5).Collision = TileCollision::Water;
+    map.MarkDirty(1, 71, 5);
+    EXPECT_EQ(map.GetCollision(71, 5), TileCollision::Water);
+}
+
+TEST(TileCollisionTest, AABBMatchesPerTileScan) {
+    Tilemap map = MakeRandomMap(11);
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<f32> px(-2.0f, 132.0f), py(-2.0f, 42.0f), sz(0.2f, 70.0f);
+    for (u32 i = 0; i < 2000; i++) {
+        glm::vec2 pos = {px(rng), py(rng)};
+        glm::vec2 size = {sz(rng), sz(rng) * 0.2f};
+        i32 minX = (i32)std::floor(pos.x - size.x * 0.5f), maxX = (i32)std::floor(pos.x + size.x * 0.5f);
+        i32 minY = (i32)std::floor(pos.y - size.y * 0.5f), maxY = (i32)std::floor(pos.y + size.y * 0.5f);
+        ASSERT_EQ(map.CheckAABBCollision(pos, size), BruteAABB(map, minX, minY, maxX, maxY)) << i;
+    }
+}
+
+TEST(TileCollisionTest, SweepStopsAtTileFace) {
+    Tilemap map(130, 20, 16);
+    map.AddLayer("walls");
+    for (u32 y = 0; y < 20; y++) {
+        map.SetTile(0, 100, y, Solid());   // 第 2 个 u64 内的竖墙
+        map.SetTile(0, 10, y, Solid());
+    }
+    map.SetTile(0, 50, 15, Solid());       // 天花板
+    const TileCollisionGrid& grid = map.GetCollisionGrid();
+    glm::vec2 half = {0.3f, 0.3f};
+
+    // 向右跨越 64 列边界，停在 x = 100 的墙面
+    glm::vec2 p = {60.5f, 5.5f};
+    f32 dx = grid.SweepX(p, half, 80.0f);
+    EXPECT_NEAR(p.x + dx + half.x, 100.0f, 1e-4f);
+    // 向左停在 x = 11 (墙 10 的右面)
+    dx = grid.SweepX(p, half, -80.0f);
+    EXPECT_NEAR(p.x + dx - half.x, 11.0f, 1e-4f);
+    // 贴墙后继续推不动
+    glm::vec2 touching = {100.0f - half.x, 5.5f};
+    EXPECT_FLOAT_EQ(grid.SweepX(touching, half, 0.5f), 0.0f);
+    // 没有阻挡时走完全程
+    EXPECT_FLOAT_EQ(grid.SweepX(p, half, 2.0f), 2.0f);
+
+    // 向上停在天花板下
+    glm::vec2 q = {50.5f, 10.5f};
+    f32 dy = grid.SweepY(q, half, 10.0f);
+    EXPECT_NEAR(q.y + dy + half.y, 15.0f, 1e-4f);
+    // 向下停在地图底边
+    dy = grid.SweepY(q, half, -30.0f);
+    EXPECT_NEAR(q.y + dy - half.y, 0.0f, 1e-4f);
+    // 向右停在地图右边界
+    glm::vec2 r = {120.5f, 3.5f};
+    dx = grid.SweepX(r, half, 50.0f);
+    EXPECT_NEAR(r.x + dx + half.x, 130.0f, 1e-4f);
+
+    // 起点卡在墙里: 墙本身不阻挡，可以走出来
+    glm::vec2 stuck = {100.5f, 5.5f};
+    EXPECT_FLOAT_EQ(grid.SweepX(stuck, half, 1.0f), 1.0f);
+}
+
+TEST(TileCollisionTest, MoveAndSlideAlongWall) {
+    Tilemap map(20, 20, 16);
+    map.AddLayer("walls");
+    for (u32 y = 0; y < 20; y++) map.SetTile(0, 12, y, Solid());
+
+    // 斜向撞墙: X 贴住墙面，Y 照常移动
+    glm::vec2 half = {0.3f, 0.3f};
+    glm::vec2 out = Collision2D::MoveAndSlide(map, {11.0f, 5.0f}, {12.5f, 6.0f}, half);
+    EXPECT_NEAR(out.x, 12.0f - half.x, 1e-4f);
+    EXPECT_FLOAT_EQ(out.y, 6.0f);
+}
+
+TEST(TileCollisionTest, BatchMatchesSerial) {
+    Tilemap map = MakeRandomMap(21);
+    std::mt19937 rng(9);
+    std::uniform_real_distribution<f32> px(1.0f, 129.0f), py(1.0f, 39.0f), step(-1.5f, 1.5f);
+
+    constexpr u32 COUNT = 5000;
+    std::vector<glm::vec2> oldPos(COUNT), target(COUNT), half(COUNT, glm::vec2(0.3f));
+    for (u32 i = 0; i < COUNT; i++) {
+        oldPos[i] = {px(rng), py(rng)};
+        target[i] = oldPos[i] + glm::vec2(step(rng), step(rng));
+        if (i % 3 == 0) half[i] = glm::vec2(0.45f);
+    }
+
+    std::vector<glm::vec2> serial(COUNT);
+    for (u32 i = 0; i < COUNT; i++) serial[i] = Collision2D::MoveAndSlide(map, oldPos[i], target[i], half[i]);
+
+    JobSystem::Init(3);
+    std::vector<glm::vec2> batch = target;
+    Collision2D::MoveAndSlideBatch(map, oldPos.data(), batch.data(), half.data(), COUNT);
+    JobSystem::Shutdown();
+
+    for (u32 i = 0; i < COUNT; i++) {
+        ASSERT_EQ(batch[i], serial[i]) << i;
+        // 起点没有重叠时，终点也不与 Solid 重叠
+        glm::vec2 h = half[i] - glm::vec2(0.002f);
+        if (!map.GetCollisionGrid().AnyInRect(TileCollision::Solid,
+                (i32)std::floor(oldPos[i].x - h.x), (i32)std::floor(oldPos[i].y - h.y),
+                (i32)std::floor(oldPos[i].x + h.x), (i32)std::floor(oldPos[i].y + h.y))) {
+            ASSERT_FALSE(map.GetCollisionGrid().AnyInRect(TileCollision::Solid,
+                (i32)std::floor(batch[i].x - h.x), (i32)std::floor(batch[i].y - h.y),
+                (i32)std::floor(batch[i].x + h.x), (i32)std::floor(batch[i].y + h.y))) << i;
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/**
+ * @file test_tilemap_chunks.cpp
+ * @brief Tilemap 区块缓存单元测试
+ *
+ * 测试 SetTile 只标脏所在区块 (边缘 tile 连带相邻区块)、相同 tile 不标脏，
+ * 以及 TilemapChunkCache 只重建过期区块、顶点按区块内的 tile 生成并按纹理合批。
+ */
+
+#include <gtest/gtest.h>
+#include "engine/game2d/tilemap_chunks.h"
+#include "engine/core/job_system.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace Engine;
+
+namespace {
+
+constexpr u32 N = Tilemap::CHUNK_SIZE;
+
+/// 3×2 个区块，最右一列和最下一行不满
+Tilemap MakeMap() {
+    Tilemap map(N * 2 + 5, N + 7, 16);
+    map.AddLayer("ground");
+    for (u32 y = 0; y < map.GetHeight(); y++) {
+        for (u32 x = 0; x < map.GetWidth(); x++) {
+            map.SetTile(0, x, y, {(u16)(1 + (x + y) % 2)});
+        }
+    }
+    return map;
+}
+
+/// TileID 决定纹理 (100 + ID)，位置为 tile 坐标
+void TestMesher(const Tilemap& map, u32 layer, u32 x, u32 y, SpriteCommandList& out) {
+    u16 id = map.GetTile(layer, x, y).TileID;
+    out.Draw(100 + id, {(f32)x, (f32)y}, {1.0f, 1.0f}, {0.0f, 0.0f, 1.0f, 1.0f}, 0.0f, glm::vec4(1.0f));
+}
+
+std::vector<u32> Versions(const Tilemap& map) {
+    std::vector<u32> v;
+    for (u32 cy = 0; cy < map.GetChunkCountY(); cy++) {
+        for (u32 cx = 0; cx < map.GetChunkCountX(); cx++) v.push_back(map.GetChunkVersion(0, cx, cy));
+    }
+    return v;
+}
+
+} // namespace
+
+TEST(TilemapChunkTest, SetTileDirtiesOwningChunk) {
+    Tilemap map = MakeMap();
+    ASSERT_EQ(map.GetChunkCountX(), 3u);
+    ASSERT_EQ(map.GetChunkCountY(), 2u);
+
+    // 区块内部: 只有 (1, 0) 变化
+    auto before = Versions(map);
+    map.SetTile(0, N + 5, 5, {7});
+    auto after = Versions(map);
+    for (u32 i = 0; i < before.size(); i++) {
+        if (i == 1) EXPECT_NE(before[i], after[i]);
+        else EXPECT_EQ(before[i], after[i]) << i;
+    }
+
+    // 写入相同的 tile 不标脏
+    map.SetTile(0, N + 5, 5, {7});
+    EXPECT_EQ(Versions(map), after);
+}
+
+TEST(TilemapChunkTest, EdgeTileDirtiesNeighbours) {
+    Tilemap map = MakeMap();
+    auto before = Versions(map);
+    // (N, N-1): 区块 (1, 0) 的左下角 → 连带 (0, 0) 与 (1, 1)
+    map.SetTile(0, N, N - 1, {9});
+    auto after = Versions(map);
+    std::vector<bool> changed;
+    for (u32 i = 0; i < before.size(); i++) changed.push_back(before[i] != after[i]);
+    EXPECT_EQ(changed, (std::vector<bool>{true, true, false, false, true, false}));
+}
+
+TEST(TilemapChunkTest, RebuildsOnlyStaleChunks) {
+    Tilemap map = MakeMap();
+    TilemapChunkCache cache;
+    cache.SetMesher(TestMesher);
+
+    EXPECT_EQ(cache.Rebuild(map), 6u);
+    EXPECT_EQ(cache.Rebuild(map), 0u);
+
+    map.SetTile(0, 3, 3, {5});
+    EXPECT_EQ(cache.Rebuild(map), 1u);
+    map.SetTile(0, N - 1, 3, {5});
+    EXPECT_EQ(cache.Rebuild(map), 2u);
+
+    // 多线程重建结果与单线程一致
+    JobSystem::Init(3);
+    TilemapChunkCache parallel;
+    parallel.SetMesher(TestMesher);
+    EXPECT_EQ(parallel.Rebuild(map), 6u);
+    JobSystem::Shutdown();
+    for (u32 cy = 0; cy < 2; cy++) {
+        for (u32 cx = 0; cx < 3; cx++) {
+            const auto& a = cache.GetChunk(0, cx, cy);
+            const auto& b = parallel.GetChunk(0, cx, cy);
+            ASSERT_EQ(a.Vertices.size(), b.Vertices.size());
+            EXPECT_EQ(0, std::memcmp(a.Vertices.data(), b.Vertices.data(), a.Vertices.size() * sizeof(SpriteVertex)));
+        }
+    }
+
+    // 更换 mesher 后全部重建
+    cache.SetMesher(TestMesher);
+    EXPECT_EQ(cache.Rebuild(map), 6u);
+}
+
+TEST(TilemapChunkTest, ChunkVerticesCoverItsTiles) {
+    Tilemap map = MakeMap();
+    map.SetTile(0, N * 2 + 1, N + 2, {0});   // 空 tile 不生成顶点
+
+    TilemapChunkCache cache;
+    cache.SetMesher(TestMesher);
+    cache.Rebuild(map);
+
+    // 完整区块: N² 个 quad，两种纹理合为一批
+    const auto& full = cache.GetChunk(0, 1, 0);
+    ASSERT_EQ(full.Vertices.size(), (size_t)N * N * 4);
+    ASSERT_EQ(full.Batches.size(), 1u);
+    EXPECT_EQ(full.Batches[0].TextureCount, 3u);   // 含白色槽 0
+    EXPECT_EQ(full.Batches[0].QuadCount, N * N);
+    EXPECT_TRUE(full.NeedsUpload);
+
+    f32 minX = 1e9f, maxX = -1e9f, minY = 1e9f, maxY = -1e9f;
+    for (const SpriteVertex& v : full.Vertices) {
+        minX = std::min(minX, v.Position.x); maxX = std::max(maxX, v.Position.x);
+        minY = std::min(minY, v.Position.y); maxY = std::max(maxY, v.Position.y);
+    }
+    EXPECT_FLOAT_EQ(minX, (f32)N);
+    EXPECT_FLOAT_EQ(maxX, (f32)(N * 2));
+    EXPECT_FLOAT_EQ(minY, 0.0f);
+    EXPECT_FLOAT_EQ(maxY, (f32)N);
+
+    // 角落的不满区块: 5×7 - 1
+    const auto& corner = cache.GetChunk(0, 2, 1);
+    EXPECT_EQ(corner.Vertices.size(), (size_t)(5 * 7 - 1) * 4);
+}
@@ -152,6 +152,21 @@ typedef struct __GLsync *GLsync;
 #define GL_ELEMENT_ARRAY_BUFFER           0x8893
 #define GL_STATIC_DRAW                    0x88E4
 #define GL_DYNAMIC_DRAW                   0x88E8
+#define GL_STREAM_DRAW                    0x88E0
+#define GL_PIXEL_UNPACK_BUFFER            0x88EC
+
+/* Buffer mapping (GL 3.0+) */
+#define GL_MAP_WRITE_BIT                  0x0002
+#define GL_MAP_INVALIDATE_RANGE_BIT       0x0004
+#define GL_MAP_INVALIDATE_BUFFER_BIT      0x0008
+#define GL_MAP_UNSYNCHRONIZED_BIT         0x0020
+
+/* Sync objects (GL 3.2+) */
+#define GL_SYNC_GPU_COMMANDS_COMPLETE     0x9117
+#define GL_ALREADY_SIGNALED               0x911A
+#define GL_TIMEOUT_EXPIRED                0x911B
+#define GL_CONDITION_SATISFIED            0x911C
+#define GL_WAIT_FAILED                    0x911D
 
 /* Textures */
 #define GL_TEXTURE_2D                     0x0DE1
@@ -199,6 +214,10 @@ typedef struct __GLsync *GLsync;
 #define GL_TEXTURE_CUBE_MAP_NEGATIVE_Z    0x851A
 #define GL_TEXTURE_WRAP_R                 0x8072
 #define GL_TEXTURE_MAX_LEVEL              0x813D
+#define GL_TEXTURE_BASE_LEVEL             0x813C
+#define GL_UNPACK_ALIGNMENT               0x0CF5
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT   0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT  0x83F3
 
 /* Framebuffer */
 #define GL_FRAMEBUFFER                    0x8D40
@@ -337,6 +356,19 @@ typedef void   (APIENTRY *PFNGLVERTEXATTRIBIPOINTERPROC)(GLuint, GLint, GLenum,
 /* Debug (GL 4.3+) */
 typedef void   (APIENTRY *PFNGLDEBUGMESSAGECALLBACKPROC)(GLDEBUGPROC, const void*);
 
+/* Buffer mapping (GL 3.0+) — PBO 流式上传 */
+typedef void*     (APIENTRY *PFNGLMAPBUFFERRANGEPROC)(GLenum, GLintptr, GLsizeiptr, GLbitfield);
+typedef GLboolean (APIENTRY *PFNGLUNMAPBUFFERPROC)(GLenum);
+
+/* Sync objects (GL 3.2+) */
+typedef GLsync (APIENTRY *PFNGLFENCESYNCPROC)(GLenum, GLbitfield);
+typedef GLenum (APIENTRY *PFNGLCLIENTWAITSYNCPROC)(GLsync, GLbitfield, GLuint64);
+typedef void   (APIENTRY *PFNGLDELETESYNCPROC)(GLsync);
+
+/* Immutable texture storage (GL 4.2+) */
+typedef void   (APIENTRY *PFNGLTEXSTORAGE2DPROC)(GLenum, GLsizei, GLenum, GLsizei, GLsizei);
+typedef void   (APIENTRY *PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC)(GLenum, GLint, GLint, GLint, GLsizei, GLsizei, GLenum, GLsizei, const void*);
+
 /* ── 全局函数指针 ────────────────────────────────────────── */
 
 extern PFNGLVIEWPORTPROC               glad_glViewport;
@@ -435,6 +467,14 @@ extern PFNGLVERTEXATTRIBIPOINTERPROC   glad_glVertexAttribIPointer;
 
 extern PFNGLDEBUGMESSAGECALLBACKPROC   glad_glDebugMessageCallback;
 
+extern PFNGLMAPBUFFERRANGEPROC         glad_glMapBufferRange;
+extern PFNGLUNMAPBUFFERPROC            glad_glUnmapBuffer;
+extern PFNGLFENCESYNCPROC              glad_glFenceSync;
+extern PFNGLCLIENTWAITSYNCPROC         glad_glClientWaitSync;
+extern PFNGLDELETESYNCPROC             glad_glDeleteSync;
+extern PFNGLTEXSTORAGE2DPROC           glad_glTexStorage2D;
+extern PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC glad_glCompressedTexSubImage2D;
+
 /* ── 用宏将 glXxx 映射到 glad_glXxx ─────────────────────── */
 
 #define glViewport              glad_glViewport
@@ -517,6 +557,13 @@ extern PFNGLDEBUGMESSAGECALLBACKPROC   glad_glDebugMessageCallback;
 #define glFramebufferRenderbuffer glad_glFramebufferRenderbuffer
 #define glVertexAttribIPointer  glad_glVertexAttribIPointer
 #define glDebugMessageCallback  glad_glDebugMessageCallback
+#define glMapBufferRange        glad_glMapBufferRange
+#define glUnmapBuffer           glad_glUnmapBuffer
+#define glFenceSync             glad_glFenceSync
+#define glClientWaitSync        glad_glClientWaitSync
+#define glDeleteSync            glad_glDeleteSync
+#define glTexStorage2D          glad_glTexStorage2D
+#define glCompressedTexSubImage2D glad_glCompressedTexSubImage2D
 
 /* ── 加载函数 ────────────────────────────────────────────── */
 
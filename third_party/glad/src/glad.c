@@ -97,6 +97,14 @@ PFNGLVERTEXATTRIBIPOINTERPROC   glad_glVertexAttribIPointer = 0;
 
 PFNGLDEBUGMESSAGECALLBACKPROC   glad_glDebugMessageCallback = 0;
 
+PFNGLMAPBUFFERRANGEPROC         glad_glMapBufferRange = 0;
+PFNGLUNMAPBUFFERPROC            glad_glUnmapBuffer = 0;
+PFNGLFENCESYNCPROC              glad_glFenceSync = 0;
+PFNGLCLIENTWAITSYNCPROC         glad_glClientWaitSync = 0;
+PFNGLDELETESYNCPROC             glad_glDeleteSync = 0;
+PFNGLTEXSTORAGE2DPROC           glad_glTexStorage2D = 0;
+PFNGLCOMPRESSEDTEXSUBIMAGE2DPROC glad_glCompressedTexSubImage2D = 0;
+
 /* ── 加载实现 ──────────────────────────────────────────────── */
 
 /* 使用 undef 来避免宏展开干扰字符串字面量 */
@@ -199,6 +207,14 @@ int gladLoadGL(GLADloadproc load) {
 
     GLAD_LOAD(glad_glDebugMessageCallback,  "glDebugMessageCallback");
 
+    GLAD_LOAD(glad_glMapBufferRange,        "glMapBufferRange");
+    GLAD_LOAD(glad_glUnmapBuffer,           "glUnmapBuffer");
+    GLAD_LOAD(glad_glFenceSync,             "glFenceSync");
+    GLAD_LOAD(glad_glClientWaitSync,        "glClientWaitSync");
+    GLAD_LOAD(glad_glDeleteSync,            "glDeleteSync");
+    GLAD_LOAD(glad_glTexStorage2D,          "glTexStorage2D");
+    GLAD_LOAD(glad_glCompressedTexSubImage2D, "glCompressedTexSubImage2D");
+
 #undef GLAD_LOAD
 
     return count;
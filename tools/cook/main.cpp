@@ -0,0 +1,310 @@
+// ── cook — 离线资源烘焙工具 ────────────────────────────────
+//
+// 把散落的源资源转换为 GPU 就绪的二进制格式，并打包进单个 .pak:
+//   .obj / .gltf / .glb   → 顶点/索引 blob (缓存/过度绘制/读取顺序优化后直接 glBufferData;
+//                           可选量化为 PackedMeshVertex、附带 meshlet)
+//   .png / .jpg / .tga …  → 完整 mip 链 (可选 BC1/BC3 压缩)
+//   .prefab               → 二进制实体蓝图
+//   .ldtk                 → 二进制 LdtkProject
+//   .scene / 场景 .json   → 二进制场景 (按组件块存放，加载时批量写入 ECS)
+//   其他                  → 原样打包
+//
+// 资源名 = 命令行给出的相对路径 ('/' 分隔)，必须与运行时加载路径一致，
+// 因此请在游戏的工作目录下执行 cook。
+//
+// 用法:
+//   cook -o assets.pak [--bc] [--kaiser] [--quantize] [--meshlets] <文件或目录>...
+
+#include "engine/core/log.h"
+#include "engine/core/pack_archive.h"
+#include "engine/core/cooked_asset.h"
+#include "engine/core/scene_serializer.h"
+#include "engine/renderer/gltf_loader.h"
+#include "engine/renderer/mesh_optimizer.h"
+#include "engine/renderer/mip_chain.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <string_view>
+
+using namespace Engine;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct CookOptions {
+    std::string Output = "assets.pak";
+    bool Compress = false;
+    MipFilter Filter = MipFilter::Box;
+    CookedModelOptions Model;
+};
+
+struct CookStats {
+    u32 Meshes = 0, Textures = 0, Scenes = 0, Prefabs = 0, Ldtk = 0, Raw = 0, Failed = 0;
+};
+
+std::string ToLower(std::string s) {
+    for (auto& c : s) c = (char)tolower((unsigned char)c);
+    return s;
+}
+
+std::string NormalizePath(const fs::path& p) {
+    std::string s = p.lexically_normal().generic_string();
+    if (s.rfind("./", 0) == 0) s = s.substr(2);
+    return s;
+}
+
+bool ReadFile(const std::string& path, std::vector<u8>& out) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) return false;
+    out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return true;
+}
+
+/// SceneSerializer 输出的 JSON 顶层必有 name + entities/directionalLight
+bool LooksLikeScene(const std::vector<u8>& data) {
+    std::string_view head((const char*)data.data(), std::min<size_t>(data.size(), 4096));
+    return head.find("\"directionalLight\"") != std::string_view::npos ||
+           head.find("\"entities\"") != std::string_view::npos;
+}
+
+bool IsTextureExt(const std::string& ext) {
+    return ext == ".png" || ext == ".jpg" || ext == ".jpeg" || ext == ".tga" || ext == ".bmp";
+}
+
+// ── 纹理 ────────────────────────────────────────────────────
+
+bool CookTexture(const std::string& path, const CookOptions& opt, PackWriter& pack) {
+    // 与运行时 Texture2D / TextureStreamer 一致: 垂直翻转
+    stbi_set_flip_vertically_on_load(1);
+    int w, h, ch;
+    unsigned char* pixels = stbi_load(path.c_str(), &w, &h, &ch, 0);
+    if (!pixels) {
+        LOG_ERROR("[cook] 纹理解码失败: %s", path.c_str());
+        return false;
+    }
+
+    MipChain chain;
+    bool ok = MipChain::Build(pixels, (u32)w, (u32)h, (u32)ch, opt.Filter, chain);
+    stbi_image_free(pixels);
+    if (!ok) return false;
+
+    // 压缩只处理 RGB/RGBA，单/双通道保持原格式
+    CookedTextureFormat format = CookedTextureFormat::Raw8;
+    if (opt.Compress && ch >= 3) {
+        format = (ch == 4) ? CookedTextureFormat::BC3 : CookedTextureFormat::BC1;
+    }
+
+    std::vector<u8> blob;
+    if (!CookedAsset::WriteTexture(chain, format, blob)) return false;
+    pack.Add(path, PackAssetType::Texture, blob);
+    LOG_INFO("[cook] 纹理 %s: %dx%d, %u mip, %zu KB", path.c_str(), w, h,
+             chain.GetLevelCount(), blob.size() / 1024);
+    return true;
+}
+
+// ── 模型 ────────────────────────────────────────────────────
+
+bool CookModel(const std::string& path, const std::string& ext, const CookOptions& opt,
+               PackWriter& pack, std::vector<std::string>& referencedTextures) {
+    std::vector<MeshCpuData> meshes;
+
+    if (ext == ".obj") {
+        MeshCpuData data;
+        if (!Mesh::ParseOBJ(path, data.Vertices, data.Indices)) return false;
+        // 与 ResourceManager::LoadModel 的命名一致: 文件名去扩展名
+        data.Name = fs::path(path).stem().string();
+        meshes.push_back(std::move(data));
+    } else {
+        auto gltfMeshes = GltfLoader::Load(path, false);
+        if (gltfMeshes.empty()) return false;
+        for (auto& gm : gltfMeshes) {
+            MeshCpuData data;
+            data.Name = "gltf_" + gm.Name;
+            data.Vertices = std::move(gm.Vertices);
+            data.Indices = std::move(gm.Indices);
+            data.AlbedoTexPath = gm.Material.BaseColorTexPath;
+            data.NormalTexPath = gm.Material.NormalTexPath;
+            data.MetallicRoughnessTexPath = gm.Material.MetallicRoughnessTexPath;
+            // 路径规范化后写入，保证与资源包条目名一致
+            for (auto* tex : {&data.AlbedoTexPath, &data.NormalTexPath, &data.MetallicRoughnessTexPath}) {
+                if (tex->empty()) continue;
+                *tex = NormalizePath(*tex);
+                referencedTextures.push_back(*tex);
+            }
+            meshes.push_back(std::move(data));
+        }
+    }
+
+    // 只改变顺序不改变几何，始终执行；ACMR/ATVR 前后对比写入日志
+    for (auto& m : meshes) {
+        u32 vertexCount = (u32)m.Vertices.size();
+        auto before = MeshOptimizer::AnalyzeVertexCache(m.Indices.data(), (u32)m.Indices.size(), vertexCount);
+        MeshOptimizer::Optimize(m.Vertices, m.Indices);
+        auto after = MeshOptimizer::AnalyzeVertexCache(m.Indices.data(), (u32)m.Indices.size(),
+                                                       (u32)m.Vertices.size());
+        LOG_INFO("[cook]   %s: %zu 三角形, ACMR %.3f → %.3f, ATVR %.3f → %.3f",
+                 m.Name.c_str(), m.Indices.size() / 3, before.ACMR, after.ACMR, before.ATVR, after.ATVR);
+    }
+
+    std::vector<u8> blob;
+    CookedAsset::WriteModel(meshes, blob, opt.Model);
+    pack.Add(path, PackAssetType::Mesh, blob);
+    LOG_INFO("[cook] 模型 %s: %zu 个 mesh, %zu KB", path.c_str(), meshes.size(), blob.size() / 1024);
+    return true;
+}
+
+// ── 预制体 (Prefab::Serialize 的 JSON 格式) ─────────────────
+
+bool CookPrefab(const std::string& path, PackWriter& pack) {
+    std::vector<u8> data;
+    if (!ReadFile(path, data)) return false;
+    Ref<Prefab> prefab = Prefab::Deserialize(std::string(data.begin(), data.end()));
+    if (!prefab) return false;
+
+    std::vector<u8> blob;
+    CookedAsset::WritePrefab(*prefab, blob);
+    pack.Add(path, PackAssetType::Prefab, blob);
+    return true;
+}
+
+// ── LDtk ────────────────────────────────────────────────────
+
+bool CookLdtk(const std::string& path, PackWriter& pack) {
+    LdtkProject project;
+    if (!LdtkLoader::Load(path, project)) return false;
+
+    std::vector<u8> blob;
+    CookedAsset::WriteLdtk(project, blob);
+    pack.Add(path, PackAssetType::Ldtk, blob);
+    LOG_INFO("[cook] LDtk %s: %zu 个关卡, %zu KB", path.c_str(), project.levels.size(), blob.size() / 1024);
+    return true;
+}
+
+// ── 场景 ────────────────────────────────────────────────────
+
+bool CookScene(const std::string& path, const std::vector<u8>& data, PackWriter& pack) {
+    auto scene = SceneSerializer::LoadFromString(std::string_view((const char*)data.data(), data.size()));
+    if (!scene) return false;
+
+    std::vector<u8> blob;
+    SceneSerializer::SaveBinaryToMemory(*scene, blob);
+    pack.Add(path, PackAssetType::Scene, blob, (u32)CookedSceneEncoding::Binary);
+    LOG_INFO("[cook] 场景 %s: %u 个实体, %zu KB (JSON %zu KB)", path.c_str(),
+             scene->GetEntityCount(), blob.size() / 1024, data.size() / 1024);
+    return true;
+}
+
+// ── 单文件分派 ──────────────────────────────────────────────
+
+void CookFile(const std::string& path, const CookOptions& opt, PackWriter& pack,
+              CookStats& stats, std::set<std::string>& cooked) {
+    if (!cooked.insert(path).second) return;
+
+    std::string ext = ToLower(fs::path(path).extension().string());
+    std::vector<std::string> referenced;
+    bool ok = true;
+
+    if (ext == ".obj" || ext == ".gltf" || ext == ".glb") {
+        ok = CookModel(path, ext, opt, pack, referenced);
+        if (ok) stats.Meshes++;
+    } else if (IsTextureExt(ext)) {
+        ok = CookTexture(path, opt, pack);
+        if (ok) stats.Textures++;
+    } else if (ext == ".ldtk") {
+        ok = CookLdtk(path, pack);
+        if (ok) stats.Ldtk++;
+    } else if (ext == ".prefab") {
+        ok = CookPrefab(path, pack);
+        if (ok) stats.Prefabs++;
+    } else {
+        std::vector<u8> data;
+        ok = ReadFile(path, data);
+        if (ok && ((ext == ".scene") || (ext == ".json" && LooksLikeScene(data)))) {
+            ok = CookScene(path, data, pack);
+            if (ok) stats.Scenes++;
+        } else if (ok) {
+            pack.Add(path, PackAssetType::Raw, data);
+            stats.Raw++;
+        }
+    }
+
+    if (!ok) {
+        LOG_ERROR("[cook] 处理失败: %s", path.c_str());
+        stats.Failed++;
+    }
+
+    // glTF 引用的贴图一并烘焙，运行时 LoadTexture 才能命中资源包
+    for (const auto& tex : referenced) {
+        if (fs::exists(tex)) CookFile(tex, opt, pack, stats, cooked);
+    }
+}
+
+void PrintUsage() {
+    std::printf("用法: cook -o <输出.pak> [--bc] [--kaiser] [--quantize] [--meshlets] <文件或目录>...\n"
+                "  -o <path>   输出资源包 (默认 assets.pak)\n"
+                "  --bc        RGB/RGBA 纹理压缩为 BC1/BC3\n"
+                "  --kaiser    mip 生成使用 Kaiser 滤波 (默认 Box)\n"
+                "  --quantize  模型顶点压缩为 20 字节 (half 位置/UV, 10-10-10-2 法线/切线)；\n"
+                "              运行时 ResourceManager::SetPackedVertexInput(true) 时直接上传，否则加载时解压\n"
+                "  --meshlets  模型附带 meshlet 划分 (包围球 + 法线锥)\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Logger::Init();
+
+    CookOptions opt;
+    std::vector<std::string> inputs;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "-o" && i + 1 < argc)   opt.Output = argv[++i];
+        else if (arg == "--bc")            opt.Compress = true;
+        else if (arg == "--kaiser")        opt.Filter = MipFilter::Kaiser;
+        else if (arg == "--quantize")      opt.Model.Quantize = true;
+        else if (arg == "--meshlets")      opt.Model.Meshlets = true;
+        else if (arg == "-h" || arg == "--help") { PrintUsage(); return 0; }
+        else inputs.push_back(arg);
+    }
+    if (inputs.empty()) {
+        PrintUsage();
+        return 1;
+    }
+
+    // 展开目录 (排序保证输出确定性)
+    std::vector<std::string> files;
+    for (const auto& in : inputs) {
+        if (fs::is_directory(in)) {
+            for (const auto& entry : fs::recursive_directory_iterator(in)) {
+                if (entry.is_regular_file()) files.push_back(NormalizePath(entry.path()));
+            }
+        } else if (fs::exists(in)) {
+            files.push_back(NormalizePath(in));
+        } else {
+            LOG_WARN("[cook] 输入不存在: %s", in.c_str());
+        }
+    }
+    std::sort(files.begin(), files.end());
+
+    PackWriter pack;
+    CookStats stats;
+    std::set<std::string> cooked;
+    for (const auto& file : files) {
+        CookFile(file, opt, pack, stats, cooked);
+    }
+
+    if (!pack.Write(opt.Output)) return 1;
+
+    LOG_INFO("[cook] 完成: %u 模型, %u 纹理, %u 场景, %u 预制体, %u LDtk, %u 原样, %u 失败 → %s (%.2f MB)",
+             stats.Meshes, stats.Textures, stats.Scenes, stats.Prefabs, stats.Ldtk, stats.Raw,
+             stats.Failed, opt.Output.c_str(), (f64)pack.GetPayloadSize() / (1024.0 * 1024.0));
+    return stats.Failed ? 2 : 0;
+}